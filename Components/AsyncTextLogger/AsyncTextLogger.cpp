@@ -0,0 +1,192 @@
+// ======================================================================
+// \title  AsyncTextLogger.cpp
+// \author cindy
+// \brief  cpp file for AsyncTextLogger component implementation class
+// ======================================================================
+
+#include "Components/AsyncTextLogger/AsyncTextLogger.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 AsyncTextLogger::RING_SLOTS;
+  const U32 AsyncTextLogger::BATCH_SIZE;
+  const U32 AsyncTextLogger::MAX_LINE_SIZE;
+
+  namespace {
+
+    const char* severityName(U8 severity)
+    {
+      switch (severity) {
+        case Fw::LogSeverity::FATAL:
+          return "FATAL";
+        case Fw::LogSeverity::WARNING_HI:
+          return "WARNING_HI";
+        case Fw::LogSeverity::WARNING_LO:
+          return "WARNING_LO";
+        case Fw::LogSeverity::COMMAND:
+          return "COMMAND";
+        case Fw::LogSeverity::ACTIVITY_HI:
+          return "ACTIVITY_HI";
+        case Fw::LogSeverity::ACTIVITY_LO:
+          return "ACTIVITY_LO";
+        case Fw::LogSeverity::DIAGNOSTIC:
+          return "DIAGNOSTIC";
+        default:
+          return "SEVERITY ERROR";
+      }
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  AsyncTextLogger ::
+    AsyncTextLogger(const char* const compName) :
+      AsyncTextLoggerComponentBase(compName),
+      m_wakePending(false),
+      m_dropped(0),
+      m_fd(STDOUT_FILENO),
+      m_written(0),
+      m_batches(0)
+  {
+
+  }
+
+  AsyncTextLogger ::
+    ~AsyncTextLogger()
+  {
+
+  }
+
+  void AsyncTextLogger ::
+    configure(int fd)
+  {
+    FW_ASSERT(fd >= 0, fd);
+    this->m_fd = fd;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    The emitting thread only copies the event into a ring cell. The drain
+    message is sent when the writer may be idle, so a burst costs one queue
+    send however many events it has. The fence pairs with the writer's:
+    either the writer sees this event after clearing its flag, or this
+    thread sees the flag cleared and wakes it.
+  */
+  void AsyncTextLogger ::
+    TextLogger_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwEventIdType id,
+        Fw::Time& timeTag,
+        const Fw::LogSeverity& severity,
+        Fw::TextLogString& text
+    )
+  {
+    const bool pushed = this->m_ring.push([&](Line& line) {
+      line.id = id;
+      line.seconds = timeTag.getSeconds();
+      line.useconds = timeTag.getUSeconds();
+      line.timeBase = static_cast<U16>(timeTag.getTimeBase());
+      line.severity = static_cast<U8>(severity.e);
+      const size_t length = ::strnlen(text.toChar(), sizeof(line.text));
+      ::memcpy(line.text, text.toChar(), length);
+      line.length = static_cast<U16>(length);
+    });
+    if (!pushed) {
+      this->m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!this->m_wakePending.load(std::memory_order_relaxed) &&
+        !this->m_wakePending.exchange(true, std::memory_order_relaxed)) {
+      this->drain_internalInterfaceInvoke();
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for internal ports
+  // ----------------------------------------------------------------------
+
+  void AsyncTextLogger ::
+    drain_internalInterfaceHandler()
+  {
+    for (;;) {
+      this->writeLines();
+      this->m_wakePending.store(false, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      // An event pushed before the flag was cleared did not send a drain message
+      if (this->m_ring.empty() || this->m_wakePending.exchange(true, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    this->tlmWrite_LINES_WRITTEN(this->m_written);
+    this->tlmWrite_LINES_DROPPED(this->m_dropped.load(std::memory_order_relaxed));
+    this->tlmWrite_BATCHES_WRITTEN(this->m_batches);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    Lines have the same layout as Svc::PassiveTextLogger's, so tools that
+    read the console output are unaffected.
+  */
+  void AsyncTextLogger ::
+    writeLines()
+  {
+    U32 used = 0;
+    auto format = [&](const Line& line) {
+      const int length = ::snprintf(&this->m_batch[used], BATCH_SIZE - used,
+                                    "EVENT: (%" PRIu32 ") (%" PRIu16 ":%" PRIu32 ",%" PRIu32 ") %s: %.*s\n",
+                                    static_cast<U32>(line.id), line.timeBase, line.seconds, line.useconds,
+                                    severityName(line.severity), static_cast<int>(line.length), line.text);
+      if (length > 0) {
+        used += FW_MIN(static_cast<U32>(length), BATCH_SIZE - used - 1);
+      }
+      ++this->m_written;
+    };
+    while (this->m_ring.pop(format)) {
+      if (BATCH_SIZE - used < MAX_LINE_SIZE) {
+        this->flush(used);
+        used = 0;
+      }
+    }
+    if (used > 0) {
+      this->flush(used);
+    }
+  }
+
+  void AsyncTextLogger ::
+    flush(U32 size)
+  {
+    const char* data = this->m_batch;
+    U32 remaining = size;
+    while (remaining > 0) {
+      const ssize_t written = ::write(this->m_fd, data, remaining);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        // Nowhere to report a console that cannot be written
+        break;
+      }
+      data += written;
+      remaining -= static_cast<U32>(written);
+    }
+    ++this->m_batches;
+  }
+
+}
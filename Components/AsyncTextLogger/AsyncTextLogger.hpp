@@ -0,0 +1,141 @@
+// ======================================================================
+// \title  AsyncTextLogger.hpp
+// \author cindy
+// \brief  hpp file for AsyncTextLogger component implementation class
+// ======================================================================
+
+#ifndef MathModule_AsyncTextLogger_HPP
+#define MathModule_AsyncTextLogger_HPP
+
+#include "Components/AsyncTextLogger/AsyncTextLoggerComponentAc.hpp"
+#include "Components/AsyncTextLogger/MpscRing.hpp"
+
+#include <atomic>
+
+namespace MathModule {
+
+  class AsyncTextLogger :
+    public AsyncTextLoggerComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Text events the ring holds before new ones are dropped
+      static const U32 RING_SLOTS = 256;
+
+      //! Bytes of formatted lines collected for one write
+      static const U32 BATCH_SIZE = 8192;
+
+      //! Longest formatted line: prefix, time, severity and text
+      static const U32 MAX_LINE_SIZE = 96 + FW_LOG_TEXT_BUFFER_SIZE;
+
+      static_assert(MAX_LINE_SIZE <= BATCH_SIZE, "a line must fit a batch");
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct AsyncTextLogger object
+      AsyncTextLogger(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy AsyncTextLogger object
+      ~AsyncTextLogger();
+
+      //! Write lines to a descriptor other than standard output
+      void configure(
+          int fd //!< Open descriptor, owned by the caller
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! A text event as copied out of the emitting thread
+      struct Line {
+        FwEventIdType id;
+        U32 seconds;
+        U32 useconds;
+        U16 timeBase;
+        U8 severity;
+        U16 length;
+        char text[FW_LOG_TEXT_BUFFER_SIZE];
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for TextLogger
+      void TextLogger_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwEventIdType id, //!< Event ID
+          Fw::Time& timeTag, //!< Time Tag
+          const Fw::LogSeverity& severity, //!< The severity argument
+          Fw::TextLogString& text //!< Text of log message
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for internal ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for drain
+      void drain_internalInterfaceHandler() override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Format and write every published line, one write per full batch
+      void writeLines();
+
+      //! Write the batch to the descriptor
+      void flush(
+          U32 size //!< Bytes in the batch
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Text events waiting for the writer
+      MpscRing<Line, RING_SLOTS> m_ring;
+
+      //! Set while a drain message is queued or the writer is running
+      std::atomic<bool> m_wakePending;
+
+      //! Text events dropped, counted from any thread
+      std::atomic<U32> m_dropped;
+
+      //! Output descriptor
+      int m_fd;
+
+      //! Formatted lines waiting to be written
+      char m_batch[BATCH_SIZE];
+
+      //! Telemetry counters, updated by the writer
+      U64 m_written;
+      U32 m_batches;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,104 @@
+// ======================================================================
+// \title  MpscRing.hpp
+// \author cindy
+// \brief  Bounded lock-free ring for many producers and one consumer
+//
+// Each cell carries a sequence number that tells producers whether it is
+// free and the consumer whether it is published. A producer claims a cell
+// with a compare-and-swap on the tail and fills it in place; the consumer
+// reads cells in claim order. A full ring fails the push instead of
+// waiting, so producers never block.
+// ======================================================================
+
+#ifndef MathModule_MpscRing_HPP
+#define MathModule_MpscRing_HPP
+
+#include <FpConfig.hpp>
+
+#include <atomic>
+
+namespace MathModule {
+
+  template <typename T, U32 CAPACITY>
+  class MpscRing {
+
+      static_assert((CAPACITY > 1) && ((CAPACITY & (CAPACITY - 1)) == 0), "capacity must be a power of two");
+
+    public:
+
+      MpscRing() :
+        m_tail(0),
+        m_head(0)
+      {
+        for (U32 i = 0; i < CAPACITY; i++) {
+          this->m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+      }
+
+      //! Claim a cell, fill it with fill(T&) and publish it. Safe from any number of threads.
+      //! \return false if the ring is full
+      template <typename Fill>
+      bool push(Fill fill)
+      {
+        U64 position = this->m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+          Cell& cell = this->m_cells[position & (CAPACITY - 1)];
+          const U64 sequence = cell.sequence.load(std::memory_order_acquire);
+          const I64 difference = static_cast<I64>(sequence - position);
+          if (difference == 0) {
+            if (this->m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+              fill(cell.value);
+              cell.sequence.store(position + 1, std::memory_order_release);
+              return true;
+            }
+          } else if (difference < 0) {
+            // The consumer has not freed the cell a full lap ago
+            return false;
+          } else {
+            position = this->m_tail.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      //! Pass the oldest published cell to use(const T&) and free it. Consumer thread only.
+      //! \return false if the oldest claimed cell is not published yet, or nothing is claimed
+      template <typename Use>
+      bool pop(Use use)
+      {
+        Cell& cell = this->m_cells[this->m_head & (CAPACITY - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != this->m_head + 1) {
+          return false;
+        }
+        use(static_cast<const T&>(cell.value));
+        cell.sequence.store(this->m_head + CAPACITY, std::memory_order_release);
+        ++this->m_head;
+        return true;
+      }
+
+      //! Whether pop would find nothing. Consumer thread only.
+      bool empty() const
+      {
+        const Cell& cell = this->m_cells[this->m_head & (CAPACITY - 1)];
+        return cell.sequence.load(std::memory_order_acquire) != this->m_head + 1;
+      }
+
+    private:
+
+      struct Cell {
+        std::atomic<U64> sequence;
+        T value;
+      };
+
+      //! Next position to claim, shared by the producers
+      alignas(64) std::atomic<U64> m_tail;
+
+      //! Next position to read, owned by the consumer
+      alignas(64) U64 m_head;
+
+      alignas(64) Cell m_cells[CAPACITY];
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,98 @@
+// ======================================================================
+// \title  AsyncTextLoggerTestMain.cpp
+// \author cindy
+// \brief  cpp file for AsyncTextLogger component test main function
+// ======================================================================
+
+#include "AsyncTextLoggerTester.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+  struct Item {
+    U32 producer;
+    U32 index;
+  };
+
+}
+
+TEST(MpscRing, OrderAndFull) {
+  MathModule::MpscRing<U32, 8> ring;
+  EXPECT_TRUE(ring.empty());
+  U32 value = 0;
+  EXPECT_FALSE(ring.pop([&](const U32& cell) { value = cell; }));
+
+  // Two laps, so cells are reused
+  for (U32 lap = 0; lap < 2; lap++) {
+    for (U32 i = 0; i < 8; i++) {
+      ASSERT_TRUE(ring.push([&](U32& cell) { cell = lap * 8 + i; }));
+    }
+    EXPECT_FALSE(ring.push([](U32& cell) { cell = 0; }));
+    for (U32 i = 0; i < 8; i++) {
+      ASSERT_TRUE(ring.pop([&](const U32& cell) { value = cell; }));
+      EXPECT_EQ(value, lap * 8 + i);
+    }
+    EXPECT_TRUE(ring.empty());
+  }
+}
+
+TEST(MpscRing, ConcurrentProducers) {
+  static const U32 PRODUCERS = 4;
+  static const U32 ITEMS = 20000;
+  MathModule::MpscRing<Item, 64> ring;
+
+  std::vector<std::thread> producers;
+  for (U32 producer = 0; producer < PRODUCERS; producer++) {
+    producers.emplace_back([&ring, producer]() {
+      for (U32 index = 0; index < ITEMS; index++) {
+        // A full ring fails the push; retry so every item is delivered
+        while (!ring.push([&](Item& item) { item.producer = producer; item.index = index; })) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Each producer's items arrive in order and none are lost or repeated
+  std::vector<U32> next(PRODUCERS, 0);
+  U32 received = 0;
+  bool ordered = true;
+  while (received < PRODUCERS * ITEMS) {
+    const bool popped = ring.pop([&](const Item& item) {
+      ordered = ordered && (item.producer < PRODUCERS) && (item.index == next[item.producer]);
+      if (item.producer < PRODUCERS) {
+        next[item.producer] = item.index + 1;
+      }
+    });
+    if (popped) {
+      ++received;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(ring.empty());
+  for (U32 producer = 0; producer < PRODUCERS; producer++) {
+    EXPECT_EQ(next[producer], ITEMS);
+  }
+}
+
+TEST(Nominal, Batched) {
+  MathModule::AsyncTextLoggerTester tester;
+  tester.testBatched();
+}
+
+TEST(OffNominal, Dropped) {
+  MathModule::AsyncTextLoggerTester tester;
+  tester.testDropped();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+// ======================================================================
+// \title  AsyncTextLoggerTester.cpp
+// \author cindy
+// \brief  cpp file for AsyncTextLogger component test harness implementation class
+// ======================================================================
+
+#include "AsyncTextLoggerTester.hpp"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  AsyncTextLoggerTester ::
+    AsyncTextLoggerTester() :
+      AsyncTextLoggerGTestBase("AsyncTextLoggerTester", AsyncTextLoggerTester::MAX_HISTORY_SIZE),
+      component("AsyncTextLogger")
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/AsyncTextLoggerTester.%d.log", static_cast<int>(::getpid()));
+    this->m_path = path;
+    this->m_fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(this->m_fd);
+  }
+
+  AsyncTextLoggerTester ::
+    ~AsyncTextLoggerTester()
+  {
+    (void) ::close(this->m_fd);
+    (void) ::unlink(this->m_path.c_str());
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void AsyncTextLoggerTester ::
+    testBatched()
+  {
+    this->logText(0x0E00, 100, Fw::LogSeverity::COMMAND, "Math command received: 1.000000 ADD 2.000000");
+    this->logText(0x2700, 101, Fw::LogSeverity::ACTIVITY_LO, "Math operation performed");
+    this->logText(0x0E01, 102, Fw::LogSeverity::ACTIVITY_HI, "Math result: 3.000000");
+    // Nothing is formatted or written on the emitting thread
+    EXPECT_EQ(this->output(), "");
+
+    this->component.doDispatch();
+    EXPECT_EQ(this->output(),
+              "EVENT: (3584) (2:100,5) COMMAND: Math command received: 1.000000 ADD 2.000000\n"
+              "EVENT: (9984) (2:101,5) ACTIVITY_LO: Math operation performed\n"
+              "EVENT: (3585) (2:102,5) ACTIVITY_HI: Math result: 3.000000\n");
+    ASSERT_TLM_LINES_WRITTEN(0, 3);
+    ASSERT_TLM_LINES_DROPPED(0, 0);
+    ASSERT_TLM_BATCHES_WRITTEN(0, 1);
+
+    // The writer is idle again, so the next event wakes it
+    this->clearHistory();
+    this->logText(0x0E00, 103, Fw::LogSeverity::WARNING_HI, "again");
+    this->component.doDispatch();
+    EXPECT_EQ(this->output().substr(this->output().rfind("EVENT")), "EVENT: (3584) (2:103,5) WARNING_HI: again\n");
+    ASSERT_TLM_LINES_WRITTEN(0, 4);
+    ASSERT_TLM_BATCHES_WRITTEN(0, 2);
+  }
+
+  void AsyncTextLoggerTester ::
+    testDropped()
+  {
+    const U32 extra = 5;
+    for (U32 i = 0; i < AsyncTextLogger::RING_SLOTS + extra; i++) {
+      this->logText(0x0E00, i, Fw::LogSeverity::ACTIVITY_HI, "Math result: 3.000000");
+    }
+    this->component.doDispatch();
+
+    // A batch is written once it has no room left for a longest line
+    const std::string lines = this->output();
+    U32 count = 0;
+    U32 batches = 0;
+    U32 used = 0;
+    for (const char c : lines) {
+      ++used;
+      if (c == '\n') {
+        ++count;
+        if (AsyncTextLogger::BATCH_SIZE - used < AsyncTextLogger::MAX_LINE_SIZE) {
+          ++batches;
+          used = 0;
+        }
+      }
+    }
+    batches += (used > 0) ? 1 : 0;
+    EXPECT_EQ(count, AsyncTextLogger::RING_SLOTS);
+    EXPECT_GT(batches, 1U);
+    // The oldest events are kept, the newest dropped
+    EXPECT_EQ(lines.substr(lines.rfind("EVENT")), "EVENT: (3584) (2:255,5) ACTIVITY_HI: Math result: 3.000000\n");
+    ASSERT_TLM_LINES_WRITTEN(0, AsyncTextLogger::RING_SLOTS);
+    ASSERT_TLM_LINES_DROPPED(0, extra);
+    ASSERT_TLM_BATCHES_WRITTEN(0, batches);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void AsyncTextLoggerTester ::
+    logText(FwEventIdType id, U32 seconds, Fw::LogSeverity severity, const char* text)
+  {
+    Fw::Time time(TB_WORKSTATION_TIME, 0, seconds, 5);
+    Fw::TextLogString string(text);
+    this->invoke_to_TextLogger(0, id, time, severity, string);
+  }
+
+  std::string AsyncTextLoggerTester ::
+    output()
+  {
+    std::string contents;
+    char chunk[4096];
+    off_t offset = 0;
+    ssize_t got = 0;
+    while ((got = ::pread(this->m_fd, chunk, sizeof(chunk), offset)) > 0) {
+      contents.append(chunk, static_cast<size_t>(got));
+      offset += got;
+    }
+    return contents;
+  }
+
+}
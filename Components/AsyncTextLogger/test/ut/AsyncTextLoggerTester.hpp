@@ -0,0 +1,97 @@
+// ======================================================================
+// \title  AsyncTextLoggerTester.hpp
+// \author cindy
+// \brief  hpp file for AsyncTextLogger component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_AsyncTextLoggerTester_HPP
+#define MathModule_AsyncTextLoggerTester_HPP
+
+#include "AsyncTextLoggerGTestBase.hpp"
+#include "Components/AsyncTextLogger/AsyncTextLogger.hpp"
+
+#include <string>
+
+namespace MathModule {
+
+  class AsyncTextLoggerTester :
+    public AsyncTextLoggerGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object AsyncTextLoggerTester
+      AsyncTextLoggerTester();
+
+      //! Destroy object AsyncTextLoggerTester, removing its output file
+      ~AsyncTextLoggerTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Events are only written once the writer runs, as PassiveTextLogger lines in one batch
+      void testBatched();
+
+      //! Events beyond the ring's capacity are dropped and counted
+      void testDropped();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Send a text event
+      void logText(FwEventIdType id, U32 seconds, Fw::LogSeverity severity, const char* text);
+
+      //! Everything written so far
+      std::string output();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      AsyncTextLogger component;
+
+      //! Output file path
+      std::string m_path;
+
+      //! Output file
+      int m_fd;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,439 @@
+// ======================================================================
+// \title  BatchCmdDispatcher.cpp
+// \author cindy
+// \brief  cpp file for BatchCmdDispatcher component implementation class
+// ======================================================================
+
+#include "Components/BatchCmdDispatcher/BatchCmdDispatcher.hpp"
+#include "Components/Tracer/Trace.hpp"
+
+#include <cstring>
+
+namespace MathModule {
+
+  const FwOpcodeType BatchCmdDispatcher::BATCH_OPCODE;
+  const U32 BatchCmdDispatcher::RECORD_HEADER_SIZE;
+  const U32 BatchCmdDispatcher::BATCH_SLOTS;
+  const U32 BatchCmdDispatcher::BATCH_WINDOW;
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  BatchCmdDispatcher ::
+    BatchCmdDispatcher(const char* const compName) :
+      BatchCmdDispatcherComponentBase(compName),
+      m_seq(0),
+      m_numCmdsDispatched(0),
+      m_numCmdErrors(0),
+      m_numBatches(0)
+  {
+    ::memset(this->m_entryTable, 0, sizeof(this->m_entryTable));
+    ::memset(this->m_sequenceTracker, 0, sizeof(this->m_sequenceTracker));
+    for (U32 slot = 0; slot < BATCH_SLOTS; slot++) {
+      this->m_batches[slot].used = false;
+    }
+  }
+
+  BatchCmdDispatcher ::
+    ~BatchCmdDispatcher()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    A command of a batch is answered to the batch, which reports once when
+    nothing of it is outstanding. Its successes are not logged one by one.
+  */
+  void BatchCmdDispatcher ::
+    compCmdStat_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwOpcodeType opCode,
+        U32 cmdSeq,
+        const Fw::CmdResponse& response
+    )
+  {
+    NATIVE_INT_TYPE callerPort = -1;
+    U32 context = 0;
+    I32 batch = -1;
+    for (U32 pending = 0; pending < FW_NUM_ARRAY_ELEMENTS(this->m_sequenceTracker); pending++) {
+      SequenceTracker& tracker = this->m_sequenceTracker[pending];
+      if (tracker.used && (tracker.seq == cmdSeq)) {
+        FW_ASSERT(opCode == tracker.opCode, opCode, tracker.opCode);
+        callerPort = tracker.callerPort;
+        context = tracker.context;
+        batch = tracker.batch;
+        tracker.used = false;
+        break;
+      }
+    }
+
+    if (response.e != Fw::CmdResponse::OK) {
+      this->m_numCmdErrors++;
+      this->log_COMMAND_OpCodeError(opCode, response);
+    } else if (batch < 0) {
+      this->log_COMMAND_OpCodeCompleted(opCode);
+    }
+
+    if (batch >= 0) {
+      Batch& current = this->m_batches[batch];
+      FW_ASSERT(current.used && (current.outstanding > 0), batch, current.outstanding);
+      current.outstanding--;
+      if (response.e == Fw::CmdResponse::OK) {
+        current.completed++;
+      } else if (current.status.e == Fw::CmdResponse::OK) {
+        current.status = response;
+      }
+      this->dispatchBatch(static_cast<U32>(batch));
+      if (current.outstanding == 0) {
+        this->finishBatch(static_cast<U32>(batch));
+      }
+    } else if (callerPort >= 0) {
+      this->respond(callerPort, opCode, context, response);
+    }
+    this->writeTelemetry();
+  }
+
+  void BatchCmdDispatcher ::
+    compCmdReg_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwOpcodeType opCode
+    )
+  {
+    bool slotFound = false;
+    for (U32 slot = 0; slot < FW_NUM_ARRAY_ELEMENTS(this->m_entryTable); slot++) {
+      DispatchEntry& entry = this->m_entryTable[slot];
+      if (!entry.used && !slotFound) {
+        entry.used = true;
+        entry.opcode = opCode;
+        entry.port = portNum;
+        this->log_DIAGNOSTIC_OpCodeRegistered(opCode, portNum, static_cast<I32>(slot));
+        slotFound = true;
+      } else if (entry.used && (entry.opcode == opCode) && (entry.port == portNum) && !slotFound) {
+        slotFound = true;
+        this->log_DIAGNOSTIC_OpCodeReregistered(opCode, portNum);
+      } else if (entry.used) {
+        // Each opcode belongs to one component
+        FW_ASSERT(entry.opcode != opCode, opCode);
+      }
+    }
+    FW_ASSERT(slotFound, opCode);
+  }
+
+  void BatchCmdDispatcher ::
+    seqCmdBuff_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::ComBuffer& data,
+        U32 context
+    )
+  {
+    MATH_TRACE_SCOPE("cmdDisp.seqCmdBuff");
+    Fw::CmdPacket packet;
+    const Fw::SerializeStatus status = packet.deserialize(data);
+    if (status != Fw::FW_SERIALIZE_OK) {
+      this->log_WARNING_HI_MalformedCommand(Fw::DeserialStatus(static_cast<Fw::DeserialStatus::t>(status)));
+      this->respond(portNum, packet.getOpCode(), context, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+
+    if (packet.getOpCode() == BATCH_OPCODE) {
+      this->startBatch(portNum, packet.getArgBuffer(), context);
+    } else {
+      const I32 entry = this->findEntry(packet.getOpCode());
+      if (entry < 0) {
+        this->log_WARNING_HI_InvalidCommand(packet.getOpCode());
+        this->m_numCmdErrors++;
+        this->respond(portNum, packet.getOpCode(), context, Fw::CmdResponse::INVALID_OPCODE);
+      } else if (this->isConnected_seqCmdStatus_OutputPort(portNum) &&
+                 !this->track(this->m_seq, packet.getOpCode(), context, portNum, -1)) {
+        this->log_WARNING_HI_TooManyCommands(packet.getOpCode());
+        this->respond(portNum, packet.getOpCode(), context, Fw::CmdResponse::EXECUTION_ERROR);
+      } else {
+        this->log_COMMAND_OpCodeDispatched(packet.getOpCode(), this->m_entryTable[entry].port);
+        this->dispatch(entry, packet);
+      }
+    }
+    this->writeTelemetry();
+  }
+
+  void BatchCmdDispatcher ::
+    pingIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 key
+    )
+  {
+    this->pingOut_out(0, key);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  void BatchCmdDispatcher ::
+    CMD_NO_OP_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    this->log_ACTIVITY_HI_NoOpReceived();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void BatchCmdDispatcher ::
+    CMD_NO_OP_STRING_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& arg1
+    )
+  {
+    Fw::LogStringArg message(arg1.toChar());
+    this->log_ACTIVITY_HI_NoOpStringReceived(message);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void BatchCmdDispatcher ::
+    CMD_TEST_CMD_1_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        I32 arg1,
+        F32 arg2,
+        U8 arg3
+    )
+  {
+    this->log_ACTIVITY_HI_TestCmd1Args(arg1, arg2, arg3);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void BatchCmdDispatcher ::
+    CMD_CLEAR_TRACKING_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    for (U32 pending = 0; pending < FW_NUM_ARRAY_ELEMENTS(this->m_sequenceTracker); pending++) {
+      this->m_sequenceTracker[pending].used = false;
+    }
+    for (U32 slot = 0; slot < BATCH_SLOTS; slot++) {
+      this->m_batches[slot].used = false;
+    }
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  I32 BatchCmdDispatcher ::
+    findEntry(FwOpcodeType opcode)
+  {
+    for (U32 slot = 0; slot < FW_NUM_ARRAY_ELEMENTS(this->m_entryTable); slot++) {
+      const DispatchEntry& entry = this->m_entryTable[slot];
+      if (entry.used && (entry.opcode == opcode)) {
+        return this->isConnected_compCmdSend_OutputPort(entry.port) ? static_cast<I32>(slot) : -1;
+      }
+    }
+    return -1;
+  }
+
+  bool BatchCmdDispatcher ::
+    track(
+        U32 seq,
+        FwOpcodeType opCode,
+        U32 context,
+        NATIVE_INT_TYPE callerPort,
+        I32 batch
+    )
+  {
+    for (U32 pending = 0; pending < FW_NUM_ARRAY_ELEMENTS(this->m_sequenceTracker); pending++) {
+      SequenceTracker& tracker = this->m_sequenceTracker[pending];
+      if (!tracker.used) {
+        tracker.used = true;
+        tracker.seq = seq;
+        tracker.opCode = opCode;
+        tracker.context = context;
+        tracker.callerPort = callerPort;
+        tracker.batch = batch;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void BatchCmdDispatcher ::
+    dispatch(
+        I32 entry,
+        Fw::CmdPacket& packet
+    )
+  {
+    MATH_TRACE_FLOW_BEGIN("command", this->m_seq);
+    this->compCmdSend_out(this->m_entryTable[entry].port, packet.getOpCode(), this->m_seq, packet.getArgBuffer());
+    this->m_seq++;
+    this->m_numCmdsDispatched++;
+  }
+
+  bool BatchCmdDispatcher ::
+    parseRecord(
+        U8* records,
+        U32 size,
+        U32 offset,
+        Fw::CmdPacket& packet,
+        U32& next
+    )
+  {
+    FW_ASSERT(offset <= size, offset, size);
+    if ((size - offset) < RECORD_HEADER_SIZE) {
+      return false;
+    }
+    const U32 length = (static_cast<U32>(records[offset]) << 8) | records[offset + 1];
+    const U32 start = offset + RECORD_HEADER_SIZE;
+    if (length > (size - start)) {
+      return false;
+    }
+    Fw::ExternalSerializeBuffer buffer(records + start, length);
+    if ((buffer.setBuffLen(length) != Fw::FW_SERIALIZE_OK) || (packet.deserialize(buffer) != Fw::FW_SERIALIZE_OK)) {
+      return false;
+    }
+    next = start + length;
+    return true;
+  }
+
+  /*
+    Every record is checked before the first is dispatched, so a batch that
+    is rejected has no effect.
+  */
+  Fw::CmdResponse BatchCmdDispatcher ::
+    validateBatch(Batch& batch)
+  {
+    batch.count = 0;
+    U32 offset = 0;
+    while (offset < batch.size) {
+      Fw::CmdPacket packet;
+      U32 next = 0;
+      if (!this->parseRecord(batch.records, batch.size, offset, packet, next) ||
+          (packet.getOpCode() == BATCH_OPCODE)) {
+        this->log_WARNING_HI_MalformedBatch(offset);
+        return Fw::CmdResponse::VALIDATION_ERROR;
+      }
+      if (this->findEntry(packet.getOpCode()) < 0) {
+        this->log_WARNING_HI_InvalidCommand(packet.getOpCode());
+        return Fw::CmdResponse::INVALID_OPCODE;
+      }
+      batch.count++;
+      offset = next;
+    }
+    if (batch.count == 0) {
+      this->log_WARNING_HI_MalformedBatch(0);
+      return Fw::CmdResponse::VALIDATION_ERROR;
+    }
+    return Fw::CmdResponse::OK;
+  }
+
+  void BatchCmdDispatcher ::
+    startBatch(
+        NATIVE_INT_TYPE portNum,
+        Fw::CmdArgBuffer& records,
+        U32 context
+    )
+  {
+    U32 slot = 0;
+    while ((slot < BATCH_SLOTS) && this->m_batches[slot].used) {
+      slot++;
+    }
+    if (slot == BATCH_SLOTS) {
+      this->log_WARNING_HI_TooManyCommands(BATCH_OPCODE);
+      this->respond(portNum, BATCH_OPCODE, context, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+
+    Batch& batch = this->m_batches[slot];
+    FW_ASSERT(records.getBuffLength() <= sizeof(batch.records), records.getBuffLength());
+    ::memcpy(batch.records, records.getBuffAddr(), records.getBuffLength());
+    batch.size = records.getBuffLength();
+    batch.callerPort = portNum;
+    batch.context = context;
+    batch.next = 0;
+    batch.outstanding = 0;
+    batch.completed = 0;
+    batch.status = Fw::CmdResponse::OK;
+    const Fw::CmdResponse valid = this->validateBatch(batch);
+    if (valid.e != Fw::CmdResponse::OK) {
+      this->m_numCmdErrors++;
+      this->respond(portNum, BATCH_OPCODE, context, valid);
+      return;
+    }
+
+    batch.used = true;
+    this->m_numBatches++;
+    this->log_COMMAND_BatchDispatched(batch.count);
+    this->dispatchBatch(slot);
+    if (batch.outstanding == 0) {
+      // Every tracker slot is held by commands outside this batch
+      this->log_WARNING_HI_TooManyCommands(BATCH_OPCODE);
+      this->m_numCmdErrors++;
+      batch.status = Fw::CmdResponse::EXECUTION_ERROR;
+      this->finishBatch(slot);
+    }
+  }
+
+  /*
+    Records were validated when the batch arrived and registrations are
+    never withdrawn, so they still parse and have a handler. A tracker slot
+    may be missing; the response that frees one calls this again.
+  */
+  void BatchCmdDispatcher ::
+    dispatchBatch(U32 slot)
+  {
+    Batch& batch = this->m_batches[slot];
+    while ((batch.status.e == Fw::CmdResponse::OK) && (batch.next < batch.size) &&
+           (batch.outstanding < BATCH_WINDOW)) {
+      Fw::CmdPacket packet;
+      U32 next = 0;
+      const bool parsed = this->parseRecord(batch.records, batch.size, batch.next, packet, next);
+      FW_ASSERT(parsed, batch.next);
+      const I32 entry = this->findEntry(packet.getOpCode());
+      FW_ASSERT(entry >= 0, packet.getOpCode());
+      if (!this->track(this->m_seq, packet.getOpCode(), batch.context, batch.callerPort, static_cast<I32>(slot))) {
+        break;
+      }
+      this->dispatch(entry, packet);
+      batch.next = next;
+      batch.outstanding++;
+    }
+  }
+
+  void BatchCmdDispatcher ::
+    finishBatch(U32 slot)
+  {
+    Batch& batch = this->m_batches[slot];
+    FW_ASSERT(batch.used && (batch.outstanding == 0), slot, batch.outstanding);
+    this->log_COMMAND_BatchCompleted(batch.completed, batch.count, batch.status);
+    this->respond(batch.callerPort, BATCH_OPCODE, batch.context, batch.status);
+    batch.used = false;
+  }
+
+  void BatchCmdDispatcher ::
+    respond(
+        NATIVE_INT_TYPE callerPort,
+        FwOpcodeType opCode,
+        U32 context,
+        Fw::CmdResponse response
+    )
+  {
+    if (this->isConnected_seqCmdStatus_OutputPort(callerPort)) {
+      this->seqCmdStatus_out(callerPort, opCode, context, response);
+    }
+  }
+
+  void BatchCmdDispatcher ::
+    writeTelemetry()
+  {
+    this->tlmWrite_CommandsDispatched(this->m_numCmdsDispatched);
+    this->tlmWrite_CommandErrors(this->m_numCmdErrors);
+    this->tlmWrite_BatchesDispatched(this->m_numBatches);
+  }
+
+}
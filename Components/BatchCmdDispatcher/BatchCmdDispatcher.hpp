@@ -0,0 +1,255 @@
+// ======================================================================
+// \title  BatchCmdDispatcher.hpp
+// \author cindy
+// \brief  hpp file for BatchCmdDispatcher component implementation class
+// ======================================================================
+
+#ifndef MathModule_BatchCmdDispatcher_HPP
+#define MathModule_BatchCmdDispatcher_HPP
+
+#include "Components/BatchCmdDispatcher/BatchCmdDispatcherComponentAc.hpp"
+#include <CommandDispatcherImplCfg.hpp>
+#include <Fw/Cmd/CmdPacket.hpp>
+
+namespace MathModule {
+
+  class BatchCmdDispatcher :
+    public BatchCmdDispatcherComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Opcode of a batch packet. Above every instance base id, so no component registers it.
+      static const FwOpcodeType BATCH_OPCODE = 0xFFFF0000;
+
+      //! Size of the length prefix in front of each command packet in a batch
+      static const U32 RECORD_HEADER_SIZE = sizeof(U16);
+
+      //! Batches that can wait for statuses at once
+      static const U32 BATCH_SLOTS = 4;
+
+      //! Commands of one batch dispatched but not yet answered. Kept below the
+      //! default component queue depth, so a batch aimed at one component
+      //! cannot overflow its queue.
+      static const U32 BATCH_WINDOW = 4;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct BatchCmdDispatcher object
+      BatchCmdDispatcher(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy BatchCmdDispatcher object
+      ~BatchCmdDispatcher();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for compCmdStat
+      void compCmdStat_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwOpcodeType opCode, //!< Command Op Code
+          U32 cmdSeq, //!< Command Sequence
+          const Fw::CmdResponse& response //!< The command response argument
+      ) override;
+
+      //! Handler implementation for compCmdReg
+      void compCmdReg_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwOpcodeType opCode //!< Command Op Code
+      ) override;
+
+      //! Handler implementation for seqCmdBuff
+      void seqCmdBuff_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::ComBuffer& data, //!< Buffer containing packet data
+          U32 context //!< Call context value; meaning chosen by user
+      ) override;
+
+      //! Handler implementation for pingIn
+      void pingIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          U32 key //!< Value to return to pinger
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command CMD_NO_OP
+      void CMD_NO_OP_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq //!< The command sequence number
+      ) override;
+
+      //! Handler implementation for command CMD_NO_OP_STRING
+      void CMD_NO_OP_STRING_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq, //!< The command sequence number
+          const Fw::CmdStringArg& arg1 //!< The string argument
+      ) override;
+
+      //! Handler implementation for command CMD_TEST_CMD_1
+      void CMD_TEST_CMD_1_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq, //!< The command sequence number
+          I32 arg1, //!< Test argument 1
+          F32 arg2, //!< Test argument 2
+          U8 arg3 //!< Test argument 3
+      ) override;
+
+      //! Handler implementation for command CMD_CLEAR_TRACKING
+      void CMD_CLEAR_TRACKING_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq //!< The command sequence number
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Registered opcode
+      struct DispatchEntry {
+        bool used;
+        FwOpcodeType opcode;
+        NATIVE_INT_TYPE port; //!< compCmdSend port of the component
+      };
+
+      //! Dispatched command waiting for its status
+      struct SequenceTracker {
+        bool used;
+        U32 seq;
+        FwOpcodeType opCode;
+        U32 context;
+        NATIVE_INT_TYPE callerPort; //!< seqCmdStatus port to answer on
+        I32 batch; //!< Batch slot the command belongs to, or -1
+      };
+
+      //! Batch whose commands are being dispatched or answered
+      struct Batch {
+        bool used;
+        NATIVE_INT_TYPE callerPort; //!< seqCmdStatus port to answer on
+        U32 context;
+        U8 records[FW_CMD_ARG_BUFFER_MAX_SIZE]; //!< Length-prefixed command packets
+        U32 size; //!< Bytes in records
+        U32 next; //!< Offset of the next record to dispatch
+        U32 count; //!< Commands in the batch
+        U32 outstanding; //!< Commands dispatched and not yet answered
+        U32 completed; //!< Commands answered OK
+        Fw::CmdResponse status; //!< First failure, or OK
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Find the dispatch table slot of a connected opcode
+      //! \return the slot, or -1 if no connected component registered the opcode
+      I32 findEntry(FwOpcodeType opcode);
+
+      //! Take a tracker slot for a dispatched command
+      //! \return false if every slot is taken
+      bool track(
+          U32 seq, //!< The command sequence number
+          FwOpcodeType opCode, //!< The opcode
+          U32 context, //!< The caller's context
+          NATIVE_INT_TYPE callerPort, //!< The caller's port
+          I32 batch //!< The batch slot, or -1
+      );
+
+      //! Send a command to the component that registered its opcode
+      void dispatch(
+          I32 entry, //!< The dispatch table slot
+          Fw::CmdPacket& packet //!< The command
+      );
+
+      //! Deserialize the command packet of the record at an offset in a batch
+      //! \return false if the record runs past the batch or does not deserialize
+      bool parseRecord(
+          U8* records, //!< The batch records
+          U32 size, //!< Bytes in records
+          U32 offset, //!< Offset of the record
+          Fw::CmdPacket& packet, //!< Set to the command
+          U32& next //!< Set to the offset of the following record
+      );
+
+      //! Check every record of a batch before any is dispatched
+      //! \return OK, or the status the batch is rejected with
+      Fw::CmdResponse validateBatch(
+          Batch& batch //!< The batch, whose count is set
+      );
+
+      //! Begin a batch received on a sequence port
+      void startBatch(
+          NATIVE_INT_TYPE portNum, //!< The caller's port
+          Fw::CmdArgBuffer& records, //!< The batch records
+          U32 context //!< The caller's context
+      );
+
+      //! Dispatch records of a batch until its window is full or it ends or fails
+      void dispatchBatch(
+          U32 slot //!< The batch slot
+      );
+
+      //! Report a batch with nothing outstanding and free its slot
+      void finishBatch(
+          U32 slot //!< The batch slot
+      );
+
+      //! Answer a command or batch on a sequence port, if connected
+      void respond(
+          NATIVE_INT_TYPE callerPort, //!< The caller's port
+          FwOpcodeType opCode, //!< The opcode
+          U32 context, //!< The caller's context
+          Fw::CmdResponse response //!< The status
+      );
+
+      //! Write the counters, once per message rather than once per command
+      void writeTelemetry();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Registered opcodes
+      DispatchEntry m_entryTable[CMD_DISPATCHER_DISPATCH_TABLE_SIZE];
+
+      //! Commands waiting for a status
+      SequenceTracker m_sequenceTracker[CMD_DISPATCHER_SEQUENCER_TABLE_SIZE];
+
+      //! Batches waiting for statuses
+      Batch m_batches[BATCH_SLOTS];
+
+      //! Sequence number of the next command
+      U32 m_seq;
+
+      //! Telemetry counters
+      U32 m_numCmdsDispatched;
+      U32 m_numCmdErrors;
+      U32 m_numBatches;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,37 @@
+// ======================================================================
+// \title  BatchCmdDispatcherTestMain.cpp
+// \author cindy
+// \brief  cpp file for BatchCmdDispatcher component test main function
+// ======================================================================
+
+#include "BatchCmdDispatcherTester.hpp"
+
+TEST(Nominal, SingleCommand) {
+  MathModule::BatchCmdDispatcherTester tester;
+  tester.testSingleCommand();
+}
+
+TEST(Nominal, Batch) {
+  MathModule::BatchCmdDispatcherTester tester;
+  tester.testBatch();
+}
+
+TEST(OffNominal, BatchFailure) {
+  MathModule::BatchCmdDispatcherTester tester;
+  tester.testBatchFailure();
+}
+
+TEST(OffNominal, BatchRejected) {
+  MathModule::BatchCmdDispatcherTester tester;
+  tester.testBatchRejected();
+}
+
+TEST(OffNominal, TooManyBatches) {
+  MathModule::BatchCmdDispatcherTester tester;
+  tester.testTooManyBatches();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,259 @@
+// ======================================================================
+// \title  BatchCmdDispatcherTester.cpp
+// \author cindy
+// \brief  cpp file for BatchCmdDispatcher component test harness implementation class
+// ======================================================================
+
+#include "BatchCmdDispatcherTester.hpp"
+
+namespace MathModule {
+
+  const FwOpcodeType BatchCmdDispatcherTester::OPCODE_A;
+  const FwOpcodeType BatchCmdDispatcherTester::OPCODE_B;
+  const U32 BatchCmdDispatcherTester::CONTEXT;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  BatchCmdDispatcherTester ::
+    BatchCmdDispatcherTester() :
+      BatchCmdDispatcherGTestBase("BatchCmdDispatcherTester", BatchCmdDispatcherTester::MAX_HISTORY_SIZE),
+      component("BatchCmdDispatcher")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->registerCommands();
+  }
+
+  BatchCmdDispatcherTester ::
+    ~BatchCmdDispatcherTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void BatchCmdDispatcherTester ::
+    testSingleCommand()
+  {
+    const std::vector<U8> bytes = this->commandPacket(OPCODE_B, 7);
+    Fw::ComBuffer packet(bytes.data(), static_cast<NATIVE_UINT_TYPE>(bytes.size()));
+    this->sendPacket(packet);
+    ASSERT_from_compCmdSend_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_compCmdSend->at(0).opCode, OPCODE_B);
+    EXPECT_EQ(this->argument(0), 7U);
+    ASSERT_EVENTS_OpCodeDispatched_SIZE(1);
+    ASSERT_EVENTS_OpCodeDispatched(0, OPCODE_B, 1);
+    ASSERT_from_seqCmdStatus_SIZE(0);
+
+    this->answer(0, Fw::CmdResponse::OK);
+    ASSERT_from_seqCmdStatus_SIZE(1);
+    ASSERT_from_seqCmdStatus(0, OPCODE_B, CONTEXT, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_OpCodeCompleted_SIZE(1);
+
+    // An opcode nobody registered
+    const std::vector<U8> unknown = this->commandPacket(0x4242, 0);
+    Fw::ComBuffer unknownPacket(unknown.data(), static_cast<NATIVE_UINT_TYPE>(unknown.size()));
+    this->sendPacket(unknownPacket);
+    ASSERT_from_seqCmdStatus_SIZE(2);
+    ASSERT_from_seqCmdStatus(1, 0x4242, CONTEXT, Fw::CmdResponse::INVALID_OPCODE);
+    ASSERT_EVENTS_InvalidCommand_SIZE(1);
+  }
+
+  void BatchCmdDispatcherTester ::
+    testBatch()
+  {
+    const U32 count = 3 * BatchCmdDispatcher::BATCH_WINDOW + 1;
+    std::vector<std::vector<U8> > commands;
+    for (U32 i = 0; i < count; i++) {
+      commands.push_back(this->commandPacket((i % 3 == 0) ? OPCODE_B : OPCODE_A, 100 + i));
+    }
+    Fw::ComBuffer packet = this->batchPacket(commands);
+    this->sendPacket(packet);
+    ASSERT_EVENTS_BatchDispatched_SIZE(1);
+    ASSERT_EVENTS_BatchDispatched(0, count);
+    ASSERT_from_compCmdSend_SIZE(BatchCmdDispatcher::BATCH_WINDOW);
+
+    // Each answer lets one more command out, in batch order
+    for (U32 i = 0; i < count; i++) {
+      this->answer(i, Fw::CmdResponse::OK);
+      ASSERT_from_compCmdSend_SIZE(FW_MIN(count, i + 1 + BatchCmdDispatcher::BATCH_WINDOW));
+    }
+    for (U32 i = 0; i < count; i++) {
+      EXPECT_EQ(this->fromPortHistory_compCmdSend->at(i).opCode, (i % 3 == 0) ? OPCODE_B : OPCODE_A);
+      EXPECT_EQ(this->argument(i), 100 + i);
+    }
+
+    ASSERT_from_seqCmdStatus_SIZE(1);
+    ASSERT_from_seqCmdStatus(0, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_BatchCompleted_SIZE(1);
+    ASSERT_EVENTS_BatchCompleted(0, count, count, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_OpCodeDispatched_SIZE(0);
+    ASSERT_EVENTS_OpCodeCompleted_SIZE(0);
+    ASSERT_TLM_CommandsDispatched(this->tlmHistory_CommandsDispatched->size() - 1, count);
+    ASSERT_TLM_BatchesDispatched(0, 1);
+  }
+
+  void BatchCmdDispatcherTester ::
+    testBatchFailure()
+  {
+    const U32 count = 2 * BatchCmdDispatcher::BATCH_WINDOW;
+    std::vector<std::vector<U8> > commands;
+    for (U32 i = 0; i < count; i++) {
+      commands.push_back(this->commandPacket(OPCODE_A, i));
+    }
+    Fw::ComBuffer packet = this->batchPacket(commands);
+    this->sendPacket(packet);
+    ASSERT_from_compCmdSend_SIZE(BatchCmdDispatcher::BATCH_WINDOW);
+
+    this->answer(0, Fw::CmdResponse::OK);
+    this->answer(1, Fw::CmdResponse::EXECUTION_ERROR);
+    // The commands already out still report, but no more are sent
+    for (U32 i = 2; i <= BatchCmdDispatcher::BATCH_WINDOW; i++) {
+      ASSERT_from_seqCmdStatus_SIZE(0);
+      this->answer(i, Fw::CmdResponse::OK);
+    }
+    ASSERT_from_compCmdSend_SIZE(BatchCmdDispatcher::BATCH_WINDOW + 1);
+    ASSERT_from_seqCmdStatus_SIZE(1);
+    ASSERT_from_seqCmdStatus(0, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_OpCodeError_SIZE(1);
+    ASSERT_EVENTS_OpCodeError(0, OPCODE_A, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_BatchCompleted(0, BatchCmdDispatcher::BATCH_WINDOW, count, Fw::CmdResponse::EXECUTION_ERROR);
+  }
+
+  void BatchCmdDispatcherTester ::
+    testBatchRejected()
+  {
+    std::vector<std::vector<U8> > commands;
+    commands.push_back(this->commandPacket(OPCODE_A, 1));
+    commands.push_back(this->commandPacket(OPCODE_B, 2));
+    commands.push_back(this->commandPacket(0x4242, 3));
+    Fw::ComBuffer unknown = this->batchPacket(commands);
+    this->sendPacket(unknown);
+    ASSERT_from_seqCmdStatus_SIZE(1);
+    ASSERT_from_seqCmdStatus(0, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::INVALID_OPCODE);
+    ASSERT_EVENTS_InvalidCommand_SIZE(1);
+    ASSERT_EVENTS_InvalidCommand(0, 0x4242);
+
+    // The last record claims more bytes than the batch holds
+    commands.pop_back();
+    Fw::ComBuffer truncated = this->batchPacket(commands);
+    truncated.serialize(static_cast<U16>(20));
+    truncated.serialize(static_cast<U32>(0));
+    this->sendPacket(truncated);
+    ASSERT_from_seqCmdStatus_SIZE(2);
+    ASSERT_from_seqCmdStatus(1, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::VALIDATION_ERROR);
+    ASSERT_EVENTS_MalformedBatch_SIZE(1);
+    const U32 recordSize = static_cast<U32>(commands[0].size()) + BatchCmdDispatcher::RECORD_HEADER_SIZE;
+    ASSERT_EVENTS_MalformedBatch(0, 2 * recordSize);
+
+    Fw::ComBuffer empty = this->batchPacket(std::vector<std::vector<U8> >());
+    this->sendPacket(empty);
+    ASSERT_from_seqCmdStatus(2, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::VALIDATION_ERROR);
+
+    // A batch inside a batch
+    std::vector<std::vector<U8> > nested;
+    nested.push_back(this->commandPacket(BatchCmdDispatcher::BATCH_OPCODE, 0));
+    Fw::ComBuffer nestedPacket = this->batchPacket(nested);
+    this->sendPacket(nestedPacket);
+    ASSERT_from_seqCmdStatus(3, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::VALIDATION_ERROR);
+
+    ASSERT_from_compCmdSend_SIZE(0);
+    ASSERT_EVENTS_BatchDispatched_SIZE(0);
+  }
+
+  void BatchCmdDispatcherTester ::
+    testTooManyBatches()
+  {
+    std::vector<std::vector<U8> > commands;
+    commands.push_back(this->commandPacket(OPCODE_A, 1));
+    for (U32 i = 0; i < BatchCmdDispatcher::BATCH_SLOTS; i++) {
+      Fw::ComBuffer packet = this->batchPacket(commands);
+      this->sendPacket(packet);
+    }
+    ASSERT_from_compCmdSend_SIZE(BatchCmdDispatcher::BATCH_SLOTS);
+    ASSERT_from_seqCmdStatus_SIZE(0);
+
+    Fw::ComBuffer refused = this->batchPacket(commands);
+    this->sendPacket(refused);
+    ASSERT_from_seqCmdStatus_SIZE(1);
+    ASSERT_from_seqCmdStatus(0, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_TooManyCommands_SIZE(1);
+    ASSERT_EVENTS_TooManyCommands(0, BatchCmdDispatcher::BATCH_OPCODE);
+
+    // Answering frees a slot
+    this->answer(0, Fw::CmdResponse::OK);
+    ASSERT_from_seqCmdStatus(1, BatchCmdDispatcher::BATCH_OPCODE, CONTEXT, Fw::CmdResponse::OK);
+    Fw::ComBuffer accepted = this->batchPacket(commands);
+    this->sendPacket(accepted);
+    ASSERT_from_compCmdSend_SIZE(BatchCmdDispatcher::BATCH_SLOTS + 1);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void BatchCmdDispatcherTester ::
+    registerCommands()
+  {
+    this->invoke_to_compCmdReg(0, OPCODE_A);
+    this->invoke_to_compCmdReg(1, OPCODE_B);
+    this->clearHistory();
+  }
+
+  std::vector<U8> BatchCmdDispatcherTester ::
+    commandPacket(FwOpcodeType opcode, U32 arg)
+  {
+    Fw::ComBuffer packet;
+    EXPECT_EQ(packet.serialize(static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_COMMAND)),
+              Fw::FW_SERIALIZE_OK);
+    EXPECT_EQ(packet.serialize(opcode), Fw::FW_SERIALIZE_OK);
+    EXPECT_EQ(packet.serialize(arg), Fw::FW_SERIALIZE_OK);
+    return std::vector<U8>(packet.getBuffAddr(), packet.getBuffAddr() + packet.getBuffLength());
+  }
+
+  Fw::ComBuffer BatchCmdDispatcherTester ::
+    batchPacket(const std::vector<std::vector<U8> >& commands)
+  {
+    Fw::ComBuffer packet;
+    EXPECT_EQ(packet.serialize(static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_COMMAND)),
+              Fw::FW_SERIALIZE_OK);
+    EXPECT_EQ(packet.serialize(BatchCmdDispatcher::BATCH_OPCODE), Fw::FW_SERIALIZE_OK);
+    for (const std::vector<U8>& command : commands) {
+      EXPECT_EQ(packet.serialize(static_cast<U16>(command.size())), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(packet.serialize(command.data(), static_cast<NATIVE_UINT_TYPE>(command.size()), true),
+                Fw::FW_SERIALIZE_OK);
+    }
+    return packet;
+  }
+
+  void BatchCmdDispatcherTester ::
+    sendPacket(Fw::ComBuffer& packet)
+  {
+    this->invoke_to_seqCmdBuff(0, packet, CONTEXT);
+    this->component.doDispatch();
+  }
+
+  void BatchCmdDispatcherTester ::
+    answer(U32 index, Fw::CmdResponse response)
+  {
+    ASSERT_LT(index, this->fromPortHistory_compCmdSend->size());
+    this->invoke_to_compCmdStat(0, this->fromPortHistory_compCmdSend->at(index).opCode,
+                                this->fromPortHistory_compCmdSend->at(index).cmdSeq, response);
+    this->component.doDispatch();
+  }
+
+  U32 BatchCmdDispatcherTester ::
+    argument(U32 index)
+  {
+    Fw::CmdArgBuffer args = this->fromPortHistory_compCmdSend->at(index).args;
+    args.resetDeser();
+    U32 value = 0;
+    EXPECT_EQ(args.deserialize(value), Fw::FW_SERIALIZE_OK);
+    return value;
+  }
+
+}
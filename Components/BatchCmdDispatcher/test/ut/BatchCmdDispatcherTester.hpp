@@ -0,0 +1,119 @@
+// ======================================================================
+// \title  BatchCmdDispatcherTester.hpp
+// \author cindy
+// \brief  hpp file for BatchCmdDispatcher component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_BatchCmdDispatcherTester_HPP
+#define MathModule_BatchCmdDispatcherTester_HPP
+
+#include "BatchCmdDispatcherGTestBase.hpp"
+#include "Components/BatchCmdDispatcher/BatchCmdDispatcher.hpp"
+
+#include <vector>
+
+namespace MathModule {
+
+  class BatchCmdDispatcherTester :
+    public BatchCmdDispatcherGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 100;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Opcodes registered by two components, on compCmdSend ports 0 and 1
+      static const FwOpcodeType OPCODE_A = 0x0E00;
+      static const FwOpcodeType OPCODE_B = 0x0F00;
+
+      //! Context the tests send with each packet
+      static const U32 CONTEXT = 0x1234;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object BatchCmdDispatcherTester
+      BatchCmdDispatcherTester();
+
+      //! Destroy object BatchCmdDispatcherTester
+      ~BatchCmdDispatcherTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! A plain command packet is dispatched and answered as by Svc::CommandDispatcher
+      void testSingleCommand();
+
+      //! A batch is dispatched in windows and answered once, with every command's arguments intact
+      void testBatch();
+
+      //! A failing command stops the rest of its batch and becomes the batch status
+      void testBatchFailure();
+
+      //! Batches with a bad record, an unknown opcode, no commands or a nested batch dispatch nothing
+      void testBatchRejected();
+
+      //! A batch arriving while every batch slot is taken is refused
+      void testTooManyBatches();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Register OPCODE_A on port 0 and OPCODE_B on port 1
+      void registerCommands();
+
+      //! Serialized command packet whose argument is a U32
+      std::vector<U8> commandPacket(FwOpcodeType opcode, U32 arg);
+
+      //! Batch packet holding the given command packets
+      Fw::ComBuffer batchPacket(const std::vector<std::vector<U8> >& commands);
+
+      //! Send a packet on seqCmdBuff port 0 and dispatch it
+      void sendPacket(Fw::ComBuffer& packet);
+
+      //! Answer the command at an index of the compCmdSend history and dispatch the answer
+      void answer(U32 index, Fw::CmdResponse response);
+
+      //! The U32 argument of the command at an index of the compCmdSend history
+      U32 argument(U32 index);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      BatchCmdDispatcher component;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,292 @@
+// ======================================================================
+// \title  ComAggregator.cpp
+// \author cindy
+// \brief  cpp file for ComAggregator component implementation class
+// ======================================================================
+
+#include "Components/ComAggregator/ComAggregator.hpp"
+#include "Components/Tracer/Trace.hpp"
+#include <Fw/Types/Assert.hpp>
+
+namespace MathModule {
+
+  const FwPacketDescriptorType ComAggregator::AGGREGATE_DESCRIPTOR;
+  const U32 ComAggregator::RECORD_HEADER_SIZE;
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  ComAggregator ::
+    ComAggregator(const char* const compName) :
+      ComAggregatorComponentBase(compName),
+      m_count(0),
+      m_hasOverflow(false),
+      m_hasPendingFile(false),
+      m_maxAggregateSize(FW_COM_BUFFER_MAX_SIZE),
+      m_deadlineUsec(0),
+      m_schedPeriodUsec(0),
+      m_schedSeen(false),
+      m_flushDue(false),
+      m_busy(false),
+      m_linkReady(false),
+      m_statusOwed(false),
+      m_upstreamAwaitingLink(true),
+      m_packetsIn(0),
+      m_framesOut(0),
+      m_deadlineFlushes(0)
+  {
+
+  }
+
+  ComAggregator ::
+    ~ComAggregator()
+  {
+
+  }
+
+  /*
+    The aggregate is handed to the framer through its com port, so it is
+    limited by the com buffer capacity even when the framer's buffers are
+    larger.
+  */
+  void ComAggregator ::
+    configure(U32 maxAggregateSize, U32 deadlineMs)
+  {
+    const U32 capacity = static_cast<U32>(this->m_aggregate.getBuffCapacity());
+    this->m_maxAggregateSize = FW_MIN(maxAggregateSize, capacity);
+    FW_ASSERT(this->m_maxAggregateSize > sizeof(FwPacketDescriptorType) + RECORD_HEADER_SIZE,
+              this->m_maxAggregateSize);
+    this->m_deadlineUsec = static_cast<U64>(deadlineMs) * 1000U;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    comIn_handler holds the packet in the aggregate. Unless a frame has to be
+    sent to make room, the com queue gets its status back right away so it can
+    hand over the next packet while this one waits for company. While packets
+    keep arriving the deadline is checked here too, so a busy link does not
+    wait for the next schedIn call.
+  */
+  void ComAggregator ::
+    comIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::ComBuffer& data,
+        U32 context
+    )
+  {
+    MATH_TRACE_SCOPE("comAggregator.comIn");
+    FW_ASSERT(!this->m_statusOwed);
+    FW_ASSERT(!this->m_hasOverflow);
+    this->m_statusOwed = true;
+    ++this->m_packetsIn;
+
+    if ((this->m_count > 0) && (this->ageUsec(this->getTime()) >= this->m_deadlineUsec)) {
+      this->m_flushDue = true;
+    }
+    const U32 length = static_cast<U32>(data.getBuffLength());
+    if (this->fits(length)) {
+      this->append(data);
+    } else {
+      this->m_overflow = data;
+      this->m_hasOverflow = true;
+    }
+    this->drain();
+  }
+
+  void ComAggregator ::
+    bufferIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    MATH_TRACE_SCOPE("comAggregator.bufferIn");
+    FW_ASSERT(!this->m_statusOwed);
+    FW_ASSERT(!this->m_hasPendingFile);
+    this->m_statusOwed = true;
+    this->m_pendingFile = fwBuffer;
+    this->m_hasPendingFile = true;
+    this->drain();
+  }
+
+  void ComAggregator ::
+    comStatusIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Success& condition
+    )
+  {
+    const bool success = (condition.e == Fw::Success::SUCCESS);
+    this->m_linkReady = success;
+
+    if (!this->m_busy) {
+      // Connection status from the com stub, not the answer to a frame
+      if (success && this->m_upstreamAwaitingLink) {
+        this->m_upstreamAwaitingLink = false;
+        this->sendStatus(Fw::Success::SUCCESS);
+      }
+      this->drain();
+      return;
+    }
+
+    this->m_busy = false;
+    if (!success) {
+      // The com queue stops on failure and resumes on the next connection status
+      if (this->m_statusOwed) {
+        this->m_statusOwed = false;
+        this->m_upstreamAwaitingLink = true;
+        this->sendStatus(Fw::Success::FAILURE);
+      }
+      return;
+    }
+    if (this->m_hasOverflow) {
+      this->append(this->m_overflow);
+      this->m_hasOverflow = false;
+    }
+    this->drain();
+  }
+
+  /*
+    schedIn_handler flushes an aggregate that would pass its deadline before
+    the next call, judging the next call by the interval since the last one.
+    A packet is therefore held for at most the larger of the deadline and the
+    schedIn period, rather than for their sum.
+  */
+  void ComAggregator ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    MATH_TRACE_SCOPE("comAggregator.schedIn");
+    const Fw::Time now = this->getTime();
+    if (this->m_schedSeen) {
+      const Fw::Time period = Fw::Time::sub(now, this->m_lastSchedTime);
+      this->m_schedPeriodUsec = static_cast<U64>(period.getSeconds()) * 1000000U + period.getUSeconds();
+    }
+    this->m_lastSchedTime = now;
+    this->m_schedSeen = true;
+
+    if ((this->m_count > 0) && (this->ageUsec(now) + this->m_schedPeriodUsec >= this->m_deadlineUsec)) {
+      this->m_flushDue = true;
+      this->drain();
+    }
+    this->tlmWrite_PACKETS_IN(this->m_packetsIn);
+    this->tlmWrite_FRAMES_OUT(this->m_framesOut);
+    this->tlmWrite_DEADLINE_FLUSHES(this->m_deadlineFlushes);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  bool ComAggregator ::
+    fits(U32 length) const
+  {
+    const U32 used = (this->m_count == 0) ? sizeof(FwPacketDescriptorType)
+                                          : static_cast<U32>(this->m_aggregate.getBuffLength());
+    return used + RECORD_HEADER_SIZE + length <= this->m_maxAggregateSize;
+  }
+
+  U64 ComAggregator ::
+    ageUsec(const Fw::Time& now) const
+  {
+    const Fw::Time age = Fw::Time::sub(now, this->m_firstPacketTime);
+    return static_cast<U64>(age.getSeconds()) * 1000000U + age.getUSeconds();
+  }
+
+  void ComAggregator ::
+    append(const Fw::ComBuffer& data)
+  {
+    Fw::SerializeStatus status = Fw::FW_SERIALIZE_OK;
+    if (this->m_count == 0) {
+      this->m_aggregate.resetSer();
+      status = this->m_aggregate.serialize(AGGREGATE_DESCRIPTOR);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      this->m_firstPacketTime = this->getTime();
+    }
+    const U16 length = static_cast<U16>(data.getBuffLength());
+    status = this->m_aggregate.serialize(length);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = this->m_aggregate.serialize(data.getBuffAddr(), length, true);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    ++this->m_count;
+  }
+
+  void ComAggregator ::
+    sendAggregate()
+  {
+    FW_ASSERT(this->m_count > 0);
+    FW_ASSERT(!this->m_busy);
+
+    this->m_busy = true;
+    ++this->m_framesOut;
+    if (this->m_count == 1) {
+      // A lone packet goes out as-is so the ground sees a normal frame
+      const U32 offset = sizeof(FwPacketDescriptorType) + RECORD_HEADER_SIZE;
+      Fw::ComBuffer single(this->m_aggregate.getBuffAddr() + offset,
+                           static_cast<NATIVE_UINT_TYPE>(this->m_aggregate.getBuffLength() - offset));
+      this->m_count = 0;
+      this->m_flushDue = false;
+      this->comOut_out(0, single, 0);
+      return;
+    }
+    this->m_count = 0;
+    this->m_flushDue = false;
+    this->comOut_out(0, this->m_aggregate, 0);
+  }
+
+  /*
+    drain decides the next downstream action. Ordering rules:
+      - at most one frame is downstream at a time;
+      - a file buffer never overtakes com buffers that arrived before it;
+      - a com buffer that did not fit waits for the aggregate ahead of it, so
+        an aggregate is sent as soon as it cannot take the next packet.
+    When nothing has to go out, the com queue is released.
+  */
+  void ComAggregator ::
+    drain()
+  {
+    if (this->m_busy || !this->m_linkReady) {
+      return;
+    }
+    if (this->m_hasPendingFile) {
+      if (this->m_count > 0) {
+        this->sendAggregate();
+        return;
+      }
+      this->m_hasPendingFile = false;
+      this->m_busy = true;
+      this->bufferOut_out(0, this->m_pendingFile);
+      return;
+    }
+    if (this->m_hasOverflow) {
+      if (this->m_count > 0) {
+        this->sendAggregate();
+        return;
+      }
+      // The aggregate ahead of it was lost with a failed frame
+      this->append(this->m_overflow);
+      this->m_hasOverflow = false;
+    }
+    if (this->m_flushDue && (this->m_count > 0)) {
+      ++this->m_deadlineFlushes;
+      this->sendAggregate();
+      return;
+    }
+    if (this->m_statusOwed) {
+      this->m_statusOwed = false;
+      this->sendStatus(Fw::Success::SUCCESS);
+    }
+  }
+
+  void ComAggregator ::
+    sendStatus(Fw::Success::T status)
+  {
+    Fw::Success condition(status);
+    this->comStatusOut_out(0, condition);
+  }
+
+}
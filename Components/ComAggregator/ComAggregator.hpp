@@ -0,0 +1,171 @@
+// ======================================================================
+// \title  ComAggregator.hpp
+// \author cindy
+// \brief  hpp file for ComAggregator component implementation class
+// ======================================================================
+
+#ifndef MathModule_ComAggregator_HPP
+#define MathModule_ComAggregator_HPP
+
+#include "Components/ComAggregator/ComAggregatorComponentAc.hpp"
+
+namespace MathModule {
+
+  class ComAggregator :
+    public ComAggregatorComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Packet descriptor marking an aggregate. Not used by Fw::ComPacket.
+      static const FwPacketDescriptorType AGGREGATE_DESCRIPTOR = 0xA0;
+
+      //! Size of the length prefix in front of each packet in an aggregate
+      static const U32 RECORD_HEADER_SIZE = sizeof(U16);
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct ComAggregator object
+      ComAggregator(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy ComAggregator object
+      ~ComAggregator();
+
+      //! Set the aggregate size limit and latency deadline
+      void configure(
+          U32 maxAggregateSize, //!< Limit on the aggregate, clamped to the com buffer capacity
+          U32 deadlineMs //!< Maximum time a com buffer is held before its frame is sent; at least the schedIn period
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for comIn
+      void comIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::ComBuffer& data, //!< Buffer containing packet data
+          U32 context //!< Call context value; meaning chosen by user
+      ) override;
+
+      //! Handler implementation for bufferIn
+      void bufferIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for comStatusIn
+      void comStatusIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Success& condition //!< Condition success/failure
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Append a com buffer to the aggregate
+      void append(const Fw::ComBuffer& data);
+
+      //! Whether a com buffer of the given length fits in the aggregate
+      bool fits(U32 length) const;
+
+      //! Time since the first packet entered the aggregate, microseconds
+      U64 ageUsec(const Fw::Time& now) const;
+
+      //! Send the aggregate to the framer, unwrapped if it holds a single packet
+      void sendAggregate();
+
+      //! Send whatever is due downstream, or settle the status owed to the com queue
+      void drain();
+
+      //! Return a status to the com queue
+      void sendStatus(Fw::Success::T status);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Aggregate under construction
+      Fw::ComBuffer m_aggregate;
+
+      //! Packets in the aggregate
+      U32 m_count;
+
+      //! Time the first packet entered the aggregate
+      Fw::Time m_firstPacketTime;
+
+      //! Com buffer that did not fit in the aggregate
+      Fw::ComBuffer m_overflow;
+
+      //! Whether m_overflow holds a packet
+      bool m_hasOverflow;
+
+      //! File buffer waiting for the aggregate ahead of it to be sent
+      Fw::Buffer m_pendingFile;
+
+      //! Whether m_pendingFile holds a buffer
+      bool m_hasPendingFile;
+
+      //! Aggregate size limit in bytes, descriptor included
+      U32 m_maxAggregateSize;
+
+      //! Latency deadline, microseconds
+      U64 m_deadlineUsec;
+
+      //! Time of the last schedIn call
+      Fw::Time m_lastSchedTime;
+
+      //! Interval between the last two schedIn calls, microseconds, or 0 before the second call
+      U64 m_schedPeriodUsec;
+
+      //! Whether schedIn has been called
+      bool m_schedSeen;
+
+      //! Whether the deadline expired with packets still held
+      bool m_flushDue;
+
+      //! Whether a frame is downstream and its status has not arrived
+      bool m_busy;
+
+      //! Whether the link reported ready
+      bool m_linkReady;
+
+      //! Whether the com queue is waiting for a status from this component
+      bool m_statusOwed;
+
+      //! Whether the com queue is waiting for the link to come up
+      bool m_upstreamAwaitingLink;
+
+      //! Telemetry counters
+      U32 m_packetsIn;
+      U32 m_framesOut;
+      U32 m_deadlineFlushes;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+// ======================================================================
+// \title  ComAggregatorTestMain.cpp
+// \author cindy
+// \brief  cpp file for ComAggregator component test main function
+// ======================================================================
+
+#include "ComAggregatorTester.hpp"
+
+TEST(Nominal, Aggregate) {
+  MathModule::ComAggregatorTester tester;
+  tester.testAggregate();
+}
+
+TEST(Nominal, FileOrdering) {
+  MathModule::ComAggregatorTester tester;
+  tester.testFileOrdering();
+}
+
+TEST(Nominal, DeadlineSched) {
+  MathModule::ComAggregatorTester tester;
+  tester.testDeadlineSched();
+}
+
+TEST(Nominal, DeadlineSlowSched) {
+  MathModule::ComAggregatorTester tester;
+  tester.testDeadlineSlowSched();
+}
+
+TEST(Nominal, DeadlineComIn) {
+  MathModule::ComAggregatorTester tester;
+  tester.testDeadlineComIn();
+}
+
+TEST(OffNominal, LinkFailure) {
+  MathModule::ComAggregatorTester tester;
+  tester.testLinkFailure();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
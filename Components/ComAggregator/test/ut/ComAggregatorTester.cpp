@@ -0,0 +1,268 @@
+// ======================================================================
+// \title  ComAggregatorTester.cpp
+// \author cindy
+// \brief  cpp file for ComAggregator component test harness implementation class
+// ======================================================================
+
+#include "ComAggregatorTester.hpp"
+
+namespace MathModule {
+
+  const U32 ComAggregatorTester::PACKET_SIZE;
+  const U32 ComAggregatorTester::PACKETS_PER_AGGREGATE;
+  const U32 ComAggregatorTester::MAX_AGGREGATE_SIZE;
+  const U32 ComAggregatorTester::DEADLINE_MS;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  ComAggregatorTester ::
+    ComAggregatorTester() :
+      ComAggregatorGTestBase("ComAggregatorTester", ComAggregatorTester::MAX_HISTORY_SIZE),
+      component("ComAggregator")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(MAX_AGGREGATE_SIZE, DEADLINE_MS);
+    this->at(0);
+  }
+
+  ComAggregatorTester ::
+    ~ComAggregatorTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void ComAggregatorTester ::
+    testAggregate()
+  {
+    this->linkUp();
+
+    // Each packet that fits is held and released straight back to the com queue
+    for (U8 fill = 1; fill <= PACKETS_PER_AGGREGATE; fill++) {
+      this->sendPacket(fill);
+      ASSERT_from_comStatusOut_SIZE(1 + fill);
+      ASSERT_from_comStatusOut(fill, Fw::Success::SUCCESS);
+    }
+    ASSERT_from_comOut_SIZE(0);
+
+    // The packet that does not fit sends the aggregate ahead of it and waits for its status
+    this->sendPacket(4);
+    ASSERT_from_comOut_SIZE(1);
+    this->expectFrame(0, {1, 2, 3});
+    ASSERT_from_comStatusOut_SIZE(1 + PACKETS_PER_AGGREGATE);
+    this->frameDone(Fw::Success::SUCCESS);
+    ASSERT_from_comStatusOut_SIZE(2 + PACKETS_PER_AGGREGATE);
+    ASSERT_from_comStatusOut(1 + PACKETS_PER_AGGREGATE, Fw::Success::SUCCESS);
+
+    // It starts the next aggregate; alone, it goes out unwrapped
+    this->at(DEADLINE_MS);
+    this->sched();
+    ASSERT_from_comOut_SIZE(2);
+    this->expectFrame(1, {4});
+    ASSERT_TLM_PACKETS_IN(0, 4);
+    ASSERT_TLM_FRAMES_OUT(0, 2);
+    ASSERT_TLM_DEADLINE_FLUSHES(0, 1);
+  }
+
+  void ComAggregatorTester ::
+    testFileOrdering()
+  {
+    this->linkUp();
+    this->sendPacket(1);
+    this->sendPacket(2);
+    ASSERT_from_comStatusOut_SIZE(3);
+
+    // The aggregate ahead of the file goes first
+    U8 data[16] = {};
+    Fw::Buffer file(data, sizeof(data));
+    this->invoke_to_bufferIn(0, file);
+    this->component.doDispatch();
+    ASSERT_from_comOut_SIZE(1);
+    this->expectFrame(0, {1, 2});
+    ASSERT_from_bufferOut_SIZE(0);
+    ASSERT_from_comStatusOut_SIZE(3);
+
+    // Then the file, and only then the status for it
+    this->frameDone(Fw::Success::SUCCESS);
+    ASSERT_from_bufferOut_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_bufferOut->at(0).fwBuffer.getData(), data);
+    ASSERT_from_comStatusOut_SIZE(3);
+    this->frameDone(Fw::Success::SUCCESS);
+    ASSERT_from_comStatusOut_SIZE(4);
+    ASSERT_from_comStatusOut(3, Fw::Success::SUCCESS);
+
+    // With nothing held, a file goes straight out
+    this->invoke_to_bufferIn(0, file);
+    this->component.doDispatch();
+    ASSERT_from_bufferOut_SIZE(2);
+    ASSERT_from_comOut_SIZE(1);
+  }
+
+  void ComAggregatorTester ::
+    testDeadlineSched()
+  {
+    this->linkUp();
+    const U32 period = 30;
+    this->sched();
+    this->at(5);
+    this->sendPacket(1);
+
+    // Held while the next call still comes before the deadline
+    this->at(period);
+    this->sched();
+    this->at(2 * period);
+    this->sched();
+    ASSERT_from_comOut_SIZE(0);
+
+    // Flushed by the last call before the deadline, not the first one after it
+    this->at(3 * period);
+    this->sched();
+    ASSERT_from_comOut_SIZE(1);
+    this->expectFrame(0, {1});
+    ASSERT_TLM_DEADLINE_FLUSHES(this->tlmHistory_DEADLINE_FLUSHES->size() - 1, 1);
+  }
+
+  void ComAggregatorTester ::
+    testDeadlineSlowSched()
+  {
+    this->linkUp();
+    const U32 period = 10 * DEADLINE_MS;
+    this->sched();
+    this->at(period);
+    this->sched();
+
+    // A packet arriving just after a call is held for at most the period
+    this->at(period + 1);
+    this->sendPacket(1);
+    this->sendPacket(2);
+    this->at(2 * period);
+    this->sched();
+    ASSERT_from_comOut_SIZE(1);
+    this->expectFrame(0, {1, 2});
+  }
+
+  void ComAggregatorTester ::
+    testDeadlineComIn()
+  {
+    this->linkUp();
+    this->sendPacket(1);
+    this->at(DEADLINE_MS / 2);
+    this->sendPacket(2);
+    ASSERT_from_comOut_SIZE(0);
+
+    // The next packet after the deadline goes out with the ones held
+    this->at(DEADLINE_MS);
+    this->sendPacket(3);
+    ASSERT_from_comOut_SIZE(1);
+    this->expectFrame(0, {1, 2, 3});
+    this->frameDone(Fw::Success::SUCCESS);
+    this->sched();
+    ASSERT_TLM_DEADLINE_FLUSHES(0, 1);
+  }
+
+  void ComAggregatorTester ::
+    testLinkFailure()
+  {
+    this->linkUp();
+    for (U8 fill = 1; fill <= PACKETS_PER_AGGREGATE + 1; fill++) {
+      this->sendPacket(fill);
+    }
+    ASSERT_from_comOut_SIZE(1);
+    ASSERT_from_comStatusOut_SIZE(1 + PACKETS_PER_AGGREGATE);
+
+    // The com queue is told of the failure and waits for the link
+    this->frameDone(Fw::Success::FAILURE);
+    ASSERT_from_comStatusOut_SIZE(2 + PACKETS_PER_AGGREGATE);
+    ASSERT_from_comStatusOut(1 + PACKETS_PER_AGGREGATE, Fw::Success::FAILURE);
+    this->at(DEADLINE_MS);
+    this->sched();
+    ASSERT_from_comOut_SIZE(1);
+
+    // On reconnection the com queue resumes and the held packet goes out
+    this->linkUp();
+    ASSERT_from_comStatusOut_SIZE(3 + PACKETS_PER_AGGREGATE);
+    ASSERT_from_comStatusOut(2 + PACKETS_PER_AGGREGATE, Fw::Success::SUCCESS);
+    ASSERT_from_comOut_SIZE(1);
+    this->at(2 * DEADLINE_MS);
+    this->sched();
+    ASSERT_from_comOut_SIZE(2);
+    this->expectFrame(1, {4});
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void ComAggregatorTester ::
+    at(U32 ms)
+  {
+    this->setTestTime(Fw::Time(TB_NONE, 1000 + ms / 1000, (ms % 1000) * 1000));
+  }
+
+  void ComAggregatorTester ::
+    linkUp()
+  {
+    this->frameDone(Fw::Success::SUCCESS);
+  }
+
+  void ComAggregatorTester ::
+    sendPacket(U8 fill)
+  {
+    U8 data[PACKET_SIZE];
+    for (U32 i = 0; i < PACKET_SIZE; i++) {
+      data[i] = fill;
+    }
+    Fw::ComBuffer packet(data, PACKET_SIZE);
+    this->invoke_to_comIn(0, packet, 0);
+    this->component.doDispatch();
+  }
+
+  void ComAggregatorTester ::
+    frameDone(Fw::Success::T status)
+  {
+    Fw::Success condition(status);
+    this->invoke_to_comStatusIn(0, condition);
+    this->component.doDispatch();
+  }
+
+  void ComAggregatorTester ::
+    sched()
+  {
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+  }
+
+  void ComAggregatorTester ::
+    expectFrame(U32 index, const std::vector<U8>& fills)
+  {
+    ASSERT_LT(index, this->fromPortHistory_comOut->size());
+    Fw::ComBuffer frame = this->fromPortHistory_comOut->at(index).data;
+    frame.resetDeser();
+    if (fills.size() > 1) {
+      FwPacketDescriptorType descriptor = 0;
+      ASSERT_EQ(frame.deserialize(descriptor), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(descriptor, ComAggregator::AGGREGATE_DESCRIPTOR);
+    }
+    for (const U8 fill : fills) {
+      if (fills.size() > 1) {
+        U16 length = 0;
+        ASSERT_EQ(frame.deserialize(length), Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(length, PACKET_SIZE);
+      }
+      ASSERT_GE(frame.getBuffLeft(), PACKET_SIZE);
+      for (U32 i = 0; i < PACKET_SIZE; i++) {
+        U8 byte = 0;
+        ASSERT_EQ(frame.deserialize(byte), Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(byte, fill) << "frame " << index;
+      }
+    }
+    EXPECT_EQ(frame.getBuffLeft(), 0U);
+  }
+
+}
@@ -0,0 +1,131 @@
+// ======================================================================
+// \title  ComAggregatorTester.hpp
+// \author cindy
+// \brief  hpp file for ComAggregator component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_ComAggregatorTester_HPP
+#define MathModule_ComAggregatorTester_HPP
+
+#include "ComAggregatorGTestBase.hpp"
+#include "Components/ComAggregator/ComAggregator.hpp"
+
+#include <vector>
+
+namespace MathModule {
+
+  class ComAggregatorTester :
+    public ComAggregatorGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Size of every com packet sent
+      static const U32 PACKET_SIZE = 10;
+
+      //! Packets that fit in one aggregate
+      static const U32 PACKETS_PER_AGGREGATE = 3;
+
+      //! Aggregate size limit, exactly PACKETS_PER_AGGREGATE packets
+      static const U32 MAX_AGGREGATE_SIZE =
+        sizeof(FwPacketDescriptorType) + PACKETS_PER_AGGREGATE * (ComAggregator::RECORD_HEADER_SIZE + PACKET_SIZE);
+
+      //! Latency deadline, milliseconds
+      static const U32 DEADLINE_MS = 100;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object ComAggregatorTester
+      ComAggregatorTester();
+
+      //! Destroy object ComAggregatorTester
+      ~ComAggregatorTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Packets are held until the aggregate is full; the one that did not fit follows it
+      void testAggregate();
+
+      //! A file buffer waits for the com packets that arrived before it
+      void testFileOrdering();
+
+      //! schedIn flushes an aggregate that would pass its deadline before the next call
+      void testDeadlineSched();
+
+      //! With a schedIn period longer than the deadline, the next call flushes
+      void testDeadlineSlowSched();
+
+      //! A packet arriving after the deadline flushes without waiting for schedIn
+      void testDeadlineComIn();
+
+      //! A failed frame stops the com queue until the link reports ready again
+      void testLinkFailure();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Set the test time to a number of milliseconds after the start
+      void at(U32 ms);
+
+      //! Report the link ready, as the com stub does on connection
+      void linkUp();
+
+      //! Send a com packet filled with one value
+      void sendPacket(U8 fill);
+
+      //! Answer the frame downstream with a status
+      void frameDone(Fw::Success::T status);
+
+      //! Call schedIn
+      void sched();
+
+      //! Check that a frame holds the packets filled with the given values, in order
+      void expectFrame(
+          U32 index, //!< Index of the frame in the comOut history
+          const std::vector<U8>& fills //!< Fill value of each packet
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      ComAggregator component;
+
+  };
+
+}
+
+#endif
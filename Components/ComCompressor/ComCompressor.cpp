@@ -0,0 +1,185 @@
+// ======================================================================
+// \title  ComCompressor.cpp
+// \author cindy
+// \brief  cpp file for ComCompressor component implementation class
+// ======================================================================
+
+#include "Components/ComCompressor/ComCompressor.hpp"
+#include "Components/Tracer/Trace.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cstring>
+#include <time.h>
+
+namespace MathModule {
+
+  const FwPacketDescriptorType ComCompressor::COMPRESSED_DESCRIPTOR;
+  const U8 ComCompressor::COMPRESSED_FILE_MARKER;
+  const U32 ComCompressor::ORIGINAL_SIZE_SIZE;
+  const U32 ComCompressor::MAX_FILE_PACKET_SIZE;
+
+  static_assert(FW_COM_BUFFER_MAX_SIZE <= Lz4Block::MAX_INPUT_SIZE,
+                "Com packets must fit an LZ4 block and a U16 original size");
+  static_assert(ComCompressor::MAX_FILE_PACKET_SIZE <= Lz4Block::MAX_INPUT_SIZE,
+                "File packets must fit an LZ4 block and a U16 original size");
+
+  namespace {
+
+    U64 threadCpuNs()
+    {
+      struct timespec now;
+      (void) ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+      return static_cast<U64>(now.tv_sec) * 1000000000U + static_cast<U64>(now.tv_nsec);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  ComCompressor ::
+    ComCompressor(const char* const compName) :
+      ComCompressorComponentBase(compName),
+      m_enabled(false),
+      m_cpuNs(0),
+      m_bytesIn(0),
+      m_bytesOut(0),
+      m_incompressible(0)
+  {
+
+  }
+
+  ComCompressor ::
+    ~ComCompressor()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    A com packet, usually an aggregate, is compressed as one LZ4 block. Its
+    telemetry and event packets repeat descriptors, channel ids and time
+    bases, which the block finds as matches within the frame. Nothing is
+    carried between frames, so a lost frame costs only its own packets.
+  */
+  void ComCompressor ::
+    comIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::ComBuffer& data,
+        U32 context
+    )
+  {
+    MATH_TRACE_SCOPE("comCompressor.comIn");
+    if (!this->m_enabled) {
+      this->comOut_out(0, data, context);
+      return;
+    }
+    const U32 size = static_cast<U32>(data.getBuffLength());
+    const U32 compressed = this->compress(data.getBuffAddr(), size, this->m_compressed.getBuffAddr(),
+                                          sizeof(FwPacketDescriptorType) + ORIGINAL_SIZE_SIZE);
+    if (compressed == 0) {
+      this->comOut_out(0, data, context);
+      return;
+    }
+    this->m_compressed.resetSer();
+    Fw::SerializeStatus status = this->m_compressed.serialize(COMPRESSED_DESCRIPTOR);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = this->m_compressed.serialize(static_cast<U16>(size));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = this->m_compressed.setBuffLen(compressed);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    this->comOut_out(0, this->m_compressed, context);
+  }
+
+  /*
+    The framer puts the file descriptor in front of a file buffer itself, so
+    a compressed file packet is marked by its first byte instead. The
+    compressed bytes are copied over the original, which stays owned by
+    fileDownlink and is returned to it as usual.
+  */
+  void ComCompressor ::
+    bufferIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    const U32 size = fwBuffer.getSize();
+    if (this->m_enabled && (size <= MAX_FILE_PACKET_SIZE)) {
+      const U32 compressed = this->compress(fwBuffer.getData(), size, this->m_fileScratch,
+                                            sizeof(U8) + ORIGINAL_SIZE_SIZE);
+      if (compressed > 0) {
+        this->m_fileScratch[0] = COMPRESSED_FILE_MARKER;
+        this->m_fileScratch[1] = static_cast<U8>(size >> 8);
+        this->m_fileScratch[2] = static_cast<U8>(size);
+        ::memcpy(fwBuffer.getData(), this->m_fileScratch, compressed);
+        fwBuffer.setSize(compressed);
+      }
+    }
+    this->bufferOut_out(0, fwBuffer);
+  }
+
+  void ComCompressor ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->tlmWrite_BYTES_IN(this->m_bytesIn);
+    this->tlmWrite_BYTES_OUT(this->m_bytesOut);
+    if (this->m_bytesOut > 0) {
+      this->tlmWrite_COMPRESSION_RATIO(static_cast<F32>(this->m_bytesIn) / static_cast<F32>(this->m_bytesOut));
+      this->tlmWrite_CPU_NS_PER_BYTE(static_cast<F32>(this->m_cpuNs) / static_cast<F32>(this->m_bytesIn));
+    }
+    this->tlmWrite_INCOMPRESSIBLE(this->m_incompressible);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  void ComCompressor ::
+    SET_COMPRESSION_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        Fw::Enabled enable
+    )
+  {
+    this->m_enabled = (enable == Fw::Enabled::ENABLED);
+    this->log_ACTIVITY_HI_COMPRESSION_SET(enable);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    The block gets one byte less than the packet minus the header, so a
+    packet is only replaced when that saves at least a byte. CPU time is
+    taken from the calling thread's clock, which excludes time the thread
+    was preempted.
+  */
+  U32 ComCompressor ::
+    compress(const U8* packet, U32 size, U8* destination, U32 headerSize)
+  {
+    this->m_bytesIn += size;
+    U32 block = 0;
+    if (size > headerSize + 1) {
+      const U64 start = threadCpuNs();
+      block = Lz4Block::compress(this->m_table, packet, size, destination + headerSize, size - headerSize - 1);
+      this->m_cpuNs += threadCpuNs() - start;
+    }
+    if (block == 0) {
+      ++this->m_incompressible;
+      this->m_bytesOut += size;
+      return 0;
+    }
+    this->m_bytesOut += headerSize + block;
+    return headerSize + block;
+  }
+
+}
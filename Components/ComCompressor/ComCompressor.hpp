@@ -0,0 +1,134 @@
+// ======================================================================
+// \title  ComCompressor.hpp
+// \author cindy
+// \brief  hpp file for ComCompressor component implementation class
+// ======================================================================
+
+#ifndef MathModule_ComCompressor_HPP
+#define MathModule_ComCompressor_HPP
+
+#include "Components/ComCompressor/ComCompressorComponentAc.hpp"
+#include "Components/ComCompressor/Lz4Block.hpp"
+
+namespace MathModule {
+
+  class ComCompressor :
+    public ComCompressorComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Packet descriptor marking a compressed com packet. Not used by Fw::ComPacket.
+      static const FwPacketDescriptorType COMPRESSED_DESCRIPTOR = 0xA1;
+
+      //! First byte of a compressed file packet. Not a Fw::FilePacket type.
+      static const U8 COMPRESSED_FILE_MARKER = 0xA1;
+
+      //! Size of the original packet length in front of the LZ4 block
+      static const U32 ORIGINAL_SIZE_SIZE = sizeof(U16);
+
+      //! Largest file packet compressed; larger ones are sent unchanged
+      static const U32 MAX_FILE_PACKET_SIZE = FW_FILE_BUFFER_MAX_SIZE;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct ComCompressor object
+      ComCompressor(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy ComCompressor object
+      ~ComCompressor();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for comIn
+      void comIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::ComBuffer& data, //!< Buffer containing packet data
+          U32 context //!< Call context value; meaning chosen by user
+      ) override;
+
+      //! Handler implementation for bufferIn
+      void bufferIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command SET_COMPRESSION
+      void SET_COMPRESSION_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq, //!< The command sequence number
+          Fw::Enabled enable //!< Whether to compress
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Compress a packet behind a header, timing the work
+      //! \return the size of header and block, or 0 if that is not smaller than the packet
+      U32 compress(
+          const U8* packet, //!< The packet
+          U32 size, //!< Bytes in the packet
+          U8* destination, //!< Output, starting with headerSize bytes for the caller to fill
+          U32 headerSize //!< Bytes reserved in front of the block
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Whether packets are compressed
+      bool m_enabled;
+
+      //! Match finder state
+      Lz4Block::HashTable m_table;
+
+      //! Compressed com packet
+      Fw::ComBuffer m_compressed;
+
+      //! Compressed file packet, copied back over the original
+      U8 m_fileScratch[MAX_FILE_PACKET_SIZE];
+
+      //! Thread CPU time spent compressing, nanoseconds
+      U64 m_cpuNs;
+
+      //! Telemetry counters
+      U64 m_bytesIn;
+      U64 m_bytesOut;
+      U32 m_incompressible;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+// ======================================================================
+// \title  Lz4Block.cpp
+// \author cindy
+// \brief  LZ4 block format encoder and decoder for downlink packets
+// ======================================================================
+
+#include "Components/ComCompressor/Lz4Block.hpp"
+
+#include <cstring>
+
+namespace MathModule {
+
+  namespace Lz4Block {
+
+    namespace {
+
+      //! Shortest match the format encodes
+      const uint32_t MIN_MATCH = 4;
+
+      //! The last bytes of a block are always literals
+      const uint32_t LAST_LITERALS = 5;
+
+      //! The last match starts at least this far from the end of the block
+      const uint32_t MATCH_FIND_LIMIT = 12;
+
+      //! Length nibble value meaning more length bytes follow
+      const uint32_t RUN_MASK = 15;
+
+      uint32_t read32(const uint8_t* p)
+      {
+        uint32_t value;
+        ::memcpy(&value, p, sizeof(value));
+        return value;
+      }
+
+      uint32_t hash(uint32_t sequence)
+      {
+        return (sequence * 2654435761U) >> (32 - HASH_LOG);
+      }
+
+      //! Appends to the output, refusing to write past its capacity
+      class Writer {
+        public:
+          Writer(uint8_t* destination, uint32_t capacity) :
+            m_destination(destination),
+            m_capacity(capacity),
+            m_size(0),
+            m_full(false)
+          {
+
+          }
+
+          void byte(uint32_t value)
+          {
+            if (this->m_size >= this->m_capacity) {
+              this->m_full = true;
+              return;
+            }
+            this->m_destination[this->m_size++] = static_cast<uint8_t>(value);
+          }
+
+          void bytes(const uint8_t* data, uint32_t size)
+          {
+            if (size > this->m_capacity - this->m_size) {
+              this->m_full = true;
+              return;
+            }
+            ::memcpy(this->m_destination + this->m_size, data, size);
+            this->m_size += size;
+          }
+
+          //! Length beyond the token nibble: 255 while more follows, then the rest
+          void length(uint32_t value)
+          {
+            for (; value >= 255; value -= 255) {
+              this->byte(255);
+            }
+            this->byte(value);
+          }
+
+          //! Token, literals and, unless this is the last sequence, the match
+          void sequence(const uint8_t* literals, uint32_t literalLength, uint32_t offset, uint32_t matchLength)
+          {
+            const uint32_t literalCode = (literalLength < RUN_MASK) ? literalLength : RUN_MASK;
+            const uint32_t matchCode = (offset == 0) ? 0
+                : ((matchLength - MIN_MATCH < RUN_MASK) ? matchLength - MIN_MATCH : RUN_MASK);
+            this->byte((literalCode << 4) | matchCode);
+            if (literalCode == RUN_MASK) {
+              this->length(literalLength - RUN_MASK);
+            }
+            this->bytes(literals, literalLength);
+            if (offset == 0) {
+              return;
+            }
+            this->byte(offset & 0xFF);
+            this->byte(offset >> 8);
+            if (matchCode == RUN_MASK) {
+              this->length(matchLength - MIN_MATCH - RUN_MASK);
+            }
+          }
+
+          uint8_t* m_destination;
+          uint32_t m_capacity;
+          uint32_t m_size;
+          bool m_full;
+      };
+
+      //! Reads a length continued past the token nibble
+      bool readLength(const uint8_t* source, uint32_t size, uint32_t& in, uint32_t& length)
+      {
+        uint32_t next;
+        do {
+          if (in >= size) {
+            return false;
+          }
+          next = source[in++];
+          length += next;
+        } while (next == 255);
+        return true;
+      }
+
+    }
+
+    /*
+      Greedy parse: each position is hashed on its next four bytes and
+      checked against the last position with the same hash. A match is
+      extended back over pending literals and forward as far as the format
+      allows, then the search resumes after it. Packets are small, so every
+      position is tried rather than skipping ahead on incompressible runs.
+    */
+    uint32_t compress(HashTable& table, const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t capacity)
+    {
+      if (size > MAX_INPUT_SIZE) {
+        return 0;
+      }
+      ::memset(table.positions, 0, sizeof(table.positions));
+      Writer writer(destination, capacity);
+      uint32_t anchor = 0;
+
+      if (size > MATCH_FIND_LIMIT) {
+        const uint32_t matchLimit = size - LAST_LITERALS;
+        const uint32_t findLimit = size - MATCH_FIND_LIMIT;
+        uint32_t position = 1;
+        while ((position <= findLimit) && !writer.m_full) {
+          const uint32_t sequence = read32(source + position);
+          uint16_t& slot = table.positions[hash(sequence)];
+          uint32_t reference = slot;
+          slot = static_cast<uint16_t>(position);
+          if (read32(source + reference) != sequence) {
+            position++;
+            continue;
+          }
+          while ((position > anchor) && (reference > 0) && (source[position - 1] == source[reference - 1])) {
+            position--;
+            reference--;
+          }
+          uint32_t length = MIN_MATCH;
+          while ((position + length < matchLimit) && (source[position + length] == source[reference + length])) {
+            length++;
+          }
+          writer.sequence(source + anchor, position - anchor, position - reference, length);
+          position += length;
+          anchor = position;
+          if (position - 2 <= findLimit) {
+            table.positions[hash(read32(source + position - 2))] = static_cast<uint16_t>(position - 2);
+          }
+        }
+      }
+
+      writer.sequence(source + anchor, size - anchor, 0, 0);
+      return writer.m_full ? 0 : writer.m_size;
+    }
+
+    int32_t decompress(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t capacity)
+    {
+      uint32_t in = 0;
+      uint32_t out = 0;
+      while (in < size) {
+        const uint32_t token = source[in++];
+        uint32_t literalLength = token >> 4;
+        if ((literalLength == RUN_MASK) && !readLength(source, size, in, literalLength)) {
+          return -1;
+        }
+        if ((literalLength > size - in) || (literalLength > capacity - out)) {
+          return -1;
+        }
+        ::memcpy(destination + out, source + in, literalLength);
+        in += literalLength;
+        out += literalLength;
+        if (in == size) {
+          return static_cast<int32_t>(out);
+        }
+
+        if (size - in < 2) {
+          return -1;
+        }
+        const uint32_t offset = source[in] | (static_cast<uint32_t>(source[in + 1]) << 8);
+        in += 2;
+        uint32_t matchLength = token & RUN_MASK;
+        if ((matchLength == RUN_MASK) && !readLength(source, size, in, matchLength)) {
+          return -1;
+        }
+        matchLength += MIN_MATCH;
+        if ((offset == 0) || (offset > out) || (matchLength > capacity - out)) {
+          return -1;
+        }
+        // Byte by byte: the match may overlap the bytes it produces
+        for (uint32_t i = 0; i < matchLength; i++, out++) {
+          destination[out] = destination[out - offset];
+        }
+      }
+      return -1;
+    }
+
+  }
+
+}
@@ -0,0 +1,56 @@
+// ======================================================================
+// \title  Lz4Block.hpp
+// \author cindy
+// \brief  LZ4 block format encoder and decoder for downlink packets
+//
+// Blocks follow the LZ4 block format, so any LZ4 decoder (lz4.block in
+// Python, LZ4_decompress_safe in C) reads them. Each block is compressed
+// on its own: matches only reach back within the same block, so a lost
+// frame never prevents decoding the next one. This file only depends on
+// the C++ standard library so ground tools can build it without F´.
+// ======================================================================
+
+#ifndef MathModule_Lz4Block_HPP
+#define MathModule_Lz4Block_HPP
+
+#include <cstdint>
+
+namespace MathModule {
+
+  namespace Lz4Block {
+
+    //! Largest input compress accepts, the reach of a match offset
+    static const uint32_t MAX_INPUT_SIZE = 0xFFFF;
+
+    //! log2 of the number of match finder slots
+    static const uint32_t HASH_LOG = 11;
+
+    //! Match finder state. Reset by every compress call.
+    struct HashTable {
+      uint16_t positions[1U << HASH_LOG];
+    };
+
+    //! Compress a block
+    //! \return the compressed size, or 0 if it does not fit in capacity or the input is too large
+    uint32_t compress(
+        HashTable& table, //!< Scratch state
+        const uint8_t* source, //!< Input
+        uint32_t size, //!< Input bytes, at most MAX_INPUT_SIZE
+        uint8_t* destination, //!< Output
+        uint32_t capacity //!< Output bytes available
+    );
+
+    //! Decompress a block
+    //! \return the decompressed size, or -1 if the block is malformed or does not fit in capacity
+    int32_t decompress(
+        const uint8_t* source, //!< Block
+        uint32_t size, //!< Block bytes
+        uint8_t* destination, //!< Output
+        uint32_t capacity //!< Output bytes available
+    );
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,84 @@
+// ======================================================================
+// \title  ComCompressorTestMain.cpp
+// \author cindy
+// \brief  cpp file for ComCompressor component test main function
+// ======================================================================
+
+#include "ComCompressorTester.hpp"
+
+namespace {
+
+  std::vector<U8> testData(U32 size, U32 seed, U32 alphabet)
+  {
+    std::vector<U8> data(size);
+    U32 state = seed;
+    for (U32 i = 0; i < size; i++) {
+      state = state * 1103515245 + 12345;
+      data[i] = static_cast<U8>((state >> 16) % alphabet);
+    }
+    return data;
+  }
+
+}
+
+TEST(Lz4Block, RoundTrip) {
+  MathModule::Lz4Block::HashTable table;
+  const U32 alphabets[] = {1, 2, 16, 256};
+  for (const U32 alphabet : alphabets) {
+    for (U32 size = 0; size < 2000; size += (size < 40) ? 1 : 97) {
+      const std::vector<U8> data = testData(size, size + alphabet, alphabet);
+      // Worst case growth of the format
+      std::vector<U8> block(size + size / 255 + 16);
+      const U32 compressed = MathModule::Lz4Block::compress(table, data.data(), size, block.data(),
+                                                            static_cast<U32>(block.size()));
+      ASSERT_GT(compressed, 0U) << "size " << size << " alphabet " << alphabet;
+      std::vector<U8> decompressed(size);
+      ASSERT_EQ(MathModule::Lz4Block::decompress(block.data(), compressed, decompressed.data(), size),
+                static_cast<I32>(size)) << "size " << size << " alphabet " << alphabet;
+      EXPECT_EQ(decompressed, data);
+    }
+  }
+}
+
+TEST(Lz4Block, Limits) {
+  MathModule::Lz4Block::HashTable table;
+  const std::vector<U8> data = testData(300, 1, 256);
+  std::vector<U8> block(400);
+  // Random bytes do not fit in less than their own size
+  EXPECT_EQ(MathModule::Lz4Block::compress(table, data.data(), 300, block.data(), 299), 0U);
+
+  const std::vector<U8> runs = testData(300, 1, 1);
+  const U32 compressed = MathModule::Lz4Block::compress(table, runs.data(), 300, block.data(), 400);
+  ASSERT_GT(compressed, 0U);
+  std::vector<U8> small(299);
+  EXPECT_EQ(MathModule::Lz4Block::decompress(block.data(), compressed, small.data(), 299), -1);
+  EXPECT_EQ(MathModule::Lz4Block::decompress(block.data(), compressed - 1, small.data(), 299), -1);
+  // A match reaching before the start of the output
+  const U8 bad[] = {0x10, 'a', 0x02, 0x00, 0x00};
+  EXPECT_EQ(MathModule::Lz4Block::decompress(bad, sizeof(bad), small.data(), 299), -1);
+}
+
+TEST(Nominal, Disabled) {
+  MathModule::ComCompressorTester tester;
+  tester.testDisabled();
+}
+
+TEST(Nominal, CompressCom) {
+  MathModule::ComCompressorTester tester;
+  tester.testCompressCom();
+}
+
+TEST(Nominal, CompressFile) {
+  MathModule::ComCompressorTester tester;
+  tester.testCompressFile();
+}
+
+TEST(OffNominal, Incompressible) {
+  MathModule::ComCompressorTester tester;
+  tester.testIncompressible();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,188 @@
+// ======================================================================
+// \title  ComCompressorTester.cpp
+// \author cindy
+// \brief  cpp file for ComCompressor component test harness implementation class
+// ======================================================================
+
+#include "ComCompressorTester.hpp"
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  ComCompressorTester ::
+    ComCompressorTester() :
+      ComCompressorGTestBase("ComCompressorTester", ComCompressorTester::MAX_HISTORY_SIZE),
+      component("ComCompressor")
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  ComCompressorTester ::
+    ~ComCompressorTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void ComCompressorTester ::
+    testDisabled()
+  {
+    const std::vector<U8> aggregate = this->telemetryAggregate();
+    Fw::ComBuffer packet(aggregate.data(), static_cast<NATIVE_UINT_TYPE>(aggregate.size()));
+    this->invoke_to_comIn(0, packet, 7);
+    ASSERT_from_comOut_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_comOut->at(0).data, packet);
+    EXPECT_EQ(this->fromPortHistory_comOut->at(0).context, 7U);
+
+    std::vector<U8> file(aggregate);
+    Fw::Buffer buffer(file.data(), static_cast<U32>(file.size()));
+    this->invoke_to_bufferIn(0, buffer);
+    ASSERT_from_bufferOut_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_bufferOut->at(0).fwBuffer.getSize(), aggregate.size());
+    EXPECT_EQ(file, aggregate);
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_BYTES_IN(0, 0);
+    ASSERT_TLM_BYTES_OUT(0, 0);
+    ASSERT_TLM_COMPRESSION_RATIO_SIZE(0);
+  }
+
+  void ComCompressorTester ::
+    testCompressCom()
+  {
+    this->setCompression(Fw::Enabled::ENABLED);
+    const std::vector<U8> aggregate = this->telemetryAggregate();
+    Fw::ComBuffer packet(aggregate.data(), static_cast<NATIVE_UINT_TYPE>(aggregate.size()));
+    this->invoke_to_comIn(0, packet, 7);
+    ASSERT_from_comOut_SIZE(1);
+    Fw::ComBuffer& out = this->fromPortHistory_comOut->at(0).data;
+    EXPECT_EQ(this->fromPortHistory_comOut->at(0).context, 7U);
+
+    FwPacketDescriptorType descriptor = 0;
+    U16 originalSize = 0;
+    ASSERT_EQ(out.deserialize(descriptor), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(out.deserialize(originalSize), Fw::FW_SERIALIZE_OK);
+    EXPECT_EQ(descriptor, ComCompressor::COMPRESSED_DESCRIPTOR);
+    EXPECT_EQ(originalSize, aggregate.size());
+    const U32 headerSize = sizeof(FwPacketDescriptorType) + ComCompressor::ORIGINAL_SIZE_SIZE;
+    // Repeated descriptors, channel ids and times compress well
+    EXPECT_LT(out.getBuffLength(), aggregate.size() / 2);
+    EXPECT_EQ(this->decompress(out.getBuffAddr() + headerSize, out.getBuffLength() - headerSize, originalSize),
+              aggregate);
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_BYTES_IN(0, aggregate.size());
+    ASSERT_TLM_BYTES_OUT(0, out.getBuffLength());
+    ASSERT_TLM_COMPRESSION_RATIO(0, static_cast<F32>(aggregate.size()) / static_cast<F32>(out.getBuffLength()));
+    ASSERT_TLM_CPU_NS_PER_BYTE_SIZE(1);
+    ASSERT_TLM_INCOMPRESSIBLE(0, 0);
+
+    // Off again: unchanged, and not counted
+    this->setCompression(Fw::Enabled::DISABLED);
+    this->invoke_to_comIn(0, packet, 0);
+    ASSERT_from_comOut_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_comOut->at(0).data, packet);
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_BYTES_IN_SIZE(0);
+  }
+
+  void ComCompressorTester ::
+    testIncompressible()
+  {
+    this->setCompression(Fw::Enabled::ENABLED);
+    std::vector<U8> noise(200);
+    U32 state = 1;
+    for (U32 i = 0; i < noise.size(); i++) {
+      state = state * 1103515245 + 12345;
+      noise[i] = static_cast<U8>(state >> 16);
+    }
+    Fw::ComBuffer packet(noise.data(), static_cast<NATIVE_UINT_TYPE>(noise.size()));
+    this->invoke_to_comIn(0, packet, 0);
+    const U8 tiny[] = {0, 0, 0, 1, 0x42};
+    Fw::ComBuffer tinyPacket(tiny, sizeof(tiny));
+    this->invoke_to_comIn(0, tinyPacket, 0);
+
+    ASSERT_from_comOut_SIZE(2);
+    EXPECT_EQ(this->fromPortHistory_comOut->at(0).data, packet);
+    EXPECT_EQ(this->fromPortHistory_comOut->at(1).data, tinyPacket);
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_INCOMPRESSIBLE(0, 2);
+    ASSERT_TLM_COMPRESSION_RATIO(0, 1.0f);
+  }
+
+  void ComCompressorTester ::
+    testCompressFile()
+  {
+    this->setCompression(Fw::Enabled::ENABLED);
+    // A data packet of a text file: type, sequence, offset, size, then the data
+    std::vector<U8> original;
+    const U8 header[] = {1, 0, 0, 0, 3, 0, 0, 0x10, 0, 0x01, 0x90};
+    original.insert(original.end(), header, header + sizeof(header));
+    const char line[] = "DO_MATH 1.0 ADD 2.0 -> 3.0\n";
+    while (original.size() < 11 + 400) {
+      original.insert(original.end(), line, line + sizeof(line) - 1);
+    }
+    std::vector<U8> storage(original);
+    Fw::Buffer buffer(storage.data(), static_cast<U32>(storage.size()), 5);
+    this->invoke_to_bufferIn(0, buffer);
+
+    ASSERT_from_bufferOut_SIZE(1);
+    const Fw::Buffer& out = this->fromPortHistory_bufferOut->at(0).fwBuffer;
+    EXPECT_EQ(out.getData(), storage.data());
+    EXPECT_EQ(out.getContext(), 5U);
+    ASSERT_LT(out.getSize(), original.size() / 4);
+    EXPECT_EQ(storage[0], ComCompressor::COMPRESSED_FILE_MARKER);
+    const U32 originalSize = (static_cast<U32>(storage[1]) << 8) | storage[2];
+    EXPECT_EQ(originalSize, original.size());
+    EXPECT_EQ(this->decompress(storage.data() + 3, out.getSize() - 3, originalSize), original);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void ComCompressorTester ::
+    setCompression(Fw::Enabled enable)
+  {
+    this->clearHistory();
+    this->sendCmd_SET_COMPRESSION(0, 12, enable);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, ComCompressor::OPCODE_SET_COMPRESSION, 12, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_COMPRESSION_SET(0, enable);
+  }
+
+  std::vector<U8> ComCompressorTester ::
+    telemetryAggregate()
+  {
+    Fw::ComBuffer aggregate;
+    EXPECT_EQ(aggregate.serialize(static_cast<FwPacketDescriptorType>(0xA0)), Fw::FW_SERIALIZE_OK);
+    for (U32 i = 0; i < 16; i++) {
+      Fw::ComBuffer packet;
+      EXPECT_EQ(packet.serialize(static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_TELEM)),
+                Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(packet.serialize(static_cast<FwChanIdType>(0x0E00 + i % 4)), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(packet.serialize(Fw::Time(TB_PROC_TIME, 0, 1700000000, 1000 * i)), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(packet.serialize(static_cast<F32>(i) * 0.5f), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(aggregate.serialize(static_cast<U16>(packet.getBuffLength())), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(aggregate.serialize(packet.getBuffAddr(), packet.getBuffLength(), true), Fw::FW_SERIALIZE_OK);
+    }
+    return std::vector<U8>(aggregate.getBuffAddr(), aggregate.getBuffAddr() + aggregate.getBuffLength());
+  }
+
+  std::vector<U8> ComCompressorTester ::
+    decompress(const U8* block, U32 size, U32 originalSize)
+  {
+    std::vector<U8> original(originalSize);
+    const I32 decompressed = Lz4Block::decompress(block, size, original.data(), originalSize);
+    EXPECT_EQ(decompressed, static_cast<I32>(originalSize));
+    return original;
+  }
+
+}
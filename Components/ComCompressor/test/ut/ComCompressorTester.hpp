@@ -0,0 +1,100 @@
+// ======================================================================
+// \title  ComCompressorTester.hpp
+// \author cindy
+// \brief  hpp file for ComCompressor component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_ComCompressorTester_HPP
+#define MathModule_ComCompressorTester_HPP
+
+#include "ComCompressorGTestBase.hpp"
+#include "Components/ComCompressor/ComCompressor.hpp"
+
+#include <vector>
+
+namespace MathModule {
+
+  class ComCompressorTester :
+    public ComCompressorGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object ComCompressorTester
+      ComCompressorTester();
+
+      //! Destroy object ComCompressorTester
+      ~ComCompressorTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Packets pass unchanged until compression is turned on
+      void testDisabled();
+
+      //! An aggregate of telemetry packets is compressed and decompresses to the original
+      void testCompressCom();
+
+      //! A packet compression does not shrink is sent unchanged and counted
+      void testIncompressible();
+
+      //! A file packet is compressed in place behind the marker byte
+      void testCompressFile();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Turn compression on or off
+      void setCompression(Fw::Enabled enable);
+
+      //! An aggregate of TlmChan packets, as comAggregator builds them
+      std::vector<U8> telemetryAggregate();
+
+      //! Decompress a block as the ground does
+      std::vector<U8> decompress(const U8* block, U32 size, U32 originalSize);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      ComCompressor component;
+
+  };
+
+}
+
+#endif
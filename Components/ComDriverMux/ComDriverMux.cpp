@@ -0,0 +1,100 @@
+// ======================================================================
+// \title  ComDriverMux.cpp
+// \author cindy
+// \brief  cpp file for ComDriverMux component implementation class
+// ======================================================================
+
+#include "Components/ComDriverMux/ComDriverMux.hpp"
+#include <Fw/Types/Assert.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  ComDriverMux ::
+    ComDriverMux(const char* const compName) :
+      ComDriverMuxComponentBase(compName),
+      m_driver(ComDriverKind::TCP)
+  {
+
+  }
+
+  ComDriverMux ::
+    ~ComDriverMux()
+  {
+
+  }
+
+  void ComDriverMux ::
+    setDriver(const ComDriverKind& driver)
+  {
+    FW_ASSERT(driver.isValid(), driver.e);
+    this->m_driver = driver;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    Drivers own and deallocate buffers they accept. A buffer that cannot reach
+    the selected driver is returned here instead, so comStub sees the same
+    contract as when it is wired to a driver directly.
+  */
+  Drv::SendStatus ComDriverMux ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    const NATIVE_INT_TYPE slot = static_cast<NATIVE_INT_TYPE>(this->m_driver.e);
+    if (!this->isConnected_drvSend_OutputPort(slot)) {
+      this->deallocate_out(0, sendBuffer);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+    return this->drvSend_out(slot, sendBuffer);
+  }
+
+  /*
+    Only the Ethernet-framed drivers carry compact telemetry. With any other
+    driver selected the packet is returned like an unconnected send.
+  */
+  Drv::SendStatus ComDriverMux ::
+    tlmSend_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    const NATIVE_INT_TYPE slot = static_cast<NATIVE_INT_TYPE>(this->m_driver.e);
+    if (!this->isConnected_drvTlmSend_OutputPort(slot)) {
+      this->deallocate_out(0, sendBuffer);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+    return this->drvTlmSend_out(slot, sendBuffer);
+  }
+
+  void ComDriverMux ::
+    drvReady_handler(const NATIVE_INT_TYPE portNum)
+  {
+    if (portNum == static_cast<NATIVE_INT_TYPE>(this->m_driver.e)) {
+      this->ready_out(0);
+    }
+  }
+
+  void ComDriverMux ::
+    drvRecv_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    if (portNum == static_cast<NATIVE_INT_TYPE>(this->m_driver.e)) {
+      this->recv_out(0, recvBuffer, recvStatus);
+    } else {
+      this->deallocate_out(0, recvBuffer);
+    }
+  }
+
+}
@@ -0,0 +1,78 @@
+// ======================================================================
+// \title  ComDriverMux.hpp
+// \author cindy
+// \brief  hpp file for ComDriverMux component implementation class
+// ======================================================================
+
+#ifndef MathModule_ComDriverMux_HPP
+#define MathModule_ComDriverMux_HPP
+
+#include "Components/ComDriverMux/ComDriverMuxComponentAc.hpp"
+
+namespace MathModule {
+
+  class ComDriverMux :
+    public ComDriverMuxComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct ComDriverMux object
+      ComDriverMux(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy ComDriverMux object
+      ~ComDriverMux();
+
+      //! Select the driver carrying the ground link. Called before the drivers are started.
+      void setDriver(const ComDriverKind& driver);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for tlmSend
+      Drv::SendStatus tlmSend_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The packet to send
+      ) override;
+
+      //! Handler implementation for drvReady
+      void drvReady_handler(
+          const NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for drvRecv
+      void drvRecv_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Selected driver
+      ComDriverKind m_driver;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+// ======================================================================
+// \title  ComDriverMuxTestMain.cpp
+// \author cindy
+// \brief  cpp file for ComDriverMux component test main function
+// ======================================================================
+
+#include "ComDriverMuxTester.hpp"
+
+TEST(Nominal, Routing) {
+  MathModule::ComDriverMuxTester tester;
+  tester.testRouting();
+}
+
+TEST(Nominal, Filtering) {
+  MathModule::ComDriverMuxTester tester;
+  tester.testFiltering();
+}
+
+TEST(OffNominal, Unconnected) {
+  MathModule::ComDriverMuxTester tester;
+  tester.testUnconnected();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
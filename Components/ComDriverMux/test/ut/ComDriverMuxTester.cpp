@@ -0,0 +1,156 @@
+// ======================================================================
+// \title  ComDriverMuxTester.cpp
+// \author cindy
+// \brief  cpp file for ComDriverMux component test harness implementation class
+// ======================================================================
+
+#include "ComDriverMuxTester.hpp"
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  ComDriverMuxTester ::
+    ComDriverMuxTester() :
+      ComDriverMuxGTestBase("ComDriverMuxTester", ComDriverMuxTester::MAX_HISTORY_SIZE),
+      component("ComDriverMux"),
+      partial("PartialComDriverMux"),
+      m_data(),
+      m_sendStatus(Drv::SendStatus::SEND_OK)
+  {
+    this->initComponents();
+    this->connectPorts();
+
+    this->partial.init(TEST_INSTANCE_ID);
+    this->partial.set_drvSend_OutputPort(ComDriverKind::TCP, this->get_from_drvSend(ComDriverKind::TCP));
+    this->partial.set_deallocate_OutputPort(0, this->get_from_deallocate(0));
+  }
+
+  ComDriverMuxTester ::
+    ~ComDriverMuxTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void ComDriverMuxTester ::
+    testRouting()
+  {
+    for (NATIVE_INT_TYPE kind = 0; kind < ComDriverKind::NUM_CONSTANTS; kind++) {
+      this->component.setDriver(static_cast<ComDriverKind::T>(kind));
+      this->m_sendSlots.clear();
+      this->m_tlmSlots.clear();
+
+      Fw::Buffer frame(this->m_data, sizeof(this->m_data), 2 * kind);
+      Fw::Buffer packet(this->m_data, sizeof(this->m_data), 2 * kind + 1);
+      this->m_sendStatus = Drv::SendStatus::SEND_OK;
+      EXPECT_EQ(this->invoke_to_send(0, frame), Drv::SendStatus::SEND_OK);
+      this->m_sendStatus = Drv::SendStatus::SEND_RETRY;
+      EXPECT_EQ(this->invoke_to_tlmSend(0, packet), Drv::SendStatus::SEND_RETRY);
+
+      ASSERT_EQ(this->m_sendSlots, std::vector<NATIVE_INT_TYPE>({kind}));
+      ASSERT_EQ(this->m_tlmSlots, std::vector<NATIVE_INT_TYPE>({kind}));
+    }
+    ASSERT_from_drvSend_SIZE(ComDriverKind::NUM_CONSTANTS);
+    ASSERT_from_drvTlmSend_SIZE(ComDriverKind::NUM_CONSTANTS);
+    for (NATIVE_INT_TYPE kind = 0; kind < ComDriverKind::NUM_CONSTANTS; kind++) {
+      EXPECT_EQ(this->fromPortHistory_drvSend->at(kind).sendBuffer.getContext(), static_cast<U32>(2 * kind));
+      EXPECT_EQ(this->fromPortHistory_drvTlmSend->at(kind).sendBuffer.getContext(), static_cast<U32>(2 * kind + 1));
+    }
+    ASSERT_from_deallocate_SIZE(0);
+  }
+
+  void ComDriverMuxTester ::
+    testFiltering()
+  {
+    this->component.setDriver(ComDriverKind::SLIP);
+    for (NATIVE_INT_TYPE slot = 0; slot < COM_DRIVER_SLOTS; slot++) {
+      this->invoke_to_drvReady(slot);
+    }
+    ASSERT_from_ready_SIZE(1);
+
+    for (NATIVE_INT_TYPE slot = 0; slot < COM_DRIVER_SLOTS; slot++) {
+      Fw::Buffer buffer(this->m_data, sizeof(this->m_data), static_cast<U32>(slot));
+      this->invoke_to_drvRecv(slot, buffer, Drv::RecvStatus::RECV_OK);
+    }
+    ASSERT_from_recv_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_recv->at(0).recvBuffer.getContext(), static_cast<U32>(ComDriverKind::SLIP));
+    EXPECT_EQ(this->fromPortHistory_recv->at(0).recvStatus, Drv::RecvStatus::RECV_OK);
+
+    // Buffers received by the idle drivers go back to the buffer manager
+    ASSERT_from_deallocate_SIZE(COM_DRIVER_SLOTS - 1);
+    U32 expected = 0;
+    for (U32 i = 0; i < COM_DRIVER_SLOTS - 1; i++, expected++) {
+      if (expected == ComDriverKind::SLIP) {
+        expected++;
+      }
+      EXPECT_EQ(this->fromPortHistory_deallocate->at(i).fwBuffer.getContext(), expected);
+    }
+
+    // A receive error from the selected driver is passed on with its status
+    this->clearHistory();
+    Fw::Buffer buffer(this->m_data, 0, 0);
+    this->invoke_to_drvRecv(ComDriverKind::SLIP, buffer, Drv::RecvStatus::RECV_ERROR);
+    ASSERT_from_recv_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_recv->at(0).recvStatus, Drv::RecvStatus::RECV_ERROR);
+    ASSERT_from_deallocate_SIZE(0);
+  }
+
+  void ComDriverMuxTester ::
+    testUnconnected()
+  {
+    Fw::Buffer frame(this->m_data, sizeof(this->m_data), 1);
+    Fw::Buffer packet(this->m_data, sizeof(this->m_data), 2);
+
+    // TCP has a drvSend connection but carries no compact telemetry
+    this->partial.setDriver(ComDriverKind::TCP);
+    EXPECT_EQ(this->partial.get_send_InputPort(0)->invoke(frame), Drv::SendStatus::SEND_OK);
+    ASSERT_EQ(this->m_sendSlots, std::vector<NATIVE_INT_TYPE>({ComDriverKind::TCP}));
+    EXPECT_EQ(this->partial.get_tlmSend_InputPort(0)->invoke(packet), Drv::SendStatus::SEND_ERROR);
+    ASSERT_TRUE(this->m_tlmSlots.empty());
+    ASSERT_from_deallocate_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_deallocate->at(0).fwBuffer.getContext(), 2U);
+
+    // SLIP has no connection at all on this instance
+    this->partial.setDriver(ComDriverKind::SLIP);
+    EXPECT_EQ(this->partial.get_send_InputPort(0)->invoke(frame), Drv::SendStatus::SEND_ERROR);
+    EXPECT_EQ(this->partial.get_tlmSend_InputPort(0)->invoke(packet), Drv::SendStatus::SEND_ERROR);
+    ASSERT_EQ(this->m_sendSlots.size(), 1U);
+    ASSERT_TRUE(this->m_tlmSlots.empty());
+    ASSERT_from_deallocate_SIZE(3);
+    EXPECT_EQ(this->fromPortHistory_deallocate->at(1).fwBuffer.getContext(), 1U);
+    EXPECT_EQ(this->fromPortHistory_deallocate->at(2).fwBuffer.getContext(), 2U);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Drv::SendStatus ComDriverMuxTester ::
+    from_drvSend_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    this->pushFromPortEntry_drvSend(sendBuffer);
+    this->m_sendSlots.push_back(portNum);
+    return this->m_sendStatus;
+  }
+
+  Drv::SendStatus ComDriverMuxTester ::
+    from_drvTlmSend_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    this->pushFromPortEntry_drvTlmSend(sendBuffer);
+    this->m_tlmSlots.push_back(portNum);
+    return this->m_sendStatus;
+  }
+
+}
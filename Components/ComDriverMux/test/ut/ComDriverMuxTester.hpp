@@ -0,0 +1,121 @@
+// ======================================================================
+// \title  ComDriverMuxTester.hpp
+// \author cindy
+// \brief  hpp file for ComDriverMux component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_ComDriverMuxTester_HPP
+#define MathModule_ComDriverMuxTester_HPP
+
+#include "ComDriverMuxGTestBase.hpp"
+#include "Components/ComDriverMux/ComDriverMux.hpp"
+
+#include <vector>
+
+namespace MathModule {
+
+  class ComDriverMuxTester :
+    public ComDriverMuxGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object ComDriverMuxTester
+      ComDriverMuxTester();
+
+      //! Destroy object ComDriverMuxTester
+      ~ComDriverMuxTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! send and tlmSend reach the selected driver only, which returns their status
+      void testRouting();
+
+      //! ready and recv pass only from the selected driver; other receive buffers are returned
+      void testFiltering();
+
+      //! Buffers for a driver without a connection are returned with SEND_ERROR
+      void testUnconnected();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for drvSend
+      Drv::SendStatus from_drvSend_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for drvTlmSend
+      Drv::SendStatus from_drvTlmSend_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The packet to send
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      ComDriverMux component;
+
+      //! A second instance wired to the TCP drvSend slot and deallocate only
+      ComDriverMux partial;
+
+      //! Storage behind the test buffers
+      U8 m_data[16];
+
+      //! Status the drivers return
+      Drv::SendStatus m_sendStatus;
+
+      //! Slots drvSend was invoked on, in order
+      std::vector<NATIVE_INT_TYPE> m_sendSlots;
+
+      //! Slots drvTlmSend was invoked on, in order
+      std::vector<NATIVE_INT_TYPE> m_tlmSlots;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,234 @@
+// ======================================================================
+// \title  CompactTlmPacketizer.cpp
+// \author cindy
+// \brief  cpp file for CompactTlmPacketizer component implementation class
+// ======================================================================
+
+#include "Components/CompactTlmPacketizer/CompactTlmPacketizer.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cstring>
+
+namespace MathModule {
+
+  namespace {
+
+    void putU16(U8* out, U16 value)
+    {
+      out[0] = static_cast<U8>(value >> 8);
+      out[1] = static_cast<U8>(value);
+    }
+
+    void putU32(U8* out, U32 value)
+    {
+      putU16(out, static_cast<U16>(value >> 16));
+      putU16(&out[2], static_cast<U16>(value));
+    }
+
+    void putU64(U8* out, U64 value)
+    {
+      putU32(out, static_cast<U32>(value >> 32));
+      putU32(&out[4], static_cast<U32>(value));
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  CompactTlmPacketizer ::
+    CompactTlmPacketizer(const char* const compName) :
+      CompactTlmPacketizerComponentBase(compName),
+      m_changedCount(0),
+      m_cursor(0),
+      m_maxPacketSize(DEFAULT_MAX_PACKET_SIZE),
+      m_refreshPeriod(0),
+      m_runsSinceRefresh(0),
+      m_packetsSent(0),
+      m_recordsSent(0),
+      m_sendErrors(0)
+  {
+    for (U32 slot = 0; slot < CHANNEL_SLOTS; slot++) {
+      this->m_channels[slot].used = false;
+      this->m_channels[slot].changed = false;
+    }
+  }
+
+  CompactTlmPacketizer ::
+    ~CompactTlmPacketizer()
+  {
+
+  }
+
+  /*
+    Every packet must hold at least one record of any size, so a channel can
+    never be stuck waiting for a packet it does not fit in. The record count
+    and value length fields bound the packet to 64 KiB.
+  */
+  void CompactTlmPacketizer ::
+    configure(U32 maxPacketSize, U32 refreshPeriod)
+  {
+    FW_ASSERT(maxPacketSize >= PACKET_HEADER_SIZE + RECORD_HEADER_SIZE + FW_TLM_BUFFER_MAX_SIZE, maxPacketSize);
+    FW_ASSERT(maxPacketSize <= 0xFFFF, maxPacketSize);
+    this->m_maxPacketSize = maxPacketSize;
+    this->m_refreshPeriod = refreshPeriod;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    Only the latest value is kept. An update equal to the stored value does
+    not mark the channel, which is what makes emission change-only.
+  */
+  void CompactTlmPacketizer ::
+    TlmRecv_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwChanIdType id,
+        Fw::Time& timeTag,
+        Fw::TlmBuffer& val
+    )
+  {
+    const U32 size = static_cast<U32>(val.getBuffLength());
+    FW_ASSERT(size <= FW_TLM_BUFFER_MAX_SIZE, size);
+
+    this->m_lock.lock();
+    Channel* channel = this->lookup(id);
+    if (channel == nullptr) {
+      this->m_lock.unLock();
+      this->log_WARNING_LO_TABLE_FULL(id);
+      return;
+    }
+    if (!channel->used || (channel->size != size) || (::memcmp(channel->value, val.getBuffAddr(), size) != 0)) {
+      channel->id = id;
+      channel->used = true;
+      ::memcpy(channel->value, val.getBuffAddr(), size);
+      channel->size = static_cast<U16>(size);
+      if (!channel->changed) {
+        channel->changed = true;
+        ++this->m_changedCount;
+      }
+    }
+    this->m_lock.unLock();
+  }
+
+  /*
+    Packets are filled under the lock and sent after it is released: the
+    driver may block on the link, and this component's own telemetry comes
+    back through TlmRecv.
+  */
+  void CompactTlmPacketizer ::
+    Run_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    const U64 timestamp = this->getTime().getSeconds();
+    Fw::Buffer packets[MAX_PACKETS_PER_RUN];
+    U32 packetRecords[MAX_PACKETS_PER_RUN];
+    U32 packetCount = 0;
+    bool bufferUnavailable = false;
+
+    this->m_lock.lock();
+    ++this->m_runsSinceRefresh;
+    if ((this->m_refreshPeriod != 0) && (this->m_runsSinceRefresh >= this->m_refreshPeriod)) {
+      this->m_runsSinceRefresh = 0;
+      for (U32 slot = 0; slot < CHANNEL_SLOTS; slot++) {
+        Channel& channel = this->m_channels[slot];
+        if (channel.used && !channel.changed) {
+          channel.changed = true;
+          ++this->m_changedCount;
+        }
+      }
+    }
+    while ((this->m_changedCount > 0) && (packetCount < MAX_PACKETS_PER_RUN)) {
+      Fw::Buffer buffer = this->bufferGet_out(0, this->m_maxPacketSize);
+      if ((buffer.getData() == nullptr) || (buffer.getSize() < this->m_maxPacketSize)) {
+        if (buffer.getData() != nullptr) {
+          this->deallocate_out(0, buffer);
+        }
+        bufferUnavailable = true;
+        break;
+      }
+      buffer.setSize(this->fillPacket(buffer.getData(), this->m_maxPacketSize, timestamp, packetRecords[packetCount]));
+      packets[packetCount++] = buffer;
+    }
+    this->m_lock.unLock();
+
+    for (U32 i = 0; i < packetCount; i++) {
+      const Drv::SendStatus status = this->packetOut_out(0, packets[i]);
+      if (status == Drv::SendStatus::SEND_OK) {
+        ++this->m_packetsSent;
+        this->m_recordsSent += packetRecords[i];
+      } else {
+        ++this->m_sendErrors;
+      }
+    }
+    if (bufferUnavailable) {
+      this->log_WARNING_LO_BUFFER_UNAVAILABLE();
+    }
+    this->tlmWrite_PACKETS_SENT(this->m_packetsSent);
+    this->tlmWrite_RECORDS_SENT(this->m_recordsSent);
+    this->tlmWrite_SEND_ERRORS(this->m_sendErrors);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  CompactTlmPacketizer::Channel* CompactTlmPacketizer ::
+    lookup(FwChanIdType id)
+  {
+    U32 slot = static_cast<U32>(id) % CHANNEL_SLOTS;
+    for (U32 probe = 0; probe < CHANNEL_SLOTS; probe++) {
+      Channel& channel = this->m_channels[slot];
+      if (!channel.used || (channel.id == id)) {
+        return &channel;
+      }
+      slot = (slot + 1) % CHANNEL_SLOTS;
+    }
+    return nullptr;
+  }
+
+  /*
+    Packet layout, matching TelemetryPacket in scripts/telemetry.py, all
+    fields big endian:
+      U16 length of the rest of the packet
+      U8  packet type, 0x01
+      U64 timestamp, seconds
+      U16 record count
+      records: U32 channel id, U16 value length, serialized value
+  */
+  U32 CompactTlmPacketizer ::
+    fillPacket(U8* data, U32 capacity, U64 timestamp, U32& records)
+  {
+    U32 offset = PACKET_HEADER_SIZE;
+    records = 0;
+    for (U32 scanned = 0; (scanned < CHANNEL_SLOTS) && (this->m_changedCount > 0); scanned++) {
+      Channel& channel = this->m_channels[this->m_cursor];
+      if (channel.changed) {
+        if (offset + RECORD_HEADER_SIZE + channel.size > capacity) {
+          break;
+        }
+        putU32(&data[offset], static_cast<U32>(channel.id));
+        putU16(&data[offset + sizeof(U32)], channel.size);
+        ::memcpy(&data[offset + RECORD_HEADER_SIZE], channel.value, channel.size);
+        offset += RECORD_HEADER_SIZE + channel.size;
+        channel.changed = false;
+        --this->m_changedCount;
+        ++records;
+      }
+      this->m_cursor = (this->m_cursor + 1) % CHANNEL_SLOTS;
+    }
+    FW_ASSERT(records > 0);
+
+    putU16(data, static_cast<U16>(offset - sizeof(U16)));
+    data[sizeof(U16)] = PACKET_TYPE_TELEMETRY;
+    putU64(&data[sizeof(U16) + sizeof(U8)], timestamp);
+    putU16(&data[sizeof(U16) + sizeof(U8) + sizeof(U64)], static_cast<U16>(records));
+    return offset;
+  }
+
+}
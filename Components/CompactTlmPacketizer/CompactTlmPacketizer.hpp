@@ -0,0 +1,153 @@
+// ======================================================================
+// \title  CompactTlmPacketizer.hpp
+// \author cindy
+// \brief  hpp file for CompactTlmPacketizer component implementation class
+// ======================================================================
+
+#ifndef MathModule_CompactTlmPacketizer_HPP
+#define MathModule_CompactTlmPacketizer_HPP
+
+#include "Components/CompactTlmPacketizer/CompactTlmPacketizerComponentAc.hpp"
+#include <Os/Mutex.hpp>
+
+namespace MathModule {
+
+  class CompactTlmPacketizer :
+    public CompactTlmPacketizerComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Packet type field of a telemetry packet
+      static const U8 PACKET_TYPE_TELEMETRY = 0x01;
+
+      //! Length (U16), packet type (U8), timestamp (U64) and record count (U16)
+      static const U32 PACKET_HEADER_SIZE = 13;
+
+      //! Channel id (U32) and value length (U16)
+      static const U32 RECORD_HEADER_SIZE = 6;
+
+      //! Default packet size limit, the Ethernet MTU, since the ground parses one packet per frame
+      static const U32 DEFAULT_MAX_PACKET_SIZE = 1500;
+
+      //! Channels the table can hold
+      static const U32 CHANNEL_SLOTS = 256;
+
+      //! Most packets sent per Run call; remaining changes wait for the next call
+      static const U32 MAX_PACKETS_PER_RUN = 8;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct CompactTlmPacketizer object
+      CompactTlmPacketizer(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy CompactTlmPacketizer object
+      ~CompactTlmPacketizer();
+
+      //! Set the packet size limit and the full refresh period
+      void configure(
+          U32 maxPacketSize, //!< Largest packet, header included
+          U32 refreshPeriod //!< Run calls between resending every channel, 0 to send changes only
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for TlmRecv
+      void TlmRecv_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwChanIdType id, //!< Telemetry Channel ID
+          Fw::Time& timeTag, //!< Time Tag
+          Fw::TlmBuffer& val //!< Buffer containing serialized telemetry value
+      ) override;
+
+      //! Handler implementation for Run
+      void Run_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Latest value of one channel
+      struct Channel {
+        FwChanIdType id;
+        bool used; //!< Whether the slot holds a channel
+        bool changed; //!< Whether the value changed since it was last sent
+        U16 size;
+        U8 value[FW_TLM_BUFFER_MAX_SIZE];
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Find the slot of a channel, or the free slot a new channel goes in
+      //! \return the slot, or nullptr if the table is full
+      Channel* lookup(FwChanIdType id);
+
+      //! Write changed channels into a packet, starting at the scan cursor
+      //! \return the packet size
+      U32 fillPacket(
+          U8* data, //!< The packet buffer
+          U32 capacity, //!< The packet size limit
+          U64 timestamp, //!< The packet timestamp
+          U32& records //!< Set to the number of records written
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Guards the channel table
+      Os::Mutex m_lock;
+
+      //! Channel table, open addressing on the channel id
+      Channel m_channels[CHANNEL_SLOTS];
+
+      //! Channels marked changed
+      U32 m_changedCount;
+
+      //! Slot the next packet starts scanning from, so a backlog is drained in turn
+      U32 m_cursor;
+
+      //! Largest packet
+      U32 m_maxPacketSize;
+
+      //! Run calls between full refreshes, 0 for none
+      U32 m_refreshPeriod;
+
+      //! Run calls since the last full refresh
+      U32 m_runsSinceRefresh;
+
+      //! Telemetry counters, updated by Run only
+      U32 m_packetsSent;
+      U32 m_recordsSent;
+      U32 m_sendErrors;
+
+  };
+
+}
+
+#endif
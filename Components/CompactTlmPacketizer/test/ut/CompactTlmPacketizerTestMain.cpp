@@ -0,0 +1,32 @@
+// ======================================================================
+// \title  CompactTlmPacketizerTestMain.cpp
+// \author cindy
+// \brief  cpp file for CompactTlmPacketizer component test main function
+// ======================================================================
+
+#include "CompactTlmPacketizerTester.hpp"
+
+TEST(Nominal, Format) {
+  MathModule::CompactTlmPacketizerTester tester;
+  tester.testFormat();
+}
+
+TEST(Nominal, ChangeOnly) {
+  MathModule::CompactTlmPacketizerTester tester;
+  tester.testChangeOnly();
+}
+
+TEST(Nominal, SplitAndRefresh) {
+  MathModule::CompactTlmPacketizerTester tester;
+  tester.testSplitAndRefresh();
+}
+
+TEST(OffNominal, TableFull) {
+  MathModule::CompactTlmPacketizerTester tester;
+  tester.testTableFull();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
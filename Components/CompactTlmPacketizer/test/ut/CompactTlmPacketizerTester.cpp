@@ -0,0 +1,223 @@
+// ======================================================================
+// \title  CompactTlmPacketizerTester.cpp
+// \author cindy
+// \brief  cpp file for CompactTlmPacketizer component test harness implementation class
+// ======================================================================
+
+#include "CompactTlmPacketizerTester.hpp"
+
+namespace MathModule {
+
+  namespace {
+
+    U32 getU(const U8* data, U32 size)
+    {
+      U32 value = 0;
+      for (U32 i = 0; i < size; i++) {
+        value = (value << 8) | data[i];
+      }
+      return value;
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  CompactTlmPacketizerTester ::
+    CompactTlmPacketizerTester() :
+      CompactTlmPacketizerGTestBase("CompactTlmPacketizerTester", CompactTlmPacketizerTester::MAX_HISTORY_SIZE),
+      component("CompactTlmPacketizer"),
+      m_allocated(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  CompactTlmPacketizerTester ::
+    ~CompactTlmPacketizerTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void CompactTlmPacketizerTester ::
+    testFormat()
+  {
+    this->setTestTime(Fw::Time(TB_NONE, 1700000000, 0));
+    this->updateU32(0x4E00, 0x01020304);
+    Fw::TlmBuffer value;
+    ASSERT_EQ(value.serialize(static_cast<F32>(2.5f)), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(value.serialize(static_cast<U8>(7)), Fw::FW_SERIALIZE_OK);
+    Fw::Time time;
+    this->invoke_to_TlmRecv(0, 0x4E01, time, value);
+
+    const std::vector<Packet> packets = this->run();
+    ASSERT_EQ(packets.size(), 1U);
+    EXPECT_EQ(packets[0].timestamp, 1700000000U);
+    ASSERT_EQ(packets[0].records.size(), 2U);
+    EXPECT_EQ(packets[0].records[0].id, 0x4E00U);
+    EXPECT_EQ(packets[0].records[0].value, std::vector<U8>({0x01, 0x02, 0x03, 0x04}));
+    EXPECT_EQ(packets[0].records[1].id, 0x4E01U);
+    EXPECT_EQ(packets[0].records[1].value, std::vector<U8>({0x40, 0x20, 0x00, 0x00, 0x07}));
+
+    ASSERT_TLM_PACKETS_SENT(0, 1);
+    ASSERT_TLM_RECORDS_SENT(0, 2);
+  }
+
+  void CompactTlmPacketizerTester ::
+    testChangeOnly()
+  {
+    this->updateU32(10, 1);
+    this->updateU32(11, 2);
+    ASSERT_EQ(this->run().size(), 1U);
+
+    // Same values again: nothing to send
+    this->updateU32(10, 1);
+    this->updateU32(11, 2);
+    EXPECT_EQ(this->run().size(), 0U);
+
+    this->updateU32(11, 3);
+    const std::vector<Packet> packets = this->run();
+    ASSERT_EQ(packets.size(), 1U);
+    ASSERT_EQ(packets[0].records.size(), 1U);
+    EXPECT_EQ(packets[0].records[0].id, 11U);
+    EXPECT_EQ(getU(packets[0].records[0].value.data(), sizeof(U32)), 3U);
+  }
+
+  void CompactTlmPacketizerTester ::
+    testSplitAndRefresh()
+  {
+    const U32 channels = 200;
+    this->component.configure(CompactTlmPacketizer::DEFAULT_MAX_PACKET_SIZE, 3);
+    for (U32 id = 0; id < channels; id++) {
+      this->updateU32(id, id * 7);
+    }
+
+    std::vector<Packet> packets = this->run();
+    ASSERT_EQ(packets.size(), 2U);
+    U32 records = 0;
+    for (const Packet& packet : packets) {
+      for (const Record& record : packet.records) {
+        EXPECT_EQ(getU(record.value.data(), sizeof(U32)), record.id * 7);
+        ++records;
+      }
+    }
+    EXPECT_EQ(records, channels);
+
+    EXPECT_EQ(this->run().size(), 0U);
+    packets = this->run();
+    records = 0;
+    for (const Packet& packet : packets) {
+      records += static_cast<U32>(packet.records.size());
+    }
+    EXPECT_EQ(records, channels);
+  }
+
+  void CompactTlmPacketizerTester ::
+    testTableFull()
+  {
+    const U32 slots = CompactTlmPacketizer::CHANNEL_SLOTS;
+    for (U32 id = 0; id <= slots; id++) {
+      this->updateU32(id, 1);
+    }
+    ASSERT_EVENTS_TABLE_FULL_SIZE(1);
+    ASSERT_EVENTS_TABLE_FULL(0, slots);
+
+    U32 records = 0;
+    for (const Packet& packet : this->run()) {
+      records += static_cast<U32>(packet.records.size());
+    }
+    EXPECT_EQ(records, slots);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer CompactTlmPacketizerTester ::
+    from_bufferGet_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    EXPECT_LE(size, sizeof(this->m_storage[0]));
+    EXPECT_LT(this->m_allocated, FW_NUM_ARRAY_ELEMENTS(this->m_storage));
+    return Fw::Buffer(this->m_storage[this->m_allocated++], size);
+  }
+
+  Drv::SendStatus CompactTlmPacketizerTester ::
+    from_packetOut_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    this->m_packets.push_back(this->parse(sendBuffer.getData(), sendBuffer.getSize()));
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  void CompactTlmPacketizerTester ::
+    from_deallocate_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    ADD_FAILURE() << "full-size buffers must not be returned";
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void CompactTlmPacketizerTester ::
+    updateU32(FwChanIdType id, U32 value)
+  {
+    Fw::TlmBuffer buffer;
+    ASSERT_EQ(buffer.serialize(value), Fw::FW_SERIALIZE_OK);
+    Fw::Time time;
+    this->invoke_to_TlmRecv(0, id, time, buffer);
+  }
+
+  std::vector<CompactTlmPacketizerTester::Packet> CompactTlmPacketizerTester ::
+    run()
+  {
+    this->m_allocated = 0;
+    this->m_packets.clear();
+    this->clearHistory();
+    this->invoke_to_Run(0, 0);
+    return this->m_packets;
+  }
+
+  CompactTlmPacketizerTester::Packet CompactTlmPacketizerTester ::
+    parse(const U8* data, U32 size)
+  {
+    const U32 headerSize = CompactTlmPacketizer::PACKET_HEADER_SIZE;
+    const U32 maxSize = CompactTlmPacketizer::DEFAULT_MAX_PACKET_SIZE;
+    const U8 packetType = CompactTlmPacketizer::PACKET_TYPE_TELEMETRY;
+    Packet packet;
+    EXPECT_GE(size, headerSize);
+    EXPECT_LE(size, maxSize);
+    EXPECT_EQ(getU(data, sizeof(U16)), size - sizeof(U16));
+    EXPECT_EQ(data[2], packetType);
+    packet.timestamp = (static_cast<U64>(getU(&data[3], sizeof(U32))) << 32) | getU(&data[7], sizeof(U32));
+    const U32 count = getU(&data[11], sizeof(U16));
+
+    U32 offset = headerSize;
+    for (U32 i = 0; i < count; i++) {
+      Record record;
+      record.id = getU(&data[offset], sizeof(U32));
+      const U32 length = getU(&data[offset + sizeof(U32)], sizeof(U16));
+      offset += CompactTlmPacketizer::RECORD_HEADER_SIZE;
+      record.value.assign(&data[offset], &data[offset + length]);
+      offset += length;
+      packet.records.push_back(record);
+    }
+    EXPECT_EQ(offset, size);
+    return packet;
+  }
+
+}
@@ -0,0 +1,151 @@
+// ======================================================================
+// \title  CompactTlmPacketizerTester.hpp
+// \author cindy
+// \brief  hpp file for CompactTlmPacketizer component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_CompactTlmPacketizerTester_HPP
+#define MathModule_CompactTlmPacketizerTester_HPP
+
+#include "CompactTlmPacketizerGTestBase.hpp"
+#include "Components/CompactTlmPacketizer/CompactTlmPacketizer.hpp"
+
+#include <vector>
+
+namespace MathModule {
+
+  class CompactTlmPacketizerTester :
+    public CompactTlmPacketizerGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object CompactTlmPacketizerTester
+      CompactTlmPacketizerTester();
+
+      //! Destroy object CompactTlmPacketizerTester
+      ~CompactTlmPacketizerTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Packets have the layout TelemetryPacket in scripts/telemetry.py parses
+      void testFormat();
+
+      //! Only channels whose value changed are sent
+      void testChangeOnly();
+
+      //! A backlog is split across packets, and the refresh resends every channel
+      void testSplitAndRefresh();
+
+      //! Channels beyond the table capacity are reported and dropped
+      void testTableFull();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! A parsed channel record
+      struct Record {
+        U32 id;
+        std::vector<U8> value;
+      };
+
+      //! A parsed packet
+      struct Packet {
+        U64 timestamp;
+        std::vector<Record> records;
+      };
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for bufferGet
+      Fw::Buffer from_bufferGet_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for packetOut
+      Drv::SendStatus from_packetOut_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The packet
+      ) override;
+
+      //! Handler implementation for deallocate
+      void from_deallocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Send a U32 channel update
+      void updateU32(FwChanIdType id, U32 value);
+
+      //! Run the component and return the packets it sent
+      std::vector<Packet> run();
+
+      //! Parse a packet as the ground does, checking its length fields
+      Packet parse(const U8* data, U32 size);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      CompactTlmPacketizer component;
+
+      //! Storage for the packet buffers
+      U8 m_storage[CompactTlmPacketizer::MAX_PACKETS_PER_RUN][CompactTlmPacketizer::DEFAULT_MAX_PACKET_SIZE];
+
+      //! Buffers handed out during the current run
+      U32 m_allocated;
+
+      //! Packets sent during the current run
+      std::vector<Packet> m_packets;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,249 @@
+// ======================================================================
+// \title  Crc32.cpp
+// \author cindy
+// \brief  Runtime-dispatched CRC-32 used by the F´ frame checksum
+// ======================================================================
+
+#include "Components/Crc32Framing/Crc32.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC32_HAVE_PCLMUL 1
+#include <immintrin.h>
+#else
+#define CRC32_HAVE_PCLMUL 0
+#endif
+
+namespace MathModule {
+
+  namespace Crc32 {
+
+    namespace {
+
+      //! Reflected CRC-32 polynomial
+      const uint32_t POLYNOMIAL = 0xEDB88320;
+
+      //! Shortest input worth folding with PCLMULQDQ: one 64 byte block
+      const size_t PCLMUL_MIN_SIZE = 64;
+
+      typedef uint32_t (*UpdateFunction)(uint32_t state, const uint8_t* data, size_t size);
+
+      /*
+        table[0] is the bytewise table. table[k][b] is the CRC of byte b
+        followed by k zero bytes, which lets slicing-by-8 look up eight input
+        bytes independently and xor the results.
+      */
+      struct Tables {
+        uint32_t table[8][256];
+
+        Tables()
+        {
+          for (uint32_t byte = 0; byte < 256; byte++) {
+            uint32_t crc = byte;
+            for (uint32_t bit = 0; bit < 8; bit++) {
+              crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+            }
+            table[0][byte] = crc;
+          }
+          for (uint32_t byte = 0; byte < 256; byte++) {
+            for (uint32_t slice = 1; slice < 8; slice++) {
+              const uint32_t previous = table[slice - 1][byte];
+              table[slice][byte] = (previous >> 8) ^ table[0][previous & 0xFF];
+            }
+          }
+        }
+      };
+
+      const Tables& tables()
+      {
+        static const Tables instance;
+        return instance;
+      }
+
+      uint32_t loadLittleEndian(const uint8_t* data)
+      {
+        return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+               (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+      }
+
+      uint32_t updateBytewise(uint32_t state, const uint8_t* data, size_t size)
+      {
+        const uint32_t* table = tables().table[0];
+        for (size_t i = 0; i < size; i++) {
+          state = (state >> 8) ^ table[(state ^ data[i]) & 0xFF];
+        }
+        return state;
+      }
+
+      uint32_t updateSlicingBy8(uint32_t state, const uint8_t* data, size_t size)
+      {
+        const Tables& t = tables();
+        while (size >= 8) {
+          const uint32_t low = state ^ loadLittleEndian(data);
+          const uint32_t high = loadLittleEndian(data + 4);
+          state = t.table[7][low & 0xFF] ^ t.table[6][(low >> 8) & 0xFF] ^
+                  t.table[5][(low >> 16) & 0xFF] ^ t.table[4][low >> 24] ^
+                  t.table[3][high & 0xFF] ^ t.table[2][(high >> 8) & 0xFF] ^
+                  t.table[1][(high >> 16) & 0xFF] ^ t.table[0][high >> 24];
+          data += 8;
+          size -= 8;
+        }
+        return updateBytewise(state, data, size);
+      }
+
+#if CRC32_HAVE_PCLMUL
+      /*
+        Folds four 128 bit lanes over 64 byte blocks, then the lanes into
+        one, then Barrett-reduces to 32 bits, following Intel's "Fast CRC
+        Computation for Generic Polynomials Using PCLMULQDQ Instruction". The
+        constants are x^n mod P for the fold distances, bit-reflected, and
+        the polynomial with its Barrett quotient. size must be a multiple of
+        16 and at least PCLMUL_MIN_SIZE.
+      */
+      __attribute__((target("sse4.1,pclmul")))
+      uint32_t foldPclmul(uint32_t state, const uint8_t* data, size_t size)
+      {
+        const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+        const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+        const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+        const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+        const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+        __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(state)));
+        data += 64;
+        size -= 64;
+
+        while (size >= 64) {
+          const __m128i l1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+          const __m128i l2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+          const __m128i l3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+          const __m128i l4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+          x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+          x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+          x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+          x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+          x1 = _mm_xor_si128(_mm_xor_si128(x1, l1), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+          x2 = _mm_xor_si128(_mm_xor_si128(x2, l2), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)));
+          x3 = _mm_xor_si128(_mm_xor_si128(x3, l3), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)));
+          x4 = _mm_xor_si128(_mm_xor_si128(x4, l4), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)));
+          data += 64;
+          size -= 64;
+        }
+
+        // Fold the four lanes into one, then any remaining 16 byte blocks into it
+        const __m128i lanes[3] = {x2, x3, x4};
+        for (size_t i = 0; i < 3; i++) {
+          const __m128i low = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+          x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+          x1 = _mm_xor_si128(_mm_xor_si128(x1, lanes[i]), low);
+        }
+        while (size >= 16) {
+          const __m128i low = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+          x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+          x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), low);
+          data += 16;
+          size -= 16;
+        }
+
+        // 128 bits to 64
+        x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, mask32);
+        x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+        // Barrett reduction to 32 bits
+        x2 = _mm_and_si128(x1, mask32);
+        x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+        x2 = _mm_and_si128(x2, mask32);
+        x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+      }
+
+      uint32_t updatePclmul(uint32_t state, const uint8_t* data, size_t size)
+      {
+        if (size >= PCLMUL_MIN_SIZE) {
+          const size_t folded = size & ~static_cast<size_t>(15);
+          state = foldPclmul(state, data, folded);
+          data += folded;
+          size -= folded;
+        }
+        return updateSlicingBy8(state, data, size);
+      }
+#endif
+
+      const UpdateFunction FUNCTIONS[IMPLEMENTATION_COUNT] = {
+        updateBytewise,
+        updateSlicingBy8,
+#if CRC32_HAVE_PCLMUL
+        updatePclmul,
+#else
+        updateSlicingBy8,
+#endif
+      };
+
+      UpdateFunction selectedFunction()
+      {
+        static const UpdateFunction function = FUNCTIONS[selected()];
+        return function;
+      }
+
+    }
+
+    /*
+      The running value handed between calls is the finished CRC, as with
+      zlib's crc32(), so callers never see the inverted register.
+    */
+    uint32_t update(uint32_t crc, const void* data, size_t size)
+    {
+      return ~selectedFunction()(~crc, static_cast<const uint8_t*>(data), size);
+    }
+
+    uint32_t update(Implementation implementation, uint32_t crc, const void* data, size_t size)
+    {
+      return ~FUNCTIONS[implementation](~crc, static_cast<const uint8_t*>(data), size);
+    }
+
+    bool supported(Implementation implementation)
+    {
+      switch (implementation) {
+        case BYTEWISE:
+        case SLICING_BY_8:
+          return true;
+        case PCLMUL:
+#if CRC32_HAVE_PCLMUL
+          return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#else
+          return false;
+#endif
+        default:
+          return false;
+      }
+    }
+
+    Implementation selected()
+    {
+      return supported(PCLMUL) ? PCLMUL : SLICING_BY_8;
+    }
+
+    const char* name(Implementation implementation)
+    {
+      switch (implementation) {
+        case BYTEWISE:
+          return "bytewise";
+        case SLICING_BY_8:
+          return "slicing-by-8";
+        case PCLMUL:
+          return "pclmul";
+        default:
+          return "unknown";
+      }
+    }
+
+  }
+
+}
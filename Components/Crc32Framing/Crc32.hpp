@@ -0,0 +1,58 @@
+// ======================================================================
+// \title  Crc32.hpp
+// \author cindy
+// \brief  Runtime-dispatched CRC-32 used by the F´ frame checksum
+//
+// This is the CRC-32 of Utils::Hash, zlib and Ethernet (reflected
+// polynomial 0xEDB88320). The checksum is the same whichever
+// implementation runs; only the speed differs. This file only depends on
+// the C++ standard library so the benchmark builds without F´.
+// ======================================================================
+
+#ifndef MathModule_Crc32_HPP
+#define MathModule_Crc32_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MathModule {
+
+  namespace Crc32 {
+
+    //! CRC of no data, and the value to start update from
+    static const uint32_t INITIAL = 0;
+
+    //! Implementations, slowest first
+    enum Implementation {
+      BYTEWISE = 0, //!< One table lookup per byte, as Utils::Hash does
+      SLICING_BY_8 = 1, //!< Eight table lookups per eight bytes
+      PCLMUL = 2, //!< Carry-less multiply folding over 64 byte blocks (x86 PCLMULQDQ and SSE4.1)
+      IMPLEMENTATION_COUNT = 3
+    };
+
+    //! Extend a CRC over more data with the fastest implementation this CPU supports
+    //! \return the CRC of the data so far
+    uint32_t update(
+        uint32_t crc, //!< CRC of the data so far, INITIAL for none
+        const void* data, //!< Next bytes
+        size_t size //!< Number of bytes
+    );
+
+    //! Extend a CRC with the given implementation, which must be supported
+    //! \return the CRC of the data so far
+    uint32_t update(Implementation implementation, uint32_t crc, const void* data, size_t size);
+
+    //! Whether this CPU can run the implementation
+    bool supported(Implementation implementation);
+
+    //! Implementation picked by update on this CPU
+    Implementation selected();
+
+    //! Printable name of an implementation
+    const char* name(Implementation implementation);
+
+  }
+
+}
+
+#endif
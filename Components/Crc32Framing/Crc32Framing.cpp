@@ -0,0 +1,162 @@
+// ======================================================================
+// \title  Crc32Framing.cpp
+// \author cindy
+// \brief  F´ framing and deframing protocols with a fast frame checksum
+// ======================================================================
+
+#include "Components/Crc32Framing/Crc32Framing.hpp"
+#include "Components/Crc32Framing/Crc32.hpp"
+
+#include <Fw/Types/Assert.hpp>
+#include <Svc/FramingProtocol/FprimeProtocol.hpp>
+#include <Utils/Hash/Hash.hpp>
+
+#include <cstring>
+#include <limits>
+
+namespace MathModule {
+
+  // The ground checks frames with the deployment's Utils::Hash, so it must be the CRC-32 this replaces
+  static_assert(HASH_DIGEST_LENGTH == sizeof(U32), "frame checksum must be the 4 byte CRC-32");
+
+  namespace {
+
+    void writeU32(U8* data, U32 value)
+    {
+      data[0] = static_cast<U8>(value >> 24);
+      data[1] = static_cast<U8>(value >> 16);
+      data[2] = static_cast<U8>(value >> 8);
+      data[3] = static_cast<U8>(value);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Framing
+  // ----------------------------------------------------------------------
+
+  Crc32Framing ::
+    Crc32Framing() :
+      Svc::FramingProtocol()
+  {
+
+  }
+
+  /*
+    The header is written directly rather than through a serializer so the
+    CRC can run over the contiguous frame in one call.
+  */
+  void Crc32Framing ::
+    frame(
+        const U8* const data,
+        const U32 size,
+        Fw::ComPacket::ComPacketType packet_type
+    )
+  {
+    FW_ASSERT(data != nullptr);
+    FW_ASSERT(this->m_interface != nullptr);
+    const bool typed = (packet_type != Fw::ComPacket::FW_PACKET_UNKNOWN);
+    const U32 dataSize = size + (typed ? sizeof(I32) : 0);
+    const U32 total = Svc::FpFrameHeader::SIZE + dataSize + HASH_DIGEST_LENGTH;
+
+    Fw::Buffer buffer = this->m_interface->allocate(total);
+    FW_ASSERT(buffer.getSize() >= total, buffer.getSize(), total);
+    U8* const frame = buffer.getData();
+    writeU32(frame, Svc::FpFrameHeader::START_WORD);
+    writeU32(frame + sizeof(U32), dataSize);
+    U8* payload = frame + Svc::FpFrameHeader::SIZE;
+    if (typed) {
+      writeU32(payload, static_cast<U32>(static_cast<I32>(packet_type)));
+      payload += sizeof(I32);
+    }
+    ::memcpy(payload, data, size);
+    writeU32(payload + size, Crc32::update(Crc32::INITIAL, frame, total - HASH_DIGEST_LENGTH));
+
+    buffer.setSize(total);
+    this->m_interface->send(buffer);
+  }
+
+  // ----------------------------------------------------------------------
+  // Deframing
+  // ----------------------------------------------------------------------
+
+  Crc32Deframing ::
+    Crc32Deframing() :
+      Svc::DeframingProtocol()
+  {
+
+  }
+
+  /*
+    Same checks, in the same order, as Svc::FprimeDeframing so a bad frame
+    gets the same status either way.
+  */
+  Svc::DeframingProtocol::DeframingStatus Crc32Deframing ::
+    deframe(
+        Types::CircularBuffer& ring,
+        U32& needed
+    )
+  {
+    FW_ASSERT(this->m_interface != nullptr);
+    if (ring.get_allocated_size() < Svc::FpFrameHeader::SIZE) {
+      needed = Svc::FpFrameHeader::SIZE;
+      return DEFRAMING_MORE_NEEDED;
+    }
+    Svc::FpFrameHeader::TokenType start = 0;
+    Svc::FpFrameHeader::TokenType size = 0;
+    Fw::SerializeStatus status = ring.peek(start, 0);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = ring.peek(size, sizeof(Svc::FpFrameHeader::TokenType));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    if (start != Svc::FpFrameHeader::START_WORD) {
+      return DEFRAMING_INVALID_FORMAT;
+    }
+    if (size > std::numeric_limits<U32>::max() - (Svc::FpFrameHeader::SIZE + HASH_DIGEST_LENGTH)) {
+      return DEFRAMING_INVALID_SIZE;
+    }
+    needed = Svc::FpFrameHeader::SIZE + size + HASH_DIGEST_LENGTH;
+    if (needed > ring.get_capacity()) {
+      return DEFRAMING_INVALID_SIZE;
+    }
+    if (ring.get_allocated_size() < needed) {
+      return DEFRAMING_MORE_NEEDED;
+    }
+    if (!this->validate(ring, needed - HASH_DIGEST_LENGTH)) {
+      return DEFRAMING_INVALID_CHECKSUM;
+    }
+
+    Fw::Buffer buffer = this->m_interface->allocate(size);
+    // Some allocators return larger buffers than requested, which would confuse routing
+    FW_ASSERT(buffer.getSize() >= size, buffer.getSize(), size);
+    buffer.setSize(size);
+    status = ring.peek(buffer.getData(), size, Svc::FpFrameHeader::SIZE);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    this->m_interface->route(buffer);
+    return DEFRAMING_STATUS_SUCCESS;
+  }
+
+  /*
+    The frame may wrap around the end of the ring, so it is copied out in
+    chunks rather than peeked one byte per CRC update.
+  */
+  bool Crc32Deframing ::
+    validate(
+        Types::CircularBuffer& ring,
+        U32 size
+    )
+  {
+    U8 chunk[VALIDATE_CHUNK_SIZE];
+    U32 crc = Crc32::INITIAL;
+    for (U32 offset = 0; offset < size; offset += VALIDATE_CHUNK_SIZE) {
+      const U32 length = FW_MIN(VALIDATE_CHUNK_SIZE, size - offset);
+      const Fw::SerializeStatus status = ring.peek(chunk, length, offset);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      crc = Crc32::update(crc, chunk, length);
+    }
+    U32 sent = 0;
+    const Fw::SerializeStatus status = ring.peek(sent, size);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    return sent == crc;
+  }
+
+}
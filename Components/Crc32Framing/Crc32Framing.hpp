@@ -0,0 +1,64 @@
+// ======================================================================
+// \title  Crc32Framing.hpp
+// \author cindy
+// \brief  F´ framing and deframing protocols with a fast frame checksum
+//
+// Frames are byte-for-byte those of Svc::FprimeFraming: start word, size,
+// data, then the big-endian CRC-32 of everything before it. Only the way
+// the CRC is computed differs, so the ground side is unchanged.
+// ======================================================================
+
+#ifndef MathModule_Crc32Framing_HPP
+#define MathModule_Crc32Framing_HPP
+
+#include <Svc/FramingProtocol/DeframingProtocol.hpp>
+#include <Svc/FramingProtocol/FramingProtocol.hpp>
+
+namespace MathModule {
+
+  //! Builds F´ frames, checksumming them with Crc32::update
+  class Crc32Framing :
+    public Svc::FramingProtocol
+  {
+
+    public:
+
+      Crc32Framing();
+
+      //! Frame the data and send it through the interface
+      void frame(
+          const U8* const data, //!< Packet data
+          const U32 size, //!< Bytes of packet data
+          Fw::ComPacket::ComPacketType packet_type //!< Type prepended to the data unless FW_PACKET_UNKNOWN
+      ) override;
+
+  };
+
+  //! Extracts F´ frames, checking them with Crc32::update
+  class Crc32Deframing :
+    public Svc::DeframingProtocol
+  {
+
+    public:
+
+      //! Bytes of the ring copied out per CRC update while validating a frame
+      static const U32 VALIDATE_CHUNK_SIZE = 512;
+
+      Crc32Deframing();
+
+      //! Route the frame at the start of the ring, or say what is wrong with it
+      DeframingStatus deframe(
+          Types::CircularBuffer& ring, //!< Received bytes
+          U32& needed //!< Set to the bytes needed for a whole frame
+      ) override;
+
+    PRIVATE:
+
+      //! Whether the CRC after the first size bytes of the ring matches them
+      bool validate(Types::CircularBuffer& ring, U32 size);
+
+  };
+
+}
+
+#endif
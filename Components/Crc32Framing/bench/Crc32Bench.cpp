@@ -0,0 +1,90 @@
+// ======================================================================
+// \title  Crc32Bench.cpp
+// \author cindy
+// \brief  Times each CRC-32 implementation over F´ frames
+//
+// Usage: crc32_bench [largest-payload]
+//
+// Payloads run from 64 bytes, doubling, up to FW_FILE_BUFFER_MAX_SIZE or
+// the given size. Each is timed as a frame checksum: the frame header and
+// the payload. BYTEWISE is the loop Utils::Hash runs, so its column is the
+// cost before Crc32Framing. Results are printed as one JSON object.
+// ======================================================================
+
+#include "Components/Crc32Framing/Crc32.hpp"
+
+#include <FpConfig.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+  //! Start word and size in front of the payload
+  const size_t FRAME_HEADER_SIZE = 8;
+
+  //! Time spent on each measurement
+  const double MEASURE_SECONDS = 0.2;
+
+  //! Nanoseconds per checksum of one frame
+  double measure(MathModule::Crc32::Implementation implementation, const std::vector<uint8_t>& frame)
+  {
+    volatile uint32_t sink = 0;
+    size_t iterations = 1;
+    while (true) {
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < iterations; i++) {
+        sink = MathModule::Crc32::update(implementation, sink, frame.data(), frame.size());
+      }
+      const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (seconds >= MEASURE_SECONDS) {
+        return seconds * 1e9 / static_cast<double>(iterations);
+      }
+      iterations *= 2;
+    }
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const size_t largest = (argc > 1) ? std::strtoul(argv[1], nullptr, 0) : FW_FILE_BUFFER_MAX_SIZE;
+  if (largest < 64) {
+    std::fprintf(stderr, "usage: %s [largest-payload >= 64]\n", argv[0]);
+    return 1;
+  }
+  std::vector<size_t> payloads;
+  for (size_t size = 64; size < largest; size *= 2) {
+    payloads.push_back(size);
+  }
+  payloads.push_back(largest);
+
+  std::printf("{\n  \"selected\": \"%s\",\n  \"frames\": [\n",
+              MathModule::Crc32::name(MathModule::Crc32::selected()));
+  for (size_t p = 0; p < payloads.size(); p++) {
+    std::vector<uint8_t> frame(FRAME_HEADER_SIZE + payloads[p]);
+    for (size_t i = 0; i < frame.size(); i++) {
+      frame[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    std::printf("    {\"payload\": %zu", payloads[p]);
+    double bytewise = 0;
+    for (uint32_t i = 0; i < MathModule::Crc32::IMPLEMENTATION_COUNT; i++) {
+      const MathModule::Crc32::Implementation implementation = static_cast<MathModule::Crc32::Implementation>(i);
+      if (!MathModule::Crc32::supported(implementation)) {
+        continue;
+      }
+      const double ns = measure(implementation, frame);
+      if (implementation == MathModule::Crc32::BYTEWISE) {
+        bytewise = ns;
+      }
+      std::printf(", \"%s\": {\"ns_per_frame\": %.1f, \"bytes_per_s\": %.0f, \"speedup\": %.2f}",
+                  MathModule::Crc32::name(implementation), ns, static_cast<double>(frame.size()) * 1e9 / ns,
+                  bytewise / ns);
+    }
+    std::printf("}%s\n", (p + 1 < payloads.size()) ? "," : "");
+  }
+  std::printf("  ]\n}\n");
+  return 0;
+}
@@ -0,0 +1,218 @@
+// ======================================================================
+// \title  Crc32FramingTestMain.cpp
+// \author cindy
+// \brief  cpp file for Crc32 and the Crc32Framing protocols test main function
+// ======================================================================
+
+#include "Components/Crc32Framing/Crc32.hpp"
+#include "Components/Crc32Framing/Crc32Framing.hpp"
+
+#include <Svc/FramingProtocol/FprimeProtocol.hpp>
+#include <Utils/Hash/Hash.hpp>
+#include <Utils/Types/CircularBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+  const MathModule::Crc32::Implementation IMPLEMENTATIONS[] = {
+    MathModule::Crc32::BYTEWISE,
+    MathModule::Crc32::SLICING_BY_8,
+    MathModule::Crc32::PCLMUL
+  };
+
+  std::vector<U8> testData(U32 size, U32 seed)
+  {
+    std::vector<U8> data(size);
+    U32 state = seed;
+    for (U32 i = 0; i < size; i++) {
+      state = state * 1103515245 + 12345;
+      data[i] = static_cast<U8>(state >> 16);
+    }
+    return data;
+  }
+
+  U32 utilsHash(const U8* data, U32 size)
+  {
+    Utils::Hash hash;
+    hash.init();
+    hash.update(data, static_cast<NATIVE_INT_TYPE>(size));
+    U32 value = 0;
+    hash.final(value);
+    return value;
+  }
+
+  //! Keeps every frame sent
+  class FramingInterface :
+    public Svc::FramingProtocolInterface
+  {
+    public:
+      Fw::Buffer allocate(const U32 size) override
+      {
+        this->m_storage.push_back(std::vector<U8>(size));
+        return Fw::Buffer(this->m_storage.back().data(), size);
+      }
+
+      void send(Fw::Buffer& outgoing) override
+      {
+        this->m_frames.push_back(std::vector<U8>(outgoing.getData(), outgoing.getData() + outgoing.getSize()));
+      }
+
+      std::vector<std::vector<U8> > m_storage;
+      std::vector<std::vector<U8> > m_frames;
+  };
+
+  //! Keeps every packet routed
+  class DeframingInterface :
+    public Svc::DeframingProtocolInterface
+  {
+    public:
+      Fw::Buffer allocate(const U32 size) override
+      {
+        this->m_storage.push_back(std::vector<U8>(size));
+        return Fw::Buffer(this->m_storage.back().data(), size);
+      }
+
+      void route(Fw::Buffer& data) override
+      {
+        this->m_packets.push_back(std::vector<U8>(data.getData(), data.getData() + data.getSize()));
+      }
+
+      std::vector<std::vector<U8> > m_storage;
+      std::vector<std::vector<U8> > m_packets;
+  };
+
+  std::vector<U8> frameWith(Svc::FramingProtocol& framing, const std::vector<U8>& data,
+                            Fw::ComPacket::ComPacketType type)
+  {
+    FramingInterface interface;
+    framing.setup(interface);
+    framing.frame(data.data(), static_cast<U32>(data.size()), type);
+    EXPECT_EQ(interface.m_frames.size(), 1U);
+    return interface.m_frames.empty() ? std::vector<U8>() : interface.m_frames[0];
+  }
+
+}
+
+TEST(Crc32, CheckValue) {
+  const char check[] = "123456789";
+  for (const MathModule::Crc32::Implementation implementation : IMPLEMENTATIONS) {
+    if (MathModule::Crc32::supported(implementation)) {
+      EXPECT_EQ(MathModule::Crc32::update(implementation, MathModule::Crc32::INITIAL, check, 9), 0xCBF43926U)
+          << MathModule::Crc32::name(implementation);
+    }
+  }
+  EXPECT_EQ(MathModule::Crc32::update(MathModule::Crc32::INITIAL, check, 9), 0xCBF43926U);
+  EXPECT_EQ(MathModule::Crc32::update(MathModule::Crc32::INITIAL, check, 0), MathModule::Crc32::INITIAL);
+}
+
+TEST(Crc32, MatchesUtilsHash) {
+  const std::vector<U8> data = testData(FW_FILE_BUFFER_MAX_SIZE + 2048, 1);
+  for (U32 offset = 0; offset < 16; offset++) {
+    for (U32 size = 0; size + offset <= data.size(); size += (size < 300) ? 1 : 61) {
+      const U32 expected = utilsHash(data.data() + offset, size);
+      for (const MathModule::Crc32::Implementation implementation : IMPLEMENTATIONS) {
+        if (MathModule::Crc32::supported(implementation)) {
+          ASSERT_EQ(MathModule::Crc32::update(implementation, MathModule::Crc32::INITIAL, data.data() + offset, size),
+                    expected) << MathModule::Crc32::name(implementation) << " offset " << offset << " size " << size;
+        }
+      }
+    }
+  }
+}
+
+TEST(Crc32, Chained) {
+  const std::vector<U8> data = testData(1000, 2);
+  const U32 expected = MathModule::Crc32::update(MathModule::Crc32::INITIAL, data.data(), data.size());
+  for (U32 split = 0; split <= data.size(); split += 37) {
+    U32 crc = MathModule::Crc32::update(MathModule::Crc32::INITIAL, data.data(), split);
+    crc = MathModule::Crc32::update(crc, data.data() + split, data.size() - split);
+    EXPECT_EQ(crc, expected) << "split " << split;
+  }
+}
+
+TEST(Framing, MatchesFprimeFraming) {
+  const Fw::ComPacket::ComPacketType types[] = {
+    Fw::ComPacket::FW_PACKET_UNKNOWN,
+    Fw::ComPacket::FW_PACKET_TELEM,
+    Fw::ComPacket::FW_PACKET_FILE
+  };
+  const U32 sizes[] = {1, 63, 64, 255, FW_COM_BUFFER_MAX_SIZE, FW_FILE_BUFFER_MAX_SIZE};
+  for (const Fw::ComPacket::ComPacketType type : types) {
+    for (const U32 size : sizes) {
+      const std::vector<U8> data = testData(size, size);
+      Svc::FprimeFraming reference;
+      MathModule::Crc32Framing framing;
+      EXPECT_EQ(frameWith(framing, data, type), frameWith(reference, data, type))
+          << "type " << type << " size " << size;
+    }
+  }
+}
+
+TEST(Deframing, RoundTrip) {
+  const U32 capacity = 4 * FW_FILE_BUFFER_MAX_SIZE;
+  std::vector<U8> storage(capacity);
+  Types::CircularBuffer ring(storage.data(), capacity);
+  DeframingInterface interface;
+  MathModule::Crc32Deframing deframing;
+  deframing.setup(interface);
+
+  // Start each frame at a different place so some wrap around the end of the ring
+  for (U32 shift = 0; shift < capacity; shift += 97) {
+    const std::vector<U8> data = testData(FW_FILE_BUFFER_MAX_SIZE, shift);
+    MathModule::Crc32Framing framing;
+    const std::vector<U8> frame = frameWith(framing, data, Fw::ComPacket::FW_PACKET_UNKNOWN);
+    const std::vector<U8> filler(97);
+    ASSERT_EQ(ring.serialize(filler.data(), static_cast<NATIVE_UINT_TYPE>(filler.size())), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(ring.rotate(static_cast<NATIVE_UINT_TYPE>(filler.size())), Fw::FW_SERIALIZE_OK);
+
+    U32 needed = 0;
+    ASSERT_EQ(ring.serialize(frame.data(), 5), Fw::FW_SERIALIZE_OK);
+    EXPECT_EQ(deframing.deframe(ring, needed), Svc::DeframingProtocol::DEFRAMING_MORE_NEEDED);
+    EXPECT_EQ(needed, Svc::FpFrameHeader::SIZE);
+    ASSERT_EQ(ring.serialize(frame.data() + 5, static_cast<NATIVE_UINT_TYPE>(frame.size() - 5)),
+              Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(deframing.deframe(ring, needed), Svc::DeframingProtocol::DEFRAMING_STATUS_SUCCESS);
+    EXPECT_EQ(needed, frame.size());
+    ASSERT_EQ(ring.rotate(needed), Fw::FW_SERIALIZE_OK);
+    ASSERT_FALSE(interface.m_packets.empty());
+    EXPECT_EQ(interface.m_packets.back(), data);
+  }
+}
+
+TEST(Deframing, Rejects) {
+  std::vector<U8> storage(2 * FW_FILE_BUFFER_MAX_SIZE);
+  DeframingInterface interface;
+  MathModule::Crc32Deframing deframing;
+  deframing.setup(interface);
+  MathModule::Crc32Framing framing;
+  const std::vector<U8> frame = frameWith(framing, testData(100, 3), Fw::ComPacket::FW_PACKET_COMMAND);
+  U32 needed = 0;
+
+  for (U32 corrupt = 0; corrupt < frame.size(); corrupt += 7) {
+    std::vector<U8> bad(frame);
+    bad[corrupt] ^= 0x10;
+    Types::CircularBuffer ring(storage.data(), static_cast<NATIVE_UINT_TYPE>(storage.size()));
+    ASSERT_EQ(ring.serialize(bad.data(), static_cast<NATIVE_UINT_TYPE>(bad.size())), Fw::FW_SERIALIZE_OK);
+    // The only size byte hit is the lowest, and flipping it grows the frame past the bytes buffered
+    const Svc::DeframingProtocol::DeframingStatus expected =
+        (corrupt < sizeof(U32)) ? Svc::DeframingProtocol::DEFRAMING_INVALID_FORMAT
+        : (corrupt < Svc::FpFrameHeader::SIZE) ? Svc::DeframingProtocol::DEFRAMING_MORE_NEEDED
+        : Svc::DeframingProtocol::DEFRAMING_INVALID_CHECKSUM;
+    EXPECT_EQ(deframing.deframe(ring, needed), expected) << "byte " << corrupt;
+  }
+
+  // A size the ring could never hold
+  std::vector<U8> large(frame);
+  large[4] = 0x7F;
+  Types::CircularBuffer ring(storage.data(), static_cast<NATIVE_UINT_TYPE>(storage.size()));
+  ASSERT_EQ(ring.serialize(large.data(), static_cast<NATIVE_UINT_TYPE>(large.size())), Fw::FW_SERIALIZE_OK);
+  EXPECT_EQ(deframing.deframe(ring, needed), Svc::DeframingProtocol::DEFRAMING_INVALID_SIZE);
+  EXPECT_TRUE(interface.m_packets.empty());
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
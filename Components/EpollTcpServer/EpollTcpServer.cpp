@@ -0,0 +1,647 @@
+// ======================================================================
+// \title  EpollTcpServer.cpp
+// \author cindy
+// \brief  cpp file for EpollTcpServer component implementation class
+// ======================================================================
+
+#include "Components/EpollTcpServer/EpollTcpServer.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    U32 readU32(const U8* bytes)
+    {
+      return (static_cast<U32>(bytes[0]) << 24) | (static_cast<U32>(bytes[1]) << 16) |
+             (static_cast<U32>(bytes[2]) << 8) | static_cast<U32>(bytes[3]);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  EpollTcpServer ::
+    EpollTcpServer(const char* const compName) :
+      EpollTcpServerComponentBase(compName),
+      m_listenFd(-1),
+      m_epollFd(-1),
+      m_wakeFd(-1),
+      m_listenPort(0),
+      m_started(false),
+      m_quit(false),
+      m_clientCount(0),
+      m_bytesSent(0),
+      m_framesDropped(0),
+      m_uplinkFrames(0),
+      m_uplinkDiscarded(0)
+  {
+    for (U32 slot = 0; slot < MAX_CLIENTS; slot++) {
+      Client& client = this->m_clients[slot];
+      client.fd = -1;
+      client.failed = false;
+      client.error = 0;
+      client.writeArmed = false;
+      client.queueHead = 0;
+      client.queueCount = 0;
+      client.offset = 0;
+      client.uplinkCount = 0;
+    }
+    for (U32 index = 0; index < FRAME_SLOTS; index++) {
+      this->m_frames[index].references = 0;
+    }
+  }
+
+  EpollTcpServer ::
+    ~EpollTcpServer()
+  {
+    if (this->m_wakeFd >= 0) {
+      (void) ::close(this->m_wakeFd);
+    }
+    if (this->m_epollFd >= 0) {
+      (void) ::close(this->m_epollFd);
+    }
+    if (this->m_listenFd >= 0) {
+      (void) ::close(this->m_listenFd);
+    }
+  }
+
+  bool EpollTcpServer ::
+    open(const char* hostname, U16 port)
+  {
+    FW_ASSERT(this->m_listenFd < 0);
+    char service[8];
+    (void) ::snprintf(service, sizeof(service), "%u", static_cast<unsigned int>(port));
+
+    struct addrinfo hints;
+    ::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    struct addrinfo* addresses = nullptr;
+    if (::getaddrinfo(hostname, service, &hints, &addresses) != 0) {
+      this->log_WARNING_HI_LISTEN_ERROR(port, EADDRNOTAVAIL);
+      return false;
+    }
+
+    int fd = -1;
+    int error = 0;
+    for (struct addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+      fd = ::socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, address->ai_protocol);
+      if (fd < 0) {
+        error = errno;
+        continue;
+      }
+      const int one = 1;
+      (void) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      if ((::bind(fd, address->ai_addr, address->ai_addrlen) == 0) &&
+          (::listen(fd, static_cast<int>(MAX_CLIENTS)) == 0)) {
+        break;
+      }
+      error = errno;
+      (void) ::close(fd);
+      fd = -1;
+    }
+    ::freeaddrinfo(addresses);
+    if (fd < 0) {
+      this->log_WARNING_HI_LISTEN_ERROR(port, error);
+      return false;
+    }
+
+    struct sockaddr_in bound;
+    socklen_t boundSize = sizeof(bound);
+    if (::getsockname(fd, reinterpret_cast<struct sockaddr*>(&bound), &boundSize) == 0) {
+      this->m_listenPort = ntohs(bound.sin_port);
+    }
+
+    const int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    const int wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    bool registered = (epollFd >= 0) && (wakeFd >= 0);
+    error = errno;
+    if (registered) {
+      struct epoll_event event;
+      ::memset(&event, 0, sizeof(event));
+      event.events = EPOLLIN;
+      event.data.u64 = LISTEN_TAG;
+      registered = (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0);
+      event.data.u64 = WAKE_TAG;
+      registered = registered && (::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0);
+      error = errno;
+    }
+    if (!registered) {
+      if (wakeFd >= 0) {
+        (void) ::close(wakeFd);
+      }
+      if (epollFd >= 0) {
+        (void) ::close(epollFd);
+      }
+      (void) ::close(fd);
+      this->log_WARNING_HI_LISTEN_ERROR(port, error);
+      return false;
+    }
+
+    this->m_listenFd = fd;
+    this->m_epollFd = epollFd;
+    this->m_wakeFd = wakeFd;
+    return true;
+  }
+
+  U16 EpollTcpServer ::
+    getListenPort() const
+  {
+    return this->m_listenPort;
+  }
+
+  void EpollTcpServer ::
+    startReadThread(NATIVE_UINT_TYPE priority, NATIVE_UINT_TYPE stackSize)
+  {
+    FW_ASSERT(this->m_listenFd >= 0);
+    FW_ASSERT(!this->m_started);
+    Os::TaskString name("EpollServer");
+    const Os::Task::TaskStatus status =
+      this->m_task.start(name, EpollTcpServer::serverTask, this, priority, stackSize);
+    FW_ASSERT(status == Os::Task::TASK_OK, status);
+    this->m_started = true;
+  }
+
+  void EpollTcpServer ::
+    quitReadThread()
+  {
+    this->m_lock.lock();
+    this->m_quit = true;
+    this->m_lock.unLock();
+
+    if (this->m_wakeFd >= 0) {
+      const U64 one = 1;
+      (void) ::write(this->m_wakeFd, &one, sizeof(one));
+    }
+  }
+
+  Os::Task::TaskStatus EpollTcpServer ::
+    join()
+  {
+    Os::Task::TaskStatus status = Os::Task::TASK_OK;
+    if (this->m_started) {
+      status = this->m_task.join(nullptr);
+      this->m_started = false;
+    }
+    for (U32 slot = 0; slot < MAX_CLIENTS; slot++) {
+      this->closeClient(slot, 0);
+    }
+    return status;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    The frame is queued for every client by reference and each queue is
+    flushed with a non-blocking send right away, so a client keeping up sees
+    no added latency and the downlink thread never waits on a socket. A client
+    whose queue is full skips the frame, which keeps the frames it does get
+    whole; the others are unaffected. The buffer goes back to the buffer
+    manager when the last client has sent it. SEND_ERROR with no client
+    connected leaves the com stub waiting for the next ready, as with the
+    other drivers.
+  */
+  Drv::SendStatus EpollTcpServer ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    Fw::Buffer released[FRAME_SLOTS];
+    U32 releasedCount = 0;
+
+    this->m_lock.lock();
+    if (this->m_clientCount == 0) {
+      this->m_lock.unLock();
+      this->deallocate_out(0, fwBuffer);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+
+    // Queued frames hold at most FRAME_SLOTS - 1 records, so one is always free
+    U32 index = 0;
+    while ((index < FRAME_SLOTS) && (this->m_frames[index].references != 0)) {
+      ++index;
+    }
+    FW_ASSERT(index < FRAME_SLOTS, index);
+    this->m_frames[index].buffer = fwBuffer;
+    this->m_frames[index].references = 1;
+
+    for (U32 slot = 0; slot < MAX_CLIENTS; slot++) {
+      Client& client = this->m_clients[slot];
+      if ((client.fd < 0) || client.failed) {
+        continue;
+      }
+      if (client.queueCount == CLIENT_QUEUE_DEPTH) {
+        ++this->m_framesDropped;
+        continue;
+      }
+      client.queue[(client.queueHead + client.queueCount) % CLIENT_QUEUE_DEPTH] = index;
+      ++client.queueCount;
+      ++this->m_frames[index].references;
+      this->flushClient(client, released, releasedCount);
+    }
+    this->releaseFrame(index, released, releasedCount);
+    this->m_lock.unLock();
+
+    this->deallocateFrames(released, releasedCount);
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  void EpollTcpServer ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->m_lock.lock();
+    const U32 clients = this->m_clientCount;
+    const U64 bytes = this->m_bytesSent;
+    const U32 dropped = this->m_framesDropped;
+    const U32 uplinkFrames = this->m_uplinkFrames;
+    const U32 discarded = this->m_uplinkDiscarded;
+    this->m_lock.unLock();
+
+    this->tlmWrite_CLIENTS(clients);
+    this->tlmWrite_BYTES_SENT(bytes);
+    this->tlmWrite_FRAMES_DROPPED(dropped);
+    this->tlmWrite_UPLINK_FRAMES(uplinkFrames);
+    this->tlmWrite_UPLINK_BYTES_DISCARDED(discarded);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  void EpollTcpServer ::
+    acceptClients()
+  {
+    while (true) {
+      const int fd = ::accept4(this->m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        // EAGAIN once the backlog is empty; anything else is retried on the next readiness
+        return;
+      }
+      const int one = 1;
+      (void) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+      this->m_lock.lock();
+      U32 slot = 0;
+      while ((slot < MAX_CLIENTS) && (this->m_clients[slot].fd >= 0)) {
+        ++slot;
+      }
+      bool accepted = (slot < MAX_CLIENTS);
+      if (accepted) {
+        struct epoll_event event;
+        ::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = slot;
+        accepted = (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, fd, &event) == 0);
+      }
+      const bool first = accepted && (this->m_clientCount == 0);
+      if (accepted) {
+        Client& client = this->m_clients[slot];
+        client.fd = fd;
+        client.failed = false;
+        client.error = 0;
+        client.writeArmed = false;
+        client.queueHead = 0;
+        client.queueCount = 0;
+        client.offset = 0;
+        client.uplinkCount = 0;
+        ++this->m_clientCount;
+      }
+      this->m_lock.unLock();
+
+      if (!accepted) {
+        (void) ::close(fd);
+        this->log_WARNING_LO_CLIENT_REJECTED();
+        continue;
+      }
+      this->log_ACTIVITY_HI_CLIENT_CONNECTED(slot);
+      if (first) {
+        this->ready_out(0);
+      }
+    }
+  }
+
+  /*
+    One read per readiness event, so a client streaming uplink cannot starve
+    the others; epoll is level triggered and reports the rest next time.
+  */
+  bool EpollTcpServer ::
+    readClient(U32 slot, I32& error)
+  {
+    Client& client = this->m_clients[slot];
+    FW_ASSERT(client.uplinkCount < UPLINK_BUFFER_SIZE, client.uplinkCount);
+    while (true) {
+      const ssize_t received = ::recv(client.fd, &client.uplink[client.uplinkCount],
+                                      UPLINK_BUFFER_SIZE - client.uplinkCount, MSG_DONTWAIT);
+      if (received > 0) {
+        client.uplinkCount += static_cast<U32>(received);
+        this->forwardFrames(client);
+        return true;
+      }
+      if (received == 0) {
+        error = 0;
+        return false;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+        return true;
+      }
+      error = errno;
+      return false;
+    }
+  }
+
+  /*
+    Clients share one deframer, so only whole frames go up and bytes from two
+    clients never interleave inside a frame. Only the start word and size are
+    checked here; the deframer still checks the CRC. Bytes that cannot start
+    a frame are skipped one at a time until the start word is found again.
+  */
+  void EpollTcpServer ::
+    forwardFrames(Client& client)
+  {
+    U32 position = 0;
+    U32 runStart = 0;
+    U32 runFrames = 0;
+    U32 frames = 0;
+    U32 discarded = 0;
+
+    while (true) {
+      const U32 available = client.uplinkCount - position;
+      bool skip = false;
+      bool complete = false;
+      U32 frameSize = 0;
+      if (available >= FRAME_HEADER_SIZE) {
+        const U32 payloadSize = readU32(&client.uplink[position + sizeof(U32)]);
+        skip = (readU32(&client.uplink[position]) != FRAME_START_WORD) ||
+               (payloadSize > UPLINK_BUFFER_SIZE - FRAME_HEADER_SIZE - FRAME_TRAILER_SIZE);
+        frameSize = FRAME_HEADER_SIZE + payloadSize + FRAME_TRAILER_SIZE;
+        complete = !skip && (available >= frameSize);
+      }
+      if (complete) {
+        position += frameSize;
+        ++runFrames;
+        continue;
+      }
+      if (!skip && (runStart == position)) {
+        break;
+      }
+
+      // Pass up the run of whole frames ending here
+      const U32 runSize = position - runStart;
+      if (runSize > 0) {
+        Fw::Buffer buffer = this->allocate_out(0, runSize);
+        if ((buffer.getData() != nullptr) && (buffer.getSize() >= runSize)) {
+          ::memcpy(buffer.getData(), &client.uplink[runStart], runSize);
+          buffer.setSize(runSize);
+          this->recv_out(0, buffer, Drv::RecvStatus::RECV_OK);
+          frames += runFrames;
+        } else {
+          if (buffer.getData() != nullptr) {
+            this->deallocate_out(0, buffer);
+          }
+          discarded += runSize;
+        }
+      }
+      runFrames = 0;
+      if (!skip) {
+        runStart = position;
+        break;
+      }
+      ++position;
+      ++discarded;
+      runStart = position;
+    }
+
+    const U32 remaining = client.uplinkCount - runStart;
+    ::memmove(client.uplink, &client.uplink[runStart], remaining);
+    client.uplinkCount = remaining;
+
+    if ((frames > 0) || (discarded > 0)) {
+      this->m_lock.lock();
+      this->m_uplinkFrames += frames;
+      this->m_uplinkDiscarded += discarded;
+      this->m_lock.unLock();
+    }
+  }
+
+  /*
+    A short send means the socket buffer is full. EPOLLOUT is then armed so the
+    task resumes the queue once the client catches up, and disarmed as soon as
+    the queue drains so an idle client costs no wakeups. A failed send only
+    marks the client and wakes the task, which closes it, so client sockets
+    are only opened and closed on one thread.
+  */
+  void EpollTcpServer ::
+    flushClient(Client& client, Fw::Buffer* released, U32& releasedCount)
+  {
+    while ((client.queueCount > 0) && !client.failed) {
+      struct iovec iov[MAX_IOV];
+      const U32 count = FW_MIN(client.queueCount, MAX_IOV);
+      size_t total = 0;
+      for (U32 i = 0; i < count; i++) {
+        const Fw::Buffer& frame = this->m_frames[client.queue[(client.queueHead + i) % CLIENT_QUEUE_DEPTH]].buffer;
+        const U32 skip = (i == 0) ? client.offset : 0;
+        iov[i].iov_base = frame.getData() + skip;
+        iov[i].iov_len = frame.getSize() - skip;
+        total += iov[i].iov_len;
+      }
+      struct msghdr msg;
+      ::memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = iov;
+      msg.msg_iovlen = count;
+      const ssize_t result = ::sendmsg(client.fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+          client.failed = true;
+          client.error = errno;
+          const U64 one = 1;
+          (void) ::write(this->m_wakeFd, &one, sizeof(one));
+        }
+        break;
+      }
+
+      this->m_bytesSent += static_cast<U64>(result);
+      size_t remaining = static_cast<size_t>(result);
+      while (client.queueCount > 0) {
+        const U32 index = client.queue[client.queueHead];
+        const U32 left = this->m_frames[index].buffer.getSize() - client.offset;
+        if (remaining < left) {
+          client.offset += static_cast<U32>(remaining);
+          break;
+        }
+        remaining -= left;
+        client.offset = 0;
+        client.queueHead = (client.queueHead + 1) % CLIENT_QUEUE_DEPTH;
+        --client.queueCount;
+        this->releaseFrame(index, released, releasedCount);
+      }
+      if (static_cast<size_t>(result) < total) {
+        break;
+      }
+    }
+
+    const bool wantWrite = (client.queueCount > 0) && !client.failed;
+    if (wantWrite != client.writeArmed) {
+      struct epoll_event event;
+      ::memset(&event, 0, sizeof(event));
+      event.events = EPOLLIN | EPOLLRDHUP | (wantWrite ? EPOLLOUT : 0);
+      event.data.u64 = static_cast<U64>(&client - this->m_clients);
+      (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_MOD, client.fd, &event);
+      client.writeArmed = wantWrite;
+    }
+  }
+
+  void EpollTcpServer ::
+    releaseFrame(U32 index, Fw::Buffer* released, U32& releasedCount)
+  {
+    SharedFrame& frame = this->m_frames[index];
+    FW_ASSERT(frame.references > 0, index);
+    --frame.references;
+    if (frame.references == 0) {
+      FW_ASSERT(releasedCount < FRAME_SLOTS, releasedCount);
+      released[releasedCount++] = frame.buffer;
+    }
+  }
+
+  void EpollTcpServer ::
+    closeClient(U32 slot, I32 error)
+  {
+    Fw::Buffer released[FRAME_SLOTS];
+    U32 releasedCount = 0;
+
+    this->m_lock.lock();
+    Client& client = this->m_clients[slot];
+    if (client.fd < 0) {
+      this->m_lock.unLock();
+      return;
+    }
+    (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+    (void) ::close(client.fd);
+    client.fd = -1;
+    while (client.queueCount > 0) {
+      this->releaseFrame(client.queue[client.queueHead], released, releasedCount);
+      client.queueHead = (client.queueHead + 1) % CLIENT_QUEUE_DEPTH;
+      --client.queueCount;
+    }
+    client.offset = 0;
+    client.failed = false;
+    client.writeArmed = false;
+    client.uplinkCount = 0;
+    --this->m_clientCount;
+    const bool quit = this->m_quit;
+    this->m_lock.unLock();
+
+    this->deallocateFrames(released, releasedCount);
+    if (!quit) {
+      this->log_ACTIVITY_HI_CLIENT_DISCONNECTED(slot, error);
+    }
+  }
+
+  void EpollTcpServer ::
+    deallocateFrames(Fw::Buffer* released, U32 releasedCount)
+  {
+    for (U32 i = 0; i < releasedCount; i++) {
+      this->deallocate_out(0, released[i]);
+    }
+  }
+
+  void EpollTcpServer ::
+    serverTask(void* arg)
+  {
+    EpollTcpServer* server = static_cast<EpollTcpServer*>(arg);
+    FW_ASSERT(server != nullptr);
+    struct epoll_event events[MAX_EVENTS];
+
+    while (true) {
+      server->m_lock.lock();
+      const bool quit = server->m_quit;
+      server->m_lock.unLock();
+      if (quit) {
+        break;
+      }
+
+      const int ready = ::epoll_wait(server->m_epollFd, events, MAX_EVENTS, -1);
+      if (ready < 0) {
+        FW_ASSERT(errno == EINTR, errno);
+        continue;
+      }
+      for (int i = 0; i < ready; i++) {
+        const U64 tag = events[i].data.u64;
+        if (tag == LISTEN_TAG) {
+          server->acceptClients();
+          continue;
+        }
+        if (tag == WAKE_TAG) {
+          U64 count = 0;
+          (void) ::read(server->m_wakeFd, &count, sizeof(count));
+          continue;
+        }
+
+        const U32 slot = static_cast<U32>(tag);
+        FW_ASSERT(slot < MAX_CLIENTS, slot);
+        if (server->m_clients[slot].fd < 0) {
+          continue;
+        }
+        I32 error = 0;
+        bool connected = true;
+        if ((events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0) {
+          connected = server->readClient(slot, error);
+        }
+        if (connected && ((events[i].events & EPOLLOUT) != 0)) {
+          Fw::Buffer released[FRAME_SLOTS];
+          U32 releasedCount = 0;
+          server->m_lock.lock();
+          server->flushClient(server->m_clients[slot], released, releasedCount);
+          server->m_lock.unLock();
+          server->deallocateFrames(released, releasedCount);
+        }
+        if (!connected) {
+          server->closeClient(slot, error);
+        }
+      }
+
+      // Clients whose send failed on the downlink thread
+      for (U32 slot = 0; slot < MAX_CLIENTS; slot++) {
+        server->m_lock.lock();
+        const Client& client = server->m_clients[slot];
+        const bool failed = (client.fd >= 0) && client.failed;
+        const I32 error = client.error;
+        server->m_lock.unLock();
+        if (failed) {
+          server->closeClient(slot, error);
+        }
+      }
+    }
+  }
+
+}
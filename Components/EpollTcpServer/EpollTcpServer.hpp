@@ -0,0 +1,208 @@
+// ======================================================================
+// \title  EpollTcpServer.hpp
+// \author cindy
+// \brief  hpp file for EpollTcpServer component implementation class
+// ======================================================================
+
+#ifndef MathModule_EpollTcpServer_HPP
+#define MathModule_EpollTcpServer_HPP
+
+#include "Components/EpollTcpServer/EpollTcpServerComponentAc.hpp"
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
+
+namespace MathModule {
+
+  class EpollTcpServer :
+    public EpollTcpServerComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Ground stations served at once
+      static const U32 MAX_CLIENTS = 4;
+
+      //! Frames queued for one client. A client that falls further behind skips frames.
+      static const U32 CLIENT_QUEUE_DEPTH = 6;
+
+      //! Shared frame records. Every queued frame holds one, plus the frame being fanned out.
+      static const U32 FRAME_SLOTS = MAX_CLIENTS * CLIENT_QUEUE_DEPTH + 1;
+
+      //! Frames handed to the kernel per writev call
+      static const U32 MAX_IOV = CLIENT_QUEUE_DEPTH;
+
+      //! Per-client uplink reassembly buffer. Holds the largest uplink frame.
+      static const U32 UPLINK_BUFFER_SIZE = 4096;
+
+      //! F´ frame layout: start word, payload size, payload, CRC32
+      static const U32 FRAME_START_WORD = 0xDEADBEEF;
+      static const U32 FRAME_HEADER_SIZE = 2 * sizeof(U32);
+      static const U32 FRAME_TRAILER_SIZE = sizeof(U32);
+
+      //! Events handled per epoll_wait call
+      static const U32 MAX_EVENTS = 16;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct EpollTcpServer object
+      EpollTcpServer(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy EpollTcpServer object
+      ~EpollTcpServer();
+
+      //! Open the listening socket
+      //! \return true if the server is listening
+      bool open(
+          const char* hostname, //!< Address to listen on, or nullptr for every interface
+          U16 port //!< Port to listen on, 0 for an ephemeral port
+      );
+
+      //! Port the server listens on, useful after opening port 0
+      U16 getListenPort() const;
+
+      //! Start the task that accepts clients and services their sockets
+      void startReadThread(
+          NATIVE_UINT_TYPE priority, //!< Task priority
+          NATIVE_UINT_TYPE stackSize //!< Task stack size
+      );
+
+      //! Ask the task to exit
+      void quitReadThread();
+
+      //! Wait for the task to exit, disconnect every client and close the listening socket
+      Os::Task::TaskStatus join();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! A downlink frame shared by every client queue holding it
+      struct SharedFrame {
+        Fw::Buffer buffer; //!< The framed buffer
+        U32 references; //!< Client queues holding the frame, plus the fan-out in progress
+      };
+
+      //! One connected ground station
+      struct Client {
+        int fd; //!< Socket, or -1 when the slot is free
+        bool failed; //!< Whether a send failed; the task closes the socket
+        I32 error; //!< The errno value of the failure
+        bool writeArmed; //!< Whether EPOLLOUT is armed
+        U32 queue[CLIENT_QUEUE_DEPTH]; //!< Shared frame indices, as a ring
+        U32 queueHead; //!< First queued frame
+        U32 queueCount; //!< Queued frames
+        U32 offset; //!< Bytes of the first queued frame already sent
+        U8 uplink[UPLINK_BUFFER_SIZE]; //!< Uplink bytes not yet forming a complete frame. Owned by the task.
+        U32 uplinkCount; //!< Bytes in uplink
+      };
+
+      //! epoll user data of the listening socket and the wakeup eventfd; clients use their slot
+      static const U64 LISTEN_TAG = MAX_CLIENTS;
+      static const U64 WAKE_TAG = MAX_CLIENTS + 1;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Accept every pending connection
+      void acceptClients();
+
+      //! Read from a client and pass up the complete frames
+      //! \return whether the client is still connected
+      bool readClient(
+          U32 slot, //!< The client slot
+          I32& error //!< The errno value when disconnected, 0 for an orderly close
+      );
+
+      //! Pass up the complete frames at the start of a client's uplink buffer and keep the rest
+      void forwardFrames(Client& client);
+
+      //! Send as much of a client's queue as the socket takes without blocking. Called with m_lock held.
+      void flushClient(Client& client, Fw::Buffer* released, U32& releasedCount);
+
+      //! Drop a reference to a shared frame, adding its buffer to released when it was the last. Called with m_lock held.
+      void releaseFrame(U32 index, Fw::Buffer* released, U32& releasedCount);
+
+      //! Close a client and release its queued frames
+      void closeClient(U32 slot, I32 error);
+
+      //! Return buffers whose last reference was dropped
+      void deallocateFrames(Fw::Buffer* released, U32 releasedCount);
+
+      //! Task entry point
+      static void serverTask(void* arg);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Listening socket, epoll instance and wakeup eventfd, or -1
+      int m_listenFd;
+      int m_epollFd;
+      int m_wakeFd;
+
+      //! Port the server listens on
+      U16 m_listenPort;
+
+      //! Guards the clients' send state, the shared frames and the statistics
+      Os::Mutex m_lock;
+
+      //! Task accepting clients and servicing their sockets
+      Os::Task m_task;
+
+      //! Whether the task was started, and whether it was asked to exit
+      bool m_started;
+      bool m_quit;
+
+      //! Client slots
+      Client m_clients[MAX_CLIENTS];
+      U32 m_clientCount;
+
+      //! Shared frame records
+      SharedFrame m_frames[FRAME_SLOTS];
+
+      //! Telemetry counters
+      U64 m_bytesSent;
+      U32 m_framesDropped;
+      U32 m_uplinkFrames;
+      U32 m_uplinkDiscarded;
+
+  };
+
+}
+
+#endif
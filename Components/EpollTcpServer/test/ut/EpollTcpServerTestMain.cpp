@@ -0,0 +1,30 @@
+// ======================================================================
+// \title  EpollTcpServerTestMain.cpp
+// \author cindy
+// \brief  cpp file for EpollTcpServer component test main function
+// ======================================================================
+
+#include "EpollTcpServerTester.hpp"
+
+TEST(Nominal, FanOut) {
+  MathModule::EpollTcpServerTester tester;
+  ASSERT_TRUE(tester.openServer());
+  tester.testFanOut();
+}
+
+TEST(Nominal, SlowClient) {
+  MathModule::EpollTcpServerTester tester;
+  ASSERT_TRUE(tester.openServer());
+  tester.testSlowClient();
+}
+
+TEST(Nominal, UplinkMerge) {
+  MathModule::EpollTcpServerTester tester;
+  ASSERT_TRUE(tester.openServer());
+  tester.testUplinkMerge();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,372 @@
+// ======================================================================
+// \title  EpollTcpServerTester.cpp
+// \author cindy
+// \brief  cpp file for EpollTcpServer component test harness implementation class
+// ======================================================================
+
+#include "EpollTcpServerTester.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    std::vector<U8> testPayload(U32 size, U8 seed)
+    {
+      std::vector<U8> payload(size);
+      for (U32 i = 0; i < size; i++) {
+        payload[i] = static_cast<U8>(seed + 3 * i);
+      }
+      return payload;
+    }
+
+    void appendU32(std::vector<U8>& bytes, U32 value)
+    {
+      bytes.push_back(static_cast<U8>(value >> 24));
+      bytes.push_back(static_cast<U8>(value >> 16));
+      bytes.push_back(static_cast<U8>(value >> 8));
+      bytes.push_back(static_cast<U8>(value));
+    }
+
+    U32 readU32(const U8* bytes)
+    {
+      return (static_cast<U32>(bytes[0]) << 24) | (static_cast<U32>(bytes[1]) << 16) |
+             (static_cast<U32>(bytes[2]) << 8) | static_cast<U32>(bytes[3]);
+    }
+
+    //! An F´ frame around the payload; the server does not check the CRC, the deframer does
+    std::vector<U8> fprimeFrame(const std::vector<U8>& payload)
+    {
+      std::vector<U8> frame;
+      appendU32(frame, EpollTcpServer::FRAME_START_WORD);
+      appendU32(frame, static_cast<U32>(payload.size()));
+      frame.insert(frame.end(), payload.begin(), payload.end());
+      appendU32(frame, 0x12345678);
+      return frame;
+    }
+
+    void writeGround(int fd, const std::vector<U8>& bytes)
+    {
+      ASSERT_EQ(::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL), static_cast<ssize_t>(bytes.size()));
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  EpollTcpServerTester ::
+    EpollTcpServerTester() :
+      EpollTcpServerGTestBase("EpollTcpServerTester", EpollTcpServerTester::MAX_HISTORY_SIZE),
+      component("EpollTcpServer"),
+      m_deallocated(0),
+      m_ready(0),
+      m_reportedClients(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  EpollTcpServerTester ::
+    ~EpollTcpServerTester()
+  {
+    this->closeServer();
+  }
+
+  bool EpollTcpServerTester ::
+    openServer()
+  {
+    if (!this->component.open("127.0.0.1", 0)) {
+      return false;
+    }
+    this->component.startReadThread(Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+    return true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void EpollTcpServerTester ::
+    testFanOut()
+  {
+    std::vector<U8> early = testPayload(64, 0x10);
+    Fw::Buffer earlyBuffer(early.data(), static_cast<U32>(early.size()));
+    EXPECT_EQ(this->invoke_to_send(0, earlyBuffer), Drv::SendStatus::SEND_ERROR);
+    EXPECT_EQ(this->m_deallocated, 1U);
+
+    const int first = this->connectGround(0);
+    const int second = this->connectGround(0);
+    ASSERT_TRUE(this->waitForClients(2));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_ready, 1U);
+    this->m_lock.unLock();
+
+    std::vector<U8> frames[3] = {testPayload(100, 0x20), testPayload(1000, 0x30), testPayload(5000, 0x40)};
+    std::vector<U8> expected;
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(frames); i++) {
+      Fw::Buffer buffer(frames[i].data(), static_cast<U32>(frames[i].size()));
+      EXPECT_EQ(this->invoke_to_send(0, buffer), Drv::SendStatus::SEND_OK);
+      expected.insert(expected.end(), frames[i].begin(), frames[i].end());
+    }
+    EXPECT_EQ(this->readGround(first, expected.size()), expected);
+    EXPECT_EQ(this->readGround(second, expected.size()), expected);
+    ASSERT_TRUE(this->waitForDeallocated(1 + FW_NUM_ARRAY_ELEMENTS(frames)));
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_BYTES_SENT_SIZE(1);
+    ASSERT_TLM_BYTES_SENT(0, 2 * expected.size());
+  }
+
+  /*
+    The slow client's receive buffer is tiny and it reads nothing until the
+    end, so the server's send buffer to it fills and its queue overflows. The
+    fast client reads each frame before the next is sent, which only works if
+    the slow one never holds up the send path.
+  */
+  void EpollTcpServerTester ::
+    testSlowClient()
+  {
+    const U32 frameCount = 200;
+    const U32 frameSize = 65536;
+    const int slow = this->connectGround(4096);
+    const int fast = this->connectGround(0);
+    ASSERT_TRUE(this->waitForClients(2));
+
+    std::vector<std::vector<U8> > frames(frameCount);
+    for (U32 seq = 0; seq < frameCount; seq++) {
+      frames[seq] = testPayload(frameSize, static_cast<U8>(seq));
+      frames[seq][0] = static_cast<U8>(seq >> 24);
+      frames[seq][1] = static_cast<U8>(seq >> 16);
+      frames[seq][2] = static_cast<U8>(seq >> 8);
+      frames[seq][3] = static_cast<U8>(seq);
+      Fw::Buffer buffer(frames[seq].data(), frameSize);
+      ASSERT_EQ(this->invoke_to_send(0, buffer), Drv::SendStatus::SEND_OK);
+      ASSERT_EQ(this->readGround(fast, frameSize), frames[seq]);
+    }
+
+    // Only the frames still queued for the slow client are held
+    const U32 depth = EpollTcpServer::CLIENT_QUEUE_DEPTH;
+    ASSERT_TRUE(this->waitForDeallocated(frameCount - depth));
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_FRAMES_DROPPED_SIZE(1);
+    EXPECT_GT(this->tlmHistory_FRAMES_DROPPED->at(0).arg, 0U);
+
+    // What the slow client does get is a run of whole frames in order
+    const std::vector<U8> slowBytes = this->readGround(slow, static_cast<size_t>(frameCount) * frameSize);
+    ASSERT_EQ(slowBytes.size() % frameSize, 0U);
+    ASSERT_LT(slowBytes.size(), static_cast<size_t>(frameCount) * frameSize);
+    I64 previous = -1;
+    for (size_t position = 0; position < slowBytes.size(); position += frameSize) {
+      const U32 seq = readU32(&slowBytes[position]);
+      ASSERT_LT(seq, frameCount);
+      EXPECT_GT(static_cast<I64>(seq), previous);
+      EXPECT_EQ(::memcmp(&slowBytes[position], frames[seq].data(), frameSize), 0);
+      previous = seq;
+    }
+    EXPECT_TRUE(this->waitForDeallocated(frameCount));
+  }
+
+  void EpollTcpServerTester ::
+    testUplinkMerge()
+  {
+    const int first = this->connectGround(0);
+    const int second = this->connectGround(0);
+    ASSERT_TRUE(this->waitForClients(2));
+
+    const std::vector<U8> frameA = fprimeFrame(testPayload(300, 0x50));
+    const std::vector<U8> frameB = fprimeFrame(testPayload(50, 0x60));
+    const std::vector<U8> garbage = {0x01, 0x02, 0x03};
+
+    // Half of A, with junk ahead of it, then all of B from the other client
+    std::vector<U8> head(garbage);
+    head.insert(head.end(), frameA.begin(), frameA.begin() + 100);
+    writeGround(first, head);
+    writeGround(second, frameB);
+    ASSERT_TRUE(this->waitForReceived(1));
+
+    writeGround(first, std::vector<U8>(frameA.begin() + 100, frameA.end()));
+    ASSERT_TRUE(this->waitForReceived(2));
+
+    std::vector<U8> twice(frameB);
+    twice.insert(twice.end(), frameB.begin(), frameB.end());
+    writeGround(second, twice);
+    ASSERT_TRUE(this->waitForReceived(3));
+
+    this->m_lock.lock();
+    ASSERT_EQ(this->m_received.size(), 3U);
+    EXPECT_EQ(this->m_received[0], frameB);
+    EXPECT_EQ(this->m_received[1], frameA);
+    EXPECT_EQ(this->m_received[2], twice);
+    this->m_lock.unLock();
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_UPLINK_FRAMES_SIZE(1);
+    ASSERT_TLM_UPLINK_FRAMES(0, 4);
+    ASSERT_TLM_UPLINK_BYTES_DISCARDED_SIZE(1);
+    ASSERT_TLM_UPLINK_BYTES_DISCARDED(0, garbage.size());
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer EpollTcpServerTester ::
+    from_allocate_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    return Fw::Buffer(new U8[size], size);
+  }
+
+  void EpollTcpServerTester ::
+    from_deallocate_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_lock.lock();
+    ++this->m_deallocated;
+    this->m_lock.unLock();
+  }
+
+  void EpollTcpServerTester ::
+    from_ready_handler(NATIVE_INT_TYPE portNum)
+  {
+    this->m_lock.lock();
+    ++this->m_ready;
+    this->m_lock.unLock();
+  }
+
+  void EpollTcpServerTester ::
+    from_recv_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    EXPECT_EQ(recvStatus, Drv::RecvStatus::RECV_OK);
+    this->m_lock.lock();
+    this->m_received.push_back(std::vector<U8>(recvBuffer.getData(), recvBuffer.getData() + recvBuffer.getSize()));
+    this->m_lock.unLock();
+    delete[] recvBuffer.getData();
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void EpollTcpServerTester ::
+    closeServer()
+  {
+    this->component.quitReadThread();
+    (void) this->component.join();
+    for (const int fd : this->m_ground) {
+      (void) ::close(fd);
+    }
+    this->m_ground.clear();
+  }
+
+  int EpollTcpServerTester ::
+    connectGround(int receiveBufferSize)
+  {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_GE(fd, 0);
+    if (receiveBufferSize > 0) {
+      (void) ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+    }
+    struct sockaddr_in address;
+    ::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(this->component.getListenPort());
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+    this->m_ground.push_back(fd);
+    return fd;
+  }
+
+  /*
+    CLIENTS is reported on change only, so the last value seen is kept for
+    polls that report nothing.
+  */
+  bool EpollTcpServerTester ::
+    waitForClients(U32 count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->clearTlm();
+      this->invoke_to_schedIn(0, 0);
+      if (this->tlmHistory_CLIENTS->size() > 0) {
+        this->m_reportedClients = this->tlmHistory_CLIENTS->at(0).arg;
+      }
+      if (this->m_reportedClients == count) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+  std::vector<U8> EpollTcpServerTester ::
+    readGround(int fd, size_t count)
+  {
+    std::vector<U8> bytes;
+    U8 chunk[65536];
+    while (bytes.size() < count) {
+      struct pollfd pfd;
+      pfd.fd = fd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (::poll(&pfd, 1, 1000) <= 0) {
+        break;
+      }
+      const ssize_t received = ::recv(fd, chunk, FW_MIN(sizeof(chunk), count - bytes.size()), 0);
+      if (received <= 0) {
+        break;
+      }
+      bytes.insert(bytes.end(), chunk, chunk + received);
+    }
+    return bytes;
+  }
+
+  bool EpollTcpServerTester ::
+    waitForDeallocated(U32 count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool done = (this->m_deallocated >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+  bool EpollTcpServerTester ::
+    waitForReceived(U32 count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool done = (this->m_received.size() >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+}
@@ -0,0 +1,159 @@
+// ======================================================================
+// \title  EpollTcpServerTester.hpp
+// \author cindy
+// \brief  hpp file for EpollTcpServer component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_EpollTcpServerTester_HPP
+#define MathModule_EpollTcpServerTester_HPP
+
+#include "EpollTcpServerGTestBase.hpp"
+#include "Components/EpollTcpServer/EpollTcpServer.hpp"
+#include <Os/Mutex.hpp>
+
+#include <vector>
+
+namespace MathModule {
+
+  class EpollTcpServerTester :
+    public EpollTcpServerGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object EpollTcpServerTester
+      EpollTcpServerTester();
+
+      //! Destroy object EpollTcpServerTester
+      ~EpollTcpServerTester();
+
+      //! Listen on an ephemeral loopback port and start the server task
+      //! \return false if the listening socket could not be opened
+      bool openServer();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Every client receives every frame, and each buffer is returned once
+      void testFanOut();
+
+      //! A client that stops reading skips whole frames; the others get all of them
+      void testSlowClient();
+
+      //! Uplink frames from several clients are passed up whole, never interleaved
+      void testUplinkMerge();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for allocate
+      Fw::Buffer from_allocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for deallocate
+      void from_deallocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for ready
+      void from_ready_handler(
+          NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for recv
+      void from_recv_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Stop the server and close the ground sockets
+      void closeServer();
+
+      //! Connect a ground socket to the server
+      int connectGround(int receiveBufferSize);
+
+      //! Wait until the server reports the given number of clients
+      bool waitForClients(U32 count);
+
+      //! Read from a ground socket until the given number of bytes arrived or a timeout
+      std::vector<U8> readGround(int fd, size_t count);
+
+      //! Wait until the given number of buffers were returned through deallocate
+      bool waitForDeallocated(U32 count);
+
+      //! Wait until the server has passed up the given number of buffers
+      bool waitForReceived(U32 count);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      EpollTcpServer component;
+
+      //! Ground sockets
+      std::vector<int> m_ground;
+
+      //! Guards the state touched by the server task
+      Os::Mutex m_lock;
+
+      //! Uplink buffers passed up by the server
+      std::vector<std::vector<U8> > m_received;
+
+      //! Buffers returned through the deallocate port
+      U32 m_deallocated;
+
+      //! Calls to ready
+      U32 m_ready;
+
+      //! Last CLIENTS value reported
+      U32 m_reportedClients;
+
+  };
+
+}
+
+#endif
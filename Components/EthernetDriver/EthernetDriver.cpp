@@ -0,0 +1,438 @@
+// ======================================================================
+// \title  EthernetDriver.cpp
+// \author cindy
+// \brief  cpp file for EthernetDriver component implementation class
+// ======================================================================
+
+#include "Components/EthernetDriver/EthernetDriver.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    //! Name carried by heartbeats, matching the ground adapters' user-name field
+    const char HEARTBEAT_NAME[] = "FPrimeDeployment";
+
+    const U8 BROADCAST[EthernetDriver::MAC_SIZE] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+    /*
+      Kernel-side filter keeping everything but the two link EtherTypes out of
+      the socket's receive queue, so a busy interface costs no wakeups:
+
+        ldh [12]
+        jeq #ETHERTYPE_FPRIME, accept
+        jeq #ETHERTYPE_HEARTBEAT, accept, drop
+    */
+    struct sock_filter etherTypeFilter[] = {
+      BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, EthernetDriver::ETHERTYPE_FPRIME, 1, 0),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, EthernetDriver::ETHERTYPE_HEARTBEAT, 0, 1),
+      BPF_STMT(BPF_RET | BPF_K, 0xFFFF),
+      BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+
+    void putU16(U8* out, U16 value)
+    {
+      out[0] = static_cast<U8>(value >> 8);
+      out[1] = static_cast<U8>(value);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  EthernetDriver ::
+    EthernetDriver(const char* const compName) :
+      EthernetDriverComponentBase(compName),
+      m_fd(-1),
+      m_readTaskStarted(false),
+      m_quit(false),
+      m_framesSent(0),
+      m_txSyscalls(0),
+      m_framesReceived(0),
+      m_framesRead(0),
+      m_rxSyscalls(0),
+      m_heartbeatsReceived(0),
+      m_reportedFramesSent(0),
+      m_reportedTxSyscalls(0),
+      m_reportedFramesRead(0),
+      m_reportedRxSyscalls(0)
+  {
+    ::memset(this->m_mac, 0, sizeof(this->m_mac));
+  }
+
+  EthernetDriver ::
+    ~EthernetDriver()
+  {
+    if (this->m_fd >= 0) {
+      (void) ::close(this->m_fd);
+    }
+  }
+
+  /*
+    The filter is attached before the socket is bound to a protocol, so no
+    unfiltered frame can be queued in between. Like the ground adapters, the
+    driver uses a random locally administered address (AE:20:xx:xx:xx:xx)
+    rather than the interface's own, and the ground sends to broadcast.
+  */
+  bool EthernetDriver ::
+    open(const char* interfaceName)
+  {
+    FW_ASSERT(interfaceName != nullptr);
+    FW_ASSERT(this->m_fd < 0);
+    Fw::LogStringArg deviceArg(interfaceName);
+
+    const unsigned int ifIndex = ::if_nametoindex(interfaceName);
+    if (ifIndex == 0) {
+      this->log_WARNING_HI_INTERFACE_OPEN_ERROR(deviceArg, errno);
+      return false;
+    }
+    const int fd = ::socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+      this->log_WARNING_HI_INTERFACE_OPEN_ERROR(deviceArg, errno);
+      return false;
+    }
+
+    struct sock_fprog program;
+    program.len = static_cast<unsigned short>(FW_NUM_ARRAY_ELEMENTS(etherTypeFilter));
+    program.filter = etherTypeFilter;
+    struct sockaddr_ll address;
+    ::memset(&address, 0, sizeof(address));
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons(ETH_P_ALL);
+    address.sll_ifindex = static_cast<int>(ifIndex);
+    if ((::setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) != 0) ||
+        (::bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0)) {
+      const I32 error = errno;
+      (void) ::close(fd);
+      this->log_WARNING_HI_INTERFACE_OPEN_ERROR(deviceArg, error);
+      return false;
+    }
+#ifdef PACKET_IGNORE_OUTGOING
+    // Our own frames are otherwise looped back to this socket
+    const int one = 1;
+    (void) ::setsockopt(fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one));
+#endif
+
+    this->m_mac[0] = 0xAE;
+    this->m_mac[1] = 0x20;
+    const int random = ::open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if ((random < 0) || (::read(random, &this->m_mac[2], MAC_SIZE - 2) != static_cast<ssize_t>(MAC_SIZE - 2))) {
+      struct timespec now;
+      (void) clock_gettime(CLOCK_REALTIME, &now);
+      const U32 seed = static_cast<U32>(now.tv_nsec) ^ static_cast<U32>(::getpid());
+      ::memcpy(&this->m_mac[2], &seed, MAC_SIZE - 2);
+    }
+    if (random >= 0) {
+      (void) ::close(random);
+    }
+
+    this->m_fd = fd;
+    this->log_ACTIVITY_HI_INTERFACE_OPENED(deviceArg);
+    return true;
+  }
+
+  void EthernetDriver ::
+    startReadThread(NATIVE_UINT_TYPE priority, NATIVE_UINT_TYPE stackSize)
+  {
+    FW_ASSERT(this->m_fd >= 0);
+    FW_ASSERT(!this->m_readTaskStarted);
+    Os::TaskString name("EthRead");
+    const Os::Task::TaskStatus status =
+      this->m_readTask.start(name, EthernetDriver::readTask, this, priority, stackSize);
+    FW_ASSERT(status == Os::Task::TASK_OK, status);
+    this->m_readTaskStarted = true;
+  }
+
+  void EthernetDriver ::
+    quitReadThread()
+  {
+    this->m_lock.lock();
+    this->m_quit = true;
+    this->m_lock.unLock();
+  }
+
+  Os::Task::TaskStatus EthernetDriver ::
+    join()
+  {
+    Os::Task::TaskStatus status = Os::Task::TASK_OK;
+    if (this->m_readTaskStarted) {
+      status = this->m_readTask.join(nullptr);
+      this->m_readTaskStarted = false;
+    }
+    if (this->m_fd >= 0) {
+      (void) ::close(this->m_fd);
+      this->m_fd = -1;
+    }
+    return status;
+  }
+
+  const U8* EthernetDriver ::
+    getMacAddress() const
+  {
+    return this->m_mac;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  Drv::SendStatus EthernetDriver ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    const I32 error = (this->m_fd < 0) ? EBADF
+                                       : this->sendFrames(ETHERTYPE_FPRIME, sendBuffer.getData(), sendBuffer.getSize());
+    this->deallocate_out(0, sendBuffer);
+    if (error != 0) {
+      this->log_WARNING_HI_SEND_ERROR(error);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  /*
+    The ground parses one compact telemetry packet per Ethernet frame, so a
+    packet is never split.
+  */
+  Drv::SendStatus EthernetDriver ::
+    tlmSend_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    I32 error = (this->m_fd < 0) ? EBADF : 0;
+    if ((error == 0) && (sendBuffer.getSize() > MTU)) {
+      error = EMSGSIZE;
+    }
+    if (error == 0) {
+      error = this->sendFrames(ETHERTYPE_TELEMETRY, sendBuffer.getData(), sendBuffer.getSize());
+    }
+    this->deallocate_out(0, sendBuffer);
+    if (error != 0) {
+      this->log_WARNING_HI_SEND_ERROR(error);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  void EthernetDriver ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    if (this->m_fd >= 0) {
+      U8 heartbeat[sizeof(U16) + sizeof(HEARTBEAT_NAME) - 1];
+      putU16(heartbeat, static_cast<U16>(sizeof(HEARTBEAT_NAME) - 1));
+      ::memcpy(&heartbeat[sizeof(U16)], HEARTBEAT_NAME, sizeof(HEARTBEAT_NAME) - 1);
+      (void) this->sendFrames(ETHERTYPE_HEARTBEAT, heartbeat, sizeof(heartbeat));
+    }
+
+    this->m_lock.lock();
+    const U32 framesReceived = this->m_framesReceived;
+    const U32 framesRead = this->m_framesRead;
+    const U32 rxSyscalls = this->m_rxSyscalls;
+    const U32 heartbeatsReceived = this->m_heartbeatsReceived;
+    this->m_lock.unLock();
+
+    if (this->m_txSyscalls != this->m_reportedTxSyscalls) {
+      this->tlmWrite_TX_FRAMES_PER_SYSCALL(
+        static_cast<F32>(this->m_framesSent - this->m_reportedFramesSent) /
+        static_cast<F32>(this->m_txSyscalls - this->m_reportedTxSyscalls));
+    }
+    if (rxSyscalls != this->m_reportedRxSyscalls) {
+      this->tlmWrite_RX_FRAMES_PER_SYSCALL(
+        static_cast<F32>(framesRead - this->m_reportedFramesRead) /
+        static_cast<F32>(rxSyscalls - this->m_reportedRxSyscalls));
+    }
+    this->m_reportedFramesSent = this->m_framesSent;
+    this->m_reportedTxSyscalls = this->m_txSyscalls;
+    this->m_reportedFramesRead = framesRead;
+    this->m_reportedRxSyscalls = rxSyscalls;
+
+    this->tlmWrite_FRAMES_SENT(this->m_framesSent);
+    this->tlmWrite_FRAMES_RECEIVED(framesReceived);
+    this->tlmWrite_HEARTBEATS_RECEIVED(heartbeatsReceived);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    Each frame is a two-entry iovec, the header and a slice of the caller's
+    buffer, so the payload is never copied in user space and a frame longer
+    than the MTU goes out in one sendmmsg call. The deframer reassembles F´
+    frames split this way from the byte stream. Callers hold the component
+    mutex (guarded ports), which serializes use of the header slots.
+  */
+  I32 EthernetDriver ::
+    sendFrames(U16 etherType, const U8* payload, U32 size)
+  {
+    while (size > 0) {
+      struct iovec iov[TX_BATCH][2];
+      struct mmsghdr messages[TX_BATCH];
+      U32 count = 0;
+      while ((count < TX_BATCH) && (size > 0)) {
+        const U32 chunk = FW_MIN(size, MTU);
+        U8* header = this->m_txHeaders[count];
+        ::memcpy(header, BROADCAST, MAC_SIZE);
+        ::memcpy(&header[MAC_SIZE], this->m_mac, MAC_SIZE);
+        putU16(&header[2 * MAC_SIZE], etherType);
+        iov[count][0].iov_base = header;
+        iov[count][0].iov_len = HEADER_SIZE;
+        iov[count][1].iov_base = const_cast<U8*>(payload);
+        iov[count][1].iov_len = chunk;
+        ::memset(&messages[count], 0, sizeof(messages[count]));
+        messages[count].msg_hdr.msg_iov = iov[count];
+        messages[count].msg_hdr.msg_iovlen = 2;
+        payload += chunk;
+        size -= chunk;
+        ++count;
+      }
+
+      U32 sent = 0;
+      while (sent < count) {
+        const int result = ::sendmmsg(this->m_fd, &messages[sent], count - sent, 0);
+        if (result < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          return errno;
+        }
+        ++this->m_txSyscalls;
+        sent += static_cast<U32>(result);
+        this->m_framesSent += static_cast<U32>(result);
+      }
+    }
+    return 0;
+  }
+
+  void EthernetDriver ::
+    receiveBatch()
+  {
+    struct iovec iov[RX_BATCH];
+    struct mmsghdr messages[RX_BATCH];
+    struct sockaddr_ll sources[RX_BATCH];
+    ::memset(messages, 0, sizeof(messages));
+    for (U32 i = 0; i < RX_BATCH; i++) {
+      iov[i].iov_base = this->m_rxFrames[i];
+      iov[i].iov_len = MAX_FRAME_SIZE;
+      messages[i].msg_hdr.msg_iov = &iov[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+      messages[i].msg_hdr.msg_name = &sources[i];
+      messages[i].msg_hdr.msg_namelen = sizeof(sources[i]);
+    }
+
+    const int received = ::recvmmsg(this->m_fd, messages, RX_BATCH, MSG_DONTWAIT, nullptr);
+    if (received <= 0) {
+      return;
+    }
+    this->m_lock.lock();
+    ++this->m_rxSyscalls;
+    this->m_framesRead += static_cast<U32>(received);
+    this->m_lock.unLock();
+
+    for (int i = 0; i < received; i++) {
+      // Kernels without PACKET_IGNORE_OUTGOING still loop our own frames back
+      if (sources[i].sll_pkttype == PACKET_OUTGOING) {
+        continue;
+      }
+      if ((messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+        continue;
+      }
+      this->handleFrame(this->m_rxFrames[i], messages[i].msg_len);
+    }
+  }
+
+  /*
+    Short frames may arrive with the NIC's padding up to the 60-byte minimum.
+    The padding is passed on with the payload; the deframer skips bytes that do
+    not start a frame.
+  */
+  void EthernetDriver ::
+    handleFrame(const U8* frame, U32 size)
+  {
+    if (size < HEADER_SIZE) {
+      return;
+    }
+    const bool forUs = (::memcmp(frame, BROADCAST, MAC_SIZE) == 0) ||
+                       (::memcmp(frame, this->m_mac, MAC_SIZE) == 0);
+    const bool fromUs = (::memcmp(&frame[MAC_SIZE], this->m_mac, MAC_SIZE) == 0);
+    if (!forUs || fromUs) {
+      return;
+    }
+
+    const U16 etherType = static_cast<U16>((frame[2 * MAC_SIZE] << 8) | frame[2 * MAC_SIZE + 1]);
+    const U32 payloadSize = size - HEADER_SIZE;
+    if (etherType == ETHERTYPE_HEARTBEAT) {
+      this->m_lock.lock();
+      ++this->m_heartbeatsReceived;
+      this->m_lock.unLock();
+      return;
+    }
+    if ((etherType != ETHERTYPE_FPRIME) || (payloadSize == 0)) {
+      return;
+    }
+
+    Fw::Buffer buffer = this->allocate_out(0, payloadSize);
+    if ((buffer.getData() == nullptr) || (buffer.getSize() < payloadSize)) {
+      if (buffer.getData() != nullptr) {
+        this->deallocate_out(0, buffer);
+      }
+      return;
+    }
+    ::memcpy(buffer.getData(), &frame[HEADER_SIZE], payloadSize);
+    buffer.setSize(payloadSize);
+    this->m_lock.lock();
+    ++this->m_framesReceived;
+    this->m_lock.unLock();
+    this->recv_out(0, buffer, Drv::RecvStatus::RECV_OK);
+  }
+
+  void EthernetDriver ::
+    readTask(void* arg)
+  {
+    EthernetDriver* driver = static_cast<EthernetDriver*>(arg);
+    FW_ASSERT(driver != nullptr);
+    driver->ready_out(0);
+
+    while (true) {
+      driver->m_lock.lock();
+      const bool quit = driver->m_quit;
+      driver->m_lock.unLock();
+      if (quit) {
+        break;
+      }
+
+      struct pollfd pfd;
+      pfd.fd = driver->m_fd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (::poll(&pfd, 1, static_cast<int>(READ_POLL_MS)) > 0) {
+        driver->receiveBatch();
+      }
+    }
+  }
+
+}
@@ -0,0 +1,174 @@
+// ======================================================================
+// \title  EthernetDriver.hpp
+// \author cindy
+// \brief  hpp file for EthernetDriver component implementation class
+// ======================================================================
+
+#ifndef MathModule_EthernetDriver_HPP
+#define MathModule_EthernetDriver_HPP
+
+#include "Components/EthernetDriver/EthernetDriverComponentAc.hpp"
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
+
+namespace MathModule {
+
+  class EthernetDriver :
+    public EthernetDriverComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Ethernet header layout: destination MAC, source MAC, EtherType
+      static const U32 MAC_SIZE = 6;
+      static const U32 HEADER_SIZE = 2 * MAC_SIZE + sizeof(U16);
+
+      //! Largest payload in one Ethernet frame. Longer sends are split across frames.
+      static const U32 MTU = 1500;
+
+      //! Largest frame handed over by the kernel; the check sequence is already stripped
+      static const U32 MAX_FRAME_SIZE = HEADER_SIZE + MTU;
+
+      //! EtherTypes shared with scripts/adapter_common.py
+      static const U16 ETHERTYPE_FPRIME = 0x999C;
+      static const U16 ETHERTYPE_HEARTBEAT = 0x999B;
+      static const U16 ETHERTYPE_TELEMETRY = 0x999D;
+
+      //! Frames moved per recvmmsg/sendmmsg call
+      static const U32 RX_BATCH = 16;
+      static const U32 TX_BATCH = 16;
+
+      //! Poll timeout of the read task, so it notices quitReadThread, milliseconds
+      static const U32 READ_POLL_MS = 100;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct EthernetDriver object
+      EthernetDriver(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy EthernetDriver object
+      ~EthernetDriver();
+
+      //! Open a packet socket on the interface, receiving only the F´ and heartbeat EtherTypes
+      //! \return true if the link is ready
+      bool open(
+          const char* interfaceName //!< Network interface, e.g. eth0
+      );
+
+      //! Start the read task. It reports the driver ready once running.
+      void startReadThread(
+          NATIVE_UINT_TYPE priority, //!< Read task priority
+          NATIVE_UINT_TYPE stackSize //!< Read task stack size
+      );
+
+      //! Ask the read task to exit
+      void quitReadThread();
+
+      //! Wait for the read task to exit and close the socket
+      Os::Task::TaskStatus join();
+
+      //! MAC address used as the source of sent frames
+      const U8* getMacAddress() const;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for tlmSend
+      Drv::SendStatus tlmSend_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The packet to send
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Send a payload as consecutive Ethernet frames of one EtherType
+      //! \return 0 on success, otherwise the errno value
+      I32 sendFrames(U16 etherType, const U8* payload, U32 size);
+
+      //! Receive and dispatch one batch of frames
+      void receiveBatch();
+
+      //! Handle one received frame
+      void handleFrame(const U8* frame, U32 size);
+
+      //! Read task entry point
+      static void readTask(void* arg);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Packet socket, or -1
+      int m_fd;
+
+      //! Source MAC address
+      U8 m_mac[MAC_SIZE];
+
+      //! Ethernet headers of the frames being sent. Guarded by the component mutex.
+      U8 m_txHeaders[TX_BATCH][HEADER_SIZE];
+
+      //! Frames being received. Owned by the read task.
+      U8 m_rxFrames[RX_BATCH][MAX_FRAME_SIZE];
+
+      //! Read task
+      Os::Task m_readTask;
+
+      //! Whether the read task was started
+      bool m_readTaskStarted;
+
+      //! Guards m_quit and the receive counters
+      Os::Mutex m_lock;
+
+      //! Whether quitReadThread was called
+      bool m_quit;
+
+      //! Telemetry counters
+      U32 m_framesSent;
+      U32 m_txSyscalls;
+      U32 m_framesReceived;
+      U32 m_framesRead;
+      U32 m_rxSyscalls;
+      U32 m_heartbeatsReceived;
+
+      //! Counters at the last report, for the per-period ratios
+      U32 m_reportedFramesSent;
+      U32 m_reportedTxSyscalls;
+      U32 m_reportedFramesRead;
+      U32 m_reportedRxSyscalls;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,36 @@
+// ======================================================================
+// \title  EthernetDriverTestMain.cpp
+// \author cindy
+// \brief  cpp file for EthernetDriver component test main function
+// ======================================================================
+
+#include "EthernetDriverTester.hpp"
+
+TEST(Nominal, Receive) {
+  MathModule::EthernetDriverTester tester;
+  if (!tester.openLink()) {
+    GTEST_SKIP() << "packet sockets need CAP_NET_RAW";
+  }
+  tester.testReceive();
+}
+
+TEST(Nominal, Send) {
+  MathModule::EthernetDriverTester tester;
+  if (!tester.openLink()) {
+    GTEST_SKIP() << "packet sockets need CAP_NET_RAW";
+  }
+  tester.testSend();
+}
+
+TEST(Nominal, Heartbeat) {
+  MathModule::EthernetDriverTester tester;
+  if (!tester.openLink()) {
+    GTEST_SKIP() << "packet sockets need CAP_NET_RAW";
+  }
+  tester.testHeartbeat();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,281 @@
+// ======================================================================
+// \title  EthernetDriverTester.cpp
+// \author cindy
+// \brief  cpp file for EthernetDriver component test harness implementation class
+// ======================================================================
+
+#include "EthernetDriverTester.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    const U8 BROADCAST[EthernetDriver::MAC_SIZE] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    const U8 GROUND_MAC[EthernetDriver::MAC_SIZE] = {0xAE, 0x20, 0x01, 0x02, 0x03, 0x04};
+    const U8 OTHER_MAC[EthernetDriver::MAC_SIZE] = {0xAE, 0x20, 0x05, 0x06, 0x07, 0x08};
+
+    std::vector<U8> testPayload(U32 size, U8 seed)
+    {
+      std::vector<U8> payload(size);
+      for (U32 i = 0; i < size; i++) {
+        payload[i] = static_cast<U8>(seed + 3 * i);
+      }
+      return payload;
+    }
+
+    U16 etherTypeOf(const std::vector<U8>& frame)
+    {
+      return static_cast<U16>((frame[12] << 8) | frame[13]);
+    }
+
+  }
+
+  const char* const EthernetDriverTester::TEST_INTERFACE = "lo";
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  EthernetDriverTester ::
+    EthernetDriverTester() :
+      EthernetDriverGTestBase("EthernetDriverTester", EthernetDriverTester::MAX_HISTORY_SIZE),
+      component("EthernetDriver"),
+      m_ground(-1),
+      m_recvNext(0),
+      m_deallocated(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  EthernetDriverTester ::
+    ~EthernetDriverTester()
+  {
+    this->closeLink();
+  }
+
+  bool EthernetDriverTester ::
+    openLink()
+  {
+    if (!this->component.open(TEST_INTERFACE)) {
+      return false;
+    }
+    this->m_ground = ::socket(AF_PACKET, SOCK_RAW, 0);
+    EXPECT_GE(this->m_ground, 0);
+    struct sockaddr_ll address;
+    ::memset(&address, 0, sizeof(address));
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons(ETH_P_ALL);
+    address.sll_ifindex = static_cast<int>(::if_nametoindex(TEST_INTERFACE));
+    EXPECT_EQ(::bind(this->m_ground, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+    this->component.startReadThread(Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+    return true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void EthernetDriverTester ::
+    testReceive()
+  {
+    std::vector<U8> expected[4];
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(expected); i++) {
+      expected[i] = testPayload(100 + i, static_cast<U8>(i));
+    }
+    const std::vector<U8> name = {0x00, 0x04, 'T', 'e', 's', 't'};
+
+    this->writeGroundFrame(BROADCAST, EthernetDriver::ETHERTYPE_FPRIME, expected[0]);
+    this->writeGroundFrame(BROADCAST, EthernetDriver::ETHERTYPE_HEARTBEAT, name);
+    this->writeGroundFrame(OTHER_MAC, EthernetDriver::ETHERTYPE_FPRIME, testPayload(40, 0x40));
+    this->writeGroundFrame(BROADCAST, 0x0800, testPayload(40, 0x50));
+    this->writeGroundFrame(this->component.getMacAddress(), EthernetDriver::ETHERTYPE_FPRIME, expected[1]);
+    this->writeGroundFrame(BROADCAST, EthernetDriver::ETHERTYPE_FPRIME, expected[2]);
+    this->writeGroundFrame(BROADCAST, EthernetDriver::ETHERTYPE_FPRIME, expected[3]);
+
+    ASSERT_TRUE(this->waitForReceived(FW_NUM_ARRAY_ELEMENTS(expected)));
+    this->m_lock.lock();
+    ASSERT_EQ(this->m_received.size(), FW_NUM_ARRAY_ELEMENTS(expected));
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(expected); i++) {
+      EXPECT_EQ(this->m_received[i], expected[i]);
+    }
+    this->m_lock.unLock();
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_FRAMES_RECEIVED_SIZE(1);
+    ASSERT_TLM_FRAMES_RECEIVED(0, FW_NUM_ARRAY_ELEMENTS(expected));
+    ASSERT_TLM_HEARTBEATS_RECEIVED_SIZE(1);
+    ASSERT_TLM_HEARTBEATS_RECEIVED(0, 1);
+  }
+
+  void EthernetDriverTester ::
+    testSend()
+  {
+    std::vector<U8> data = testPayload(2 * EthernetDriver::MTU + 200, 0x60);
+    Fw::Buffer buffer(data.data(), static_cast<U32>(data.size()));
+    EXPECT_EQ(this->invoke_to_send(0, buffer), Drv::SendStatus::SEND_OK);
+    EXPECT_EQ(this->m_deallocated, 1U);
+
+    const std::vector<std::vector<U8> > frames = this->readDriverFrames(3);
+    ASSERT_EQ(frames.size(), 3U);
+    std::vector<U8> reassembled;
+    for (const std::vector<U8>& frame : frames) {
+      EXPECT_EQ(::memcmp(frame.data(), BROADCAST, EthernetDriver::MAC_SIZE), 0);
+      EXPECT_EQ(etherTypeOf(frame), static_cast<U16>(EthernetDriver::ETHERTYPE_FPRIME));
+      reassembled.insert(reassembled.end(), frame.begin() + EthernetDriver::HEADER_SIZE, frame.end());
+    }
+    EXPECT_EQ(frames[0].size(), static_cast<size_t>(EthernetDriver::MAX_FRAME_SIZE));
+    EXPECT_EQ(reassembled, data);
+
+    // All three frames went out in a single sendmmsg call
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_TX_FRAMES_PER_SYSCALL_SIZE(1);
+    ASSERT_TLM_TX_FRAMES_PER_SYSCALL(0, 3);
+  }
+
+  void EthernetDriverTester ::
+    testHeartbeat()
+  {
+    this->invoke_to_schedIn(0, 0);
+    const std::vector<std::vector<U8> > frames = this->readDriverFrames(1);
+    ASSERT_EQ(frames.size(), 1U);
+    const std::vector<U8>& frame = frames[0];
+    EXPECT_EQ(etherTypeOf(frame), static_cast<U16>(EthernetDriver::ETHERTYPE_HEARTBEAT));
+    const U32 nameSize = (static_cast<U32>(frame[14]) << 8) | frame[15];
+    ASSERT_GE(frame.size(), EthernetDriver::HEADER_SIZE + sizeof(U16) + nameSize);
+
+    ASSERT_TLM_FRAMES_SENT_SIZE(1);
+    ASSERT_TLM_FRAMES_SENT(0, 1);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer EthernetDriverTester ::
+    from_allocate_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    this->m_lock.lock();
+    U8* storage = this->m_recvStorage[this->m_recvNext % FW_NUM_ARRAY_ELEMENTS(this->m_recvStorage)];
+    ++this->m_recvNext;
+    this->m_lock.unLock();
+    return Fw::Buffer(storage, FW_MIN(size, RECV_BUFFER_SIZE));
+  }
+
+  void EthernetDriverTester ::
+    from_deallocate_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_lock.lock();
+    ++this->m_deallocated;
+    this->m_lock.unLock();
+  }
+
+  void EthernetDriverTester ::
+    from_ready_handler(NATIVE_INT_TYPE portNum)
+  {
+
+  }
+
+  void EthernetDriverTester ::
+    from_recv_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    EXPECT_EQ(recvStatus, Drv::RecvStatus::RECV_OK);
+    this->m_lock.lock();
+    this->m_received.push_back(std::vector<U8>(recvBuffer.getData(), recvBuffer.getData() + recvBuffer.getSize()));
+    this->m_lock.unLock();
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void EthernetDriverTester ::
+    closeLink()
+  {
+    this->component.quitReadThread();
+    (void) this->component.join();
+    if (this->m_ground >= 0) {
+      (void) ::close(this->m_ground);
+      this->m_ground = -1;
+    }
+  }
+
+  void EthernetDriverTester ::
+    writeGroundFrame(const U8* dst, U16 etherType, const std::vector<U8>& payload)
+  {
+    std::vector<U8> frame(dst, dst + EthernetDriver::MAC_SIZE);
+    frame.insert(frame.end(), GROUND_MAC, GROUND_MAC + EthernetDriver::MAC_SIZE);
+    frame.push_back(static_cast<U8>(etherType >> 8));
+    frame.push_back(static_cast<U8>(etherType));
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    ASSERT_EQ(::send(this->m_ground, frame.data(), frame.size(), 0), static_cast<ssize_t>(frame.size()));
+  }
+
+  /*
+    The ground socket sees every frame on the interface, including its own
+    and, on loopback, each frame twice. Only incoming frames from the driver
+    are kept.
+  */
+  std::vector<std::vector<U8> > EthernetDriverTester ::
+    readDriverFrames(U32 count)
+  {
+    std::vector<std::vector<U8> > frames;
+    while (frames.size() < count) {
+      struct pollfd pfd;
+      pfd.fd = this->m_ground;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (::poll(&pfd, 1, 2000) <= 0) {
+        break;
+      }
+      U8 frame[EthernetDriver::MAX_FRAME_SIZE];
+      struct sockaddr_ll source;
+      socklen_t sourceSize = sizeof(source);
+      const ssize_t received = ::recvfrom(this->m_ground, frame, sizeof(frame), 0,
+                                          reinterpret_cast<struct sockaddr*>(&source), &sourceSize);
+      if ((received < static_cast<ssize_t>(EthernetDriver::HEADER_SIZE)) || (source.sll_pkttype == PACKET_OUTGOING)) {
+        continue;
+      }
+      if (::memcmp(&frame[EthernetDriver::MAC_SIZE], this->component.getMacAddress(), EthernetDriver::MAC_SIZE) != 0) {
+        continue;
+      }
+      frames.push_back(std::vector<U8>(frame, frame + received));
+    }
+    return frames;
+  }
+
+  bool EthernetDriverTester ::
+    waitForReceived(U32 count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool done = (this->m_received.size() >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+}
@@ -0,0 +1,157 @@
+// ======================================================================
+// \title  EthernetDriverTester.hpp
+// \author cindy
+// \brief  hpp file for EthernetDriver component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_EthernetDriverTester_HPP
+#define MathModule_EthernetDriverTester_HPP
+
+#include "EthernetDriverGTestBase.hpp"
+#include "Components/EthernetDriver/EthernetDriver.hpp"
+#include <Os/Mutex.hpp>
+
+#include <vector>
+
+namespace MathModule {
+
+  class EthernetDriverTester :
+    public EthernetDriverGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      // Size of the test receive buffers
+      static const U32 RECV_BUFFER_SIZE = 2048;
+
+      // Interface the tests run on; a veth pair works the same way
+      static const char* const TEST_INTERFACE;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object EthernetDriverTester
+      EthernetDriverTester();
+
+      //! Destroy object EthernetDriverTester
+      ~EthernetDriverTester();
+
+      //! Open the driver and a ground socket on the test interface
+      //! \return false if packet sockets are not permitted, e.g. without CAP_NET_RAW
+      bool openLink();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! F´ frames for us are forwarded without their header; other traffic is not
+      void testReceive();
+
+      //! Sends longer than the MTU go out as consecutive frames
+      void testSend();
+
+      //! The heartbeat carries the heartbeat EtherType and a length-prefixed name
+      void testHeartbeat();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for allocate
+      Fw::Buffer from_allocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for deallocate
+      void from_deallocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for ready
+      void from_ready_handler(
+          NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for recv
+      void from_recv_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Stop the driver and close the ground socket
+      void closeLink();
+
+      //! Send an Ethernet frame from the ground socket
+      void writeGroundFrame(const U8* dst, U16 etherType, const std::vector<U8>& payload);
+
+      //! Read frames sent by the driver until the count is reached or a timeout
+      std::vector<std::vector<U8> > readDriverFrames(U32 count);
+
+      //! Wait until the driver has forwarded the given number of buffers
+      bool waitForReceived(U32 count);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      EthernetDriver component;
+
+      //! Ground packet socket
+      int m_ground;
+
+      //! Guards the buffers collected from the driver's read task
+      Os::Mutex m_lock;
+
+      //! Payloads forwarded by the driver
+      std::vector<std::vector<U8> > m_received;
+
+      //! Buffers handed out to the driver
+      U8 m_recvStorage[4][RECV_BUFFER_SIZE];
+      U32 m_recvNext;
+
+      //! Buffers returned through the deallocate port
+      U32 m_deallocated;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,213 @@
+// ======================================================================
+// \title  EventJournal.cpp
+// \author cindy
+// \brief  cpp file for EventJournal component implementation class
+// ======================================================================
+
+#include "Components/EventJournal/EventJournal.hpp"
+#include "Components/EventJournal/StagingFile.hpp"
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/Serializable.hpp>
+
+#include <cerrno>
+#include <cstdio>
+
+namespace MathModule {
+
+  const U32 EventJournal::RANGE_FILE_MAGIC;
+  const U32 EventJournal::RANGE_HEADER_SIZE;
+  const U32 EventJournal::RECORD_HEADER_SIZE;
+  const U32 EventJournal::STAGING_SIZE;
+  const U32 EventJournal::FILE_NAME_SIZE;
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  EventJournal ::
+    EventJournal(const char* const compName) :
+      EventJournalComponentBase(compName),
+      m_dropped(0)
+  {
+
+  }
+
+  EventJournal ::
+    ~EventJournal()
+  {
+
+  }
+
+  void EventJournal ::
+    configure(const char* file, U32 slotCount, const char* rangePrefix)
+  {
+    FW_ASSERT(file != nullptr);
+    FW_ASSERT(rangePrefix != nullptr);
+    this->m_rangePrefix = rangePrefix;
+    const I32 error = this->m_ring.open(file, slotCount);
+    if (error != 0) {
+      this->log_WARNING_HI_JOURNAL_OPEN_ERROR(error);
+      return;
+    }
+    const U64 head = this->m_ring.head();
+    const U32 kept = (head < slotCount) ? static_cast<U32>(head) : slotCount;
+    this->log_ACTIVITY_HI_JOURNAL_OPENED(kept, slotCount);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    Runs on the thread of whichever component logged the event, so it only
+    claims a slot and copies into it: no lock, no allocation and no system
+    call. The event logger still gets every event, journaled or not.
+  */
+  void EventJournal ::
+    LogRecv_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwEventIdType id,
+        Fw::Time& timeTag,
+        const Fw::LogSeverity& severity,
+        Fw::LogBuffer& args
+    )
+  {
+    JournalRing::EntryHeader header;
+    header.id = id;
+    header.seconds = timeTag.getSeconds();
+    header.useconds = timeTag.getUSeconds();
+    header.timeBase = static_cast<U16>(timeTag.getTimeBase());
+    header.timeContext = timeTag.getContext();
+    header.severity = static_cast<U8>(severity.e);
+    if (!this->m_ring.append(header, args.getBuffAddr(), static_cast<U32>(args.getBuffLength()))) {
+      this->m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (this->isConnected_logOut_OutputPort(0)) {
+      this->logOut_out(0, id, timeTag, severity, args);
+    }
+  }
+
+  void EventJournal ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->tlmWrite_ENTRIES_WRITTEN(this->m_ring.head());
+    this->tlmWrite_ENTRIES_DROPPED(this->m_dropped.load(std::memory_order_relaxed));
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  /*
+    The range file is named after the range, so repeating a request
+    replaces its file instead of filling the disk. File downlink only
+    queues the file here; its own events report the transfer.
+  */
+  void EventJournal ::
+    DOWNLINK_RANGE_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        U32 start,
+        U32 end
+    )
+  {
+    if (end < start) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+    if (this->m_ring.slotCount() == 0) {
+      this->log_WARNING_LO_JOURNAL_UNAVAILABLE();
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+
+    char path[FILE_NAME_SIZE];
+    const int length = ::snprintf(path, sizeof(path), "%s_%u_%u.bin", this->m_rangePrefix.toChar(), start, end);
+    U32 entries = 0;
+    I32 error = ENAMETOOLONG;
+    if ((length > 0) && (static_cast<U32>(length) < sizeof(path))) {
+      error = this->extractRange(path, start, end, entries);
+    }
+    if (error != 0) {
+      this->log_WARNING_HI_RANGE_WRITE_ERROR(error);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+
+    const Fw::String file(path);
+    const Svc::SendFileResponse response = this->sendFile_out(0, file, file, 0, 0);
+    if (response.getstatus() != Svc::SendFileStatus::STATUS_OK) {
+      this->log_WARNING_HI_RANGE_DOWNLINK_REJECTED(response.getstatus());
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    Fw::LogStringArg fileArg(path);
+    this->log_ACTIVITY_HI_RANGE_EXTRACTED(entries, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    Walks the kept entries oldest first. Appends go on meanwhile: entries
+    past the head read at the start are left out, and any overwritten or
+    half-written before they are copied are skipped, never torn. Records
+    are big endian, with the time in Fw::Time's serialized order.
+  */
+  I32 EventJournal ::
+    extractRange(const char* path, U32 start, U32 end, U32& entries)
+  {
+    StagingFile file(this->m_staging, STAGING_SIZE);
+    I32 error = file.open(path);
+    if (error != 0) {
+      return error;
+    }
+    Fw::SerializeBufferBase& staging = file.buffer();
+    Fw::SerializeStatus status = staging.serialize(RANGE_FILE_MAGIC);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = staging.serialize(start);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = staging.serialize(end);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+
+    const U64 head = this->m_ring.head();
+    const U32 slotCount = this->m_ring.slotCount();
+    const U64 first = (head > slotCount) ? head - slotCount : 0;
+    JournalRing::Entry& entry = this->m_entry;
+    for (U64 sequence = first; sequence < head; sequence++) {
+      if (!this->m_ring.read(sequence, entry) || (entry.header.seconds < start) || (entry.header.seconds > end)) {
+        continue;
+      }
+      error = file.reserve(RECORD_HEADER_SIZE + entry.argSize);
+      if (error != 0) {
+        break;
+      }
+      status = staging.serialize(entry.sequence);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.header.id);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.header.timeBase);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.header.timeContext);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.header.seconds);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.header.useconds);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.header.severity);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.argSize);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      status = staging.serialize(entry.args, entry.argSize, true);
+      FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+      ++entries;
+    }
+    return file.close();
+  }
+
+}
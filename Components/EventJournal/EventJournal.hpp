@@ -0,0 +1,143 @@
+// ======================================================================
+// \title  EventJournal.hpp
+// \author cindy
+// \brief  hpp file for EventJournal component implementation class
+// ======================================================================
+
+#ifndef MathModule_EventJournal_HPP
+#define MathModule_EventJournal_HPP
+
+#include "Components/EventJournal/EventJournalComponentAc.hpp"
+#include "Components/EventJournal/JournalRing.hpp"
+#include <Fw/Types/String.hpp>
+
+#include <atomic>
+
+namespace MathModule {
+
+  class EventJournal :
+    public EventJournalComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! First word of an extracted range file
+      static const U32 RANGE_FILE_MAGIC = 0x454A5831;
+
+      //! Range file header: magic, start and end seconds
+      static const U32 RANGE_HEADER_SIZE = 3 * sizeof(U32);
+
+      //! Range file record before the arguments: sequence, id, time, severity, argument size
+      static const U32 RECORD_HEADER_SIZE = sizeof(U64) + sizeof(FwEventIdType) + sizeof(U16) + sizeof(U8) +
+                                            2 * sizeof(U32) + sizeof(U8) + sizeof(U16);
+
+      //! Bytes collected before each write of a range file
+      static const U32 STAGING_SIZE = 4096;
+
+      //! Longest range file name, the size of the event argument reporting it
+      static const U32 FILE_NAME_SIZE = 80;
+
+      static_assert(RECORD_HEADER_SIZE + JournalRing::ARG_CAPACITY <= STAGING_SIZE,
+                    "a record must fit the staging buffer");
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct EventJournal object
+      EventJournal(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy EventJournal object
+      ~EventJournal();
+
+      //! Map the journal file. Events arriving before this are forwarded but not kept.
+      void configure(
+          const char* file, //!< The ring file path
+          U32 slotCount, //!< Entries kept
+          const char* rangePrefix //!< Path prefix of extracted range files
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for LogRecv
+      void LogRecv_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwEventIdType id, //!< Log ID
+          Fw::Time& timeTag, //!< Time Tag
+          const Fw::LogSeverity& severity, //!< The severity argument
+          Fw::LogBuffer& args //!< Buffer containing serialized log entry
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command DOWNLINK_RANGE
+      void DOWNLINK_RANGE_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq, //!< The command sequence number
+          U32 start, //!< First second of the range
+          U32 end //!< Last second of the range, inclusive
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Write the entries of a range to a file
+      //! \return 0, or the errno value of the failed call
+      I32 extractRange(
+          const char* path, //!< The range file
+          U32 start, //!< First second
+          U32 end, //!< Last second, inclusive
+          U32& entries //!< Set to the number of entries written
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The journal file
+      JournalRing m_ring;
+
+      //! Path prefix of range files
+      Fw::String m_rangePrefix;
+
+      //! Events not journaled, counted from any thread
+      std::atomic<U32> m_dropped;
+
+      //! Entry being copied out of the ring
+      JournalRing::Entry m_entry;
+
+      //! Range file bytes waiting to be written
+      U8 m_staging[STAGING_SIZE];
+
+  };
+
+}
+
+#endif
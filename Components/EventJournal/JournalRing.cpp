@@ -0,0 +1,186 @@
+// ======================================================================
+// \title  JournalRing.cpp
+// \author cindy
+// \brief  Memory-mapped ring file of binary events used by EventJournal
+// ======================================================================
+
+#include "Components/EventJournal/JournalRing.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 JournalRing::MAGIC;
+  const U32 JournalRing::VERSION;
+  const U32 JournalRing::ARG_CAPACITY;
+
+  JournalRing ::
+    JournalRing() :
+      m_map(nullptr),
+      m_mapSize(0),
+      m_slotCount(0)
+  {
+
+  }
+
+  JournalRing ::
+    ~JournalRing()
+  {
+    this->close();
+  }
+
+  /*
+    A file of exactly the expected size whose header matches is reused with
+    its head, so entries from before a restart or crash stay readable. Any
+    other file is truncated to zeros and given a new header, magic last, so
+    a crash while starting over is detected by the next open.
+  */
+  I32 JournalRing ::
+    open(const char* path, U32 slotCount)
+  {
+    FW_ASSERT(path != nullptr);
+    FW_ASSERT(slotCount > 0);
+    this->close();
+
+    const U64 size = sizeof(FileHeader) + static_cast<U64>(slotCount) * sizeof(Slot);
+    const int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+      return errno;
+    }
+    I32 error = 0;
+    struct stat info;
+    bool reuse = false;
+    void* map = MAP_FAILED;
+    if (::fstat(fd, &info) != 0) {
+      error = errno;
+    } else {
+      reuse = (static_cast<U64>(info.st_size) == size);
+      if (!reuse && ((::ftruncate(fd, 0) != 0) || (::ftruncate(fd, static_cast<off_t>(size)) != 0))) {
+        error = errno;
+      }
+    }
+    if (error == 0) {
+      map = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (map == MAP_FAILED) {
+        error = errno;
+      }
+    }
+    (void) ::close(fd);
+    if (error != 0) {
+      return error;
+    }
+
+    FileHeader* header = static_cast<FileHeader*>(map);
+    if (!reuse || (header->magic != MAGIC) || (header->version != VERSION) ||
+        (header->slotSize != sizeof(Slot)) || (header->slotCount != slotCount)) {
+      ::memset(map, 0, static_cast<size_t>(size));
+      header->version = VERSION;
+      header->slotSize = sizeof(Slot);
+      header->slotCount = slotCount;
+      header->head.store(0, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      header->magic = MAGIC;
+    }
+    this->m_mapSize = size;
+    this->m_slotCount = slotCount;
+    this->m_map.store(static_cast<U8*>(map), std::memory_order_release);
+    return 0;
+  }
+
+  void JournalRing ::
+    close()
+  {
+    U8* const map = this->m_map.exchange(nullptr, std::memory_order_acq_rel);
+    if (map != nullptr) {
+      (void) ::munmap(map, static_cast<size_t>(this->m_mapSize));
+    }
+    this->m_mapSize = 0;
+    this->m_slotCount = 0;
+  }
+
+  /*
+    Claiming a sequence number is the only contended step, a single atomic
+    add. The slot's commit word is cleared before and set after the copy,
+    with release ordering, so a reader either sees the whole entry under a
+    matching commit word or discards it. Two writers only meet on a slot if
+    slotCount appends overtake one in progress.
+  */
+  bool JournalRing ::
+    append(const EntryHeader& header, const U8* args, U32 argSize)
+  {
+    U8* const map = this->m_map.load(std::memory_order_acquire);
+    if (map == nullptr) {
+      return false;
+    }
+    FileHeader* const file = reinterpret_cast<FileHeader*>(map);
+    const U64 sequence = file->head.fetch_add(1, std::memory_order_relaxed);
+    Slot& entry = this->slot(sequence);
+
+    entry.commit.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.header = header;
+    entry.argSize = static_cast<U16>((argSize < ARG_CAPACITY) ? argSize : ARG_CAPACITY);
+    if (entry.argSize > 0) {
+      ::memcpy(entry.args, args, entry.argSize);
+    }
+    entry.commit.store(sequence + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool JournalRing ::
+    read(U64 sequence, Entry& entry) const
+  {
+    U8* const map = this->m_map.load(std::memory_order_acquire);
+    if (map == nullptr) {
+      return false;
+    }
+    const U64 head = reinterpret_cast<const FileHeader*>(map)->head.load(std::memory_order_acquire);
+    if ((sequence >= head) || (head - sequence > this->m_slotCount)) {
+      return false;
+    }
+    const Slot& source = this->slot(sequence);
+    if (source.commit.load(std::memory_order_acquire) != sequence + 1) {
+      return false;
+    }
+    entry.sequence = sequence;
+    entry.header = source.header;
+    entry.argSize = source.argSize;
+    if (entry.argSize > ARG_CAPACITY) {
+      return false;
+    }
+    ::memcpy(entry.args, source.args, entry.argSize);
+    // The copy is only valid if no writer took the slot over meanwhile
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return source.commit.load(std::memory_order_relaxed) == sequence + 1;
+  }
+
+  U64 JournalRing ::
+    head() const
+  {
+    const U8* const map = this->m_map.load(std::memory_order_acquire);
+    if (map == nullptr) {
+      return 0;
+    }
+    return reinterpret_cast<const FileHeader*>(map)->head.load(std::memory_order_relaxed);
+  }
+
+  U32 JournalRing ::
+    slotCount() const
+  {
+    return (this->m_map.load(std::memory_order_acquire) != nullptr) ? this->m_slotCount : 0;
+  }
+
+  JournalRing::Slot& JournalRing ::
+    slot(U64 sequence) const
+  {
+    U8* const slots = this->m_map.load(std::memory_order_relaxed) + sizeof(FileHeader);
+    return reinterpret_cast<Slot*>(slots)[sequence % this->m_slotCount];
+  }
+
+}
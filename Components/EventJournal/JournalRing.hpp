@@ -0,0 +1,144 @@
+// ======================================================================
+// \title  JournalRing.hpp
+// \author cindy
+// \brief  Memory-mapped ring file of binary events used by EventJournal
+//
+// The file holds a header and a fixed number of fixed-size slots. Entry n
+// goes to slot n % slotCount, so the newest slotCount entries are kept and
+// the sequence number is the wrap-around index. The file is mapped shared,
+// so entries survive a crash of the process and are found again by the
+// next open with the same layout. Slots are in native byte order; only
+// EventJournal's extracted range files are meant for the ground.
+// ======================================================================
+
+#ifndef MathModule_JournalRing_HPP
+#define MathModule_JournalRing_HPP
+
+#include <FpConfig.hpp>
+
+#include <atomic>
+
+namespace MathModule {
+
+  class JournalRing {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants and types
+      // ----------------------------------------------------------------------
+
+      //! Identifies a journal file
+      static const U32 MAGIC = 0x454A524E;
+
+      //! Layout version. Bump when FileHeader, Slot or EntryHeader changes.
+      static const U32 VERSION = 1;
+
+      //! Argument bytes kept per entry, enough for any event
+      static const U32 ARG_CAPACITY = FW_LOG_BUFFER_MAX_SIZE;
+
+      static_assert(ARG_CAPACITY <= 0xFFFF, "argument sizes are stored as U16");
+      static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "the head and commit words must be lock free to live in a file");
+
+      //! Fixed fields of an event
+      struct EntryHeader {
+        FwEventIdType id; //!< Event id
+        U32 seconds; //!< Time tag seconds
+        U32 useconds; //!< Time tag microseconds
+        U16 timeBase; //!< Time tag base
+        U8 timeContext; //!< Time tag context
+        U8 severity; //!< Fw::LogSeverity value
+      };
+
+      //! An entry as copied out of the ring
+      struct Entry {
+        U64 sequence; //!< Number of entries appended before this one
+        EntryHeader header; //!< Fixed fields
+        U16 argSize; //!< Bytes in args
+        U8 args[ARG_CAPACITY]; //!< Serialized event arguments
+      };
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      JournalRing();
+
+      //! Unmaps the file
+      ~JournalRing();
+
+      //! Map a ring file, creating it or starting it over if its layout differs from slotCount slots
+      //! \return 0, or the errno value of the failed call
+      I32 open(
+          const char* path, //!< The ring file
+          U32 slotCount //!< Entries kept, at least 1
+      );
+
+      //! Unmap the file. No append or read may be running.
+      void close();
+
+      // ----------------------------------------------------------------------
+      // Entries
+      // ----------------------------------------------------------------------
+
+      //! Append an entry. Lock-free, allocation-free and safe from any number of threads.
+      //! \return false if no file is mapped
+      bool append(
+          const EntryHeader& header, //!< Fixed fields
+          const U8* args, //!< Serialized arguments
+          U32 argSize //!< Bytes in args, clipped to ARG_CAPACITY
+      );
+
+      //! Copy out an entry while appends go on
+      //! \return false if the entry was never written, was overwritten or is being written
+      bool read(
+          U64 sequence, //!< The entry
+          Entry& entry //!< Filled with the entry
+      ) const;
+
+      //! Number of entries ever appended to the file, including earlier runs
+      U64 head() const;
+
+      //! Slots in the mapped file, 0 when none is mapped
+      U32 slotCount() const;
+
+    private:
+
+      //! Start of the file. Slots follow it.
+      struct FileHeader {
+        U32 magic; //!< MAGIC, written last when a file is started over
+        U32 version; //!< VERSION
+        U32 slotSize; //!< sizeof(Slot)
+        U32 slotCount; //!< Slots in the file
+        //! Next sequence number, on its own cache line
+        alignas(64) std::atomic<U64> head;
+      };
+
+      //! One entry, guarded like a seqlock by its commit word
+      struct Slot {
+        //! sequence + 1 once the entry is complete, 0 while it is written
+        std::atomic<U64> commit;
+        EntryHeader header;
+        U16 argSize;
+        U8 args[ARG_CAPACITY];
+      };
+
+      //! The slot of an entry
+      Slot& slot(U64 sequence) const;
+
+      //! The mapping, published once open has set it up
+      std::atomic<U8*> m_map;
+
+      //! Bytes mapped
+      U64 m_mapSize;
+
+      //! Slots in the mapping
+      U32 m_slotCount;
+
+  };
+
+}
+
+#endif
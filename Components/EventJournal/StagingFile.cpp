@@ -0,0 +1,97 @@
+// ======================================================================
+// \title  StagingFile.cpp
+// \author cindy
+// \brief  File written through a staging buffer, used by EventJournal and TlmHistory
+// ======================================================================
+
+#include "Components/EventJournal/StagingFile.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  StagingFile ::
+    StagingFile(U8* staging, U32 size) :
+      m_fd(-1),
+      m_error(0),
+      m_staging(staging, size)
+  {
+    FW_ASSERT(staging != nullptr);
+  }
+
+  StagingFile ::
+    ~StagingFile()
+  {
+    if (this->m_fd >= 0) {
+      (void) ::close(this->m_fd);
+    }
+  }
+
+  I32 StagingFile ::
+    open(const char* path)
+  {
+    FW_ASSERT(path != nullptr);
+    FW_ASSERT(this->m_fd < 0);
+    this->m_staging.resetSer();
+    this->m_error = 0;
+    this->m_fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (this->m_fd < 0) {
+      this->m_error = errno;
+    }
+    return this->m_error;
+  }
+
+  I32 StagingFile ::
+    reserve(U32 size)
+  {
+    FW_ASSERT(size <= this->m_staging.getBuffCapacity(), size);
+    if ((this->m_error == 0) && (this->m_staging.getBuffLength() + size > this->m_staging.getBuffCapacity())) {
+      this->flush();
+    }
+    return this->m_error;
+  }
+
+  Fw::SerializeBufferBase& StagingFile ::
+    buffer()
+  {
+    return this->m_staging;
+  }
+
+  I32 StagingFile ::
+    close()
+  {
+    FW_ASSERT(this->m_fd >= 0);
+    if (this->m_error == 0) {
+      this->flush();
+    }
+    if ((::close(this->m_fd) != 0) && (this->m_error == 0)) {
+      this->m_error = errno;
+    }
+    this->m_fd = -1;
+    return this->m_error;
+  }
+
+  void StagingFile ::
+    flush()
+  {
+    const U8* data = this->m_staging.getBuffAddr();
+    size_t remaining = this->m_staging.getBuffLength();
+    while (remaining > 0) {
+      const ssize_t written = ::write(this->m_fd, data, remaining);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        this->m_error = errno;
+        return;
+      }
+      data += written;
+      remaining -= static_cast<size_t>(written);
+    }
+    this->m_staging.resetSer();
+  }
+
+}
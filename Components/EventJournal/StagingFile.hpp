@@ -0,0 +1,71 @@
+// ======================================================================
+// \title  StagingFile.hpp
+// \author cindy
+// \brief  File written through a staging buffer, used by EventJournal and TlmHistory
+//
+// Records are serialized into a caller-owned buffer and reach the file in
+// writes of up to the buffer's size, so extracting thousands of small
+// records costs a handful of system calls. The first failed call is kept
+// and returned by close, so a writer serializes records without checking
+// every one.
+// ======================================================================
+
+#ifndef MathModule_StagingFile_HPP
+#define MathModule_StagingFile_HPP
+
+#include <FpConfig.hpp>
+#include <Fw/Types/Serializable.hpp>
+
+namespace MathModule {
+
+  class StagingFile {
+
+    public:
+
+      //! Construct a closed file staging into the given buffer
+      StagingFile(
+          U8* staging, //!< The staging buffer, owned by the caller
+          U32 size //!< Bytes of the staging buffer
+      );
+
+      //! Close the file if it is still open, dropping the staged bytes
+      ~StagingFile();
+
+      //! Create or truncate the file
+      //! \return 0, or the errno value of the failed call
+      I32 open(
+          const char* path //!< The file
+      );
+
+      //! Make room for a record, writing the staged bytes if it would not fit
+      //! \return 0, or the errno value of this or an earlier failed write
+      I32 reserve(
+          U32 size //!< Bytes of the record, at most the staging buffer's size
+      );
+
+      //! The staging buffer to serialize records into after reserving room for them
+      Fw::SerializeBufferBase& buffer();
+
+      //! Write the staged bytes and close the file
+      //! \return 0, or the errno value of the first failed call
+      I32 close();
+
+    private:
+
+      //! Write the staged bytes and empty the staging buffer
+      void flush();
+
+      //! The open file, or -1
+      int m_fd;
+
+      //! First errno value seen, or 0
+      I32 m_error;
+
+      //! Serializes into the caller's buffer
+      Fw::ExternalSerializeBuffer m_staging;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,198 @@
+// ======================================================================
+// \title  EventJournalTestMain.cpp
+// \author cindy
+// \brief  cpp file for EventJournal component test main function
+// ======================================================================
+
+#include "EventJournalTester.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+  std::string ringPath(const char* name)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/JournalRing.%s.%d", name, static_cast<int>(::getpid()));
+    (void) ::unlink(path);
+    return path;
+  }
+
+  MathModule::JournalRing::EntryHeader entryHeader(U32 id)
+  {
+    MathModule::JournalRing::EntryHeader header;
+    header.id = id;
+    header.seconds = 1000 + id;
+    header.useconds = id * 7;
+    header.timeBase = 2;
+    header.timeContext = static_cast<U8>(id);
+    header.severity = static_cast<U8>(Fw::LogSeverity::ACTIVITY_HI);
+    return header;
+  }
+
+}
+
+TEST(JournalRing, Wrap) {
+  const std::string path = ringPath("wrap");
+  MathModule::JournalRing ring;
+  ASSERT_EQ(ring.open(path.c_str(), 4), 0);
+  MathModule::JournalRing::Entry entry;
+  EXPECT_FALSE(ring.read(0, entry));
+
+  U8 args[MathModule::JournalRing::ARG_CAPACITY + 10];
+  for (U32 i = 0; i < sizeof(args); i++) {
+    args[i] = static_cast<U8>(i);
+  }
+  for (U32 id = 0; id < 10; id++) {
+    ASSERT_TRUE(ring.append(entryHeader(id), args, (id == 9) ? sizeof(args) : id));
+  }
+  EXPECT_EQ(ring.head(), 10U);
+  for (U64 sequence = 0; sequence < 6; sequence++) {
+    EXPECT_FALSE(ring.read(sequence, entry)) << sequence;
+  }
+  for (U32 id = 6; id < 10; id++) {
+    ASSERT_TRUE(ring.read(id, entry));
+    EXPECT_EQ(entry.sequence, id);
+    EXPECT_EQ(entry.header.id, id);
+    EXPECT_EQ(entry.header.seconds, 1000 + id);
+    EXPECT_EQ(entry.header.useconds, id * 7);
+    EXPECT_EQ(entry.header.timeContext, id);
+    // Arguments beyond the capacity are clipped
+    const U32 size = (id == 9) ? MathModule::JournalRing::ARG_CAPACITY : id;
+    ASSERT_EQ(entry.argSize, size);
+    EXPECT_EQ(::memcmp(entry.args, args, size), 0);
+  }
+  EXPECT_FALSE(ring.read(10, entry));
+  ring.close();
+  EXPECT_FALSE(ring.append(entryHeader(0), args, 0));
+  (void) ::unlink(path.c_str());
+}
+
+TEST(JournalRing, Reopen) {
+  const std::string path = ringPath("reopen");
+  MathModule::JournalRing::Entry entry;
+  {
+    MathModule::JournalRing ring;
+    ASSERT_EQ(ring.open(path.c_str(), 16), 0);
+    for (U32 id = 0; id < 5; id++) {
+      ASSERT_TRUE(ring.append(entryHeader(id), nullptr, 0));
+    }
+  }
+  {
+    // Same layout: the entries are still there and appends continue after them
+    MathModule::JournalRing ring;
+    ASSERT_EQ(ring.open(path.c_str(), 16), 0);
+    EXPECT_EQ(ring.head(), 5U);
+    ASSERT_TRUE(ring.read(4, entry));
+    EXPECT_EQ(entry.header.id, 4U);
+    ASSERT_TRUE(ring.append(entryHeader(5), nullptr, 0));
+    EXPECT_EQ(ring.head(), 6U);
+  }
+  {
+    // Different slot count: started over
+    MathModule::JournalRing ring;
+    ASSERT_EQ(ring.open(path.c_str(), 8), 0);
+    EXPECT_EQ(ring.head(), 0U);
+    EXPECT_FALSE(ring.read(0, entry));
+  }
+  {
+    // Damaged header: started over
+    MathModule::JournalRing ring;
+    ASSERT_EQ(ring.open(path.c_str(), 8), 0);
+    ASSERT_TRUE(ring.append(entryHeader(0), nullptr, 0));
+    ring.close();
+    FILE* file = ::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    (void) ::fputc(0, file);
+    (void) ::fclose(file);
+    ASSERT_EQ(ring.open(path.c_str(), 8), 0);
+    EXPECT_EQ(ring.head(), 0U);
+  }
+  MathModule::JournalRing ring;
+  EXPECT_EQ(ring.open("/nonexistent/journal", 8), ENOENT);
+  EXPECT_EQ(ring.slotCount(), 0U);
+  (void) ::unlink(path.c_str());
+}
+
+TEST(JournalRing, ConcurrentAppend) {
+  const std::string path = ringPath("concurrent");
+  MathModule::JournalRing ring;
+  ASSERT_EQ(ring.open(path.c_str(), 64), 0);
+  const U32 WRITERS = 4;
+  const U32 APPENDS = 20000;
+  std::atomic<bool> done(false);
+  std::atomic<U32> torn(0);
+  std::atomic<U32> checked(0);
+
+  // Every entry's fields and arguments are derived from its id, so a mix of two entries shows up
+  std::thread reader([&]() {
+    MathModule::JournalRing::Entry entry;
+    bool last = false;
+    while (!last) {
+      last = done.load();
+      const U64 head = ring.head();
+      for (U64 sequence = (head > 64) ? head - 64 : 0; sequence < head; sequence++) {
+        if (!ring.read(sequence, entry)) {
+          continue;
+        }
+        bool ok = (entry.header.seconds == 1000 + entry.header.id) && (entry.argSize == entry.header.id % 50);
+        for (U32 b = 0; ok && (b < entry.argSize); b++) {
+          ok = (entry.args[b] == static_cast<U8>(entry.header.id));
+        }
+        torn += ok ? 0 : 1;
+        ++checked;
+      }
+    }
+  });
+  std::vector<std::thread> writers;
+  for (U32 w = 0; w < WRITERS; w++) {
+    writers.emplace_back([&ring, w, APPENDS]() {
+      U8 args[50];
+      for (U32 i = 0; i < APPENDS; i++) {
+        const U32 id = w * APPENDS + i;
+        ::memset(args, static_cast<U8>(id), sizeof(args));
+        (void) ring.append(entryHeader(id), args, id % 50);
+      }
+    });
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(ring.head(), WRITERS * APPENDS);
+  EXPECT_EQ(torn.load(), 0U);
+  EXPECT_GT(checked.load(), 0U);
+  (void) ::unlink(path.c_str());
+}
+
+TEST(Nominal, Forward) {
+  MathModule::EventJournalTester tester;
+  tester.testForward();
+}
+
+TEST(Nominal, DownlinkRange) {
+  MathModule::EventJournalTester tester;
+  tester.testDownlinkRange();
+}
+
+TEST(OffNominal, DownlinkRejected) {
+  MathModule::EventJournalTester tester;
+  tester.testDownlinkRejected();
+}
+
+TEST(OffNominal, Unconfigured) {
+  MathModule::EventJournalTester tester;
+  tester.testUnconfigured();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
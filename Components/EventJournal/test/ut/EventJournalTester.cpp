@@ -0,0 +1,205 @@
+// ======================================================================
+// \title  EventJournalTester.cpp
+// \author cindy
+// \brief  cpp file for EventJournal component test harness implementation class
+// ======================================================================
+
+#include "EventJournalTester.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 EventJournalTester::SLOTS;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  EventJournalTester ::
+    EventJournalTester() :
+      EventJournalGTestBase("EventJournalTester", EventJournalTester::MAX_HISTORY_SIZE),
+      component("EventJournal"),
+      m_sendStatus(Svc::SendFileStatus::STATUS_OK)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/EventJournalTester.%d", static_cast<int>(::getpid()));
+    this->m_prefix = path;
+    this->m_ringPath = this->m_prefix + ".ring";
+    (void) ::unlink(this->m_ringPath.c_str());
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  EventJournalTester ::
+    ~EventJournalTester()
+  {
+    (void) ::unlink(this->m_ringPath.c_str());
+    for (const std::string& file : this->m_sentFiles) {
+      (void) ::unlink(file.c_str());
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void EventJournalTester ::
+    testForward()
+  {
+    this->configure();
+    ASSERT_EVENTS_JOURNAL_OPENED(0, 0, SLOTS);
+
+    this->logEvent(0x1234, 100, 6);
+    ASSERT_from_logOut_SIZE(1);
+    EXPECT_EQ(this->fromPortHistory_logOut->at(0).id, 0x1234U);
+    EXPECT_EQ(this->fromPortHistory_logOut->at(0).timeTag.getSeconds(), 100U);
+    EXPECT_EQ(this->fromPortHistory_logOut->at(0).severity, Fw::LogSeverity::WARNING_LO);
+    EXPECT_EQ(this->fromPortHistory_logOut->at(0).args.getBuffLength(), 6U);
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_ENTRIES_WRITTEN(0, 1);
+    ASSERT_TLM_ENTRIES_DROPPED(0, 0);
+  }
+
+  void EventJournalTester ::
+    testDownlinkRange()
+  {
+    this->configure();
+    // Twelve events at 100..111 s; the ring keeps the last eight
+    for (U32 i = 0; i < 12; i++) {
+      this->logEvent(0x0B00 + i, 100 + i, i);
+    }
+    this->downlinkRange(102, 109);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, EventJournal::OPCODE_DOWNLINK_RANGE, 5, Fw::CmdResponse::OK);
+    const std::string file = this->m_prefix + "_102_109.bin";
+    ASSERT_EQ(this->m_sentFiles.size(), 1U);
+    EXPECT_EQ(this->m_sentFiles[0], file);
+    ASSERT_EVENTS_RANGE_EXTRACTED_SIZE(1);
+    ASSERT_EVENTS_RANGE_EXTRACTED(0, 6, file.c_str());
+
+    std::ifstream stream(file, std::ios::binary);
+    std::vector<U8> contents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    Fw::ExternalSerializeBuffer reader(contents.data(), static_cast<NATIVE_UINT_TYPE>(contents.size()));
+    ASSERT_EQ(reader.setBuffLen(static_cast<NATIVE_UINT_TYPE>(contents.size())), Fw::FW_SERIALIZE_OK);
+    U32 magic = 0;
+    U32 start = 0;
+    U32 end = 0;
+    ASSERT_EQ(reader.deserialize(magic), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(reader.deserialize(start), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(reader.deserialize(end), Fw::FW_SERIALIZE_OK);
+    EXPECT_EQ(magic, EventJournal::RANGE_FILE_MAGIC);
+    EXPECT_EQ(start, 102U);
+    EXPECT_EQ(end, 109U);
+    // 100 and 101 were overwritten, so the range starts at the oldest kept entry
+    for (U32 i = 4; i < 10; i++) {
+      U64 sequence = 0;
+      FwEventIdType id = 0;
+      Fw::Time time;
+      U8 severity = 0;
+      U16 argSize = 0;
+      ASSERT_EQ(reader.deserialize(sequence), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(reader.deserialize(id), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(reader.deserialize(time), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(reader.deserialize(severity), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(reader.deserialize(argSize), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(sequence, i);
+      EXPECT_EQ(id, 0x0B00 + i);
+      EXPECT_EQ(time.getSeconds(), 100 + i);
+      EXPECT_EQ(time.getUSeconds(), 250 * i);
+      EXPECT_EQ(severity, static_cast<U8>(Fw::LogSeverity::WARNING_LO));
+      ASSERT_EQ(argSize, i);
+      for (U32 b = 0; b < argSize; b++) {
+        U8 value = 0;
+        ASSERT_EQ(reader.deserialize(value), Fw::FW_SERIALIZE_OK);
+        EXPECT_EQ(value, static_cast<U8>(i + b));
+      }
+    }
+    EXPECT_EQ(reader.getBuffLeft(), 0U);
+  }
+
+  void EventJournalTester ::
+    testDownlinkRejected()
+  {
+    this->configure();
+    this->logEvent(0x0B00, 100, 0);
+    this->m_sendStatus = Svc::SendFileStatus::STATUS_BUSY;
+    this->downlinkRange(0, 200);
+    ASSERT_CMD_RESPONSE(0, EventJournal::OPCODE_DOWNLINK_RANGE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_RANGE_DOWNLINK_REJECTED_SIZE(1);
+    ASSERT_EVENTS_RANGE_DOWNLINK_REJECTED(0, Svc::SendFileStatus::STATUS_BUSY);
+    ASSERT_EVENTS_RANGE_EXTRACTED_SIZE(0);
+  }
+
+  void EventJournalTester ::
+    testUnconfigured()
+  {
+    this->logEvent(0x0B00, 100, 2);
+    ASSERT_from_logOut_SIZE(1);
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_ENTRIES_WRITTEN(0, 0);
+    ASSERT_TLM_ENTRIES_DROPPED(0, 1);
+
+    this->downlinkRange(0, 200);
+    ASSERT_CMD_RESPONSE(0, EventJournal::OPCODE_DOWNLINK_RANGE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_JOURNAL_UNAVAILABLE_SIZE(1);
+
+    this->downlinkRange(200, 100);
+    ASSERT_CMD_RESPONSE(0, EventJournal::OPCODE_DOWNLINK_RANGE, 5, Fw::CmdResponse::VALIDATION_ERROR);
+    EXPECT_TRUE(this->m_sentFiles.empty());
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Svc::SendFileResponse EventJournalTester ::
+    from_sendFile_handler(
+        NATIVE_INT_TYPE portNum,
+        const Fw::StringBase& fileNameFrom,
+        const Fw::StringBase& fileNameTo,
+        U32 offset,
+        U32 length
+    )
+  {
+    this->m_sentFiles.push_back(fileNameFrom.toChar());
+    EXPECT_EQ(fileNameTo, fileNameFrom);
+    EXPECT_EQ(offset, 0U);
+    EXPECT_EQ(length, 0U);
+    return Svc::SendFileResponse(this->m_sendStatus, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void EventJournalTester ::
+    configure()
+  {
+    this->component.configure(this->m_ringPath.c_str(), SLOTS, this->m_prefix.c_str());
+  }
+
+  void EventJournalTester ::
+    logEvent(FwEventIdType id, U32 seconds, U32 size)
+  {
+    Fw::Time time(TB_WORKSTATION_TIME, 0, seconds, 250 * (seconds - 100));
+    Fw::LogBuffer args;
+    for (U32 b = 0; b < size; b++) {
+      ASSERT_EQ(args.serialize(static_cast<U8>(id - 0x0B00 + b)), Fw::FW_SERIALIZE_OK);
+    }
+    this->invoke_to_LogRecv(0, id, time, Fw::LogSeverity::WARNING_LO, args);
+  }
+
+  void EventJournalTester ::
+    downlinkRange(U32 start, U32 end)
+  {
+    this->clearHistory();
+    this->sendCmd_DOWNLINK_RANGE(0, 5, start, end);
+    this->component.doDispatch();
+  }
+
+}
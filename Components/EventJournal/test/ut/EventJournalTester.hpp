@@ -0,0 +1,131 @@
+// ======================================================================
+// \title  EventJournalTester.hpp
+// \author cindy
+// \brief  hpp file for EventJournal component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_EventJournalTester_HPP
+#define MathModule_EventJournalTester_HPP
+
+#include "EventJournalGTestBase.hpp"
+#include "Components/EventJournal/EventJournal.hpp"
+
+#include <string>
+#include <vector>
+
+namespace MathModule {
+
+  class EventJournalTester :
+    public EventJournalGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Slots in the test journal
+      static const U32 SLOTS = 8;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object EventJournalTester
+      EventJournalTester();
+
+      //! Destroy object EventJournalTester, removing its files
+      ~EventJournalTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Events are journaled and forwarded unchanged
+      void testForward();
+
+      //! A range of the kept entries is written to a file and handed to file downlink
+      void testDownlinkRange();
+
+      //! A range file file downlink does not accept fails the command
+      void testDownlinkRejected();
+
+      //! Without a journal file events are forwarded and counted, and ranges fail
+      void testUnconfigured();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for sendFile
+      Svc::SendFileResponse from_sendFile_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          const Fw::StringBase& fileNameFrom, //!< Path of file to downlink
+          const Fw::StringBase& fileNameTo, //!< Path to store downlinked file at
+          U32 offset, //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+          U32 length //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Map the test journal
+      void configure();
+
+      //! Log an event at a time with size argument bytes
+      void logEvent(FwEventIdType id, U32 seconds, U32 size);
+
+      //! Send DOWNLINK_RANGE and let the component run it
+      void downlinkRange(U32 start, U32 end);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      EventJournal component;
+
+      //! Ring file path
+      std::string m_ringPath;
+
+      //! Range file prefix
+      std::string m_prefix;
+
+      //! Answer of the sendFile port
+      Svc::SendFileStatus m_sendStatus;
+
+      //! Files handed to sendFile
+      std::vector<std::string> m_sentFiles;
+
+  };
+
+}
+
+#endif
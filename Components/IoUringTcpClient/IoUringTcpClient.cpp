@@ -0,0 +1,820 @@
+// ======================================================================
+// \title  IoUringTcpClient.cpp
+// \author cindy
+// \brief  cpp file for IoUringTcpClient component implementation class
+// ======================================================================
+
+#include "Components/IoUringTcpClient/IoUringTcpClient.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    // The raw system calls; the deployment does not depend on liburing
+
+    int ioUringSetup(U32 entries, struct io_uring_params* params)
+    {
+      return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ioUringEnter(int ringFd, U32 toSubmit, U32 minComplete, U32 flags)
+    {
+      return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    int ioUringRegister(int ringFd, U32 opcode, const void* arg, U32 count)
+    {
+      return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, arg, count));
+    }
+
+    U64 pointerValue(const void* pointer)
+    {
+      return static_cast<U64>(reinterpret_cast<uintptr_t>(pointer));
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  IoUringTcpClient ::
+    IoUringTcpClient(const char* const compName) :
+      IoUringTcpClientComponentBase(compName),
+      m_port(0),
+      m_started(false),
+      m_ringFd(-1),
+      m_sqRing(nullptr),
+      m_sqRingSize(0),
+      m_cqRing(nullptr),
+      m_cqRingSize(0),
+      m_sqes(nullptr),
+      m_sqesSize(0),
+      m_sqHead(nullptr),
+      m_sqTail(nullptr),
+      m_sqArray(nullptr),
+      m_sqMask(0),
+      m_sqEntries(0),
+      m_sqLocalTail(0),
+      m_cqHead(nullptr),
+      m_cqTail(nullptr),
+      m_cqes(nullptr),
+      m_cqMask(0),
+      m_fd(-1),
+      m_connected(false),
+      m_failed(false),
+      m_error(0),
+      m_stopping(false),
+      m_slotCount(0),
+      m_nextSlot(0),
+      m_recvSlot(-1),
+      m_timeoutArmed(false),
+      m_pendingHead(0),
+      m_pendingCount(0),
+      m_batchCount(0),
+      m_sending(false),
+      m_bytesSent(0),
+      m_submitCalls(0),
+      m_sqesSubmitted(0),
+      m_sendOps(0),
+      m_framesSent(0),
+      m_reportedSubmitCalls(0),
+      m_reportedSqes(0),
+      m_reportedSendOps(0),
+      m_reportedFrames(0)
+  {
+    this->m_timeout.tv_sec = 0;
+    this->m_timeout.tv_nsec = static_cast<long long>(ALLOCATE_RETRY_MS) * 1000000;
+    ::memset(this->m_iov, 0, sizeof(this->m_iov));
+    ::memset(&this->m_msg, 0, sizeof(this->m_msg));
+  }
+
+  IoUringTcpClient ::
+    ~IoUringTcpClient()
+  {
+    this->teardownRing();
+  }
+
+  void IoUringTcpClient ::
+    configure(const char* hostname, U16 port)
+  {
+    FW_ASSERT(hostname != nullptr);
+    this->m_hostname = hostname;
+    this->m_port = port;
+  }
+
+  /*
+    A kernel without io_uring, or with it disabled by sysctl, is reported
+    rather than asserted, so the deployment still runs without a link.
+  */
+  void IoUringTcpClient ::
+    start(const Fw::StringBase& name, NATIVE_UINT_TYPE priority, NATIVE_UINT_TYPE stackSize)
+  {
+    FW_ASSERT(!this->m_started);
+    const I32 error = this->setupRing();
+    if (error != 0) {
+      this->log_WARNING_HI_RING_SETUP_ERROR(error);
+      return;
+    }
+    const Os::Task::TaskStatus status =
+      this->m_task.start(name, IoUringTcpClient::ringTask, this, priority, stackSize);
+    FW_ASSERT(status == Os::Task::TASK_OK, status);
+    this->m_started = true;
+  }
+
+  /*
+    The no-op completes at once and wakes the task out of io_uring_enter, so
+    it notices the stop without waiting for link traffic.
+  */
+  void IoUringTcpClient ::
+    stop()
+  {
+    this->m_lock.lock();
+    this->m_stopping = true;
+    const bool hasRing = (this->m_ringFd >= 0);
+    if (hasRing) {
+      struct io_uring_sqe* sqe = this->getSqe();
+      FW_ASSERT(sqe != nullptr);
+      sqe->opcode = IORING_OP_NOP;
+      sqe->user_data = TAG_WAKE;
+      this->commitSqe();
+    }
+    this->m_lock.unLock();
+
+    if (hasRing) {
+      (void) this->enter(0);
+    }
+  }
+
+  Os::Task::TaskStatus IoUringTcpClient ::
+    join()
+  {
+    if (!this->m_started) {
+      return Os::Task::TASK_OK;
+    }
+    const Os::Task::TaskStatus status = this->m_task.join(nullptr);
+    this->m_started = false;
+    return status;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    With no send in flight the frame is submitted right away, so an idle link
+    adds no latency. Otherwise it waits, and every frame that arrives during
+    the send in flight goes out in the next sendmsg, which the task submits
+    in the same io_uring_enter call it waits in. The pending ring holds more
+    frames than the framer has buffers, so in this deployment it never fills;
+    if it did, the frame would be dropped rather than block the caller.
+  */
+  Drv::SendStatus IoUringTcpClient ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_lock.lock();
+    const bool accepted = this->m_connected && !this->m_failed && !this->m_stopping &&
+                          (this->m_pendingCount < PENDING_CAPACITY);
+    bool queued = false;
+    if (accepted) {
+      this->m_pending[(this->m_pendingHead + this->m_pendingCount) % PENDING_CAPACITY] = fwBuffer;
+      ++this->m_pendingCount;
+      queued = this->startSend();
+    }
+    this->m_lock.unLock();
+
+    if (!accepted) {
+      this->deallocate_out(0, fwBuffer);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+    if (queued) {
+      (void) this->enter(0);
+    }
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  void IoUringTcpClient ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->m_lock.lock();
+    const U64 bytes = this->m_bytesSent;
+    const U32 submitCalls = this->m_submitCalls;
+    const U32 periodSubmitCalls = submitCalls - this->m_reportedSubmitCalls;
+    const U32 periodSqes = this->m_sqesSubmitted - this->m_reportedSqes;
+    const U32 periodSendOps = this->m_sendOps - this->m_reportedSendOps;
+    const U32 periodFrames = this->m_framesSent - this->m_reportedFrames;
+    this->m_reportedSubmitCalls = submitCalls;
+    this->m_reportedSqes = this->m_sqesSubmitted;
+    this->m_reportedSendOps = this->m_sendOps;
+    this->m_reportedFrames = this->m_framesSent;
+    this->m_lock.unLock();
+
+    this->tlmWrite_BYTES_SENT(bytes);
+    this->tlmWrite_SUBMIT_CALLS(submitCalls);
+    this->tlmWrite_SQES_PER_SUBMIT(
+      (periodSubmitCalls == 0) ? 0.0f : static_cast<F32>(periodSqes) / static_cast<F32>(periodSubmitCalls));
+    this->tlmWrite_FRAMES_PER_SEND(
+      (periodSendOps == 0) ? 0.0f : static_cast<F32>(periodFrames) / static_cast<F32>(periodSendOps));
+  }
+
+  // ----------------------------------------------------------------------
+  // Ring helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    The receive slots are registered empty when the ring is created, then
+    filled with buffers from the allocate port as the task needs them. Reads
+    into a registered buffer skip the per-operation page pinning of a plain
+    read.
+  */
+  I32 IoUringTcpClient ::
+    setupRing()
+  {
+    struct io_uring_params params;
+    ::memset(&params, 0, sizeof(params));
+    this->m_ringFd = ioUringSetup(RING_ENTRIES, &params);
+    if (this->m_ringFd < 0) {
+      return errno;
+    }
+
+    this->m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(U32);
+    this->m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+      this->m_sqRingSize = FW_MAX(this->m_sqRingSize, this->m_cqRingSize);
+      this->m_cqRingSize = this->m_sqRingSize;
+    }
+    this->m_sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    I32 error = 0;
+    void* sqRing = ::mmap(nullptr, this->m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          this->m_ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+      error = errno;
+      this->teardownRing();
+      return error;
+    }
+    this->m_sqRing = sqRing;
+
+    void* cqRing = sqRing;
+    if (!singleMap) {
+      cqRing = ::mmap(nullptr, this->m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      this->m_ringFd, IORING_OFF_CQ_RING);
+      if (cqRing == MAP_FAILED) {
+        error = errno;
+        this->teardownRing();
+        return error;
+      }
+    }
+    this->m_cqRing = cqRing;
+
+    void* sqes = ::mmap(nullptr, this->m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        this->m_ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      error = errno;
+      this->teardownRing();
+      return error;
+    }
+    this->m_sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+    U8* const sq = static_cast<U8*>(sqRing);
+    this->m_sqHead = reinterpret_cast<U32*>(sq + params.sq_off.head);
+    this->m_sqTail = reinterpret_cast<U32*>(sq + params.sq_off.tail);
+    this->m_sqArray = reinterpret_cast<U32*>(sq + params.sq_off.array);
+    this->m_sqMask = *reinterpret_cast<U32*>(sq + params.sq_off.ring_mask);
+    this->m_sqEntries = params.sq_entries;
+    this->m_sqLocalTail = *this->m_sqTail;
+
+    U8* const cq = static_cast<U8*>(cqRing);
+    this->m_cqHead = reinterpret_cast<U32*>(cq + params.cq_off.head);
+    this->m_cqTail = reinterpret_cast<U32*>(cq + params.cq_off.tail);
+    this->m_cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+    this->m_cqMask = *reinterpret_cast<U32*>(cq + params.cq_off.ring_mask);
+
+    struct iovec empty[RECV_SLOTS];
+    ::memset(empty, 0, sizeof(empty));
+    if (ioUringRegister(this->m_ringFd, IORING_REGISTER_BUFFERS, empty, RECV_SLOTS) < 0) {
+      error = errno;
+      this->teardownRing();
+      return error;
+    }
+    return 0;
+  }
+
+  void IoUringTcpClient ::
+    teardownRing()
+  {
+    if (this->m_sqes != nullptr) {
+      (void) ::munmap(this->m_sqes, this->m_sqesSize);
+      this->m_sqes = nullptr;
+    }
+    if ((this->m_cqRing != nullptr) && (this->m_cqRing != this->m_sqRing)) {
+      (void) ::munmap(this->m_cqRing, this->m_cqRingSize);
+    }
+    this->m_cqRing = nullptr;
+    if (this->m_sqRing != nullptr) {
+      (void) ::munmap(this->m_sqRing, this->m_sqRingSize);
+      this->m_sqRing = nullptr;
+    }
+    // Closing the ring also releases the registered buffers
+    if (this->m_ringFd >= 0) {
+      (void) ::close(this->m_ringFd);
+      this->m_ringFd = -1;
+    }
+  }
+
+  struct io_uring_sqe* IoUringTcpClient ::
+    getSqe()
+  {
+    const U32 head = __atomic_load_n(this->m_sqHead, __ATOMIC_ACQUIRE);
+    if (this->m_sqLocalTail - head >= this->m_sqEntries) {
+      return nullptr;
+    }
+    const U32 index = this->m_sqLocalTail & this->m_sqMask;
+    struct io_uring_sqe* sqe = &this->m_sqes[index];
+    ::memset(sqe, 0, sizeof(*sqe));
+    this->m_sqArray[index] = index;
+    return sqe;
+  }
+
+  void IoUringTcpClient ::
+    commitSqe()
+  {
+    ++this->m_sqLocalTail;
+    __atomic_store_n(this->m_sqTail, this->m_sqLocalTail, __ATOMIC_RELEASE);
+  }
+
+  /*
+    Any thread may submit. The kernel serializes submissions and never takes
+    more entries than are published, so a count made stale by another
+    thread's submission is harmless. Only the task waits for completions.
+
+    Interrupted calls are retried by the caller's loop. Any other failure
+    ends the connection like a failed operation: the socket is shut down so
+    the task wakes from its wait, disconnects and reconnects.
+  */
+  I32 IoUringTcpClient ::
+    enter(U32 waitCount)
+  {
+    this->m_lock.lock();
+    const U32 toSubmit = this->m_sqLocalTail - __atomic_load_n(this->m_sqHead, __ATOMIC_ACQUIRE);
+    this->m_lock.unLock();
+    if ((toSubmit == 0) && (waitCount == 0)) {
+      return 0;
+    }
+
+    const int result = ioUringEnter(this->m_ringFd, toSubmit, waitCount,
+                                    (waitCount > 0) ? IORING_ENTER_GETEVENTS : 0);
+    if (result < 0) {
+      const I32 error = errno;
+      if ((error == EINTR) || (error == EAGAIN) || (error == EBUSY)) {
+        return 0;
+      }
+      this->m_lock.lock();
+      this->fail(error);
+      const int fd = this->m_fd;
+      this->m_lock.unLock();
+      if (fd >= 0) {
+        (void) ::shutdown(fd, SHUT_RDWR);
+      }
+      return error;
+    }
+    if ((toSubmit > 0) && (result > 0)) {
+      this->m_lock.lock();
+      ++this->m_submitCalls;
+      this->m_sqesSubmitted += static_cast<U32>(result);
+      this->m_lock.unLock();
+    }
+    return 0;
+  }
+
+  void IoUringTcpClient ::
+    reapCompletions()
+  {
+    while (true) {
+      const U32 head = *this->m_cqHead;
+      const U32 tail = __atomic_load_n(this->m_cqTail, __ATOMIC_ACQUIRE);
+      if (head == tail) {
+        break;
+      }
+      const struct io_uring_cqe& cqe = this->m_cqes[head & this->m_cqMask];
+      const U64 tag = cqe.user_data;
+      const I32 result = cqe.res;
+      __atomic_store_n(this->m_cqHead, head + 1, __ATOMIC_RELEASE);
+      this->handleCompletion(tag, result);
+    }
+  }
+
+  /*
+    A received buffer goes up the stack as is and its slot stays empty until
+    the next refill. A failed read returns its buffer, since the slot is not
+    read into again before the refill either. A short send is resumed from
+    where the kernel stopped, so frames are never reordered or interleaved.
+    Sent frames are returned through the deallocate port once the kernel is
+    done with them.
+  */
+  void IoUringTcpClient ::
+    handleCompletion(U64 tag, I32 result)
+  {
+    switch (tag) {
+      case TAG_RECV: {
+        FW_ASSERT(this->m_recvSlot >= 0, this->m_recvSlot);
+        Fw::Buffer buffer = this->m_slots[this->m_recvSlot];
+        this->m_recvSlot = -1;
+        if (result > 0) {
+          buffer.setSize(static_cast<U32>(result));
+          this->recv_out(0, buffer, Drv::RecvStatus::RECV_OK);
+        } else {
+          this->deallocate_out(0, buffer);
+          this->m_lock.lock();
+          this->fail((result == 0) ? 0 : -result);
+          this->m_lock.unLock();
+        }
+        break;
+      }
+      case TAG_SEND: {
+        Fw::Buffer sent[MAX_BATCH];
+        U32 sentCount = 0;
+        this->m_lock.lock();
+        if (((result == -EINTR) || (result == -EAGAIN)) && !this->m_failed) {
+          this->queueSendmsg();
+        } else if (result < 0) {
+          this->m_sending = false;
+          this->fail(-result);
+        } else {
+          this->m_bytesSent += static_cast<U32>(result);
+          U32 remaining = static_cast<U32>(result);
+          while ((this->m_msg.msg_iovlen > 0) && ((remaining > 0) || (this->m_msg.msg_iov->iov_len == 0))) {
+            struct iovec* iov = this->m_msg.msg_iov;
+            if (remaining >= iov->iov_len) {
+              remaining -= static_cast<U32>(iov->iov_len);
+              ++this->m_msg.msg_iov;
+              --this->m_msg.msg_iovlen;
+            } else {
+              iov->iov_base = static_cast<U8*>(iov->iov_base) + remaining;
+              iov->iov_len -= remaining;
+              remaining = 0;
+            }
+          }
+          if (this->m_msg.msg_iovlen > 0) {
+            if (this->m_failed) {
+              this->m_sending = false;
+            } else {
+              this->queueSendmsg();
+            }
+          } else {
+            for (U32 i = 0; i < this->m_batchCount; i++) {
+              sent[i] = this->m_batch[i];
+            }
+            sentCount = this->m_batchCount;
+            this->m_framesSent += this->m_batchCount;
+            this->m_batchCount = 0;
+            this->m_sending = false;
+            (void) this->startSend();
+          }
+        }
+        this->m_lock.unLock();
+        for (U32 i = 0; i < sentCount; i++) {
+          this->deallocate_out(0, sent[i]);
+        }
+        break;
+      }
+      case TAG_TIMEOUT:
+        this->m_timeoutArmed = false;
+        break;
+      default:
+        // TAG_WAKE: waking up was the point
+        break;
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Connection helpers
+  // ----------------------------------------------------------------------
+
+  int IoUringTcpClient ::
+    connectToGround()
+  {
+    char service[8];
+    (void) ::snprintf(service, sizeof(service), "%u", static_cast<unsigned int>(this->m_port));
+
+    struct addrinfo hints;
+    ::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = nullptr;
+    if (::getaddrinfo(this->m_hostname.toChar(), service, &hints, &addresses) != 0) {
+      errno = EHOSTUNREACH;
+      return -1;
+    }
+
+    int fd = -1;
+    for (struct addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+      fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+      if (fd < 0) {
+        continue;
+      }
+      if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+        break;
+      }
+      const int error = errno;
+      (void) ::close(fd);
+      errno = error;
+      fd = -1;
+    }
+    ::freeaddrinfo(addresses);
+    if (fd < 0) {
+      return -1;
+    }
+
+    // Frames are batched here already, so Nagle would only add latency
+    const int one = 1;
+    (void) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+  }
+
+  /*
+    Each pass queues what the task itself needs (a read, or the retry timer
+    when the buffer manager is empty) and then submits it together with any
+    send queued by the completions of the previous pass, in the same
+    io_uring_enter call that waits for the next completion.
+  */
+  I32 IoUringTcpClient ::
+    serviceConnection()
+  {
+    while (true) {
+      this->m_lock.lock();
+      const bool done = this->m_failed || this->m_stopping;
+      this->m_lock.unLock();
+      if (done) {
+        break;
+      }
+      this->refillSlots();
+      this->armReceive();
+      (void) this->enter(1);
+      this->reapCompletions();
+    }
+
+    this->m_lock.lock();
+    const I32 error = this->m_failed ? this->m_error : 0;
+    this->m_lock.unLock();
+    return error;
+  }
+
+  /*
+    The kernel may still be reading the batch in flight, so the frames are
+    only returned once the shutdown has made every operation on the socket
+    complete. The socket is closed after that, so a late operation never hits
+    a reused descriptor. A ring that can no longer be entered reports no more
+    completions, so the wait ends there rather than hang the task.
+  */
+  void IoUringTcpClient ::
+    disconnect(int fd)
+  {
+    this->m_lock.lock();
+    this->m_connected = false;
+    this->fail(0);
+    this->m_lock.unLock();
+    (void) ::shutdown(fd, SHUT_RDWR);
+
+    while (true) {
+      this->m_lock.lock();
+      const bool sending = this->m_sending;
+      this->m_lock.unLock();
+      if (!sending && (this->m_recvSlot < 0)) {
+        break;
+      }
+      if (this->enter(1) != 0) {
+        break;
+      }
+      this->reapCompletions();
+    }
+    (void) ::close(fd);
+
+    Fw::Buffer dropped[MAX_BATCH + PENDING_CAPACITY];
+    U32 droppedCount = 0;
+    this->m_lock.lock();
+    for (U32 i = 0; i < this->m_batchCount; i++) {
+      dropped[droppedCount++] = this->m_batch[i];
+    }
+    this->m_batchCount = 0;
+    while (this->m_pendingCount > 0) {
+      dropped[droppedCount++] = this->m_pending[this->m_pendingHead];
+      this->m_pendingHead = (this->m_pendingHead + 1) % PENDING_CAPACITY;
+      --this->m_pendingCount;
+    }
+    this->m_fd = -1;
+    this->m_lock.unLock();
+
+    for (U32 i = 0; i < droppedCount; i++) {
+      this->deallocate_out(0, dropped[i]);
+    }
+  }
+
+  /*
+    The slots are read into in order and refilled only once all of them have
+    been used, so a single registration update covers every slot and the
+    refill costs one system call per RECV_SLOTS reads rather than one per
+    read. If the buffer manager runs short, the slots it could fill are
+    registered; if it is empty, armReceive falls back to the retry timer.
+  */
+  void IoUringTcpClient ::
+    refillSlots()
+  {
+    if ((this->m_nextSlot < this->m_slotCount) || (this->m_recvSlot >= 0)) {
+      return;
+    }
+    struct iovec iov[RECV_SLOTS];
+    U32 count = 0;
+    for (; count < RECV_SLOTS; count++) {
+      Fw::Buffer buffer = this->allocate_out(0, RECV_BUFFER_SIZE);
+      if ((buffer.getData() == nullptr) || (buffer.getSize() == 0)) {
+        break;
+      }
+      this->m_slots[count] = buffer;
+      iov[count].iov_base = buffer.getData();
+      iov[count].iov_len = buffer.getSize();
+    }
+    this->m_nextSlot = 0;
+    this->m_slotCount = 0;
+    if (count == 0) {
+      return;
+    }
+
+    struct io_uring_rsrc_update2 update;
+    ::memset(&update, 0, sizeof(update));
+    update.offset = 0;
+    update.data = pointerValue(iov);
+    update.nr = count;
+    if (ioUringRegister(this->m_ringFd, IORING_REGISTER_BUFFERS_UPDATE, &update, sizeof(update)) !=
+        static_cast<int>(count)) {
+      for (U32 slot = 0; slot < count; slot++) {
+        this->deallocate_out(0, this->m_slots[slot]);
+      }
+      return;
+    }
+    this->m_slotCount = count;
+  }
+
+  void IoUringTcpClient ::
+    armReceive()
+  {
+    if (this->m_recvSlot >= 0) {
+      return;
+    }
+    const bool ready = (this->m_nextSlot < this->m_slotCount);
+
+    this->m_lock.lock();
+    if (ready) {
+      const U32 slot = this->m_nextSlot++;
+      const Fw::Buffer& buffer = this->m_slots[slot];
+      struct io_uring_sqe* sqe = this->getSqe();
+      FW_ASSERT(sqe != nullptr);
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->fd = this->m_fd;
+      sqe->addr = pointerValue(buffer.getData());
+      sqe->len = buffer.getSize();
+      sqe->buf_index = static_cast<U16>(slot);
+      sqe->user_data = TAG_RECV;
+      this->commitSqe();
+      this->m_recvSlot = static_cast<I32>(slot);
+    } else if (!this->m_timeoutArmed) {
+      struct io_uring_sqe* sqe = this->getSqe();
+      FW_ASSERT(sqe != nullptr);
+      sqe->opcode = IORING_OP_TIMEOUT;
+      sqe->addr = pointerValue(&this->m_timeout);
+      sqe->len = 1;
+      sqe->user_data = TAG_TIMEOUT;
+      this->commitSqe();
+      this->m_timeoutArmed = true;
+    }
+    this->m_lock.unLock();
+  }
+
+  bool IoUringTcpClient ::
+    startSend()
+  {
+    if (this->m_sending || !this->m_connected || this->m_failed || (this->m_pendingCount == 0)) {
+      return false;
+    }
+    const U32 count = FW_MIN(this->m_pendingCount, MAX_BATCH);
+    for (U32 i = 0; i < count; i++) {
+      Fw::Buffer& frame = this->m_pending[this->m_pendingHead];
+      this->m_batch[i] = frame;
+      this->m_iov[i].iov_base = frame.getData();
+      this->m_iov[i].iov_len = frame.getSize();
+      this->m_pendingHead = (this->m_pendingHead + 1) % PENDING_CAPACITY;
+    }
+    this->m_pendingCount -= count;
+    this->m_batchCount = count;
+
+    ::memset(&this->m_msg, 0, sizeof(this->m_msg));
+    this->m_msg.msg_iov = this->m_iov;
+    this->m_msg.msg_iovlen = count;
+    this->m_sending = true;
+    ++this->m_sendOps;
+    this->queueSendmsg();
+    return true;
+  }
+
+  void IoUringTcpClient ::
+    queueSendmsg()
+  {
+    struct io_uring_sqe* sqe = this->getSqe();
+    FW_ASSERT(sqe != nullptr);
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = this->m_fd;
+    sqe->addr = pointerValue(&this->m_msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = TAG_SEND;
+    this->commitSqe();
+  }
+
+  void IoUringTcpClient ::
+    fail(I32 error)
+  {
+    if (!this->m_failed) {
+      this->m_failed = true;
+      this->m_error = error;
+    }
+  }
+
+  void IoUringTcpClient ::
+    ringTask(void* arg)
+  {
+    IoUringTcpClient* client = static_cast<IoUringTcpClient*>(arg);
+    FW_ASSERT(client != nullptr);
+
+    while (true) {
+      client->m_lock.lock();
+      const bool stopping = client->m_stopping;
+      client->m_lock.unLock();
+      if (stopping) {
+        break;
+      }
+
+      const int fd = client->connectToGround();
+      if (fd < 0) {
+        (void) ::usleep(RECONNECT_DELAY_USEC);
+        continue;
+      }
+
+      client->m_lock.lock();
+      const bool cancelled = client->m_stopping;
+      if (!cancelled) {
+        client->m_fd = fd;
+        client->m_connected = true;
+        client->m_failed = false;
+        client->m_error = 0;
+      }
+      client->m_lock.unLock();
+      if (cancelled) {
+        (void) ::close(fd);
+        break;
+      }
+
+      client->log_ACTIVITY_HI_CONNECTED();
+      client->ready_out(0);
+      const I32 error = client->serviceConnection();
+      client->disconnect(fd);
+
+      client->m_lock.lock();
+      const bool stopped = client->m_stopping;
+      client->m_lock.unLock();
+      if (!stopped) {
+        client->log_WARNING_HI_DISCONNECTED(error);
+      }
+    }
+
+    // The retry timer is the only operation that can still be outstanding
+    while (client->m_timeoutArmed) {
+      if (client->enter(1) != 0) {
+        break;
+      }
+      client->reapCompletions();
+    }
+    while (client->m_nextSlot < client->m_slotCount) {
+      client->deallocate_out(0, client->m_slots[client->m_nextSlot++]);
+    }
+  }
+
+}
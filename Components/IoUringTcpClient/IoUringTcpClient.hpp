@@ -0,0 +1,286 @@
+// ======================================================================
+// \title  IoUringTcpClient.hpp
+// \author cindy
+// \brief  hpp file for IoUringTcpClient component implementation class
+// ======================================================================
+
+#ifndef MathModule_IoUringTcpClient_HPP
+#define MathModule_IoUringTcpClient_HPP
+
+#include "Components/IoUringTcpClient/IoUringTcpClientComponentAc.hpp"
+#include <Fw/Types/String.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace MathModule {
+
+  class IoUringTcpClient :
+    public IoUringTcpClientComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Submission queue entries. At most one send, one receive, one timeout and a wakeup are outstanding.
+      static const U32 RING_ENTRIES = 16;
+
+      //! Most frames carried by one sendmsg operation
+      static const U32 MAX_BATCH = 8;
+
+      //! Frames waiting for the send in flight to complete. Larger than the framer's buffer pool.
+      static const U32 PENDING_CAPACITY = 64;
+
+      //! Registered receive buffers. They are refilled together, so one registration update serves this many receives.
+      static const U32 RECV_SLOTS = 8;
+
+      //! Size requested from the allocate port for each receive buffer
+      static const U32 RECV_BUFFER_SIZE = 1024;
+
+      //! Delay between connection attempts, microseconds
+      static const U32 RECONNECT_DELAY_USEC = 1000000;
+
+      //! Retry period when no receive buffer could be allocated, milliseconds
+      static const U32 ALLOCATE_RETRY_MS = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct IoUringTcpClient object
+      IoUringTcpClient(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy IoUringTcpClient object
+      ~IoUringTcpClient();
+
+      //! Set the ground address
+      void configure(
+          const char* hostname, //!< Ground host name or address
+          U16 port //!< Ground port
+      );
+
+      //! Create the ring and start the task that connects to the ground and completes I/O
+      void start(
+          const Fw::StringBase& name, //!< Task name
+          NATIVE_UINT_TYPE priority, //!< Task priority
+          NATIVE_UINT_TYPE stackSize //!< Task stack size
+      );
+
+      //! Ask the task to disconnect and exit
+      void stop();
+
+      //! Wait for the task to exit
+      Os::Task::TaskStatus join();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Completion tags carried in user_data
+      enum Tag {
+        TAG_RECV = 1, //!< Read into a registered receive buffer
+        TAG_SEND = 2, //!< sendmsg of the batch in flight
+        TAG_TIMEOUT = 3, //!< Allocation retry timer
+        TAG_WAKE = 4 //!< No-op submitted by stop
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Ring helpers
+      // ----------------------------------------------------------------------
+
+      //! Create and map the ring and register the empty receive slots
+      //! \return 0 on success, otherwise the errno value
+      I32 setupRing();
+
+      //! Unmap and close the ring
+      void teardownRing();
+
+      //! Get the next free submission entry, cleared. Called with m_lock held.
+      struct io_uring_sqe* getSqe();
+
+      //! Publish the entry returned by getSqe. Called with m_lock held.
+      void commitSqe();
+
+      //! Submit published entries and optionally wait for completions. A failure other than an
+      //! interruption fails the connection.
+      //! \return 0 if the call succeeded or may be retried, otherwise the errno value
+      I32 enter(U32 waitCount);
+
+      //! Handle every completion in the completion queue
+      void reapCompletions();
+
+      //! Handle one completion
+      void handleCompletion(U64 tag, I32 result);
+
+      // ----------------------------------------------------------------------
+      // Connection helpers
+      // ----------------------------------------------------------------------
+
+      //! Open a socket connected to the ground
+      //! \return the socket, or -1 with errno set
+      int connectToGround();
+
+      //! Complete I/O on the connection until it fails or the driver is stopped
+      //! \return the errno value that ended the connection, 0 for an orderly shutdown
+      I32 serviceConnection();
+
+      //! Wait for outstanding operations on the socket, then close it and drop unsent frames
+      void disconnect(int fd);
+
+      //! Once every slot has been read into, allocate new buffers for all of them and register them in one update
+      void refillSlots();
+
+      //! Queue a read into the next ready slot if none is in flight, or a retry timer if no slot is ready
+      void armReceive();
+
+      //! Move pending frames into a new sendmsg operation if none is in flight. Called with m_lock held.
+      //! \return whether an operation was queued
+      bool startSend();
+
+      //! Queue the sendmsg operation for the current batch. Called with m_lock held.
+      void queueSendmsg();
+
+      //! Mark the connection failed with the first error seen. Called with m_lock held.
+      void fail(I32 error);
+
+      //! Task entry point
+      static void ringTask(void* arg);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Ground host name
+      Fw::String m_hostname;
+
+      //! Ground port
+      U16 m_port;
+
+      //! Guards the submission queue, the connection state, the send state and the statistics
+      Os::Mutex m_lock;
+
+      //! Task connecting and completing I/O
+      Os::Task m_task;
+
+      //! Whether the task was started
+      bool m_started;
+
+      //! Ring file descriptor, or -1
+      int m_ringFd;
+
+      //! Ring mappings
+      void* m_sqRing;
+      size_t m_sqRingSize;
+      void* m_cqRing;
+      size_t m_cqRingSize;
+      struct io_uring_sqe* m_sqes;
+      size_t m_sqesSize;
+
+      //! Submission queue fields inside the mapping
+      U32* m_sqHead;
+      U32* m_sqTail;
+      U32* m_sqArray;
+      U32 m_sqMask;
+      U32 m_sqEntries;
+
+      //! Submission queue tail including entries not yet published
+      U32 m_sqLocalTail;
+
+      //! Completion queue fields inside the mapping
+      U32* m_cqHead;
+      U32* m_cqTail;
+      struct io_uring_cqe* m_cqes;
+      U32 m_cqMask;
+
+      //! Connected socket, or -1
+      int m_fd;
+
+      //! Whether the connection can take new operations
+      bool m_connected;
+
+      //! Whether the connection failed, and the error
+      bool m_failed;
+      I32 m_error;
+
+      //! Whether stop was called
+      bool m_stopping;
+
+      //! Registered receive buffers. Slots from m_nextSlot up to m_slotCount hold a buffer. Owned by the task.
+      Fw::Buffer m_slots[RECV_SLOTS];
+      U32 m_slotCount;
+      U32 m_nextSlot;
+
+      //! Slot being read into, or -1. Owned by the task.
+      I32 m_recvSlot;
+
+      //! Whether the retry timer is outstanding, and its period. Owned by the task.
+      bool m_timeoutArmed;
+      struct __kernel_timespec m_timeout;
+
+      //! Frames waiting for the send in flight, as a ring
+      Fw::Buffer m_pending[PENDING_CAPACITY];
+      U32 m_pendingHead;
+      U32 m_pendingCount;
+
+      //! Batch carried by the send in flight
+      Fw::Buffer m_batch[MAX_BATCH];
+      struct iovec m_iov[MAX_BATCH];
+      struct msghdr m_msg;
+      U32 m_batchCount;
+
+      //! Whether a sendmsg operation is in flight
+      bool m_sending;
+
+      //! Telemetry counters
+      U64 m_bytesSent;
+      U32 m_submitCalls;
+      U32 m_sqesSubmitted;
+      U32 m_sendOps;
+      U32 m_framesSent;
+
+      //! Counters at the last report, for the per-period ratios
+      U32 m_reportedSubmitCalls;
+      U32 m_reportedSqes;
+      U32 m_reportedSendOps;
+      U32 m_reportedFrames;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,37 @@
+// ======================================================================
+// \title  IoUringTcpClientTestMain.cpp
+// \author cindy
+// \brief  cpp file for IoUringTcpClient component test main function
+// ======================================================================
+
+#include "IoUringTcpClientTester.hpp"
+
+TEST(Nominal, SendBatching) {
+  MathModule::IoUringTcpClientTester tester;
+  tester.testSendBatching();
+}
+
+TEST(Nominal, ShortSend) {
+  MathModule::IoUringTcpClientTester tester;
+  tester.testShortSend();
+}
+
+TEST(Nominal, ReceiveRefill) {
+  MathModule::IoUringTcpClientTester tester;
+  tester.testReceiveRefill();
+}
+
+TEST(OffNominal, Disconnect) {
+  MathModule::IoUringTcpClientTester tester;
+  tester.testDisconnect();
+}
+
+TEST(OffNominal, Stop) {
+  MathModule::IoUringTcpClientTester tester;
+  tester.testStop();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
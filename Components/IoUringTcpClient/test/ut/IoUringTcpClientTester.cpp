@@ -0,0 +1,447 @@
+// ======================================================================
+// \title  IoUringTcpClientTester.cpp
+// \author cindy
+// \brief  cpp file for IoUringTcpClient component test harness implementation class
+// ======================================================================
+
+#include "IoUringTcpClientTester.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    std::vector<U8> testPayload(U32 size, U8 seed)
+    {
+      std::vector<U8> payload(size);
+      for (U32 i = 0; i < size; i++) {
+        payload[i] = static_cast<U8>(seed + 7 * i + (i >> 12));
+      }
+      return payload;
+    }
+
+    //! Larger than the socket buffers on both ends, so the kernel takes only part of it per sendmsg
+    const U32 BIG_FRAME_SIZE = 8 * 1024 * 1024;
+
+  }
+
+  const U32 IoUringTcpClientTester::RECV_CONTEXT;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  IoUringTcpClientTester ::
+    IoUringTcpClientTester() :
+      IoUringTcpClientGTestBase("IoUringTcpClientTester", IoUringTcpClientTester::MAX_HISTORY_SIZE),
+      component("IoUringTcpClient"),
+      m_listener(-1),
+      m_ground(-1),
+      m_allocateEnabled(true),
+      m_allocateCalls(0),
+      m_recvOutstanding(0),
+      m_ready(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  IoUringTcpClientTester ::
+    ~IoUringTcpClientTester()
+  {
+    this->closeGround();
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  /*
+    The big frame keeps the sendmsg in flight until the ground reads, so the
+    three small frames queue up behind it and go out as one batch.
+  */
+  void IoUringTcpClientTester ::
+    testSendBatching()
+  {
+    if (!this->startDriver()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(this->acceptGround(1));
+
+    std::vector<U8> frames[4] = {
+      testPayload(BIG_FRAME_SIZE, 0x10), testPayload(100, 0x20), testPayload(200, 0x30), testPayload(300, 0x40)
+    };
+    std::vector<U8> expected;
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(frames); i++) {
+      expected.insert(expected.end(), frames[i].begin(), frames[i].end());
+    }
+
+    this->sendFrame(frames[0], 0);
+    ASSERT_TRUE(this->waitForGroundData());
+    for (U32 i = 1; i < FW_NUM_ARRAY_ELEMENTS(frames); i++) {
+      this->sendFrame(frames[i], i);
+    }
+
+    ASSERT_EQ(this->readGround(expected.size()), expected);
+    ASSERT_TRUE(this->waitForDeallocated(4));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1, 2, 3}));
+    this->m_lock.unLock();
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_FRAMES_PER_SEND_SIZE(1);
+    ASSERT_TLM_FRAMES_PER_SEND(0, 2.0f);
+    ASSERT_TLM_BYTES_SENT(0, expected.size());
+  }
+
+  /*
+    The kernel takes only part of the big frame per sendmsg, so the driver has
+    to resubmit the rest. The frame stays with the driver until the last byte
+    is taken, and the connection carries on afterwards.
+  */
+  void IoUringTcpClientTester ::
+    testShortSend()
+  {
+    if (!this->startDriver()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(this->acceptGround(1));
+
+    std::vector<U8> big = testPayload(BIG_FRAME_SIZE, 0x50);
+    const std::vector<U8> expectedBig(big);
+    this->sendFrame(big, 0);
+    ASSERT_TRUE(this->waitForGroundData());
+    (void) ::usleep(50000);
+    this->m_lock.lock();
+    EXPECT_TRUE(this->m_deallocated.empty());
+    this->m_lock.unLock();
+
+    ASSERT_EQ(this->readGround(expectedBig.size()), expectedBig);
+    ASSERT_TRUE(this->waitForDeallocated(1));
+
+    std::vector<U8> small = testPayload(100, 0x60);
+    const std::vector<U8> expectedSmall(small);
+    this->sendFrame(small, 1);
+    ASSERT_EQ(this->readGround(expectedSmall.size()), expectedSmall);
+    ASSERT_TRUE(this->waitForDeallocated(2));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1}));
+    this->m_lock.unLock();
+
+    // The resubmissions of the big frame do not count as sends of their own
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_FRAMES_PER_SEND(0, 1.0f);
+    ASSERT_TLM_BYTES_SENT(0, expectedBig.size() + expectedSmall.size());
+    ASSERT_EVENTS_CONNECTED_SIZE(1);
+    ASSERT_EVENTS_DISCONNECTED_SIZE(0);
+  }
+
+  /*
+    While the buffer manager is empty nothing can be received, and the retry
+    timer keeps the driver asking. Once buffers are available again every
+    slot is filled at once and the waiting bytes come up. Later reads use the
+    remaining slots, and the slots are refilled once all have been used.
+  */
+  void IoUringTcpClientTester ::
+    testReceiveRefill()
+  {
+    this->m_allocateEnabled = false;
+    if (!this->startDriver()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(this->acceptGround(1));
+
+    const std::vector<U8> first = testPayload(100, 0x70);
+    this->writeGround(first);
+    (void) ::usleep(100000);
+    this->m_lock.lock();
+    EXPECT_TRUE(this->m_received.empty());
+    EXPECT_GT(this->m_allocateCalls, 2U);
+    this->m_allocateEnabled = true;
+    this->m_lock.unLock();
+    ASSERT_TRUE(this->waitForReceived(first.size()));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_recvOutstanding, IoUringTcpClient::RECV_SLOTS - 1);
+    this->m_lock.unLock();
+
+    // More than two refills' worth of reads
+    const std::vector<U8> second =
+      testPayload(2 * IoUringTcpClient::RECV_SLOTS * IoUringTcpClient::RECV_BUFFER_SIZE + 100, 0x80);
+    this->writeGround(second);
+    std::vector<U8> expected(first);
+    expected.insert(expected.end(), second.begin(), second.end());
+    ASSERT_TRUE(this->waitForReceived(expected.size()));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_received, expected);
+    this->m_lock.unLock();
+  }
+
+  /*
+    The ground goes away with a send in flight and frames waiting behind it.
+    All of them come back once, and the driver connects again.
+  */
+  void IoUringTcpClientTester ::
+    testDisconnect()
+  {
+    if (!this->startDriver()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(this->acceptGround(1));
+
+    std::vector<U8> frames[3] = {testPayload(BIG_FRAME_SIZE, 0x90), testPayload(100, 0xA0), testPayload(200, 0xB0)};
+    this->sendFrame(frames[0], 0);
+    ASSERT_TRUE(this->waitForGroundData());
+    this->sendFrame(frames[1], 1);
+    this->sendFrame(frames[2], 2);
+
+    // Unread data makes the close reset the connection
+    (void) ::close(this->m_ground);
+    this->m_ground = -1;
+    ASSERT_TRUE(this->waitForDeallocated(3));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1, 2}));
+    this->m_lock.unLock();
+
+    ASSERT_TRUE(this->acceptGround(2));
+    ASSERT_EVENTS_DISCONNECTED_SIZE(1);
+    ASSERT_EVENTS_CONNECTED_SIZE(2);
+
+    std::vector<U8> frame = testPayload(100, 0xC0);
+    const std::vector<U8> expected(frame);
+    this->sendFrame(frame, 3);
+    ASSERT_EQ(this->readGround(expected.size()), expected);
+    ASSERT_TRUE(this->waitForDeallocated(4));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1, 2, 3}));
+    this->m_lock.unLock();
+  }
+
+  void IoUringTcpClientTester ::
+    testStop()
+  {
+    if (!this->startDriver()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(this->acceptGround(1));
+
+    std::vector<U8> frames[2] = {testPayload(BIG_FRAME_SIZE, 0xD0), testPayload(100, 0xE0)};
+    this->sendFrame(frames[0], 0);
+    ASSERT_TRUE(this->waitForGroundData());
+    this->sendFrame(frames[1], 1);
+
+    this->component.stop();
+    ASSERT_EQ(this->component.join(), Os::Task::TASK_OK);
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1}));
+    EXPECT_EQ(this->m_recvOutstanding, 0U);
+    this->m_lock.unLock();
+    ASSERT_EVENTS_DISCONNECTED_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer IoUringTcpClientTester ::
+    from_allocate_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    this->m_lock.lock();
+    ++this->m_allocateCalls;
+    const bool enabled = this->m_allocateEnabled;
+    if (enabled) {
+      ++this->m_recvOutstanding;
+    }
+    this->m_lock.unLock();
+    if (!enabled) {
+      return Fw::Buffer();
+    }
+    return Fw::Buffer(new U8[size], size, RECV_CONTEXT);
+  }
+
+  void IoUringTcpClientTester ::
+    from_deallocate_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_lock.lock();
+    if (fwBuffer.getContext() == RECV_CONTEXT) {
+      delete[] fwBuffer.getData();
+      --this->m_recvOutstanding;
+    } else {
+      this->m_deallocated.push_back(fwBuffer.getContext());
+    }
+    this->m_lock.unLock();
+  }
+
+  void IoUringTcpClientTester ::
+    from_ready_handler(NATIVE_INT_TYPE portNum)
+  {
+    this->m_lock.lock();
+    ++this->m_ready;
+    this->m_lock.unLock();
+  }
+
+  void IoUringTcpClientTester ::
+    from_recv_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    EXPECT_EQ(recvStatus, Drv::RecvStatus::RECV_OK);
+    this->m_lock.lock();
+    this->m_received.insert(this->m_received.end(), recvBuffer.getData(),
+                            recvBuffer.getData() + recvBuffer.getSize());
+    --this->m_recvOutstanding;
+    this->m_lock.unLock();
+    delete[] recvBuffer.getData();
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  bool IoUringTcpClientTester ::
+    startDriver()
+  {
+    this->m_listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_GE(this->m_listener, 0);
+    struct sockaddr_in address;
+    ::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    EXPECT_EQ(::bind(this->m_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+    EXPECT_EQ(::listen(this->m_listener, 1), 0);
+    EXPECT_EQ(::getsockname(this->m_listener, reinterpret_cast<struct sockaddr*>(&address), &length), 0);
+
+    this->component.configure("127.0.0.1", ntohs(address.sin_port));
+    this->component.start(Os::TaskString("UringTask"), Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+    return this->eventHistory_RING_SETUP_ERROR->size() == 0;
+  }
+
+  bool IoUringTcpClientTester ::
+    acceptGround(U32 readyCount)
+  {
+    struct pollfd pfd;
+    pfd.fd = this->m_listener;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, 2000) != 1) {
+      return false;
+    }
+    this->m_ground = ::accept(this->m_listener, nullptr, nullptr);
+    if (this->m_ground < 0) {
+      return false;
+    }
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool ready = (this->m_ready >= readyCount);
+      this->m_lock.unLock();
+      if (ready) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+  void IoUringTcpClientTester ::
+    closeGround()
+  {
+    this->component.stop();
+    (void) this->component.join();
+    if (this->m_ground >= 0) {
+      (void) ::close(this->m_ground);
+      this->m_ground = -1;
+    }
+    if (this->m_listener >= 0) {
+      (void) ::close(this->m_listener);
+      this->m_listener = -1;
+    }
+  }
+
+  void IoUringTcpClientTester ::
+    sendFrame(std::vector<U8>& frame, U32 index)
+  {
+    Fw::Buffer buffer(frame.data(), static_cast<U32>(frame.size()), index);
+    EXPECT_EQ(this->invoke_to_send(0, buffer), Drv::SendStatus::SEND_OK);
+  }
+
+  bool IoUringTcpClientTester ::
+    waitForGroundData()
+  {
+    struct pollfd pfd;
+    pfd.fd = this->m_ground;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return ::poll(&pfd, 1, 2000) == 1;
+  }
+
+  std::vector<U8> IoUringTcpClientTester ::
+    readGround(size_t count)
+  {
+    std::vector<U8> bytes;
+    U8 chunk[65536];
+    while (bytes.size() < count) {
+      if (!this->waitForGroundData()) {
+        break;
+      }
+      const ssize_t received = ::recv(this->m_ground, chunk, FW_MIN(sizeof(chunk), count - bytes.size()), 0);
+      if (received <= 0) {
+        break;
+      }
+      bytes.insert(bytes.end(), chunk, chunk + received);
+    }
+    return bytes;
+  }
+
+  void IoUringTcpClientTester ::
+    writeGround(const std::vector<U8>& bytes)
+  {
+    EXPECT_EQ(::send(this->m_ground, bytes.data(), bytes.size(), MSG_NOSIGNAL), static_cast<ssize_t>(bytes.size()));
+  }
+
+  bool IoUringTcpClientTester ::
+    waitForDeallocated(U32 count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool done = (this->m_deallocated.size() >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+  bool IoUringTcpClientTester ::
+    waitForReceived(size_t count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool done = (this->m_received.size() >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+}
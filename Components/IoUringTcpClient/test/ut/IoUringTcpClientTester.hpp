@@ -0,0 +1,184 @@
+// ======================================================================
+// \title  IoUringTcpClientTester.hpp
+// \author cindy
+// \brief  hpp file for IoUringTcpClient component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_IoUringTcpClientTester_HPP
+#define MathModule_IoUringTcpClientTester_HPP
+
+#include "IoUringTcpClientGTestBase.hpp"
+#include "Components/IoUringTcpClient/IoUringTcpClient.hpp"
+#include <Os/Mutex.hpp>
+
+#include <vector>
+
+namespace MathModule {
+
+  class IoUringTcpClientTester :
+    public IoUringTcpClientGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Context of the receive buffers handed out by allocate
+      static const U32 RECV_CONTEXT = 0xFFFF;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object IoUringTcpClientTester
+      IoUringTcpClientTester();
+
+      //! Destroy object IoUringTcpClientTester
+      ~IoUringTcpClientTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Frames arriving during a send in flight go out together in the next sendmsg
+      void testSendBatching();
+
+      //! A short send resumes where the kernel stopped, and the frame is held until it completes
+      void testShortSend();
+
+      //! With the buffer manager empty the driver retries, then fills every slot at once and refills them once all are used
+      void testReceiveRefill();
+
+      //! A lost connection returns the frames in flight and pending, then the driver reconnects
+      void testDisconnect();
+
+      //! stop completes the operations in flight and returns every frame and slot buffer before the task exits
+      void testStop();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for allocate
+      Fw::Buffer from_allocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for deallocate
+      void from_deallocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for ready
+      void from_ready_handler(
+          NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for recv
+      void from_recv_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Listen on an ephemeral loopback port and start the driver
+      //! \return false if io_uring is not available
+      bool startDriver();
+
+      //! Accept the driver's next connection and wait until it has reported ready the given number of times
+      //! \return false if the driver did not connect
+      bool acceptGround(U32 readyCount);
+
+      //! Stop the driver and close the ground sockets
+      void closeGround();
+
+      //! Hand a frame to the driver, tagged with its index
+      void sendFrame(std::vector<U8>& frame, U32 index);
+
+      //! Wait until the driver's bytes start arriving at the ground
+      bool waitForGroundData();
+
+      //! Read from the ground socket until the given number of bytes arrived or a timeout
+      std::vector<U8> readGround(size_t count);
+
+      //! Write to the ground socket
+      void writeGround(const std::vector<U8>& bytes);
+
+      //! Wait until the given number of frames were returned through deallocate
+      bool waitForDeallocated(U32 count);
+
+      //! Wait until the driver has passed up the given number of bytes
+      bool waitForReceived(size_t count);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      IoUringTcpClient component;
+
+      //! Listening socket
+      int m_listener;
+
+      //! Accepted ground socket
+      int m_ground;
+
+      //! Guards the state touched by the driver task
+      Os::Mutex m_lock;
+
+      //! Indexes of the frames returned through deallocate, in order
+      std::vector<U32> m_deallocated;
+
+      //! Bytes passed up by the driver
+      std::vector<U8> m_received;
+
+      //! Whether allocate hands out buffers
+      bool m_allocateEnabled;
+
+      //! Calls to allocate
+      U32 m_allocateCalls;
+
+      //! Receive buffers handed out and not yet passed up or returned
+      U32 m_recvOutstanding;
+
+      //! Calls to ready
+      U32 m_ready;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+// ======================================================================
+// \title  LoopbackComDriver.cpp
+// \author cindy
+// \brief  cpp file for LoopbackComDriver component implementation class
+// ======================================================================
+
+#include "Components/LoopbackComDriver/LoopbackComDriver.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cstring>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  LoopbackComDriver ::
+    LoopbackComDriver(const char* const compName) :
+      LoopbackComDriverComponentBase(compName),
+      m_listener(nullptr)
+  {
+    ::memset(&this->m_stats, 0, sizeof(this->m_stats));
+  }
+
+  LoopbackComDriver ::
+    ~LoopbackComDriver()
+  {
+
+  }
+
+  void LoopbackComDriver ::
+    setListener(Listener* listener)
+  {
+    this->m_listener = listener;
+  }
+
+  void LoopbackComDriver ::
+    connect()
+  {
+    this->ready_out(0);
+  }
+
+  /*
+    The bytes are passed up on the calling thread, as a driver's read task
+    would, so the caller feels any back pressure from the deframer.
+  */
+  bool LoopbackComDriver ::
+    inject(const U8* data, U32 size)
+  {
+    FW_ASSERT(data != nullptr);
+    Fw::Buffer buffer = this->allocate_out(0, size);
+    if ((buffer.getData() == nullptr) || (buffer.getSize() < size)) {
+      if (buffer.getData() != nullptr) {
+        this->deallocate_out(0, buffer);
+      }
+      this->m_lock.lock();
+      this->m_stats.injectRefused++;
+      this->m_lock.unLock();
+      return false;
+    }
+    ::memcpy(buffer.getData(), data, size);
+    buffer.setSize(size);
+    this->m_lock.lock();
+    this->m_stats.bytesInjected += size;
+    this->m_lock.unLock();
+    this->recv_out(0, buffer, Drv::RecvStatus::RECV_OK);
+    return true;
+  }
+
+  LoopbackComDriver::Stats LoopbackComDriver ::
+    getStats()
+  {
+    this->m_lock.lock();
+    const Stats stats = this->m_stats;
+    this->m_lock.unLock();
+    return stats;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  Drv::SendStatus LoopbackComDriver ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    if (this->m_listener != nullptr) {
+      this->m_listener->frameSent(fwBuffer.getData(), fwBuffer.getSize());
+    }
+    this->m_lock.lock();
+    this->m_stats.framesSent++;
+    this->m_stats.bytesSent += fwBuffer.getSize();
+    this->m_lock.unLock();
+    this->deallocate_out(0, fwBuffer);
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  Drv::SendStatus LoopbackComDriver ::
+    tlmSend_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    if (this->m_listener != nullptr) {
+      this->m_listener->tlmPacketSent(fwBuffer.getData(), fwBuffer.getSize());
+    }
+    this->m_lock.lock();
+    this->m_stats.tlmPacketsSent++;
+    this->m_lock.unLock();
+    this->deallocate_out(0, fwBuffer);
+    return Drv::SendStatus::SEND_OK;
+  }
+
+}
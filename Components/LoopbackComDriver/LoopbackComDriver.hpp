@@ -0,0 +1,121 @@
+// ======================================================================
+// \title  LoopbackComDriver.hpp
+// \author cindy
+// \brief  hpp file for LoopbackComDriver component implementation class
+// ======================================================================
+
+#ifndef MathModule_LoopbackComDriver_HPP
+#define MathModule_LoopbackComDriver_HPP
+
+#include "Components/LoopbackComDriver/LoopbackComDriverComponentAc.hpp"
+#include <Os/Mutex.hpp>
+
+namespace MathModule {
+
+  class LoopbackComDriver :
+    public LoopbackComDriverComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Receives what the deployment sends, on the sending thread. Calls are never concurrent.
+      class Listener {
+        public:
+          virtual ~Listener() {}
+
+          //! A buffer from comStub, framed
+          virtual void frameSent(
+              const U8* data, //!< The frame bytes, valid for the call only
+              U32 size //!< Number of bytes
+          ) = 0;
+
+          //! A compact telemetry packet from compactTlm
+          virtual void tlmPacketSent(
+              const U8* data, //!< The packet bytes, valid for the call only
+              U32 size //!< Number of bytes
+          ) = 0;
+      };
+
+      //! Traffic through the driver
+      struct Stats {
+        U64 framesSent; //!< Buffers sent by comStub
+        U64 bytesSent; //!< Bytes in those buffers
+        U64 tlmPacketsSent; //!< Compact telemetry packets
+        U64 bytesInjected; //!< Uplink bytes passed up
+        U32 injectRefused; //!< Injections refused for lack of a buffer
+      };
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct LoopbackComDriver object
+      LoopbackComDriver(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy LoopbackComDriver object
+      ~LoopbackComDriver();
+
+      //! Set the listener sent data goes to, before the driver is connected. Without one it is only counted.
+      void setListener(
+          Listener* listener //!< The listener, or nullptr
+      );
+
+      //! Report the link as up through the ready port
+      void connect();
+
+      //! Pass bytes up as if received, in one buffer from the allocate port
+      //! \return false if no buffer of that size was available; the bytes are dropped
+      bool inject(
+          const U8* data, //!< The bytes
+          U32 size //!< Number of bytes
+      );
+
+      //! Traffic so far
+      Stats getStats();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for tlmSend
+      Drv::SendStatus tlmSend_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The packet to send
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Where sent data goes, or nullptr
+      Listener* m_listener;
+
+      //! Guards the statistics
+      Os::Mutex m_lock;
+
+      //! Traffic so far
+      Stats m_stats;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+// ======================================================================
+// \title  LoopbackComDriverTestMain.cpp
+// \author cindy
+// \brief  cpp file for LoopbackComDriver component test main function
+// ======================================================================
+
+#include "LoopbackComDriverTester.hpp"
+
+TEST(Nominal, Uplink) {
+  MathModule::LoopbackComDriverTester tester;
+  tester.testUplink();
+}
+
+TEST(Nominal, Downlink) {
+  MathModule::LoopbackComDriverTester tester;
+  tester.testDownlink();
+}
+
+TEST(OffNominal, NoBuffer) {
+  MathModule::LoopbackComDriverTester tester;
+  tester.testNoBuffer();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+// ======================================================================
+// \title  LoopbackComDriverTester.cpp
+// \author cindy
+// \brief  cpp file for LoopbackComDriver component test harness implementation class
+// ======================================================================
+
+#include "LoopbackComDriverTester.hpp"
+
+namespace MathModule {
+
+  const U32 LoopbackComDriverTester::BUFFER_SIZE;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  LoopbackComDriverTester ::
+    LoopbackComDriverTester() :
+      LoopbackComDriverGTestBase("LoopbackComDriverTester", LoopbackComDriverTester::MAX_HISTORY_SIZE),
+      component("LoopbackComDriver"),
+      m_allocateSize(BUFFER_SIZE)
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.setListener(this);
+  }
+
+  LoopbackComDriverTester ::
+    ~LoopbackComDriverTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void LoopbackComDriverTester ::
+    testUplink()
+  {
+    this->component.connect();
+    ASSERT_from_ready_SIZE(1);
+
+    const U8 first[] = {0xDE, 0xAD, 0xBE, 0xEF, 1, 2, 3};
+    const U8 second[] = {4, 5};
+    EXPECT_TRUE(this->component.inject(first, sizeof(first)));
+    EXPECT_TRUE(this->component.inject(second, sizeof(second)));
+    ASSERT_EQ(this->m_received.size(), 2U);
+    EXPECT_EQ(this->m_received[0], std::vector<U8>(first, first + sizeof(first)));
+    EXPECT_EQ(this->m_received[1], std::vector<U8>(second, second + sizeof(second)));
+    ASSERT_from_deallocate_SIZE(0);
+
+    const LoopbackComDriver::Stats stats = this->component.getStats();
+    EXPECT_EQ(stats.bytesInjected, sizeof(first) + sizeof(second));
+    EXPECT_EQ(stats.injectRefused, 0U);
+  }
+
+  void LoopbackComDriverTester ::
+    testDownlink()
+  {
+    U8 frame[40];
+    U8 packet[12];
+    for (U32 i = 0; i < sizeof(frame); i++) {
+      frame[i] = static_cast<U8>(i);
+    }
+    for (U32 i = 0; i < sizeof(packet); i++) {
+      packet[i] = static_cast<U8>(0x80 + i);
+    }
+    Fw::Buffer frameBuffer(frame, sizeof(frame));
+    Fw::Buffer packetBuffer(packet, sizeof(packet));
+    Fw::Buffer secondFrame(frame, 8);
+    EXPECT_EQ(this->invoke_to_send(0, frameBuffer), Drv::SendStatus::SEND_OK);
+    EXPECT_EQ(this->invoke_to_tlmSend(0, packetBuffer), Drv::SendStatus::SEND_OK);
+    EXPECT_EQ(this->invoke_to_send(0, secondFrame), Drv::SendStatus::SEND_OK);
+
+    ASSERT_EQ(this->m_sent.size(), 3U);
+    EXPECT_EQ(this->m_sent[0], std::vector<U8>(frame, frame + sizeof(frame)));
+    std::vector<U8> tagged(1, 0xFF);
+    tagged.insert(tagged.end(), packet, packet + sizeof(packet));
+    EXPECT_EQ(this->m_sent[1], tagged);
+    EXPECT_EQ(this->m_sent[2], std::vector<U8>(frame, frame + 8));
+
+    // Each buffer goes back exactly once
+    ASSERT_from_deallocate_SIZE(3);
+    EXPECT_EQ(this->fromPortHistory_deallocate->at(0).fwBuffer.getData(), frame);
+    EXPECT_EQ(this->fromPortHistory_deallocate->at(1).fwBuffer.getData(), packet);
+
+    const LoopbackComDriver::Stats stats = this->component.getStats();
+    EXPECT_EQ(stats.framesSent, 2U);
+    EXPECT_EQ(stats.bytesSent, sizeof(frame) + 8);
+    EXPECT_EQ(stats.tlmPacketsSent, 1U);
+  }
+
+  void LoopbackComDriverTester ::
+    testNoBuffer()
+  {
+    const U8 data[BUFFER_SIZE + 1] = {};
+    this->m_allocateSize = 0;
+    EXPECT_FALSE(this->component.inject(data, 10));
+    ASSERT_from_deallocate_SIZE(0);
+
+    // A buffer smaller than asked for is returned
+    this->m_allocateSize = BUFFER_SIZE;
+    EXPECT_FALSE(this->component.inject(data, sizeof(data)));
+    ASSERT_from_deallocate_SIZE(1);
+    EXPECT_TRUE(this->m_received.empty());
+
+    const LoopbackComDriver::Stats stats = this->component.getStats();
+    EXPECT_EQ(stats.injectRefused, 2U);
+    EXPECT_EQ(stats.bytesInjected, 0U);
+  }
+
+  // ----------------------------------------------------------------------
+  // Listener
+  // ----------------------------------------------------------------------
+
+  void LoopbackComDriverTester ::
+    frameSent(const U8* data, U32 size)
+  {
+    this->m_sent.push_back(std::vector<U8>(data, data + size));
+  }
+
+  void LoopbackComDriverTester ::
+    tlmPacketSent(const U8* data, U32 size)
+  {
+    std::vector<U8> tagged(1, 0xFF);
+    tagged.insert(tagged.end(), data, data + size);
+    this->m_sent.push_back(tagged);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer LoopbackComDriverTester ::
+    from_allocate_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    if (this->m_allocateSize == 0) {
+      return Fw::Buffer();
+    }
+    return Fw::Buffer(this->m_storage, this->m_allocateSize);
+  }
+
+  void LoopbackComDriverTester ::
+    from_recv_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    EXPECT_EQ(recvStatus, Drv::RecvStatus::RECV_OK);
+    this->m_received.push_back(std::vector<U8>(recvBuffer.getData(), recvBuffer.getData() + recvBuffer.getSize()));
+  }
+
+}
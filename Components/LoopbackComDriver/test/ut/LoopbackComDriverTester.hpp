@@ -0,0 +1,133 @@
+// ======================================================================
+// \title  LoopbackComDriverTester.hpp
+// \author cindy
+// \brief  hpp file for LoopbackComDriver component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_LoopbackComDriverTester_HPP
+#define MathModule_LoopbackComDriverTester_HPP
+
+#include "LoopbackComDriverGTestBase.hpp"
+#include "Components/LoopbackComDriver/LoopbackComDriver.hpp"
+
+#include <vector>
+
+namespace MathModule {
+
+  class LoopbackComDriverTester :
+    public LoopbackComDriverGTestBase,
+    public LoopbackComDriver::Listener
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Size of the buffers handed out by allocate
+      static const U32 BUFFER_SIZE = 256;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object LoopbackComDriverTester
+      LoopbackComDriverTester();
+
+      //! Destroy object LoopbackComDriverTester
+      ~LoopbackComDriverTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Injected bytes are passed up whole, and connect reports ready
+      void testUplink();
+
+      //! Frames and telemetry packets reach the listener in order, and each buffer is returned
+      void testDownlink();
+
+      //! An injection that gets no buffer, or too small a one, is refused and counted
+      void testNoBuffer();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Listener
+      // ----------------------------------------------------------------------
+
+      void frameSent(const U8* data, U32 size) override;
+
+      void tlmPacketSent(const U8* data, U32 size) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for allocate
+      Fw::Buffer from_allocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for recv
+      void from_recv_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      LoopbackComDriver component;
+
+      //! Storage of the buffer handed out by allocate
+      U8 m_storage[BUFFER_SIZE];
+
+      //! Size of the buffer allocate hands out, 0 for none
+      U32 m_allocateSize;
+
+      //! Buffers passed up by the driver
+      std::vector<std::vector<U8> > m_received;
+
+      //! What the listener saw, in order; telemetry packets are tagged with a leading 0xFF
+      std::vector<std::vector<U8> > m_sent;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,329 @@
+// ======================================================================
+// \title  MathBench.cpp
+// \author cindy
+// \brief  Google Benchmark suite of the math components' hot paths
+//
+// Usage: math_bench [--benchmark_format=json] [--benchmark_out=<file>]
+//                   [--benchmark_context=commit=<sha>] [other Google Benchmark flags]
+//
+// Components are set up without tasks and driven on the benchmark thread
+// through their ports, as the unit tests drive them. Their event, text
+// event, telemetry, time and command response ports go to sinks that drop
+// what they receive, so each measurement includes the serialization of
+// what the deployment would send on. MathReceiver's parameter reads are
+// answered as having no stored value, so its parameters are at their defaults.
+//
+//   MathOpIn/<op>        One request through MathReceiver's mathOpIn port and queue, dispatched by schedIn
+//   BatchDiv/<mode>      MathKernels batch DIV of 1024 operands, precise or approximate with 0 to 3 refinement steps
+//   SchedInDrain/<depth> MathReceiver's schedIn draining <depth> queued requests, only the drain timed
+//   DoMath               DO_MATH through MathSender's cmdIn port and command queue
+//   RoundTrip            DO_MATH through MathSender's command queue, MathReceiver's queue and back through
+//                        MathSender's queue to mathResultIn
+// ======================================================================
+
+#include "Components/MathReceiver/MathKernels.hpp"
+#include "Components/MathReceiver/MathReceiver.hpp"
+#include "Components/MathSender/MathSender.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+namespace {
+
+  //! Deepest queue drained
+  const NATIVE_INT_TYPE MAX_DEPTH = 256;
+
+  //! Operands that stay finite whatever the operation
+  const F32 VAL1 = 7.25f;
+  const F32 VAL2 = 1.5f;
+
+  //! MathSender with its queue dispatched by the benchmark thread, which
+  //! stands in for the component's task
+  class BenchSender : public MathModule::MathSender {
+
+    public:
+
+      explicit BenchSender(const char* const compName) : MathModule::MathSender(compName)
+      {
+      }
+
+      void dispatch()
+      {
+        (void) this->doDispatch();
+      }
+
+      //! The autocoded opcodes are protected outside unit test builds
+      static FwOpcodeType doMathOpcode()
+      {
+        return OPCODE_DO_MATH;
+      }
+
+  };
+
+  //! Drops everything the components send on
+  class Sink : public Fw::PassiveComponentBase {
+
+    public:
+
+      Sink() : Fw::PassiveComponentBase("sink")
+      {
+        this->m_event.init();
+        this->m_event.addCallComp(this, event);
+#if FW_ENABLE_TEXT_LOGGING == 1
+        this->m_text.init();
+        this->m_text.addCallComp(this, text);
+#endif
+        this->m_tlm.init();
+        this->m_tlm.addCallComp(this, tlm);
+        this->m_time.init();
+        this->m_time.addCallComp(this, time);
+        this->m_response.init();
+        this->m_response.addCallComp(this, response);
+        this->m_op.init();
+        this->m_op.addCallComp(this, op);
+        this->m_result.init();
+        this->m_result.addCallComp(this, result);
+        this->m_prmGet.init();
+        this->m_prmGet.addCallComp(this, prmGet);
+      }
+
+      //! Connect the ports every component has
+      template <typename Component>
+      void connect(Component& component)
+      {
+        component.set_eventOut_OutputPort(0, &this->m_event);
+#if FW_ENABLE_TEXT_LOGGING == 1
+        component.set_textEventOut_OutputPort(0, &this->m_text);
+#endif
+        component.set_tlmOut_OutputPort(0, &this->m_tlm);
+        component.set_timeGetOut_OutputPort(0, &this->m_time);
+        component.set_cmdResponseOut_OutputPort(0, &this->m_response);
+      }
+
+      //! Connect the ports every component has, and MathReceiver's parameter reads.
+      //! loadParameters asserts that prmGetOut is connected.
+      void connect(MathModule::MathReceiver& component)
+      {
+        this->connect<MathModule::MathReceiver>(component);
+        component.set_prmGetOut_OutputPort(0, &this->m_prmGet);
+      }
+
+      MathModule::InputOpRequestPort* opIn()
+      {
+        return &this->m_op;
+      }
+
+      MathModule::InputMathResultPort* resultIn()
+      {
+        return &this->m_result;
+      }
+
+    private:
+
+      static void event(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, FwEventIdType, Fw::Time&,
+                        const Fw::LogSeverity&, Fw::LogBuffer& args)
+      {
+        benchmark::DoNotOptimize(args.getBuffAddr());
+      }
+
+#if FW_ENABLE_TEXT_LOGGING == 1
+      static void text(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, FwEventIdType, Fw::Time&,
+                       const Fw::LogSeverity&, Fw::TextLogString& text)
+      {
+        benchmark::DoNotOptimize(text.toChar());
+      }
+#endif
+
+      static void tlm(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, FwChanIdType, Fw::Time&, Fw::TlmBuffer& val)
+      {
+        benchmark::DoNotOptimize(val.getBuffAddr());
+      }
+
+      static void time(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, Fw::Time& time)
+      {
+        time.set(TB_NONE, 0, 0);
+      }
+
+      static void response(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, FwOpcodeType, U32,
+                           const Fw::CmdResponse& response)
+      {
+        benchmark::DoNotOptimize(response.e);
+      }
+
+      static void op(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, F32 val1, const MathModule::MathOp& op, F32 val2)
+      {
+        benchmark::DoNotOptimize(val1);
+        benchmark::DoNotOptimize(op.e);
+        benchmark::DoNotOptimize(val2);
+      }
+
+      static void result(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, F32 result)
+      {
+        benchmark::DoNotOptimize(result);
+      }
+
+      static Fw::ParamValid prmGet(Fw::PassiveComponentBase*, NATIVE_INT_TYPE, FwPrmIdType, Fw::ParamBuffer&)
+      {
+        return Fw::ParamValid::DEFAULT;
+      }
+
+      Fw::InputLogPort m_event;
+#if FW_ENABLE_TEXT_LOGGING == 1
+      Fw::InputLogTextPort m_text;
+#endif
+      Fw::InputTlmPort m_tlm;
+      Fw::InputTimePort m_time;
+      Fw::InputCmdResponsePort m_response;
+      MathModule::InputOpRequestPort m_op;
+      MathModule::InputMathResultPort m_result;
+      Fw::InputPrmGetPort m_prmGet;
+
+  };
+
+  //! A receiver with FACTOR at its default and its results dropped
+  struct Receiver {
+    explicit Receiver(NATIVE_INT_TYPE depth) : component("mathReceiver")
+    {
+      this->component.init(depth, 0);
+      this->sink.connect(this->component);
+      this->component.set_mathResultOut_OutputPort(0, this->sink.resultIn());
+      this->component.loadParameters();
+    }
+
+    Sink sink;
+    MathModule::MathReceiver component;
+  };
+
+  void MathOpIn(benchmark::State& state, MathModule::MathOp::T op)
+  {
+    Receiver receiver(1);
+    MathModule::InputOpRequestPort* const opIn = receiver.component.get_mathOpIn_InputPort(0);
+    Svc::InputSchedPort* const schedIn = receiver.component.get_schedIn_InputPort(0);
+    for (auto _ : state) {
+      opIn->invoke(VAL1, op, VAL2);
+      schedIn->invoke(0);
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK_CAPTURE(MathOpIn, ADD, MathModule::MathOp::ADD);
+  BENCHMARK_CAPTURE(MathOpIn, SUB, MathModule::MathOp::SUB);
+  BENCHMARK_CAPTURE(MathOpIn, MUL, MathModule::MathOp::MUL);
+  BENCHMARK_CAPTURE(MathOpIn, DIV, MathModule::MathOp::DIV);
+
+  void BatchDiv(benchmark::State& state, MathModule::DivMode::T mode, U8 steps)
+  {
+    const U32 count = 1024;
+    const MathModule::MathSettings settings(1.0f, mode, steps);
+    std::vector<F32> val1(count);
+    std::vector<F32> val2(count);
+    std::vector<F32> result(count);
+    for (U32 i = 0; i < count; i++) {
+      val1[i] = VAL1 + static_cast<F32>(i);
+      val2[i] = VAL2 + static_cast<F32>(i) / 8.0f;
+    }
+    for (auto _ : state) {
+      MathModule::MathKernels::apply(MathModule::MathOp::DIV, val1.data(), val2.data(), settings, result.data(), count);
+      benchmark::DoNotOptimize(result.data());
+      benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  }
+  BENCHMARK_CAPTURE(BatchDiv, precise, MathModule::DivMode::PRECISE, 0);
+  BENCHMARK_CAPTURE(BatchDiv, approximate0, MathModule::DivMode::APPROXIMATE, 0);
+  BENCHMARK_CAPTURE(BatchDiv, approximate1, MathModule::DivMode::APPROXIMATE, 1);
+  BENCHMARK_CAPTURE(BatchDiv, approximate2, MathModule::DivMode::APPROXIMATE, 2);
+  BENCHMARK_CAPTURE(BatchDiv, approximate3, MathModule::DivMode::APPROXIMATE, 3);
+
+  /*
+    Filling the queue is not timed: the iteration time is the schedIn call
+    alone, so per item it is the dispatch cost with the queue at that depth.
+  */
+  void SchedInDrain(benchmark::State& state)
+  {
+    const NATIVE_INT_TYPE depth = static_cast<NATIVE_INT_TYPE>(state.range(0));
+    Receiver receiver(MAX_DEPTH);
+    MathModule::InputOpRequestPort* const opIn = receiver.component.get_mathOpIn_InputPort(0);
+    Svc::InputSchedPort* const schedIn = receiver.component.get_schedIn_InputPort(0);
+    for (auto _ : state) {
+      for (NATIVE_INT_TYPE i = 0; i < depth; i++) {
+        opIn->invoke(VAL1, static_cast<MathModule::MathOp::T>(i % MathModule::MathOp::NUM_CONSTANTS), VAL2);
+      }
+      const auto start = std::chrono::steady_clock::now();
+      schedIn->invoke(0);
+      state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+  }
+  BENCHMARK(SchedInDrain)->ArgName("depth")->RangeMultiplier(4)->Range(1, MAX_DEPTH)->UseManualTime();
+
+  //! DO_MATH arguments as the command dispatcher passes them on
+  Fw::CmdArgBuffer doMathArgs(MathModule::MathOp::T op)
+  {
+    Fw::CmdArgBuffer args;
+    Fw::SerializeStatus status = args.serialize(VAL1);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = args.serialize(MathModule::MathOp(op));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = args.serialize(VAL2);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    return args;
+  }
+
+  void DoMath(benchmark::State& state)
+  {
+    Sink sink;
+    BenchSender sender("mathSender");
+    sender.init(1, 0);
+    sink.connect(sender);
+    sender.set_mathOpOut_OutputPort(0, sink.opIn());
+    Fw::CmdArgBuffer args = doMathArgs(MathModule::MathOp::MUL);
+    const FwOpcodeType opCode = sender.getIdBase() + BenchSender::doMathOpcode();
+    Fw::InputCmdPort* const cmdIn = sender.get_cmdIn_InputPort(0);
+    U32 cmdSeq = 0;
+    for (auto _ : state) {
+      cmdIn->invoke(opCode, cmdSeq++, args);
+      sender.dispatch();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(DoMath);
+
+  /*
+    Each step the deployment's threads would take runs here in turn: the
+    command is queued on MathSender's port and dispatched, the request
+    drained from MathReceiver's queue by schedIn, and the result dispatched
+    from MathSender's queue.
+  */
+  void RoundTrip(benchmark::State& state)
+  {
+    Sink sink;
+    BenchSender sender("mathSender");
+    sender.init(2, 0);
+    sink.connect(sender);
+    MathModule::MathReceiver receiver("mathReceiver");
+    receiver.init(1, 0);
+    sink.connect(receiver);
+    sender.set_mathOpOut_OutputPort(0, receiver.get_mathOpIn_InputPort(0));
+    receiver.set_mathResultOut_OutputPort(0, sender.get_mathResultIn_InputPort(0));
+    receiver.loadParameters();
+
+    Fw::CmdArgBuffer args = doMathArgs(MathModule::MathOp::DIV);
+    const FwOpcodeType opCode = sender.getIdBase() + BenchSender::doMathOpcode();
+    Fw::InputCmdPort* const cmdIn = sender.get_cmdIn_InputPort(0);
+    Svc::InputSchedPort* const schedIn = receiver.get_schedIn_InputPort(0);
+    U32 cmdSeq = 0;
+    for (auto _ : state) {
+      cmdIn->invoke(opCode, cmdSeq++, args);
+      sender.dispatch();
+      schedIn->invoke(0);
+      sender.dispatch();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+  BENCHMARK(RoundTrip);
+
+}
+
+BENCHMARK_MAIN();
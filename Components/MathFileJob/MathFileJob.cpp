@@ -0,0 +1,299 @@
+// ======================================================================
+// \title  MathFileJob.cpp
+// \author cindy
+// \brief  cpp file for MathFileJob component implementation class
+// ======================================================================
+
+#include "Components/MathFileJob/MathFileJob.hpp"
+#include "Components/MathReceiver/MathKernels.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 MathFileJob::INPUT_MAGIC;
+  const U32 MathFileJob::OUTPUT_MAGIC;
+  const U32 MathFileJob::INPUT_HEADER_SIZE;
+  const U32 MathFileJob::INPUT_RECORD_SIZE;
+  const U32 MathFileJob::OUTPUT_HEADER_SIZE;
+  const U32 MathFileJob::OUTPUT_RECORD_SIZE;
+  const U32 MathFileJob::BATCH_SIZE;
+  const U32 MathFileJob::WRITE_BUFFER_SIZE;
+  const U32 MathFileJob::PROGRESS_RECORDS;
+  const U32 MathFileJob::FILE_NAME_SIZE;
+
+  namespace {
+
+    U32 readU32(const U8* src) {
+      return (static_cast<U32>(src[0]) << 24) | (static_cast<U32>(src[1]) << 16) |
+             (static_cast<U32>(src[2]) << 8) | static_cast<U32>(src[3]);
+    }
+
+    void writeU32(U8* dst, U32 val) {
+      dst[0] = static_cast<U8>(val >> 24);
+      dst[1] = static_cast<U8>(val >> 16);
+      dst[2] = static_cast<U8>(val >> 8);
+      dst[3] = static_cast<U8>(val);
+    }
+
+    F32 toF32(U32 bits) {
+      F32 val;
+      memcpy(&val, &bits, sizeof(val));
+      return val;
+    }
+
+    U32 toBits(F32 val) {
+      U32 bits;
+      memcpy(&bits, &val, sizeof(bits));
+      return bits;
+    }
+
+    //! Write all the bytes
+    //! \return 0, or the errno value of the failed write
+    I32 writeAll(int fd, const U8* data, size_t size)
+    {
+      while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          return errno;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+      }
+      return 0;
+    }
+
+    F32 recordsPerSec(U32 records, U64 usec) {
+      return (usec > 0) ? static_cast<F32>(static_cast<F64>(records) * 1.0e6 / static_cast<F64>(usec)) : 0.0f;
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathFileJob ::
+    MathFileJob(const char* const compName) :
+      MathFileJobComponentBase(compName),
+      m_jobs(0)
+  {
+
+  }
+
+  MathFileJob ::
+    ~MathFileJob()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  /*
+    The operand file is mapped read-only and walked once, front to back, so
+    the page cache reads it ahead and a job of any size uses the same
+    memory. The settings are read once, at the start, so every result of a
+    job uses the same factor and division mode. The job runs on this
+    component's thread; the command completes when the result file is
+    queued for downlink.
+  */
+  void MathFileJob ::
+    RUN_MATH_FILE_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& inputFile,
+        const Fw::CmdStringArg& outputFile
+    )
+  {
+    const int in = ::open(inputFile.toChar(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+      this->log_WARNING_HI_JOB_INPUT_ERROR(errno);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    struct stat info;
+    if (::fstat(in, &info) != 0) {
+      this->log_WARNING_HI_JOB_INPUT_ERROR(errno);
+      (void) ::close(in);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    const U64 size = static_cast<U64>(info.st_size);
+    if ((size < INPUT_HEADER_SIZE) || ((size - INPUT_HEADER_SIZE) % INPUT_RECORD_SIZE != 0) ||
+        ((size - INPUT_HEADER_SIZE) / INPUT_RECORD_SIZE > 0xFFFFFFFFU)) {
+      this->log_WARNING_HI_JOB_INPUT_INVALID(size);
+      (void) ::close(in);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    void* const map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, in, 0);
+    const I32 mapError = (map == MAP_FAILED) ? errno : 0;
+    (void) ::close(in);
+    if (mapError != 0) {
+      this->log_WARNING_HI_JOB_INPUT_ERROR(mapError);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    (void) ::madvise(map, size, MADV_SEQUENTIAL);
+    const U8* const data = static_cast<const U8*>(map);
+    if (readU32(data) != INPUT_MAGIC) {
+      (void) ::munmap(map, size);
+      this->log_WARNING_HI_JOB_INPUT_INVALID(size);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    const U32 count = static_cast<U32>((size - INPUT_HEADER_SIZE) / INPUT_RECORD_SIZE);
+
+    const MathSettings settings = this->isConnected_settingsGet_OutputPort(0) ?
+        this->settingsGet_out(0) : MathSettings(1.0f, DivMode::PRECISE, MathKernels::MAX_DIV_REFINE_STEPS);
+    Fw::LogStringArg inputArg(inputFile.toChar());
+    this->log_ACTIVITY_HI_JOB_STARTED(count, settings.getfactor(), settings.getdivMode(), inputArg);
+    this->tlmWrite_RECORDS_TOTAL(count);
+    this->tlmWrite_RECORDS_DONE(0);
+
+    const int out = ::open(outputFile.toChar(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+      this->log_WARNING_HI_JOB_OUTPUT_ERROR(errno);
+      (void) ::munmap(map, size);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    const U64 start = nowUsec();
+    U32 badRecord = 0;
+    I32 error = 0;
+    JobStatus status = this->runJob(data + INPUT_HEADER_SIZE, count, settings, out, badRecord, error);
+    if ((::close(out) != 0) && (status == JOB_OK)) {
+      error = errno;
+      status = JOB_WRITE_FAILED;
+    }
+    const U64 usec = nowUsec() - start;
+    const U64 badOffset = INPUT_HEADER_SIZE + static_cast<U64>(badRecord) * INPUT_RECORD_SIZE;
+    const U8 badOp = (status == JOB_BAD_OP) ? data[badOffset] : 0;
+    (void) ::munmap(map, size);
+
+    if (status != JOB_OK) {
+      // A partial result file is not left to be mistaken for a finished one
+      (void) ::unlink(outputFile.toChar());
+      if (status == JOB_BAD_OP) {
+        this->log_WARNING_HI_JOB_BAD_OP(badRecord, badOp);
+      } else {
+        this->log_WARNING_HI_JOB_OUTPUT_ERROR(error);
+      }
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    this->tlmWrite_RECORDS_DONE(count);
+    this->tlmWrite_RECORDS_PER_SEC(recordsPerSec(count, usec));
+
+    const Svc::SendFileResponse response = this->sendFile_out(0, outputFile, outputFile, 0, 0);
+    if (response.getstatus() != Svc::SendFileStatus::STATUS_OK) {
+      this->log_WARNING_HI_JOB_DOWNLINK_REJECTED(response.getstatus());
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    ++this->m_jobs;
+    this->tlmWrite_JOBS_COMPLETED(this->m_jobs);
+    Fw::LogStringArg outputArg(outputFile.toChar());
+    this->log_ACTIVITY_HI_JOB_COMPLETED(count, static_cast<U32>(FW_MIN(usec, static_cast<U64>(0xFFFFFFFF))),
+                                        outputArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  MathFileJob::JobStatus MathFileJob ::
+    runJob(const U8* records, U32 count, const MathSettings& settings, int fd, U32& badRecord, I32& error)
+  {
+    writeU32(this->m_writeBuffer, OUTPUT_MAGIC);
+    writeU32(this->m_writeBuffer + sizeof(U32), count);
+    U32 used = OUTPUT_HEADER_SIZE;
+
+    const U64 start = nowUsec();
+    U32 done = 0;
+    while (done < count) {
+      const U32 batch = FW_MIN(BATCH_SIZE, count - done);
+      if (used + batch * OUTPUT_RECORD_SIZE > WRITE_BUFFER_SIZE) {
+        error = writeAll(fd, this->m_writeBuffer, used);
+        if (error != 0) {
+          return JOB_WRITE_FAILED;
+        }
+        used = 0;
+      }
+      U32 bad = 0;
+      if (!this->computeBatch(records + static_cast<U64>(done) * INPUT_RECORD_SIZE, batch, settings,
+                              this->m_writeBuffer + used, bad)) {
+        badRecord = done + bad;
+        return JOB_BAD_OP;
+      }
+      used += batch * OUTPUT_RECORD_SIZE;
+      done += batch;
+      if ((done % PROGRESS_RECORDS) == 0) {
+        this->tlmWrite_RECORDS_DONE(done);
+        this->tlmWrite_RECORDS_PER_SEC(recordsPerSec(done, nowUsec() - start));
+      }
+    }
+    error = writeAll(fd, this->m_writeBuffer, used);
+    return (error == 0) ? JOB_OK : JOB_WRITE_FAILED;
+  }
+
+  /*
+    The records of a batch are sorted into one lane per operation so that
+    each kernel call is a run of one operation, then the results are
+    scattered back into record order.
+  */
+  bool MathFileJob ::
+    computeBatch(const U8* records, U32 count, const MathSettings& settings, U8* out, U32& badRecord)
+  {
+    FW_ASSERT(count <= BATCH_SIZE, count);
+    for (U32 op = 0; op < MathOp::NUM_CONSTANTS; op++) {
+      this->m_lanes[op].count = 0;
+    }
+    for (U32 i = 0; i < count; i++) {
+      const U8* const record = records + i * INPUT_RECORD_SIZE;
+      const U8 op = record[0];
+      if (op >= MathOp::NUM_CONSTANTS) {
+        badRecord = i;
+        return false;
+      }
+      Lane& lane = this->m_lanes[op];
+      const U32 slot = lane.count++;
+      lane.index[slot] = i;
+      lane.val1[slot] = toF32(readU32(record + sizeof(U8)));
+      lane.val2[slot] = toF32(readU32(record + sizeof(U8) + sizeof(U32)));
+    }
+    for (U32 op = 0; op < MathOp::NUM_CONSTANTS; op++) {
+      Lane& lane = this->m_lanes[op];
+      if (lane.count == 0) {
+        continue;
+      }
+      MathKernels::apply(static_cast<MathOp::T>(op), lane.val1, lane.val2, settings, lane.result, lane.count);
+      for (U32 slot = 0; slot < lane.count; slot++) {
+        writeU32(out + lane.index[slot] * OUTPUT_RECORD_SIZE, toBits(lane.result[slot]));
+      }
+    }
+    return true;
+  }
+
+  U64 MathFileJob ::
+    nowUsec()
+  {
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<U64>(now.tv_sec) * 1000000U + static_cast<U64>(now.tv_nsec) / 1000U;
+  }
+
+}
@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  MathFileJob.hpp
+// \author cindy
+// \brief  hpp file for MathFileJob component implementation class
+// ======================================================================
+
+#ifndef MathModule_MathFileJob_HPP
+#define MathModule_MathFileJob_HPP
+
+#include "Components/MathFileJob/MathFileJobComponentAc.hpp"
+
+namespace MathModule {
+
+  class MathFileJob :
+    public MathFileJobComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! First word of an operand file, "MJI1"
+      static const U32 INPUT_MAGIC = 0x4D4A4931;
+
+      //! First word of a result file, "MJO1"
+      static const U32 OUTPUT_MAGIC = 0x4D4A4F31;
+
+      //! Operand file header: magic
+      static const U32 INPUT_HEADER_SIZE = sizeof(U32);
+
+      //! Operand record: MathOp value, then the two operands as big endian F32 bits
+      static const U32 INPUT_RECORD_SIZE = sizeof(U8) + 2 * sizeof(U32);
+
+      //! Result file header: magic, record count
+      static const U32 OUTPUT_HEADER_SIZE = 2 * sizeof(U32);
+
+      //! Result record: the result as big endian F32 bits
+      static const U32 OUTPUT_RECORD_SIZE = sizeof(U32);
+
+      //! Records decoded and computed together
+      static const U32 BATCH_SIZE = 1024;
+
+      //! Bytes of results collected before each write of the result file
+      static const U32 WRITE_BUFFER_SIZE = 256 * 1024;
+
+      //! Records computed between progress telemetry updates
+      static const U32 PROGRESS_RECORDS = 256 * 1024;
+
+      //! Longest file name, the size of the command and event arguments
+      static const U32 FILE_NAME_SIZE = 80;
+
+      static_assert(OUTPUT_HEADER_SIZE + BATCH_SIZE * OUTPUT_RECORD_SIZE <= WRITE_BUFFER_SIZE,
+                    "the header and a batch of results must fit the write buffer");
+
+      static_assert(PROGRESS_RECORDS % BATCH_SIZE == 0, "progress is reported between batches");
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct MathFileJob object
+      MathFileJob(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy MathFileJob object
+      ~MathFileJob();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command RUN_MATH_FILE
+      //!
+      //! Compute every record of an operand file, write the results to a file and downlink it
+      void RUN_MATH_FILE_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq, //!< The command sequence number
+          const Fw::CmdStringArg& inputFile, //!< The operand file
+          const Fw::CmdStringArg& outputFile //!< The result file to write
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! The records of a batch with one operation, gathered for the kernel
+      struct Lane {
+        U32 count; //!< Records in the lane
+        U32 index[BATCH_SIZE]; //!< Position of each record in the batch
+        F32 val1[BATCH_SIZE]; //!< First operands
+        F32 val2[BATCH_SIZE]; //!< Second operands
+        F32 result[BATCH_SIZE]; //!< Results from the kernel
+      };
+
+      //! Outcome of a job
+      enum JobStatus {
+        JOB_OK, //!< Every record computed and the result file written
+        JOB_BAD_OP, //!< A record's operation is not a MathOp
+        JOB_WRITE_FAILED //!< The result file could not be written
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Compute the mapped records and write the result file
+      //! \return the outcome; badRecord or error is set on failure
+      JobStatus runJob(
+          const U8* records, //!< The records after the operand file header
+          U32 count, //!< Number of records
+          const MathSettings& settings, //!< The factor and division mode
+          int fd, //!< The result file, positioned at its start
+          U32& badRecord, //!< Set to the record with a bad operation
+          I32& error //!< Set to the errno value of a failed write
+      );
+
+      //! Decode, compute and encode one batch of records into the write buffer
+      //! \return false if a record's operation is not a MathOp, with badRecord set to its index in the batch
+      bool computeBatch(
+          const U8* records, //!< The first record of the batch
+          U32 count, //!< Records in the batch, at most BATCH_SIZE
+          const MathSettings& settings, //!< The factor and division mode
+          U8* out, //!< Where the results are encoded
+          U32& badRecord //!< Set to the record with a bad operation
+      );
+
+      //! Monotonic clock in microseconds
+      static U64 nowUsec();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Per operation batches, indexed by MathOp value
+      Lane m_lanes[MathOp::NUM_CONSTANTS];
+
+      //! Results collected for the next write
+      U8 m_writeBuffer[WRITE_BUFFER_SIZE];
+
+      //! Jobs completed
+      U32 m_jobs;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+// ======================================================================
+// \title  MathFileJobTestMain.cpp
+// \author cindy
+// \brief  cpp file for MathFileJob component test main function
+// ======================================================================
+
+#include "MathFileJobTester.hpp"
+
+TEST(Nominal, Job) {
+  MathModule::MathFileJobTester tester;
+  tester.testNominal();
+}
+
+TEST(Nominal, Empty) {
+  MathModule::MathFileJobTester tester;
+  tester.testEmpty();
+}
+
+TEST(Nominal, ApproximateDiv) {
+  MathModule::MathFileJobTester tester;
+  tester.testApproximateDiv();
+}
+
+TEST(OffNominal, InputRejected) {
+  MathModule::MathFileJobTester tester;
+  tester.testInputRejected();
+}
+
+TEST(OffNominal, BadOp) {
+  MathModule::MathFileJobTester tester;
+  tester.testBadOp();
+}
+
+TEST(OffNominal, DownlinkRejected) {
+  MathModule::MathFileJobTester tester;
+  tester.testDownlinkRejected();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
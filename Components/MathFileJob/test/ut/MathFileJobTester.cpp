@@ -0,0 +1,336 @@
+// ======================================================================
+// \title  MathFileJobTester.cpp
+// \author cindy
+// \brief  cpp file for MathFileJob component test harness implementation class
+// ======================================================================
+
+#include "MathFileJobTester.hpp"
+#include "Components/MathReceiver/MathKernels.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace MathModule {
+
+  constexpr F32 MathFileJobTester::FACTOR;
+
+  namespace {
+
+    void appendU32(std::vector<U8>& out, U32 val)
+    {
+      for (U32 b = 0; b < sizeof(U32); b++) {
+        out.push_back(static_cast<U8>(val >> (8 * (sizeof(U32) - 1 - b))));
+      }
+    }
+
+    U32 readU32(const U8* src)
+    {
+      return (static_cast<U32>(src[0]) << 24) | (static_cast<U32>(src[1]) << 16) |
+             (static_cast<U32>(src[2]) << 8) | static_cast<U32>(src[3]);
+    }
+
+    U32 toBits(F32 val)
+    {
+      U32 bits;
+      memcpy(&bits, &val, sizeof(bits));
+      return bits;
+    }
+
+    //! The result as MathReceiver computes it, written out rather than through MathKernels
+    F32 expected(const MathFileJobTester::Record& record)
+    {
+      F32 res = 0.0f;
+      switch (record.op) {
+        case MathOp::ADD:
+          res = record.val1 + record.val2;
+          break;
+        case MathOp::SUB:
+          res = record.val1 - record.val2;
+          break;
+        case MathOp::MUL:
+          res = record.val1 * record.val2;
+          break;
+        case MathOp::DIV:
+          res = record.val1 / record.val2;
+          break;
+        default:
+          EXPECT_TRUE(false) << static_cast<U32>(record.op);
+          break;
+      }
+      return res * MathFileJobTester::FACTOR;
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathFileJobTester ::
+    MathFileJobTester() :
+      MathFileJobGTestBase("MathFileJobTester", MathFileJobTester::MAX_HISTORY_SIZE),
+      component("MathFileJob"),
+      m_settings(FACTOR, DivMode::PRECISE, MathKernels::MAX_DIV_REFINE_STEPS),
+      m_sendStatus(Svc::SendFileStatus::STATUS_OK)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/MathFileJobTester.%d.in", static_cast<int>(::getpid()));
+    this->m_input = path;
+    (void) ::snprintf(path, sizeof(path), "/tmp/MathFileJobTester.%d.out", static_cast<int>(::getpid()));
+    this->m_output = path;
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  MathFileJobTester ::
+    ~MathFileJobTester()
+  {
+    (void) ::unlink(this->m_input.c_str());
+    (void) ::unlink(this->m_output.c_str());
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MathFileJobTester ::
+    testNominal()
+  {
+    // Enough records for a progress update and a partial last batch
+    const U32 count = MathFileJob::PROGRESS_RECORDS + MathFileJob::BATCH_SIZE + 17;
+    const std::vector<Record> records = testRecords(count);
+    this->writeInput(records);
+    this->run();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_JOB_STARTED_SIZE(1);
+    ASSERT_EVENTS_JOB_STARTED(0, count, FACTOR, DivMode::PRECISE, this->m_input.c_str());
+    ASSERT_EVENTS_JOB_COMPLETED_SIZE(1);
+    ASSERT_EQ(this->eventHistory_JOB_COMPLETED->at(0).records, count);
+    ASSERT_TLM_RECORDS_TOTAL(0, count);
+    ASSERT_TLM_RECORDS_DONE_SIZE(3);
+    ASSERT_TLM_RECORDS_DONE(0, 0);
+    ASSERT_TLM_RECORDS_DONE(1, MathFileJob::PROGRESS_RECORDS);
+    ASSERT_TLM_RECORDS_DONE(2, count);
+    ASSERT_TLM_RECORDS_PER_SEC_SIZE(2);
+    ASSERT_TLM_JOBS_COMPLETED(0, 1);
+    ASSERT_EQ(this->m_sentFiles.size(), 1U);
+    EXPECT_EQ(this->m_sentFiles[0], this->m_output);
+
+    const std::vector<U8> output = this->readOutput();
+    ASSERT_EQ(output.size(), MathFileJob::OUTPUT_HEADER_SIZE + count * MathFileJob::OUTPUT_RECORD_SIZE);
+    EXPECT_EQ(readU32(output.data()), MathFileJob::OUTPUT_MAGIC);
+    EXPECT_EQ(readU32(output.data() + sizeof(U32)), count);
+    for (U32 i = 0; i < count; i++) {
+      const U32 bits = readU32(output.data() + MathFileJob::OUTPUT_HEADER_SIZE + i * MathFileJob::OUTPUT_RECORD_SIZE);
+      ASSERT_EQ(bits, toBits(expected(records[i]))) << "record " << i;
+    }
+
+    // A second job counts as another completed one
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::OK);
+    ASSERT_TLM_JOBS_COMPLETED(0, 2);
+  }
+
+  void MathFileJobTester ::
+    testEmpty()
+  {
+    this->writeInput(std::vector<Record>());
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_JOB_STARTED(0, 0, FACTOR, DivMode::PRECISE, this->m_input.c_str());
+    ASSERT_TLM_RECORDS_DONE(0, 0);
+    const std::vector<U8> output = this->readOutput();
+    ASSERT_EQ(output.size(), MathFileJob::OUTPUT_HEADER_SIZE);
+    EXPECT_EQ(readU32(output.data()), MathFileJob::OUTPUT_MAGIC);
+    EXPECT_EQ(readU32(output.data() + sizeof(U32)), 0U);
+    EXPECT_EQ(this->m_sentFiles.size(), 1U);
+  }
+
+  void MathFileJobTester ::
+    testApproximateDiv()
+  {
+    // No refinement, so approximate quotients differ from precise ones
+    this->m_settings = MathSettings(FACTOR, DivMode::APPROXIMATE, 0);
+    const U32 count = 3 * MathFileJob::BATCH_SIZE;
+    const std::vector<Record> records = testRecords(count);
+    this->writeInput(records);
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_JOB_STARTED(0, count, FACTOR, DivMode::APPROXIMATE, this->m_input.c_str());
+
+    const std::vector<U8> output = this->readOutput();
+    ASSERT_EQ(output.size(), MathFileJob::OUTPUT_HEADER_SIZE + count * MathFileJob::OUTPUT_RECORD_SIZE);
+    U32 approximated = 0;
+    for (U32 i = 0; i < count; i++) {
+      const Record& record = records[i];
+      const U32 bits = readU32(output.data() + MathFileJob::OUTPUT_HEADER_SIZE + i * MathFileJob::OUTPUT_RECORD_SIZE);
+      const F32 single = MathKernels::apply(static_cast<MathOp::T>(record.op), record.val1, record.val2,
+                                            this->m_settings);
+      ASSERT_EQ(bits, toBits(single)) << "record " << i;
+      if (record.op != MathOp::DIV) {
+        ASSERT_EQ(bits, toBits(expected(record))) << "record " << i;
+      } else if (bits != toBits(expected(record))) {
+        approximated++;
+      }
+    }
+    EXPECT_GT(approximated, 0U);
+  }
+
+  void MathFileJobTester ::
+    testInputRejected()
+  {
+    // Missing
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_JOB_INPUT_ERROR_SIZE(1);
+    ASSERT_EVENTS_JOB_INPUT_ERROR(0, ENOENT);
+
+    // Shorter than the header
+    this->writeInput(std::vector<U8>(2, 0x4D));
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_JOB_INPUT_INVALID(0, 2);
+
+    // A partial record
+    std::vector<U8> bytes;
+    appendU32(bytes, MathFileJob::INPUT_MAGIC);
+    bytes.resize(MathFileJob::INPUT_HEADER_SIZE + 3 * MathFileJob::INPUT_RECORD_SIZE + 1, 0);
+    this->writeInput(bytes);
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_JOB_INPUT_INVALID(0, bytes.size());
+
+    // Not an operand file
+    bytes.resize(MathFileJob::INPUT_HEADER_SIZE + 3 * MathFileJob::INPUT_RECORD_SIZE);
+    bytes[0] = 'X';
+    this->writeInput(bytes);
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_JOB_INPUT_INVALID(0, bytes.size());
+
+    ASSERT_EVENTS_JOB_STARTED_SIZE(0);
+    EXPECT_TRUE(this->m_sentFiles.empty());
+    EXPECT_NE(::access(this->m_output.c_str(), F_OK), 0);
+  }
+
+  void MathFileJobTester ::
+    testBadOp()
+  {
+    // The bad record is in the second batch, after a batch has been computed
+    std::vector<Record> records = testRecords(2 * MathFileJob::BATCH_SIZE);
+    const U32 bad = MathFileJob::BATCH_SIZE + 300;
+    records[bad].op = MathOp::NUM_CONSTANTS;
+    this->writeInput(records);
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_JOB_BAD_OP_SIZE(1);
+    ASSERT_EVENTS_JOB_BAD_OP(0, bad, MathOp::NUM_CONSTANTS);
+    ASSERT_EVENTS_JOB_COMPLETED_SIZE(0);
+    EXPECT_TRUE(this->m_sentFiles.empty());
+    EXPECT_NE(::access(this->m_output.c_str(), F_OK), 0);
+  }
+
+  void MathFileJobTester ::
+    testDownlinkRejected()
+  {
+    this->writeInput(testRecords(10));
+    this->m_sendStatus = Svc::SendFileStatus::STATUS_BUSY;
+    this->run();
+    ASSERT_CMD_RESPONSE(0, MathFileJob::OPCODE_RUN_MATH_FILE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_JOB_DOWNLINK_REJECTED_SIZE(1);
+    ASSERT_EVENTS_JOB_DOWNLINK_REJECTED(0, Svc::SendFileStatus::STATUS_BUSY);
+    ASSERT_EVENTS_JOB_COMPLETED_SIZE(0);
+    ASSERT_TLM_JOBS_COMPLETED_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  MathSettings MathFileJobTester ::
+    from_settingsGet_handler(NATIVE_INT_TYPE portNum)
+  {
+    return this->m_settings;
+  }
+
+  Svc::SendFileResponse MathFileJobTester ::
+    from_sendFile_handler(
+        NATIVE_INT_TYPE portNum,
+        const Fw::StringBase& fileNameFrom,
+        const Fw::StringBase& fileNameTo,
+        U32 offset,
+        U32 length
+    )
+  {
+    this->m_sentFiles.push_back(fileNameFrom.toChar());
+    EXPECT_EQ(fileNameTo, fileNameFrom);
+    EXPECT_EQ(offset, 0U);
+    EXPECT_EQ(length, 0U);
+    return Svc::SendFileResponse(this->m_sendStatus, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  std::vector<MathFileJobTester::Record> MathFileJobTester ::
+    testRecords(U32 count)
+  {
+    std::vector<Record> records(count);
+    U32 state = count;
+    for (U32 i = 0; i < count; i++) {
+      state = state * 1103515245 + 12345;
+      Record& record = records[i];
+      record.op = static_cast<U8>((state >> 16) % MathOp::NUM_CONSTANTS);
+      // Never zero, so no division gives a NaN
+      const F32 scale = static_cast<F32>(1U << ((state >> 8) % 20));
+      record.val1 = static_cast<F32>(static_cast<I32>(state % 20001) - 10000) / 7.0f * scale;
+      record.val2 = (static_cast<F32>((state >> 4) % 999) + 0.5f) * (((state >> 3) & 1) ? -1.0f : 1.0f) / scale;
+    }
+    return records;
+  }
+
+  void MathFileJobTester ::
+    writeInput(const std::vector<Record>& records)
+  {
+    std::vector<U8> bytes;
+    appendU32(bytes, MathFileJob::INPUT_MAGIC);
+    for (const Record& record : records) {
+      bytes.push_back(record.op);
+      appendU32(bytes, toBits(record.val1));
+      appendU32(bytes, toBits(record.val2));
+    }
+    this->writeInput(bytes);
+  }
+
+  void MathFileJobTester ::
+    writeInput(const std::vector<U8>& bytes)
+  {
+    std::ofstream stream(this->m_input, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    ASSERT_TRUE(stream.good());
+  }
+
+  std::vector<U8> MathFileJobTester ::
+    readOutput()
+  {
+    std::ifstream stream(this->m_output, std::ios::binary);
+    EXPECT_TRUE(stream.good());
+    return std::vector<U8>((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  }
+
+  void MathFileJobTester ::
+    run()
+  {
+    this->clearHistory();
+    this->sendCmd_RUN_MATH_FILE(0, 5, Fw::CmdStringArg(this->m_input.c_str()),
+                                Fw::CmdStringArg(this->m_output.c_str()));
+    this->component.doDispatch();
+  }
+
+}
@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  MathFileJobTester.hpp
+// \author cindy
+// \brief  hpp file for MathFileJob component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_MathFileJobTester_HPP
+#define MathModule_MathFileJobTester_HPP
+
+#include "MathFileJobGTestBase.hpp"
+#include "Components/MathFileJob/MathFileJob.hpp"
+
+#include <string>
+#include <vector>
+
+namespace MathModule {
+
+  class MathFileJobTester :
+    public MathFileJobGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! The FACTOR answered on settingsGet
+      static constexpr F32 FACTOR = 2.0f;
+
+    public:
+
+      //! One record of an operand file
+      struct Record {
+        U8 op; //!< The operation byte
+        F32 val1; //!< The first operand
+        F32 val2; //!< The second operand
+      };
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathFileJobTester
+      MathFileJobTester();
+
+      //! Destroy object MathFileJobTester, removing its files
+      ~MathFileJobTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Records of every operation across several batches give the same results as MathReceiver
+      void testNominal();
+
+      //! An operand file with no records gives a result file with none
+      void testEmpty();
+
+      //! APPROXIMATE division from settingsGet gives the same results as MathReceiver in that mode
+      void testApproximateDiv();
+
+      //! Operand files that are missing or not whole records fail the command
+      void testInputRejected();
+
+      //! A record with an operation that is not a MathOp fails the job and leaves no result file
+      void testBadOp();
+
+      //! A result file file downlink does not accept fails the command
+      void testDownlinkRejected();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for settingsGet
+      MathSettings from_settingsGet_handler(
+          NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for sendFile
+      Svc::SendFileResponse from_sendFile_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          const Fw::StringBase& fileNameFrom, //!< Path of file to downlink
+          const Fw::StringBase& fileNameTo, //!< Path to store downlinked file at
+          U32 offset, //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+          U32 length //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Records with every operation in a shuffled order and operands of many magnitudes and signs
+      static std::vector<Record> testRecords(U32 count);
+
+      //! Write an operand file
+      void writeInput(const std::vector<Record>& records);
+
+      //! Write raw bytes as the operand file
+      void writeInput(const std::vector<U8>& bytes);
+
+      //! Read the result file
+      std::vector<U8> readOutput();
+
+      //! Send RUN_MATH_FILE and let the component run it
+      void run();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      MathFileJob component;
+
+      //! The operand file
+      std::string m_input;
+
+      //! The result file
+      std::string m_output;
+
+      //! Answer of the settingsGet port
+      MathSettings m_settings;
+
+      //! Answer of the sendFile port
+      Svc::SendFileStatus m_sendStatus;
+
+      //! Files handed to sendFile
+      std::vector<std::string> m_sentFiles;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+// ======================================================================
+// \title  MathOpLog.cpp
+// \author cindy
+// \brief  Binary log of math requests written by MathOpRecorder
+// ======================================================================
+
+#include "Components/MathOpRecorder/MathOpLog.hpp"
+#include "Types/MathOpEnumAc.hpp"
+
+#include <cstring>
+
+namespace MathModule {
+
+  const U32 MathOpLog::MAGIC;
+  const U32 MathOpLog::HEADER_SIZE;
+  const U32 MathOpLog::MAX_RECORD_SIZE;
+
+  namespace {
+
+    //! Seven bits a byte, low bits first
+    //! \return bytes written
+    U32 putVarint(U8* out, U64 value)
+    {
+      U32 length = 0;
+      while (value >= 0x80) {
+        out[length++] = static_cast<U8>(value | 0x80);
+        value >>= 7;
+      }
+      out[length++] = static_cast<U8>(value);
+      return length;
+    }
+
+    //! \return bytes read, 0 if the varint runs past the end or past 64 bits
+    U32 getVarint(const U8* in, U32 available, U64& value)
+    {
+      value = 0;
+      for (U32 length = 0; (length < available) && (length < 10); length++) {
+        value |= static_cast<U64>(in[length] & 0x7F) << (7 * length);
+        if ((in[length] & 0x80) == 0) {
+          return length + 1;
+        }
+      }
+      return 0;
+    }
+
+    void putU32(U8* out, U32 value)
+    {
+      out[0] = static_cast<U8>(value >> 24);
+      out[1] = static_cast<U8>(value >> 16);
+      out[2] = static_cast<U8>(value >> 8);
+      out[3] = static_cast<U8>(value);
+    }
+
+    U32 getU32(const U8* in)
+    {
+      return (static_cast<U32>(in[0]) << 24) | (static_cast<U32>(in[1]) << 16) |
+             (static_cast<U32>(in[2]) << 8) | static_cast<U32>(in[3]);
+    }
+
+    void putF32(U8* out, F32 value)
+    {
+      U32 bits = 0;
+      (void) ::memcpy(&bits, &value, sizeof(bits));
+      putU32(out, bits);
+    }
+
+    F32 getF32(const U8* in)
+    {
+      const U32 bits = getU32(in);
+      F32 value = 0;
+      (void) ::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+  }
+
+  U32 MathOpLog ::
+    encodeHeader(U8* out)
+  {
+    putU32(out, MAGIC);
+    return HEADER_SIZE;
+  }
+
+  bool MathOpLog ::
+    checkHeader(const U8* in, U32 available)
+  {
+    return (available >= HEADER_SIZE) && (getU32(in) == MAGIC);
+  }
+
+  U32 MathOpLog ::
+    encode(const Record& record, U8* out)
+  {
+    U32 length = putVarint(out, record.deltaNsec);
+    out[length++] = record.op;
+    putF32(&out[length], record.val1);
+    length += sizeof(U32);
+    putF32(&out[length], record.val2);
+    length += sizeof(U32);
+    return length;
+  }
+
+  MathOpLog::Status MathOpLog ::
+    decode(const U8* in, U32 available, Record& record, U32& used)
+  {
+    if (available == 0) {
+      return END;
+    }
+    U32 length = getVarint(in, available, record.deltaNsec);
+    if ((length == 0) || (available - length < sizeof(U8) + 2 * sizeof(U32))) {
+      return TRUNCATED;
+    }
+    record.op = in[length++];
+    if (record.op >= MathOp::NUM_CONSTANTS) {
+      return BAD_OP;
+    }
+    record.val1 = getF32(&in[length]);
+    length += sizeof(U32);
+    record.val2 = getF32(&in[length]);
+    length += sizeof(U32);
+    used = length;
+    return RECORD;
+  }
+
+}
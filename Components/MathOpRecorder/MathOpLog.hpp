@@ -0,0 +1,89 @@
+// ======================================================================
+// \title  MathOpLog.hpp
+// \author cindy
+// \brief  Binary log of math requests written by MathOpRecorder
+//
+// A log is the magic number followed by one record per request, in the
+// order they were made. A record is the time since the record before, in
+// nanoseconds of the monotonic clock as a varint, the operation, and the
+// two operands as big endian F32 bits: 10 to 19 bytes. The first record's
+// time is counted from the start of recording. Operands keep their exact
+// bits, NaN payloads included, so a replay repeats the same arithmetic.
+// ======================================================================
+
+#ifndef MathModule_MathOpLog_HPP
+#define MathModule_MathOpLog_HPP
+
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  class MathOpLog {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants and types
+      // ----------------------------------------------------------------------
+
+      //! Identifies a log, "MOL1"
+      static const U32 MAGIC = 0x4D4F4C31;
+
+      //! Bytes in front of the first record
+      static const U32 HEADER_SIZE = sizeof(U32);
+
+      //! Longest encoded record
+      static const U32 MAX_RECORD_SIZE = 10 + sizeof(U8) + 2 * sizeof(U32);
+
+      //! One math request
+      struct Record {
+        U64 deltaNsec; //!< Time since the record before
+        U8 op; //!< The MathOp value
+        F32 val1; //!< The first operand
+        F32 val2; //!< The second operand
+      };
+
+      //! Outcome of decoding a record
+      enum Status {
+        RECORD, //!< A record was decoded
+        END, //!< No bytes left
+        TRUNCATED, //!< The record runs past the end
+        BAD_OP //!< The operation is not a MathOp
+      };
+
+    public:
+
+      //! Encode the log header
+      //! \return HEADER_SIZE
+      static U32 encodeHeader(
+          U8* out //!< At least HEADER_SIZE bytes
+      );
+
+      //! Check the log header
+      //! \return whether the bytes start with a log header
+      static bool checkHeader(
+          const U8* in, //!< The log
+          U32 available //!< Bytes in the log
+      );
+
+      //! Encode a record
+      //! \return bytes written, at most MAX_RECORD_SIZE
+      static U32 encode(
+          const Record& record, //!< The record
+          U8* out //!< At least MAX_RECORD_SIZE bytes
+      );
+
+      //! Decode the record at the front of the bytes
+      //! \return RECORD with used set, or why there is none
+      static Status decode(
+          const U8* in, //!< The bytes after the header or the previous record
+          U32 available, //!< Bytes left
+          Record& record, //!< Filled with the record
+          U32& used //!< Set to the bytes of the record
+      );
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+// ======================================================================
+// \title  MathOpRecorder.cpp
+// \author cindy
+// \brief  cpp file for MathOpRecorder component implementation class
+// ======================================================================
+
+#include "Components/MathOpRecorder/MathOpRecorder.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 MathOpRecorder::STAGING_SIZE;
+
+  namespace {
+
+    U64 monotonicNsec()
+    {
+      struct timespec now;
+      (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+      return static_cast<U64>(now.tv_sec) * 1000000000U + static_cast<U64>(now.tv_nsec);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathOpRecorder ::
+    MathOpRecorder(const char* const compName) :
+      MathOpRecorderComponentBase(compName),
+      m_fd(-1),
+      m_records(0),
+      m_lastNsec(0),
+      m_staged(0)
+  {
+
+  }
+
+  MathOpRecorder ::
+    ~MathOpRecorder()
+  {
+    this->m_lock.lock();
+    if (this->m_fd >= 0) {
+      (void) this->closeLog();
+    }
+    this->m_lock.unLock();
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    Runs on the sender's thread. The request is timed on arrival and staged;
+    a file write happens once per STAGING_SIZE bytes, about 300 requests, and
+    the request is passed on after the lock is released.
+  */
+  void MathOpRecorder ::
+    opIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        F32 val1,
+        const MathModule::MathOp& op,
+        F32 val2
+    )
+  {
+    I32 error = 0;
+    this->m_lock.lock();
+    if (this->m_fd >= 0) {
+      const U64 now = monotonicNsec();
+      MathOpLog::Record record;
+      record.deltaNsec = now - this->m_lastNsec;
+      record.op = static_cast<U8>(op.e);
+      record.val1 = val1;
+      record.val2 = val2;
+      this->m_lastNsec = now;
+      if (this->m_staged + MathOpLog::MAX_RECORD_SIZE > STAGING_SIZE) {
+        error = this->flushStaged();
+      }
+      if (error == 0) {
+        this->m_staged += MathOpLog::encode(record, &this->m_staging[this->m_staged]);
+        this->m_records++;
+      } else {
+        (void) ::close(this->m_fd);
+        this->m_fd = -1;
+        this->m_staged = 0;
+      }
+    }
+    this->m_lock.unLock();
+
+    if (error != 0) {
+      this->log_WARNING_HI_RECORDING_WRITE_ERROR(error);
+    }
+    this->opOut_out(0, val1, op, val2);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  void MathOpRecorder ::
+    START_RECORDING_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& file
+    )
+  {
+    this->m_lock.lock();
+    const bool wasRecording = (this->m_fd >= 0);
+    const U32 previousRecords = this->m_records;
+    const Fw::String previousFile = this->m_file;
+    I32 error = wasRecording ? this->closeLog() : 0;
+    const bool stopped = wasRecording && (error == 0);
+    if (error == 0) {
+      this->m_fd = ::open(file.toChar(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (this->m_fd < 0) {
+        error = errno;
+      } else {
+        this->m_file = file.toChar();
+        this->m_records = 0;
+        this->m_staged = MathOpLog::encodeHeader(this->m_staging);
+        this->m_lastNsec = monotonicNsec();
+      }
+    }
+    this->m_lock.unLock();
+
+    if (stopped) {
+      Fw::LogStringArg previousArg(previousFile.toChar());
+      this->log_ACTIVITY_HI_RECORDING_STOPPED(previousRecords, previousArg);
+    }
+    if (error != 0) {
+      this->log_WARNING_HI_RECORDING_WRITE_ERROR(error);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    Fw::LogStringArg fileArg(file.toChar());
+    this->log_ACTIVITY_HI_RECORDING_STARTED(fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void MathOpRecorder ::
+    STOP_RECORDING_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    this->m_lock.lock();
+    const bool wasRecording = (this->m_fd >= 0);
+    const I32 error = wasRecording ? this->closeLog() : 0;
+    const U32 records = this->m_records;
+    const Fw::String file = this->m_file;
+    this->m_lock.unLock();
+
+    if (!wasRecording) {
+      this->log_WARNING_LO_NOT_RECORDING();
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    if (error != 0) {
+      this->log_WARNING_HI_RECORDING_WRITE_ERROR(error);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    Fw::LogStringArg fileArg(file.toChar());
+    this->log_ACTIVITY_HI_RECORDING_STOPPED(records, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  I32 MathOpRecorder ::
+    flushStaged()
+  {
+    FW_ASSERT(this->m_fd >= 0);
+    const U8* data = this->m_staging;
+    size_t remaining = this->m_staged;
+    while (remaining > 0) {
+      const ssize_t written = ::write(this->m_fd, data, remaining);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno;
+      }
+      data += written;
+      remaining -= static_cast<size_t>(written);
+    }
+    this->m_staged = 0;
+    return 0;
+  }
+
+  I32 MathOpRecorder ::
+    closeLog()
+  {
+    I32 error = this->flushStaged();
+    if ((::close(this->m_fd) != 0) && (error == 0)) {
+      error = errno;
+    }
+    this->m_fd = -1;
+    this->m_staged = 0;
+    return error;
+  }
+
+}
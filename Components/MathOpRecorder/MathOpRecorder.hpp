@@ -0,0 +1,122 @@
+// ======================================================================
+// \title  MathOpRecorder.hpp
+// \author cindy
+// \brief  hpp file for MathOpRecorder component implementation class
+// ======================================================================
+
+#ifndef MathModule_MathOpRecorder_HPP
+#define MathModule_MathOpRecorder_HPP
+
+#include "Components/MathOpRecorder/MathOpRecorderComponentAc.hpp"
+#include "Components/MathOpRecorder/MathOpLog.hpp"
+#include <Fw/Types/String.hpp>
+#include <Os/Mutex.hpp>
+
+namespace MathModule {
+
+  class MathOpRecorder :
+    public MathOpRecorderComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Records staged in memory before a file write
+      static const U32 STAGING_SIZE = 4096;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct MathOpRecorder object
+      MathOpRecorder(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy MathOpRecorder object, closing a recording in progress
+      ~MathOpRecorder();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for opIn
+      void opIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          F32 val1, //!< The first operand
+          const MathModule::MathOp& op, //!< The operation
+          F32 val2 //!< The second operand
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command START_RECORDING
+      void START_RECORDING_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq, //!< The command sequence number
+          const Fw::CmdStringArg& file //!< The log file
+      ) override;
+
+      //! Handler implementation for command STOP_RECORDING
+      void STOP_RECORDING_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq //!< The command sequence number
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Write the staged records. Call with the lock held.
+      //! \return 0, or the errno value of the failed write
+      I32 flushStaged();
+
+      //! Write the staged records and close the log. Call with the lock held.
+      //! \return 0, or the errno value of the failed write or close
+      I32 closeLog();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Guards the log, which the sender and command threads share
+      Os::Mutex m_lock;
+
+      //! The log file, or -1 when not recording
+      int m_fd;
+
+      //! The log file name
+      Fw::String m_file;
+
+      //! Requests recorded to the log
+      U32 m_records;
+
+      //! Monotonic time of the last record, or of the start of recording
+      U64 m_lastNsec;
+
+      //! Bytes staged
+      U32 m_staged;
+
+      //! Records not yet written
+      U8 m_staging[STAGING_SIZE];
+
+  };
+
+}
+
+#endif
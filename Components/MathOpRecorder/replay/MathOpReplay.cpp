@@ -0,0 +1,282 @@
+// ======================================================================
+// \title  MathOpReplay.cpp
+// \author cindy
+// \brief  Replays a MathOpRecorder log into a lone MathReceiver
+//
+// Usage: math_replay <log> [--paced] [--repeat <count>] [--queue <depth>]
+//
+// The log is decoded up front, then each request goes through
+// MathReceiver's mathOpIn port and queue as in the deployment, with
+// schedIn draining the queue. By default the queue is filled to its depth
+// before each drain, as fast as possible. --paced issues each request at
+// its recorded time and drains it at once. FACTOR is at its default, 1.0.
+//
+// Results are checksummed in order with 64-bit FNV-1a over their bits,
+// overall and per operation, so two runs of a log agree exactly when
+// MathReceiver computed the same results. Results are printed as one JSON
+// object.
+// ======================================================================
+
+#include "Components/MathOpRecorder/MathOpLog.hpp"
+#include "Components/MathReceiver/MathReceiver.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+  const char* const OP_NAMES[] = {"ADD", "SUB", "MUL", "DIV"};
+  static_assert(FW_NUM_ARRAY_ELEMENTS(OP_NAMES) == MathModule::MathOp::NUM_CONSTANTS, "Every operation needs a name");
+
+  const U64 FNV_OFFSET = 0xCBF29CE484222325ULL;
+  const U64 FNV_PRIME = 0x100000001B3ULL;
+
+  U64 monotonicNsec()
+  {
+    struct timespec now;
+    (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<U64>(now.tv_sec) * 1000000000U + static_cast<U64>(now.tv_nsec);
+  }
+
+  void sleepUntil(U64 nsec)
+  {
+    struct timespec due;
+    due.tv_sec = static_cast<time_t>(nsec / 1000000000U);
+    due.tv_nsec = static_cast<long>(nsec % 1000000000U);
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr) == EINTR) {
+    }
+  }
+
+  U64 fnv(U64 hash, U32 bits)
+  {
+    for (U32 i = 0; i < sizeof(bits); i++) {
+      hash = (hash ^ ((bits >> (8 * i)) & 0xFF)) * FNV_PRIME;
+    }
+    return hash;
+  }
+
+  //! Receives MathReceiver's results and checksums them in order. The queue
+  //! is FIFO, so the nth result is that of the nth request.
+  class ResultSink : public Fw::PassiveComponentBase {
+
+    public:
+
+      explicit ResultSink(const std::vector<MathModule::MathOpLog::Record>& records) :
+        Fw::PassiveComponentBase("resultSink"), results(0), checksum(FNV_OFFSET), m_records(records)
+      {
+        for (U32 op = 0; op < MathModule::MathOp::NUM_CONSTANTS; op++) {
+          this->opResults[op] = 0;
+          this->opChecksums[op] = FNV_OFFSET;
+        }
+      }
+
+      static void resultIn(Fw::PassiveComponentBase* callComp, NATIVE_INT_TYPE portNum, F32 result)
+      {
+        ResultSink* sink = static_cast<ResultSink*>(callComp);
+        U32 bits = 0;
+        (void) ::memcpy(&bits, &result, sizeof(bits));
+        const U8 op = sink->m_records[sink->results % sink->m_records.size()].op;
+        sink->results++;
+        sink->checksum = fnv(sink->checksum, bits);
+        sink->opResults[op]++;
+        sink->opChecksums[op] = fnv(sink->opChecksums[op], bits);
+      }
+
+      U64 results;
+      U64 checksum;
+      U64 opResults[MathModule::MathOp::NUM_CONSTANTS];
+      U64 opChecksums[MathModule::MathOp::NUM_CONSTANTS];
+
+    private:
+
+      const std::vector<MathModule::MathOpLog::Record>& m_records;
+
+  };
+
+  //! Answers every parameter read as not found, so MathReceiver's
+  //! parameters take their defaults as in a deployment without a
+  //! parameter file. loadParameters asserts that the port is connected.
+  class DefaultParams : public Fw::PassiveComponentBase {
+
+    public:
+
+      DefaultParams() : Fw::PassiveComponentBase("defaultParams")
+      {
+      }
+
+      static Fw::ParamValid prmGetIn(Fw::PassiveComponentBase* callComp, NATIVE_INT_TYPE portNum, FwPrmIdType id,
+                                     Fw::ParamBuffer& val)
+      {
+        return Fw::ParamValid::DEFAULT;
+      }
+
+  };
+
+  //! Decode every record of a log
+  //! \return whether the whole log decoded
+  bool readLog(const char* path, std::vector<MathModule::MathOpLog::Record>& records)
+  {
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      std::fprintf(stderr, "%s: %s\n", path, std::strerror(errno));
+      return false;
+    }
+    struct stat info;
+    if ((::fstat(fd, &info) != 0) || (info.st_size < static_cast<off_t>(MathModule::MathOpLog::HEADER_SIZE))) {
+      std::fprintf(stderr, "%s: not a math request log\n", path);
+      (void) ::close(fd);
+      return false;
+    }
+    const U64 size = static_cast<U64>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void) ::close(fd);
+    if (mapped == MAP_FAILED) {
+      std::fprintf(stderr, "%s: %s\n", path, std::strerror(errno));
+      return false;
+    }
+    (void) ::madvise(mapped, size, MADV_SEQUENTIAL);
+    const U8* log = static_cast<const U8*>(mapped);
+    bool complete = MathModule::MathOpLog::checkHeader(log, MathModule::MathOpLog::HEADER_SIZE);
+    if (!complete) {
+      std::fprintf(stderr, "%s: not a math request log\n", path);
+    }
+    U64 offset = MathModule::MathOpLog::HEADER_SIZE;
+    while (complete) {
+      const U64 left = size - offset;
+      const U32 available = static_cast<U32>((left < MathModule::MathOpLog::MAX_RECORD_SIZE) ?
+                                             left : MathModule::MathOpLog::MAX_RECORD_SIZE);
+      MathModule::MathOpLog::Record record;
+      U32 used = 0;
+      const MathModule::MathOpLog::Status status = MathModule::MathOpLog::decode(&log[offset], available, record, used);
+      if (status == MathModule::MathOpLog::END) {
+        break;
+      }
+      if (status != MathModule::MathOpLog::RECORD) {
+        std::fprintf(stderr, "%s: %s record at byte %llu\n", path,
+                     (status == MathModule::MathOpLog::BAD_OP) ? "bad" : "truncated",
+                     static_cast<unsigned long long>(offset));
+        complete = false;
+        break;
+      }
+      records.push_back(record);
+      offset += used;
+    }
+    (void) ::munmap(mapped, size);
+    return complete;
+  }
+
+  int usage(const char* program)
+  {
+    std::fprintf(stderr, "usage: %s <log> [--paced] [--repeat <count>] [--queue <depth>]\n", program);
+    return 1;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    return usage(argv[0]);
+  }
+  const char* path = argv[1];
+  bool paced = false;
+  unsigned long repeat = 1;
+  unsigned long depth = 10;
+  for (int i = 2; i < argc; i++) {
+    if (std::strcmp(argv[i], "--paced") == 0) {
+      paced = true;
+    } else if ((std::strcmp(argv[i], "--repeat") == 0) && (i + 1 < argc)) {
+      repeat = std::strtoul(argv[++i], nullptr, 0);
+    } else if ((std::strcmp(argv[i], "--queue") == 0) && (i + 1 < argc)) {
+      depth = std::strtoul(argv[++i], nullptr, 0);
+    } else {
+      return usage(argv[0]);
+    }
+  }
+  if ((repeat == 0) || (depth == 0)) {
+    return usage(argv[0]);
+  }
+
+  std::vector<MathModule::MathOpLog::Record> records;
+  if (!readLog(path, records)) {
+    return 1;
+  }
+  if (records.empty()) {
+    std::fprintf(stderr, "%s: no records\n", path);
+    return 1;
+  }
+  U64 recordedNsec = 0;
+  for (const MathModule::MathOpLog::Record& record : records) {
+    recordedNsec += record.deltaNsec;
+  }
+
+  // A lone receiver: parameters at their defaults, results to the sink, no other ports connected
+  MathModule::MathReceiver receiver("mathReceiver");
+  receiver.init(static_cast<NATIVE_INT_TYPE>(depth), 0);
+  ResultSink sink(records);
+  MathModule::InputMathResultPort resultIn;
+  resultIn.init();
+  resultIn.addCallComp(&sink, ResultSink::resultIn);
+  receiver.set_mathResultOut_OutputPort(0, &resultIn);
+  DefaultParams params;
+  Fw::InputPrmGetPort prmGetIn;
+  prmGetIn.init();
+  prmGetIn.addCallComp(&params, DefaultParams::prmGetIn);
+  receiver.set_prmGetOut_OutputPort(0, &prmGetIn);
+  receiver.loadParameters();
+  MathModule::InputOpRequestPort* const opIn = receiver.get_mathOpIn_InputPort(0);
+  Svc::InputSchedPort* const schedIn = receiver.get_schedIn_InputPort(0);
+
+  U64 maxLateNsec = 0;
+  const U64 start = monotonicNsec();
+  U64 due = start;
+  for (unsigned long pass = 0; pass < repeat; pass++) {
+    for (U64 i = 0; i < records.size(); i++) {
+      const MathModule::MathOpLog::Record& record = records[i];
+      if (paced) {
+        due += record.deltaNsec;
+        sleepUntil(due);
+        const U64 late = monotonicNsec() - due;
+        maxLateNsec = (late > maxLateNsec) ? late : maxLateNsec;
+      }
+      opIn->invoke(record.val1, static_cast<MathModule::MathOp::T>(record.op), record.val2);
+      if (paced || ((i + 1) % depth == 0)) {
+        schedIn->invoke(0);
+      }
+    }
+    schedIn->invoke(0);
+  }
+  const double seconds = static_cast<double>(monotonicNsec() - start) / 1e9;
+
+  const U64 requests = static_cast<U64>(records.size()) * repeat;
+  if (sink.results != requests) {
+    std::fprintf(stderr, "%llu results for %llu requests\n", static_cast<unsigned long long>(sink.results),
+                 static_cast<unsigned long long>(requests));
+    return 1;
+  }
+  std::printf("{\n  \"log\": \"%s\",\n  \"records\": %llu,\n  \"repeat\": %lu,\n  \"paced\": %s,\n"
+              "  \"queue\": %lu,\n  \"recorded_seconds\": %.6f,\n  \"seconds\": %.6f,\n  \"ops_per_sec\": %.1f,\n",
+              path, static_cast<unsigned long long>(records.size()), repeat, paced ? "true" : "false", depth,
+              static_cast<double>(recordedNsec) / 1e9, seconds,
+              (seconds > 0) ? static_cast<double>(requests) / seconds : 0.0);
+  if (paced) {
+    std::printf("  \"max_late_usec\": %.3f,\n", static_cast<double>(maxLateNsec) / 1e3);
+  }
+  std::printf("  \"checksum\": \"0x%016llx\",\n  \"ops\": {\n", static_cast<unsigned long long>(sink.checksum));
+  for (U32 op = 0; op < MathModule::MathOp::NUM_CONSTANTS; op++) {
+    std::printf("    \"%s\": {\"count\": %llu, \"checksum\": \"0x%016llx\"}%s\n", OP_NAMES[op],
+                static_cast<unsigned long long>(sink.opResults[op]),
+                static_cast<unsigned long long>(sink.opChecksums[op]),
+                (op + 1 < MathModule::MathOp::NUM_CONSTANTS) ? "," : "");
+  }
+  std::printf("  }\n}\n");
+  return 0;
+}
@@ -0,0 +1,94 @@
+// ======================================================================
+// \title  MathOpRecorderTestMain.cpp
+// \author cindy
+// \brief  cpp file for MathOpRecorder component test main function
+// ======================================================================
+
+#include "MathOpRecorderTester.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+  U32 bitsOf(F32 value)
+  {
+    U32 bits = 0;
+    (void) ::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+}
+
+TEST(MathOpLog, RoundTrip) {
+  F32 nan = 0;
+  const U32 nanBits = 0x7FC01234U;
+  (void) ::memcpy(&nan, &nanBits, sizeof(nan));
+  const MathModule::MathOpLog::Record records[] = {
+    {0, MathModule::MathOp::ADD, 1.5f, -2.25f},
+    {127, MathModule::MathOp::SUB, -0.0f, std::numeric_limits<F32>::denorm_min()},
+    {128, MathModule::MathOp::MUL, std::numeric_limits<F32>::infinity(), nan},
+    {0xFFFFFFFFFFFFFFFFULL, MathModule::MathOp::DIV, std::numeric_limits<F32>::max(), 3.0f},
+  };
+  U8 log[MathModule::MathOpLog::HEADER_SIZE + 4 * MathModule::MathOpLog::MAX_RECORD_SIZE];
+  U32 size = MathModule::MathOpLog::encodeHeader(log);
+  for (const MathModule::MathOpLog::Record& record : records) {
+    const U32 length = MathModule::MathOpLog::encode(record, &log[size]);
+    EXPECT_LE(length, MathModule::MathOpLog::MAX_RECORD_SIZE);
+    size += length;
+  }
+  // Two bytes of time for a delta of 128 ns, ten for the largest
+  EXPECT_EQ(size, MathModule::MathOpLog::HEADER_SIZE + 10 + 10 + 11 + 19);
+
+  ASSERT_TRUE(MathModule::MathOpLog::checkHeader(log, size));
+  U32 offset = MathModule::MathOpLog::HEADER_SIZE;
+  for (const MathModule::MathOpLog::Record& expected : records) {
+    MathModule::MathOpLog::Record record;
+    U32 used = 0;
+    ASSERT_EQ(MathModule::MathOpLog::decode(&log[offset], size - offset, record, used),
+              MathModule::MathOpLog::RECORD);
+    EXPECT_EQ(record.deltaNsec, expected.deltaNsec);
+    EXPECT_EQ(record.op, expected.op);
+    // Operands keep their exact bits
+    EXPECT_EQ(bitsOf(record.val1), bitsOf(expected.val1));
+    EXPECT_EQ(bitsOf(record.val2), bitsOf(expected.val2));
+    offset += used;
+  }
+  MathModule::MathOpLog::Record record;
+  U32 used = 0;
+  EXPECT_EQ(MathModule::MathOpLog::decode(&log[offset], size - offset, record, used), MathModule::MathOpLog::END);
+}
+
+TEST(MathOpLog, Damaged) {
+  U8 log[MathModule::MathOpLog::HEADER_SIZE + MathModule::MathOpLog::MAX_RECORD_SIZE] = {};
+  EXPECT_FALSE(MathModule::MathOpLog::checkHeader(log, MathModule::MathOpLog::HEADER_SIZE - 1));
+  const U32 length = MathModule::MathOpLog::encode({300, MathModule::MathOp::MUL, 1.0f, 2.0f}, log);
+  MathModule::MathOpLog::Record record;
+  U32 used = 0;
+  for (U32 cut = 1; cut < length; cut++) {
+    EXPECT_EQ(MathModule::MathOpLog::decode(log, cut, record, used), MathModule::MathOpLog::TRUNCATED) << cut;
+  }
+  log[2] = MathModule::MathOp::NUM_CONSTANTS;
+  EXPECT_EQ(MathModule::MathOpLog::decode(log, length, record, used), MathModule::MathOpLog::BAD_OP);
+}
+
+TEST(Nominal, Record) {
+  MathModule::MathOpRecorderTester tester;
+  tester.testRecord();
+}
+
+TEST(Nominal, PassThrough) {
+  MathModule::MathOpRecorderTester tester;
+  tester.testPassThrough();
+}
+
+TEST(OffNominal, OpenError) {
+  MathModule::MathOpRecorderTester tester;
+  tester.testOpenError();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
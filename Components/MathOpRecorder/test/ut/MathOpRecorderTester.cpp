@@ -0,0 +1,141 @@
+// ======================================================================
+// \title  MathOpRecorderTester.cpp
+// \author cindy
+// \brief  cpp file for MathOpRecorder component test harness implementation class
+// ======================================================================
+
+#include "MathOpRecorderTester.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    U64 monotonicNsec()
+    {
+      struct timespec now;
+      (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+      return static_cast<U64>(now.tv_sec) * 1000000000U + static_cast<U64>(now.tv_nsec);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathOpRecorderTester ::
+    MathOpRecorderTester() :
+      MathOpRecorderGTestBase("MathOpRecorderTester", MathOpRecorderTester::MAX_HISTORY_SIZE),
+      component("MathOpRecorder")
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/MathOpRecorderTester.%d.bin", static_cast<int>(::getpid()));
+    this->m_file = path;
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  MathOpRecorderTester ::
+    ~MathOpRecorderTester()
+  {
+    (void) ::unlink(this->m_file.c_str());
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MathOpRecorderTester ::
+    testRecord()
+  {
+    // More requests than one staging buffer holds, so the log is written in several parts
+    const U32 requests = 1000;
+    const U64 start = monotonicNsec();
+    this->sendCmd_START_RECORDING(0, 5, Fw::CmdStringArg(this->m_file.c_str()));
+    ASSERT_CMD_RESPONSE(0, MathOpRecorder::OPCODE_START_RECORDING, 5, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_RECORDING_STARTED(0, this->m_file.c_str());
+    for (U32 i = 0; i < requests; i++) {
+      this->invoke_to_opIn(0, static_cast<F32>(i), MathOp(static_cast<MathOp::T>(i % MathOp::NUM_CONSTANTS)),
+                           -0.5f * static_cast<F32>(i));
+    }
+    this->sendCmd_STOP_RECORDING(0, 6);
+    const U64 elapsed = monotonicNsec() - start;
+    ASSERT_CMD_RESPONSE(1, MathOpRecorder::OPCODE_STOP_RECORDING, 6, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_RECORDING_STOPPED(0, requests, this->m_file.c_str());
+
+    ASSERT_from_opOut_SIZE(requests);
+    const std::vector<MathOpLog::Record> records = this->readLog();
+    ASSERT_EQ(records.size(), requests);
+    U64 total = 0;
+    for (U32 i = 0; i < requests; i++) {
+      EXPECT_EQ(records[i].op, this->fromPortHistory_opOut->at(i).op.e);
+      EXPECT_EQ(records[i].val1, this->fromPortHistory_opOut->at(i).val1);
+      EXPECT_EQ(records[i].val2, this->fromPortHistory_opOut->at(i).val2);
+      total += records[i].deltaNsec;
+    }
+    // Times are counted from the start of recording
+    EXPECT_LE(total, elapsed);
+  }
+
+  void MathOpRecorderTester ::
+    testPassThrough()
+  {
+    this->invoke_to_opIn(0, 1.0f, MathOp::DIV, 2.0f);
+    ASSERT_from_opOut_SIZE(1);
+    ASSERT_from_opOut(0, 1.0f, MathOp::DIV, 2.0f);
+
+    this->sendCmd_STOP_RECORDING(0, 5);
+    ASSERT_CMD_RESPONSE(0, MathOpRecorder::OPCODE_STOP_RECORDING, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_NOT_RECORDING_SIZE(1);
+    EXPECT_NE(::access(this->m_file.c_str(), F_OK), 0);
+  }
+
+  void MathOpRecorderTester ::
+    testOpenError()
+  {
+    this->sendCmd_START_RECORDING(0, 5, Fw::CmdStringArg("/nonexistent/MathOps.bin"));
+    ASSERT_CMD_RESPONSE(0, MathOpRecorder::OPCODE_START_RECORDING, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_RECORDING_WRITE_ERROR(0, ENOENT);
+    ASSERT_EVENTS_RECORDING_STARTED_SIZE(0);
+
+    this->invoke_to_opIn(0, 3.0f, MathOp::ADD, 4.0f);
+    ASSERT_from_opOut_SIZE(1);
+    this->sendCmd_STOP_RECORDING(0, 6);
+    ASSERT_EVENTS_NOT_RECORDING_SIZE(1);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  std::vector<MathOpLog::Record> MathOpRecorderTester ::
+    readLog()
+  {
+    std::ifstream stream(this->m_file, std::ios::binary);
+    const std::vector<U8> log((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    std::vector<MathOpLog::Record> records;
+    EXPECT_TRUE(MathOpLog::checkHeader(log.data(), static_cast<U32>(log.size())));
+    U32 offset = MathOpLog::HEADER_SIZE;
+    while (offset <= log.size()) {
+      MathOpLog::Record record;
+      U32 used = 0;
+      const MathOpLog::Status status = MathOpLog::decode(log.data() + offset, static_cast<U32>(log.size()) - offset,
+                                                         record, used);
+      if (status != MathOpLog::RECORD) {
+        EXPECT_EQ(status, MathOpLog::END);
+        break;
+      }
+      records.push_back(record);
+      offset += used;
+    }
+    return records;
+  }
+
+}
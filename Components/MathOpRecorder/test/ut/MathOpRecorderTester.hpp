@@ -0,0 +1,95 @@
+// ======================================================================
+// \title  MathOpRecorderTester.hpp
+// \author cindy
+// \brief  hpp file for MathOpRecorder component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_MathOpRecorderTester_HPP
+#define MathModule_MathOpRecorderTester_HPP
+
+#include "MathOpRecorderGTestBase.hpp"
+#include "Components/MathOpRecorder/MathOpRecorder.hpp"
+
+#include <string>
+#include <vector>
+
+namespace MathModule {
+
+  class MathOpRecorderTester :
+    public MathOpRecorderGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 2000;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathOpRecorderTester
+      MathOpRecorderTester();
+
+      //! Destroy object MathOpRecorderTester, removing its log
+      ~MathOpRecorderTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Requests are passed on and recorded in order with their operands and times
+      void testRecord();
+
+      //! Requests outside a recording are passed on only
+      void testPassThrough();
+
+      //! A log that cannot be opened fails the command and records nothing
+      void testOpenError();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Decode every record of the log
+      std::vector<MathOpLog::Record> readLog();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      MathOpRecorder component;
+
+      //! Log file
+      std::string m_file;
+
+  };
+
+}
+
+#endif
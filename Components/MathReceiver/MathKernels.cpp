@@ -0,0 +1,143 @@
+// ======================================================================
+// \title  MathKernels.cpp
+// \author cindy
+// \brief  cpp file for the MathReceiver arithmetic
+// ======================================================================
+
+#include "Components/MathReceiver/MathKernels.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cstring>
+
+namespace MathModule {
+
+  namespace MathKernels {
+
+    namespace {
+
+      //! Subtracting a positive F32's bits from this negates its exponent and roughly inverts its mantissa
+      const U32 RECIPROCAL_MAGIC = 0x7EF311C3;
+
+      //! Largest biased exponent of a divisor whose estimate is a normal F32
+      const U32 MAX_ESTIMATE_EXPONENT = 251;
+
+      U32 toBits(F32 val) {
+        U32 bits;
+        memcpy(&bits, &val, sizeof(bits));
+        return bits;
+      }
+
+      F32 toF32(U32 bits) {
+        F32 val;
+        memcpy(&val, &bits, sizeof(val));
+        return val;
+      }
+
+      /*
+        Each step x = x + x * (1 - b * x) squares the relative error of the
+        reciprocal. STEPS is a template argument so the steps unroll into
+        the element loop and the loop stays branch-free for the vectorizer.
+        Divisors outside the estimate's range are only counted here.
+      */
+      template <U32 STEPS>
+      U32 divideApproximate(const F32* __restrict a, const F32* __restrict b, F32 factor,
+                            F32* __restrict out, U32 count)
+      {
+        U32 outside = 0;
+        for (U32 i = 0; i < count; i++) {
+          const U32 bits = toBits(b[i]);
+          // The magic subtraction leaves the divisor's sign bit in place
+          F32 x = toF32(RECIPROCAL_MAGIC - bits);
+          for (U32 step = 0; step < STEPS; step++) {
+            const F32 e = 1.0f - b[i] * x;
+            x = x + x * e;
+          }
+          out[i] = (a[i] * x) * factor;
+          // Biased exponent 0 wraps around, so one comparison finds both ends of the range
+          outside += ((((bits >> 23) & 0xFF) - 1) >= MAX_ESTIMATE_EXPONENT) ? 1 : 0;
+        }
+        return outside;
+      }
+
+    }
+
+    F32 apply(MathOp::T op, F32 val1, F32 val2, const MathSettings& settings)
+    {
+      F32 res = 0.0;
+      apply(op, &val1, &val2, settings, &res, 1);
+      return res;
+    }
+
+    /*
+      The switch is outside the loops so that each loop is a plain
+      element-wise operation with no branch, which the compiler turns into
+      SIMD code. The single form goes through here too, so a request gives
+      the same bits whichever form computed it.
+    */
+    void apply(MathOp::T op, const F32* val1, const F32* val2, const MathSettings& settings, F32* result, U32 count)
+    {
+      FW_ASSERT(val1 != nullptr);
+      FW_ASSERT(val2 != nullptr);
+      FW_ASSERT(result != nullptr);
+      const F32* __restrict a = val1;
+      const F32* __restrict b = val2;
+      F32* __restrict out = result;
+      const F32 factor = settings.getfactor();
+
+      switch (op) {
+        case MathOp::ADD:
+          for (U32 i = 0; i < count; i++) {
+            out[i] = (a[i] + b[i]) * factor;
+          }
+          break;
+        case MathOp::SUB:
+          for (U32 i = 0; i < count; i++) {
+            out[i] = (a[i] - b[i]) * factor;
+          }
+          break;
+        case MathOp::DIV:{
+          if (settings.getdivMode() != DivMode::APPROXIMATE) {
+            for (U32 i = 0; i < count; i++) {
+              out[i] = (a[i] / b[i]) * factor;
+            }
+            break;
+          }
+          U32 outside;
+          switch (FW_MIN(settings.getdivRefineSteps(), MAX_DIV_REFINE_STEPS)) {
+            case 0:
+              outside = divideApproximate<0>(a, b, factor, out, count);
+              break;
+            case 1:
+              outside = divideApproximate<1>(a, b, factor, out, count);
+              break;
+            case 2:
+              outside = divideApproximate<2>(a, b, factor, out, count);
+              break;
+            default:
+              outside = divideApproximate<3>(a, b, factor, out, count);
+              break;
+          }
+          // Divisors outside the estimate's range are rare, so they are divided exactly in a second pass
+          for (U32 i = 0; (i < count) && (outside > 0); i++) {
+            const U32 exponent = (toBits(b[i]) >> 23) & 0xFF;
+            if ((exponent == 0) || (exponent > MAX_ESTIMATE_EXPONENT)) {
+              out[i] = (a[i] / b[i]) * factor;
+              outside--;
+            }
+          }
+          break;
+        }
+        case MathOp::MUL:
+          for (U32 i = 0; i < count; i++) {
+            out[i] = (a[i] * b[i]) * factor;
+          }
+          break;
+        default:
+          FW_ASSERT(0, op);
+          break;
+      }
+    }
+
+  }
+
+}
@@ -0,0 +1,68 @@
+// ======================================================================
+// \title  MathKernels.hpp
+// \author cindy
+// \brief  The arithmetic of MathReceiver, for one request or a batch
+//
+// mathOpIn_handler computes each request with the single form. Bulk
+// callers such as MathFileJob group requests by operation and call the
+// batch form, whose loops the compiler vectorizes. Both give the same
+// result for the same operands and settings.
+//
+// With DivMode::APPROXIMATE, DIV multiplies by a reciprocal estimated from
+// the divisor's bits and refined by divRefineSteps Newton-Raphson steps.
+// The quotient, before the factor, is then within DIV_ULP_BOUND[steps] ULP
+// of the IEEE quotient:
+//
+//   steps  bound (ULP)  relative error
+//   0      850000       5.1e-2
+//   1      43000        2.6e-3
+//   2      112          6.6e-6
+//   3      2            1.2e-7
+//
+// for every divisor and dividend, except that quotients of magnitude 2^127
+// or more may overflow to infinity one rounding early or late. Divisors
+// that are zero, infinite, NaN, subnormal or of magnitude 2^125 or more,
+// where the estimate does not hold, are divided exactly, as are all DIV
+// requests with DivMode::PRECISE.
+// ======================================================================
+
+#ifndef MathModule_MathKernels_HPP
+#define MathModule_MathKernels_HPP
+
+#include "Types/MathOpEnumAc.hpp"
+#include "Types/MathSettingsSerializableAc.hpp"
+
+namespace MathModule {
+
+  namespace MathKernels {
+
+    //! Most refinement steps of APPROXIMATE division; a larger divRefineSteps uses this many
+    const U8 MAX_DIV_REFINE_STEPS = 3;
+
+    //! Error bound of APPROXIMATE division in ULP of the quotient, by refinement steps
+    const U32 DIV_ULP_BOUND[MAX_DIV_REFINE_STEPS + 1] = {850000, 43000, 112, 2};
+
+    //! Compute one request
+    //! \return (val1 op val2) * factor
+    F32 apply(
+        MathOp::T op, //!< The operation
+        F32 val1, //!< The first operand
+        F32 val2, //!< The second operand
+        const MathSettings& settings //!< The factor and division mode
+    );
+
+    //! Compute a batch of requests with the same operation
+    void apply(
+        MathOp::T op, //!< The operation of every request
+        const F32* val1, //!< First operands
+        const F32* val2, //!< Second operands
+        const MathSettings& settings, //!< The factor and division mode
+        F32* result, //!< Filled with the results; must not overlap the operands
+        U32 count //!< Number of requests
+    );
+
+  }
+
+}
+
+#endif
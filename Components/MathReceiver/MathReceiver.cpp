@@ -5,6 +5,8 @@
 // ======================================================================
 
 #include "Components/MathReceiver/MathReceiver.hpp"
+#include "Components/MathReceiver/MathKernels.hpp"
+#include "Components/Tracer/Trace.hpp"
 
 namespace MathModule {
 
@@ -14,7 +16,8 @@ namespace MathModule {
 
   MathReceiver ::
     MathReceiver(const char* const compName) :
-      MathReceiverComponentBase(compName)
+      MathReceiverComponentBase(compName),
+      m_settingsStale(true)
   {
 
   }
@@ -31,12 +34,12 @@ namespace MathModule {
 
   /*
     MathOpIn_Handler does the following:
-      1. Compute an initial result based on the input values and the requested operation.
-      2. Get the value of the factor parameter. Check that the value is a valid value
-         from the parameter database or a default parameter value.
-      3. Multiply the initial result by the factor to generate the final result.
-      4. Emit telemetry and events.
-      5. Emit the results.
+      1. Get the values of the factor and division parameters. They are cached in
+         m_settings and read from the parameters again only after one changed.
+      2. Compute the result of the requested operation on the input values, multiplied
+         by the factor. MathKernels holds the arithmetic so batch jobs compute the same.
+      3. Emit telemetry and events.
+      4. Emit the results.
   */
   void MathReceiver ::
     mathOpIn_handler(
@@ -46,46 +49,38 @@ namespace MathModule {
         F32 val2
     )
   {
-    // Get the initial result
-    F32 res = 0.0;
+    MATH_TRACE_SCOPE("mathReceiver.mathOpIn");
+    MATH_TRACE_DISPATCH("mathReceiver.mathOpIn");
 
-    switch(op.e) {
-      case MathOp::ADD:
-        res = val1 + val2;
-        break;
-      case MathOp::SUB:
-        res = val1 - val2;
-        break;
-      case MathOp::DIV:
-        res = val1 / val2;
-        break;
-      case MathOp::MUL:
-        res = val1 * val2;
-        break;
-      default:
-        FW_ASSERT(0, op.e);
-        break;
-    } // end of switch
-
-    // Get the factor value
-    Fw::ParamValid valid;
-    F32 factor = paramGet_FACTOR(valid);
-    FW_ASSERT(
-      valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT, 
-      valid.e
-    );
+    // Get the factor and division mode
+    if (this->m_settingsStale.load(std::memory_order_acquire)) {
+      this->m_settingsStale.store(false, std::memory_order_relaxed);
+      this->m_settings = this->getSettings();
+    }
 
-    // Multiply result by factor
-    res *= factor;
+    // Compute the result, multiplied by the factor
+    const F32 res = MathKernels::apply(op.e, val1, val2, this->m_settings);
 
     // Emit telemetry and events
     this->log_ACTIVITY_HI_OPERATION_PERFORMED(op);
     this->tlmWrite_OPERATION(op);
 
     // Emit result
+    MATH_TRACE_ENQUEUE("mathSender.mathResultIn");
     this->mathResultOut_out(0, res);
   }
 
+  /*
+    settingsGet_handler runs on the caller's thread. The parameter gets are
+    guarded by the component base, so a batch job may read the settings while
+    this component handles requests.
+  */
+  MathSettings MathReceiver ::
+    settingsGet_handler(const NATIVE_INT_TYPE portNum)
+  {
+    return this->getSettings();
+  }
+
   /*
     schedIn_handler dispatches all the messages in the queue. 
     For queued components, we have to do this dispatch explicitly in the
@@ -97,6 +92,7 @@ namespace MathModule {
         NATIVE_UINT_TYPE context
     )
   {
+    MATH_TRACE_SCOPE("mathReceiver.schedIn");
     U32 numMsgs = this->m_queue.getMessagesAvailable();
     for (U32 i = 0; i < numMsgs; ++i)
     {
@@ -109,7 +105,12 @@ namespace MathModule {
     parameter is updated by command
 
     if parameter identifier is PARAMID_FACTOR - get parameter value and emit event report
+    if parameter identifier is PARAMID_DIV_MODE or PARAMID_DIV_REFINE_STEPS - get both
+    division parameter values and emit event report
     otherwise, fail assertion, code will not run
+
+    Parameter commands run on the command dispatcher's thread, so the cached
+    settings are only marked stale here and reloaded by mathOpIn.
   */
  void MathReceiver ::
   parameterUpdated(FwPrmIdType id)
@@ -125,10 +126,23 @@ namespace MathModule {
         this->log_ACTIVITY_HI_FACTOR_UPDATED(val);
         break;
       }
+      case PARAMID_DIV_MODE:
+      case PARAMID_DIV_REFINE_STEPS:{
+        const MathSettings settings = this->getSettings();
+        this->log_ACTIVITY_HI_DIV_MODE_UPDATED(settings.getdivMode(), settings.getdivRefineSteps());
+        break;
+      }
       default:
         FW_ASSERT(0, id);
         break;
     }
+    this->m_settingsStale.store(true, std::memory_order_release);
+  }
+
+  void MathReceiver ::
+    parametersLoaded()
+  {
+    this->m_settingsStale.store(true, std::memory_order_release);
   }
 
   // ----------------------------------------------------------------------
@@ -152,4 +166,30 @@ namespace MathModule {
     // reply with completion status
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  MathSettings MathReceiver ::
+    getSettings()
+  {
+    Fw::ParamValid valid;
+    const F32 factor = this->paramGet_FACTOR(valid);
+    FW_ASSERT(
+      valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+      valid.e
+    );
+    const DivMode divMode = this->paramGet_DIV_MODE(valid);
+    FW_ASSERT(
+      valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+      valid.e
+    );
+    const U8 divRefineSteps = this->paramGet_DIV_REFINE_STEPS(valid);
+    FW_ASSERT(
+      valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+      valid.e
+    );
+    return MathSettings(factor, divMode, divRefineSteps);
+  }
 }
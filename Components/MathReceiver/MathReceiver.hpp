@@ -8,6 +8,7 @@
 #define MathModule_MathReceiver_HPP
 
 #include "Components/MathReceiver/MathReceiverComponentAc.hpp"
+#include <atomic>
 
 namespace MathModule {
 
@@ -45,6 +46,13 @@ namespace MathModule {
           F32 val2 //!< The second operand
       ) override;
 
+      //! Handler implementation for settingsGet
+      //!
+      //! The factor and division mode applied to every result, for batch jobs
+      MathSettings settingsGet_handler(
+          const NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
       //! Handler implementation for schedIn
       //!
       //! The rate group scheduler input
@@ -57,6 +65,8 @@ namespace MathModule {
           FwPrmIdType id
       ) override;
 
+      void parametersLoaded() override;
+
     PRIVATE:
 
       // ----------------------------------------------------------------------
@@ -70,6 +80,27 @@ namespace MathModule {
           const FwOpcodeType opCode, //!< The opcode
           const U32 cmdSeq //!< The command sequence number
       ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! The FACTOR, DIV_MODE and DIV_REFINE_STEPS parameters
+      MathSettings getSettings();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The settings applied by mathOpIn, read on the component thread only
+      MathSettings m_settings;
+
+      //! Set when a parameter changes, so mathOpIn reloads m_settings
+      std::atomic<bool> m_settingsStale;
   };
 
 }
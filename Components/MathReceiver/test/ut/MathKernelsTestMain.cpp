@@ -0,0 +1,195 @@
+// ======================================================================
+// \title  MathKernelsTestMain.cpp
+// \author cindy
+// \brief  cpp file for the MathKernels test main function
+// ======================================================================
+
+#include "Components/MathReceiver/MathKernels.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+
+  using MathModule::DivMode;
+  using MathModule::MathOp;
+  using MathModule::MathSettings;
+  namespace MathKernels = MathModule::MathKernels;
+
+  //! Operands computed per kernel call
+  const U32 BATCH = 4096;
+
+  //! Step between the divisor bit patterns of the full range sweep; odd, so every exponent and sign is visited
+  const U32 SWEEP_STRIDE = 251;
+
+  F32 toF32(U32 bits)
+  {
+    F32 val;
+    memcpy(&val, &bits, sizeof(val));
+    return val;
+  }
+
+  U32 toBits(F32 val)
+  {
+    U32 bits;
+    memcpy(&bits, &val, sizeof(bits));
+    return bits;
+  }
+
+  //! Position of a float in the ordered sequence of floats, so ULP distance is a subtraction
+  I64 ordinal(F32 val)
+  {
+    const I32 bits = static_cast<I32>(toBits(val));
+    return (bits < 0) ? static_cast<I64>(std::numeric_limits<I32>::min()) - bits : bits;
+  }
+
+  //! Distance in ULP between an approximate and an exact quotient
+  //! \return 0 if both are NaN, the largest U64 if only one is
+  U64 ulpDistance(F32 approximate, F32 exact)
+  {
+    if (std::isnan(approximate) || std::isnan(exact)) {
+      return (std::isnan(approximate) && std::isnan(exact)) ? 0 : std::numeric_limits<U64>::max();
+    }
+    const I64 distance = ordinal(approximate) - ordinal(exact);
+    return static_cast<U64>((distance < 0) ? -distance : distance);
+  }
+
+  //! Bit patterns spread over every float, infinities, NaNs and subnormals included
+  U32 nextBits(U32& state)
+  {
+    state = state * 1664525 + 1013904223;
+    return state ^ (state >> 15);
+  }
+
+  //! Worst error of APPROXIMATE division over divisors swept across every bit pattern
+  U64 worstDivError(U8 steps)
+  {
+    const MathSettings settings(1.0f, DivMode::APPROXIMATE, steps);
+    std::vector<F32> dividends(BATCH);
+    std::vector<F32> divisors(BATCH);
+    std::vector<F32> quotients(BATCH);
+    U32 state = steps;
+    U64 worst = 0;
+    U64 divisor = 0;
+    while (divisor <= 0xFFFFFFFFULL) {
+      U32 count = 0;
+      for (; (count < BATCH) && (divisor <= 0xFFFFFFFFULL); count++, divisor += SWEEP_STRIDE) {
+        dividends[count] = toF32(nextBits(state));
+        divisors[count] = toF32(static_cast<U32>(divisor));
+      }
+      MathKernels::apply(MathOp::DIV, dividends.data(), divisors.data(), settings, quotients.data(), count);
+      for (U32 i = 0; i < count; i++) {
+        // The bound excludes quotients that may round to infinity
+        const F64 exact = static_cast<F64>(dividends[i]) / static_cast<F64>(divisors[i]);
+        if (std::fabs(exact) >= std::ldexp(1.0, 127)) {
+          continue;
+        }
+        const U64 error = ulpDistance(quotients[i], dividends[i] / divisors[i]);
+        EXPECT_LE(error, MathKernels::DIV_ULP_BOUND[steps])
+          << dividends[i] << " / " << divisors[i] << " gave " << quotients[i] << " with " << static_cast<U32>(steps)
+          << " steps";
+        if (error > worst) {
+          worst = error;
+          if (error > MathKernels::DIV_ULP_BOUND[steps]) {
+            return worst;
+          }
+        }
+      }
+    }
+    return worst;
+  }
+
+}
+
+TEST(MathKernels, PreciseIsIeee) {
+  const MathSettings settings(2.5f, DivMode::PRECISE, 0);
+  std::vector<F32> val1(BATCH);
+  std::vector<F32> val2(BATCH);
+  std::vector<F32> result(BATCH);
+  U32 state = 1;
+  for (U32 i = 0; i < BATCH; i++) {
+    val1[i] = toF32(nextBits(state));
+    val2[i] = toF32(nextBits(state));
+  }
+  const MathOp::T ops[] = {MathOp::ADD, MathOp::SUB, MathOp::MUL, MathOp::DIV};
+  for (const MathOp::T op : ops) {
+    MathKernels::apply(op, val1.data(), val2.data(), settings, result.data(), BATCH);
+    for (U32 i = 0; i < BATCH; i++) {
+      F32 expected = 0.0f;
+      switch (op) {
+        case MathOp::ADD:
+          expected = (val1[i] + val2[i]) * 2.5f;
+          break;
+        case MathOp::SUB:
+          expected = (val1[i] - val2[i]) * 2.5f;
+          break;
+        case MathOp::MUL:
+          expected = (val1[i] * val2[i]) * 2.5f;
+          break;
+        default:
+          expected = (val1[i] / val2[i]) * 2.5f;
+          break;
+      }
+      ASSERT_EQ(ulpDistance(result[i], expected), 0U) << "op " << op << " record " << i;
+      // The single form gives the same bits
+      ASSERT_EQ(ulpDistance(MathKernels::apply(op, val1[i], val2[i], settings), result[i]), 0U);
+    }
+  }
+}
+
+TEST(MathKernels, ApproximateDivBound) {
+  for (U8 steps = 0; steps <= MathKernels::MAX_DIV_REFINE_STEPS; steps++) {
+    const U64 worst = worstDivError(steps);
+    EXPECT_LE(worst, MathKernels::DIV_ULP_BOUND[steps]) << static_cast<U32>(steps) << " steps";
+    // The bound is close to what the steps achieve, not just loose
+    EXPECT_GE(worst, MathKernels::DIV_ULP_BOUND[steps] / 2) << static_cast<U32>(steps) << " steps";
+  }
+}
+
+TEST(MathKernels, ApproximateDivExactOutsideEstimateRange) {
+  const MathSettings approximate(1.0f, DivMode::APPROXIMATE, 0);
+  const F32 divisors[] = {
+    0.0f, -0.0f,
+    std::numeric_limits<F32>::infinity(), -std::numeric_limits<F32>::infinity(),
+    std::numeric_limits<F32>::quiet_NaN(),
+    std::numeric_limits<F32>::denorm_min(), -std::numeric_limits<F32>::denorm_min(), toF32(0x007FFFFF),
+    std::ldexp(1.0f, 125), -std::ldexp(1.5f, 126), std::numeric_limits<F32>::max()
+  };
+  const F32 dividends[] = {1.0f, -3.0f, 0.0f, std::numeric_limits<F32>::infinity(), 1.0e-30f, 3.0e38f};
+  for (const F32 divisor : divisors) {
+    for (const F32 dividend : dividends) {
+      const F32 quotient = MathKernels::apply(MathOp::DIV, dividend, divisor, approximate);
+      EXPECT_EQ(ulpDistance(quotient, dividend / divisor), 0U) << dividend << " / " << divisor;
+    }
+  }
+}
+
+TEST(MathKernels, ApproximateDivSettings) {
+  // Steps past the most refine as much as the most
+  const MathSettings most(3.0f, DivMode::APPROXIMATE, MathKernels::MAX_DIV_REFINE_STEPS);
+  const MathSettings past(3.0f, DivMode::APPROXIMATE, 200);
+  const MathSettings none(3.0f, DivMode::APPROXIMATE, 0);
+  U32 state = 7;
+  U32 differ = 0;
+  for (U32 i = 0; i < BATCH; i++) {
+    const F32 val1 = toF32(0x3F800000 | (nextBits(state) & 0x007FFFFF));
+    const F32 val2 = toF32(0x3F800000 | (nextBits(state) & 0x007FFFFF));
+    const F32 refined = MathKernels::apply(MathOp::DIV, val1, val2, most);
+    ASSERT_EQ(toBits(MathKernels::apply(MathOp::DIV, val1, val2, past)), toBits(refined));
+    // The factor applies to the approximate quotient like to the precise one
+    EXPECT_LE(ulpDistance(refined, (val1 / val2) * 3.0f), MathKernels::DIV_ULP_BOUND[MathKernels::MAX_DIV_REFINE_STEPS] + 1);
+    if (toBits(MathKernels::apply(MathOp::DIV, val1, val2, none)) != toBits(refined)) {
+      differ++;
+    }
+  }
+  EXPECT_GT(differ, BATCH / 2);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
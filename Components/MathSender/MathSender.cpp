@@ -5,6 +5,7 @@
 // ======================================================================
 
 #include "Components/MathSender/MathSender.hpp"
+#include "Components/Tracer/Trace.hpp"
 
 namespace MathModule {
 
@@ -35,6 +36,8 @@ namespace MathModule {
         F32 result
     )
   {
+    MATH_TRACE_SCOPE("mathSender.mathResultIn");
+    MATH_TRACE_DISPATCH("mathSender.mathResultIn");
     this->tlmWrite_RESULT(result);
     this->log_ACTIVITY_HI_RESULT(result);
   }
@@ -52,10 +55,13 @@ namespace MathModule {
         F32 val2
     )
   {
+    MATH_TRACE_SCOPE("mathSender.DO_MATH");
+    MATH_TRACE_FLOW_END("command", cmdSeq);
     this->tlmWrite_VAL1(val1);
     this->tlmWrite_OP(op);
     this->tlmWrite_VAL2(val2);
     this->log_ACTIVITY_LO_COMMAND_RECV(val1, op, val2);
+    MATH_TRACE_ENQUEUE("mathReceiver.mathOpIn");
     this->mathOpOut_out(0, val1, op, val2);
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
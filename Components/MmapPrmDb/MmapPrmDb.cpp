@@ -0,0 +1,508 @@
+// ======================================================================
+// \title  MmapPrmDb.cpp
+// \author cindy
+// \brief  cpp file for MmapPrmDb component implementation class
+// ======================================================================
+
+#include "Components/MmapPrmDb/MmapPrmDb.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 MmapPrmDb::NUM_ENTRIES;
+  const U8 MmapPrmDb::ENTRY_DELIMITER;
+  const U32 MmapPrmDb::RECORD_HEADER_SIZE;
+  const U32 MmapPrmDb::SAVE_BUFFER_SIZE;
+  const U32 MmapPrmDb::NUM_SAVE_BUFFERS;
+
+  namespace {
+
+    U32 readU32(const U8* src) {
+      return (static_cast<U32>(src[0]) << 24) | (static_cast<U32>(src[1]) << 16) |
+             (static_cast<U32>(src[2]) << 8) | static_cast<U32>(src[3]);
+    }
+
+    void writeU32(U8* dst, U32 val) {
+      dst[0] = static_cast<U8>(val >> 24);
+      dst[1] = static_cast<U8>(val >> 16);
+      dst[2] = static_cast<U8>(val >> 8);
+      dst[3] = static_cast<U8>(val);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  MmapPrmDb ::
+    MmapPrmDb(const char* const compName) :
+      MmapPrmDbComponentBase(compName),
+      m_map(nullptr),
+      m_mapSize(0),
+      m_saveTaskRunning(false),
+      m_saveCount(0),
+      m_recordsValidated(0)
+  {
+    for (U32 i = 0; i < NUM_ENTRIES; ++i) {
+      this->m_entries[i].state = ENTRY_EMPTY;
+      this->m_entries[i].id = 0;
+      this->m_entries[i].offset = 0;
+      this->m_entries[i].recordSize = 0;
+    }
+    for (U32 i = 0; i < NUM_SAVE_BUFFERS; ++i) {
+      this->m_saveBusy[i] = false;
+    }
+  }
+
+  MmapPrmDb ::
+    ~MmapPrmDb()
+  {
+    this->unmap();
+  }
+
+  void MmapPrmDb ::
+    configure(const char* file)
+  {
+    FW_ASSERT(file != nullptr);
+    this->m_fileName = file;
+
+    if (!this->m_saveTaskRunning) {
+      Os::QueueString queueName("PrmSaveQ");
+      Os::Queue::QueueStatus qStat =
+        this->m_saveQueue.create(queueName, NUM_SAVE_BUFFERS + 1, sizeof(SaveRequest));
+      FW_ASSERT(qStat == Os::Queue::QUEUE_OK, qStat);
+
+      Os::TaskString taskName("PrmSave");
+      Os::Task::TaskStatus tStat = this->m_saveTask.start(taskName, MmapPrmDb::saveTask, this);
+      FW_ASSERT(tStat == Os::Task::TASK_OK, tStat);
+      this->m_saveTaskRunning = true;
+    }
+  }
+
+  /*
+    readParamFile maps the file read-only and walks the record headers to build
+    the id -> offset index. Values stay in the page cache until first requested,
+    so startup cost is proportional to the number of records, not their size.
+    The record layout matches Svc::PrmDb: delimiter, U32 record size, U32 id, value.
+  */
+  void MmapPrmDb ::
+    readParamFile()
+  {
+    I32 error = 0;
+    U32 records = 0;
+    bool full = false;
+    FwPrmIdType fullId = 0;
+
+    this->m_lock.lock();
+    this->unmap();
+    for (U32 i = 0; i < NUM_ENTRIES; ++i) {
+      this->m_entries[i].state = ENTRY_EMPTY;
+    }
+
+    const int fd = ::open(this->m_fileName.toChar(), O_RDONLY);
+    struct stat info;
+    if (fd < 0) {
+      error = errno;
+    } else if (::fstat(fd, &info) != 0) {
+      error = errno;
+    } else if (info.st_size > 0) {
+      void* map = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) {
+        error = errno;
+      } else {
+        this->m_map = static_cast<const U8*>(map);
+        this->m_mapSize = static_cast<U32>(info.st_size);
+      }
+    }
+    if (fd >= 0) {
+      (void) ::close(fd);
+    }
+
+    U32 offset = 0;
+    while ((this->m_map != nullptr) && (offset + RECORD_HEADER_SIZE <= this->m_mapSize)) {
+      const U8* header = this->m_map + offset;
+      if (header[0] != ENTRY_DELIMITER) {
+        break;
+      }
+      const U32 recordSize = readU32(header + sizeof(U8));
+      if ((recordSize < sizeof(U32)) || (recordSize > this->m_mapSize - offset - sizeof(U8) - sizeof(U32))) {
+        break;
+      }
+      const FwPrmIdType id = readU32(header + sizeof(U8) + sizeof(U32));
+      Entry* entry = this->find(id);
+      for (U32 i = 0; (entry == nullptr) && (i < NUM_ENTRIES); ++i) {
+        if (this->m_entries[i].state == ENTRY_EMPTY) {
+          entry = &this->m_entries[i];
+        }
+      }
+      if (entry == nullptr) {
+        full = true;
+        fullId = id;
+        break;
+      }
+      entry->state = ENTRY_UNCHECKED;
+      entry->id = id;
+      entry->offset = offset;
+      entry->recordSize = recordSize;
+      offset += sizeof(U8) + sizeof(U32) + recordSize;
+      ++records;
+    }
+    this->m_lock.unLock();
+
+    if (error != 0) {
+      this->log_WARNING_HI_PARAM_FILE_READ_ERROR(error);
+      return;
+    }
+    if (full) {
+      this->log_WARNING_HI_PARAM_DB_FULL(fullId);
+    }
+    this->log_ACTIVITY_HI_PARAM_FILE_LOADED(records);
+  }
+
+  void MmapPrmDb ::
+    shutdownWriter()
+  {
+    if (!this->m_saveTaskRunning) {
+      return;
+    }
+    SaveRequest quit;
+    memset(&quit, 0, sizeof(quit));
+    quit.bufferIndex = NUM_SAVE_BUFFERS;
+    (void) this->m_saveQueue.send(reinterpret_cast<const U8*>(&quit), sizeof(quit), 0,
+                                  Os::Queue::QUEUE_BLOCKING);
+    (void) this->m_saveTask.join(nullptr);
+    this->m_saveTaskRunning = false;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  Fw::ParamValid MmapPrmDb ::
+    getPrm_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwPrmIdType id,
+        Fw::ParamBuffer& val
+    )
+  {
+    Fw::ParamValid result = Fw::ParamValid::INVALID;
+    bool invalidRecord = false;
+    U32 recordOffset = 0;
+
+    this->m_lock.lock();
+    Entry* entry = this->find(id);
+    if (entry != nullptr) {
+      if (this->materialize(*entry)) {
+        val = entry->value;
+        result = Fw::ParamValid::VALID;
+      } else {
+        invalidRecord = true;
+        recordOffset = entry->offset;
+      }
+    }
+    const U32 validated = this->m_recordsValidated;
+    this->m_lock.unLock();
+
+    if (entry == nullptr) {
+      this->log_WARNING_LO_PARAM_ID_NOT_FOUND(id);
+    } else if (invalidRecord) {
+      this->log_WARNING_HI_PARAM_RECORD_INVALID(id, recordOffset);
+    } else {
+      this->tlmWrite_RECORDS_VALIDATED(validated);
+    }
+    return result;
+  }
+
+  void MmapPrmDb ::
+    setPrm_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwPrmIdType id,
+        Fw::ParamBuffer& val
+    )
+  {
+    bool added = false;
+
+    this->m_lock.lock();
+    Entry* entry = this->find(id);
+    for (U32 i = 0; (entry == nullptr) && (i < NUM_ENTRIES); ++i) {
+      if (this->m_entries[i].state == ENTRY_EMPTY) {
+        entry = &this->m_entries[i];
+        entry->id = id;
+        added = true;
+      }
+    }
+    if (entry != nullptr) {
+      entry->value = val;
+      entry->state = ENTRY_CACHED;
+    }
+    this->m_lock.unLock();
+
+    if (entry == nullptr) {
+      this->log_WARNING_HI_PARAM_DB_FULL(id);
+    } else if (added) {
+      this->log_ACTIVITY_HI_PARAM_ID_ADDED(id);
+    } else {
+      this->log_ACTIVITY_HI_PARAM_ID_UPDATED(id);
+    }
+  }
+
+  void MmapPrmDb ::
+    pingIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 key
+    )
+  {
+    this->pingOut_out(0, key);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for internal ports
+  // ----------------------------------------------------------------------
+
+  /*
+    The save task only writes the file. It reports the result through this
+    port so that the events, telemetry and command response come from the
+    component's own thread, like those of every other command.
+  */
+  void MmapPrmDb ::
+    saveDone_internalInterfaceHandler(
+        U32 bufferIndex,
+        U32 records,
+        U32 usec,
+        I32 error,
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    FW_ASSERT(bufferIndex < NUM_SAVE_BUFFERS, bufferIndex);
+    this->m_saveBusy[bufferIndex] = false;
+
+    if (error != 0) {
+      this->log_WARNING_HI_PARAM_FILE_WRITE_ERROR(error);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    ++this->m_saveCount;
+    this->log_ACTIVITY_HI_PARAM_FILE_SAVED(records, usec);
+    this->tlmWrite_SAVE_COUNT(this->m_saveCount);
+    this->tlmWrite_SAVE_TIME(usec);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  /*
+    PRM_SAVE_FILE_cmdHandler serializes the table into whichever save buffer is
+    idle and hands it to the save task. The disk write, fsync and rename happen
+    on that task, so neither this thread nor parameter get/set callers wait on
+    storage. The buffer stays busy, and the command unanswered, until the save
+    task reports the file durable through saveDone.
+  */
+  void MmapPrmDb ::
+    PRM_SAVE_FILE_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    SaveRequest request;
+    memset(&request, 0, sizeof(request));
+    request.bufferIndex = NUM_SAVE_BUFFERS;
+    request.opCode = opCode;
+    request.cmdSeq = cmdSeq;
+
+    for (U32 i = 0; i < NUM_SAVE_BUFFERS; ++i) {
+      if (!this->m_saveBusy[i]) {
+        request.bufferIndex = i;
+        break;
+      }
+    }
+    if (request.bufferIndex < NUM_SAVE_BUFFERS) {
+      this->m_lock.lock();
+      U8* image = this->m_saveBuffers[request.bufferIndex];
+      for (U32 i = 0; i < NUM_ENTRIES; ++i) {
+        Entry& entry = this->m_entries[i];
+        if ((entry.state == ENTRY_UNCHECKED) && !this->materialize(entry)) {
+          continue;
+        }
+        if (entry.state != ENTRY_CACHED) {
+          continue;
+        }
+        const U32 valueSize = entry.value.getBuffLength();
+        FW_ASSERT(request.size + RECORD_HEADER_SIZE + valueSize <= SAVE_BUFFER_SIZE, request.size, valueSize);
+        image[request.size] = ENTRY_DELIMITER;
+        writeU32(image + request.size + sizeof(U8), sizeof(U32) + valueSize);
+        writeU32(image + request.size + sizeof(U8) + sizeof(U32), entry.id);
+        memcpy(image + request.size + RECORD_HEADER_SIZE, entry.value.getBuffAddr(), valueSize);
+        request.size += RECORD_HEADER_SIZE + valueSize;
+        ++request.records;
+      }
+      this->m_lock.unLock();
+      this->m_saveBusy[request.bufferIndex] = true;
+    }
+
+    if (request.bufferIndex >= NUM_SAVE_BUFFERS) {
+      this->log_WARNING_LO_PARAM_SAVE_BUSY();
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+      return;
+    }
+
+    const Os::Queue::QueueStatus status = this->m_saveQueue.send(
+      reinterpret_cast<const U8*>(&request), sizeof(request), 0, Os::Queue::QUEUE_NONBLOCKING);
+    if (status != Os::Queue::QUEUE_OK) {
+      this->m_saveBusy[request.bufferIndex] = false;
+      this->log_WARNING_LO_PARAM_SAVE_BUSY();
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  bool MmapPrmDb ::
+    materialize(Entry& entry)
+  {
+    if (entry.state == ENTRY_CACHED) {
+      return true;
+    }
+    if (entry.state != ENTRY_UNCHECKED) {
+      return false;
+    }
+    FW_ASSERT(this->m_map != nullptr);
+    const U32 valueOffset = entry.offset + RECORD_HEADER_SIZE;
+    const U32 valueSize = entry.recordSize - sizeof(U32);
+    if ((valueSize > entry.value.getBuffCapacity()) ||
+        (valueOffset + valueSize > this->m_mapSize) ||
+        (entry.value.setBuff(this->m_map + valueOffset, valueSize) != Fw::FW_SERIALIZE_OK)) {
+      entry.state = ENTRY_INVALID;
+      return false;
+    }
+    entry.state = ENTRY_CACHED;
+    ++this->m_recordsValidated;
+    return true;
+  }
+
+  MmapPrmDb::Entry* MmapPrmDb ::
+    find(FwPrmIdType id)
+  {
+    for (U32 i = 0; i < NUM_ENTRIES; ++i) {
+      if ((this->m_entries[i].state != ENTRY_EMPTY) && (this->m_entries[i].id == id)) {
+        return &this->m_entries[i];
+      }
+    }
+    return nullptr;
+  }
+
+  void MmapPrmDb ::
+    unmap()
+  {
+    if (this->m_map != nullptr) {
+      (void) ::munmap(const_cast<U8*>(this->m_map), this->m_mapSize);
+      this->m_map = nullptr;
+      this->m_mapSize = 0;
+    }
+  }
+
+  /*
+    writeImage never modifies the live file: the image is written to
+    "<file>.tmp", synced, and renamed over the original. A crash at any point
+    leaves either the old or the new file intact. Any existing mapping keeps
+    referring to the old inode, so lazily validated entries stay readable.
+  */
+  I32 MmapPrmDb ::
+    writeImage(const U8* image, U32 size)
+  {
+    const char* fileName = this->m_fileName.toChar();
+    char tmpName[FW_FIXED_LENGTH_STRING_SIZE + sizeof(".tmp")];
+    (void) snprintf(tmpName, sizeof(tmpName), "%s.tmp", fileName);
+
+    const int fd = ::open(tmpName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      return errno;
+    }
+    I32 error = 0;
+    U32 written = 0;
+    while ((error == 0) && (written < size)) {
+      const ssize_t count = ::write(fd, image + written, size - written);
+      if (count < 0) {
+        error = (errno == EINTR) ? 0 : errno;
+      } else {
+        written += static_cast<U32>(count);
+      }
+    }
+    if ((error == 0) && (::fsync(fd) != 0)) {
+      error = errno;
+    }
+    (void) ::close(fd);
+    if ((error == 0) && (::rename(tmpName, fileName) != 0)) {
+      error = errno;
+    }
+    if (error != 0) {
+      (void) ::unlink(tmpName);
+      return error;
+    }
+
+    // Persist the rename itself by syncing the containing directory
+    char dirName[FW_FIXED_LENGTH_STRING_SIZE];
+    (void) snprintf(dirName, sizeof(dirName), "%s", fileName);
+    char* slash = strrchr(dirName, '/');
+    if (slash == nullptr) {
+      (void) snprintf(dirName, sizeof(dirName), ".");
+    } else if (slash == dirName) {
+      slash[1] = '\0';
+    } else {
+      slash[0] = '\0';
+    }
+    const int dirFd = ::open(dirName, O_RDONLY);
+    if (dirFd >= 0) {
+      (void) ::fsync(dirFd);
+      (void) ::close(dirFd);
+    }
+    return 0;
+  }
+
+  void MmapPrmDb ::
+    saveTask(void* arg)
+  {
+    MmapPrmDb* db = static_cast<MmapPrmDb*>(arg);
+    FW_ASSERT(db != nullptr);
+
+    while (true) {
+      SaveRequest request;
+      NATIVE_INT_TYPE size = 0;
+      NATIVE_INT_TYPE priority = 0;
+      const Os::Queue::QueueStatus status = db->m_saveQueue.receive(
+        reinterpret_cast<U8*>(&request), sizeof(request), size, priority, Os::Queue::QUEUE_BLOCKING);
+      if ((status != Os::Queue::QUEUE_OK) || (request.bufferIndex >= NUM_SAVE_BUFFERS)) {
+        break;
+      }
+
+      const U64 start = nowUsec();
+      const I32 error = db->writeImage(db->m_saveBuffers[request.bufferIndex], request.size);
+      const U32 usec = static_cast<U32>(FW_MIN(nowUsec() - start, static_cast<U64>(0xFFFFFFFF)));
+      db->saveDone_internalInterfaceInvoke(request.bufferIndex, request.records, usec, error, request.opCode,
+                                           request.cmdSeq);
+    }
+  }
+
+  U64 MmapPrmDb ::
+    nowUsec()
+  {
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<U64>(now.tv_sec) * 1000000U + static_cast<U64>(now.tv_nsec) / 1000U;
+  }
+
+}
@@ -0,0 +1,234 @@
+// ======================================================================
+// \title  MmapPrmDb.hpp
+// \author cindy
+// \brief  hpp file for MmapPrmDb component implementation class
+// ======================================================================
+
+#ifndef MathModule_MmapPrmDb_HPP
+#define MathModule_MmapPrmDb_HPP
+
+#include "Components/MmapPrmDb/MmapPrmDbComponentAc.hpp"
+#include <Fw/Types/String.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Queue.hpp>
+#include <Os/Task.hpp>
+
+namespace MathModule {
+
+  class MmapPrmDb :
+    public MmapPrmDbComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Maximum number of parameters held by the database
+      static const U32 NUM_ENTRIES = 32;
+
+      //! Record delimiter, shared with Svc::PrmDb so files are interchangeable
+      static const U8 ENTRY_DELIMITER = 0xA5;
+
+      //! Record header: delimiter, record size, parameter id
+      static const U32 RECORD_HEADER_SIZE = sizeof(U8) + sizeof(U32) + sizeof(U32);
+
+      //! Capacity of one save buffer
+      static const U32 SAVE_BUFFER_SIZE = NUM_ENTRIES * (RECORD_HEADER_SIZE + FW_PARAM_BUFFER_MAX_SIZE);
+
+      //! Number of save buffers; one can be filled while the other is written
+      static const U32 NUM_SAVE_BUFFERS = 2;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct MmapPrmDb object
+      MmapPrmDb(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy MmapPrmDb object
+      ~MmapPrmDb();
+
+      //! Set the parameter file and start the save task
+      void configure(
+          const char* file //!< The parameter file path
+      );
+
+      //! Map the parameter file and index its records
+      //!
+      //! Only record headers are read here; values are validated and copied
+      //! out of the mapping the first time each parameter is requested.
+      void readParamFile();
+
+      //! Stop and join the save task. Call during teardown.
+      void shutdownWriter();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for getPrm
+      Fw::ParamValid getPrm_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwPrmIdType id, //!< The parameter id
+          Fw::ParamBuffer& val //!< Buffer receiving the value
+      ) override;
+
+      //! Handler implementation for setPrm
+      void setPrm_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwPrmIdType id, //!< The parameter id
+          Fw::ParamBuffer& val //!< The new value
+      ) override;
+
+      //! Handler implementation for pingIn
+      void pingIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          U32 key //!< Value to return to pinger
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for internal ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for saveDone
+      void saveDone_internalInterfaceHandler(
+          U32 bufferIndex, //!< The save buffer that was written
+          U32 records, //!< Records in the image
+          U32 usec, //!< Time spent writing, syncing and renaming, microseconds
+          I32 error, //!< 0 on success, otherwise the errno value
+          FwOpcodeType opCode, //!< Opcode of the PRM_SAVE_FILE command
+          U32 cmdSeq //!< Sequence number of the PRM_SAVE_FILE command
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command PRM_SAVE_FILE
+      void PRM_SAVE_FILE_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq //!< The command sequence number
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Where the current value of an entry lives
+      enum EntryState {
+        ENTRY_EMPTY, //!< Slot unused
+        ENTRY_UNCHECKED, //!< Value is in the mapping and has not been validated
+        ENTRY_CACHED, //!< Value has been copied into the entry
+        ENTRY_INVALID //!< Record in the mapping failed validation
+      };
+
+      //! One parameter slot
+      struct Entry {
+        EntryState state;
+        FwPrmIdType id;
+        U32 offset; //!< Offset of the record in the mapping
+        U32 recordSize; //!< Record size field from the file
+        Fw::ParamBuffer value;
+      };
+
+      //! Message passed to the save task
+      struct SaveRequest {
+        U32 bufferIndex; //!< Save buffer holding the image, or NUM_SAVE_BUFFERS to quit
+        U32 size; //!< Bytes of image in the buffer
+        U32 records; //!< Records in the image
+        FwOpcodeType opCode; //!< Opcode of the PRM_SAVE_FILE command
+        U32 cmdSeq; //!< Sequence number of the PRM_SAVE_FILE command
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Validate an unchecked entry and copy its value out of the mapping
+      //!
+      //! Called with m_lock held.
+      //! \return true if the entry holds a usable value
+      bool materialize(Entry& entry);
+
+      //! Find the slot for an id
+      //! \return the entry, or nullptr if absent
+      Entry* find(FwPrmIdType id);
+
+      //! Release the file mapping
+      void unmap();
+
+      //! Write an image to the temporary file, sync it, and rename it over the parameter file
+      //! \return 0 on success, otherwise the errno value
+      I32 writeImage(const U8* image, U32 size);
+
+      //! Save task entry point
+      static void saveTask(void* arg);
+
+      //! Monotonic clock in microseconds
+      static U64 nowUsec();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Guards the entry table and the mapping
+      Os::Mutex m_lock;
+
+      //! Parameter slots
+      Entry m_entries[NUM_ENTRIES];
+
+      //! Parameter file path
+      Fw::String m_fileName;
+
+      //! Start of the file mapping, or nullptr
+      const U8* m_map;
+
+      //! Size of the file mapping
+      U32 m_mapSize;
+
+      //! Images being handed to the save task
+      U8 m_saveBuffers[NUM_SAVE_BUFFERS][SAVE_BUFFER_SIZE];
+
+      //! Whether each save buffer is owned by the save task
+      //!
+      //! Only used on the component's thread: set by PRM_SAVE_FILE and cleared by saveDone.
+      bool m_saveBusy[NUM_SAVE_BUFFERS];
+
+      //! Requests to the save task
+      Os::Queue m_saveQueue;
+
+      //! Task writing images to disk
+      Os::Task m_saveTask;
+
+      //! Whether the save task is running
+      bool m_saveTaskRunning;
+
+      //! Completed saves
+      U32 m_saveCount;
+
+      //! File records validated so far
+      U32 m_recordsValidated;
+
+  };
+
+}
+
+#endif
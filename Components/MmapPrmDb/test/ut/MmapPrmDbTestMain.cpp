@@ -0,0 +1,37 @@
+// ======================================================================
+// \title  MmapPrmDbTestMain.cpp
+// \author cindy
+// \brief  cpp file for MmapPrmDb component test main function
+// ======================================================================
+
+#include "MmapPrmDbTester.hpp"
+
+TEST(Nominal, LazyValidation) {
+  MathModule::MmapPrmDbTester tester;
+  tester.testLazyValidation();
+}
+
+TEST(Nominal, Save) {
+  MathModule::MmapPrmDbTester tester;
+  tester.testSave();
+}
+
+TEST(OffNominal, MissingFile) {
+  MathModule::MmapPrmDbTester tester;
+  tester.testMissingFile();
+}
+
+TEST(OffNominal, SaveBusy) {
+  MathModule::MmapPrmDbTester tester;
+  tester.testSaveBusy();
+}
+
+TEST(OffNominal, WriteError) {
+  MathModule::MmapPrmDbTester tester;
+  tester.testWriteError();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
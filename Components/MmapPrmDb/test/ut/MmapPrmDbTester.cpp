@@ -0,0 +1,268 @@
+// ======================================================================
+// \title  MmapPrmDbTester.cpp
+// \author cindy
+// \brief  cpp file for MmapPrmDb component test harness implementation class
+// ======================================================================
+
+#include "MmapPrmDbTester.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MmapPrmDbTester ::
+    MmapPrmDbTester() :
+      MmapPrmDbGTestBase("MmapPrmDbTester", MmapPrmDbTester::MAX_HISTORY_SIZE),
+      component("MmapPrmDb")
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/MmapPrmDbTester.%d.dat", static_cast<int>(::getpid()));
+    this->m_file = path;
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(this->m_file.c_str());
+  }
+
+  MmapPrmDbTester ::
+    ~MmapPrmDbTester()
+  {
+    this->component.shutdownWriter();
+    const std::string tmpFile = this->m_file + ".tmp";
+    (void) ::unlink(this->m_file.c_str());
+    (void) ::unlink(tmpFile.c_str());
+    (void) ::rmdir(tmpFile.c_str());
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MmapPrmDbTester ::
+    testLazyValidation()
+  {
+    // The last value is larger than a parameter buffer, which indexing does not look at
+    const std::vector<Record> records = {
+      {0x100, {0, 0, 0, 7}},
+      {0x101, {0, 0, 0, 9}},
+      {0x102, std::vector<U8>(Fw::ParamBuffer().getBuffCapacity() + 1, 0xEE)}
+    };
+    const std::vector<U32> offsets = this->writeFile(records);
+    this->component.readParamFile();
+    ASSERT_EVENTS_PARAM_FILE_LOADED_SIZE(1);
+    ASSERT_EVENTS_PARAM_FILE_LOADED(0, 3);
+    ASSERT_TLM_RECORDS_VALIDATED_SIZE(0);
+
+    // A record is validated once, on its first request
+    this->expectU32(0x100, 7);
+    ASSERT_TLM_RECORDS_VALIDATED(0, 1);
+    this->expectU32(0x100, 7);
+    ASSERT_TLM_RECORDS_VALIDATED(1, 1);
+    this->expectU32(0x101, 9);
+    ASSERT_TLM_RECORDS_VALIDATED(2, 2);
+
+    // An invalid record reads as absent every time, so its owner keeps its default
+    for (U32 i = 0; i < 2; i++) {
+      Fw::ParamBuffer val;
+      ASSERT_EQ(this->invoke_to_getPrm(0, 0x102, val), Fw::ParamValid::INVALID);
+    }
+    ASSERT_EVENTS_PARAM_RECORD_INVALID_SIZE(2);
+    ASSERT_EVENTS_PARAM_RECORD_INVALID(0, 0x102, offsets[2]);
+    ASSERT_TLM_RECORDS_VALIDATED_SIZE(3);
+
+    Fw::ParamBuffer val;
+    ASSERT_EQ(this->invoke_to_getPrm(0, 0x103, val), Fw::ParamValid::INVALID);
+    ASSERT_EVENTS_PARAM_ID_NOT_FOUND_SIZE(1);
+    ASSERT_EVENTS_PARAM_ID_NOT_FOUND(0, 0x103);
+
+    // Setting the parameter replaces the invalid record
+    Fw::ParamBuffer replacement = this->u32Param(11);
+    this->invoke_to_setPrm(0, 0x102, replacement);
+    ASSERT_EVENTS_PARAM_ID_UPDATED_SIZE(1);
+    ASSERT_EVENTS_PARAM_ID_UPDATED(0, 0x102);
+    this->expectU32(0x102, 11);
+  }
+
+  void MmapPrmDbTester ::
+    testMissingFile()
+  {
+    this->component.readParamFile();
+    ASSERT_EVENTS_PARAM_FILE_READ_ERROR_SIZE(1);
+    ASSERT_EVENTS_PARAM_FILE_READ_ERROR(0, ENOENT);
+    ASSERT_EVENTS_PARAM_FILE_LOADED_SIZE(0);
+    Fw::ParamBuffer val;
+    ASSERT_EQ(this->invoke_to_getPrm(0, 0x100, val), Fw::ParamValid::INVALID);
+    ASSERT_EVENTS_PARAM_ID_NOT_FOUND_SIZE(1);
+  }
+
+  void MmapPrmDbTester ::
+    testSave()
+  {
+    (void) this->writeFile({{0x100, {0, 0, 0, 7}}});
+    this->component.readParamFile();
+    Fw::ParamBuffer added = this->u32Param(5);
+    this->invoke_to_setPrm(0, 0x200, added);
+    ASSERT_EVENTS_PARAM_ID_ADDED_SIZE(1);
+    ASSERT_EVENTS_PARAM_ID_ADDED(0, 0x200);
+
+    // The save task only writes; the response waits for the component to run its report
+    this->save(1);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    ASSERT_EVENTS_PARAM_FILE_SAVED_SIZE(0);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MmapPrmDb::OPCODE_PRM_SAVE_FILE, 1, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_PARAM_FILE_SAVED_SIZE(1);
+    EXPECT_EQ(this->eventHistory_PARAM_FILE_SAVED->at(0).records, 2U);
+    ASSERT_TLM_SAVE_COUNT_SIZE(1);
+    ASSERT_TLM_SAVE_COUNT(0, 1);
+    ASSERT_TLM_SAVE_TIME_SIZE(1);
+
+    // The record never requested is saved from the mapping, next to the one set in memory
+    std::vector<U32> offsets;
+    EXPECT_EQ(this->readFile(this->m_file), this->imageOf({{0x100, {0, 0, 0, 7}}, {0x200, {0, 0, 0, 5}}}, offsets));
+    const std::string tmpFile = this->m_file + ".tmp";
+    EXPECT_NE(::access(tmpFile.c_str(), F_OK), 0);
+
+    // The saved file loads back
+    this->clearHistory();
+    this->component.readParamFile();
+    ASSERT_EVENTS_PARAM_FILE_LOADED(0, 2);
+    this->expectU32(0x100, 7);
+    this->expectU32(0x200, 5);
+  }
+
+  void MmapPrmDbTester ::
+    testSaveBusy()
+  {
+    Fw::ParamBuffer val = this->u32Param(1);
+    this->invoke_to_setPrm(0, 0x300, val);
+
+    // All three commands are queued before the component runs, so no save can have completed
+    this->sendCmd_PRM_SAVE_FILE(0, 1);
+    this->sendCmd_PRM_SAVE_FILE(0, 2);
+    this->sendCmd_PRM_SAVE_FILE(0, 3);
+    for (U32 i = 0; i < 3; i++) {
+      this->component.doDispatch();
+    }
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MmapPrmDb::OPCODE_PRM_SAVE_FILE, 3, Fw::CmdResponse::BUSY);
+    ASSERT_EVENTS_PARAM_SAVE_BUSY_SIZE(1);
+
+    // Both accepted saves complete, in order, and free their buffers
+    this->component.doDispatch();
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(3);
+    ASSERT_CMD_RESPONSE(1, MmapPrmDb::OPCODE_PRM_SAVE_FILE, 1, Fw::CmdResponse::OK);
+    ASSERT_CMD_RESPONSE(2, MmapPrmDb::OPCODE_PRM_SAVE_FILE, 2, Fw::CmdResponse::OK);
+    ASSERT_TLM_SAVE_COUNT(1, 2);
+
+    this->save(4);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(3, MmapPrmDb::OPCODE_PRM_SAVE_FILE, 4, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_PARAM_SAVE_BUSY_SIZE(1);
+  }
+
+  void MmapPrmDbTester ::
+    testWriteError()
+  {
+    (void) this->writeFile({{0x100, {0, 0, 0, 7}}});
+    const std::vector<U8> before = this->readFile(this->m_file);
+    this->component.readParamFile();
+    Fw::ParamBuffer val = this->u32Param(8);
+    this->invoke_to_setPrm(0, 0x100, val);
+
+    // A directory in the way of the temporary file fails the write before the rename
+    const std::string tmpFile = this->m_file + ".tmp";
+    ASSERT_EQ(::mkdir(tmpFile.c_str(), 0755), 0);
+    this->save(1);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(0, MmapPrmDb::OPCODE_PRM_SAVE_FILE, 1, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_PARAM_FILE_WRITE_ERROR_SIZE(1);
+    ASSERT_EVENTS_PARAM_FILE_WRITE_ERROR(0, EISDIR);
+    ASSERT_TLM_SAVE_COUNT_SIZE(0);
+    EXPECT_EQ(this->readFile(this->m_file), before);
+
+    // The failed save freed its buffer
+    ASSERT_EQ(::rmdir(tmpFile.c_str()), 0);
+    this->save(2);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(1, MmapPrmDb::OPCODE_PRM_SAVE_FILE, 2, Fw::CmdResponse::OK);
+    EXPECT_NE(this->readFile(this->m_file), before);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  std::vector<U8> MmapPrmDbTester ::
+    imageOf(const std::vector<Record>& records, std::vector<U32>& offsets)
+  {
+    std::vector<U8> image;
+    for (const Record& record : records) {
+      offsets.push_back(static_cast<U32>(image.size()));
+      const U32 fields[] = {static_cast<U32>(sizeof(U32) + record.value.size()), record.id};
+      image.push_back(MmapPrmDb::ENTRY_DELIMITER);
+      for (const U32 field : fields) {
+        for (U32 shift = 32; shift > 0; shift -= 8) {
+          image.push_back(static_cast<U8>(field >> (shift - 8)));
+        }
+      }
+      image.insert(image.end(), record.value.begin(), record.value.end());
+    }
+    return image;
+  }
+
+  std::vector<U32> MmapPrmDbTester ::
+    writeFile(const std::vector<Record>& records)
+  {
+    std::vector<U32> offsets;
+    const std::vector<U8> image = this->imageOf(records, offsets);
+    std::ofstream stream(this->m_file, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    EXPECT_TRUE(stream.good());
+    return offsets;
+  }
+
+  std::vector<U8> MmapPrmDbTester ::
+    readFile(const std::string& path)
+  {
+    std::ifstream stream(path, std::ios::binary);
+    return std::vector<U8>((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  }
+
+  Fw::ParamBuffer MmapPrmDbTester ::
+    u32Param(U32 value)
+  {
+    Fw::ParamBuffer buffer;
+    EXPECT_EQ(buffer.serialize(value), Fw::FW_SERIALIZE_OK);
+    return buffer;
+  }
+
+  void MmapPrmDbTester ::
+    expectU32(FwPrmIdType id, U32 value)
+  {
+    Fw::ParamBuffer val;
+    ASSERT_EQ(this->invoke_to_getPrm(0, id, val), Fw::ParamValid::VALID) << id;
+    U32 actual = 0;
+    val.resetDeser();
+    ASSERT_EQ(val.deserialize(actual), Fw::FW_SERIALIZE_OK) << id;
+    EXPECT_EQ(actual, value) << id;
+  }
+
+  void MmapPrmDbTester ::
+    save(U32 cmdSeq)
+  {
+    this->sendCmd_PRM_SAVE_FILE(0, cmdSeq);
+    this->component.doDispatch();
+  }
+
+}
@@ -0,0 +1,133 @@
+// ======================================================================
+// \title  MmapPrmDbTester.hpp
+// \author cindy
+// \brief  hpp file for MmapPrmDb component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_MmapPrmDbTester_HPP
+#define MathModule_MmapPrmDbTester_HPP
+
+#include "MmapPrmDbGTestBase.hpp"
+#include "Components/MmapPrmDb/MmapPrmDb.hpp"
+
+#include <string>
+#include <vector>
+
+namespace MathModule {
+
+  class MmapPrmDbTester :
+    public MmapPrmDbGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MmapPrmDbTester
+      MmapPrmDbTester();
+
+      //! Destroy object MmapPrmDbTester, stopping the save task and removing its files
+      ~MmapPrmDbTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Loading indexes the records; each is validated the first time it is requested
+      void testLazyValidation();
+
+      //! A missing parameter file is reported and leaves the database empty
+      void testMissingFile();
+
+      //! A save writes every parameter and is answered from the component's thread
+      void testSave();
+
+      //! A save is rejected while both save buffers are in flight
+      void testSaveBusy();
+
+      //! A save that cannot be written leaves the parameter file as it was
+      void testWriteError();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! A record of a parameter file
+      struct Record {
+        FwPrmIdType id;
+        std::vector<U8> value;
+      };
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Lay out records the way Svc::PrmDb writes them
+      //! \return the file image
+      std::vector<U8> imageOf(
+          const std::vector<Record>& records, //!< The records
+          std::vector<U32>& offsets //!< Receives the offset of each record
+      );
+
+      //! Write records to the parameter file
+      //! \return the offset of each record
+      std::vector<U32> writeFile(const std::vector<Record>& records);
+
+      //! Read the parameter file
+      std::vector<U8> readFile(const std::string& path);
+
+      //! A parameter holding one U32
+      Fw::ParamBuffer u32Param(U32 value);
+
+      //! Get a parameter and check it holds one U32
+      void expectU32(FwPrmIdType id, U32 value);
+
+      //! Send PRM_SAVE_FILE and let the component run the command, not its completion
+      void save(U32 cmdSeq);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      MmapPrmDb component;
+
+      //! Parameter file
+      std::string m_file;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,173 @@
+// ======================================================================
+// \title  RateGroupTimer.cpp
+// \author cindy
+// \brief  cpp file for RateGroupTimer component implementation class
+// ======================================================================
+
+#include "Components/RateGroupTimer/RateGroupTimer.hpp"
+#include "Components/Tracer/Trace.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cstring>
+#include <time.h>
+
+namespace MathModule {
+
+  const U32 RateGroupTimer::FIRST_BUCKET_USEC;
+
+  namespace {
+
+    /*
+      CLOCK_MONOTONIC rather than the thread's CPU time: a member that blocks or
+      is preempted uses up the cycle budget just the same.
+    */
+    U64 monotonicNsec()
+    {
+      struct timespec now;
+      (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+      return static_cast<U64>(now.tv_sec) * 1000000000U + static_cast<U64>(now.tv_nsec);
+    }
+
+#if MATH_TRACE
+    //! Trace slice names of the member slots
+    const char* const MEMBER_NAMES[] = {
+      "member[0]", "member[1]", "member[2]", "member[3]", "member[4]",
+      "member[5]", "member[6]", "member[7]", "member[8]", "member[9]"
+    };
+    static_assert(FW_NUM_ARRAY_ELEMENTS(MEMBER_NAMES) == MemberTimes::SIZE, "Every member slot needs a name");
+#endif
+
+    U32 toUsec(U64 nsec)
+    {
+      const U64 usec = nsec / 1000U;
+      return (usec > 0xFFFFFFFFU) ? 0xFFFFFFFFU : static_cast<U32>(usec);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  RateGroupTimer ::
+    RateGroupTimer(const char* const compName) :
+      RateGroupTimerComponentBase(compName)
+  {
+    this->reset();
+  }
+
+  RateGroupTimer ::
+    ~RateGroupTimer()
+  {
+
+  }
+
+  /*
+    Bucket 0 holds calls under 16 us and each later bucket is four times as
+    wide as the one before, so 8 buckets separate a counter update from a
+    file write, with every call of 65 ms and over in the last.
+  */
+  U32 RateGroupTimer ::
+    bucketOf(U64 usec)
+  {
+    U32 bucket = 0;
+    U64 bound = FIRST_BUCKET_USEC;
+    while (usec >= bound && bucket < MemberTimeBuckets::SIZE - 1) {
+      bucket++;
+      bound *= 4;
+    }
+    return bucket;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    The member runs outside the lock, so schedIn reporting from another rate
+    group never holds up this one for longer than one slot update.
+  */
+  void RateGroupTimer ::
+    memberIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    FW_ASSERT(portNum >= 0 && portNum < static_cast<NATIVE_INT_TYPE>(MemberTimes::SIZE), portNum);
+    if (!this->isConnected_memberOut_OutputPort(portNum)) {
+      return;
+    }
+    const U64 begin = monotonicNsec();
+    {
+      MATH_TRACE_SCOPE(MEMBER_NAMES[portNum]);
+      this->memberOut_out(portNum, context);
+    }
+    const U64 elapsed = monotonicNsec() - begin;
+
+    this->m_lock.lock();
+    Slot& slot = this->m_slots[portNum];
+    slot.calls++;
+    slot.totalNsec += elapsed;
+    if (slot.calls == 1 || elapsed < slot.minNsec) {
+      slot.minNsec = elapsed;
+    }
+    if (elapsed > slot.maxNsec) {
+      slot.maxNsec = elapsed;
+    }
+    slot.buckets[bucketOf(elapsed / 1000U)]++;
+    this->m_lock.unLock();
+  }
+
+  void RateGroupTimer ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    Slot slots[MemberTimes::SIZE];
+    this->m_lock.lock();
+    (void) ::memcpy(slots, this->m_slots, sizeof(slots));
+    this->m_lock.unLock();
+
+    MemberTimes times;
+    MemberHistograms histograms;
+    for (U32 i = 0; i < MemberTimes::SIZE; i++) {
+      const Slot& slot = slots[i];
+      const U64 meanNsec = (slot.calls > 0) ? slot.totalNsec / slot.calls : 0;
+      times[i] = MemberTime(slot.calls, toUsec(slot.minNsec), toUsec(meanNsec), toUsec(slot.maxNsec));
+      for (U32 b = 0; b < MemberTimeBuckets::SIZE; b++) {
+        histograms[i][b] = slot.buckets[b];
+      }
+    }
+    this->tlmWrite_MEMBER_TIMES(times);
+    this->tlmWrite_MEMBER_HISTOGRAMS(histograms);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  void RateGroupTimer ::
+    RESET_TIMES_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    this->m_lock.lock();
+    this->reset();
+    this->m_lock.unLock();
+    this->log_ACTIVITY_HI_TIMES_RESET();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  void RateGroupTimer ::
+    reset()
+  {
+    (void) ::memset(this->m_slots, 0, sizeof(this->m_slots));
+  }
+
+}
@@ -0,0 +1,118 @@
+// ======================================================================
+// \title  RateGroupTimer.hpp
+// \author cindy
+// \brief  hpp file for RateGroupTimer component implementation class
+// ======================================================================
+
+#ifndef MathModule_RateGroupTimer_HPP
+#define MathModule_RateGroupTimer_HPP
+
+#include "Components/RateGroupTimer/RateGroupTimerComponentAc.hpp"
+#include <Os/Mutex.hpp>
+
+namespace MathModule {
+
+  class RateGroupTimer :
+    public RateGroupTimerComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Upper bound of the first histogram bucket, microseconds
+      static const U32 FIRST_BUCKET_USEC = 16;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct RateGroupTimer object
+      RateGroupTimer(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy RateGroupTimer object
+      ~RateGroupTimer();
+
+      //! Histogram bucket of an execution time
+      //! \return the bucket, below MemberTimeBuckets::SIZE
+      static U32 bucketOf(
+          U64 usec //!< The execution time, microseconds
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for memberIn
+      void memberIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command RESET_TIMES
+      void RESET_TIMES_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq //!< The command sequence number
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Execution times of one member slot
+      struct Slot {
+        U32 calls;
+        U64 totalNsec;
+        U64 minNsec;
+        U64 maxNsec;
+        U32 buckets[MemberTimeBuckets::SIZE];
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Clear the execution times of every slot
+      void reset();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Guards the slots, which the rate group and schedIn threads share
+      Os::Mutex m_lock;
+
+      //! Execution times of each member slot
+      Slot m_slots[MemberTimes::SIZE];
+
+  };
+
+}
+
+#endif
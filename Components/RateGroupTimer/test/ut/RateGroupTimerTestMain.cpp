@@ -0,0 +1,35 @@
+// ======================================================================
+// \title  RateGroupTimerTestMain.cpp
+// \author cindy
+// \brief  cpp file for RateGroupTimer component test main function
+// ======================================================================
+
+#include "RateGroupTimerTester.hpp"
+
+TEST(RateGroupTimer, Buckets) {
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(0), 0U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(15), 0U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(16), 1U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(63), 1U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(64), 2U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(1023), 3U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(1024), 4U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(65535), 6U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(65536), 7U);
+  EXPECT_EQ(MathModule::RateGroupTimer::bucketOf(0xFFFFFFFFFFFFFFFFULL), 7U);
+}
+
+TEST(Nominal, Times) {
+  MathModule::RateGroupTimerTester tester;
+  tester.testTimes();
+}
+
+TEST(Nominal, Reset) {
+  MathModule::RateGroupTimerTester tester;
+  tester.testReset();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
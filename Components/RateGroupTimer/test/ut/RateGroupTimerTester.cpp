@@ -0,0 +1,129 @@
+// ======================================================================
+// \title  RateGroupTimerTester.cpp
+// \author cindy
+// \brief  cpp file for RateGroupTimer component test harness implementation class
+// ======================================================================
+
+#include "RateGroupTimerTester.hpp"
+
+#include <unistd.h>
+
+namespace MathModule {
+
+  const NATIVE_INT_TYPE RateGroupTimerTester::SLOW_SLOT;
+  const U32 RateGroupTimerTester::SLOW_USEC;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  RateGroupTimerTester ::
+    RateGroupTimerTester() :
+      RateGroupTimerGTestBase("RateGroupTimerTester", RateGroupTimerTester::MAX_HISTORY_SIZE),
+      component("RateGroupTimer")
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  RateGroupTimerTester ::
+    ~RateGroupTimerTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void RateGroupTimerTester ::
+    testTimes()
+  {
+    this->cycle(5);
+    // Each member is called on its own slot with the rate group's context
+    ASSERT_EQ(this->m_calls.size(), 20U);
+    for (U32 i = 0; i < this->m_calls.size(); i++) {
+      EXPECT_EQ(this->m_calls[i].slot, static_cast<NATIVE_INT_TYPE>(i % (SLOW_SLOT + 1)));
+      EXPECT_EQ(this->m_calls[i].context, 100 + i % (SLOW_SLOT + 1));
+    }
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_MEMBER_TIMES_SIZE(1);
+    ASSERT_TLM_MEMBER_HISTOGRAMS_SIZE(1);
+    const MemberTimes& times = this->tlmHistory_MEMBER_TIMES->at(0).arg;
+    const MemberHistograms& histograms = this->tlmHistory_MEMBER_HISTOGRAMS->at(0).arg;
+    for (U32 slot = 0; slot < MemberTimes::SIZE; slot++) {
+      SCOPED_TRACE(slot);
+      const U32 calls = (slot <= static_cast<U32>(SLOW_SLOT)) ? 5 : 0;
+      EXPECT_EQ(times[slot].get_calls(), calls);
+      EXPECT_LE(times[slot].get_minUsec(), times[slot].get_meanUsec());
+      EXPECT_LE(times[slot].get_meanUsec(), times[slot].get_maxUsec());
+      U32 bucketed = 0;
+      for (U32 b = 0; b < MemberTimeBuckets::SIZE; b++) {
+        bucketed += histograms[slot][b];
+      }
+      EXPECT_EQ(bucketed, calls);
+    }
+
+    // The slow member is timed with its sleep, in the buckets from its sleep up
+    const MemberTime& slow = times[SLOW_SLOT];
+    EXPECT_GE(slow.get_minUsec(), SLOW_USEC);
+    EXPECT_GT(slow.get_meanUsec(), times[0].get_maxUsec());
+    for (U32 b = 0; b < RateGroupTimer::bucketOf(SLOW_USEC); b++) {
+      EXPECT_EQ(histograms[SLOW_SLOT][b], 0U) << b;
+    }
+    EXPECT_EQ(times[SLOW_SLOT + 1], MemberTime(0, 0, 0, 0));
+  }
+
+  void RateGroupTimerTester ::
+    testReset()
+  {
+    this->cycle(2);
+    this->sendCmd_RESET_TIMES(0, 5);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, RateGroupTimer::OPCODE_RESET_TIMES, 5, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_TIMES_RESET_SIZE(1);
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_MEMBER_TIMES(0, MemberTimes(MemberTime(0, 0, 0, 0)));
+    ASSERT_TLM_MEMBER_HISTOGRAMS(0, MemberHistograms(MemberTimeBuckets(0)));
+
+    // Timing starts over after the reset
+    this->invoke_to_memberIn(1, 1);
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_MEMBER_TIMES_SIZE(2);
+    EXPECT_EQ(this->tlmHistory_MEMBER_TIMES->at(1).arg[1].get_calls(), 1U);
+    EXPECT_EQ(this->tlmHistory_MEMBER_TIMES->at(1).arg[0].get_calls(), 0U);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void RateGroupTimerTester ::
+    from_memberOut_handler(
+        NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->m_calls.push_back({portNum, context});
+    if (portNum == SLOW_SLOT) {
+      (void) ::usleep(SLOW_USEC);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void RateGroupTimerTester ::
+    cycle(U32 cycles)
+  {
+    for (U32 c = 0; c < cycles; c++) {
+      for (NATIVE_INT_TYPE slot = 0; slot <= SLOW_SLOT; slot++) {
+        this->invoke_to_memberIn(slot, 100 + static_cast<NATIVE_UINT_TYPE>(slot));
+      }
+    }
+  }
+
+}
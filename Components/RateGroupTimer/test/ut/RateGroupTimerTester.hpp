@@ -0,0 +1,121 @@
+// ======================================================================
+// \title  RateGroupTimerTester.hpp
+// \author cindy
+// \brief  hpp file for RateGroupTimer component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_RateGroupTimerTester_HPP
+#define MathModule_RateGroupTimerTester_HPP
+
+#include "RateGroupTimerGTestBase.hpp"
+#include "Components/RateGroupTimer/RateGroupTimer.hpp"
+
+#include <vector>
+
+namespace MathModule {
+
+  class RateGroupTimerTester :
+    public RateGroupTimerGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 50;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Slot of the slow member
+      static const NATIVE_INT_TYPE SLOW_SLOT = 3;
+
+      //! Time the slow member takes, microseconds
+      static const U32 SLOW_USEC = 2000;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object RateGroupTimerTester
+      RateGroupTimerTester();
+
+      //! Destroy object RateGroupTimerTester
+      ~RateGroupTimerTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Members are called on their own slot and timed per slot
+      void testTimes();
+
+      //! RESET_TIMES clears every slot
+      void testReset();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! A member call
+      struct Call {
+        NATIVE_INT_TYPE slot;
+        NATIVE_UINT_TYPE context;
+      };
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for memberOut
+      void from_memberOut_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Run slots 0 to SLOW_SLOT the way a rate group cycle does
+      void cycle(U32 cycles);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      RateGroupTimer component;
+
+      //! Member calls, in order
+      std::vector<Call> m_calls;
+
+  };
+
+}
+
+#endif
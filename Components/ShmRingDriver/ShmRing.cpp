@@ -0,0 +1,534 @@
+// ======================================================================
+// \title  ShmRing.cpp
+// \author cindy
+// \brief  Shared-memory ring transport used by ShmRingDriver and the ground client
+// ======================================================================
+
+#include "Components/ShmRingDriver/ShmRing.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace ShmRing {
+
+    namespace {
+
+      const size_t PAGE_SIZE = 4096;
+
+      bool isPowerOfTwo(uint32_t value)
+      {
+        return (value != 0) && ((value & (value - 1)) == 0);
+      }
+
+      int64_t monotonicMs()
+      {
+        struct timespec now;
+        (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+      }
+
+    }
+
+    size_t dataOffset()
+    {
+      return (sizeof(RegionHeader) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    }
+
+    size_t regionSize(uint32_t ringSize)
+    {
+      return dataOffset() + DIRECTION_COUNT * static_cast<size_t>(ringSize);
+    }
+
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+    Endpoint ::
+      Endpoint() :
+        m_region(nullptr),
+        m_regionSize(0),
+        m_ringSize(0),
+        m_mask(0),
+        m_tx(nullptr),
+        m_txData(nullptr),
+        m_txDataFd(-1),
+        m_txSpaceFd(-1),
+        m_rx(nullptr),
+        m_rxData(nullptr),
+        m_rxDataFd(-1),
+        m_rxSpaceFd(-1),
+        m_interrupted(false),
+        m_wakeups(0)
+    {
+      for (int& fd : this->m_fds) {
+        fd = -1;
+      }
+    }
+
+    Endpoint ::
+      ~Endpoint()
+    {
+      this->close();
+    }
+
+    // ----------------------------------------------------------------------
+    // Session setup
+    // ----------------------------------------------------------------------
+
+    /*
+      The region is a memfd rather than a name under /dev/shm, so nothing is
+      left behind if either process dies and no other process can open it;
+      the ground only gets it through the handshake socket.
+    */
+    int Endpoint ::
+      create(uint32_t ringSize)
+    {
+      this->close();
+      if (!isPowerOfTwo(ringSize)) {
+        return EINVAL;
+      }
+
+      this->m_fds[FD_MEMORY] = ::memfd_create("MathDeploymentShmRing", MFD_CLOEXEC);
+      if (this->m_fds[FD_MEMORY] < 0) {
+        const int error = errno;
+        this->close();
+        return error;
+      }
+      if (::ftruncate(this->m_fds[FD_MEMORY], static_cast<off_t>(regionSize(ringSize))) != 0) {
+        const int error = errno;
+        this->close();
+        return error;
+      }
+      for (int index = FD_DOWNLINK_DATA; index < FD_COUNT; index++) {
+        this->m_fds[index] = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (this->m_fds[index] < 0) {
+          const int error = errno;
+          this->close();
+          return error;
+        }
+      }
+
+      const int error = this->map(DEPLOYMENT, ringSize);
+      if (error != 0) {
+        this->close();
+        return error;
+      }
+      RegionHeader* header = static_cast<RegionHeader*>(this->m_region);
+      for (RingControl& ring : header->rings) {
+        ring.head.store(0, std::memory_order_relaxed);
+        ring.tail.store(0, std::memory_order_relaxed);
+        ring.readerWaiting.store(0, std::memory_order_relaxed);
+        ring.writerWaiting.store(0, std::memory_order_relaxed);
+      }
+      header->magic = MAGIC;
+      header->version = VERSION;
+      header->ringSize = ringSize;
+      return 0;
+    }
+
+    int Endpoint ::
+      sendDescriptors(int socket) const
+    {
+      if (!this->isOpen()) {
+        return EBADF;
+      }
+      Hello hello;
+      hello.magic = MAGIC;
+      hello.version = VERSION;
+      hello.ringSize = this->m_ringSize;
+      struct iovec iov;
+      iov.iov_base = &hello;
+      iov.iov_len = sizeof(hello);
+
+      union {
+        char buffer[CMSG_SPACE(sizeof(int) * FD_COUNT)];
+        struct cmsghdr align;
+      } control;
+      ::memset(&control, 0, sizeof(control));
+      struct msghdr msg;
+      ::memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control.buffer;
+      msg.msg_controllen = sizeof(control.buffer);
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int) * FD_COUNT);
+      ::memcpy(CMSG_DATA(cmsg), this->m_fds, sizeof(int) * FD_COUNT);
+
+      while (true) {
+        const ssize_t sent = ::sendmsg(socket, &msg, MSG_NOSIGNAL);
+        if (sent == static_cast<ssize_t>(sizeof(hello))) {
+          return 0;
+        }
+        if ((sent < 0) && (errno == EINTR)) {
+          continue;
+        }
+        return (sent < 0) ? errno : EPROTO;
+      }
+    }
+
+    int Endpoint ::
+      receiveDescriptors(int socket)
+    {
+      this->close();
+      Hello hello;
+      struct iovec iov;
+      iov.iov_base = &hello;
+      iov.iov_len = sizeof(hello);
+
+      union {
+        char buffer[CMSG_SPACE(sizeof(int) * FD_COUNT)];
+        struct cmsghdr align;
+      } control;
+      struct msghdr msg;
+      ::memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control.buffer;
+      msg.msg_controllen = sizeof(control.buffer);
+
+      ssize_t received = -1;
+      do {
+        received = ::recvmsg(socket, &msg, MSG_WAITALL | MSG_CMSG_CLOEXEC);
+      } while ((received < 0) && (errno == EINTR));
+      if (received < 0) {
+        return errno;
+      }
+
+      // Take ownership of whatever descriptors arrived before checking anything else
+      size_t count = 0;
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      if ((cmsg != nullptr) && (cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS)) {
+        count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        if (count > FD_COUNT) {
+          count = FD_COUNT;
+        }
+        ::memcpy(this->m_fds, CMSG_DATA(cmsg), sizeof(int) * count);
+      }
+      if ((received != static_cast<ssize_t>(sizeof(hello))) || (count != FD_COUNT) ||
+          ((msg.msg_flags & MSG_CTRUNC) != 0) || (hello.magic != MAGIC)) {
+        this->close();
+        return EPROTO;
+      }
+      if (hello.version != VERSION) {
+        this->close();
+        return EPROTONOSUPPORT;
+      }
+      if (!isPowerOfTwo(hello.ringSize)) {
+        this->close();
+        return EINVAL;
+      }
+
+      // The region must be as large as the handshake says before it is touched
+      struct stat status;
+      if ((::fstat(this->m_fds[FD_MEMORY], &status) != 0) ||
+          (static_cast<size_t>(status.st_size) < regionSize(hello.ringSize))) {
+        this->close();
+        return EINVAL;
+      }
+      const int error = this->map(GROUND, hello.ringSize);
+      if (error != 0) {
+        this->close();
+        return error;
+      }
+      const RegionHeader* header = static_cast<const RegionHeader*>(this->m_region);
+      if ((header->magic != MAGIC) || (header->version != VERSION) || (header->ringSize != hello.ringSize)) {
+        this->close();
+        return EPROTO;
+      }
+      return 0;
+    }
+
+    int Endpoint ::
+      map(Role role, uint32_t ringSize)
+    {
+      const size_t size = regionSize(ringSize);
+      void* region = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_fds[FD_MEMORY], 0);
+      if (region == MAP_FAILED) {
+        return errno;
+      }
+      this->m_region = region;
+      this->m_regionSize = size;
+      this->m_ringSize = ringSize;
+      this->m_mask = ringSize - 1;
+      this->m_interrupted.store(false);
+
+      RegionHeader* header = static_cast<RegionHeader*>(region);
+      uint8_t* data = static_cast<uint8_t*>(region) + dataOffset();
+      const Direction tx = (role == DEPLOYMENT) ? DOWNLINK : UPLINK;
+      const Direction rx = (role == DEPLOYMENT) ? UPLINK : DOWNLINK;
+      this->m_tx = &header->rings[tx];
+      this->m_txData = data + tx * static_cast<size_t>(ringSize);
+      this->m_rx = &header->rings[rx];
+      this->m_rxData = data + rx * static_cast<size_t>(ringSize);
+      this->m_txDataFd = this->m_fds[(tx == DOWNLINK) ? FD_DOWNLINK_DATA : FD_UPLINK_DATA];
+      this->m_txSpaceFd = this->m_fds[(tx == DOWNLINK) ? FD_DOWNLINK_SPACE : FD_UPLINK_SPACE];
+      this->m_rxDataFd = this->m_fds[(rx == DOWNLINK) ? FD_DOWNLINK_DATA : FD_UPLINK_DATA];
+      this->m_rxSpaceFd = this->m_fds[(rx == DOWNLINK) ? FD_DOWNLINK_SPACE : FD_UPLINK_SPACE];
+      return 0;
+    }
+
+    void Endpoint ::
+      close()
+    {
+      if (this->m_region != nullptr) {
+        (void) ::munmap(this->m_region, this->m_regionSize);
+      }
+      for (int& fd : this->m_fds) {
+        if (fd >= 0) {
+          (void) ::close(fd);
+        }
+        fd = -1;
+      }
+      this->m_region = nullptr;
+      this->m_regionSize = 0;
+      this->m_ringSize = 0;
+      this->m_mask = 0;
+      this->m_tx = nullptr;
+      this->m_txData = nullptr;
+      this->m_txDataFd = -1;
+      this->m_txSpaceFd = -1;
+      this->m_rx = nullptr;
+      this->m_rxData = nullptr;
+      this->m_rxDataFd = -1;
+      this->m_rxSpaceFd = -1;
+    }
+
+    bool Endpoint ::
+      isOpen() const
+    {
+      return this->m_region != nullptr;
+    }
+
+    // ----------------------------------------------------------------------
+    // Data transfer
+    // ----------------------------------------------------------------------
+
+    /*
+      The head is published with release after the copy, so the reader never
+      sees bytes that are not there yet. The fence orders that store before
+      the readerWaiting load, pairing with the fence in wait: either the
+      reader sees the new head before it sleeps, or this side sees its flag
+      and signals. The eventfd is only written when the reader sleeps, so a
+      reader keeping up costs no system call at all.
+    */
+    size_t Endpoint ::
+      write(const void* data, size_t size)
+    {
+      const uint64_t head = this->m_tx->head.load(std::memory_order_relaxed);
+      const size_t space = this->writable();
+      const size_t count = (size < space) ? size : space;
+      if (count == 0) {
+        return 0;
+      }
+      const size_t offset = static_cast<size_t>(head & this->m_mask);
+      const size_t first = (count < this->m_ringSize - offset) ? count : this->m_ringSize - offset;
+      ::memcpy(this->m_txData + offset, data, first);
+      ::memcpy(this->m_txData, static_cast<const uint8_t*>(data) + first, count - first);
+      this->m_tx->head.store(head + count, std::memory_order_release);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (this->m_tx->readerWaiting.load(std::memory_order_relaxed) != 0) {
+        this->signal(this->m_txDataFd);
+      }
+      return count;
+    }
+
+    size_t Endpoint ::
+      read(void* data, size_t size)
+    {
+      const uint64_t tail = this->m_rx->tail.load(std::memory_order_relaxed);
+      const size_t available = this->readable();
+      const size_t count = (size < available) ? size : available;
+      if (count == 0) {
+        return 0;
+      }
+      const size_t offset = static_cast<size_t>(tail & this->m_mask);
+      const size_t first = (count < this->m_ringSize - offset) ? count : this->m_ringSize - offset;
+      ::memcpy(data, this->m_rxData + offset, first);
+      ::memcpy(static_cast<uint8_t*>(data) + first, this->m_rxData, count - first);
+      this->m_rx->tail.store(tail + count, std::memory_order_release);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (this->m_rx->writerWaiting.load(std::memory_order_relaxed) != 0) {
+        this->signal(this->m_rxSpaceFd);
+      }
+      return count;
+    }
+
+    /*
+      The peer's position is only trusted up to a full ring. Offsets are
+      masked, so a corrupt position yields wrong bytes but never an access
+      outside the region.
+    */
+    size_t Endpoint ::
+      readable() const
+    {
+      const uint64_t head = this->m_rx->head.load(std::memory_order_acquire);
+      const uint64_t used = head - this->m_rx->tail.load(std::memory_order_relaxed);
+      return static_cast<size_t>((used < this->m_ringSize) ? used : this->m_ringSize);
+    }
+
+    size_t Endpoint ::
+      writable() const
+    {
+      const uint64_t tail = this->m_tx->tail.load(std::memory_order_acquire);
+      const uint64_t used = this->m_tx->head.load(std::memory_order_relaxed) - tail;
+      return static_cast<size_t>((used < this->m_ringSize) ? this->m_ringSize - used : 0);
+    }
+
+    // ----------------------------------------------------------------------
+    // Waiting
+    // ----------------------------------------------------------------------
+
+    Endpoint::WaitStatus Endpoint ::
+      waitWritable(int timeoutMs, int peerSocket)
+    {
+      return this->wait(this->m_tx->writerWaiting, this->m_txSpaceFd, &Endpoint::hasSpace, timeoutMs, peerSocket);
+    }
+
+    Endpoint::WaitStatus Endpoint ::
+      waitReadable(int timeoutMs, int peerSocket)
+    {
+      return this->wait(this->m_rx->readerWaiting, this->m_rxDataFd, &Endpoint::hasData, timeoutMs, peerSocket);
+    }
+
+    bool Endpoint ::
+      armReceive()
+    {
+      this->m_rx->readerWaiting.store(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return !this->hasData();
+    }
+
+    void Endpoint ::
+      disarmReceive()
+    {
+      this->m_rx->readerWaiting.store(0, std::memory_order_relaxed);
+      uint64_t count = 0;
+      (void) ::read(this->m_rxDataFd, &count, sizeof(count));
+    }
+
+    int Endpoint ::
+      receiveFd() const
+    {
+      return this->m_rxDataFd;
+    }
+
+    void Endpoint ::
+      interrupt()
+    {
+      this->m_interrupted.store(true);
+      const uint64_t one = 1;
+      if (this->m_txSpaceFd >= 0) {
+        (void) ::write(this->m_txSpaceFd, &one, sizeof(one));
+      }
+      if (this->m_rxDataFd >= 0) {
+        (void) ::write(this->m_rxDataFd, &one, sizeof(one));
+      }
+    }
+
+    uint32_t Endpoint ::
+      wakeupsSent() const
+    {
+      return this->m_wakeups.load(std::memory_order_relaxed);
+    }
+
+    /*
+      The peer is first given a few chances to run: each data or space signal
+      wakes the sleeper, which on a busy or single core host preempts the
+      peer after every frame. Yielding lets the peer write or read a batch
+      first, so most waits end without a wakeup. The flag is raised before
+      the last check, so a peer that makes the ring ready after the check
+      also sees the flag and signals. Signals left over from an earlier wait
+      only cause one extra pass round the loop.
+    */
+    Endpoint::WaitStatus Endpoint ::
+      wait(std::atomic<uint32_t>& flag, int eventFd, bool (Endpoint::*ready)() const, int timeoutMs, int peerSocket)
+    {
+      for (uint32_t attempt = 0; attempt < YIELDS_BEFORE_SLEEP; attempt++) {
+        if ((this->*ready)()) {
+          return WAIT_READY;
+        }
+        (void) ::sched_yield();
+      }
+
+      const int64_t deadline = monotonicMs() + timeoutMs;
+      while (true) {
+        if (this->m_interrupted.load()) {
+          return WAIT_INTERRUPTED;
+        }
+        flag.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((this->*ready)()) {
+          flag.store(0, std::memory_order_relaxed);
+          return WAIT_READY;
+        }
+
+        int remaining = -1;
+        if (timeoutMs >= 0) {
+          const int64_t left = deadline - monotonicMs();
+          remaining = (left > 0) ? static_cast<int>(left) : 0;
+        }
+        struct pollfd fds[2];
+        fds[0].fd = eventFd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = peerSocket;
+        fds[1].events = POLLIN | POLLRDHUP;
+        fds[1].revents = 0;
+        const int result = ::poll(fds, (peerSocket >= 0) ? 2 : 1, remaining);
+        uint64_t count = 0;
+        (void) ::read(eventFd, &count, sizeof(count));
+        flag.store(0, std::memory_order_relaxed);
+
+        if (this->m_interrupted.load()) {
+          return WAIT_INTERRUPTED;
+        }
+        if ((this->*ready)()) {
+          return WAIT_READY;
+        }
+        if ((fds[1].revents & (POLLIN | POLLRDHUP | POLLHUP | POLLERR)) != 0) {
+          return WAIT_HANGUP;
+        }
+        if ((result == 0) || ((remaining == 0) && (timeoutMs >= 0))) {
+          return WAIT_TIMEOUT;
+        }
+      }
+    }
+
+    bool Endpoint ::
+      hasData() const
+    {
+      return this->readable() > 0;
+    }
+
+    bool Endpoint ::
+      hasSpace() const
+    {
+      return this->writable() > 0;
+    }
+
+    void Endpoint ::
+      signal(int eventFd)
+    {
+      const uint64_t one = 1;
+      (void) ::write(eventFd, &one, sizeof(one));
+      this->m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+
+  }
+
+}
@@ -0,0 +1,227 @@
+// ======================================================================
+// \title  ShmRing.hpp
+// \author cindy
+// \brief  Shared-memory ring transport used by ShmRingDriver and the ground client
+//
+// This file only depends on the C++ standard library and Linux headers so
+// ground tools can build it without F´.
+// ======================================================================
+
+#ifndef MathModule_ShmRing_HPP
+#define MathModule_ShmRing_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace MathModule {
+
+  namespace ShmRing {
+
+    //! Identifies the shared region and the handshake
+    static const uint32_t MAGIC = 0x53484D52;
+
+    //! Layout version. Bump when RegionHeader or the handshake changes.
+    static const uint32_t VERSION = 1;
+
+    //! Bytes in each ring. Must be a power of two.
+    static const uint32_t DEFAULT_RING_SIZE = 1U << 20;
+
+    //! Times a wait yields to the peer before sleeping on an eventfd
+    static const uint32_t YIELDS_BEFORE_SLEEP = 8;
+
+    //! Control words and data start on separate cache lines so the two sides do not share one
+    static const size_t CACHE_LINE = 64;
+
+    //! Rings in the region. The deployment writes DOWNLINK and reads UPLINK.
+    enum Direction {
+      DOWNLINK = 0,
+      UPLINK = 1,
+      DIRECTION_COUNT = 2
+    };
+
+    //! Descriptors passed from the deployment to the ground, in this order
+    enum Descriptor {
+      FD_MEMORY = 0, //!< memfd holding the region
+      FD_DOWNLINK_DATA = 1, //!< Signalled by the deployment when it writes to a sleeping ground
+      FD_DOWNLINK_SPACE = 2, //!< Signalled by the ground when it reads from a full downlink ring
+      FD_UPLINK_DATA = 3, //!< Signalled by the ground when it writes to a sleeping deployment
+      FD_UPLINK_SPACE = 4, //!< Signalled by the deployment when it reads from a full uplink ring
+      FD_COUNT = 5
+    };
+
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "ring positions must be lock free to live in shared memory");
+
+    //! Control words of one single-producer single-consumer byte ring
+    struct RingControl {
+      //! Bytes written since the session started. Written by the producer only.
+      alignas(CACHE_LINE) std::atomic<uint64_t> head;
+      //! Bytes read since the session started. Written by the consumer only.
+      alignas(CACHE_LINE) std::atomic<uint64_t> tail;
+      //! Non-zero while the consumer sleeps on the data eventfd
+      alignas(CACHE_LINE) std::atomic<uint32_t> readerWaiting;
+      //! Non-zero while the producer sleeps on the space eventfd
+      std::atomic<uint32_t> writerWaiting;
+    };
+
+    //! Start of the shared region. The rings' data follows at dataOffset().
+    struct RegionHeader {
+      uint32_t magic; //!< MAGIC
+      uint32_t version; //!< VERSION
+      uint32_t ringSize; //!< Bytes in each ring
+      uint32_t reserved;
+      RingControl rings[DIRECTION_COUNT];
+    };
+
+    //! Message sent with the descriptors
+    struct Hello {
+      uint32_t magic; //!< MAGIC
+      uint32_t version; //!< VERSION
+      uint32_t ringSize; //!< Bytes in each ring
+    };
+
+    //! Offset of the first ring's data in the region, rounded up to a page
+    size_t dataOffset();
+
+    //! Size of a region holding two rings of the given size
+    size_t regionSize(uint32_t ringSize);
+
+    //! One side of a session: writes one ring and reads the other
+    class Endpoint {
+
+      public:
+
+        //! Which side of the session the endpoint is
+        enum Role {
+          DEPLOYMENT, //!< Writes DOWNLINK, reads UPLINK
+          GROUND //!< Writes UPLINK, reads DOWNLINK
+        };
+
+        //! Outcome of a wait
+        enum WaitStatus {
+          WAIT_READY, //!< The ring has data or space
+          WAIT_TIMEOUT, //!< The timeout elapsed
+          WAIT_HANGUP, //!< The peer's socket closed
+          WAIT_INTERRUPTED //!< interrupt was called
+        };
+
+        Endpoint();
+        ~Endpoint();
+
+        //! Create and map the region and the eventfds. Deployment side.
+        //! \return 0 on success, otherwise the errno value
+        int create(uint32_t ringSize);
+
+        //! Send the handshake and the descriptors over a connected unix socket. Deployment side.
+        //! \return 0 on success, otherwise the errno value
+        int sendDescriptors(int socket) const;
+
+        //! Receive the handshake and the descriptors, and map the region. Ground side.
+        //! \return 0 on success, otherwise the errno value
+        int receiveDescriptors(int socket);
+
+        //! Unmap the region and close the descriptors
+        void close();
+
+        //! Whether the region is mapped
+        bool isOpen() const;
+
+        //! Copy as much of the data as fits into the transmit ring, waking the peer if it sleeps
+        //! \return bytes copied
+        size_t write(const void* data, size_t size);
+
+        //! Copy up to size bytes out of the receive ring, waking the peer if it waits for space
+        //! \return bytes copied
+        size_t read(void* data, size_t size);
+
+        //! Bytes waiting in the receive ring
+        size_t readable() const;
+
+        //! Free bytes in the transmit ring
+        size_t writable() const;
+
+        //! Wait until the transmit ring has space
+        WaitStatus waitWritable(
+            int timeoutMs, //!< Timeout, -1 for none
+            int peerSocket //!< Socket whose closing ends the wait, or -1
+        );
+
+        //! Wait until the receive ring has data
+        WaitStatus waitReadable(
+            int timeoutMs, //!< Timeout, -1 for none
+            int peerSocket //!< Socket whose closing ends the wait, or -1
+        );
+
+        //! Ask the peer to signal the data eventfd on its next write
+        //! \return false if data arrived meanwhile, so the caller must not sleep
+        bool armReceive();
+
+        //! Stop data signals and clear the data eventfd after a wakeup
+        void disarmReceive();
+
+        //! Eventfd that becomes readable when data arrives on an armed receive ring
+        int receiveFd() const;
+
+        //! End any wait in progress and every later one until the next create or receiveDescriptors
+        void interrupt();
+
+        //! Eventfd signals sent to the peer
+        uint32_t wakeupsSent() const;
+
+      private:
+
+        //! Map the region and point the rings at it
+        //! \return 0 on success, otherwise the errno value
+        int map(Role role, uint32_t ringSize);
+
+        //! Wait on an eventfd with a flag raised, unless ready already holds
+        WaitStatus wait(std::atomic<uint32_t>& flag, int eventFd, bool (Endpoint::*ready)() const,
+                        int timeoutMs, int peerSocket);
+
+        bool hasData() const;
+        bool hasSpace() const;
+
+        //! Signal an eventfd
+        void signal(int eventFd);
+
+        Endpoint(const Endpoint&) = delete;
+        Endpoint& operator=(const Endpoint&) = delete;
+
+      private:
+
+        //! Region descriptor and eventfds, indexed by Descriptor, or -1
+        int m_fds[FD_COUNT];
+
+        //! Region mapping
+        void* m_region;
+        size_t m_regionSize;
+
+        //! Bytes in each ring, and the mask for offsets into it
+        uint32_t m_ringSize;
+        uint64_t m_mask;
+
+        //! Transmit ring and its eventfds
+        RingControl* m_tx;
+        uint8_t* m_txData;
+        int m_txDataFd;
+        int m_txSpaceFd;
+
+        //! Receive ring and its eventfds
+        RingControl* m_rx;
+        uint8_t* m_rxData;
+        int m_rxDataFd;
+        int m_rxSpaceFd;
+
+        //! Set by interrupt
+        std::atomic<bool> m_interrupted;
+
+        //! Eventfd signals sent
+        std::atomic<uint32_t> m_wakeups;
+
+    };
+
+  }
+
+}
+
+#endif
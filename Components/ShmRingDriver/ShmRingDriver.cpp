@@ -0,0 +1,431 @@
+// ======================================================================
+// \title  ShmRingDriver.cpp
+// \author cindy
+// \brief  cpp file for ShmRingDriver component implementation class
+// ======================================================================
+
+#include "Components/ShmRingDriver/ShmRingDriver.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  ShmRingDriver ::
+    ShmRingDriver(const char* const compName) :
+      ShmRingDriverComponentBase(compName),
+      m_listenFd(-1),
+      m_epollFd(-1),
+      m_wakeFd(-1),
+      m_sessionFd(-1),
+      m_started(false),
+      m_quit(false),
+      m_connected(false),
+      m_bytesSent(0),
+      m_bytesReceived(0),
+      m_sendStalls(0)
+  {
+    ::memset(&this->m_address, 0, sizeof(this->m_address));
+  }
+
+  ShmRingDriver ::
+    ~ShmRingDriver()
+  {
+    if (this->m_sessionFd >= 0) {
+      (void) ::close(this->m_sessionFd);
+    }
+    if (this->m_wakeFd >= 0) {
+      (void) ::close(this->m_wakeFd);
+    }
+    if (this->m_epollFd >= 0) {
+      (void) ::close(this->m_epollFd);
+    }
+    if (this->m_listenFd >= 0) {
+      (void) ::close(this->m_listenFd);
+      (void) ::unlink(this->m_address.sun_path);
+    }
+  }
+
+  bool ShmRingDriver ::
+    open(const char* path)
+  {
+    FW_ASSERT(this->m_listenFd < 0);
+    FW_ASSERT(path != nullptr);
+    Fw::LogStringArg pathArg(path);
+    if (::strlen(path) >= sizeof(this->m_address.sun_path)) {
+      this->log_WARNING_HI_LISTEN_ERROR(pathArg, ENAMETOOLONG);
+      return false;
+    }
+    this->m_address.sun_family = AF_UNIX;
+    (void) ::strncpy(this->m_address.sun_path, path, sizeof(this->m_address.sun_path) - 1);
+
+    // A socket left by a deployment that did not exit cleanly would make bind fail
+    struct stat status;
+    if ((::lstat(path, &status) == 0) && S_ISSOCK(status.st_mode)) {
+      (void) ::unlink(path);
+    }
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+      this->log_WARNING_HI_LISTEN_ERROR(pathArg, errno);
+      return false;
+    }
+    if ((::bind(fd, reinterpret_cast<const struct sockaddr*>(&this->m_address), sizeof(this->m_address)) != 0) ||
+        (::listen(fd, 1) != 0)) {
+      const int error = errno;
+      (void) ::close(fd);
+      this->log_WARNING_HI_LISTEN_ERROR(pathArg, error);
+      return false;
+    }
+
+    const int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    const int wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    bool registered = (epollFd >= 0) && (wakeFd >= 0);
+    int error = errno;
+    if (registered) {
+      struct epoll_event event;
+      ::memset(&event, 0, sizeof(event));
+      event.events = EPOLLIN;
+      event.data.u64 = TAG_LISTEN;
+      registered = (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0);
+      event.data.u64 = TAG_WAKE;
+      registered = registered && (::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0);
+      error = errno;
+    }
+    if (!registered) {
+      if (wakeFd >= 0) {
+        (void) ::close(wakeFd);
+      }
+      if (epollFd >= 0) {
+        (void) ::close(epollFd);
+      }
+      (void) ::close(fd);
+      (void) ::unlink(path);
+      this->log_WARNING_HI_LISTEN_ERROR(pathArg, error);
+      return false;
+    }
+
+    this->m_listenFd = fd;
+    this->m_epollFd = epollFd;
+    this->m_wakeFd = wakeFd;
+    return true;
+  }
+
+  void ShmRingDriver ::
+    startReadThread(NATIVE_UINT_TYPE priority, NATIVE_UINT_TYPE stackSize)
+  {
+    FW_ASSERT(this->m_listenFd >= 0);
+    FW_ASSERT(!this->m_started);
+    Os::TaskString name("ShmRingTask");
+    const Os::Task::TaskStatus status =
+      this->m_task.start(name, ShmRingDriver::ringTask, this, priority, stackSize);
+    FW_ASSERT(status == Os::Task::TASK_OK, status);
+    this->m_started = true;
+  }
+
+  void ShmRingDriver ::
+    quitReadThread()
+  {
+    this->m_lock.lock();
+    this->m_quit = true;
+    this->m_lock.unLock();
+
+    if (this->m_wakeFd >= 0) {
+      const U64 one = 1;
+      (void) ::write(this->m_wakeFd, &one, sizeof(one));
+    }
+  }
+
+  Os::Task::TaskStatus ShmRingDriver ::
+    join()
+  {
+    Os::Task::TaskStatus status = Os::Task::TASK_OK;
+    if (this->m_started) {
+      status = this->m_task.join(nullptr);
+      this->m_started = false;
+    }
+    this->detachClient();
+    if (this->m_listenFd >= 0) {
+      (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_DEL, this->m_listenFd, nullptr);
+      (void) ::close(this->m_listenFd);
+      (void) ::unlink(this->m_address.sun_path);
+      this->m_listenFd = -1;
+    }
+    return status;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    The frame is copied into the downlink ring and the buffer returned right
+    away. A full ring means the client is behind, and the send waits for it
+    as a blocking socket write would, so comQueue absorbs the backlog instead
+    of frames being cut short. Only a detach ends the wait early.
+  */
+  Drv::SendStatus ShmRingDriver ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_sendLock.lock();
+    this->m_lock.lock();
+    const bool connected = this->m_connected;
+    this->m_lock.unLock();
+    if (!connected) {
+      this->m_sendLock.unLock();
+      this->deallocate_out(0, fwBuffer);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+
+    const U8* const data = fwBuffer.getData();
+    const U32 size = fwBuffer.getSize();
+    U32 written = 0;
+    bool stalled = false;
+    bool attached = true;
+    while (true) {
+      written += static_cast<U32>(this->m_endpoint.write(data + written, size - written));
+      if (written == size) {
+        break;
+      }
+      stalled = true;
+      if (this->m_endpoint.waitWritable(-1, -1) == ShmRing::Endpoint::WAIT_INTERRUPTED) {
+        attached = false;
+        break;
+      }
+    }
+    this->m_sendLock.unLock();
+
+    this->m_lock.lock();
+    this->m_bytesSent += written;
+    this->m_sendStalls += stalled ? 1 : 0;
+    this->m_lock.unLock();
+
+    this->deallocate_out(0, fwBuffer);
+    return attached ? Drv::SendStatus::SEND_OK : Drv::SendStatus::SEND_ERROR;
+  }
+
+  void ShmRingDriver ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->m_lock.lock();
+    const bool connected = this->m_connected;
+    const U64 sent = this->m_bytesSent;
+    const U64 received = this->m_bytesReceived;
+    const U32 stalls = this->m_sendStalls;
+    this->m_lock.unLock();
+
+    this->tlmWrite_CONNECTED(connected);
+    this->tlmWrite_BYTES_SENT(sent);
+    this->tlmWrite_BYTES_RECEIVED(received);
+    this->tlmWrite_WAKEUPS(this->m_endpoint.wakeupsSent());
+    this->tlmWrite_SEND_STALLS(stalls);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    Each client gets fresh rings, so nothing a previous client left behind
+    is replayed. Only one client is served; the rings are single-producer
+    single-consumer.
+  */
+  void ShmRingDriver ::
+    attachClient()
+  {
+    while (true) {
+      const int fd = ::accept4(this->m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return;
+      }
+      if (this->m_sessionFd >= 0) {
+        (void) ::close(fd);
+        this->log_WARNING_LO_CLIENT_REJECTED();
+        continue;
+      }
+
+      int error = this->m_endpoint.create(RING_SIZE);
+      if (error == 0) {
+        error = this->m_endpoint.sendDescriptors(fd);
+      }
+      if (error == 0) {
+        struct epoll_event event;
+        ::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = TAG_SESSION;
+        error = (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, fd, &event) == 0) ? 0 : errno;
+        event.events = EPOLLIN;
+        event.data.u64 = TAG_UPLINK;
+        if ((error == 0) &&
+            (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, this->m_endpoint.receiveFd(), &event) != 0)) {
+          error = errno;
+          (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+      }
+      if (error != 0) {
+        this->m_endpoint.close();
+        (void) ::close(fd);
+        this->log_WARNING_HI_SESSION_ERROR(error);
+        continue;
+      }
+
+      this->m_sessionFd = fd;
+      this->m_lock.lock();
+      this->m_connected = true;
+      this->m_lock.unLock();
+      this->log_ACTIVITY_HI_CLIENT_CONNECTED();
+      this->ready_out(0);
+    }
+  }
+
+  /*
+    Sends are stopped first and any send waiting for ring space is woken,
+    then the send lock is taken once so no send still uses the mapping when
+    it is removed.
+  */
+  void ShmRingDriver ::
+    detachClient()
+  {
+    if (this->m_sessionFd < 0) {
+      return;
+    }
+    this->m_lock.lock();
+    this->m_connected = false;
+    const bool quit = this->m_quit;
+    this->m_lock.unLock();
+    this->m_endpoint.interrupt();
+    this->m_sendLock.lock();
+    this->m_sendLock.unLock();
+
+    (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_DEL, this->m_endpoint.receiveFd(), nullptr);
+    (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_DEL, this->m_sessionFd, nullptr);
+    (void) ::close(this->m_sessionFd);
+    this->m_sessionFd = -1;
+    this->m_endpoint.close();
+    if (!quit) {
+      this->log_ACTIVITY_HI_CLIENT_DISCONNECTED();
+    }
+  }
+
+  /*
+    At most one ring's worth is passed up per call, so a client streaming
+    uplink without pause cannot keep the task from seeing a hangup or quit.
+  */
+  bool ShmRingDriver ::
+    readUplink()
+  {
+    U32 total = 0;
+    while (total < RING_SIZE) {
+      const size_t available = this->m_endpoint.readable();
+      if (available == 0) {
+        break;
+      }
+      const U32 size = static_cast<U32>(FW_MIN(available, static_cast<size_t>(RECV_BUFFER_SIZE)));
+      Fw::Buffer buffer = this->allocate_out(0, size);
+      if ((buffer.getData() == nullptr) || (buffer.getSize() < size)) {
+        if (buffer.getData() != nullptr) {
+          this->deallocate_out(0, buffer);
+        }
+        return false;
+      }
+      const U32 count = static_cast<U32>(this->m_endpoint.read(buffer.getData(), size));
+      buffer.setSize(count);
+      this->recv_out(0, buffer, Drv::RecvStatus::RECV_OK);
+      total += count;
+    }
+
+    if (total > 0) {
+      this->m_lock.lock();
+      this->m_bytesReceived += total;
+      this->m_lock.unLock();
+    }
+    return true;
+  }
+
+  /*
+    The task only sleeps with the uplink ring armed, so a client writing to
+    it signals the eventfd; while the task keeps up, the client writes
+    without any system call.
+  */
+  void ShmRingDriver ::
+    ringTask(void* arg)
+  {
+    ShmRingDriver* driver = static_cast<ShmRingDriver*>(arg);
+    FW_ASSERT(driver != nullptr);
+    struct epoll_event events[MAX_EVENTS];
+
+    while (true) {
+      driver->m_lock.lock();
+      const bool quit = driver->m_quit;
+      driver->m_lock.unLock();
+      if (quit) {
+        break;
+      }
+
+      const bool attached = (driver->m_sessionFd >= 0);
+      int timeout = -1;
+      if (attached) {
+        if (!driver->readUplink()) {
+          timeout = static_cast<int>(ALLOCATE_RETRY_MS);
+        } else if (!driver->m_endpoint.armReceive()) {
+          timeout = 0;
+        }
+      }
+      const int ready = ::epoll_wait(driver->m_epollFd, events, MAX_EVENTS, timeout);
+      if (attached) {
+        driver->m_endpoint.disarmReceive();
+      }
+      if (ready < 0) {
+        FW_ASSERT(errno == EINTR, errno);
+        continue;
+      }
+
+      for (int i = 0; i < ready; i++) {
+        switch (events[i].data.u64) {
+          case TAG_LISTEN:
+            driver->attachClient();
+            break;
+          case TAG_WAKE: {
+            U64 count = 0;
+            (void) ::read(driver->m_wakeFd, &count, sizeof(count));
+            break;
+          }
+          case TAG_SESSION: {
+            // Nothing is sent on the socket after the handshake, so readable means closed
+            U8 discard[64];
+            const ssize_t received = ::recv(driver->m_sessionFd, discard, sizeof(discard), MSG_DONTWAIT);
+            if ((received == 0) || ((received < 0) && (errno != EAGAIN) && (errno != EINTR)) ||
+                ((events[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0)) {
+              (void) driver->readUplink();
+              driver->detachClient();
+            }
+            break;
+          }
+          default:
+            // TAG_UPLINK: the ring is read at the top of the loop
+            break;
+        }
+      }
+    }
+  }
+
+}
@@ -0,0 +1,161 @@
+// ======================================================================
+// \title  ShmRingDriver.hpp
+// \author cindy
+// \brief  hpp file for ShmRingDriver component implementation class
+// ======================================================================
+
+#ifndef MathModule_ShmRingDriver_HPP
+#define MathModule_ShmRingDriver_HPP
+
+#include "Components/ShmRingDriver/ShmRingDriverComponentAc.hpp"
+#include "Components/ShmRingDriver/ShmRing.hpp"
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
+
+#include <sys/un.h>
+
+namespace MathModule {
+
+  class ShmRingDriver :
+    public ShmRingDriverComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Bytes in each ring. Holds many frames, so the ground can fall behind briefly without stalling the downlink.
+      static const U32 RING_SIZE = ShmRing::DEFAULT_RING_SIZE;
+
+      //! Largest buffer requested from the allocate port for uplink bytes
+      static const U32 RECV_BUFFER_SIZE = 4096;
+
+      //! Retry period when no uplink buffer could be allocated, milliseconds
+      static const U32 ALLOCATE_RETRY_MS = 10;
+
+      //! Events handled per epoll_wait call
+      static const U32 MAX_EVENTS = 4;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct ShmRingDriver object
+      ShmRingDriver(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy ShmRingDriver object
+      ~ShmRingDriver();
+
+      //! Open the unix socket ground clients attach through. A stale socket file at the path is replaced.
+      //! \return true if the driver is listening
+      bool open(
+          const char* path //!< Socket path
+      );
+
+      //! Start the task that attaches clients and reads the uplink ring
+      void startReadThread(
+          NATIVE_UINT_TYPE priority, //!< Task priority
+          NATIVE_UINT_TYPE stackSize //!< Task stack size
+      );
+
+      //! Ask the task to exit
+      void quitReadThread();
+
+      //! Wait for the task to exit, detach the client and remove the socket
+      Os::Task::TaskStatus join();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! epoll user data of each descriptor the task waits on
+      enum Tag {
+        TAG_LISTEN = 1, //!< Handshake socket
+        TAG_SESSION = 2, //!< Connected client's socket, for hangups
+        TAG_UPLINK = 3, //!< Uplink data eventfd
+        TAG_WAKE = 4 //!< Wakeup from quitReadThread
+      };
+
+      //! Accept a client, set up its rings and hand it the descriptors
+      void attachClient();
+
+      //! Detach the client, waiting out any send in progress
+      void detachClient();
+
+      //! Pass up the bytes in the uplink ring
+      //! \return false if a buffer could not be allocated and bytes remain
+      bool readUplink();
+
+      //! Task entry point
+      static void ringTask(void* arg);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Socket path
+      struct sockaddr_un m_address;
+
+      //! Handshake socket, epoll instance, wakeup eventfd and client socket, or -1
+      int m_listenFd;
+      int m_epollFd;
+      int m_wakeFd;
+      int m_sessionFd;
+
+      //! The rings shared with the client
+      ShmRing::Endpoint m_endpoint;
+
+      //! Guards the connection state and the statistics
+      Os::Mutex m_lock;
+
+      //! Held by send while it writes to the rings, so a detach can wait for it
+      Os::Mutex m_sendLock;
+
+      //! Task attaching clients and reading the uplink ring
+      Os::Task m_task;
+
+      //! Whether the task was started, and whether it was asked to exit
+      bool m_started;
+      bool m_quit;
+
+      //! Whether a client is attached and sends may use the rings
+      bool m_connected;
+
+      //! Telemetry counters
+      U64 m_bytesSent;
+      U64 m_bytesReceived;
+      U32 m_sendStalls;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+// ======================================================================
+// \title  ShmRingBench.cpp
+// \author cindy
+// \brief  Compares the shared-memory rings with loopback TCP
+//
+// Usage: shm_ring_bench [frame-size] [frame-count]
+//
+// A producer thread plays the deployment and writes frames one call per
+// frame, as the com drivers do; the main thread plays the ground and reads
+// them. The shared-memory run goes through ShmRingClient and the same ring
+// code ShmRingDriver uses. Results are printed as one JSON object.
+// ======================================================================
+
+#include "Components/ShmRingDriver/client/ShmRingClient.hpp"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+  struct Result {
+    double seconds;
+    bool complete;
+  };
+
+  std::vector<uint8_t> testFrame(size_t size)
+  {
+    std::vector<uint8_t> frame(size);
+    for (size_t i = 0; i < size; i++) {
+      frame[i] = static_cast<uint8_t>(i * 7);
+    }
+    return frame;
+  }
+
+  Result runShm(const std::vector<uint8_t>& frame, size_t count)
+  {
+    char path[sizeof(sockaddr_un::sun_path)];
+    (void) ::snprintf(path, sizeof(path), "/tmp/shm_ring_bench.%d.sock", static_cast<int>(::getpid()));
+    (void) ::unlink(path);
+    struct sockaddr_un address;
+    ::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    ::memcpy(address.sun_path, path, ::strlen(path) + 1);
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if ((listener < 0) || (::bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) ||
+        (::listen(listener, 1) != 0)) {
+      ::perror("shm listen");
+      std::exit(1);
+    }
+
+    std::thread producer([&]() {
+      const int session = ::accept(listener, nullptr, nullptr);
+      MathModule::ShmRing::Endpoint endpoint;
+      if ((session < 0) || (endpoint.create(MathModule::ShmRing::DEFAULT_RING_SIZE) != 0) ||
+          (endpoint.sendDescriptors(session) != 0)) {
+        ::perror("shm session");
+        std::exit(1);
+      }
+      for (size_t sent = 0; sent < count; sent++) {
+        size_t written = 0;
+        while (written < frame.size()) {
+          written += endpoint.write(frame.data() + written, frame.size() - written);
+          if ((written < frame.size()) &&
+              (endpoint.waitWritable(-1, session) != MathModule::ShmRing::Endpoint::WAIT_READY)) {
+            ::close(session);
+            return;
+          }
+        }
+      }
+      // Wait for the ground to detach before the mapping goes away
+      uint8_t discard = 0;
+      (void) ::recv(session, &discard, sizeof(discard), 0);
+      ::close(session);
+    });
+
+    MathModule::ShmRingClient client;
+    if (client.connect(path) != 0) {
+      ::perror("shm connect");
+      std::exit(1);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const size_t total = frame.size() * count;
+    size_t received = 0;
+    std::vector<uint8_t> buffer(65536);
+    while (received < total) {
+      const ssize_t result = client.read(buffer.data(), buffer.size(), 5000);
+      if (result <= 0) {
+        break;
+      }
+      received += static_cast<size_t>(result);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    client.close();
+    producer.join();
+    ::close(listener);
+    (void) ::unlink(path);
+    return Result{std::chrono::duration<double>(stop - start).count(), received == total};
+  }
+
+  Result runTcp(const std::vector<uint8_t>& frame, size_t count)
+  {
+    const int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_in address;
+    ::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if ((listener < 0) || (::bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) ||
+        (::listen(listener, 1) != 0) ||
+        (::getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &length) != 0)) {
+      ::perror("tcp listen");
+      std::exit(1);
+    }
+
+    std::thread producer([&]() {
+      const int session = ::accept(listener, nullptr, nullptr);
+      const int one = 1;
+      (void) ::setsockopt(session, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      for (size_t sent = 0; sent < count; sent++) {
+        size_t written = 0;
+        while (written < frame.size()) {
+          const ssize_t result = ::send(session, frame.data() + written, frame.size() - written, MSG_NOSIGNAL);
+          if (result <= 0) {
+            ::close(session);
+            return;
+          }
+          written += static_cast<size_t>(result);
+        }
+      }
+      ::close(session);
+    });
+
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+      ::perror("tcp connect");
+      std::exit(1);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const size_t total = frame.size() * count;
+    size_t received = 0;
+    std::vector<uint8_t> buffer(65536);
+    while (received < total) {
+      const ssize_t result = ::recv(fd, buffer.data(), buffer.size(), 0);
+      if (result <= 0) {
+        break;
+      }
+      received += static_cast<size_t>(result);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    ::close(fd);
+    producer.join();
+    ::close(listener);
+    return Result{std::chrono::duration<double>(stop - start).count(), received == total};
+  }
+
+  void printResult(const char* name, const Result& result, size_t frameSize, size_t count)
+  {
+    std::printf("  \"%s\": {\"seconds\": %.6f, \"bytes_per_s\": %.0f, \"frames_per_s\": %.0f, \"complete\": %s},\n",
+                name, result.seconds, static_cast<double>(frameSize * count) / result.seconds,
+                static_cast<double>(count) / result.seconds, result.complete ? "true" : "false");
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  const size_t frameSize = (argc > 1) ? std::strtoul(argv[1], nullptr, 0) : 128;
+  const size_t count = (argc > 2) ? std::strtoul(argv[2], nullptr, 0) : 1000000;
+  if ((frameSize == 0) || (count == 0)) {
+    std::fprintf(stderr, "usage: %s [frame-size] [frame-count]\n", argv[0]);
+    return 1;
+  }
+  const std::vector<uint8_t> frame = testFrame(frameSize);
+
+  const Result shm = runShm(frame, count);
+  const Result tcp = runTcp(frame, count);
+  std::printf("{\n  \"frame_size\": %zu,\n  \"frames\": %zu,\n", frameSize, count);
+  printResult("shm", shm, frameSize, count);
+  printResult("tcp", tcp, frameSize, count);
+  std::printf("  \"speedup\": %.2f\n}\n", tcp.seconds / shm.seconds);
+  return (shm.complete && tcp.complete) ? 0 : 1;
+}
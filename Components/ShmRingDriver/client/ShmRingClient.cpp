@@ -0,0 +1,162 @@
+// ======================================================================
+// \title  ShmRingClient.cpp
+// \author cindy
+// \brief  Ground-side client of ShmRingDriver
+// ======================================================================
+
+#include "Components/ShmRingDriver/client/ShmRingClient.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    int64_t monotonicMs()
+    {
+      struct timespec now;
+      (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+      return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+    }
+
+  }
+
+  ShmRingClient ::
+    ShmRingClient() :
+      m_socket(-1)
+  {
+  }
+
+  ShmRingClient ::
+    ~ShmRingClient()
+  {
+    this->close();
+  }
+
+  int ShmRingClient ::
+    connect(const char* path)
+  {
+    this->close();
+    struct sockaddr_un address;
+    ::memset(&address, 0, sizeof(address));
+    if (::strlen(path) >= sizeof(address.sun_path)) {
+      return ENAMETOOLONG;
+    }
+    address.sun_family = AF_UNIX;
+    (void) ::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+      return errno;
+    }
+    if (::connect(fd, reinterpret_cast<const struct sockaddr*>(&address), sizeof(address)) != 0) {
+      const int error = errno;
+      (void) ::close(fd);
+      return error;
+    }
+    const int error = this->m_endpoint.receiveDescriptors(fd);
+    if (error != 0) {
+      (void) ::close(fd);
+      return error;
+    }
+    this->m_socket = fd;
+    return 0;
+  }
+
+  void ShmRingClient ::
+    close()
+  {
+    this->m_endpoint.close();
+    if (this->m_socket >= 0) {
+      (void) ::close(this->m_socket);
+      this->m_socket = -1;
+    }
+  }
+
+  bool ShmRingClient ::
+    isConnected() const
+  {
+    return this->m_socket >= 0;
+  }
+
+  bool ShmRingClient ::
+    write(const void* data, size_t size, int timeoutMs)
+  {
+    if (!this->isConnected()) {
+      return false;
+    }
+    const int64_t deadline = monotonicMs() + timeoutMs;
+    size_t written = 0;
+    while (true) {
+      written += this->m_endpoint.write(static_cast<const uint8_t*>(data) + written, size - written);
+      if (written == size) {
+        return true;
+      }
+      int remaining = -1;
+      if (timeoutMs >= 0) {
+        const int64_t left = deadline - monotonicMs();
+        remaining = (left > 0) ? static_cast<int>(left) : 0;
+      }
+      if (this->m_endpoint.waitWritable(remaining, this->m_socket) != ShmRing::Endpoint::WAIT_READY) {
+        return false;
+      }
+    }
+  }
+
+  /*
+    Bytes already in the ring are returned even after the deployment
+    detached, so nothing it wrote before exiting is lost.
+  */
+  ssize_t ShmRingClient ::
+    read(void* data, size_t size, int timeoutMs)
+  {
+    if (!this->isConnected()) {
+      return -1;
+    }
+    while (true) {
+      const size_t count = this->m_endpoint.read(data, size);
+      if ((count > 0) || (size == 0)) {
+        return static_cast<ssize_t>(count);
+      }
+      switch (this->m_endpoint.waitReadable(timeoutMs, this->m_socket)) {
+        case ShmRing::Endpoint::WAIT_READY:
+          break;
+        case ShmRing::Endpoint::WAIT_TIMEOUT:
+          return 0;
+        default:
+          // A hangup is only reported once the ring is empty
+          return -1;
+      }
+    }
+  }
+
+  int ShmRingClient ::
+    readFd() const
+  {
+    return this->m_endpoint.receiveFd();
+  }
+
+  bool ShmRingClient ::
+    armRead()
+  {
+    return this->m_endpoint.armReceive();
+  }
+
+  void ShmRingClient ::
+    disarmRead()
+  {
+    this->m_endpoint.disarmReceive();
+  }
+
+  uint32_t ShmRingClient ::
+    wakeupsSent() const
+  {
+    return this->m_endpoint.wakeupsSent();
+  }
+
+}
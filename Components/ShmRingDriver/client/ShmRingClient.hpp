@@ -0,0 +1,85 @@
+// ======================================================================
+// \title  ShmRingClient.hpp
+// \author cindy
+// \brief  Ground-side client of ShmRingDriver
+//
+// Attaches to a deployment on the same host and exchanges the same byte
+// stream of F´ frames a TCP ground link carries. Needs no F´ headers.
+// ======================================================================
+
+#ifndef MathModule_ShmRingClient_HPP
+#define MathModule_ShmRingClient_HPP
+
+#include "Components/ShmRingDriver/ShmRing.hpp"
+
+#include <sys/types.h>
+
+namespace MathModule {
+
+  class ShmRingClient {
+
+    public:
+
+      ShmRingClient();
+
+      //! Detach if attached
+      ~ShmRingClient();
+
+      //! Attach to the deployment listening on a unix socket path
+      //! \return 0 on success, otherwise the errno value
+      int connect(const char* path);
+
+      //! Detach. The deployment sees the socket close and stops sending.
+      void close();
+
+      //! Whether the client is attached
+      bool isConnected() const;
+
+      //! Write every byte to the uplink ring, waiting for space as needed
+      //! \return false if the deployment detached or the timeout elapsed first
+      bool write(
+          const void* data, //!< Bytes to send
+          size_t size, //!< Number of bytes
+          int timeoutMs //!< Timeout for the whole write, -1 for none
+      );
+
+      //! Read downlink bytes, waiting until at least one arrives
+      //! \return bytes read, 0 if the timeout elapsed, -1 if the deployment detached
+      ssize_t read(
+          void* data, //!< Destination
+          size_t size, //!< Largest number of bytes to read
+          int timeoutMs //!< Timeout, -1 for none
+      );
+
+      //! Eventfd to poll for downlink data, for callers with their own event loop.
+      //! Arm it with armRead before polling and call disarmRead after each wakeup.
+      int readFd() const;
+
+      //! Ask the deployment to signal readFd on its next write
+      //! \return false if data is already waiting, so the caller must not sleep
+      bool armRead();
+
+      //! Stop signals on readFd and clear it
+      void disarmRead();
+
+      //! Eventfd signals sent to the deployment
+      uint32_t wakeupsSent() const;
+
+    private:
+
+      ShmRingClient(const ShmRingClient&) = delete;
+      ShmRingClient& operator=(const ShmRingClient&) = delete;
+
+    private:
+
+      //! Handshake socket, kept open for the session so each side sees the other go away, or -1
+      int m_socket;
+
+      //! The rings shared with the deployment
+      ShmRing::Endpoint m_endpoint;
+
+  };
+
+}
+
+#endif
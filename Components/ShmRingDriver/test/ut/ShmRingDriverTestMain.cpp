@@ -0,0 +1,36 @@
+// ======================================================================
+// \title  ShmRingDriverTestMain.cpp
+// \author cindy
+// \brief  cpp file for ShmRingDriver component test main function
+// ======================================================================
+
+#include "ShmRingDriverTester.hpp"
+
+TEST(Nominal, Downlink) {
+  MathModule::ShmRingDriverTester tester;
+  ASSERT_TRUE(tester.openDriver());
+  tester.testDownlink();
+}
+
+TEST(Nominal, Uplink) {
+  MathModule::ShmRingDriverTester tester;
+  ASSERT_TRUE(tester.openDriver());
+  tester.testUplink();
+}
+
+TEST(Nominal, SlowClient) {
+  MathModule::ShmRingDriverTester tester;
+  ASSERT_TRUE(tester.openDriver());
+  tester.testSlowClient();
+}
+
+TEST(Nominal, Reattach) {
+  MathModule::ShmRingDriverTester tester;
+  ASSERT_TRUE(tester.openDriver());
+  tester.testReattach();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,293 @@
+// ======================================================================
+// \title  ShmRingDriverTester.cpp
+// \author cindy
+// \brief  cpp file for ShmRingDriver component test harness implementation class
+// ======================================================================
+
+#include "ShmRingDriverTester.hpp"
+
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    std::vector<U8> testPayload(U32 size, U8 seed)
+    {
+      std::vector<U8> payload(size);
+      for (U32 i = 0; i < size; i++) {
+        payload[i] = static_cast<U8>(seed + 3 * i + (i >> 12));
+      }
+      return payload;
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  ShmRingDriverTester ::
+    ShmRingDriverTester() :
+      ShmRingDriverGTestBase("ShmRingDriverTester", ShmRingDriverTester::MAX_HISTORY_SIZE),
+      component("ShmRingDriver"),
+      m_receivedBytes(0),
+      m_deallocated(0),
+      m_ready(0),
+      m_reportedConnected(false)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/ShmRingDriverTester.%d.sock", static_cast<int>(::getpid()));
+    this->m_path = path;
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  ShmRingDriverTester ::
+    ~ShmRingDriverTester()
+  {
+    this->closeDriver();
+  }
+
+  bool ShmRingDriverTester ::
+    openDriver()
+  {
+    if (!this->component.open(this->m_path.c_str())) {
+      return false;
+    }
+    this->component.startReadThread(Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+    return true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void ShmRingDriverTester ::
+    testDownlink()
+  {
+    std::vector<U8> early = testPayload(64, 0x10);
+    Fw::Buffer earlyBuffer(early.data(), static_cast<U32>(early.size()));
+    EXPECT_EQ(this->invoke_to_send(0, earlyBuffer), Drv::SendStatus::SEND_ERROR);
+    EXPECT_EQ(this->m_deallocated, 1U);
+
+    ASSERT_EQ(this->m_client.connect(this->m_path.c_str()), 0);
+    ASSERT_TRUE(this->waitForConnected(true));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_ready, 1U);
+    this->m_lock.unLock();
+
+    std::vector<U8> frames[3] = {testPayload(100, 0x20), testPayload(1000, 0x30), testPayload(5000, 0x40)};
+    std::vector<U8> expected;
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(frames); i++) {
+      Fw::Buffer buffer(frames[i].data(), static_cast<U32>(frames[i].size()));
+      EXPECT_EQ(this->invoke_to_send(0, buffer), Drv::SendStatus::SEND_OK);
+      expected.insert(expected.end(), frames[i].begin(), frames[i].end());
+    }
+    EXPECT_EQ(this->m_deallocated, 1 + FW_NUM_ARRAY_ELEMENTS(frames));
+    EXPECT_EQ(this->readClient(this->m_client, expected.size()), expected);
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_BYTES_SENT_SIZE(1);
+    ASSERT_TLM_BYTES_SENT(0, expected.size());
+  }
+
+  void ShmRingDriverTester ::
+    testUplink()
+  {
+    ASSERT_EQ(this->m_client.connect(this->m_path.c_str()), 0);
+    ASSERT_TRUE(this->waitForConnected(true));
+
+    const std::vector<U8> first = testPayload(100, 0x50);
+    const std::vector<U8> second = testPayload(3 * ShmRingDriver::RECV_BUFFER_SIZE + 10, 0x60);
+    ASSERT_TRUE(this->m_client.write(first.data(), first.size(), 1000));
+    ASSERT_TRUE(this->waitForReceivedBytes(first.size()));
+    ASSERT_TRUE(this->m_client.write(second.data(), second.size(), 1000));
+    ASSERT_TRUE(this->waitForReceivedBytes(first.size() + second.size()));
+
+    std::vector<U8> expected(first);
+    expected.insert(expected.end(), second.begin(), second.end());
+    std::vector<U8> received;
+    this->m_lock.lock();
+    for (const std::vector<U8>& buffer : this->m_received) {
+      EXPECT_LE(buffer.size(), static_cast<size_t>(ShmRingDriver::RECV_BUFFER_SIZE));
+      received.insert(received.end(), buffer.begin(), buffer.end());
+    }
+    this->m_lock.unLock();
+    EXPECT_EQ(received, expected);
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_BYTES_RECEIVED_SIZE(1);
+    ASSERT_TLM_BYTES_RECEIVED(0, expected.size());
+  }
+
+  void ShmRingDriverTester ::
+    testSlowClient()
+  {
+    ASSERT_EQ(this->m_client.connect(this->m_path.c_str()), 0);
+    ASSERT_TRUE(this->waitForConnected(true));
+
+    std::vector<U8> frame = testPayload(2 * ShmRingDriver::RING_SIZE + 1000, 0x70);
+    Drv::SendStatus status = Drv::SendStatus::SEND_ERROR;
+    std::thread sender([&]() {
+      Fw::Buffer buffer(frame.data(), static_cast<U32>(frame.size()));
+      status = this->invoke_to_send(0, buffer);
+    });
+    (void) ::usleep(100000);
+    EXPECT_EQ(this->readClient(this->m_client, frame.size()), frame);
+    sender.join();
+    EXPECT_EQ(status, Drv::SendStatus::SEND_OK);
+    EXPECT_EQ(this->m_deallocated, 1U);
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_SEND_STALLS_SIZE(1);
+    ASSERT_TLM_SEND_STALLS(0, 1);
+  }
+
+  void ShmRingDriverTester ::
+    testReattach()
+  {
+    ASSERT_EQ(this->m_client.connect(this->m_path.c_str()), 0);
+    ASSERT_TRUE(this->waitForConnected(true));
+
+    // The client never reads, so the send blocks on the full ring until the client goes away
+    std::vector<U8> large = testPayload(2 * ShmRingDriver::RING_SIZE, 0x80);
+    Drv::SendStatus status = Drv::SendStatus::SEND_OK;
+    std::thread sender([&]() {
+      Fw::Buffer buffer(large.data(), static_cast<U32>(large.size()));
+      status = this->invoke_to_send(0, buffer);
+    });
+    (void) ::usleep(100000);
+    this->m_client.close();
+    sender.join();
+    EXPECT_EQ(status, Drv::SendStatus::SEND_ERROR);
+    EXPECT_EQ(this->m_deallocated, 1U);
+    ASSERT_TRUE(this->waitForConnected(false));
+
+    ASSERT_EQ(this->m_client.connect(this->m_path.c_str()), 0);
+    ASSERT_TRUE(this->waitForConnected(true));
+    std::vector<U8> small = testPayload(200, 0x90);
+    Fw::Buffer buffer(small.data(), static_cast<U32>(small.size()));
+    EXPECT_EQ(this->invoke_to_send(0, buffer), Drv::SendStatus::SEND_OK);
+    EXPECT_EQ(this->readClient(this->m_client, small.size()), small);
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_ready, 2U);
+    this->m_lock.unLock();
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer ShmRingDriverTester ::
+    from_allocate_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    return Fw::Buffer(new U8[size], size);
+  }
+
+  void ShmRingDriverTester ::
+    from_deallocate_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_lock.lock();
+    ++this->m_deallocated;
+    this->m_lock.unLock();
+  }
+
+  void ShmRingDriverTester ::
+    from_ready_handler(NATIVE_INT_TYPE portNum)
+  {
+    this->m_lock.lock();
+    ++this->m_ready;
+    this->m_lock.unLock();
+  }
+
+  void ShmRingDriverTester ::
+    from_recv_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    EXPECT_EQ(recvStatus, Drv::RecvStatus::RECV_OK);
+    this->m_lock.lock();
+    this->m_received.push_back(std::vector<U8>(recvBuffer.getData(), recvBuffer.getData() + recvBuffer.getSize()));
+    this->m_receivedBytes += recvBuffer.getSize();
+    this->m_lock.unLock();
+    delete[] recvBuffer.getData();
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void ShmRingDriverTester ::
+    closeDriver()
+  {
+    this->m_client.close();
+    this->component.quitReadThread();
+    (void) this->component.join();
+  }
+
+  /*
+    CONNECTED is reported on change only, so the last value seen is kept for
+    polls that report nothing.
+  */
+  bool ShmRingDriverTester ::
+    waitForConnected(bool connected)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->clearTlm();
+      this->invoke_to_schedIn(0, 0);
+      if (this->tlmHistory_CONNECTED->size() > 0) {
+        this->m_reportedConnected = this->tlmHistory_CONNECTED->at(0).arg;
+      }
+      if (this->m_reportedConnected == connected) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+  std::vector<U8> ShmRingDriverTester ::
+    readClient(ShmRingClient& client, size_t count)
+  {
+    std::vector<U8> bytes;
+    U8 chunk[65536];
+    while (bytes.size() < count) {
+      const ssize_t received = client.read(chunk, FW_MIN(sizeof(chunk), count - bytes.size()), 1000);
+      if (received <= 0) {
+        break;
+      }
+      bytes.insert(bytes.end(), chunk, chunk + received);
+    }
+    return bytes;
+  }
+
+  bool ShmRingDriverTester ::
+    waitForReceivedBytes(size_t count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool done = (this->m_receivedBytes >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+}
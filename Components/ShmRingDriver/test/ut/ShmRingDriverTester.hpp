@@ -0,0 +1,162 @@
+// ======================================================================
+// \title  ShmRingDriverTester.hpp
+// \author cindy
+// \brief  hpp file for ShmRingDriver component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_ShmRingDriverTester_HPP
+#define MathModule_ShmRingDriverTester_HPP
+
+#include "ShmRingDriverGTestBase.hpp"
+#include "Components/ShmRingDriver/ShmRingDriver.hpp"
+#include "Components/ShmRingDriver/client/ShmRingClient.hpp"
+#include <Os/Mutex.hpp>
+
+#include <string>
+#include <vector>
+
+namespace MathModule {
+
+  class ShmRingDriverTester :
+    public ShmRingDriverGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object ShmRingDriverTester
+      ShmRingDriverTester();
+
+      //! Destroy object ShmRingDriverTester
+      ~ShmRingDriverTester();
+
+      //! Listen on a socket under /tmp and start the driver task
+      //! \return false if the socket could not be opened
+      bool openDriver();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Frames sent reach the client in order, and each buffer is returned once
+      void testDownlink();
+
+      //! Bytes the client writes are passed up in order, in buffers of at most RECV_BUFFER_SIZE
+      void testUplink();
+
+      //! A frame larger than the ring waits for the client to read, then arrives whole
+      void testSlowClient();
+
+      //! A client detaching ends a blocked send, and a new client gets fresh rings
+      void testReattach();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for allocate
+      Fw::Buffer from_allocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for deallocate
+      void from_deallocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for ready
+      void from_ready_handler(
+          NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for recv
+      void from_recv_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Stop the driver and detach the client
+      void closeDriver();
+
+      //! Wait until the driver reports the given connection state
+      bool waitForConnected(bool connected);
+
+      //! Read from the client until the given number of bytes arrived or a timeout
+      std::vector<U8> readClient(ShmRingClient& client, size_t count);
+
+      //! Wait until the driver has passed up the given number of bytes
+      bool waitForReceivedBytes(size_t count);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      ShmRingDriver component;
+
+      //! Socket path
+      std::string m_path;
+
+      //! Ground client
+      ShmRingClient m_client;
+
+      //! Guards the state touched by the driver task
+      Os::Mutex m_lock;
+
+      //! Uplink buffers passed up by the driver
+      std::vector<std::vector<U8> > m_received;
+      size_t m_receivedBytes;
+
+      //! Buffers returned through the deallocate port
+      U32 m_deallocated;
+
+      //! Calls to ready
+      U32 m_ready;
+
+      //! Last CONNECTED value reported
+      bool m_reportedConnected;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,479 @@
+// ======================================================================
+// \title  SlipSerialDriver.cpp
+// \author cindy
+// \brief  cpp file for SlipSerialDriver component implementation class
+// ======================================================================
+
+#include "Components/SlipSerialDriver/SlipSerialDriver.hpp"
+#include <Fw/Types/Assert.hpp>
+#include <Utils/Hash/Hash.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    //! Name carried by heartbeats, matching the ground adapters' user-name field
+    const char HEARTBEAT_NAME[] = "FPrimeDeployment";
+
+    //! Map a baud rate to its termios speed
+    bool toSpeed(U32 baud, speed_t& speed)
+    {
+      switch (baud) {
+        case 9600: speed = B9600; return true;
+        case 19200: speed = B19200; return true;
+        case 38400: speed = B38400; return true;
+        case 57600: speed = B57600; return true;
+        case 115200: speed = B115200; return true;
+        case 230400: speed = B230400; return true;
+#ifdef B460800
+        case 460800: speed = B460800; return true;
+#endif
+#ifdef B921600
+        case 921600: speed = B921600; return true;
+#endif
+        default: return false;
+      }
+    }
+
+    void putU16(U8* out, U16 value)
+    {
+      out[0] = static_cast<U8>(value >> 8);
+      out[1] = static_cast<U8>(value);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  SlipSerialDriver ::
+    SlipSerialDriver(const char* const compName) :
+      SlipSerialDriverComponentBase(compName),
+      m_fd(-1),
+      m_checkSequence(true),
+      m_rxSize(0),
+      m_rxEscape(false),
+      m_rxDiscard(false),
+      m_readTaskStarted(false),
+      m_quit(false),
+      m_framesSent(0),
+      m_framesReceived(0),
+      m_heartbeatsReceived(0),
+      m_decodeErrors(0)
+  {
+    ::memset(this->m_mac, 0, sizeof(this->m_mac));
+  }
+
+  SlipSerialDriver ::
+    ~SlipSerialDriver()
+  {
+    if (this->m_fd >= 0) {
+      (void) ::close(this->m_fd);
+    }
+  }
+
+  /*
+    The address follows the ground adapters: AE:20 marks it locally
+    administered and unicast, the remaining four bytes are random so several
+    deployments can share a SatCat5 switch.
+  */
+  bool SlipSerialDriver ::
+    open(const char* device, U32 baud, bool checkSequence)
+  {
+    FW_ASSERT(device != nullptr);
+    FW_ASSERT(this->m_fd < 0);
+    Fw::LogStringArg deviceArg(device);
+    this->m_checkSequence = checkSequence;
+
+    speed_t speed;
+    if (!toSpeed(baud, speed)) {
+      this->log_WARNING_HI_PORT_OPEN_ERROR(deviceArg, EINVAL);
+      return false;
+    }
+    const int fd = ::open(device, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (fd < 0) {
+      this->log_WARNING_HI_PORT_OPEN_ERROR(deviceArg, errno);
+      return false;
+    }
+    struct termios options;
+    if (::tcgetattr(fd, &options) != 0) {
+      const I32 error = errno;
+      (void) ::close(fd);
+      this->log_WARNING_HI_PORT_OPEN_ERROR(deviceArg, error);
+      return false;
+    }
+    ::cfmakeraw(&options);
+    options.c_cflag |= (CLOCAL | CREAD);
+    options.c_cflag &= ~(CSTOPB | CRTSCTS);
+    options.c_cc[VMIN] = 1;
+    options.c_cc[VTIME] = 0;
+    if ((::cfsetispeed(&options, speed) != 0) || (::cfsetospeed(&options, speed) != 0) ||
+        (::tcsetattr(fd, TCSANOW, &options) != 0)) {
+      const I32 error = errno;
+      (void) ::close(fd);
+      this->log_WARNING_HI_PORT_OPEN_ERROR(deviceArg, error);
+      return false;
+    }
+    (void) ::tcflush(fd, TCIOFLUSH);
+
+    this->m_mac[0] = 0xAE;
+    this->m_mac[1] = 0x20;
+    const int random = ::open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if ((random < 0) || (::read(random, &this->m_mac[2], MAC_SIZE - 2) != static_cast<ssize_t>(MAC_SIZE - 2))) {
+      struct timespec now;
+      (void) clock_gettime(CLOCK_REALTIME, &now);
+      const U32 seed = static_cast<U32>(now.tv_nsec) ^ static_cast<U32>(::getpid());
+      ::memcpy(&this->m_mac[2], &seed, MAC_SIZE - 2);
+    }
+    if (random >= 0) {
+      (void) ::close(random);
+    }
+
+    this->m_fd = fd;
+    this->log_ACTIVITY_HI_PORT_OPENED(deviceArg, baud);
+    return true;
+  }
+
+  void SlipSerialDriver ::
+    startReadThread(NATIVE_UINT_TYPE priority, NATIVE_UINT_TYPE stackSize)
+  {
+    FW_ASSERT(this->m_fd >= 0);
+    FW_ASSERT(!this->m_readTaskStarted);
+    Os::TaskString name("SlipRead");
+    const Os::Task::TaskStatus status =
+      this->m_readTask.start(name, SlipSerialDriver::readTask, this, priority, stackSize);
+    FW_ASSERT(status == Os::Task::TASK_OK, status);
+    this->m_readTaskStarted = true;
+  }
+
+  void SlipSerialDriver ::
+    quitReadThread()
+  {
+    this->m_lock.lock();
+    this->m_quit = true;
+    this->m_lock.unLock();
+  }
+
+  Os::Task::TaskStatus SlipSerialDriver ::
+    join()
+  {
+    Os::Task::TaskStatus status = Os::Task::TASK_OK;
+    if (this->m_readTaskStarted) {
+      status = this->m_readTask.join(nullptr);
+      this->m_readTaskStarted = false;
+    }
+    if (this->m_fd >= 0) {
+      (void) ::close(this->m_fd);
+      this->m_fd = -1;
+    }
+    return status;
+  }
+
+  const U8* SlipSerialDriver ::
+    getMacAddress() const
+  {
+    return this->m_mac;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    The deframer reassembles F´ frames from a byte stream, so a frame longer
+    than the Ethernet MTU is simply carried in consecutive Ethernet frames.
+  */
+  Drv::SendStatus SlipSerialDriver ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    I32 error = (this->m_fd < 0) ? EBADF : 0;
+    const U8* data = sendBuffer.getData();
+    U32 remaining = sendBuffer.getSize();
+    while ((error == 0) && (remaining > 0)) {
+      const U32 chunk = FW_MIN(remaining, MTU);
+      error = this->writeFrame(ETHERTYPE_FPRIME, data, chunk);
+      data += chunk;
+      remaining -= chunk;
+    }
+    this->deallocate_out(0, sendBuffer);
+
+    if (error != 0) {
+      this->log_WARNING_HI_WRITE_ERROR(error);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  /*
+    The ground parses one compact telemetry packet per Ethernet frame, so a
+    packet is never split.
+  */
+  Drv::SendStatus SlipSerialDriver ::
+    tlmSend_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& sendBuffer
+    )
+  {
+    I32 error = (this->m_fd < 0) ? EBADF : 0;
+    if ((error == 0) && (sendBuffer.getSize() > MTU)) {
+      error = EMSGSIZE;
+    }
+    if (error == 0) {
+      error = this->writeFrame(ETHERTYPE_TELEMETRY, sendBuffer.getData(), sendBuffer.getSize());
+    }
+    this->deallocate_out(0, sendBuffer);
+
+    if (error != 0) {
+      this->log_WARNING_HI_WRITE_ERROR(error);
+      return Drv::SendStatus::SEND_ERROR;
+    }
+    return Drv::SendStatus::SEND_OK;
+  }
+
+  void SlipSerialDriver ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    if (this->m_fd >= 0) {
+      U8 heartbeat[sizeof(U16) + sizeof(HEARTBEAT_NAME) - 1];
+      putU16(heartbeat, static_cast<U16>(sizeof(HEARTBEAT_NAME) - 1));
+      ::memcpy(&heartbeat[sizeof(U16)], HEARTBEAT_NAME, sizeof(HEARTBEAT_NAME) - 1);
+      (void) this->writeFrame(ETHERTYPE_HEARTBEAT, heartbeat, sizeof(heartbeat));
+    }
+
+    this->m_lock.lock();
+    const U32 framesReceived = this->m_framesReceived;
+    const U32 heartbeatsReceived = this->m_heartbeatsReceived;
+    const U32 decodeErrors = this->m_decodeErrors;
+    this->m_lock.unLock();
+
+    this->tlmWrite_FRAMES_SENT(this->m_framesSent);
+    this->tlmWrite_FRAMES_RECEIVED(framesReceived);
+    this->tlmWrite_HEARTBEATS_RECEIVED(heartbeatsReceived);
+    this->tlmWrite_DECODE_ERRORS(decodeErrors);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    Callers hold the component mutex (guarded ports), which serializes use of
+    the transmit buffers and keeps frames from interleaving on the wire.
+  */
+  I32 SlipSerialDriver ::
+    writeFrame(U16 etherType, const U8* payload, U32 size)
+  {
+    FW_ASSERT(size <= MTU, size);
+    U8* frame = this->m_txFrame;
+    ::memset(frame, 0xFF, MAC_SIZE);
+    ::memcpy(&frame[MAC_SIZE], this->m_mac, MAC_SIZE);
+    putU16(&frame[2 * MAC_SIZE], etherType);
+    ::memcpy(&frame[HEADER_SIZE], payload, size);
+    U32 frameSize = HEADER_SIZE + size;
+    if (this->m_checkSequence) {
+      // The check sequence goes out least significant byte first
+      const U32 fcs = checkSequence(frame, frameSize);
+      for (U32 i = 0; i < FCS_SIZE; i++) {
+        frame[frameSize++] = static_cast<U8>(fcs >> (8 * i));
+      }
+    }
+
+    // A leading END flushes any line noise the receiver has accumulated
+    U32 encoded = 0;
+    this->m_txEncoded[encoded++] = SLIP_END;
+    for (U32 i = 0; i < frameSize; i++) {
+      if (frame[i] == SLIP_END) {
+        this->m_txEncoded[encoded++] = SLIP_ESC;
+        this->m_txEncoded[encoded++] = SLIP_ESC_END;
+      } else if (frame[i] == SLIP_ESC) {
+        this->m_txEncoded[encoded++] = SLIP_ESC;
+        this->m_txEncoded[encoded++] = SLIP_ESC_ESC;
+      } else {
+        this->m_txEncoded[encoded++] = frame[i];
+      }
+    }
+    this->m_txEncoded[encoded++] = SLIP_END;
+
+    U32 written = 0;
+    while (written < encoded) {
+      const ssize_t result = ::write(this->m_fd, &this->m_txEncoded[written], encoded - written);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno;
+      }
+      written += static_cast<U32>(result);
+    }
+    ++this->m_framesSent;
+    return 0;
+  }
+
+  void SlipSerialDriver ::
+    decode(const U8* data, U32 size)
+  {
+    for (U32 i = 0; i < size; i++) {
+      U8 byte = data[i];
+      if (byte == SLIP_END) {
+        if (this->m_rxDiscard) {
+          this->m_lock.lock();
+          ++this->m_decodeErrors;
+          this->m_lock.unLock();
+        } else if (this->m_rxSize > 0) {
+          this->handleFrame(this->m_rxFrame, this->m_rxSize);
+        }
+        this->m_rxSize = 0;
+        this->m_rxEscape = false;
+        this->m_rxDiscard = false;
+        continue;
+      }
+      if (this->m_rxDiscard) {
+        continue;
+      }
+      if (this->m_rxEscape) {
+        this->m_rxEscape = false;
+        if (byte == SLIP_ESC_END) {
+          byte = SLIP_END;
+        } else if (byte == SLIP_ESC_ESC) {
+          byte = SLIP_ESC;
+        } else {
+          this->m_rxDiscard = true;
+          continue;
+        }
+      } else if (byte == SLIP_ESC) {
+        this->m_rxEscape = true;
+        continue;
+      }
+      if (this->m_rxSize == MAX_FRAME_SIZE) {
+        this->m_rxDiscard = true;
+        continue;
+      }
+      this->m_rxFrame[this->m_rxSize++] = byte;
+    }
+  }
+
+  /*
+    Frames addressed to another station, and our own frames echoed back by a
+    switch, are dropped quietly. Only F´ frames reach the deframer; heartbeats
+    are counted so the ground link can be monitored.
+  */
+  void SlipSerialDriver ::
+    handleFrame(const U8* frame, U32 size)
+  {
+    const U32 trailer = this->m_checkSequence ? FCS_SIZE : 0;
+    bool valid = (size >= HEADER_SIZE + trailer);
+    if (valid && this->m_checkSequence) {
+      size -= FCS_SIZE;
+      U32 fcs = 0;
+      for (U32 i = 0; i < FCS_SIZE; i++) {
+        fcs |= static_cast<U32>(frame[size + i]) << (8 * i);
+      }
+      valid = (fcs == checkSequence(frame, size));
+    }
+    if (!valid) {
+      this->m_lock.lock();
+      ++this->m_decodeErrors;
+      this->m_lock.unLock();
+      return;
+    }
+
+    static const U8 broadcast[MAC_SIZE] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    const bool forUs = (::memcmp(frame, broadcast, MAC_SIZE) == 0) ||
+                       (::memcmp(frame, this->m_mac, MAC_SIZE) == 0);
+    const bool fromUs = (::memcmp(&frame[MAC_SIZE], this->m_mac, MAC_SIZE) == 0);
+    if (!forUs || fromUs) {
+      return;
+    }
+
+    const U16 etherType = static_cast<U16>((frame[2 * MAC_SIZE] << 8) | frame[2 * MAC_SIZE + 1]);
+    const U32 payloadSize = size - HEADER_SIZE;
+    if (etherType == ETHERTYPE_HEARTBEAT) {
+      this->m_lock.lock();
+      ++this->m_heartbeatsReceived;
+      this->m_lock.unLock();
+      return;
+    }
+    if ((etherType != ETHERTYPE_FPRIME) || (payloadSize == 0)) {
+      return;
+    }
+
+    Fw::Buffer buffer = this->allocate_out(0, payloadSize);
+    if ((buffer.getData() == nullptr) || (buffer.getSize() < payloadSize)) {
+      if (buffer.getData() != nullptr) {
+        this->deallocate_out(0, buffer);
+      }
+      this->m_lock.lock();
+      ++this->m_decodeErrors;
+      this->m_lock.unLock();
+      return;
+    }
+    ::memcpy(buffer.getData(), &frame[HEADER_SIZE], payloadSize);
+    buffer.setSize(payloadSize);
+    this->m_lock.lock();
+    ++this->m_framesReceived;
+    this->m_lock.unLock();
+    this->recv_out(0, buffer, Drv::RecvStatus::RECV_OK);
+  }
+
+  U32 SlipSerialDriver ::
+    checkSequence(const U8* data, U32 size)
+  {
+    // Utils::Hash is the F´ CRC-32, the same polynomial and reflection as the Ethernet FCS
+    Utils::Hash hash;
+    hash.init();
+    hash.update(data, static_cast<NATIVE_INT_TYPE>(size));
+    U32 value = 0;
+    hash.final(value);
+    return value;
+  }
+
+  void SlipSerialDriver ::
+    readTask(void* arg)
+  {
+    SlipSerialDriver* driver = static_cast<SlipSerialDriver*>(arg);
+    FW_ASSERT(driver != nullptr);
+    driver->ready_out(0);
+
+    U8 chunk[READ_CHUNK_SIZE];
+    while (true) {
+      driver->m_lock.lock();
+      const bool quit = driver->m_quit;
+      driver->m_lock.unLock();
+      if (quit) {
+        break;
+      }
+
+      struct pollfd pfd;
+      pfd.fd = driver->m_fd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      const int ready = ::poll(&pfd, 1, static_cast<int>(READ_POLL_MS));
+      if (ready <= 0) {
+        continue;
+      }
+      const ssize_t received = ::read(driver->m_fd, chunk, sizeof(chunk));
+      if (received > 0) {
+        driver->decode(chunk, static_cast<U32>(received));
+      } else if ((received < 0) && (errno != EINTR) && (errno != EAGAIN)) {
+        // A pseudo-terminal reports EIO while its other end is closed; wait for it to reopen
+        (void) ::usleep(READ_POLL_MS * 1000);
+      }
+    }
+  }
+
+}
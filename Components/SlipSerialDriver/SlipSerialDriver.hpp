@@ -0,0 +1,200 @@
+// ======================================================================
+// \title  SlipSerialDriver.hpp
+// \author cindy
+// \brief  hpp file for SlipSerialDriver component implementation class
+// ======================================================================
+
+#ifndef MathModule_SlipSerialDriver_HPP
+#define MathModule_SlipSerialDriver_HPP
+
+#include "Components/SlipSerialDriver/SlipSerialDriverComponentAc.hpp"
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
+
+namespace MathModule {
+
+  class SlipSerialDriver :
+    public SlipSerialDriverComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! SLIP special characters (RFC 1055)
+      static const U8 SLIP_END = 0xC0;
+      static const U8 SLIP_ESC = 0xDB;
+      static const U8 SLIP_ESC_END = 0xDC;
+      static const U8 SLIP_ESC_ESC = 0xDD;
+
+      //! Ethernet header layout: destination MAC, source MAC, EtherType
+      static const U32 MAC_SIZE = 6;
+      static const U32 HEADER_SIZE = 2 * MAC_SIZE + sizeof(U16);
+
+      //! Ethernet frame check sequence appended by SatCat5 SLIP ports
+      static const U32 FCS_SIZE = sizeof(U32);
+
+      //! Largest payload in one Ethernet frame. Longer sends are split across frames.
+      static const U32 MTU = 1500;
+
+      //! Largest decoded frame
+      static const U32 MAX_FRAME_SIZE = HEADER_SIZE + MTU + FCS_SIZE;
+
+      //! Largest encoded frame: every byte escaped, plus a leading and trailing END
+      static const U32 MAX_ENCODED_SIZE = 2 * MAX_FRAME_SIZE + 2;
+
+      //! EtherTypes shared with scripts/adapter_common.py
+      static const U16 ETHERTYPE_FPRIME = 0x999C;
+      static const U16 ETHERTYPE_HEARTBEAT = 0x999B;
+      static const U16 ETHERTYPE_TELEMETRY = 0x999D;
+
+      //! Baud rate of the SatCat5 Arty A7 UART
+      static const U32 DEFAULT_BAUD = 921600;
+
+      //! Bytes requested from the serial port per read
+      static const U32 READ_CHUNK_SIZE = 512;
+
+      //! Poll timeout of the read task, so it notices quitReadThread, milliseconds
+      static const U32 READ_POLL_MS = 100;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct SlipSerialDriver object
+      SlipSerialDriver(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy SlipSerialDriver object
+      ~SlipSerialDriver();
+
+      //! Open and configure the serial port, and pick a random locally administered MAC address
+      //! \return true if the port is ready
+      bool open(
+          const char* device, //!< Serial device, e.g. /dev/ttyUSB0
+          U32 baud = DEFAULT_BAUD, //!< Baud rate
+          bool checkSequence = true //!< Append and verify the Ethernet frame check sequence
+      );
+
+      //! Start the read task. It reports the driver ready once running.
+      void startReadThread(
+          NATIVE_UINT_TYPE priority, //!< Read task priority
+          NATIVE_UINT_TYPE stackSize //!< Read task stack size
+      );
+
+      //! Ask the read task to exit
+      void quitReadThread();
+
+      //! Wait for the read task to exit and close the port
+      Os::Task::TaskStatus join();
+
+      //! MAC address used as the source of sent frames
+      const U8* getMacAddress() const;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for tlmSend
+      Drv::SendStatus tlmSend_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& sendBuffer //!< The packet to send
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Wrap a payload in an Ethernet header and check sequence, SLIP-encode it and write it
+      //! \return 0 on success, otherwise the errno value
+      I32 writeFrame(U16 etherType, const U8* payload, U32 size);
+
+      //! Feed received bytes to the SLIP decoder
+      void decode(const U8* data, U32 size);
+
+      //! Handle one decoded frame
+      void handleFrame(const U8* frame, U32 size);
+
+      //! Ethernet CRC-32 of a byte range
+      static U32 checkSequence(const U8* data, U32 size);
+
+      //! Read task entry point
+      static void readTask(void* arg);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Serial port, or -1
+      int m_fd;
+
+      //! Whether frames carry an Ethernet check sequence
+      bool m_checkSequence;
+
+      //! Source MAC address
+      U8 m_mac[MAC_SIZE];
+
+      //! Frame being assembled for sending. Guarded by the component mutex.
+      U8 m_txFrame[MAX_FRAME_SIZE];
+
+      //! SLIP encoding of m_txFrame
+      U8 m_txEncoded[MAX_ENCODED_SIZE];
+
+      //! Frame being decoded. Owned by the read task.
+      U8 m_rxFrame[MAX_FRAME_SIZE];
+
+      //! Bytes in m_rxFrame
+      U32 m_rxSize;
+
+      //! Whether the last received byte was SLIP_ESC
+      bool m_rxEscape;
+
+      //! Whether the frame being decoded is corrupt and is skipped up to the next END
+      bool m_rxDiscard;
+
+      //! Read task
+      Os::Task m_readTask;
+
+      //! Whether the read task was started
+      bool m_readTaskStarted;
+
+      //! Guards m_quit and the receive counters
+      Os::Mutex m_lock;
+
+      //! Whether quitReadThread was called
+      bool m_quit;
+
+      //! Telemetry counters
+      U32 m_framesSent;
+      U32 m_framesReceived;
+      U32 m_heartbeatsReceived;
+      U32 m_decodeErrors;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,32 @@
+// ======================================================================
+// \title  SlipSerialDriverTestMain.cpp
+// \author cindy
+// \brief  cpp file for SlipSerialDriver component test main function
+// ======================================================================
+
+#include "SlipSerialDriverTester.hpp"
+
+TEST(Nominal, Receive) {
+  MathModule::SlipSerialDriverTester tester;
+  tester.testReceive();
+}
+
+TEST(Nominal, ReceiveFiltering) {
+  MathModule::SlipSerialDriverTester tester;
+  tester.testReceiveFiltering();
+}
+
+TEST(Nominal, Send) {
+  MathModule::SlipSerialDriverTester tester;
+  tester.testSend();
+}
+
+TEST(Nominal, Heartbeat) {
+  MathModule::SlipSerialDriverTester tester;
+  tester.testHeartbeat();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,354 @@
+// ======================================================================
+// \title  SlipSerialDriverTester.cpp
+// \author cindy
+// \brief  cpp file for SlipSerialDriver component test harness implementation class
+// ======================================================================
+
+#include "SlipSerialDriverTester.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    const U8 BROADCAST[SlipSerialDriver::MAC_SIZE] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    const U8 GROUND_MAC[SlipSerialDriver::MAC_SIZE] = {0xAE, 0x20, 0x01, 0x02, 0x03, 0x04};
+    const U8 OTHER_MAC[SlipSerialDriver::MAC_SIZE] = {0xAE, 0x20, 0x05, 0x06, 0x07, 0x08};
+
+    //! Payload exercising both SLIP escapes
+    std::vector<U8> testPayload(U32 size, U8 seed)
+    {
+      std::vector<U8> payload(size);
+      for (U32 i = 0; i < size; i++) {
+        payload[i] = static_cast<U8>(seed + i);
+      }
+      if (size > 2) {
+        payload[0] = SlipSerialDriver::SLIP_END;
+        payload[1] = SlipSerialDriver::SLIP_ESC;
+      }
+      return payload;
+    }
+
+    U16 etherTypeOf(const std::vector<U8>& frame)
+    {
+      return static_cast<U16>((frame[12] << 8) | frame[13]);
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  SlipSerialDriverTester ::
+    SlipSerialDriverTester() :
+      SlipSerialDriverGTestBase("SlipSerialDriverTester", SlipSerialDriverTester::MAX_HISTORY_SIZE),
+      component("SlipSerialDriver"),
+      m_ground(-1),
+      m_recvNext(0),
+      m_deallocated(0),
+      m_ready(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  SlipSerialDriverTester ::
+    ~SlipSerialDriverTester()
+  {
+    this->closeLink();
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void SlipSerialDriverTester ::
+    testReceive()
+  {
+    this->openLink();
+
+    const std::vector<U8> broadcast = testPayload(100, 0x10);
+    this->writeGroundFrame(BROADCAST, SlipSerialDriver::ETHERTYPE_FPRIME, broadcast, false);
+    const std::vector<U8> unicast = testPayload(SlipSerialDriver::MTU, 0x20);
+    this->writeGroundFrame(this->component.getMacAddress(), SlipSerialDriver::ETHERTYPE_FPRIME, unicast, false);
+
+    ASSERT_TRUE(this->waitForReceived(2));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_received[0], broadcast);
+    EXPECT_EQ(this->m_received[1], unicast);
+    this->m_lock.unLock();
+    EXPECT_EQ(this->m_ready, 1U);
+  }
+
+  void SlipSerialDriverTester ::
+    testReceiveFiltering()
+  {
+    this->openLink();
+
+    const std::vector<U8> name = {0x00, 0x04, 'T', 'e', 's', 't'};
+    this->writeGroundFrame(BROADCAST, SlipSerialDriver::ETHERTYPE_HEARTBEAT, name, false);
+    this->writeGroundFrame(BROADCAST, SlipSerialDriver::ETHERTYPE_FPRIME, testPayload(40, 0x30), true);
+    this->writeGroundFrame(OTHER_MAC, SlipSerialDriver::ETHERTYPE_FPRIME, testPayload(40, 0x40), false);
+    const std::vector<U8> valid = testPayload(40, 0x50);
+    this->writeGroundFrame(BROADCAST, SlipSerialDriver::ETHERTYPE_FPRIME, valid, false);
+
+    // Frames are decoded in order, so the earlier ones have been handled once the valid one arrives
+    ASSERT_TRUE(this->waitForReceived(1));
+    this->m_lock.lock();
+    ASSERT_EQ(this->m_received.size(), 1U);
+    EXPECT_EQ(this->m_received[0], valid);
+    this->m_lock.unLock();
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_FRAMES_RECEIVED_SIZE(1);
+    ASSERT_TLM_FRAMES_RECEIVED(0, 1);
+    ASSERT_TLM_HEARTBEATS_RECEIVED_SIZE(1);
+    ASSERT_TLM_HEARTBEATS_RECEIVED(0, 1);
+    ASSERT_TLM_DECODE_ERRORS_SIZE(1);
+    ASSERT_TLM_DECODE_ERRORS(0, 1);
+  }
+
+  void SlipSerialDriverTester ::
+    testSend()
+  {
+    this->openLink();
+
+    std::vector<U8> data = testPayload(SlipSerialDriver::MTU + 100, 0x60);
+    Fw::Buffer buffer(data.data(), static_cast<U32>(data.size()));
+    const Drv::SendStatus status = this->invoke_to_send(0, buffer);
+    EXPECT_EQ(status, Drv::SendStatus::SEND_OK);
+    EXPECT_EQ(this->m_deallocated, 1U);
+
+    const std::vector<std::vector<U8> > frames = this->readGroundFrames(2);
+    ASSERT_EQ(frames.size(), 2U);
+    std::vector<U8> reassembled;
+    for (const std::vector<U8>& frame : frames) {
+      ASSERT_GT(frame.size(), SlipSerialDriver::HEADER_SIZE + SlipSerialDriver::FCS_SIZE);
+      EXPECT_EQ(::memcmp(frame.data(), BROADCAST, SlipSerialDriver::MAC_SIZE), 0);
+      EXPECT_EQ(::memcmp(&frame[SlipSerialDriver::MAC_SIZE], this->component.getMacAddress(),
+                         SlipSerialDriver::MAC_SIZE), 0);
+      EXPECT_EQ(etherTypeOf(frame), SlipSerialDriver::ETHERTYPE_FPRIME);
+
+      const U32 size = static_cast<U32>(frame.size()) - SlipSerialDriver::FCS_SIZE;
+      U32 fcs = 0;
+      for (U32 i = 0; i < SlipSerialDriver::FCS_SIZE; i++) {
+        fcs |= static_cast<U32>(frame[size + i]) << (8 * i);
+      }
+      EXPECT_EQ(fcs, crc32(frame.data(), size));
+      reassembled.insert(reassembled.end(), frame.begin() + SlipSerialDriver::HEADER_SIZE, frame.begin() + size);
+    }
+    EXPECT_EQ(frames[0].size(), SlipSerialDriver::MAX_FRAME_SIZE);
+    EXPECT_EQ(reassembled, data);
+  }
+
+  void SlipSerialDriverTester ::
+    testHeartbeat()
+  {
+    this->openLink();
+
+    this->invoke_to_schedIn(0, 0);
+    const std::vector<std::vector<U8> > frames = this->readGroundFrames(1);
+    ASSERT_EQ(frames.size(), 1U);
+    const std::vector<U8>& frame = frames[0];
+    EXPECT_EQ(::memcmp(&frame[SlipSerialDriver::MAC_SIZE], this->component.getMacAddress(),
+                       SlipSerialDriver::MAC_SIZE), 0);
+    EXPECT_EQ(etherTypeOf(frame), SlipSerialDriver::ETHERTYPE_HEARTBEAT);
+
+    // Length-prefixed name, as sent by the ground adapters
+    const U32 nameSize = (static_cast<U32>(frame[14]) << 8) | frame[15];
+    EXPECT_EQ(frame.size(), SlipSerialDriver::HEADER_SIZE + sizeof(U16) + nameSize + SlipSerialDriver::FCS_SIZE);
+    EXPECT_EQ(this->component.getMacAddress()[0], 0xAE);
+
+    ASSERT_TLM_FRAMES_SENT_SIZE(1);
+    ASSERT_TLM_FRAMES_SENT(0, 1);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer SlipSerialDriverTester ::
+    from_allocate_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    this->m_lock.lock();
+    U8* storage = this->m_recvStorage[this->m_recvNext % FW_NUM_ARRAY_ELEMENTS(this->m_recvStorage)];
+    ++this->m_recvNext;
+    this->m_lock.unLock();
+    return Fw::Buffer(storage, FW_MIN(size, RECV_BUFFER_SIZE));
+  }
+
+  void SlipSerialDriverTester ::
+    from_deallocate_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_lock.lock();
+    ++this->m_deallocated;
+    this->m_lock.unLock();
+  }
+
+  void SlipSerialDriverTester ::
+    from_ready_handler(NATIVE_INT_TYPE portNum)
+  {
+    this->m_lock.lock();
+    ++this->m_ready;
+    this->m_lock.unLock();
+  }
+
+  void SlipSerialDriverTester ::
+    from_recv_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    EXPECT_EQ(recvStatus, Drv::RecvStatus::RECV_OK);
+    this->m_lock.lock();
+    this->m_received.push_back(std::vector<U8>(recvBuffer.getData(), recvBuffer.getData() + recvBuffer.getSize()));
+    this->m_lock.unLock();
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void SlipSerialDriverTester ::
+    openLink()
+  {
+    this->m_ground = ::posix_openpt(O_RDWR | O_NOCTTY);
+    ASSERT_GE(this->m_ground, 0);
+    ASSERT_EQ(::grantpt(this->m_ground), 0);
+    ASSERT_EQ(::unlockpt(this->m_ground), 0);
+    struct termios options;
+    ASSERT_EQ(::tcgetattr(this->m_ground, &options), 0);
+    ::cfmakeraw(&options);
+    ASSERT_EQ(::tcsetattr(this->m_ground, TCSANOW, &options), 0);
+
+    ASSERT_TRUE(this->component.open(::ptsname(this->m_ground)));
+    ASSERT_EVENTS_PORT_OPENED_SIZE(1);
+    this->component.startReadThread(Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+  }
+
+  void SlipSerialDriverTester ::
+    closeLink()
+  {
+    if (this->m_ground >= 0) {
+      this->component.quitReadThread();
+      (void) this->component.join();
+      (void) ::close(this->m_ground);
+      this->m_ground = -1;
+    }
+  }
+
+  void SlipSerialDriverTester ::
+    writeGroundFrame(const U8* dst, U16 etherType, const std::vector<U8>& payload, bool corruptFcs)
+  {
+    std::vector<U8> frame(dst, dst + SlipSerialDriver::MAC_SIZE);
+    frame.insert(frame.end(), GROUND_MAC, GROUND_MAC + SlipSerialDriver::MAC_SIZE);
+    frame.push_back(static_cast<U8>(etherType >> 8));
+    frame.push_back(static_cast<U8>(etherType));
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    U32 fcs = crc32(frame.data(), static_cast<U32>(frame.size()));
+    if (corruptFcs) {
+      fcs ^= 1;
+    }
+    for (U32 i = 0; i < SlipSerialDriver::FCS_SIZE; i++) {
+      frame.push_back(static_cast<U8>(fcs >> (8 * i)));
+    }
+
+    std::vector<U8> encoded(1, SlipSerialDriver::SLIP_END);
+    for (const U8 byte : frame) {
+      if (byte == SlipSerialDriver::SLIP_END) {
+        encoded.push_back(SlipSerialDriver::SLIP_ESC);
+        encoded.push_back(SlipSerialDriver::SLIP_ESC_END);
+      } else if (byte == SlipSerialDriver::SLIP_ESC) {
+        encoded.push_back(SlipSerialDriver::SLIP_ESC);
+        encoded.push_back(SlipSerialDriver::SLIP_ESC_ESC);
+      } else {
+        encoded.push_back(byte);
+      }
+    }
+    encoded.push_back(SlipSerialDriver::SLIP_END);
+    ASSERT_EQ(::write(this->m_ground, encoded.data(), encoded.size()), static_cast<ssize_t>(encoded.size()));
+  }
+
+  std::vector<std::vector<U8> > SlipSerialDriverTester ::
+    readGroundFrames(U32 count)
+  {
+    std::vector<std::vector<U8> > frames;
+    std::vector<U8> current;
+    bool escape = false;
+    while (frames.size() < count) {
+      struct pollfd pfd;
+      pfd.fd = this->m_ground;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (::poll(&pfd, 1, 2000) <= 0) {
+        break;
+      }
+      U8 chunk[256];
+      const ssize_t received = ::read(this->m_ground, chunk, sizeof(chunk));
+      if (received <= 0) {
+        break;
+      }
+      for (ssize_t i = 0; i < received; i++) {
+        const U8 byte = chunk[i];
+        if (byte == SlipSerialDriver::SLIP_END) {
+          if (!current.empty()) {
+            frames.push_back(current);
+            current.clear();
+          }
+        } else if (escape) {
+          current.push_back((byte == SlipSerialDriver::SLIP_ESC_END) ? SlipSerialDriver::SLIP_END
+                                                                     : SlipSerialDriver::SLIP_ESC);
+          escape = false;
+        } else if (byte == SlipSerialDriver::SLIP_ESC) {
+          escape = true;
+        } else {
+          current.push_back(byte);
+        }
+      }
+    }
+    return frames;
+  }
+
+  bool SlipSerialDriverTester ::
+    waitForReceived(U32 count)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool done = (this->m_received.size() >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+  U32 SlipSerialDriverTester ::
+    crc32(const U8* data, U32 size)
+  {
+    U32 crc = 0xFFFFFFFF;
+    for (U32 i = 0; i < size; i++) {
+      crc ^= data[i];
+      for (U32 bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+      }
+    }
+    return ~crc;
+  }
+
+}
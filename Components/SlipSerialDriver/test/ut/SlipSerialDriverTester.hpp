@@ -0,0 +1,162 @@
+// ======================================================================
+// \title  SlipSerialDriverTester.hpp
+// \author cindy
+// \brief  hpp file for SlipSerialDriver component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_SlipSerialDriverTester_HPP
+#define MathModule_SlipSerialDriverTester_HPP
+
+#include "SlipSerialDriverGTestBase.hpp"
+#include "Components/SlipSerialDriver/SlipSerialDriver.hpp"
+#include <Os/Mutex.hpp>
+
+#include <vector>
+
+namespace MathModule {
+
+  class SlipSerialDriverTester :
+    public SlipSerialDriverGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      // Size of the test receive buffers
+      static const U32 RECV_BUFFER_SIZE = 2048;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object SlipSerialDriverTester
+      SlipSerialDriverTester();
+
+      //! Destroy object SlipSerialDriverTester
+      ~SlipSerialDriverTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! F´ frames from the ground are forwarded without their Ethernet header
+      void testReceive();
+
+      //! Heartbeats, corrupt frames and frames for other stations are not forwarded
+      void testReceiveFiltering();
+
+      //! Sends longer than the MTU are split into consecutive Ethernet frames
+      void testSend();
+
+      //! The heartbeat carries the heartbeat EtherType and the driver's MAC address
+      void testHeartbeat();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for allocate
+      Fw::Buffer from_allocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for deallocate
+      void from_deallocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for ready
+      void from_ready_handler(
+          NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for recv
+      void from_recv_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Open a pseudo-terminal pair and start the driver on its subordinate end
+      void openLink();
+
+      //! Stop the driver and close the pair
+      void closeLink();
+
+      //! Write an Ethernet frame, SLIP-encoded, from the ground end
+      void writeGroundFrame(const U8* dst, U16 etherType, const std::vector<U8>& payload, bool corruptFcs);
+
+      //! Read and SLIP-decode frames arriving at the ground end until the count is reached or a timeout
+      std::vector<std::vector<U8> > readGroundFrames(U32 count);
+
+      //! Wait until the driver has forwarded the given number of buffers
+      bool waitForReceived(U32 count);
+
+      //! Ethernet CRC-32, computed bit by bit as an independent reference
+      static U32 crc32(const U8* data, U32 size);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      SlipSerialDriver component;
+
+      //! Ground end of the pseudo-terminal pair
+      int m_ground;
+
+      //! Guards the buffers collected from the driver's read task
+      Os::Mutex m_lock;
+
+      //! Payloads forwarded by the driver
+      std::vector<std::vector<U8> > m_received;
+
+      //! Buffers handed out to the driver
+      U8 m_recvStorage[4][RECV_BUFFER_SIZE];
+      U32 m_recvNext;
+
+      //! Buffers returned through the deallocate port
+      U32 m_deallocated;
+
+      //! Ready notifications
+      U32 m_ready;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+// ======================================================================
+// \title  StartupProfiler.cpp
+// \author cindy
+// \brief  cpp file for StartupProfiler component implementation class
+// ======================================================================
+
+#include "Components/StartupProfiler/StartupProfiler.hpp"
+#include <Fw/Types/Assert.hpp>
+#include <time.h>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  StartupProfiler ::
+    StartupProfiler(const char* const compName) :
+      StartupProfilerComponentBase(compName),
+      m_startupBegin(0),
+      m_started(false)
+  {
+    for (U32 i = 0; i < StartupPhase::NUM_CONSTANTS; ++i) {
+      this->m_phaseBegin[i] = 0;
+      this->m_phaseUsec[i] = 0;
+    }
+  }
+
+  StartupProfiler ::
+    ~StartupProfiler()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Phase recording
+  // ----------------------------------------------------------------------
+
+  /*
+    CLOCK_MONOTONIC is used rather than the component time port: chronoTime is
+    not connected until connectComponents has run, and wall-clock steps during
+    boot (e.g. NTP) would corrupt the measurements.
+  */
+  U64 StartupProfiler ::
+    nowUsec()
+  {
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<U64>(now.tv_sec) * 1000000U + static_cast<U64>(now.tv_nsec) / 1000U;
+  }
+
+  void StartupProfiler ::
+    beginPhase(const StartupPhase& phase)
+  {
+    FW_ASSERT(phase.isValid(), phase.e);
+    const U64 now = nowUsec();
+    if (!this->m_started) {
+      this->m_startupBegin = now;
+      this->m_started = true;
+    }
+    this->m_phaseBegin[phase.e] = now;
+  }
+
+  void StartupProfiler ::
+    endPhase(const StartupPhase& phase)
+  {
+    FW_ASSERT(phase.isValid(), phase.e);
+    const U64 elapsed = nowUsec() - this->m_phaseBegin[phase.e];
+    this->m_phaseUsec[phase.e] = static_cast<U32>(FW_MIN(elapsed, static_cast<U64>(0xFFFFFFFF)));
+  }
+
+  void StartupProfiler ::
+    report()
+  {
+    for (U32 i = 0; i < StartupPhase::NUM_CONSTANTS; ++i) {
+      this->log_ACTIVITY_LO_PHASE_TIME(static_cast<StartupPhase::T>(i), this->m_phaseUsec[i]);
+    }
+    const U64 total = this->m_started ? nowUsec() - this->m_startupBegin : 0;
+    const U32 totalUsec = static_cast<U32>(FW_MIN(total, static_cast<U64>(0xFFFFFFFF)));
+    this->log_ACTIVITY_HI_STARTUP_COMPLETE(totalUsec);
+    this->tlmWrite_STARTUP_TIME(totalUsec);
+    this->tlmWrite_CONFIGURE_TIME(this->m_phaseUsec[StartupPhase::CONFIGURE_TOPOLOGY]);
+  }
+
+}
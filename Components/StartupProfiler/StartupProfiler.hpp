@@ -0,0 +1,81 @@
+// ======================================================================
+// \title  StartupProfiler.hpp
+// \author cindy
+// \brief  hpp file for StartupProfiler component implementation class
+// ======================================================================
+
+#ifndef MathModule_StartupProfiler_HPP
+#define MathModule_StartupProfiler_HPP
+
+#include "Components/StartupProfiler/StartupProfilerComponentAc.hpp"
+
+namespace MathModule {
+
+  class StartupProfiler :
+    public StartupProfilerComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct StartupProfiler object
+      StartupProfiler(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy StartupProfiler object
+      ~StartupProfiler();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Phase recording
+      // ----------------------------------------------------------------------
+
+      //! Mark the start of a startup phase
+      //!
+      //! Only touches member data, so it is safe to call before init() and
+      //! before the event logger is running.
+      void beginPhase(
+          const StartupPhase& phase //!< The phase being started
+      );
+
+      //! Mark the end of the phase started by the matching beginPhase
+      void endPhase(
+          const StartupPhase& phase //!< The phase being ended
+      );
+
+      //! Emit the recorded phase timings as events and telemetry
+      //!
+      //! Call once the event logger and telemetry tasks are running.
+      void report();
+
+      //! Read the monotonic clock in microseconds
+      static U64 nowUsec();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Monotonic time of the first beginPhase call
+      U64 m_startupBegin;
+
+      //! Monotonic start time of each phase
+      U64 m_phaseBegin[StartupPhase::NUM_CONSTANTS];
+
+      //! Duration of each phase, microseconds
+      U32 m_phaseUsec[StartupPhase::NUM_CONSTANTS];
+
+      //! Whether any phase has been started
+      bool m_started;
+
+  };
+
+}
+
+#endif
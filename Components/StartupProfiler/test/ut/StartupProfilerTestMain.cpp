@@ -0,0 +1,32 @@
+// ======================================================================
+// \title  StartupProfilerTestMain.cpp
+// \author cindy
+// \brief  cpp file for StartupProfiler component test main function
+// ======================================================================
+
+#include "StartupProfilerTester.hpp"
+
+TEST(Nominal, Phases) {
+  MathModule::StartupProfilerTester tester;
+  tester.testPhases();
+}
+
+TEST(Nominal, Nested) {
+  MathModule::StartupProfilerTester tester;
+  tester.testNested();
+}
+
+TEST(Nominal, Overlapping) {
+  MathModule::StartupProfilerTester tester;
+  tester.testOverlapping();
+}
+
+TEST(OffNominal, NoPhases) {
+  MathModule::StartupProfilerTester tester;
+  tester.testNoPhases();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  StartupProfilerTester.cpp
+// \author cindy
+// \brief  cpp file for StartupProfiler component test harness implementation class
+// ======================================================================
+
+#include "StartupProfilerTester.hpp"
+
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace MathModule {
+
+  const U32 StartupProfilerTester::PHASE_USEC;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  StartupProfilerTester ::
+    StartupProfilerTester() :
+      StartupProfilerGTestBase("StartupProfilerTester", StartupProfilerTester::MAX_HISTORY_SIZE),
+      component("StartupProfiler")
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  StartupProfilerTester ::
+    ~StartupProfilerTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void StartupProfilerTester ::
+    testPhases()
+  {
+    const U64 begin = StartupProfiler::nowUsec();
+    this->timePhase(StartupPhase::INIT_COMPONENTS, PHASE_USEC);
+    this->timePhase(StartupPhase::CONFIGURE_TOPOLOGY, 2 * PHASE_USEC);
+    this->component.report();
+    const U64 elapsed = StartupProfiler::nowUsec() - begin;
+
+    // Every phase is reported in order, the ones never timed as zero
+    ASSERT_EVENTS_PHASE_TIME_SIZE(StartupPhase::NUM_CONSTANTS);
+    for (U32 i = 0; i < StartupPhase::NUM_CONSTANTS; i++) {
+      EXPECT_EQ(this->eventHistory_PHASE_TIME->at(i).phase, static_cast<StartupPhase::T>(i));
+    }
+    const U32 init = this->reportedUsec(StartupPhase::INIT_COMPONENTS);
+    const U32 configure = this->reportedUsec(StartupPhase::CONFIGURE_TOPOLOGY);
+    EXPECT_GE(init, PHASE_USEC);
+    EXPECT_GE(configure, 2 * PHASE_USEC);
+    EXPECT_EQ(this->reportedUsec(StartupPhase::SET_BASE_IDS), 0U);
+    EXPECT_EQ(this->reportedUsec(StartupPhase::START_TASKS), 0U);
+
+    // The total runs from the first begin to the report
+    ASSERT_EVENTS_STARTUP_COMPLETE_SIZE(1);
+    const U32 total = this->eventHistory_STARTUP_COMPLETE->at(0).usec;
+    EXPECT_GE(total, init + configure);
+    EXPECT_LE(total, elapsed);
+    ASSERT_TLM_STARTUP_TIME_SIZE(1);
+    ASSERT_TLM_STARTUP_TIME(0, total);
+    ASSERT_TLM_CONFIGURE_TIME_SIZE(1);
+    ASSERT_TLM_CONFIGURE_TIME(0, configure);
+  }
+
+  void StartupProfilerTester ::
+    testNested()
+  {
+    this->component.beginPhase(StartupPhase::CONFIGURE_TOPOLOGY);
+    (void) ::usleep(PHASE_USEC);
+    this->timePhase(StartupPhase::CONFIG_COMPONENTS, PHASE_USEC);
+    (void) ::usleep(PHASE_USEC);
+    this->component.endPhase(StartupPhase::CONFIGURE_TOPOLOGY);
+    this->component.report();
+
+    const U32 inner = this->reportedUsec(StartupPhase::CONFIG_COMPONENTS);
+    const U32 outer = this->reportedUsec(StartupPhase::CONFIGURE_TOPOLOGY);
+    EXPECT_GE(inner, PHASE_USEC);
+    EXPECT_GE(outer, inner + 2 * PHASE_USEC);
+    ASSERT_TLM_CONFIGURE_TIME(0, outer);
+  }
+
+  void StartupProfilerTester ::
+    testOverlapping()
+  {
+    // setupTopology has begun a phase before configureTopology starts its tasks
+    this->component.beginPhase(StartupPhase::CONFIGURE_TOPOLOGY);
+    const StartupPhase::T phases[] = {
+      StartupPhase::CONFIG_COMPONENTS,
+      StartupPhase::REG_COMMANDS,
+      StartupPhase::LOAD_PARAMETERS,
+      StartupPhase::START_TASKS
+    };
+    const U64 begin = StartupProfiler::nowUsec();
+    std::vector<std::thread> tasks;
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(phases); i++) {
+      tasks.emplace_back([this, &phases, i]() {
+        this->timePhase(phases[i], (i + 1) * PHASE_USEC);
+      });
+    }
+    for (std::thread& task : tasks) {
+      task.join();
+    }
+    const U64 elapsed = StartupProfiler::nowUsec() - begin;
+    this->component.endPhase(StartupPhase::CONFIGURE_TOPOLOGY);
+    this->component.report();
+
+    // Each phase keeps its own time, and together they took longer than the tasks ran
+    U64 sum = 0;
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(phases); i++) {
+      const U32 usec = this->reportedUsec(phases[i]);
+      EXPECT_GE(usec, (i + 1) * PHASE_USEC) << i;
+      EXPECT_LE(usec, elapsed) << i;
+      sum += usec;
+    }
+    EXPECT_GT(sum, elapsed);
+    EXPECT_GE(this->reportedUsec(StartupPhase::CONFIGURE_TOPOLOGY), elapsed);
+  }
+
+  void StartupProfilerTester ::
+    testNoPhases()
+  {
+    this->component.report();
+    ASSERT_EVENTS_PHASE_TIME_SIZE(StartupPhase::NUM_CONSTANTS);
+    for (U32 i = 0; i < StartupPhase::NUM_CONSTANTS; i++) {
+      EXPECT_EQ(this->eventHistory_PHASE_TIME->at(i).usec, 0U);
+    }
+    ASSERT_EVENTS_STARTUP_COMPLETE_SIZE(1);
+    ASSERT_EVENTS_STARTUP_COMPLETE(0, 0);
+    ASSERT_TLM_STARTUP_TIME(0, 0);
+    ASSERT_TLM_CONFIGURE_TIME(0, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void StartupProfilerTester ::
+    timePhase(StartupPhase::T phase, U32 usec)
+  {
+    this->component.beginPhase(phase);
+    (void) ::usleep(usec);
+    this->component.endPhase(phase);
+  }
+
+  U32 StartupProfilerTester ::
+    reportedUsec(StartupPhase::T phase)
+  {
+    const U32 index = static_cast<U32>(phase);
+    EXPECT_LT(index, this->eventHistory_PHASE_TIME->size());
+    return (index < this->eventHistory_PHASE_TIME->size()) ? this->eventHistory_PHASE_TIME->at(index).usec : 0;
+  }
+
+}
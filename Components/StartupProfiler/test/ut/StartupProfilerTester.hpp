@@ -0,0 +1,98 @@
+// ======================================================================
+// \title  StartupProfilerTester.hpp
+// \author cindy
+// \brief  hpp file for StartupProfiler component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_StartupProfilerTester_HPP
+#define MathModule_StartupProfilerTester_HPP
+
+#include "StartupProfilerGTestBase.hpp"
+#include "Components/StartupProfiler/StartupProfiler.hpp"
+
+namespace MathModule {
+
+  class StartupProfilerTester :
+    public StartupProfilerGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Time each timed phase sleeps, microseconds
+      static const U32 PHASE_USEC = 2000;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object StartupProfilerTester
+      StartupProfilerTester();
+
+      //! Destroy object StartupProfilerTester
+      ~StartupProfilerTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Each phase is timed from its begin to its end and reported in order
+      void testPhases();
+
+      //! A phase begun inside another is timed apart from the one around it
+      void testNested();
+
+      //! Phases timed from several tasks at once keep their own times
+      void testOverlapping();
+
+      //! A report with no phase timed reports zero everywhere
+      void testNoPhases();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Time one phase that sleeps for usec
+      void timePhase(StartupPhase::T phase, U32 usec);
+
+      //! Time reported for phase by the last report
+      U32 reportedUsec(StartupPhase::T phase);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      StartupProfiler component;
+
+  };
+
+}
+
+#endif
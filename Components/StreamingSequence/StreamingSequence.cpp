@@ -0,0 +1,497 @@
+// ======================================================================
+// \title  StreamingSequence.cpp
+// \author cindy
+// \brief  cpp file for the streaming F´ command sequence format
+// ======================================================================
+
+#include "Components/StreamingSequence/StreamingSequence.hpp"
+#include "Components/Crc32Framing/Crc32.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    U32 readU32(const U8* src) {
+      return (static_cast<U32>(src[0]) << 24) | (static_cast<U32>(src[1]) << 16) |
+             (static_cast<U32>(src[2]) << 8) | static_cast<U32>(src[3]);
+    }
+
+  }
+
+  const U32 StreamingSequence::HEADER_SIZE;
+  const U32 StreamingSequence::RECORD_HEADER_SIZE;
+  const U32 StreamingSequence::MAX_RECORD_SIZE;
+  const U32 StreamingSequence::CRC_SIZE;
+  const U32 StreamingSequence::NUM_CHUNKS;
+  const U32 StreamingSequence::MIN_CHUNK_SIZE;
+  const U32 StreamingSequence::MIN_BUFFER_SIZE;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  StreamingSequence ::
+    StreamingSequence(Svc::CmdSequencerComponentImpl& component) :
+      Sequence(component),
+      m_readerRunning(false),
+      m_fd(-1),
+      m_chunkSize(0),
+      m_recordsEnd(0),
+      m_nextOffset(0),
+      m_pending(0),
+      m_chunk(0),
+      m_cursor(nullptr),
+      m_end(nullptr),
+      m_streaming(false),
+      m_readFailed(false),
+      m_computeCrc(false),
+      m_crc(Crc32::INITIAL),
+      m_recordsRead(0),
+      m_loaded(false)
+  {
+
+  }
+
+  StreamingSequence ::
+    ~StreamingSequence()
+  {
+
+  }
+
+  void StreamingSequence ::
+    startReader()
+  {
+    if (this->m_readerRunning) {
+      return;
+    }
+    // One request per chunk and the quit message
+    Os::QueueString requestName("SeqReadReq");
+    Os::Queue::QueueStatus qStat =
+      this->m_requestQueue.create(requestName, NUM_CHUNKS + 1, sizeof(ReadRequest));
+    FW_ASSERT(qStat == Os::Queue::QUEUE_OK, qStat);
+    Os::QueueString resultName("SeqReadRes");
+    qStat = this->m_resultQueue.create(resultName, NUM_CHUNKS, sizeof(ReadResult));
+    FW_ASSERT(qStat == Os::Queue::QUEUE_OK, qStat);
+
+    Os::TaskString taskName("SeqRead");
+    const Os::Task::TaskStatus tStat = this->m_readerTask.start(taskName, StreamingSequence::readerTask, this);
+    FW_ASSERT(tStat == Os::Task::TASK_OK, tStat);
+    this->m_readerRunning = true;
+  }
+
+  void StreamingSequence ::
+    stopReader()
+  {
+    if (!this->m_readerRunning) {
+      return;
+    }
+    this->clear();
+    ReadRequest quit;
+    memset(&quit, 0, sizeof(quit));
+    quit.chunk = NUM_CHUNKS;
+    (void) this->m_requestQueue.send(reinterpret_cast<const U8*>(&quit), sizeof(quit), 0,
+                                     Os::Queue::QUEUE_BLOCKING);
+    (void) this->m_readerTask.join(nullptr);
+    this->m_readerRunning = false;
+  }
+
+  // ----------------------------------------------------------------------
+  // Sequence interface
+  // ----------------------------------------------------------------------
+
+  /*
+    loadFile makes the checks of FPrimeSequence (file size, CRC, time base and
+    context, record framing and count) without holding the file: the records
+    are streamed through the chunks once, extending the CRC as each chunk
+    arrives. Records are then streamed again as the sequence runs, so a
+    sequence costs two sequential reads of the file and no memory beyond the
+    sequence buffer. The stream is restarted before returning so the first
+    command does not wait on the disk.
+  */
+  bool StreamingSequence ::
+    loadFile(const Fw::StringBase& fileName)
+  {
+    FW_ASSERT(this->m_readerRunning);
+    this->clear();
+    this->setFileName(fileName);
+
+    const U32 capacity = static_cast<U32>(this->m_buffer.getBuffCapacity());
+    if (capacity < MIN_BUFFER_SIZE) {
+      this->m_events.fileSizeError(capacity);
+      return false;
+    }
+    this->m_chunkSize = capacity / NUM_CHUNKS - MAX_RECORD_SIZE;
+
+    this->m_fd = ::open(fileName.toChar(), O_RDONLY | O_CLOEXEC);
+    if (this->m_fd < 0) {
+      this->m_events.fileNotFound();
+      return false;
+    }
+    (void) ::posix_fadvise(this->m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    if (!this->readHeader()) {
+      this->closeFile();
+      return false;
+    }
+
+    this->m_computeCrc = true;
+    bool ok = this->startStream();
+    U32 records = 0;
+    Fw::SerializeStatus status = Fw::FW_SERIALIZE_OK;
+    Record scratch;
+    while (ok && (records < this->m_header.m_numRecords)) {
+      status = this->readRecord(scratch);
+      if (status != Fw::FW_SERIALIZE_OK) {
+        break;
+      }
+      ++records;
+    }
+    // Bytes after the last record, or after an invalid one, still count toward the CRC
+    U32 extraBytes = 0;
+    while (ok) {
+      extraBytes += static_cast<U32>(this->m_end - this->m_cursor);
+      this->m_cursor = this->m_end;
+      ok = this->advance();
+    }
+    this->m_computeCrc = false;
+    this->drain();
+
+    U8 stored[CRC_SIZE];
+    if (this->m_readFailed ||
+        (::pread(this->m_fd, stored, CRC_SIZE, this->m_recordsEnd) != static_cast<ssize_t>(CRC_SIZE))) {
+      this->m_events.fileReadError();
+      this->closeFile();
+      return false;
+    }
+    const U32 storedCrc = readU32(stored);
+    if (storedCrc != this->m_crc) {
+      this->m_events.fileCRCFailure(storedCrc, this->m_crc);
+      this->closeFile();
+      return false;
+    }
+    if (!this->m_header.validateTime(this->m_component)) {
+      this->closeFile();
+      return false;
+    }
+    if (status != Fw::FW_SERIALIZE_OK) {
+      this->m_events.recordInvalid(records, status);
+      this->closeFile();
+      return false;
+    }
+    if (extraBytes != 0) {
+      this->m_events.recordMismatch(this->m_header.m_numRecords, extraBytes);
+      this->closeFile();
+      return false;
+    }
+
+    this->m_loaded = true;
+    if (!this->startStream()) {
+      this->m_events.fileReadError();
+      this->clear();
+      return false;
+    }
+    return true;
+  }
+
+  bool StreamingSequence ::
+    hasMoreRecords() const
+  {
+    return this->m_loaded && (this->m_recordsRead < this->m_header.m_numRecords);
+  }
+
+  /*
+    Records were validated by loadFile, so a record that cannot be read here
+    means the file could not be read or changed underneath the sequence. That
+    is reported as a read error and the sequence ends at the record, rather
+    than asserting as FPrimeSequence does for a buffer it holds itself.
+  */
+  void StreamingSequence ::
+    nextRecord(Record& record)
+  {
+    FW_ASSERT(this->hasMoreRecords());
+    Fw::SerializeStatus status = Fw::FW_DESERIALIZE_BUFFER_EMPTY;
+    if (this->m_streaming || this->startStream()) {
+      status = this->readRecord(record);
+    }
+    if (status != Fw::FW_SERIALIZE_OK) {
+      this->m_events.fileReadError();
+      record.m_descriptor = Record::END;
+      this->m_recordsRead = this->m_header.m_numRecords;
+      return;
+    }
+    ++this->m_recordsRead;
+  }
+
+  void StreamingSequence ::
+    reset()
+  {
+    // The stream restarts from the first record on the next nextRecord
+    this->drain();
+    this->m_recordsRead = 0;
+  }
+
+  void StreamingSequence ::
+    clear()
+  {
+    this->closeFile();
+    this->m_loaded = false;
+    this->m_recordsRead = 0;
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  U8* StreamingSequence ::
+    chunkData(U32 chunk)
+  {
+    FW_ASSERT(chunk < NUM_CHUNKS, chunk);
+    return this->m_buffer.getBuffAddr() + chunk * (MAX_RECORD_SIZE + this->m_chunkSize) + MAX_RECORD_SIZE;
+  }
+
+  bool StreamingSequence ::
+    readHeader()
+  {
+    struct stat info;
+    if (::fstat(this->m_fd, &info) != 0) {
+      this->m_events.fileReadError();
+      return false;
+    }
+    if ((info.st_size < static_cast<off_t>(HEADER_SIZE + CRC_SIZE)) ||
+        (info.st_size > static_cast<off_t>(0xFFFFFFFFU))) {
+      this->m_events.fileSizeError(static_cast<U32>(FW_MIN(info.st_size, static_cast<off_t>(0xFFFFFFFFU))));
+      return false;
+    }
+
+    U8 header[HEADER_SIZE];
+    if (::pread(this->m_fd, header, HEADER_SIZE, 0) != static_cast<ssize_t>(HEADER_SIZE)) {
+      this->m_events.fileReadError();
+      return false;
+    }
+    Fw::ExternalSerializeBuffer buffer(header, HEADER_SIZE);
+    Fw::SerializeStatus status = buffer.setBuffLen(HEADER_SIZE);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    FwTimeBaseStoreType timeBase = 0;
+    status = buffer.deserialize(this->m_header.m_fileSize);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = buffer.deserialize(this->m_header.m_numRecords);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = buffer.deserialize(timeBase);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = buffer.deserialize(this->m_header.m_timeContext);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    this->m_header.m_timeBase = static_cast<TimeBase>(timeBase);
+
+    // The size field covers the records and the CRC
+    if ((this->m_header.m_fileSize < CRC_SIZE) ||
+        (static_cast<off_t>(HEADER_SIZE) + this->m_header.m_fileSize != info.st_size)) {
+      this->m_events.fileSizeError(this->m_header.m_fileSize);
+      return false;
+    }
+    this->m_recordsEnd = HEADER_SIZE + this->m_header.m_fileSize - CRC_SIZE;
+    this->m_crc = Crc32::update(Crc32::INITIAL, header, HEADER_SIZE);
+    return true;
+  }
+
+  /*
+    Only the first chunk is requested here. advance() requests the chunk it
+    leaves as soon as it moves to the next, so from the first chunk on the
+    reader task is always one chunk ahead of the sequencer.
+  */
+  bool StreamingSequence ::
+    startStream()
+  {
+    this->drain();
+    this->m_nextOffset = HEADER_SIZE;
+    this->m_readFailed = false;
+    this->m_recordsRead = 0;
+    this->m_chunk = NUM_CHUNKS - 1;
+    this->m_cursor = this->chunkData(this->m_chunk);
+    this->m_end = this->m_cursor;
+    this->requestChunk(0);
+    this->m_streaming = true;
+    // An empty sequence has no chunk to wait for
+    return this->advance() || !this->m_readFailed;
+  }
+
+  void StreamingSequence ::
+    drain()
+  {
+    while (this->m_pending > 0) {
+      ReadResult result;
+      NATIVE_INT_TYPE size = 0;
+      NATIVE_INT_TYPE priority = 0;
+      const Os::Queue::QueueStatus status = this->m_resultQueue.receive(
+        reinterpret_cast<U8*>(&result), sizeof(result), size, priority, Os::Queue::QUEUE_BLOCKING);
+      FW_ASSERT(status == Os::Queue::QUEUE_OK, status);
+      --this->m_pending;
+    }
+    this->m_streaming = false;
+  }
+
+  bool StreamingSequence ::
+    ensure(U32 size)
+  {
+    FW_ASSERT(size <= MAX_RECORD_SIZE, size);
+    while (static_cast<U32>(this->m_end - this->m_cursor) < size) {
+      if (!this->advance()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool StreamingSequence ::
+    advance()
+  {
+    if (this->m_pending == 0) {
+      return false;
+    }
+    ReadResult result;
+    NATIVE_INT_TYPE size = 0;
+    NATIVE_INT_TYPE priority = 0;
+    const Os::Queue::QueueStatus status = this->m_resultQueue.receive(
+      reinterpret_cast<U8*>(&result), sizeof(result), size, priority, Os::Queue::QUEUE_BLOCKING);
+    FW_ASSERT(status == Os::Queue::QUEUE_OK, status);
+    --this->m_pending;
+
+    const U32 next = (this->m_chunk + 1) % NUM_CHUNKS;
+    FW_ASSERT(result.chunk == next, result.chunk, next);
+    if (result.status < 0) {
+      this->m_readFailed = true;
+      return false;
+    }
+    U8* const data = this->chunkData(next);
+    if (this->m_computeCrc) {
+      this->m_crc = Crc32::update(this->m_crc, data, static_cast<U32>(result.status));
+    }
+
+    // A record split across chunks is made contiguous in the space before the next chunk's data
+    const U32 tail = static_cast<U32>(this->m_end - this->m_cursor);
+    FW_ASSERT(tail <= MAX_RECORD_SIZE, tail);
+    memcpy(data - tail, this->m_cursor, tail);
+
+    const U32 previous = this->m_chunk;
+    this->m_chunk = next;
+    this->m_cursor = data - tail;
+    this->m_end = data + result.status;
+    this->requestChunk(previous);
+    return true;
+  }
+
+  void StreamingSequence ::
+    requestChunk(U32 chunk)
+  {
+    if (this->m_nextOffset >= this->m_recordsEnd) {
+      return;
+    }
+    ReadRequest request;
+    request.chunk = chunk;
+    request.offset = this->m_nextOffset;
+    request.size = FW_MIN(this->m_chunkSize, this->m_recordsEnd - this->m_nextOffset);
+    const Os::Queue::QueueStatus status = this->m_requestQueue.send(
+      reinterpret_cast<const U8*>(&request), sizeof(request), 0, Os::Queue::QUEUE_BLOCKING);
+    FW_ASSERT(status == Os::Queue::QUEUE_OK, status);
+    this->m_nextOffset += request.size;
+    ++this->m_pending;
+  }
+
+  Fw::SerializeStatus StreamingSequence ::
+    readRecord(Record& record)
+  {
+    if (!this->ensure(sizeof(U8))) {
+      return Fw::FW_DESERIALIZE_BUFFER_EMPTY;
+    }
+    const U8 descriptor = this->m_cursor[0];
+    if (descriptor > Record::END) {
+      return Fw::FW_DESERIALIZE_FORMAT_ERROR;
+    }
+    record.m_descriptor = static_cast<Record::Descriptor>(descriptor);
+    if (record.m_descriptor == Record::END) {
+      // As in FPrimeSequence, an end record is only its descriptor
+      this->m_cursor += sizeof(U8);
+      return Fw::FW_SERIALIZE_OK;
+    }
+
+    if (!this->ensure(RECORD_HEADER_SIZE)) {
+      return Fw::FW_DESERIALIZE_BUFFER_EMPTY;
+    }
+    const U32 seconds = readU32(this->m_cursor + sizeof(U8));
+    const U32 useconds = readU32(this->m_cursor + sizeof(U8) + sizeof(U32));
+    const U32 commandSize = readU32(this->m_cursor + sizeof(U8) + 2 * sizeof(U32));
+    if ((commandSize > FW_COM_BUFFER_MAX_SIZE) || !this->ensure(RECORD_HEADER_SIZE + commandSize)) {
+      return Fw::FW_DESERIALIZE_SIZE_MISMATCH;
+    }
+    record.m_timeTag.set(seconds, useconds);
+    record.m_command.resetSer();
+    const Fw::SerializeStatus status =
+      record.m_command.serialize(this->m_cursor + RECORD_HEADER_SIZE, commandSize, true);
+    if (status != Fw::FW_SERIALIZE_OK) {
+      return status;
+    }
+    this->m_cursor += RECORD_HEADER_SIZE + commandSize;
+    return Fw::FW_SERIALIZE_OK;
+  }
+
+  void StreamingSequence ::
+    closeFile()
+  {
+    this->drain();
+    if (this->m_fd >= 0) {
+      (void) ::close(this->m_fd);
+      this->m_fd = -1;
+    }
+  }
+
+  void StreamingSequence ::
+    readerTask(void* arg)
+  {
+    StreamingSequence* sequence = static_cast<StreamingSequence*>(arg);
+    FW_ASSERT(sequence != nullptr);
+
+    while (true) {
+      ReadRequest request;
+      NATIVE_INT_TYPE size = 0;
+      NATIVE_INT_TYPE priority = 0;
+      const Os::Queue::QueueStatus status = sequence->m_requestQueue.receive(
+        reinterpret_cast<U8*>(&request), sizeof(request), size, priority, Os::Queue::QUEUE_BLOCKING);
+      if ((status != Os::Queue::QUEUE_OK) || (request.chunk >= NUM_CHUNKS)) {
+        break;
+      }
+
+      U8* const data = sequence->chunkData(request.chunk);
+      U32 done = 0;
+      I32 error = 0;
+      while (done < request.size) {
+        const ssize_t got = ::pread(sequence->m_fd, data + done, request.size - done, request.offset + done);
+        if (got < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          error = errno;
+          break;
+        }
+        if (got == 0) {
+          // The file shrank since its size was checked
+          error = EIO;
+          break;
+        }
+        done += static_cast<U32>(got);
+      }
+
+      ReadResult result;
+      result.chunk = request.chunk;
+      result.status = (error != 0) ? -error : static_cast<I32>(done);
+      const Os::Queue::QueueStatus sent = sequence->m_resultQueue.send(
+        reinterpret_cast<const U8*>(&result), sizeof(result), 0, Os::Queue::QUEUE_BLOCKING);
+      FW_ASSERT(sent == Os::Queue::QUEUE_OK, sent);
+    }
+  }
+
+}
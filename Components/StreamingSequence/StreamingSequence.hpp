@@ -0,0 +1,223 @@
+// ======================================================================
+// \title  StreamingSequence.hpp
+// \author cindy
+// \brief  hpp file for the streaming F´ command sequence format
+//
+// Reads F´ binary sequence files (the format of
+// Svc::CmdSequencerComponentImpl::FPrimeSequence) through two fixed-size
+// chunks filled ahead of the sequencer by a reader task, so the memory
+// used does not depend on the length of the sequence.
+// ======================================================================
+
+#ifndef MathModule_StreamingSequence_HPP
+#define MathModule_StreamingSequence_HPP
+
+#include <Svc/CmdSequencer/CmdSequencerImpl.hpp>
+#include <Os/Queue.hpp>
+#include <Os/Task.hpp>
+
+namespace MathModule {
+
+  class StreamingSequence :
+    public Svc::CmdSequencerComponentImpl::Sequence
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Serialized size of the file header: file size, record count, time base, time context
+      static const U32 HEADER_SIZE =
+        sizeof(U32) + sizeof(U32) + sizeof(FwTimeBaseStoreType) + sizeof(FwTimeContextStoreType);
+
+      //! Serialized size of a record up to its command: descriptor, seconds, microseconds, command size
+      static const U32 RECORD_HEADER_SIZE = sizeof(U8) + sizeof(U32) + sizeof(U32) + sizeof(U32);
+
+      //! Largest serialized record
+      static const U32 MAX_RECORD_SIZE = RECORD_HEADER_SIZE + FW_COM_BUFFER_MAX_SIZE;
+
+      //! Size of the file CRC
+      static const U32 CRC_SIZE = sizeof(U32);
+
+      //! Number of chunks; the sequencer reads one while the reader task fills the other
+      static const U32 NUM_CHUNKS = 2;
+
+      //! Smallest chunk the sequence buffer must leave room for
+      static const U32 MIN_CHUNK_SIZE = 512;
+
+      //! Smallest buffer to pass to allocateBuffer
+      static const U32 MIN_BUFFER_SIZE = NUM_CHUNKS * (MAX_RECORD_SIZE + MIN_CHUNK_SIZE);
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct StreamingSequence object
+      StreamingSequence(
+          Svc::CmdSequencerComponentImpl& component //!< The sequencer using this format
+      );
+
+      //! Destroy StreamingSequence object
+      ~StreamingSequence();
+
+      //! Start the read-ahead task. Call before the sequencer runs a sequence.
+      void startReader();
+
+      //! Close the sequence file, then stop and join the read-ahead task. Call during teardown.
+      void stopReader();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Sequence interface
+      // ----------------------------------------------------------------------
+
+      //! Open a sequence file and validate it in one streaming pass
+      //! \return true if the sequence is valid and ready to run
+      bool loadFile(
+          const Fw::StringBase& fileName //!< The file name
+      ) override;
+
+      //! Whether records remain to be run
+      bool hasMoreRecords() const override;
+
+      //! Read the next record, waiting for its chunk if the reader is behind
+      void nextRecord(
+          Record& record //!< The record
+      ) override;
+
+      //! Rewind to the first record
+      void reset() override;
+
+      //! Close the sequence file; no records remain
+      void clear() override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Message to the reader task
+      struct ReadRequest {
+        U32 chunk; //!< Chunk to fill, or NUM_CHUNKS to quit
+        U32 offset; //!< File offset to read from
+        U32 size; //!< Bytes to read
+      };
+
+      //! Message back from the reader task
+      struct ReadResult {
+        U32 chunk; //!< Chunk filled
+        I32 status; //!< Bytes read, or the negated errno value
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Start of a chunk's data; MAX_RECORD_SIZE bytes before it are free for a record split across chunks
+      U8* chunkData(U32 chunk);
+
+      //! Read the file header and check it against the file size
+      //! \return true if the header is valid
+      bool readHeader();
+
+      //! Request both chunks from the first record on and wait for the first
+      //! \return true if the first chunk was read
+      bool startStream();
+
+      //! Wait for every outstanding read so the chunks and the file may be reused
+      void drain();
+
+      //! Make at least size bytes of the records readable at m_cursor
+      //! \return true if they are, false on a read error or at the end of the records
+      bool ensure(U32 size);
+
+      //! Move to the next chunk, carrying the unread tail of the current one
+      //! \return true if the next chunk was read
+      bool advance();
+
+      //! Ask the reader task for the next part of the records in a chunk
+      void requestChunk(U32 chunk);
+
+      //! Deserialize the record at m_cursor
+      //! \return FW_SERIALIZE_OK, or the reason the record is invalid
+      Fw::SerializeStatus readRecord(Record& record);
+
+      //! Close the sequence file if open
+      void closeFile();
+
+      //! Reader task entry point
+      static void readerTask(void* arg);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Requests to the reader task
+      Os::Queue m_requestQueue;
+
+      //! Chunks filled by the reader task, in request order
+      Os::Queue m_resultQueue;
+
+      //! Task reading chunks ahead of the sequencer
+      Os::Task m_readerTask;
+
+      //! Whether the reader task has been started
+      bool m_readerRunning;
+
+      //! Sequence file descriptor, or -1
+      int m_fd;
+
+      //! Bytes of data in each chunk
+      U32 m_chunkSize;
+
+      //! File offset of the end of the records, where the CRC starts
+      U32 m_recordsEnd;
+
+      //! File offset of the next read to request
+      U32 m_nextOffset;
+
+      //! Reads requested and not yet received
+      U32 m_pending;
+
+      //! Chunk being read
+      U32 m_chunk;
+
+      //! Next unread byte of the records
+      const U8* m_cursor;
+
+      //! End of the bytes read into the current chunk
+      const U8* m_end;
+
+      //! Whether the chunks hold the stream from the first record on
+      bool m_streaming;
+
+      //! Whether a read failed while streaming
+      bool m_readFailed;
+
+      //! Whether the CRC is extended over each chunk as it arrives
+      bool m_computeCrc;
+
+      //! CRC of the header and the records streamed so far
+      U32 m_crc;
+
+      //! Records returned by nextRecord since the last rewind
+      U32 m_recordsRead;
+
+      //! Whether a valid sequence is loaded
+      bool m_loaded;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,227 @@
+// ======================================================================
+// \title  StreamingSequenceTestMain.cpp
+// \author cindy
+// \brief  cpp file for the StreamingSequence format test main function
+// ======================================================================
+
+#include "Components/StreamingSequence/StreamingSequence.hpp"
+#include "Components/Crc32Framing/Crc32.hpp"
+
+#include <Fw/Types/MallocAllocator.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+  typedef Svc::CmdSequencerComponentImpl::Sequence::Record Record;
+
+  const char* const SEQUENCE_FILE = "StreamingSequenceTest.bin";
+
+  //! One record of a test sequence
+  struct TestRecord {
+    Record::Descriptor descriptor;
+    U32 seconds;
+    U32 useconds;
+    std::vector<U8> command;
+  };
+
+  void appendBigEndian(std::vector<U8>& out, U64 value, U32 size)
+  {
+    for (U32 i = 0; i < size; i++) {
+      out.push_back(static_cast<U8>(value >> (8 * (size - 1 - i))));
+    }
+  }
+
+  //! Records with command sizes from 1 byte to FW_COM_BUFFER_MAX_SIZE, so many straddle two chunks
+  std::vector<TestRecord> testRecords(U32 count)
+  {
+    std::vector<TestRecord> records(count);
+    U32 state = count;
+    for (U32 i = 0; i < count; i++) {
+      state = state * 1103515245 + 12345;
+      TestRecord& record = records[i];
+      record.descriptor = (i % 3 == 0) ? Record::ABSOLUTE : Record::RELATIVE;
+      record.seconds = i;
+      record.useconds = state % 1000000;
+      const U32 size = (i % 7 == 0) ? FW_COM_BUFFER_MAX_SIZE : 1 + (state >> 8) % 96;
+      for (U32 j = 0; j < size; j++) {
+        record.command.push_back(static_cast<U8>(i + j));
+      }
+    }
+    return records;
+  }
+
+  //! Serialize a sequence as FPrimeSequence reads it: header, records, CRC of both
+  std::vector<U8> serializeSequence(const std::vector<TestRecord>& records, U32 extraBytes = 0)
+  {
+    std::vector<U8> body;
+    for (const TestRecord& record : records) {
+      appendBigEndian(body, record.descriptor, sizeof(U8));
+      if (record.descriptor == Record::END) {
+        continue;
+      }
+      appendBigEndian(body, record.seconds, sizeof(U32));
+      appendBigEndian(body, record.useconds, sizeof(U32));
+      appendBigEndian(body, record.command.size(), sizeof(U32));
+      body.insert(body.end(), record.command.begin(), record.command.end());
+    }
+    body.insert(body.end(), extraBytes, 0x5A);
+
+    std::vector<U8> file;
+    appendBigEndian(file, body.size() + MathModule::StreamingSequence::CRC_SIZE, sizeof(U32));
+    appendBigEndian(file, records.size(), sizeof(U32));
+    appendBigEndian(file, TB_NONE, sizeof(FwTimeBaseStoreType));
+    appendBigEndian(file, 0, sizeof(FwTimeContextStoreType));
+    file.insert(file.end(), body.begin(), body.end());
+    const U32 crc = MathModule::Crc32::update(MathModule::Crc32::INITIAL, file.data(), file.size());
+    appendBigEndian(file, crc, sizeof(U32));
+    return file;
+  }
+
+  void writeFile(const std::vector<U8>& data)
+  {
+    FILE* file = fopen(SEQUENCE_FILE, "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fwrite(data.data(), 1, data.size(), file), data.size());
+    ASSERT_EQ(fclose(file), 0);
+  }
+
+  //! A sequencer that is never started, with a streaming sequence over the smallest buffer
+  class StreamingSequenceTest :
+    public ::testing::Test
+  {
+    protected:
+      StreamingSequenceTest() :
+        m_sequencer("cmdSeq"),
+        m_sequence(m_sequencer)
+      {
+        this->m_sequencer.init(10, 0);
+        this->m_sequence.allocateBuffer(0, this->m_allocator, MathModule::StreamingSequence::MIN_BUFFER_SIZE);
+        this->m_sequence.startReader();
+      }
+
+      ~StreamingSequenceTest()
+      {
+        this->m_sequence.stopReader();
+        this->m_sequence.deallocateBuffer(this->m_allocator);
+        (void) remove(SEQUENCE_FILE);
+      }
+
+      bool load()
+      {
+        return this->m_sequence.loadFile(Fw::String(SEQUENCE_FILE));
+      }
+
+      //! Run the loaded sequence to the end, checking every record
+      void expectRecords(const std::vector<TestRecord>& expected)
+      {
+        for (size_t i = 0; i < expected.size(); i++) {
+          ASSERT_TRUE(this->m_sequence.hasMoreRecords()) << "record " << i;
+          Record record;
+          this->m_sequence.nextRecord(record);
+          ASSERT_EQ(record.m_descriptor, expected[i].descriptor) << "record " << i;
+          if (record.m_descriptor == Record::END) {
+            continue;
+          }
+          EXPECT_EQ(record.m_timeTag.getSeconds(), expected[i].seconds) << "record " << i;
+          EXPECT_EQ(record.m_timeTag.getUSeconds(), expected[i].useconds) << "record " << i;
+          ASSERT_EQ(record.m_command.getBuffLength(), expected[i].command.size()) << "record " << i;
+          EXPECT_EQ(memcmp(record.m_command.getBuffAddr(), expected[i].command.data(), expected[i].command.size()), 0)
+            << "record " << i;
+        }
+        EXPECT_FALSE(this->m_sequence.hasMoreRecords());
+      }
+
+      Fw::MallocAllocator m_allocator;
+      Svc::CmdSequencerComponentImpl m_sequencer;
+      MathModule::StreamingSequence m_sequence;
+  };
+
+}
+
+TEST_F(StreamingSequenceTest, Nominal) {
+  const std::vector<TestRecord> records = testRecords(2000);
+  writeFile(serializeSequence(records));
+  ASSERT_TRUE(this->load());
+  EXPECT_EQ(this->m_sequence.getHeader().m_numRecords, records.size());
+  this->expectRecords(records);
+
+  // A rerun streams the file again from the first record
+  this->m_sequence.reset();
+  this->expectRecords(records);
+}
+
+TEST_F(StreamingSequenceTest, EndRecord) {
+  std::vector<TestRecord> records = testRecords(3);
+  records.push_back(TestRecord{Record::END, 0, 0, std::vector<U8>()});
+  writeFile(serializeSequence(records));
+  ASSERT_TRUE(this->load());
+  this->expectRecords(records);
+}
+
+TEST_F(StreamingSequenceTest, Empty) {
+  writeFile(serializeSequence(std::vector<TestRecord>()));
+  ASSERT_TRUE(this->load());
+  EXPECT_FALSE(this->m_sequence.hasMoreRecords());
+}
+
+TEST_F(StreamingSequenceTest, ManyRecordsInFixedMemory) {
+  // Several hundred times the sequence buffer
+  const std::vector<TestRecord> records = testRecords(100000);
+  const std::vector<U8> file = serializeSequence(records);
+  ASSERT_GT(file.size(), 500U * MathModule::StreamingSequence::MIN_BUFFER_SIZE);
+  writeFile(file);
+  ASSERT_TRUE(this->load());
+  this->expectRecords(records);
+}
+
+TEST_F(StreamingSequenceTest, Rejects) {
+  const std::vector<TestRecord> records = testRecords(50);
+
+  // Missing file
+  EXPECT_FALSE(this->load());
+
+  // Any flipped byte fails the CRC, or the size check for the size field
+  const std::vector<U8> good = serializeSequence(records);
+  const size_t corruptAt[] = {0, 5, MathModule::StreamingSequence::HEADER_SIZE, good.size() / 2, good.size() - 1};
+  for (const size_t at : corruptAt) {
+    std::vector<U8> bad(good);
+    bad[at] ^= 0x01;
+    writeFile(bad);
+    EXPECT_FALSE(this->load()) << "byte " << at;
+    EXPECT_FALSE(this->m_sequence.hasMoreRecords());
+  }
+
+  // Truncated
+  writeFile(std::vector<U8>(good.begin(), good.end() - 10));
+  EXPECT_FALSE(this->load());
+
+  // Bytes after the last record
+  writeFile(serializeSequence(records, 3));
+  EXPECT_FALSE(this->load());
+
+  // A command larger than a com buffer
+  std::vector<TestRecord> large(records);
+  large[20].command.resize(FW_COM_BUFFER_MAX_SIZE + 1);
+  writeFile(serializeSequence(large));
+  EXPECT_FALSE(this->load());
+
+  // An invalid descriptor
+  std::vector<TestRecord> invalid(records);
+  invalid[10].descriptor = static_cast<Record::Descriptor>(Record::END + 1);
+  writeFile(serializeSequence(invalid));
+  EXPECT_FALSE(this->load());
+
+  // The sequence still loads once the file is good again
+  writeFile(good);
+  ASSERT_TRUE(this->load());
+  this->expectRecords(records);
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
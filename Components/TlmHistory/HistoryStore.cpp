@@ -0,0 +1,417 @@
+// ======================================================================
+// \title  HistoryStore.cpp
+// \author cindy
+// \brief  Compressed per-channel telemetry history used by TlmHistory
+// ======================================================================
+
+#include "Components/TlmHistory/HistoryStore.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 HistoryStore::MAGIC;
+  const U32 HistoryStore::VERSION;
+  const U32 HistoryStore::COLUMNS;
+  const U32 HistoryStore::BLOCK_SIZE;
+  const U32 HistoryStore::MAX_VALUE_SIZE;
+  const U32 HistoryStore::MAX_SAMPLE_SIZE;
+
+  namespace {
+
+    const U64 USECONDS_PER_SECOND = 1000000;
+
+    //! Small magnitudes of either sign to small unsigned numbers
+    U64 zigzag(I64 value)
+    {
+      return (static_cast<U64>(value) << 1) ^ static_cast<U64>(value >> 63);
+    }
+
+    I64 unzigzag(U64 value)
+    {
+      return static_cast<I64>(value >> 1) ^ -static_cast<I64>(value & 1);
+    }
+
+    //! Seven bits a byte, low bits first
+    //! \return bytes written
+    U32 putVarint(U8* out, U64 value)
+    {
+      U32 length = 0;
+      while (value >= 0x80) {
+        out[length++] = static_cast<U8>(value | 0x80);
+        value >>= 7;
+      }
+      out[length++] = static_cast<U8>(value);
+      return length;
+    }
+
+    //! \return bytes read, 0 if the varint runs past the end or past 64 bits
+    U32 getVarint(const U8* in, U32 available, U64& value)
+    {
+      value = 0;
+      for (U32 length = 0; (length < available) && (length < 10); length++) {
+        value |= static_cast<U64>(in[length] & 0x7F) << (7 * length);
+        if ((in[length] & 0x80) == 0) {
+          return length + 1;
+        }
+      }
+      return 0;
+    }
+
+    //! A code byte, leading zero bytes in the high nibble and kept bytes in
+    //! the low one, then the kept bytes of the XOR of the two values
+    //! \return bytes written
+    U32 encodeValue(const U8* previous, const U8* value, U32 size, U8* out)
+    {
+      U8 change[HistoryStore::MAX_VALUE_SIZE];
+      U32 lead = size;
+      U32 last = 0;
+      for (U32 i = 0; i < size; i++) {
+        change[i] = previous[i] ^ value[i];
+        if (change[i] != 0) {
+          lead = (lead == size) ? i : lead;
+          last = i + 1;
+        }
+      }
+      const U32 kept = (lead == size) ? 0 : last - lead;
+      out[0] = static_cast<U8>((lead << 4) | kept);
+      ::memcpy(&out[1], &change[lead], kept);
+      return 1 + kept;
+    }
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Block reader
+  // ----------------------------------------------------------------------
+
+  HistoryStore::BlockReader ::
+    BlockReader(const U8* block) :
+      m_block(block),
+      m_used(0),
+      m_offset(0),
+      m_remaining(0),
+      m_time(0),
+      m_delta(0)
+  {
+    BlockHeader header;
+    ::memcpy(&header, block, sizeof(header));
+    if ((header.sequence != 0) && (header.valueSize > 0) && (header.valueSize <= MAX_VALUE_SIZE) &&
+        (header.used >= sizeof(header) + header.valueSize) && (header.used <= BLOCK_SIZE)) {
+      this->m_used = header.used;
+      this->m_remaining = header.count;
+      this->m_last.seconds = header.seconds;
+      this->m_last.useconds = header.useconds;
+      this->m_last.timeBase = header.timeBase;
+      this->m_last.timeContext = header.timeContext;
+      this->m_last.valueSize = header.valueSize;
+      ::memcpy(this->m_last.value, &block[sizeof(header)], header.valueSize);
+    }
+  }
+
+  bool HistoryStore::BlockReader ::
+    next(Sample& sample)
+  {
+    if (this->m_remaining == 0) {
+      return false;
+    }
+    if (this->m_offset == 0) {
+      // The first sample is stored whole
+      this->m_offset = sizeof(BlockHeader) + this->m_last.valueSize;
+      this->m_time = this->m_last.seconds * USECONDS_PER_SECOND + this->m_last.useconds;
+    } else {
+      U64 change = 0;
+      const U32 length = getVarint(&this->m_block[this->m_offset], this->m_used - this->m_offset, change);
+      this->m_offset += length;
+      if ((length == 0) || (this->m_offset >= this->m_used)) {
+        this->m_remaining = 0;
+        return false;
+      }
+      this->m_delta += unzigzag(change);
+      this->m_time += static_cast<U64>(this->m_delta);
+      const U8 code = this->m_block[this->m_offset++];
+      const U32 lead = code >> 4;
+      const U32 kept = code & 0x0F;
+      if ((lead + kept > this->m_last.valueSize) || (this->m_offset + kept > this->m_used)) {
+        this->m_remaining = 0;
+        return false;
+      }
+      for (U32 i = lead; i < lead + kept; i++) {
+        this->m_last.value[i] ^= this->m_block[this->m_offset++];
+      }
+      this->m_last.seconds = static_cast<U32>(this->m_time / USECONDS_PER_SECOND);
+      this->m_last.useconds = static_cast<U32>(this->m_time % USECONDS_PER_SECOND);
+    }
+    --this->m_remaining;
+    sample = this->m_last;
+    return true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  HistoryStore ::
+    HistoryStore() :
+      m_map(nullptr),
+      m_mapSize(0)
+  {
+
+  }
+
+  HistoryStore ::
+    ~HistoryStore()
+  {
+    this->close();
+  }
+
+  /*
+    As with JournalRing, a file of exactly the expected size whose header
+    matches is reused, so history from before a restart stays queryable.
+    Any other file is truncated to zeros and given a new header, magic
+    last. Anonymous memory starts zeroed and always starts over.
+  */
+  I32 HistoryStore ::
+    open(const char* path, U32 blocksPerColumn)
+  {
+    FW_ASSERT(blocksPerColumn > 0);
+    this->close();
+
+    const U64 size = sizeof(FileHeader) + COLUMNS * sizeof(Column) +
+                     static_cast<U64>(COLUMNS) * blocksPerColumn * BLOCK_SIZE;
+    bool reuse = false;
+    void* map = MAP_FAILED;
+    I32 error = 0;
+    if (path == nullptr) {
+      map = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (map == MAP_FAILED) {
+        return errno;
+      }
+    } else {
+      const int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+      if (fd < 0) {
+        return errno;
+      }
+      struct stat info;
+      if (::fstat(fd, &info) != 0) {
+        error = errno;
+      } else {
+        reuse = (static_cast<U64>(info.st_size) == size);
+        if (!reuse && ((::ftruncate(fd, 0) != 0) || (::ftruncate(fd, static_cast<off_t>(size)) != 0))) {
+          error = errno;
+        }
+      }
+      if (error == 0) {
+        map = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+          error = errno;
+        }
+      }
+      (void) ::close(fd);
+      if (error != 0) {
+        return error;
+      }
+    }
+
+    FileHeader* header = static_cast<FileHeader*>(map);
+    if (!reuse || (header->magic != MAGIC) || (header->version != VERSION) || (header->blockSize != BLOCK_SIZE) ||
+        (header->columns != COLUMNS) || (header->blocksPerColumn != blocksPerColumn)) {
+      ::memset(map, 0, static_cast<size_t>(size));
+      header->version = VERSION;
+      header->blockSize = BLOCK_SIZE;
+      header->columns = COLUMNS;
+      header->blocksPerColumn = blocksPerColumn;
+      header->magic = MAGIC;
+    }
+    this->m_map = static_cast<U8*>(map);
+    this->m_mapSize = size;
+    return 0;
+  }
+
+  void HistoryStore ::
+    close()
+  {
+    if (this->m_map != nullptr) {
+      (void) ::munmap(this->m_map, static_cast<size_t>(this->m_mapSize));
+    }
+    this->m_map = nullptr;
+    this->m_mapSize = 0;
+  }
+
+  // ----------------------------------------------------------------------
+  // Samples
+  // ----------------------------------------------------------------------
+
+  /*
+    A sample is encoded against the channel's last one and added to the
+    open block if it fits. Otherwise, or if the sample cannot be expressed
+    relative to the block (another value size or time base, or a time tag
+    with microseconds out of range), it starts the next block, reusing the
+    column's oldest once the column is full.
+  */
+  bool HistoryStore ::
+    append(FwChanIdType id, const Sample& sample)
+  {
+    if ((this->m_map == nullptr) || (sample.valueSize == 0) || (sample.valueSize > MAX_VALUE_SIZE)) {
+      return false;
+    }
+    Column* const column = this->lookup(id, true);
+    if (column == nullptr) {
+      return false;
+    }
+    const U64 time = sample.seconds * USECONDS_PER_SECOND + sample.useconds;
+    BlockHeader* const open = (column->head > 0) ? this->block(*column, column->head - 1) : nullptr;
+    U32 added = 0;
+    if ((open != nullptr) && (sample.useconds < USECONDS_PER_SECOND) && (open->valueSize == sample.valueSize) &&
+        (open->timeBase == sample.timeBase) && (open->timeContext == sample.timeContext)) {
+      U8 encoded[MAX_SAMPLE_SIZE];
+      const I64 delta = static_cast<I64>(time - column->time);
+      U32 length = putVarint(encoded, zigzag(delta - column->delta));
+      length += encodeValue(column->value, sample.value, sample.valueSize, &encoded[length]);
+      if (open->used + length <= BLOCK_SIZE) {
+        ::memcpy(reinterpret_cast<U8*>(open) + open->used, encoded, length);
+        open->used = static_cast<U16>(open->used + length);
+        ++open->count;
+        column->time = time;
+        column->delta = delta;
+        ::memcpy(column->value, sample.value, sample.valueSize);
+        added = length;
+      }
+    }
+    if (added == 0) {
+      added = this->startBlock(*column, sample, time);
+    }
+    FileHeader* const header = reinterpret_cast<FileHeader*>(this->m_map);
+    ++header->samples;
+    header->bytes += added;
+    return true;
+  }
+
+  bool HistoryStore ::
+    blocks(FwChanIdType id, U64& first, U64& end) const
+  {
+    const Column* const column = this->lookup(id, false);
+    if (column == nullptr) {
+      return false;
+    }
+    const U32 blocksPerColumn = this->blocksPerColumn();
+    end = column->head;
+    first = (end > blocksPerColumn) ? end - blocksPerColumn : 0;
+    return true;
+  }
+
+  bool HistoryStore ::
+    readBlock(FwChanIdType id, U64 sequence, U8* block) const
+  {
+    const Column* const column = this->lookup(id, false);
+    if ((column == nullptr) || (sequence >= column->head) || (column->head - sequence > this->blocksPerColumn())) {
+      return false;
+    }
+    const BlockHeader* const source = this->block(*column, sequence);
+    if (source->sequence != sequence + 1) {
+      return false;
+    }
+    ::memcpy(block, source, BLOCK_SIZE);
+    return true;
+  }
+
+  U32 HistoryStore ::
+    channels() const
+  {
+    return (this->m_map != nullptr) ? reinterpret_cast<const FileHeader*>(this->m_map)->channels : 0;
+  }
+
+  U64 HistoryStore ::
+    samples() const
+  {
+    return (this->m_map != nullptr) ? reinterpret_cast<const FileHeader*>(this->m_map)->samples : 0;
+  }
+
+  U64 HistoryStore ::
+    bytes() const
+  {
+    return (this->m_map != nullptr) ? reinterpret_cast<const FileHeader*>(this->m_map)->bytes : 0;
+  }
+
+  U32 HistoryStore ::
+    blocksPerColumn() const
+  {
+    return (this->m_map != nullptr) ? reinterpret_cast<const FileHeader*>(this->m_map)->blocksPerColumn : 0;
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  HistoryStore::Column* HistoryStore ::
+    lookup(FwChanIdType id, bool take) const
+  {
+    if (this->m_map == nullptr) {
+      return nullptr;
+    }
+    Column* const columns = reinterpret_cast<Column*>(this->m_map + sizeof(FileHeader));
+    U32 slot = static_cast<U32>(id) % COLUMNS;
+    for (U32 probe = 0; probe < COLUMNS; probe++) {
+      Column& column = columns[slot];
+      if (column.used && (column.id == id)) {
+        return &column;
+      }
+      if (!column.used) {
+        if (!take) {
+          return nullptr;
+        }
+        column.id = id;
+        column.used = 1;
+        column.head = 0;
+        ++reinterpret_cast<FileHeader*>(this->m_map)->channels;
+        return &column;
+      }
+      slot = (slot + 1) % COLUMNS;
+    }
+    return nullptr;
+  }
+
+  HistoryStore::BlockHeader* HistoryStore ::
+    block(const Column& column, U64 sequence) const
+  {
+    const Column* const columns = reinterpret_cast<const Column*>(this->m_map + sizeof(FileHeader));
+    const U64 index = static_cast<U64>(&column - columns) * this->blocksPerColumn() + sequence % this->blocksPerColumn();
+    U8* const blocks = this->m_map + sizeof(FileHeader) + COLUMNS * sizeof(Column);
+    return reinterpret_cast<BlockHeader*>(blocks + index * BLOCK_SIZE);
+  }
+
+  /*
+    The block's sequence word is cleared while it is rewritten and set
+    last, so readBlock never hands out a block whose header and contents
+    belong to different fills.
+  */
+  U32 HistoryStore ::
+    startBlock(Column& column, const Sample& sample, U64 time)
+  {
+    const U64 sequence = column.head;
+    BlockHeader* const header = this->block(column, sequence);
+    header->sequence = 0;
+    header->seconds = sample.seconds;
+    header->useconds = sample.useconds;
+    header->timeBase = sample.timeBase;
+    header->timeContext = sample.timeContext;
+    header->valueSize = sample.valueSize;
+    header->count = 1;
+    header->used = static_cast<U16>(sizeof(BlockHeader) + sample.valueSize);
+    ::memcpy(header + 1, sample.value, sample.valueSize);
+    header->sequence = sequence + 1;
+
+    column.head = sequence + 1;
+    column.time = time;
+    column.delta = 0;
+    ::memcpy(column.value, sample.value, sample.valueSize);
+    return header->used;
+  }
+
+}
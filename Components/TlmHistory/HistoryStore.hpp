@@ -0,0 +1,219 @@
+// ======================================================================
+// \title  HistoryStore.hpp
+// \author cindy
+// \brief  Compressed per-channel telemetry history used by TlmHistory
+//
+// Each channel has a column: a ring of fixed-size blocks holding only that
+// channel's samples. A block starts with one full sample; every later
+// sample stores its time as a delta of the previous time delta and its
+// value XORed with the previous value, with zero bytes at either end
+// trimmed. A channel updated on a period with an unchanged value costs two
+// bytes a sample. When a column is full its oldest block is reused, so
+// every block decodes on its own.
+//
+// The store lives in a shared mapping of a file, which survives a restart
+// with the same layout, or in anonymous memory. It is not thread safe;
+// TlmHistory serializes access. Blocks are in native byte order.
+// ======================================================================
+
+#ifndef MathModule_HistoryStore_HPP
+#define MathModule_HistoryStore_HPP
+
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  class HistoryStore {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants and types
+      // ----------------------------------------------------------------------
+
+      //! Identifies a history file
+      static const U32 MAGIC = 0x54484953;
+
+      //! Layout version. Bump when FileHeader, Column or BlockHeader changes.
+      static const U32 VERSION = 1;
+
+      //! Channels that can be recorded, the size of the column table
+      static const U32 COLUMNS = 128;
+
+      //! Bytes in a block, header included
+      static const U32 BLOCK_SIZE = 512;
+
+      //! Largest value recorded. Longer values, such as strings, are not.
+      static const U32 MAX_VALUE_SIZE = 8;
+
+      //! One channel update
+      struct Sample {
+        U32 seconds; //!< Time tag seconds
+        U32 useconds; //!< Time tag microseconds
+        U16 timeBase; //!< Time tag base
+        U8 timeContext; //!< Time tag context
+        U8 valueSize; //!< Bytes in value
+        U8 value[MAX_VALUE_SIZE]; //!< Serialized value
+      };
+
+      //! Decodes the samples of a block copied out by readBlock, oldest first
+      class BlockReader {
+
+        public:
+
+          BlockReader(
+              const U8* block //!< BLOCK_SIZE bytes
+          );
+
+          //! Decode the next sample
+          //! \return false once the block is exhausted or found damaged
+          bool next(
+              Sample& sample //!< Filled with the sample
+          );
+
+        private:
+
+          const U8* m_block;
+          U32 m_used;
+          U32 m_offset;
+          U32 m_remaining;
+          U64 m_time;
+          I64 m_delta;
+          Sample m_last;
+
+      };
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      HistoryStore();
+
+      //! Unmaps the store
+      ~HistoryStore();
+
+      //! Map a history file, creating it or starting it over if its layout differs,
+      //! or anonymous memory if path is null
+      //! \return 0, or the errno value of the failed call
+      I32 open(
+          const char* path, //!< The history file, or nullptr
+          U32 blocksPerColumn //!< Blocks kept per channel, at least 1
+      );
+
+      //! Unmap the store
+      void close();
+
+      // ----------------------------------------------------------------------
+      // Samples
+      // ----------------------------------------------------------------------
+
+      //! Record a channel update, taking a free column for a new channel
+      //! \return false if nothing is mapped, the value is empty or too long, or every column is taken
+      bool append(
+          FwChanIdType id, //!< The channel
+          const Sample& sample //!< The update
+      );
+
+      //! Sequence numbers of the blocks a channel has kept, first to end exclusive
+      //! \return false if the channel has no column
+      bool blocks(
+          FwChanIdType id, //!< The channel
+          U64& first, //!< Set to the oldest kept block
+          U64& end //!< Set to one past the newest block
+      ) const;
+
+      //! Copy out a block of a channel
+      //! \return false if the block was never written or has been reused
+      bool readBlock(
+          FwChanIdType id, //!< The channel
+          U64 sequence, //!< The block
+          U8* block //!< Filled with BLOCK_SIZE bytes
+      ) const;
+
+      //! Channels with a column, including earlier runs
+      U32 channels() const;
+
+      //! Samples ever appended, including earlier runs
+      U64 samples() const;
+
+      //! Bytes ever appended, block headers included
+      U64 bytes() const;
+
+      //! Blocks per column of the mapped store, 0 when none is mapped
+      U32 blocksPerColumn() const;
+
+    private:
+
+      //! Start of the store. The column table and the blocks follow it.
+      struct FileHeader {
+        U32 magic; //!< MAGIC, written last when a file is started over
+        U32 version; //!< VERSION
+        U32 blockSize; //!< BLOCK_SIZE
+        U32 columns; //!< COLUMNS
+        U32 blocksPerColumn; //!< Blocks in each column
+        U32 channels; //!< Columns taken
+        U64 samples; //!< Samples appended
+        U64 bytes; //!< Bytes appended
+      };
+
+      //! A channel's column, open addressing on the channel id
+      struct Column {
+        FwChanIdType id; //!< The channel
+        U32 used; //!< Whether the column holds a channel
+        U64 head; //!< Blocks ever started
+        U64 time; //!< Time of the last sample, in microseconds
+        I64 delta; //!< Time from the sample before it
+        U8 value[MAX_VALUE_SIZE]; //!< Value of the last sample
+      };
+
+      //! Start of a block. The first sample's value follows, then the encoded samples.
+      struct BlockHeader {
+        U64 sequence; //!< Block sequence number + 1, 0 if never written
+        U32 seconds; //!< First sample's time tag seconds
+        U32 useconds; //!< First sample's time tag microseconds
+        U16 timeBase; //!< Time tag base of every sample
+        U8 timeContext; //!< Time tag context of every sample
+        U8 valueSize; //!< Value size of every sample
+        U16 count; //!< Samples in the block
+        U16 used; //!< Bytes used, header included
+      };
+
+      //! Longest encoded sample: time delta change and value
+      static const U32 MAX_SAMPLE_SIZE = 10 + 1 + MAX_VALUE_SIZE;
+
+      static_assert(sizeof(BlockHeader) + MAX_VALUE_SIZE + MAX_SAMPLE_SIZE <= BLOCK_SIZE, "a block must hold a sample");
+
+      //! Find the column of a channel, or take a free one
+      //! \return the column, or nullptr if the channel has none and none was taken
+      Column* lookup(
+          FwChanIdType id, //!< The channel
+          bool take //!< Whether to take a free column for a new channel
+      ) const;
+
+      //! A block of a column
+      BlockHeader* block(
+          const Column& column, //!< The column
+          U64 sequence //!< The block
+      ) const;
+
+      //! Start a block with a sample
+      //! \return bytes written
+      U32 startBlock(
+          Column& column, //!< The channel's column
+          const Sample& sample, //!< The first sample
+          U64 time //!< Its time in microseconds
+      );
+
+      //! The mapping
+      U8* m_map;
+
+      //! Bytes mapped
+      U64 m_mapSize;
+
+  };
+
+}
+
+#endif
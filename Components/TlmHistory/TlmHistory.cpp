@@ -0,0 +1,245 @@
+// ======================================================================
+// \title  TlmHistory.cpp
+// \author cindy
+// \brief  cpp file for TlmHistory component implementation class
+// ======================================================================
+
+#include "Components/TlmHistory/TlmHistory.hpp"
+#include "Components/EventJournal/StagingFile.hpp"
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/Serializable.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace MathModule {
+
+  const U32 TlmHistory::QUERY_FILE_MAGIC;
+  const U32 TlmHistory::QUERY_HEADER_SIZE;
+  const U32 TlmHistory::RECORD_HEADER_SIZE;
+  const U32 TlmHistory::STAGING_SIZE;
+  const U32 TlmHistory::FILE_NAME_SIZE;
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  TlmHistory ::
+    TlmHistory(const char* const compName) :
+      TlmHistoryComponentBase(compName),
+      m_dropped(0)
+  {
+
+  }
+
+  TlmHistory ::
+    ~TlmHistory()
+  {
+
+  }
+
+  void TlmHistory ::
+    configure(const char* file, U32 blocksPerChannel, const char* queryPrefix)
+  {
+    FW_ASSERT(queryPrefix != nullptr);
+    this->m_queryPrefix = queryPrefix;
+    this->m_lock.lock();
+    const I32 error = this->m_store.open(file, blocksPerChannel);
+    const U32 channels = this->m_store.channels();
+    this->m_lock.unLock();
+    if (error != 0) {
+      this->log_WARNING_HI_HISTORY_OPEN_ERROR(error);
+      return;
+    }
+    this->log_ACTIVITY_HI_HISTORY_OPENED(channels, blocksPerChannel);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    Runs on the thread of whichever component wrote the channel. Recording
+    is a short encode and copy into the channel's open block, with no
+    allocation or system call.
+  */
+  void TlmHistory ::
+    TlmRecv_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwChanIdType id,
+        Fw::Time& timeTag,
+        Fw::TlmBuffer& val
+    )
+  {
+    HistoryStore::Sample sample;
+    sample.seconds = timeTag.getSeconds();
+    sample.useconds = timeTag.getUSeconds();
+    sample.timeBase = static_cast<U16>(timeTag.getTimeBase());
+    sample.timeContext = timeTag.getContext();
+    const FwSizeType size = val.getBuffLength();
+    sample.valueSize = static_cast<U8>((size <= HistoryStore::MAX_VALUE_SIZE) ? size : 0);
+    ::memcpy(sample.value, val.getBuffAddr(), sample.valueSize);
+
+    this->m_lock.lock();
+    if (!this->m_store.append(id, sample)) {
+      ++this->m_dropped;
+    }
+    this->m_lock.unLock();
+  }
+
+  /*
+    The counters are read under the lock and written after it is released:
+    this component's own telemetry comes back through TlmRecv.
+  */
+  void TlmHistory ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->m_lock.lock();
+    const U64 samples = this->m_store.samples();
+    const U64 bytes = this->m_store.bytes();
+    const U32 channels = this->m_store.channels();
+    const U32 dropped = this->m_dropped;
+    this->m_lock.unLock();
+
+    this->tlmWrite_SAMPLES_RECORDED(samples);
+    this->tlmWrite_SAMPLES_DROPPED(dropped);
+    this->tlmWrite_CHANNELS_RECORDED(channels);
+    this->tlmWrite_BYTES_PER_SAMPLE((samples > 0) ? static_cast<F32>(bytes) / static_cast<F32>(samples) : 0.0f);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  /*
+    Only the history store wraps; query files are never rotated or removed
+    by the component. Naming each after its channel and range bounds them
+    to one file per distinct query, and lets the ground ask again after a
+    lost downlink without a second copy piling up. The command completes
+    once fileDownlink has queued the file, since the transfer can outlast
+    the command timeout; QUERY_DOWNLINK_REJECTED covers a full queue.
+  */
+  void TlmHistory ::
+    QUERY_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        U32 channel,
+        U32 start,
+        U32 end
+    )
+  {
+    if (end < start) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+      return;
+    }
+    U64 first = 0;
+    U64 last = 0;
+    this->m_lock.lock();
+    const bool recorded = this->m_store.blocks(channel, first, last);
+    this->m_lock.unLock();
+    if (!recorded) {
+      this->log_WARNING_LO_CHANNEL_NOT_RECORDED(channel);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+
+    char path[FILE_NAME_SIZE];
+    const int length = ::snprintf(path, sizeof(path), "%s_%u_%u_%u.bin", this->m_queryPrefix.toChar(),
+                                  channel, start, end);
+    U32 samples = 0;
+    I32 error = ENAMETOOLONG;
+    if ((length > 0) && (static_cast<U32>(length) < sizeof(path))) {
+      error = this->extractQuery(path, channel, start, end, samples);
+    }
+    if (error != 0) {
+      this->log_WARNING_HI_QUERY_WRITE_ERROR(error);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+
+    const Fw::String file(path);
+    const Svc::SendFileResponse response = this->sendFile_out(0, file, file, 0, 0);
+    if (response.getstatus() != Svc::SendFileStatus::STATUS_OK) {
+      this->log_WARNING_HI_QUERY_DOWNLINK_REJECTED(response.getstatus());
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    Fw::LogStringArg fileArg(path);
+    this->log_ACTIVITY_HI_QUERY_EXTRACTED(samples, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  /*
+    Blocks are copied out one at a time under the lock and decoded after
+    it, so recording is held up for one block copy at most. A block reused
+    between copies is skipped. Records are big endian, with the time in
+    Fw::Time's serialized order and the value as the channel serialized it.
+  */
+  I32 TlmHistory ::
+    extractQuery(const char* path, FwChanIdType channel, U32 start, U32 end, U32& samples)
+  {
+    StagingFile file(this->m_staging, STAGING_SIZE);
+    I32 error = file.open(path);
+    if (error != 0) {
+      return error;
+    }
+    Fw::SerializeBufferBase& staging = file.buffer();
+    Fw::SerializeStatus status = staging.serialize(QUERY_FILE_MAGIC);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = staging.serialize(static_cast<U32>(channel));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = staging.serialize(start);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = staging.serialize(end);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+
+    U64 first = 0;
+    U64 last = 0;
+    this->m_lock.lock();
+    (void) this->m_store.blocks(channel, first, last);
+    this->m_lock.unLock();
+
+    for (U64 sequence = first; (sequence < last) && (error == 0); sequence++) {
+      this->m_lock.lock();
+      const bool copied = this->m_store.readBlock(channel, sequence, this->m_block);
+      this->m_lock.unLock();
+      if (!copied) {
+        continue;
+      }
+      HistoryStore::BlockReader reader(this->m_block);
+      HistoryStore::Sample sample;
+      while (reader.next(sample)) {
+        if ((sample.seconds < start) || (sample.seconds > end)) {
+          continue;
+        }
+        error = file.reserve(RECORD_HEADER_SIZE + sample.valueSize);
+        if (error != 0) {
+          break;
+        }
+        status = staging.serialize(sample.timeBase);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+        status = staging.serialize(sample.timeContext);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+        status = staging.serialize(sample.seconds);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+        status = staging.serialize(sample.useconds);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+        status = staging.serialize(sample.valueSize);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+        status = staging.serialize(sample.value, sample.valueSize, true);
+        FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+        ++samples;
+      }
+    }
+    return file.close();
+  }
+
+}
@@ -0,0 +1,145 @@
+// ======================================================================
+// \title  TlmHistory.hpp
+// \author cindy
+// \brief  hpp file for TlmHistory component implementation class
+// ======================================================================
+
+#ifndef MathModule_TlmHistory_HPP
+#define MathModule_TlmHistory_HPP
+
+#include "Components/TlmHistory/TlmHistoryComponentAc.hpp"
+#include "Components/TlmHistory/HistoryStore.hpp"
+#include <Fw/Types/String.hpp>
+#include <Os/Mutex.hpp>
+
+namespace MathModule {
+
+  class TlmHistory :
+    public TlmHistoryComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! First word of a query file
+      static const U32 QUERY_FILE_MAGIC = 0x54485831;
+
+      //! Query file header: magic, channel id, start and end seconds
+      static const U32 QUERY_HEADER_SIZE = 4 * sizeof(U32);
+
+      //! Query file record before the value: time and value size
+      static const U32 RECORD_HEADER_SIZE = sizeof(U16) + sizeof(U8) + 2 * sizeof(U32) + sizeof(U8);
+
+      //! Bytes collected before each write of a query file
+      static const U32 STAGING_SIZE = 4096;
+
+      //! Longest query file name, the size of the event argument reporting it
+      static const U32 FILE_NAME_SIZE = 80;
+
+      static_assert(QUERY_HEADER_SIZE + RECORD_HEADER_SIZE + HistoryStore::MAX_VALUE_SIZE <= STAGING_SIZE,
+                    "a record must fit the staging buffer");
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct TlmHistory object
+      TlmHistory(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy TlmHistory object
+      ~TlmHistory();
+
+      //! Set up the store. Updates arriving before this are not recorded.
+      void configure(
+          const char* file, //!< The history file, or nullptr to keep the history in memory only
+          U32 blocksPerChannel, //!< Blocks of HistoryStore::BLOCK_SIZE bytes kept per channel
+          const char* queryPrefix //!< Path prefix of query files
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for TlmRecv
+      void TlmRecv_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwChanIdType id, //!< Telemetry Channel ID
+          Fw::Time& timeTag, //!< Time Tag
+          Fw::TlmBuffer& val //!< Buffer containing serialized telemetry value
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command QUERY
+      void QUERY_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq, //!< The command sequence number
+          U32 channel, //!< The channel id
+          U32 start, //!< First second of the range
+          U32 end //!< Last second of the range, inclusive
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Write the samples of a channel within a range to a file
+      //! \return 0, or the errno value of the failed call
+      I32 extractQuery(
+          const char* path, //!< The query file
+          FwChanIdType channel, //!< The channel
+          U32 start, //!< First second
+          U32 end, //!< Last second, inclusive
+          U32& samples //!< Set to the number of samples written
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Guards the store and the drop count
+      Os::Mutex m_lock;
+
+      //! The recorded history
+      HistoryStore m_store;
+
+      //! Path prefix of query files
+      Fw::String m_queryPrefix;
+
+      //! Updates not recorded
+      U32 m_dropped;
+
+      //! Block being decoded by a query
+      U8 m_block[HistoryStore::BLOCK_SIZE];
+
+      //! Query file bytes waiting to be written
+      U8 m_staging[STAGING_SIZE];
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,203 @@
+// ======================================================================
+// \title  TlmHistoryTestMain.cpp
+// \author cindy
+// \brief  cpp file for TlmHistory component test main function
+// ======================================================================
+
+#include "TlmHistoryTester.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+  std::string storePath(const char* name)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/HistoryStore.%s.%d", name, static_cast<int>(::getpid()));
+    (void) ::unlink(path);
+    return path;
+  }
+
+  MathModule::HistoryStore::Sample sample(U32 seconds, U32 useconds, U64 value, U8 size)
+  {
+    MathModule::HistoryStore::Sample sample;
+    sample.seconds = seconds;
+    sample.useconds = useconds;
+    sample.timeBase = 2;
+    sample.timeContext = 0;
+    sample.valueSize = size;
+    for (U32 b = 0; b < size; b++) {
+      sample.value[b] = static_cast<U8>(value >> (8 * (size - 1 - b)));
+    }
+    return sample;
+  }
+
+  //! Decode every kept sample of a channel
+  std::vector<MathModule::HistoryStore::Sample> readAll(const MathModule::HistoryStore& store, FwChanIdType id)
+  {
+    std::vector<MathModule::HistoryStore::Sample> samples;
+    U64 first = 0;
+    U64 end = 0;
+    if (!store.blocks(id, first, end)) {
+      return samples;
+    }
+    U8 block[MathModule::HistoryStore::BLOCK_SIZE];
+    for (U64 sequence = first; sequence < end; sequence++) {
+      EXPECT_TRUE(store.readBlock(id, sequence, block)) << sequence;
+      MathModule::HistoryStore::BlockReader reader(block);
+      MathModule::HistoryStore::Sample decoded;
+      while (reader.next(decoded)) {
+        samples.push_back(decoded);
+      }
+    }
+    return samples;
+  }
+
+  void expectSame(const MathModule::HistoryStore::Sample& actual, const MathModule::HistoryStore::Sample& expected)
+  {
+    EXPECT_EQ(actual.seconds, expected.seconds);
+    EXPECT_EQ(actual.useconds, expected.useconds);
+    EXPECT_EQ(actual.timeBase, expected.timeBase);
+    EXPECT_EQ(actual.timeContext, expected.timeContext);
+    ASSERT_EQ(actual.valueSize, expected.valueSize);
+    EXPECT_EQ(::memcmp(actual.value, expected.value, expected.valueSize), 0);
+  }
+
+}
+
+TEST(HistoryStore, RoundTrip) {
+  MathModule::HistoryStore store;
+  ASSERT_EQ(store.open(nullptr, 64), 0);
+  std::vector<MathModule::HistoryStore::Sample> written;
+  U64 value = 0x3F800000;
+  U32 seconds = 1000;
+  U32 useconds = 0;
+  for (U32 i = 0; i < 3000; i++) {
+    // Jittered periods, value changes in the low, high and all bytes, and a step back in time
+    useconds += 250000 + (i * 7919) % 1000;
+    seconds += useconds / 1000000;
+    useconds %= 1000000;
+    if (i == 1500) {
+      seconds -= 30;
+    }
+    value ^= (i % 3 == 0) ? 0 : ((i % 3 == 1) ? (i & 0xFF) : (static_cast<U64>(i) << 20));
+    written.push_back(sample(seconds, useconds, value, 4));
+    ASSERT_TRUE(store.append(7, written.back()));
+  }
+  // A new value size and a new time context each start a block
+  written.push_back(sample(seconds, useconds, 0x0123456789ABCDEFULL, 8));
+  ASSERT_TRUE(store.append(7, written.back()));
+  written.push_back(sample(seconds + 1, 0, 0x0123456789ABCDEFULL, 8));
+  written.back().timeContext = 3;
+  ASSERT_TRUE(store.append(7, written.back()));
+
+  const std::vector<MathModule::HistoryStore::Sample> samples = readAll(store, 7);
+  ASSERT_EQ(samples.size(), written.size());
+  for (size_t i = 0; i < samples.size(); i++) {
+    SCOPED_TRACE(i);
+    expectSame(samples[i], written[i]);
+  }
+  EXPECT_EQ(store.samples(), written.size());
+  EXPECT_EQ(store.channels(), 1U);
+  EXPECT_TRUE(readAll(store, 8).empty());
+}
+
+TEST(HistoryStore, Wrap) {
+  MathModule::HistoryStore store;
+  ASSERT_EQ(store.open(nullptr, 2), 0);
+  for (U32 i = 0; i < 2000; i++) {
+    ASSERT_TRUE(store.append(1, sample(i, 0, i, 4)));
+  }
+  U64 first = 0;
+  U64 end = 0;
+  ASSERT_TRUE(store.blocks(1, first, end));
+  EXPECT_EQ(end - first, 2U);
+  U8 block[MathModule::HistoryStore::BLOCK_SIZE];
+  EXPECT_FALSE(store.readBlock(1, first - 1, block));
+  EXPECT_FALSE(store.readBlock(1, end, block));
+
+  // The newest samples are kept, contiguous up to the last one
+  const std::vector<MathModule::HistoryStore::Sample> samples = readAll(store, 1);
+  ASSERT_FALSE(samples.empty());
+  EXPECT_EQ(samples.back().seconds, 1999U);
+  for (size_t i = 1; i < samples.size(); i++) {
+    EXPECT_EQ(samples[i].seconds, samples[i - 1].seconds + 1);
+  }
+}
+
+TEST(HistoryStore, Reopen) {
+  const std::string path = storePath("reopen");
+  {
+    MathModule::HistoryStore store;
+    ASSERT_EQ(store.open(path.c_str(), 4), 0);
+    for (U32 i = 0; i < 100; i++) {
+      ASSERT_TRUE(store.append(5, sample(100 + i, 0, i, 2)));
+    }
+  }
+  {
+    // Same layout: the history continues
+    MathModule::HistoryStore store;
+    ASSERT_EQ(store.open(path.c_str(), 4), 0);
+    EXPECT_EQ(store.channels(), 1U);
+    EXPECT_EQ(store.samples(), 100U);
+    ASSERT_TRUE(store.append(5, sample(200, 0, 100, 2)));
+    const std::vector<MathModule::HistoryStore::Sample> samples = readAll(store, 5);
+    ASSERT_EQ(samples.size(), 101U);
+    EXPECT_EQ(samples.back().seconds, 200U);
+    EXPECT_EQ(samples.back().value[1], 100);
+  }
+  {
+    // Another layout: started over
+    MathModule::HistoryStore store;
+    ASSERT_EQ(store.open(path.c_str(), 8), 0);
+    EXPECT_EQ(store.channels(), 0U);
+    EXPECT_TRUE(readAll(store, 5).empty());
+  }
+  (void) ::unlink(path.c_str());
+}
+
+TEST(HistoryStore, Rejected) {
+  MathModule::HistoryStore store;
+  EXPECT_FALSE(store.append(1, sample(0, 0, 0, 4)));
+  ASSERT_EQ(store.open(nullptr, 1), 0);
+  EXPECT_FALSE(store.append(1, sample(0, 0, 0, 0)));
+  MathModule::HistoryStore::Sample tooLong = sample(0, 0, 0, 8);
+  tooLong.valueSize = MathModule::HistoryStore::MAX_VALUE_SIZE + 1;
+  EXPECT_FALSE(store.append(1, tooLong));
+  for (U32 id = 0; id < MathModule::HistoryStore::COLUMNS; id++) {
+    ASSERT_TRUE(store.append(id * 3, sample(0, 0, id, 4)));
+  }
+  EXPECT_FALSE(store.append(1, sample(0, 0, 0, 4)));
+  // Channels with a column are still recorded
+  EXPECT_TRUE(store.append(3, sample(1, 0, 0, 4)));
+  EXPECT_EQ(store.channels(), MathModule::HistoryStore::COLUMNS);
+  EXPECT_EQ(readAll(store, 3).size(), 2U);
+}
+
+TEST(Nominal, Query) {
+  MathModule::TlmHistoryTester tester;
+  tester.testQuery();
+}
+
+TEST(Nominal, Compact) {
+  MathModule::TlmHistoryTester tester;
+  tester.testCompact();
+}
+
+TEST(OffNominal, QueryRejected) {
+  MathModule::TlmHistoryTester tester;
+  tester.testQueryRejected();
+}
+
+TEST(OffNominal, NotRecorded) {
+  MathModule::TlmHistoryTester tester;
+  tester.testNotRecorded();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,224 @@
+// ======================================================================
+// \title  TlmHistoryTester.cpp
+// \author cindy
+// \brief  cpp file for TlmHistory component test harness implementation class
+// ======================================================================
+
+#include "TlmHistoryTester.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace MathModule {
+
+  const U32 TlmHistoryTester::BLOCKS;
+  const FwChanIdType TlmHistoryTester::RESULT_ID;
+  const FwChanIdType TlmHistoryTester::OPERATION_ID;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  TlmHistoryTester ::
+    TlmHistoryTester() :
+      TlmHistoryGTestBase("TlmHistoryTester", TlmHistoryTester::MAX_HISTORY_SIZE),
+      component("TlmHistory"),
+      m_sendStatus(Svc::SendFileStatus::STATUS_OK)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/TlmHistoryTester.%d", static_cast<int>(::getpid()));
+    this->m_prefix = path;
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  TlmHistoryTester ::
+    ~TlmHistoryTester()
+  {
+    for (const std::string& file : this->m_sentFiles) {
+      (void) ::unlink(file.c_str());
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void TlmHistoryTester ::
+    testQuery()
+  {
+    this->configure();
+    ASSERT_EVENTS_HISTORY_OPENED(0, 0, BLOCKS);
+    // Two channels updated each second at 100..139 s
+    for (U32 i = 0; i < 40; i++) {
+      this->writeF32(RESULT_ID, 100 + i, 1000 * i, 0.5f * static_cast<F32>(i));
+      this->writeU32(OPERATION_ID, 100 + i, 1000 * i + 7, i % 4);
+    }
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_SAMPLES_RECORDED(0, 80);
+    ASSERT_TLM_SAMPLES_DROPPED(0, 0);
+    ASSERT_TLM_CHANNELS_RECORDED(0, 2);
+
+    this->query(RESULT_ID, 110, 119);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, TlmHistory::OPCODE_QUERY, 5, Fw::CmdResponse::OK);
+    const std::string file = this->m_prefix + "_3587_110_119.bin";
+    ASSERT_EQ(this->m_sentFiles.size(), 1U);
+    EXPECT_EQ(this->m_sentFiles[0], file);
+    ASSERT_EVENTS_QUERY_EXTRACTED_SIZE(1);
+    ASSERT_EVENTS_QUERY_EXTRACTED(0, 10, file.c_str());
+
+    std::ifstream stream(file, std::ios::binary);
+    std::vector<U8> contents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    Fw::ExternalSerializeBuffer reader(contents.data(), static_cast<NATIVE_UINT_TYPE>(contents.size()));
+    ASSERT_EQ(reader.setBuffLen(static_cast<NATIVE_UINT_TYPE>(contents.size())), Fw::FW_SERIALIZE_OK);
+    U32 magic = 0;
+    U32 channel = 0;
+    U32 start = 0;
+    U32 end = 0;
+    ASSERT_EQ(reader.deserialize(magic), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(reader.deserialize(channel), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(reader.deserialize(start), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(reader.deserialize(end), Fw::FW_SERIALIZE_OK);
+    EXPECT_EQ(magic, TlmHistory::QUERY_FILE_MAGIC);
+    EXPECT_EQ(channel, RESULT_ID);
+    EXPECT_EQ(start, 110U);
+    EXPECT_EQ(end, 119U);
+    for (U32 i = 10; i < 20; i++) {
+      Fw::Time time;
+      U8 size = 0;
+      F32 value = 0.0f;
+      ASSERT_EQ(reader.deserialize(time), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(reader.deserialize(size), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(size, sizeof(F32));
+      ASSERT_EQ(reader.deserialize(value), Fw::FW_SERIALIZE_OK);
+      EXPECT_EQ(time.getTimeBase(), TB_WORKSTATION_TIME);
+      EXPECT_EQ(time.getSeconds(), 100 + i);
+      EXPECT_EQ(time.getUSeconds(), 1000 * i);
+      EXPECT_EQ(value, 0.5f * static_cast<F32>(i));
+    }
+    EXPECT_EQ(reader.getBuffLeft(), 0U);
+  }
+
+  void TlmHistoryTester ::
+    testCompact()
+  {
+    this->configure();
+    // Fewer samples than the column keeps, so every one is queryable
+    const U32 samples = 900;
+    for (U32 i = 0; i < samples; i++) {
+      this->writeF32(RESULT_ID, 1000 + i, 0, 3.0f);
+    }
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_SAMPLES_RECORDED(0, samples);
+    ASSERT_TLM_BYTES_PER_SAMPLE_SIZE(1);
+    EXPECT_LT(this->tlmHistory_BYTES_PER_SAMPLE->at(0).arg, 2.2f);
+    EXPECT_GE(this->tlmHistory_BYTES_PER_SAMPLE->at(0).arg, 2.0f);
+
+    this->query(RESULT_ID, 0, 0xFFFFFFFF);
+    ASSERT_CMD_RESPONSE(0, TlmHistory::OPCODE_QUERY, 5, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_QUERY_EXTRACTED_SIZE(1);
+    ASSERT_EVENTS_QUERY_EXTRACTED(0, samples, (this->m_prefix + "_3587_0_4294967295.bin").c_str());
+  }
+
+  void TlmHistoryTester ::
+    testQueryRejected()
+  {
+    this->configure();
+    this->writeF32(RESULT_ID, 100, 0, 1.0f);
+    this->m_sendStatus = Svc::SendFileStatus::STATUS_BUSY;
+    this->query(RESULT_ID, 0, 200);
+    ASSERT_CMD_RESPONSE(0, TlmHistory::OPCODE_QUERY, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_QUERY_DOWNLINK_REJECTED_SIZE(1);
+    ASSERT_EVENTS_QUERY_DOWNLINK_REJECTED(0, Svc::SendFileStatus::STATUS_BUSY);
+    ASSERT_EVENTS_QUERY_EXTRACTED_SIZE(0);
+  }
+
+  void TlmHistoryTester ::
+    testNotRecorded()
+  {
+    // Before the store is set up
+    this->writeF32(RESULT_ID, 100, 0, 1.0f);
+    this->configure();
+    // Longer than any recorded value
+    Fw::TlmBuffer text;
+    for (U32 b = 0; b < HistoryStore::MAX_VALUE_SIZE + 1; b++) {
+      ASSERT_EQ(text.serialize(static_cast<U8>('a' + b)), Fw::FW_SERIALIZE_OK);
+    }
+    Fw::Time time(TB_WORKSTATION_TIME, 0, 101, 0);
+    this->invoke_to_TlmRecv(0, 0x4A00, time, text);
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_SAMPLES_RECORDED(0, 0);
+    ASSERT_TLM_SAMPLES_DROPPED(0, 2);
+    ASSERT_TLM_CHANNELS_RECORDED(0, 0);
+
+    this->query(RESULT_ID, 0, 200);
+    ASSERT_CMD_RESPONSE(0, TlmHistory::OPCODE_QUERY, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_CHANNEL_NOT_RECORDED_SIZE(1);
+    ASSERT_EVENTS_CHANNEL_NOT_RECORDED(0, RESULT_ID);
+
+    this->query(RESULT_ID, 200, 100);
+    ASSERT_CMD_RESPONSE(0, TlmHistory::OPCODE_QUERY, 5, Fw::CmdResponse::VALIDATION_ERROR);
+    EXPECT_TRUE(this->m_sentFiles.empty());
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Svc::SendFileResponse TlmHistoryTester ::
+    from_sendFile_handler(
+        NATIVE_INT_TYPE portNum,
+        const Fw::StringBase& fileNameFrom,
+        const Fw::StringBase& fileNameTo,
+        U32 offset,
+        U32 length
+    )
+  {
+    this->m_sentFiles.push_back(fileNameFrom.toChar());
+    EXPECT_EQ(fileNameTo, fileNameFrom);
+    EXPECT_EQ(offset, 0U);
+    EXPECT_EQ(length, 0U);
+    return Svc::SendFileResponse(this->m_sendStatus, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void TlmHistoryTester ::
+    configure()
+  {
+    this->component.configure(nullptr, BLOCKS, this->m_prefix.c_str());
+  }
+
+  void TlmHistoryTester ::
+    writeF32(FwChanIdType id, U32 seconds, U32 useconds, F32 value)
+  {
+    Fw::Time time(TB_WORKSTATION_TIME, 0, seconds, useconds);
+    Fw::TlmBuffer val;
+    ASSERT_EQ(val.serialize(value), Fw::FW_SERIALIZE_OK);
+    this->invoke_to_TlmRecv(0, id, time, val);
+  }
+
+  void TlmHistoryTester ::
+    writeU32(FwChanIdType id, U32 seconds, U32 useconds, U32 value)
+  {
+    Fw::Time time(TB_WORKSTATION_TIME, 0, seconds, useconds);
+    Fw::TlmBuffer val;
+    ASSERT_EQ(val.serialize(value), Fw::FW_SERIALIZE_OK);
+    this->invoke_to_TlmRecv(0, id, time, val);
+  }
+
+  void TlmHistoryTester ::
+    query(U32 channel, U32 start, U32 end)
+  {
+    this->clearHistory();
+    this->sendCmd_QUERY(0, 5, channel, start, end);
+    this->component.doDispatch();
+  }
+
+}
@@ -0,0 +1,137 @@
+// ======================================================================
+// \title  TlmHistoryTester.hpp
+// \author cindy
+// \brief  hpp file for TlmHistory component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_TlmHistoryTester_HPP
+#define MathModule_TlmHistoryTester_HPP
+
+#include "TlmHistoryGTestBase.hpp"
+#include "Components/TlmHistory/TlmHistory.hpp"
+
+#include <string>
+#include <vector>
+
+namespace MathModule {
+
+  class TlmHistoryTester :
+    public TlmHistoryGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Blocks per channel in the test store
+      static const U32 BLOCKS = 4;
+
+      //! The recorded F32 channel, as mathSender.RESULT
+      static const FwChanIdType RESULT_ID = 0x0E03;
+
+      //! The recorded U32 channel, as mathReceiver.OPERATION
+      static const FwChanIdType OPERATION_ID = 0x2700;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object TlmHistoryTester
+      TlmHistoryTester();
+
+      //! Destroy object TlmHistoryTester, removing its files
+      ~TlmHistoryTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! The samples of one channel within a range are written to a file and handed to file downlink
+      void testQuery();
+
+      //! A channel updated on a period with an unchanged value costs about two bytes a sample
+      void testCompact();
+
+      //! A query file file downlink does not accept fails the command
+      void testQueryRejected();
+
+      //! Updates that cannot be recorded are counted, and queries of unrecorded channels fail
+      void testNotRecorded();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for sendFile
+      Svc::SendFileResponse from_sendFile_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          const Fw::StringBase& fileNameFrom, //!< Path of file to downlink
+          const Fw::StringBase& fileNameTo, //!< Path to store downlinked file at
+          U32 offset, //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+          U32 length //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Set up the test store in memory
+      void configure();
+
+      //! Send an F32 channel update
+      void writeF32(FwChanIdType id, U32 seconds, U32 useconds, F32 value);
+
+      //! Send a U32 channel update
+      void writeU32(FwChanIdType id, U32 seconds, U32 useconds, U32 value);
+
+      //! Send QUERY and let the component run it
+      void query(U32 channel, U32 start, U32 end);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      TlmHistory component;
+
+      //! Query file prefix
+      std::string m_prefix;
+
+      //! Answer of the sendFile port
+      Svc::SendFileStatus m_sendStatus;
+
+      //! Files handed to sendFile
+      std::vector<std::string> m_sentFiles;
+
+  };
+
+}
+
+#endif
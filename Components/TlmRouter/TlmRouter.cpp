@@ -0,0 +1,72 @@
+// ======================================================================
+// \title  TlmRouter.cpp
+// \author cindy
+// \brief  cpp file for TlmRouter component implementation class
+// ======================================================================
+
+#include "Components/TlmRouter/TlmRouter.hpp"
+#include "Components/Tracer/Trace.hpp"
+#include <Fw/Types/Assert.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  TlmRouter ::
+    TlmRouter(const char* const compName) :
+      TlmRouterComponentBase(compName),
+      m_backend(TlmBackend::CHANNELIZED)
+  {
+
+  }
+
+  TlmRouter ::
+    ~TlmRouter()
+  {
+
+  }
+
+  void TlmRouter ::
+    setBackend(const TlmBackend& backend)
+  {
+    FW_ASSERT(backend.isValid(), backend.e);
+    this->m_backend = backend;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    TlmRecv_handler forwards the update to the selected backend only, so the
+    idle backend never stores or downlinks anything. The history, when
+    connected, records every update regardless of the backend.
+  */
+  void TlmRouter ::
+    TlmRecv_handler(
+        const NATIVE_INT_TYPE portNum,
+        FwChanIdType id,
+        Fw::Time& timeTag,
+        Fw::TlmBuffer& val
+    )
+  {
+    MATH_TRACE_SCOPE("tlmRouter.TlmRecv");
+    if (this->isConnected_historyTlmOut_OutputPort(0)) {
+      this->historyTlmOut_out(0, id, timeTag, val);
+    }
+    switch (this->m_backend.e) {
+      case TlmBackend::PACKETIZED:
+        this->packetTlmOut_out(0, id, timeTag, val);
+        break;
+      case TlmBackend::COMPACT:
+        this->compactTlmOut_out(0, id, timeTag, val);
+        break;
+      default:
+        this->chanTlmOut_out(0, id, timeTag, val);
+        break;
+    }
+  }
+
+}
@@ -0,0 +1,68 @@
+// ======================================================================
+// \title  TlmRouter.hpp
+// \author cindy
+// \brief  hpp file for TlmRouter component implementation class
+// ======================================================================
+
+#ifndef MathModule_TlmRouter_HPP
+#define MathModule_TlmRouter_HPP
+
+#include "Components/TlmRouter/TlmRouterComponentAc.hpp"
+
+namespace MathModule {
+
+  class TlmRouter :
+    public TlmRouterComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct TlmRouter object
+      TlmRouter(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy TlmRouter object
+      ~TlmRouter();
+
+      //! Select the backend receiving channel updates
+      //!
+      //! Call during configuration, before any component task is started.
+      void setBackend(
+          const TlmBackend& backend //!< The backend to route to
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for TlmRecv
+      //!
+      //! Telemetry input, target of the telemetry connection pattern
+      void TlmRecv_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          FwChanIdType id, //!< Telemetry Channel ID
+          Fw::Time& timeTag, //!< Time Tag
+          Fw::TlmBuffer& val //!< Buffer containing serialized telemetry value
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The selected backend
+      TlmBackend m_backend;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,37 @@
+// ======================================================================
+// \title  TlmRouterTestMain.cpp
+// \author cindy
+// \brief  cpp file for TlmRouter component test main function
+// ======================================================================
+
+#include "TlmRouterTester.hpp"
+
+TEST(Nominal, Default) {
+  MathModule::TlmRouterTester tester;
+  tester.testDefault();
+}
+
+TEST(Nominal, Channelized) {
+  MathModule::TlmRouterTester tester;
+  tester.testBackend(MathModule::TlmBackend::CHANNELIZED);
+}
+
+TEST(Nominal, Packetized) {
+  MathModule::TlmRouterTester tester;
+  tester.testBackend(MathModule::TlmBackend::PACKETIZED);
+}
+
+TEST(Nominal, Compact) {
+  MathModule::TlmRouterTester tester;
+  tester.testBackend(MathModule::TlmBackend::COMPACT);
+}
+
+TEST(Nominal, Reselect) {
+  MathModule::TlmRouterTester tester;
+  tester.testReselect();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
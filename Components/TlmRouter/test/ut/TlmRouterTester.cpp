@@ -0,0 +1,101 @@
+// ======================================================================
+// \title  TlmRouterTester.cpp
+// \author cindy
+// \brief  cpp file for TlmRouter component test harness implementation class
+// ======================================================================
+
+#include "TlmRouterTester.hpp"
+
+namespace MathModule {
+
+  const U32 TlmRouterTester::UPDATES;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  TlmRouterTester ::
+    TlmRouterTester() :
+      TlmRouterGTestBase("TlmRouterTester", TlmRouterTester::MAX_HISTORY_SIZE),
+      component("TlmRouter")
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  TlmRouterTester ::
+    ~TlmRouterTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void TlmRouterTester ::
+    testDefault()
+  {
+    this->sendAndCheck(TlmBackend::CHANNELIZED);
+  }
+
+  void TlmRouterTester ::
+    testBackend(const TlmBackend& backend)
+  {
+    this->component.setBackend(backend);
+    this->sendAndCheck(backend);
+  }
+
+  void TlmRouterTester ::
+    testReselect()
+  {
+    this->component.setBackend(TlmBackend::COMPACT);
+    this->sendAndCheck(TlmBackend::COMPACT);
+    this->clearHistory();
+    this->component.setBackend(TlmBackend::PACKETIZED);
+    this->sendAndCheck(TlmBackend::PACKETIZED);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void TlmRouterTester ::
+    sendAndCheck(const TlmBackend& backend)
+  {
+    for (U32 i = 0; i < UPDATES; i++) {
+      Fw::Time timeTag(TB_NONE, 100 + i, 10 * i);
+      Fw::TlmBuffer val;
+      ASSERT_EQ(val.serialize(0xC0DE0000 + i), Fw::FW_SERIALIZE_OK);
+      this->invoke_to_TlmRecv(0, 0x2000 + i, timeTag, val);
+    }
+
+    // The selected backend gets every update unchanged; the idle ones get none
+    const U32 chan = (backend == TlmBackend::CHANNELIZED) ? UPDATES : 0;
+    const U32 packet = (backend == TlmBackend::PACKETIZED) ? UPDATES : 0;
+    const U32 compact = (backend == TlmBackend::COMPACT) ? UPDATES : 0;
+    ASSERT_from_chanTlmOut_SIZE(chan);
+    ASSERT_from_packetTlmOut_SIZE(packet);
+    ASSERT_from_compactTlmOut_SIZE(compact);
+    ASSERT_from_historyTlmOut_SIZE(UPDATES);
+    for (U32 i = 0; i < UPDATES; i++) {
+      Fw::Time timeTag(TB_NONE, 100 + i, 10 * i);
+      Fw::TlmBuffer val;
+      ASSERT_EQ(val.serialize(0xC0DE0000 + i), Fw::FW_SERIALIZE_OK);
+      switch (backend.e) {
+        case TlmBackend::PACKETIZED:
+          ASSERT_from_packetTlmOut(i, 0x2000 + i, timeTag, val);
+          break;
+        case TlmBackend::COMPACT:
+          ASSERT_from_compactTlmOut(i, 0x2000 + i, timeTag, val);
+          break;
+        default:
+          ASSERT_from_chanTlmOut(i, 0x2000 + i, timeTag, val);
+          break;
+      }
+      // The history records every update whichever backend is selected
+      ASSERT_from_historyTlmOut(i, 0x2000 + i, timeTag, val);
+    }
+  }
+
+}
@@ -0,0 +1,96 @@
+// ======================================================================
+// \title  TlmRouterTester.hpp
+// \author cindy
+// \brief  hpp file for TlmRouter component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_TlmRouterTester_HPP
+#define MathModule_TlmRouterTester_HPP
+
+#include "TlmRouterGTestBase.hpp"
+#include "Components/TlmRouter/TlmRouter.hpp"
+
+namespace MathModule {
+
+  class TlmRouterTester :
+    public TlmRouterGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Channel updates sent per test
+      static const U32 UPDATES = 5;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object TlmRouterTester
+      TlmRouterTester();
+
+      //! Destroy object TlmRouterTester
+      ~TlmRouterTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Without a selection every update goes to the channelized backend
+      void testDefault();
+
+      //! Every update goes to the selected backend only, and to the history
+      void testBackend(
+          const TlmBackend& backend //!< The backend to select
+      );
+
+      //! A new selection moves later updates to the new backend
+      void testReselect();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Send UPDATES channel updates and check where they were routed
+      void sendAndCheck(
+          const TlmBackend& backend //!< The backend expected to receive them
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      TlmRouter component;
+
+  };
+
+}
+
+#endif
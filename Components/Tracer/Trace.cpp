@@ -0,0 +1,293 @@
+// ======================================================================
+// \title  Trace.cpp
+// \author cindy
+// \brief  Per-thread lock-free trace buffers and their Chrome trace JSON export
+// ======================================================================
+
+#include "Components/Tracer/Trace.hpp"
+
+#if MATH_TRACE
+
+#include <Fw/Types/Assert.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace Trace {
+
+    namespace {
+
+      //! The events of one thread. Only that thread writes it.
+      struct ThreadBuffer {
+        Event events[THREAD_EVENTS];
+        std::atomic<U64> written; //!< Events recorded; the newest is at (written - 1) % THREAD_EVENTS
+        U32 tid;
+        char name[16];
+        ThreadBuffer* next;
+      };
+
+      //! Enqueue and dispatch counts of one queue
+      struct Queue {
+        std::atomic<const char*> name;
+        std::atomic<U32> enqueued;
+        std::atomic<U32> dispatched;
+      };
+
+      //! Every thread's buffer, newest first. Buffers are never freed, so events outlive their thread.
+      std::atomic<ThreadBuffer*> s_threads(nullptr);
+
+      thread_local ThreadBuffer* t_buffer = nullptr;
+
+      Queue s_queues[MAX_QUEUES];
+
+      //! JSON staged for one write
+      const U32 STAGING_SIZE = 64 * 1024;
+
+      //! Longest JSON of one event
+      const U32 MAX_EVENT_JSON = 256;
+
+      /*
+        The buffer is set up on the thread's first event. pthread_getname_np
+        gives the name Os::Task set, or the process name for the main thread.
+      */
+      ThreadBuffer* threadBuffer()
+      {
+        if (t_buffer == nullptr) {
+          ThreadBuffer* buffer = new ThreadBuffer();
+          buffer->written.store(0, std::memory_order_relaxed);
+          buffer->tid = static_cast<U32>(::syscall(SYS_gettid));
+          if (::pthread_getname_np(::pthread_self(), buffer->name, sizeof(buffer->name)) != 0) {
+            buffer->name[0] = '\0';
+          }
+          ThreadBuffer* head = s_threads.load(std::memory_order_relaxed);
+          do {
+            buffer->next = head;
+          } while (!s_threads.compare_exchange_weak(head, buffer, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+          t_buffer = buffer;
+        }
+        return t_buffer;
+      }
+
+      /*
+        Queues are found by the contents of their name, since each translation
+        unit may have its own copy of the literal. Ids carry the queue's slot
+        in the top byte so flows of different queues never share an id.
+      */
+      Queue& queueOf(const char* name)
+      {
+        U32 hash = 2166136261U;
+        for (const char* c = name; *c != '\0'; c++) {
+          hash = (hash ^ static_cast<U8>(*c)) * 16777619U;
+        }
+        for (U32 probe = 0; probe < MAX_QUEUES; probe++) {
+          Queue& queue = s_queues[(hash + probe) % MAX_QUEUES];
+          const char* current = queue.name.load(std::memory_order_acquire);
+          if (current == nullptr) {
+            const char* expected = nullptr;
+            if (queue.name.compare_exchange_strong(expected, name, std::memory_order_acq_rel)) {
+              return queue;
+            }
+            current = expected;
+          }
+          if (::strcmp(current, name) == 0) {
+            return queue;
+          }
+        }
+        FW_ASSERT(0, MAX_QUEUES);
+        return s_queues[0];
+      }
+
+      U32 flowId(const Queue& queue, U32 count)
+      {
+        return (static_cast<U32>(&queue - s_queues) << 24) | (count & 0xFFFFFFU);
+      }
+
+      //! Write the staged JSON and empty the staging buffer
+      //! \return 0, or the errno value of the failed write
+      I32 flush(int fd, const char* data, U32& size)
+      {
+        size_t remaining = size;
+        while (remaining > 0) {
+          const ssize_t written = ::write(fd, data, remaining);
+          if (written < 0) {
+            if (errno == EINTR) {
+              continue;
+            }
+            return errno;
+          }
+          data += written;
+          remaining -= static_cast<size_t>(written);
+        }
+        size = 0;
+        return 0;
+      }
+
+      //! Copy a thread name into JSON, replacing what would need escaping
+      void jsonName(const char* name, U32 tid, char* out, U32 size)
+      {
+        if (name[0] == '\0') {
+          (void) ::snprintf(out, size, "thread %u", tid);
+          return;
+        }
+        U32 i = 0;
+        for (; (name[i] != '\0') && (i + 1 < size); i++) {
+          const char c = name[i];
+          out[i] = ((c == '"') || (c == '\\') || (static_cast<U8>(c) < 0x20)) ? '_' : c;
+        }
+        out[i] = '\0';
+      }
+
+      //! Format one event
+      //! \return the JSON length
+      int formatEvent(char* out, const Event& event, int pid, U32 tid)
+      {
+        const unsigned long long startUsec = event.startNsec / 1000U;
+        const unsigned startFraction = static_cast<unsigned>(event.startNsec % 1000U);
+        switch (event.phase) {
+          case SLICE:
+            return ::snprintf(out, MAX_EVENT_JSON,
+                              ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%llu.%03u,\"dur\":%llu.%03u}",
+                              event.name, pid, tid, startUsec, startFraction,
+                              static_cast<unsigned long long>(event.durationNsec / 1000U),
+                              static_cast<unsigned>(event.durationNsec % 1000U));
+          case FLOW_BEGIN:
+            return ::snprintf(out, MAX_EVENT_JSON,
+                              ",\n{\"name\":\"%s\",\"cat\":\"flow\",\"ph\":\"s\",\"id\":%u,\"pid\":%d,\"tid\":%u,"
+                              "\"ts\":%llu.%03u}",
+                              event.name, event.id, pid, tid, startUsec, startFraction);
+          default:
+            return ::snprintf(out, MAX_EVENT_JSON,
+                              ",\n{\"name\":\"%s\",\"cat\":\"flow\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%u,\"pid\":%d,"
+                              "\"tid\":%u,\"ts\":%llu.%03u}",
+                              event.name, event.id, pid, tid, startUsec, startFraction);
+        }
+      }
+
+    }
+
+    U64 nowNsec()
+    {
+      struct timespec now;
+      (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+      return static_cast<U64>(now.tv_sec) * 1000000000U + static_cast<U64>(now.tv_nsec);
+    }
+
+    /*
+      The event is filled in before the count is published, so a dump that
+      reads the count with acquire sees complete events up to it.
+    */
+    void record(Phase phase, const char* name, U64 startNsec, U64 durationNsec, U32 id)
+    {
+      ThreadBuffer* buffer = threadBuffer();
+      const U64 index = buffer->written.load(std::memory_order_relaxed);
+      Event& event = buffer->events[index % THREAD_EVENTS];
+      event.startNsec = startNsec;
+      event.durationNsec = durationNsec;
+      event.name = name;
+      event.id = id;
+      event.phase = phase;
+      buffer->written.store(index + 1, std::memory_order_release);
+    }
+
+    void enqueue(const char* queue)
+    {
+      Queue& counts = queueOf(queue);
+      const U32 count = counts.enqueued.fetch_add(1, std::memory_order_relaxed);
+      record(FLOW_BEGIN, queue, nowNsec(), 0, flowId(counts, count));
+    }
+
+    void dispatch(const char* queue)
+    {
+      Queue& counts = queueOf(queue);
+      const U32 count = counts.dispatched.fetch_add(1, std::memory_order_relaxed);
+      record(FLOW_END, queue, nowNsec(), 0, flowId(counts, count));
+    }
+
+    /*
+      Threads keep recording during the dump. A thread's events are copied
+      out and its count is read again afterwards: events the thread may have
+      overwritten meanwhile, including the one it is writing, are dropped.
+    */
+    I32 writeChromeJson(const char* path, DumpStats& stats)
+    {
+      stats.threads = 0;
+      stats.events = 0;
+      stats.lost = 0;
+      const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0) {
+        return errno;
+      }
+      const int pid = static_cast<int>(::getpid());
+      Event* copy = new Event[THREAD_EVENTS];
+      char* staging = new char[STAGING_SIZE];
+      U32 staged = static_cast<U32>(::snprintf(staging, STAGING_SIZE,
+                                               "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                                               "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                                               "\"args\":{\"name\":\"MathDeployment\"}}", pid));
+      I32 error = 0;
+      for (ThreadBuffer* buffer = s_threads.load(std::memory_order_acquire);
+           (buffer != nullptr) && (error == 0); buffer = buffer->next) {
+        const U64 end = buffer->written.load(std::memory_order_acquire);
+        U64 begin = (end > THREAD_EVENTS) ? end - THREAD_EVENTS : 0;
+        for (U64 index = begin; index < end; index++) {
+          copy[index - begin] = buffer->events[index % THREAD_EVENTS];
+        }
+        const U64 after = buffer->written.load(std::memory_order_acquire);
+        const U64 copied = begin;
+        if (after + 1 > THREAD_EVENTS + begin) {
+          begin = after + 1 - THREAD_EVENTS;
+        }
+        stats.threads++;
+        stats.lost += begin;
+
+        char name[sizeof(buffer->name) + 16];
+        jsonName(buffer->name, buffer->tid, name, sizeof(name));
+        if (staged + MAX_EVENT_JSON > STAGING_SIZE) {
+          error = flush(fd, staging, staged);
+          if (error != 0) {
+            break;
+          }
+        }
+        staged += static_cast<U32>(::snprintf(staging + staged, MAX_EVENT_JSON,
+                                              ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,"
+                                              "\"args\":{\"name\":\"%s\"}}", pid, buffer->tid, name));
+        for (U64 index = begin; index < end; index++) {
+          if (staged + MAX_EVENT_JSON > STAGING_SIZE) {
+            error = flush(fd, staging, staged);
+            if (error != 0) {
+              break;
+            }
+          }
+          const int length = formatEvent(staging + staged, copy[index - copied], pid, buffer->tid);
+          FW_ASSERT(length > 0 && static_cast<U32>(length) < MAX_EVENT_JSON, length);
+          staged += static_cast<U32>(length);
+          stats.events++;
+        }
+      }
+      if (error == 0) {
+        staged += static_cast<U32>(::snprintf(staging + staged, STAGING_SIZE - staged, "\n]}\n"));
+        error = flush(fd, staging, staged);
+      }
+      delete[] staging;
+      delete[] copy;
+      if ((::close(fd) != 0) && (error == 0)) {
+        error = errno;
+      }
+      return error;
+    }
+
+  }
+
+}
+
+#endif
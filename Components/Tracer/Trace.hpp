@@ -0,0 +1,118 @@
+// ======================================================================
+// \title  Trace.hpp
+// \author cindy
+// \brief  Per-thread lock-free trace buffers and the macros that fill them
+// ======================================================================
+
+#ifndef MathModule_Trace_HPP
+#define MathModule_Trace_HPP
+
+#include <FpConfig.hpp>
+
+//! Set to 1 by the MATH_TRACE CMake option. At 0 the macros expand to nothing.
+#ifndef MATH_TRACE
+#define MATH_TRACE 0
+#endif
+
+namespace MathModule {
+
+  namespace Trace {
+
+    //! Events kept per thread; a thread's oldest events are overwritten
+    const U32 THREAD_EVENTS = 8192;
+
+    //! Queues whose enqueue and dispatch are paired
+    const U32 MAX_QUEUES = 32;
+
+    //! Kind of a trace event
+    enum Phase {
+      SLICE, //!< A call, from its start for its duration
+      FLOW_BEGIN, //!< A message leaving for another thread
+      FLOW_END //!< The message arriving
+    };
+
+    //! A recorded event. Names are string literals and are not copied.
+    struct Event {
+      U64 startNsec;
+      U64 durationNsec;
+      const char* name;
+      U32 id;
+      U32 phase;
+    };
+
+    //! Result of a dump
+    struct DumpStats {
+      U32 threads; //!< Threads that recorded events
+      U64 events; //!< Events written
+      U64 lost; //!< Events overwritten before the dump
+    };
+
+    //! Monotonic time, nanoseconds
+    U64 nowNsec();
+
+    //! Append an event to the calling thread's buffer, without locking
+    void record(
+        Phase phase, //!< The kind of event
+        const char* name, //!< The event name, a string literal
+        U64 startNsec, //!< Start time
+        U64 durationNsec, //!< Duration, for SLICE
+        U32 id //!< Flow id, for FLOW_BEGIN and FLOW_END
+    );
+
+    //! Record the flow of a message into a FIFO queue, numbered by its position in the queue
+    void enqueue(
+        const char* queue //!< The queue name, the same at both ends
+    );
+
+    //! Record the flow of the next message out of a FIFO queue
+    void dispatch(
+        const char* queue //!< The queue name, the same at both ends
+    );
+
+    //! Write the buffered events of every thread as Chrome trace JSON, which Perfetto also opens
+    //! \return 0, or the errno value of the failed open or write
+    I32 writeChromeJson(
+        const char* path, //!< The file to write
+        DumpStats& stats //!< Set to what was written
+    );
+
+    //! Records a SLICE covering its lifetime
+    class Scope {
+      public:
+        explicit Scope(const char* name) : m_name(name), m_start(nowNsec()) {}
+        ~Scope() { record(SLICE, this->m_name, this->m_start, nowNsec() - this->m_start, 0); }
+      private:
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+        const char* const m_name;
+        const U64 m_start;
+    };
+
+  }
+
+}
+
+#if MATH_TRACE
+#define MATH_TRACE_PASTE_(a, b) a##b
+#define MATH_TRACE_PASTE(a, b) MATH_TRACE_PASTE_(a, b)
+//! Record the enclosing block as a slice
+#define MATH_TRACE_SCOPE(name) ::MathModule::Trace::Scope MATH_TRACE_PASTE(mathTraceScope, __LINE__)(name)
+//! Record a message with a known id leaving for another thread
+#define MATH_TRACE_FLOW_BEGIN(name, id) \
+  ::MathModule::Trace::record(::MathModule::Trace::FLOW_BEGIN, name, ::MathModule::Trace::nowNsec(), 0, id)
+//! Record the message with that id arriving
+#define MATH_TRACE_FLOW_END(name, id) \
+  ::MathModule::Trace::record(::MathModule::Trace::FLOW_END, name, ::MathModule::Trace::nowNsec(), 0, id)
+//! Record a message entering a FIFO queue, at the caller of an async port
+#define MATH_TRACE_ENQUEUE(queue) ::MathModule::Trace::enqueue(queue)
+//! Record the next message leaving a FIFO queue, at the top of its handler
+#define MATH_TRACE_DISPATCH(queue) ::MathModule::Trace::dispatch(queue)
+#else
+#define MATH_TRACE_SCOPE(name)
+#define MATH_TRACE_FLOW_BEGIN(name, id)
+#define MATH_TRACE_FLOW_END(name, id)
+#define MATH_TRACE_ENQUEUE(queue)
+#define MATH_TRACE_DISPATCH(queue)
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+// ======================================================================
+// \title  Tracer.cpp
+// \author cindy
+// \brief  cpp file for Tracer component implementation class
+// ======================================================================
+
+#include "Components/Tracer/Tracer.hpp"
+#include <Fw/Types/Assert.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  Tracer ::
+    Tracer(const char* const compName) :
+      TracerComponentBase(compName),
+      m_file("Trace.json")
+  {
+
+  }
+
+  Tracer ::
+    ~Tracer()
+  {
+
+  }
+
+  void Tracer ::
+    configure(const char* file)
+  {
+    FW_ASSERT(file != nullptr);
+    this->m_file = file;
+  }
+
+  I32 Tracer ::
+    dumpAtShutdown()
+  {
+#if MATH_TRACE
+    Trace::DumpStats stats;
+    return Trace::writeChromeJson(this->m_file.toChar(), stats);
+#else
+    return 0;
+#endif
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  /*
+    The dump runs on this component's thread, so the threads being traced
+    only lose the events they overwrite while it copies their buffers.
+  */
+  void Tracer ::
+    DUMP_TRACE_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+#if MATH_TRACE
+    Trace::DumpStats stats;
+    const I32 error = Trace::writeChromeJson(this->m_file.toChar(), stats);
+    if (error != 0) {
+      this->log_WARNING_HI_TRACE_WRITE_ERROR(error);
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    const Svc::SendFileResponse response = this->sendFile_out(0, this->m_file, this->m_file, 0, 0);
+    if (response.getstatus() != Svc::SendFileStatus::STATUS_OK) {
+      this->log_WARNING_HI_TRACE_DOWNLINK_REJECTED(response.getstatus());
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
+    Fw::LogStringArg fileArg(this->m_file.toChar());
+    this->log_ACTIVITY_HI_TRACE_DUMPED(stats.events, stats.lost, stats.threads, fileArg);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+#else
+    this->log_WARNING_LO_TRACING_DISABLED();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+#endif
+  }
+
+}
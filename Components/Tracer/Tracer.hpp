@@ -0,0 +1,68 @@
+// ======================================================================
+// \title  Tracer.hpp
+// \author cindy
+// \brief  hpp file for Tracer component implementation class
+// ======================================================================
+
+#ifndef MathModule_Tracer_HPP
+#define MathModule_Tracer_HPP
+
+#include "Components/Tracer/TracerComponentAc.hpp"
+#include "Components/Tracer/Trace.hpp"
+#include <Fw/Types/String.hpp>
+
+namespace MathModule {
+
+  class Tracer :
+    public TracerComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct Tracer object
+      Tracer(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy Tracer object
+      ~Tracer();
+
+      //! Set the trace file
+      void configure(
+          const char* file //!< Path of the trace file, rewritten by each dump
+      );
+
+      //! Write the trace file without events or downlink, for topology teardown after the tasks stopped
+      //! \return 0, or the errno value of the failed write
+      I32 dumpAtShutdown();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command DUMP_TRACE
+      void DUMP_TRACE_cmdHandler(
+          const FwOpcodeType opCode, //!< The opcode
+          const U32 cmdSeq //!< The command sequence number
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Path of the trace file
+      Fw::String m_file;
+
+  };
+
+}
+
+#endif
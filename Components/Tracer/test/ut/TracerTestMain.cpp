@@ -0,0 +1,145 @@
+// ======================================================================
+// \title  TracerTestMain.cpp
+// \author cindy
+// \brief  cpp file for Tracer component test main function
+// ======================================================================
+
+#include "TracerTester.hpp"
+
+#if MATH_TRACE
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+  std::string tracePath(const char* name)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/Trace.%s.%d.json", name, static_cast<int>(::getpid()));
+    return path;
+  }
+
+  std::string readFile(const std::string& path)
+  {
+    std::ifstream stream(path);
+    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  }
+
+  //! Values of a numeric field in every event of one name and phase
+  std::vector<unsigned long> fieldOf(const std::string& json, const std::string& name, const char* phase,
+                                     const char* field)
+  {
+    std::vector<unsigned long> values;
+    const std::string prefix = "{\"name\":\"" + name + "\"";
+    const std::string phaseText = std::string("\"ph\":\"") + phase + "\"";
+    const std::string fieldText = std::string("\"") + field + "\":";
+    for (size_t at = json.find(prefix); at != std::string::npos; at = json.find(prefix, at + 1)) {
+      const std::string event = json.substr(at, json.find('}', at) - at);
+      const size_t value = event.find(fieldText);
+      if ((event.find(phaseText) != std::string::npos) && (value != std::string::npos)) {
+        values.push_back(std::stoul(event.substr(value + fieldText.size())));
+      }
+    }
+    return values;
+  }
+
+}
+
+TEST(Trace, ChromeJson) {
+  // Two threads pass messages through a queue each way, as a sender and receiver do
+  const U32 messages = 100;
+  std::thread receiver([messages]() {
+    for (U32 i = 0; i < messages; i++) {
+      MATH_TRACE_SCOPE("test.receiverHandler");
+      MATH_TRACE_DISPATCH("test.requestQueue");
+    }
+  });
+  receiver.join();
+  for (U32 i = 0; i < messages; i++) {
+    MATH_TRACE_SCOPE("test.senderHandler");
+    MATH_TRACE_ENQUEUE("test.requestQueue");
+    MATH_TRACE_FLOW_BEGIN("test.command", i);
+  }
+  std::thread dispatcher([messages]() {
+    for (U32 i = 0; i < messages; i++) {
+      MATH_TRACE_SCOPE("test.commandHandler");
+      MATH_TRACE_FLOW_END("test.command", i);
+    }
+  });
+  dispatcher.join();
+
+  const std::string path = tracePath("json");
+  MathModule::Trace::DumpStats stats;
+  ASSERT_EQ(MathModule::Trace::writeChromeJson(path.c_str(), stats), 0);
+  EXPECT_GE(stats.threads, 3U);
+  const std::string json = readFile(path);
+  (void) ::unlink(path.c_str());
+  ASSERT_EQ(json.compare(0, 2, "{\""), 0);
+  ASSERT_EQ(json.compare(json.size() - 4, 4, "\n]}\n"), 0);
+
+  EXPECT_EQ(fieldOf(json, "test.senderHandler", "X", "dur").size(), messages);
+  EXPECT_EQ(fieldOf(json, "test.receiverHandler", "X", "dur").size(), messages);
+  // Every message's enqueue is paired with its dispatch on the other thread, in order
+  const std::vector<unsigned long> begins = fieldOf(json, "test.requestQueue", "s", "id");
+  const std::vector<unsigned long> ends = fieldOf(json, "test.requestQueue", "f", "id");
+  ASSERT_EQ(begins.size(), messages);
+  ASSERT_EQ(ends.size(), messages);
+  EXPECT_EQ(std::set<unsigned long>(begins.begin(), begins.end()).size(), messages);
+  EXPECT_EQ(std::set<unsigned long>(begins.begin(), begins.end()),
+            std::set<unsigned long>(ends.begin(), ends.end()));
+  EXPECT_EQ(fieldOf(json, "test.command", "s", "id"), fieldOf(json, "test.command", "f", "id"));
+  const std::vector<unsigned long> senderThreads = fieldOf(json, "test.senderHandler", "X", "tid");
+  const std::vector<unsigned long> receiverThreads = fieldOf(json, "test.receiverHandler", "X", "tid");
+  EXPECT_NE(senderThreads[0], receiverThreads[0]);
+}
+
+TEST(Trace, Overwrite) {
+  const std::string path = tracePath("overwrite");
+  MathModule::Trace::DumpStats before;
+  ASSERT_EQ(MathModule::Trace::writeChromeJson(path.c_str(), before), 0);
+  // A thread recording more than its buffer holds keeps its newest events
+  std::thread busy([]() {
+    for (U32 i = 0; i < MathModule::Trace::THREAD_EVENTS + 100; i++) {
+      MATH_TRACE_FLOW_BEGIN("test.busy", i);
+    }
+  });
+  busy.join();
+  MathModule::Trace::DumpStats after;
+  ASSERT_EQ(MathModule::Trace::writeChromeJson(path.c_str(), after), 0);
+  const std::string json = readFile(path);
+  (void) ::unlink(path.c_str());
+  // The oldest kept event is dropped too, as its slot is the one the thread would write next
+  EXPECT_EQ(after.lost - before.lost, 101U);
+  EXPECT_EQ(after.threads, before.threads + 1);
+  const std::vector<unsigned long> ids = fieldOf(json, "test.busy", "s", "id");
+  ASSERT_EQ(ids.size(), MathModule::Trace::THREAD_EVENTS - 1);
+  EXPECT_EQ(ids.front(), 101U);
+  EXPECT_EQ(ids.back(), MathModule::Trace::THREAD_EVENTS + 99U);
+}
+
+#endif
+
+TEST(Nominal, Dump) {
+  MathModule::TracerTester tester;
+  tester.testDump();
+}
+
+TEST(OffNominal, DumpRejected) {
+  MathModule::TracerTester tester;
+  tester.testDumpRejected();
+}
+
+TEST(OffNominal, WriteError) {
+  MathModule::TracerTester tester;
+  tester.testWriteError();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+// ======================================================================
+// \title  TracerTester.cpp
+// \author cindy
+// \brief  cpp file for Tracer component test harness implementation class
+// ======================================================================
+
+#include "TracerTester.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  TracerTester ::
+    TracerTester() :
+      TracerGTestBase("TracerTester", TracerTester::MAX_HISTORY_SIZE),
+      component("Tracer"),
+      m_sendStatus(Svc::SendFileStatus::STATUS_OK)
+  {
+    char path[64];
+    (void) ::snprintf(path, sizeof(path), "/tmp/TracerTester.%d.json", static_cast<int>(::getpid()));
+    this->m_file = path;
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(this->m_file.c_str());
+  }
+
+  TracerTester ::
+    ~TracerTester()
+  {
+    (void) ::unlink(this->m_file.c_str());
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void TracerTester ::
+    testDump()
+  {
+    {
+      MATH_TRACE_SCOPE("TracerTester.testDump");
+    }
+    this->dump();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+#if MATH_TRACE
+    ASSERT_CMD_RESPONSE(0, Tracer::OPCODE_DUMP_TRACE, 5, Fw::CmdResponse::OK);
+    ASSERT_EQ(this->m_sentFiles.size(), 1U);
+    EXPECT_EQ(this->m_sentFiles[0], this->m_file);
+    ASSERT_EVENTS_TRACE_DUMPED_SIZE(1);
+    EXPECT_GE(this->eventHistory_TRACE_DUMPED->at(0).events, 1U);
+    EXPECT_GE(this->eventHistory_TRACE_DUMPED->at(0).threads, 1U);
+    EXPECT_EQ(::access(this->m_file.c_str(), R_OK), 0);
+#else
+    ASSERT_CMD_RESPONSE(0, Tracer::OPCODE_DUMP_TRACE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_TRACING_DISABLED_SIZE(1);
+    EXPECT_TRUE(this->m_sentFiles.empty());
+#endif
+  }
+
+  void TracerTester ::
+    testDumpRejected()
+  {
+    this->m_sendStatus = Svc::SendFileStatus::STATUS_BUSY;
+    this->dump();
+    ASSERT_CMD_RESPONSE(0, Tracer::OPCODE_DUMP_TRACE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+#if MATH_TRACE
+    ASSERT_EVENTS_TRACE_DOWNLINK_REJECTED_SIZE(1);
+    ASSERT_EVENTS_TRACE_DOWNLINK_REJECTED(0, Svc::SendFileStatus::STATUS_BUSY);
+    ASSERT_EVENTS_TRACE_DUMPED_SIZE(0);
+#endif
+  }
+
+  void TracerTester ::
+    testWriteError()
+  {
+    this->component.configure("/nonexistent/Trace.json");
+    this->dump();
+    ASSERT_CMD_RESPONSE(0, Tracer::OPCODE_DUMP_TRACE, 5, Fw::CmdResponse::EXECUTION_ERROR);
+    EXPECT_TRUE(this->m_sentFiles.empty());
+#if MATH_TRACE
+    ASSERT_EVENTS_TRACE_WRITE_ERROR_SIZE(1);
+    ASSERT_EVENTS_TRACE_WRITE_ERROR(0, ENOENT);
+    EXPECT_EQ(this->component.dumpAtShutdown(), ENOENT);
+#else
+    EXPECT_EQ(this->component.dumpAtShutdown(), 0);
+#endif
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Svc::SendFileResponse TracerTester ::
+    from_sendFile_handler(
+        NATIVE_INT_TYPE portNum,
+        const Fw::StringBase& fileNameFrom,
+        const Fw::StringBase& fileNameTo,
+        U32 offset,
+        U32 length
+    )
+  {
+    this->m_sentFiles.push_back(fileNameFrom.toChar());
+    EXPECT_EQ(fileNameTo, fileNameFrom);
+    EXPECT_EQ(offset, 0U);
+    EXPECT_EQ(length, 0U);
+    return Svc::SendFileResponse(this->m_sendStatus, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void TracerTester ::
+    dump()
+  {
+    this->clearHistory();
+    this->sendCmd_DUMP_TRACE(0, 5);
+    this->component.doDispatch();
+  }
+
+}
@@ -0,0 +1,116 @@
+// ======================================================================
+// \title  TracerTester.hpp
+// \author cindy
+// \brief  hpp file for Tracer component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_TracerTester_HPP
+#define MathModule_TracerTester_HPP
+
+#include "TracerGTestBase.hpp"
+#include "Components/Tracer/Tracer.hpp"
+
+#include <string>
+#include <vector>
+
+namespace MathModule {
+
+  class TracerTester :
+    public TracerGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object TracerTester
+      TracerTester();
+
+      //! Destroy object TracerTester, removing its file
+      ~TracerTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! DUMP_TRACE writes the trace file and hands it to file downlink, or reports tracing is compiled out
+      void testDump();
+
+      //! A trace file file downlink does not accept fails the command
+      void testDumpRejected();
+
+      //! A trace file that cannot be written fails the command
+      void testWriteError();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for sendFile
+      Svc::SendFileResponse from_sendFile_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          const Fw::StringBase& fileNameFrom, //!< Path of file to downlink
+          const Fw::StringBase& fileNameTo, //!< Path to store downlinked file at
+          U32 offset, //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+          U32 length //!< Amount of data in bytes to downlink from file. 0 to read until end of file
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Send DUMP_TRACE and let the component run it
+      void dump();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      Tracer component;
+
+      //! Trace file
+      std::string m_file;
+
+      //! Answer of the sendFile port
+      Svc::SendFileStatus m_sendStatus;
+
+      //! Files handed to sendFile
+      std::vector<std::string> m_sentFiles;
+
+  };
+
+}
+
+#endif
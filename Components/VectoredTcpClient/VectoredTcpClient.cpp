@@ -0,0 +1,600 @@
+// ======================================================================
+// \title  VectoredTcpClient.cpp
+// \author cindy
+// \brief  cpp file for VectoredTcpClient component implementation class
+// ======================================================================
+
+#include "Components/VectoredTcpClient/VectoredTcpClient.hpp"
+#include <Fw/Types/Assert.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <linux/errqueue.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define VECTORED_TCP_ZERO_COPY 1
+#else
+#define VECTORED_TCP_ZERO_COPY 0
+#endif
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  VectoredTcpClient ::
+    VectoredTcpClient(const char* const compName) :
+      VectoredTcpClientComponentBase(compName),
+      m_port(0),
+      m_zeroCopyThreshold(DEFAULT_ZERO_COPY_THRESHOLD),
+      m_fd(-1),
+      m_connection(0),
+      m_zeroCopy(false),
+      m_stopping(false),
+      m_started(false),
+      m_hasPending(false),
+      m_zeroCopyNextId(0),
+      m_zeroCopyCompleted(0),
+      m_zeroCopyConnection(0),
+      m_bytesSent(0),
+      m_syscalls(0),
+      m_zeroCopySends(0),
+      m_reportedBytes(0),
+      m_reportedSyscalls(0),
+      m_framesSent(0),
+      m_reportedFrames(0)
+  {
+    ::memset(&this->m_pending, 0, sizeof(this->m_pending));
+  }
+
+  VectoredTcpClient ::
+    ~VectoredTcpClient()
+  {
+
+  }
+
+  void VectoredTcpClient ::
+    configure(const char* hostname, U16 port, U32 zeroCopyThreshold)
+  {
+    FW_ASSERT(hostname != nullptr);
+    this->m_hostname = hostname;
+    this->m_port = port;
+    this->m_zeroCopyThreshold = zeroCopyThreshold;
+  }
+
+  void VectoredTcpClient ::
+    start(const Fw::StringBase& name, NATIVE_UINT_TYPE priority, NATIVE_UINT_TYPE stackSize)
+  {
+    FW_ASSERT(!this->m_started);
+    Os::QueueString queueName("VecTcpQ");
+    const Os::Queue::QueueStatus qStat =
+      this->m_sendQueue.create(queueName, SEND_QUEUE_DEPTH, sizeof(SendEntry));
+    FW_ASSERT(qStat == Os::Queue::QUEUE_OK, qStat);
+
+    Os::TaskString sendName("VecTcpSend");
+    Os::Task::TaskStatus tStat =
+      this->m_sendTask.start(sendName, VectoredTcpClient::sendTask, this, priority, stackSize);
+    FW_ASSERT(tStat == Os::Task::TASK_OK, tStat);
+    tStat = this->m_receiveTask.start(name, VectoredTcpClient::receiveTask, this, priority, stackSize);
+    FW_ASSERT(tStat == Os::Task::TASK_OK, tStat);
+    this->m_started = true;
+  }
+
+  /*
+    shutdown() wakes the receive task out of recv() and the send task out of
+    sendmsg(); the receive task then closes the socket. The quit message is
+    queued behind any frames already accepted, so they are still offered to
+    the kernel before the send task exits.
+  */
+  void VectoredTcpClient ::
+    stop()
+  {
+    this->m_lock.lock();
+    this->m_stopping = true;
+    const int fd = this->m_fd;
+    if (fd >= 0) {
+      (void) ::shutdown(fd, SHUT_RDWR);
+    }
+    this->m_lock.unLock();
+
+    if (this->m_started) {
+      this->postControl(SendEntry::QUIT, Os::Queue::QUEUE_BLOCKING);
+    }
+  }
+
+  Os::Task::TaskStatus VectoredTcpClient ::
+    join()
+  {
+    if (!this->m_started) {
+      return Os::Task::TASK_OK;
+    }
+    const Os::Task::TaskStatus status = this->m_receiveTask.join(nullptr);
+    (void) this->m_sendTask.join(nullptr);
+    this->m_started = false;
+    return status;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  /*
+    send_handler only queues the frame, so the com stub reports success and the
+    com queue hands over the next frame while this one waits for the send task.
+    A full queue blocks the caller, which is the backpressure the com queue
+    expects from a driver; SEND_RETRY is not used because the com stub asserts
+    after a few retries. A frame accepted before the link drops is returned to
+    the buffer manager by the send task, and the com stub learns of the loss on
+    its next send.
+  */
+  Drv::SendStatus VectoredTcpClient ::
+    send_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->m_lock.lock();
+    const bool connected = (this->m_fd >= 0) && !this->m_stopping;
+    this->m_lock.unLock();
+
+    if (connected) {
+      SendEntry entry;
+      entry.kind = SendEntry::FRAME;
+      entry.data = fwBuffer.getData();
+      entry.size = fwBuffer.getSize();
+      entry.context = fwBuffer.getContext();
+      const Os::Queue::QueueStatus status = this->m_sendQueue.send(
+        reinterpret_cast<const U8*>(&entry), sizeof(entry), 0, Os::Queue::QUEUE_BLOCKING);
+      if (status == Os::Queue::QUEUE_OK) {
+        return Drv::SendStatus::SEND_OK;
+      }
+    }
+    this->deallocate_out(0, fwBuffer);
+    return Drv::SendStatus::SEND_ERROR;
+  }
+
+  /*
+    schedIn reports the ratios over the last period rather than since boot, so
+    a change in downlink load shows up within one report. It also prompts the
+    send task to collect zero-copy completions when the link has gone idle.
+  */
+  void VectoredTcpClient ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->m_lock.lock();
+    const U64 bytes = this->m_bytesSent;
+    const U32 syscalls = this->m_syscalls;
+    const U32 frames = this->m_framesSent;
+    const U32 zeroCopySends = this->m_zeroCopySends;
+    const bool zeroCopy = this->m_zeroCopy && (this->m_fd >= 0);
+    this->m_lock.unLock();
+
+    const U32 periodSyscalls = syscalls - this->m_reportedSyscalls;
+    if (periodSyscalls > 0) {
+      this->tlmWrite_BYTES_PER_SYSCALL(
+        static_cast<F32>(bytes - this->m_reportedBytes) / static_cast<F32>(periodSyscalls));
+      this->tlmWrite_FRAMES_PER_SYSCALL(
+        static_cast<F32>(frames - this->m_reportedFrames) / static_cast<F32>(periodSyscalls));
+    }
+    this->m_reportedBytes = bytes;
+    this->m_reportedSyscalls = syscalls;
+    this->m_reportedFrames = frames;
+
+    this->tlmWrite_BYTES_SENT(bytes);
+    this->tlmWrite_SEND_SYSCALLS(syscalls);
+    this->tlmWrite_ZEROCOPY_SENDS(zeroCopySends);
+
+    if (zeroCopy && this->m_started) {
+      this->postControl(SendEntry::REAP, Os::Queue::QUEUE_NONBLOCKING);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Helpers
+  // ----------------------------------------------------------------------
+
+  int VectoredTcpClient ::
+    connectToGround()
+  {
+    char service[8];
+    (void) ::snprintf(service, sizeof(service), "%u", static_cast<unsigned int>(this->m_port));
+
+    struct addrinfo hints;
+    ::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = nullptr;
+    if (::getaddrinfo(this->m_hostname.toChar(), service, &hints, &addresses) != 0) {
+      errno = EHOSTUNREACH;
+      return -1;
+    }
+
+    int fd = -1;
+    for (struct addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+      fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+      if (fd < 0) {
+        continue;
+      }
+      if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+        break;
+      }
+      const int error = errno;
+      (void) ::close(fd);
+      errno = error;
+      fd = -1;
+    }
+    ::freeaddrinfo(addresses);
+    if (fd < 0) {
+      return -1;
+    }
+
+    // Frames are already coalesced here, so Nagle would only add latency
+    const int one = 1;
+    (void) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+  }
+
+  I32 VectoredTcpClient ::
+    receiveLoop(int fd)
+  {
+    while (true) {
+      Fw::Buffer buffer = this->allocate_out(0, RECV_BUFFER_SIZE);
+      if ((buffer.getData() == nullptr) || (buffer.getSize() == 0)) {
+        // Buffer manager exhausted; the deframer will return buffers shortly
+        (void) ::usleep(RECONNECT_DELAY_USEC / 100);
+        continue;
+      }
+      const ssize_t received = ::recv(fd, buffer.getData(), buffer.getSize(), 0);
+      if (received > 0) {
+        buffer.setSize(static_cast<U32>(received));
+        this->recv_out(0, buffer, Drv::RecvStatus::RECV_OK);
+        continue;
+      }
+      const I32 error = (received == 0) ? 0 : errno;
+      this->deallocate_out(0, buffer);
+      if (error != EINTR) {
+        return error;
+      }
+    }
+  }
+
+  /*
+    Taking the send lock waits out a sendmsg() still running on the socket,
+    which the shutdown() below interrupts, so the descriptor is never closed
+    and reused while the send task holds it.
+  */
+  void VectoredTcpClient ::
+    disconnect(int fd, I32 error)
+  {
+    (void) ::shutdown(fd, SHUT_RDWR);
+    this->m_sendLock.lock();
+    this->m_lock.lock();
+    this->m_fd = -1;
+    this->m_zeroCopy = false;
+    const bool stopping = this->m_stopping;
+    this->m_lock.unLock();
+    (void) ::close(fd);
+    this->m_sendLock.unLock();
+
+    if (!stopping) {
+      this->log_WARNING_HI_DISCONNECTED(error);
+    }
+  }
+
+  /*
+    transmit hands the batch to the kernel as one iovec list. Each frame is
+    already a contiguous buffer from the framer, so the kernel reads header,
+    payload and hash straight out of the buffer manager's memory. Large
+    batches are sent with MSG_ZEROCOPY, which skips the copy into the socket
+    buffer as well; the frames are then parked until the kernel reports that
+    it has finished with them.
+  */
+  void VectoredTcpClient ::
+    transmit(SendEntry* frames, U32 count)
+  {
+    FW_ASSERT(count <= MAX_BATCH, count);
+    struct iovec iov[MAX_BATCH];
+    U32 total = 0;
+    for (U32 i = 0; i < count; i++) {
+      iov[i].iov_base = frames[i].data;
+      iov[i].iov_len = frames[i].size;
+      total += frames[i].size;
+    }
+
+    this->m_sendLock.lock();
+    this->m_lock.lock();
+    const int fd = this->m_fd;
+    const U32 connection = this->m_connection;
+    const bool zeroCopy = this->m_zeroCopy && (total >= this->m_zeroCopyThreshold);
+    this->m_lock.unLock();
+
+    if (fd < 0) {
+      this->m_sendLock.unLock();
+      this->deallocateFrames(frames, count);
+      return;
+    }
+    if (connection != this->m_zeroCopyConnection) {
+      this->m_zeroCopyConnection = connection;
+      this->m_zeroCopyNextId = 0;
+      this->m_zeroCopyCompleted = 0;
+    }
+
+    bool useZeroCopy = zeroCopy;
+
+    U32 first = 0;
+    U32 calls = 0;
+    U32 sent = 0;
+    bool failed = false;
+    while (first < count) {
+      struct msghdr msg;
+      ::memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov[first];
+      msg.msg_iovlen = count - first;
+      int flags = MSG_NOSIGNAL;
+#if VECTORED_TCP_ZERO_COPY
+      if (useZeroCopy) {
+        flags |= MSG_ZEROCOPY;
+      }
+#endif
+      const ssize_t result = ::sendmsg(fd, &msg, flags);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if ((errno == ENOBUFS) && useZeroCopy) {
+          // Out of optmem for pinned pages: finish this batch with ordinary copies
+          useZeroCopy = false;
+          continue;
+        }
+        failed = true;
+        break;
+      }
+      ++calls;
+      sent += static_cast<U32>(result);
+      if (useZeroCopy) {
+        ++this->m_zeroCopyNextId;
+      }
+
+      // Step over what the kernel took; a partial write resumes mid-frame
+      size_t remaining = static_cast<size_t>(result);
+      while ((first < count) && (remaining >= iov[first].iov_len)) {
+        remaining -= iov[first].iov_len;
+        ++first;
+      }
+      if (first < count) {
+        iov[first].iov_base = static_cast<U8*>(iov[first].iov_base) + remaining;
+        iov[first].iov_len -= remaining;
+      }
+    }
+    this->m_sendLock.unLock();
+
+    const bool parked = zeroCopy && !failed && (this->m_zeroCopyNextId != this->m_zeroCopyCompleted);
+    this->m_lock.lock();
+    this->m_bytesSent += sent;
+    this->m_syscalls += calls;
+    this->m_framesSent += first;
+    if (parked) {
+      ++this->m_zeroCopySends;
+    }
+    this->m_lock.unLock();
+
+    if (failed) {
+      // The receive task sees the shutdown, closes the socket and reconnects
+      (void) ::shutdown(fd, SHUT_RDWR);
+    }
+    if (!parked) {
+      this->deallocateFrames(frames, count);
+      return;
+    }
+
+    // Only one batch is parked at a time, which keeps the frames held by this
+    // driver well below the buffer manager's framer pool
+    while (this->m_hasPending) {
+      this->reapCompletions(fd, 100);
+      this->releasePending(false);
+    }
+    ::memcpy(this->m_pending.frames, frames, count * sizeof(SendEntry));
+    this->m_pending.count = count;
+    this->m_pending.connection = connection;
+    this->m_pending.lastCallId = this->m_zeroCopyNextId - 1;
+    this->m_hasPending = true;
+  }
+
+  void VectoredTcpClient ::
+    reapCompletions(int fd, U32 waitMs)
+  {
+#if VECTORED_TCP_ZERO_COPY
+    this->m_sendLock.lock();
+    this->m_lock.lock();
+    const bool current = (this->m_fd == fd) && (fd >= 0);
+    this->m_lock.unLock();
+    if (!current) {
+      this->m_sendLock.unLock();
+      return;
+    }
+
+    if (waitMs > 0) {
+      // The error queue raises POLLERR, which poll() reports without asking
+      struct pollfd pfd;
+      pfd.fd = fd;
+      pfd.events = 0;
+      pfd.revents = 0;
+      (void) ::poll(&pfd, 1, static_cast<int>(waitMs));
+    }
+
+    while (true) {
+      U8 control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+      struct msghdr msg;
+      ::memset(&msg, 0, sizeof(msg));
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      if (::recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+        break;
+      }
+      for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (!((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR))) {
+          continue;
+        }
+        struct sock_extended_err err;
+        ::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+        if ((err.ee_errno == 0) && (err.ee_origin == SO_EE_ORIGIN_ZEROCOPY)) {
+          // [ee_info, ee_data] is the range of completed call ids
+          this->m_zeroCopyCompleted = FW_MAX(this->m_zeroCopyCompleted, err.ee_data + 1);
+        }
+      }
+    }
+    this->m_sendLock.unLock();
+#else
+    (void) fd;
+    (void) waitMs;
+#endif
+  }
+
+  /*
+    After a disconnect the kernel no longer reports completions for the old
+    socket. The peer is gone, so any bytes the kernel still reads from a
+    reused buffer would never reach the ground.
+  */
+  void VectoredTcpClient ::
+    releasePending(bool force)
+  {
+    if (!this->m_hasPending) {
+      return;
+    }
+    this->m_lock.lock();
+    const bool connectionGone = (this->m_fd < 0) || (this->m_connection != this->m_pending.connection);
+    this->m_lock.unLock();
+
+    const bool completed = (this->m_zeroCopyConnection == this->m_pending.connection) &&
+                           (this->m_zeroCopyCompleted > this->m_pending.lastCallId);
+    if (force || connectionGone || completed) {
+      this->deallocateFrames(this->m_pending.frames, this->m_pending.count);
+      this->m_hasPending = false;
+    }
+  }
+
+  void VectoredTcpClient ::
+    deallocateFrames(SendEntry* frames, U32 count)
+  {
+    for (U32 i = 0; i < count; i++) {
+      Fw::Buffer buffer(frames[i].data, frames[i].size, frames[i].context);
+      this->deallocate_out(0, buffer);
+    }
+  }
+
+  void VectoredTcpClient ::
+    postControl(U32 kind, Os::Queue::QueueBlocking block)
+  {
+    SendEntry entry;
+    ::memset(&entry, 0, sizeof(entry));
+    entry.kind = kind;
+    (void) this->m_sendQueue.send(reinterpret_cast<const U8*>(&entry), sizeof(entry), 0, block);
+  }
+
+  void VectoredTcpClient ::
+    receiveTask(void* arg)
+  {
+    VectoredTcpClient* client = static_cast<VectoredTcpClient*>(arg);
+    FW_ASSERT(client != nullptr);
+
+    while (true) {
+      client->m_lock.lock();
+      const bool stopping = client->m_stopping;
+      client->m_lock.unLock();
+      if (stopping) {
+        break;
+      }
+
+      const int fd = client->connectToGround();
+      if (fd < 0) {
+        (void) ::usleep(RECONNECT_DELAY_USEC);
+        continue;
+      }
+
+      bool zeroCopy = false;
+#if VECTORED_TCP_ZERO_COPY
+      const int one = 1;
+      zeroCopy = (::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0);
+#endif
+      client->m_lock.lock();
+      const bool cancelled = client->m_stopping;
+      if (!cancelled) {
+        client->m_fd = fd;
+        client->m_zeroCopy = zeroCopy;
+        ++client->m_connection;
+      }
+      client->m_lock.unLock();
+      if (cancelled) {
+        (void) ::close(fd);
+        break;
+      }
+
+      client->log_ACTIVITY_HI_CONNECTED(zeroCopy);
+      client->ready_out(0);
+      const I32 error = client->receiveLoop(fd);
+      client->disconnect(fd, error);
+    }
+  }
+
+  void VectoredTcpClient ::
+    sendTask(void* arg)
+  {
+    VectoredTcpClient* client = static_cast<VectoredTcpClient*>(arg);
+    FW_ASSERT(client != nullptr);
+
+    bool quit = false;
+    while (!quit) {
+      SendEntry frames[MAX_BATCH];
+      U32 count = 0;
+      NATIVE_INT_TYPE size = 0;
+      NATIVE_INT_TYPE priority = 0;
+      SendEntry entry;
+      Os::Queue::QueueStatus status = client->m_sendQueue.receive(
+        reinterpret_cast<U8*>(&entry), sizeof(entry), size, priority, Os::Queue::QUEUE_BLOCKING);
+
+      // Coalesce whatever else is already waiting, without waiting for more
+      while (status == Os::Queue::QUEUE_OK) {
+        if (entry.kind == SendEntry::QUIT) {
+          quit = true;
+          break;
+        }
+        if (entry.kind == SendEntry::FRAME) {
+          frames[count++] = entry;
+          if (count == MAX_BATCH) {
+            break;
+          }
+        }
+        status = client->m_sendQueue.receive(
+          reinterpret_cast<U8*>(&entry), sizeof(entry), size, priority, Os::Queue::QUEUE_NONBLOCKING);
+      }
+      if ((status != Os::Queue::QUEUE_OK) && (status != Os::Queue::QUEUE_NO_MORE_MSGS)) {
+        quit = true;
+      }
+
+      if (client->m_hasPending) {
+        client->m_lock.lock();
+        const int fd = client->m_fd;
+        client->m_lock.unLock();
+        client->reapCompletions(fd, 0);
+        client->releasePending(false);
+      }
+      if (count > 0) {
+        client->transmit(frames, count);
+      }
+    }
+    client->releasePending(true);
+  }
+
+}
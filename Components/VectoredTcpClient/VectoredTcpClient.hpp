@@ -0,0 +1,235 @@
+// ======================================================================
+// \title  VectoredTcpClient.hpp
+// \author cindy
+// \brief  hpp file for VectoredTcpClient component implementation class
+// ======================================================================
+
+#ifndef MathModule_VectoredTcpClient_HPP
+#define MathModule_VectoredTcpClient_HPP
+
+#include "Components/VectoredTcpClient/VectoredTcpClientComponentAc.hpp"
+#include <Fw/Types/String.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Queue.hpp>
+#include <Os/Task.hpp>
+
+namespace MathModule {
+
+  class VectoredTcpClient :
+    public VectoredTcpClientComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      //! Frames waiting for the send task
+      static const U32 SEND_QUEUE_DEPTH = 8;
+
+      //! Most frames coalesced into one sendmsg call
+      static const U32 MAX_BATCH = 8;
+
+      //! Size requested from the allocate port for each receive
+      static const U32 RECV_BUFFER_SIZE = 1024;
+
+      //! Smallest batch sent with MSG_ZEROCOPY. Page pinning costs more than copying below this.
+      static const U32 DEFAULT_ZERO_COPY_THRESHOLD = 16 * 1024;
+
+      //! Delay between connection attempts, microseconds
+      static const U32 RECONNECT_DELAY_USEC = 1000000;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct VectoredTcpClient object
+      VectoredTcpClient(
+          const char* const compName //!< The component name
+      );
+
+      //! Destroy VectoredTcpClient object
+      ~VectoredTcpClient();
+
+      //! Set the ground address
+      void configure(
+          const char* hostname, //!< Ground host name or address
+          U16 port, //!< Ground port
+          U32 zeroCopyThreshold = DEFAULT_ZERO_COPY_THRESHOLD //!< Smallest batch sent with MSG_ZEROCOPY
+      );
+
+      //! Start the receive task, which connects to the ground, and the send task
+      void start(
+          const Fw::StringBase& name, //!< Receive task name
+          NATIVE_UINT_TYPE priority, //!< Priority of both tasks
+          NATIVE_UINT_TYPE stackSize //!< Stack size of both tasks
+      );
+
+      //! Ask both tasks to exit and disconnect
+      void stop();
+
+      //! Wait for both tasks to exit
+      Os::Task::TaskStatus join();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for send
+      Drv::SendStatus send_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer to send
+      ) override;
+
+      //! Handler implementation for schedIn
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! Messages to the send task
+      struct SendEntry {
+        enum Kind {
+          FRAME, //!< A frame to send
+          REAP, //!< Collect MSG_ZEROCOPY completions
+          QUIT //!< Exit the send task
+        };
+        U32 kind;
+        U8* data;
+        U32 size;
+        U32 context;
+      };
+
+      //! A batch sent with MSG_ZEROCOPY whose buffers the kernel may still read
+      struct PendingBatch {
+        SendEntry frames[MAX_BATCH];
+        U32 count;
+        U32 connection; //!< Connection the batch was sent on
+        U32 lastCallId; //!< Zero-copy id of the last sendmsg call carrying the batch
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helpers
+      // ----------------------------------------------------------------------
+
+      //! Open a socket connected to the ground
+      //! \return the socket, or -1 with errno set
+      int connectToGround();
+
+      //! Receive from the socket until it fails or the driver is stopped
+      //! \return the errno value that ended the connection, 0 for an orderly shutdown
+      I32 receiveLoop(int fd);
+
+      //! Unpublish and close the socket
+      void disconnect(int fd, I32 error);
+
+      //! Send a batch of frames with as few sendmsg calls as possible
+      void transmit(SendEntry* frames, U32 count);
+
+      //! Read MSG_ZEROCOPY completions from the socket error queue
+      void reapCompletions(int fd, U32 waitMs);
+
+      //! Return the pending batch if the kernel is done with it or its connection is gone
+      void releasePending(bool force);
+
+      //! Return frames to the buffer manager
+      void deallocateFrames(SendEntry* frames, U32 count);
+
+      //! Queue a control message for the send task
+      void postControl(U32 kind, Os::Queue::QueueBlocking block);
+
+      //! Receive task entry point
+      static void receiveTask(void* arg);
+
+      //! Send task entry point
+      static void sendTask(void* arg);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Ground host name
+      Fw::String m_hostname;
+
+      //! Ground port
+      U16 m_port;
+
+      //! Smallest batch sent with MSG_ZEROCOPY
+      U32 m_zeroCopyThreshold;
+
+      //! Guards the connection state and the statistics
+      Os::Mutex m_lock;
+
+      //! Held by the send task while it uses the socket, so it is not closed underneath it
+      Os::Mutex m_sendLock;
+
+      //! Connected socket, or -1
+      int m_fd;
+
+      //! Incremented on each connection
+      U32 m_connection;
+
+      //! Whether the connected socket accepted SO_ZEROCOPY
+      bool m_zeroCopy;
+
+      //! Whether stop was called
+      bool m_stopping;
+
+      //! Frames and control messages for the send task
+      Os::Queue m_sendQueue;
+
+      //! Task connecting and receiving
+      Os::Task m_receiveTask;
+
+      //! Task coalescing and sending frames
+      Os::Task m_sendTask;
+
+      //! Whether the tasks were started
+      bool m_started;
+
+      //! Zero-copy batch waiting for completion. Owned by the send task.
+      PendingBatch m_pending;
+
+      //! Whether m_pending holds a batch
+      bool m_hasPending;
+
+      //! Zero-copy id of the next sendmsg call on this connection. Owned by the send task.
+      U32 m_zeroCopyNextId;
+
+      //! Zero-copy calls completed on this connection. Owned by the send task.
+      U32 m_zeroCopyCompleted;
+
+      //! Connection the zero-copy ids belong to. Owned by the send task.
+      U32 m_zeroCopyConnection;
+
+      //! Telemetry counters
+      U64 m_bytesSent;
+      U32 m_syscalls;
+      U32 m_zeroCopySends;
+
+      //! Counters at the last report, for the per-period ratios
+      U64 m_reportedBytes;
+      U32 m_reportedSyscalls;
+      U32 m_framesSent;
+      U32 m_reportedFrames;
+
+  };
+
+}
+
+#endif
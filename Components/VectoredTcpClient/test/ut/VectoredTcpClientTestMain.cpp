@@ -0,0 +1,27 @@
+// ======================================================================
+// \title  VectoredTcpClientTestMain.cpp
+// \author cindy
+// \brief  cpp file for VectoredTcpClient component test main function
+// ======================================================================
+
+#include "VectoredTcpClientTester.hpp"
+
+TEST(Nominal, Coalesce) {
+  MathModule::VectoredTcpClientTester tester;
+  tester.testCoalesce();
+}
+
+TEST(Nominal, PartialWrite) {
+  MathModule::VectoredTcpClientTester tester;
+  tester.testPartialWrite();
+}
+
+TEST(Nominal, ZeroCopy) {
+  MathModule::VectoredTcpClientTester tester;
+  tester.testZeroCopy();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,375 @@
+// ======================================================================
+// \title  VectoredTcpClientTester.cpp
+// \author cindy
+// \brief  cpp file for VectoredTcpClient component test harness implementation class
+// ======================================================================
+
+#include "VectoredTcpClientTester.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  namespace {
+
+    std::vector<U8> testPayload(U32 size, U8 seed)
+    {
+      std::vector<U8> payload(size);
+      for (U32 i = 0; i < size; i++) {
+        payload[i] = static_cast<U8>(seed + 7 * i + (i >> 12));
+      }
+      return payload;
+    }
+
+    //! Larger than the socket buffers on both ends, so the sendmsg call carrying it blocks until the ground reads
+    const U32 BIG_FRAME_SIZE = 8 * 1024 * 1024;
+
+  }
+
+  const U32 VectoredTcpClientTester::RECV_CONTEXT;
+  const U32 VectoredTcpClientTester::NO_ZERO_COPY;
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  VectoredTcpClientTester ::
+    VectoredTcpClientTester() :
+      VectoredTcpClientGTestBase("VectoredTcpClientTester", VectoredTcpClientTester::MAX_HISTORY_SIZE),
+      component("VectoredTcpClient"),
+      m_listener(-1),
+      m_ground(-1),
+      m_ready(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  VectoredTcpClientTester ::
+    ~VectoredTcpClientTester()
+  {
+    this->closeGround();
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  /*
+    The big frame keeps the send task inside sendmsg until the ground reads,
+    so the three small frames queue up behind it and are taken as one batch.
+  */
+  void VectoredTcpClientTester ::
+    testCoalesce()
+  {
+    ASSERT_TRUE(this->openGround(NO_ZERO_COPY));
+
+    std::vector<U8> frames[4] = {
+      testPayload(BIG_FRAME_SIZE, 0x10), testPayload(100, 0x20), testPayload(200, 0x30), testPayload(300, 0x40)
+    };
+    std::vector<U8> expected;
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(frames); i++) {
+      expected.insert(expected.end(), frames[i].begin(), frames[i].end());
+    }
+
+    this->sendFrame(frames[0], 0);
+    struct pollfd pfd;
+    pfd.fd = this->m_ground;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    ASSERT_EQ(::poll(&pfd, 1, 2000), 1);
+    for (U32 i = 1; i < FW_NUM_ARRAY_ELEMENTS(frames); i++) {
+      this->sendFrame(frames[i], i);
+    }
+
+    ASSERT_EQ(this->readGround(expected.size()), expected);
+    ASSERT_TRUE(this->waitForDeallocated(4, false));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1, 2, 3}));
+    this->m_lock.unLock();
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_SEND_SYSCALLS_SIZE(1);
+    ASSERT_TLM_SEND_SYSCALLS(0, 2);
+    ASSERT_TLM_FRAMES_PER_SYSCALL_SIZE(1);
+    ASSERT_TLM_FRAMES_PER_SYSCALL(0, 2.0f);
+    ASSERT_TLM_BYTES_SENT(0, expected.size());
+  }
+
+  /*
+    A send timeout on the driver's socket, with a ground that reads slowly,
+    makes the kernel return from sendmsg with only part of the frame taken.
+    Every byte still has to arrive once, in order, on the same connection.
+  */
+  void VectoredTcpClientTester ::
+    testPartialWrite()
+  {
+    ASSERT_TRUE(this->openGround(NO_ZERO_COPY));
+    const int fd = this->driverSocket();
+    ASSERT_GE(fd, 0);
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 50000;
+    ASSERT_EQ(::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)), 0);
+
+    std::vector<U8> big = testPayload(BIG_FRAME_SIZE, 0x50);
+    const std::vector<U8> expectedBig(big);
+    this->sendFrame(big, 0);
+    std::vector<U8> received;
+    U8 chunk[65536];
+    while (received.size() < expectedBig.size()) {
+      struct pollfd pfd;
+      pfd.fd = this->m_ground;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      ASSERT_EQ(::poll(&pfd, 1, 2000), 1);
+      const ssize_t count = ::recv(this->m_ground, chunk, sizeof(chunk), 0);
+      ASSERT_GT(count, 0);
+      received.insert(received.end(), chunk, chunk + count);
+      (void) ::usleep(1000);
+    }
+    ASSERT_EQ(received, expectedBig);
+    ASSERT_TRUE(this->waitForDeallocated(1, false));
+
+    // The connection survives the short writes
+    std::vector<U8> small = testPayload(100, 0x60);
+    const std::vector<U8> expectedSmall(small);
+    this->sendFrame(small, 1);
+    ASSERT_EQ(this->readGround(expectedSmall.size()), expectedSmall);
+    ASSERT_TRUE(this->waitForDeallocated(2, false));
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1}));
+    this->m_lock.unLock();
+
+    this->clearTlm();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_SEND_SYSCALLS_SIZE(1);
+    EXPECT_GT(this->tlmHistory_SEND_SYSCALLS->at(0).arg, 2U);
+    ASSERT_TLM_BYTES_SENT(0, expectedBig.size() + expectedSmall.size());
+    ASSERT_EVENTS_CONNECTED_SIZE(1);
+    ASSERT_EVENTS_DISCONNECTED_SIZE(0);
+  }
+
+  /*
+    Each frame is sent on its own, so each is a batch parked until the kernel
+    reports its completion. Nothing else wakes the send task after the first
+    frame, so that frame must still be held; the rest are returned as the next
+    batch or schedIn collects the completions.
+  */
+  void VectoredTcpClientTester ::
+    testZeroCopy()
+  {
+    ASSERT_TRUE(this->openGround(1));
+    ASSERT_EVENTS_CONNECTED_SIZE(1);
+    if (!this->eventHistory_CONNECTED->at(0).zeroCopy) {
+      GTEST_SKIP() << "SO_ZEROCOPY is not available";
+    }
+
+    const U32 frameCount = 4;
+    std::vector<std::vector<U8> > frames(frameCount);
+    for (U32 i = 0; i < frameCount; i++) {
+      frames[i] = testPayload(32 * 1024, static_cast<U8>(0x70 + i));
+      const std::vector<U8> expected(frames[i]);
+      this->sendFrame(frames[i], i);
+      ASSERT_EQ(this->readGround(expected.size()), expected);
+      if (i == 0) {
+        this->m_lock.lock();
+        EXPECT_TRUE(this->m_deallocated.empty());
+        this->m_lock.unLock();
+      }
+    }
+
+    this->clearTlm();
+    ASSERT_TRUE(this->waitForDeallocated(frameCount, true));
+    this->invoke_to_schedIn(0, 0);
+    this->m_lock.lock();
+    EXPECT_EQ(this->m_deallocated, std::vector<U32>({0, 1, 2, 3}));
+    this->m_lock.unLock();
+    ASSERT_GT(this->tlmHistory_ZEROCOPY_SENDS->size(), 0U);
+    EXPECT_EQ(this->tlmHistory_ZEROCOPY_SENDS->at(this->tlmHistory_ZEROCOPY_SENDS->size() - 1).arg, frameCount);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer VectoredTcpClientTester ::
+    from_allocate_handler(
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    return Fw::Buffer(new U8[size], size, RECV_CONTEXT);
+  }
+
+  void VectoredTcpClientTester ::
+    from_deallocate_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    if (fwBuffer.getContext() == RECV_CONTEXT) {
+      delete[] fwBuffer.getData();
+      return;
+    }
+    this->m_lock.lock();
+    this->m_deallocated.push_back(fwBuffer.getContext());
+    this->m_lock.unLock();
+  }
+
+  void VectoredTcpClientTester ::
+    from_ready_handler(NATIVE_INT_TYPE portNum)
+  {
+    this->m_lock.lock();
+    ++this->m_ready;
+    this->m_lock.unLock();
+  }
+
+  void VectoredTcpClientTester ::
+    from_recv_handler(
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& recvBuffer,
+        const Drv::RecvStatus& recvStatus
+    )
+  {
+    delete[] recvBuffer.getData();
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  bool VectoredTcpClientTester ::
+    openGround(U32 zeroCopyThreshold)
+  {
+    this->m_listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (this->m_listener < 0) {
+      return false;
+    }
+    struct sockaddr_in address;
+    ::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if ((::bind(this->m_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) ||
+        (::listen(this->m_listener, 1) != 0) ||
+        (::getsockname(this->m_listener, reinterpret_cast<struct sockaddr*>(&address), &length) != 0)) {
+      return false;
+    }
+
+    this->component.configure("127.0.0.1", ntohs(address.sin_port), zeroCopyThreshold);
+    this->component.start(Os::TaskString("VecTcpRecv"), Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+
+    struct pollfd pfd;
+    pfd.fd = this->m_listener;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, 2000) != 1) {
+      return false;
+    }
+    this->m_ground = ::accept(this->m_listener, nullptr, nullptr);
+    if (this->m_ground < 0) {
+      return false;
+    }
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      this->m_lock.lock();
+      const bool ready = (this->m_ready > 0);
+      this->m_lock.unLock();
+      if (ready) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+  void VectoredTcpClientTester ::
+    closeGround()
+  {
+    this->component.stop();
+    (void) this->component.join();
+    if (this->m_ground >= 0) {
+      (void) ::close(this->m_ground);
+      this->m_ground = -1;
+    }
+    if (this->m_listener >= 0) {
+      (void) ::close(this->m_listener);
+      this->m_listener = -1;
+    }
+  }
+
+  int VectoredTcpClientTester ::
+    driverSocket()
+  {
+    struct sockaddr_in peer;
+    socklen_t length = sizeof(peer);
+    if (::getpeername(this->m_ground, reinterpret_cast<struct sockaddr*>(&peer), &length) != 0) {
+      return -1;
+    }
+    for (int fd = 0; fd < 1024; fd++) {
+      struct sockaddr_in local;
+      length = sizeof(local);
+      if ((fd != this->m_ground) &&
+          (::getsockname(fd, reinterpret_cast<struct sockaddr*>(&local), &length) == 0) &&
+          (local.sin_family == AF_INET) && (local.sin_port == peer.sin_port)) {
+        return fd;
+      }
+    }
+    return -1;
+  }
+
+  void VectoredTcpClientTester ::
+    sendFrame(std::vector<U8>& frame, U32 index)
+  {
+    Fw::Buffer buffer(frame.data(), static_cast<U32>(frame.size()), index);
+    EXPECT_EQ(this->invoke_to_send(0, buffer), Drv::SendStatus::SEND_OK);
+  }
+
+  std::vector<U8> VectoredTcpClientTester ::
+    readGround(size_t count)
+  {
+    std::vector<U8> bytes;
+    U8 chunk[65536];
+    while (bytes.size() < count) {
+      struct pollfd pfd;
+      pfd.fd = this->m_ground;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      if (::poll(&pfd, 1, 2000) <= 0) {
+        break;
+      }
+      const ssize_t received = ::recv(this->m_ground, chunk, FW_MIN(sizeof(chunk), count - bytes.size()), 0);
+      if (received <= 0) {
+        break;
+      }
+      bytes.insert(bytes.end(), chunk, chunk + received);
+    }
+    return bytes;
+  }
+
+  bool VectoredTcpClientTester ::
+    waitForDeallocated(U32 count, bool reap)
+  {
+    for (U32 attempt = 0; attempt < 200; attempt++) {
+      if (reap) {
+        this->invoke_to_schedIn(0, 0);
+      }
+      this->m_lock.lock();
+      const bool done = (this->m_deallocated.size() >= count);
+      this->m_lock.unLock();
+      if (done) {
+        return true;
+      }
+      (void) ::usleep(10000);
+    }
+    return false;
+  }
+
+}
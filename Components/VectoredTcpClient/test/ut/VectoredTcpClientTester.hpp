@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  VectoredTcpClientTester.hpp
+// \author cindy
+// \brief  hpp file for VectoredTcpClient component test harness implementation class
+// ======================================================================
+
+#ifndef MathModule_VectoredTcpClientTester_HPP
+#define MathModule_VectoredTcpClientTester_HPP
+
+#include "VectoredTcpClientGTestBase.hpp"
+#include "Components/VectoredTcpClient/VectoredTcpClient.hpp"
+#include <Os/Mutex.hpp>
+
+#include <vector>
+
+namespace MathModule {
+
+  class VectoredTcpClientTester :
+    public VectoredTcpClientGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Context of the receive buffers handed out by allocate
+      static const U32 RECV_CONTEXT = 0xFFFF;
+
+      //! Zero-copy threshold that keeps every send an ordinary copy
+      static const U32 NO_ZERO_COPY = 0xFFFFFFFF;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object VectoredTcpClientTester
+      VectoredTcpClientTester();
+
+      //! Destroy object VectoredTcpClientTester
+      ~VectoredTcpClientTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Frames queued while a send is in progress go out together in one sendmsg call
+      void testCoalesce();
+
+      //! A short write resumes mid-frame and the ground receives every byte in order
+      void testPartialWrite();
+
+      //! Zero-copy frames are returned once the error queue reports them, in send order
+      void testZeroCopy();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for allocate
+      Fw::Buffer from_allocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          U32 size //!< The requested size
+      ) override;
+
+      //! Handler implementation for deallocate
+      void from_deallocate_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Handler implementation for ready
+      void from_ready_handler(
+          NATIVE_INT_TYPE portNum //!< The port number
+      ) override;
+
+      //! Handler implementation for recv
+      void from_recv_handler(
+          NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer& recvBuffer, //!< The received data
+          const Drv::RecvStatus& recvStatus //!< The receive status
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Listen on an ephemeral loopback port, start the driver and accept its connection
+      //! \return false if the driver did not connect
+      bool openGround(U32 zeroCopyThreshold);
+
+      //! Stop the driver and close the ground sockets
+      void closeGround();
+
+      //! The driver's end of the connection, found by its address
+      int driverSocket();
+
+      //! Hand a frame to the driver, tagged with its index
+      void sendFrame(std::vector<U8>& frame, U32 index);
+
+      //! Read from the ground socket until the given number of bytes arrived or a timeout
+      std::vector<U8> readGround(size_t count);
+
+      //! Wait until the given number of frames were returned through deallocate
+      //! \param reap whether to call schedIn while waiting, which collects zero-copy completions
+      bool waitForDeallocated(U32 count, bool reap);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      VectoredTcpClient component;
+
+      //! Listening socket
+      int m_listener;
+
+      //! Accepted ground socket
+      int m_ground;
+
+      //! Guards the state touched by the driver tasks
+      Os::Mutex m_lock;
+
+      //! Indexes of the frames returned through deallocate, in order
+      std::vector<U32> m_deallocated;
+
+      //! Calls to ready
+      U32 m_ready;
+
+  };
+
+}
+
+#endif
@@ -13,6 +13,8 @@
 #include <getopt.h>
 // Used for printf functions
 #include <cstdlib>
+// Used for option string comparison
+#include <cstring>
 
 /**
  * \brief print command line help message
@@ -22,7 +24,12 @@
  * @param app: name of application
  */
 void print_usage(const char* app) {
-    (void)printf("Usage: ./%s [options]\n-a\thostname/IP address\n-p\tport_number\n", app);
+    (void)printf(
+        "Usage: ./%s [options]\n-a\thostname/IP address (listen address for the server driver)\n-p\tport_number\n"
+        "-t\ttelemetry backend: chan (default), pkt or compact (slip and eth drivers only)\n"
+        "-c\tcom driver: tcp (default), uring, server, shm, slip or eth\n"
+        "-d\tserial device for the slip driver, network interface for the eth driver, socket path for the shm driver\n",
+        app);
 }
 
 /**
@@ -51,10 +58,13 @@ int main(int argc, char* argv[]) {
     I32 option = 0;
     CHAR* hostname = nullptr;
     U16 port_number = 0;
+    MathModule::TlmBackend tlm_backend = MathModule::TlmBackend::CHANNELIZED;
+    MathModule::ComDriverKind com_driver = MathModule::ComDriverKind::TCP;
+    CHAR* device = nullptr;
     Os::init();
 
     // Loop while reading the getopt supplied options
-    while ((option = getopt(argc, argv, "hp:a:")) != -1) {
+    while ((option = getopt(argc, argv, "hp:a:t:c:d:")) != -1) {
         switch (option) {
             // Handle the -a argument for address/hostname
             case 'a':
@@ -64,6 +74,42 @@ int main(int argc, char* argv[]) {
             case 'p':
                 port_number = static_cast<U16>(atoi(optarg));
                 break;
+            // Handle the -t telemetry backend argument
+            case 't':
+                if (strcmp(optarg, "pkt") == 0) {
+                    tlm_backend = MathModule::TlmBackend::PACKETIZED;
+                } else if (strcmp(optarg, "compact") == 0) {
+                    tlm_backend = MathModule::TlmBackend::COMPACT;
+                } else if (strcmp(optarg, "chan") == 0) {
+                    tlm_backend = MathModule::TlmBackend::CHANNELIZED;
+                } else {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            // Handle the -c com driver argument
+            case 'c':
+                if (strcmp(optarg, "slip") == 0) {
+                    com_driver = MathModule::ComDriverKind::SLIP;
+                } else if (strcmp(optarg, "eth") == 0) {
+                    com_driver = MathModule::ComDriverKind::ETHERNET;
+                } else if (strcmp(optarg, "tcp") == 0) {
+                    com_driver = MathModule::ComDriverKind::TCP;
+                } else if (strcmp(optarg, "uring") == 0) {
+                    com_driver = MathModule::ComDriverKind::IO_URING;
+                } else if (strcmp(optarg, "server") == 0) {
+                    com_driver = MathModule::ComDriverKind::TCP_SERVER;
+                } else if (strcmp(optarg, "shm") == 0) {
+                    com_driver = MathModule::ComDriverKind::SHM;
+                } else {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            // Handle the -d serial device, network interface or socket path argument
+            case 'd':
+                device = optarg;
+                break;
             // Cascade intended: help output
             case 'h':
             // Cascade intended: help output
@@ -74,10 +120,19 @@ int main(int argc, char* argv[]) {
                 return (option == 'h') ? 0 : 1;
         }
     }
+    // Compact telemetry is only carried by the Ethernet-framed drivers; any other driver would drop every packet
+    if ((tlm_backend == MathModule::TlmBackend::COMPACT) && (com_driver != MathModule::ComDriverKind::SLIP) &&
+        (com_driver != MathModule::ComDriverKind::ETHERNET) && (com_driver != MathModule::ComDriverKind::LOOPBACK)) {
+        print_usage(argv[0]);
+        return 1;
+    }
     // Object for communicating state to the reference topology
     MathDeployment::TopologyState inputs;
     inputs.hostname = hostname;
     inputs.port = port_number;
+    inputs.tlmBackend = tlm_backend;
+    inputs.comDriver = com_driver;
+    inputs.device = device;
 
     // Setup program shutdown via Ctrl-C
     signal(SIGINT, signalHandler);
@@ -0,0 +1,554 @@
+// ======================================================================
+// \title  MathSoak.cpp
+// \author cindy
+// \brief  Headless soak of the whole MathDeployment topology
+//
+// Usage: math_soak [--rate <ops/s>] [--seconds <s>] [--cycle-hz <hz>]
+//                  [--window <ops>] [--warmup <s>] [--settle <s>]
+//
+// The topology is set up as by MathDeployment, with the loopback driver as
+// the ground link and the compact telemetry backend, so it needs no
+// network or device. DO_MATH commands are framed as the ground frames them
+// and injected at the given rate while the rate groups are cycled at
+// --cycle-hz. With --window, at most that many commands are outstanding;
+// 0 injects open loop, which ends in an assertion once a queue overflows.
+//
+// Command n adds n (modulo 2^24) and 0 with FACTOR set to 1 first, so the
+// RESULT channel in the downlinked compact telemetry gives the number of
+// completed commands even when events are dropped. Cycle slips and buffer
+// manager allocation failures are read from the same telemetry; queue
+// high-water marks are read from the components before teardown. The
+// report is one JSON object; the exit status is 1 if not every command
+// completed or a downlink frame was malformed.
+// ======================================================================
+
+#include <MathDeployment/Top/MathDeploymentTopology.hpp>
+#include <MathDeployment/Top/MathDeploymentTopologyAc.hpp>
+#include "Components/ComAggregator/ComAggregator.hpp"
+#include "Components/ComCompressor/ComCompressor.hpp"
+#include "Components/ComCompressor/Lz4Block.hpp"
+#include "Components/Crc32Framing/Crc32.hpp"
+#include "Components/Crc32Framing/Crc32Framing.hpp"
+#include "Components/LoopbackComDriver/LoopbackComDriver.hpp"
+#include <Fw/Types/Assert.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Os.hpp>
+#include <Os/Task.hpp>
+#include <Svc/FramingProtocol/FprimeProtocol.hpp>
+#include <Svc/FramingProtocol/FramingProtocolInterface.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+#include <vector>
+
+namespace {
+
+  //! Largest uplink buffer injected at once, like one socket read
+  const U32 INJECT_SIZE = 1024;
+
+  //! Results are exact integers in an F32 up to 2^24
+  const U32 SEQUENCE_MODULUS = 1U << 24;
+
+  //! Injection period, nanoseconds
+  const U64 TICK_NSEC = 1000000;
+
+  //! Compact telemetry packet layout, see Components/CompactTlmPacketizer/docs/sdd.md
+  const U32 COMPACT_HEADER_SIZE = 2 + 1 + 8 + 2;
+  const U32 COMPACT_RECORD_HEADER_SIZE = 4 + 2;
+  const U8 COMPACT_TYPE_TELEMETRY = 0x01;
+
+  const U32 RATE_GROUPS = 3;
+
+  U64 monotonicNsec()
+  {
+    struct timespec now;
+    (void) ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<U64>(now.tv_sec) * 1000000000U + static_cast<U64>(now.tv_nsec);
+  }
+
+  void sleepUntil(U64 nsec)
+  {
+    struct timespec due;
+    due.tv_sec = static_cast<time_t>(nsec / 1000000000U);
+    due.tv_nsec = static_cast<long>(nsec % 1000000000U);
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr) == EINTR) {
+    }
+  }
+
+  U32 readU32(const U8* data)
+  {
+    return (static_cast<U32>(data[0]) << 24) | (static_cast<U32>(data[1]) << 16) |
+           (static_cast<U32>(data[2]) << 8) | static_cast<U32>(data[3]);
+  }
+
+  U16 readU16(const U8* data)
+  {
+    return static_cast<U16>((data[0] << 8) | data[1]);
+  }
+
+  U8* writeU32(U8* data, U32 value)
+  {
+    data[0] = static_cast<U8>(value >> 24);
+    data[1] = static_cast<U8>(value >> 16);
+    data[2] = static_cast<U8>(value >> 8);
+    data[3] = static_cast<U8>(value);
+    return data + sizeof(U32);
+  }
+
+  U8* writeF32(U8* data, F32 value)
+  {
+    U32 bits = 0;
+    (void) ::memcpy(&bits, &value, sizeof(bits));
+    return writeU32(data, bits);
+  }
+
+  F32 readF32(const U8* data)
+  {
+    const U32 bits = readU32(data);
+    F32 value = 0;
+    (void) ::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  // The autocoded ids are protected constants of the component bases, so they are read through derived classes
+
+  struct MathSenderIds : public MathModule::MathSenderComponentBase {
+    static FwOpcodeType doMath() { return OPCODE_DO_MATH; }
+    static FwEventIdType resultEvent() { return EVENTID_RESULT; }
+    static FwChanIdType resultChannel() { return CHANNELID_RESULT; }
+  };
+
+  struct MathReceiverIds : public MathModule::MathReceiverComponentBase {
+    static FwOpcodeType factorSet() { return OPCODE_FACTOR_SET; }
+  };
+
+  struct BufferManagerIds : public Svc::BufferManagerComponentBase {
+    static FwChanIdType noBuffs() { return CHANNELID_NOBUFFS; }
+  };
+
+  struct RateGroupIds : public Svc::ActiveRateGroupComponentBase {
+    static FwChanIdType cycleSlips() { return CHANNELID_RGCYCLESLIPS; }
+  };
+
+  //! Reads the queue high-water mark of any queued component through its protected queue
+  struct QueueAccess : public Fw::QueuedComponentBase {
+    static FwSizeType highWaterMark(Fw::QueuedComponentBase& component)
+    {
+      return (component.*(&QueueAccess::m_queue)).getMessageHighWaterMark();
+    }
+  };
+
+  //! Reads the downlink the way the ground would. Called on the deployment's sending threads.
+  class DownlinkMonitor : public MathModule::LoopbackComDriver::Listener {
+
+    public:
+
+      //! What the downlink showed so far
+      struct Counts {
+        U64 frames;
+        U64 bytes;
+        U64 badFrames;
+        U64 tlmPackets;
+        U64 resultEvents;
+        U64 completed; //!< Commands whose result was downlinked
+        U32 noBuffs;
+        U32 cycleSlips[RATE_GROUPS];
+      };
+
+      DownlinkMonitor() :
+        m_lastSequence(0), m_resultEventId(0), m_resultChannelId(0), m_noBuffsChannelId(0)
+      {
+        ::memset(&this->m_counts, 0, sizeof(this->m_counts));
+        ::memset(this->m_cycleSlipsChannelIds, 0, sizeof(this->m_cycleSlipsChannelIds));
+      }
+
+      //! Look up the ids of the events and channels read. The base ids are set by setupTopology.
+      void resolveIds()
+      {
+        this->m_resultEventId = MathDeployment::mathSender.getIdBase() + MathSenderIds::resultEvent();
+        this->m_resultChannelId = MathDeployment::mathSender.getIdBase() + MathSenderIds::resultChannel();
+        this->m_noBuffsChannelId = MathDeployment::bufferManager.getIdBase() + BufferManagerIds::noBuffs();
+        const Svc::ActiveRateGroup* const rateGroups[RATE_GROUPS] = {
+          &MathDeployment::rateGroup1, &MathDeployment::rateGroup2, &MathDeployment::rateGroup3};
+        for (U32 i = 0; i < RATE_GROUPS; i++) {
+          this->m_cycleSlipsChannelIds[i] = rateGroups[i]->getIdBase() + RateGroupIds::cycleSlips();
+        }
+      }
+
+      Counts counts()
+      {
+        this->m_lock.lock();
+        const Counts counts = this->m_counts;
+        this->m_lock.unLock();
+        return counts;
+      }
+
+      void frameSent(const U8* data, U32 size) override
+      {
+        this->m_lock.lock();
+        this->m_counts.bytes += size;
+        U32 offset = 0;
+        while (offset < size) {
+          const U32 left = size - offset;
+          const U8* const frame = data + offset;
+          const U32 overhead = Svc::FpFrameHeader::SIZE + HASH_DIGEST_LENGTH;
+          if ((left < overhead) || (readU32(frame) != Svc::FpFrameHeader::START_WORD) ||
+              (readU32(frame + sizeof(U32)) > left - overhead)) {
+            this->m_counts.badFrames++;
+            break;
+          }
+          const U32 dataSize = readU32(frame + sizeof(U32));
+          const U32 checked = Svc::FpFrameHeader::SIZE + dataSize;
+          if (MathModule::Crc32::update(MathModule::Crc32::INITIAL, frame, checked) != readU32(frame + checked)) {
+            this->m_counts.badFrames++;
+            break;
+          }
+          this->m_counts.frames++;
+          this->packet(frame + Svc::FpFrameHeader::SIZE, dataSize);
+          offset += checked + HASH_DIGEST_LENGTH;
+        }
+        this->m_lock.unLock();
+      }
+
+      void tlmPacketSent(const U8* data, U32 size) override
+      {
+        this->m_lock.lock();
+        this->m_counts.tlmPackets++;
+        if ((size >= COMPACT_HEADER_SIZE) && (data[2] == COMPACT_TYPE_TELEMETRY)) {
+          const U32 end = FW_MIN(size, static_cast<U32>(sizeof(U16)) + readU16(data));
+          U32 offset = COMPACT_HEADER_SIZE;
+          for (U16 records = readU16(data + COMPACT_HEADER_SIZE - sizeof(U16)); records > 0; records--) {
+            if (offset + COMPACT_RECORD_HEADER_SIZE > end) {
+              break;
+            }
+            const U32 id = readU32(data + offset);
+            const U16 length = readU16(data + offset + sizeof(U32));
+            offset += COMPACT_RECORD_HEADER_SIZE;
+            if (offset + length > end) {
+              break;
+            }
+            this->channel(id, data + offset, length);
+            offset += length;
+          }
+        }
+        this->m_lock.unLock();
+      }
+
+    private:
+
+      //! A com packet, possibly an aggregate or compressed
+      void packet(const U8* data, U32 size)
+      {
+        if (size < sizeof(U32)) {
+          return;
+        }
+        const U32 descriptor = readU32(data);
+        if (descriptor == MathModule::ComAggregator::AGGREGATE_DESCRIPTOR) {
+          U32 offset = sizeof(U32);
+          while (offset + MathModule::ComAggregator::RECORD_HEADER_SIZE <= size) {
+            const U16 length = readU16(data + offset);
+            offset += MathModule::ComAggregator::RECORD_HEADER_SIZE;
+            if (offset + length > size) {
+              break;
+            }
+            this->packet(data + offset, length);
+            offset += length;
+          }
+        } else if (descriptor == MathModule::ComCompressor::COMPRESSED_DESCRIPTOR) {
+          const U32 header = sizeof(U32) + MathModule::ComCompressor::ORIGINAL_SIZE_SIZE;
+          if (size >= header) {
+            std::vector<U8> original(readU16(data + sizeof(U32)));
+            const I32 decoded = MathModule::Lz4Block::decompress(data + header, size - header, original.data(),
+                                                                 static_cast<U32>(original.size()));
+            if (decoded == static_cast<I32>(original.size())) {
+              this->packet(original.data(), static_cast<U32>(original.size()));
+            }
+          }
+        } else if ((descriptor == static_cast<U32>(Fw::ComPacket::FW_PACKET_LOG)) && (size >= 2 * sizeof(U32))) {
+          if (readU32(data + sizeof(U32)) == this->m_resultEventId) {
+            this->m_counts.resultEvents++;
+          }
+        }
+      }
+
+      //! A channel record of a compact telemetry packet
+      void channel(U32 id, const U8* value, U16 length)
+      {
+        if ((id == this->m_resultChannelId) && (length == sizeof(F32))) {
+          // Results arrive in command order, so the newest names every command before it
+          const U32 sequence = static_cast<U32>(readF32(value)) % SEQUENCE_MODULUS;
+          this->m_counts.completed += (sequence - this->m_lastSequence) % SEQUENCE_MODULUS;
+          this->m_lastSequence = sequence;
+        } else if ((id == this->m_noBuffsChannelId) && (length == sizeof(U32))) {
+          this->m_counts.noBuffs = readU32(value);
+        } else if (length == sizeof(U32)) {
+          for (U32 i = 0; i < RATE_GROUPS; i++) {
+            if (id == this->m_cycleSlipsChannelIds[i]) {
+              this->m_counts.cycleSlips[i] = readU32(value);
+            }
+          }
+        }
+      }
+
+      Os::Mutex m_lock;
+      Counts m_counts;
+      U32 m_lastSequence;
+      U32 m_resultEventId;
+      U32 m_resultChannelId;
+      U32 m_noBuffsChannelId;
+      U32 m_cycleSlipsChannelIds[RATE_GROUPS];
+
+  };
+
+  //! Packs framed commands into one uplink buffer for the loopback driver
+  class Uplink : public Svc::FramingProtocolInterface {
+
+    public:
+
+      Uplink() : m_staged(0), m_refused(0)
+      {
+        this->m_framing.setup(*this);
+      }
+
+      //! Frame a command after those staged, if it fits
+      //! \return false if the buffer is full
+      bool command(FwOpcodeType opcode, const U8* args, U32 size)
+      {
+        U8 data[sizeof(U32) + 3 * sizeof(U32)];
+        FW_ASSERT(size <= sizeof(data) - sizeof(U32), size);
+        (void) writeU32(data, opcode);
+        (void) ::memcpy(data + sizeof(U32), args, size);
+        const U32 frameSize = Svc::FpFrameHeader::SIZE + sizeof(U32) + sizeof(U32) + size + HASH_DIGEST_LENGTH;
+        if (this->m_staged + frameSize > INJECT_SIZE) {
+          return false;
+        }
+        this->m_framing.frame(data, sizeof(U32) + size, Fw::ComPacket::FW_PACKET_COMMAND);
+        return true;
+      }
+
+      //! Pass the staged frames up through the driver
+      //! \return false if the driver got no buffer; the frames stay staged
+      bool flush()
+      {
+        if (this->m_staged == 0) {
+          return true;
+        }
+        if (!MathDeployment::loopbackDriver.inject(this->m_staging, this->m_staged)) {
+          this->m_refused++;
+          return false;
+        }
+        this->m_staged = 0;
+        return true;
+      }
+
+      U32 refused() const
+      {
+        return this->m_refused;
+      }
+
+      Fw::Buffer allocate(const U32 size) override
+      {
+        FW_ASSERT(this->m_staged + size <= INJECT_SIZE, this->m_staged, size);
+        return Fw::Buffer(this->m_staging + this->m_staged, size);
+      }
+
+      void send(Fw::Buffer& outgoing) override
+      {
+        this->m_staged += outgoing.getSize();
+      }
+
+    private:
+
+      MathModule::Crc32Framing m_framing;
+      U8 m_staging[INJECT_SIZE];
+      U32 m_staged;
+      U32 m_refused;
+
+  };
+
+  struct NamedQueue {
+    const char* name;
+    Fw::QueuedComponentBase* component;
+  };
+
+  void cycleTask(void* arg)
+  {
+    MathDeployment::startSimulatedCycle(*static_cast<Fw::TimeInterval*>(arg));
+  }
+
+  int usage(const char* program)
+  {
+    std::fprintf(stderr,
+                 "usage: %s [--rate <ops/s>] [--seconds <s>] [--cycle-hz <hz>] [--window <ops>] "
+                 "[--warmup <s>] [--settle <s>]\n", program);
+    return 1;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  double rate = 100;
+  double seconds = 10;
+  double cycleHz = 10;
+  unsigned long window = 8;
+  double warmup = 1;
+  double settle = 2;
+  for (int i = 1; i < argc; i++) {
+    if ((i + 1 < argc) && (std::strcmp(argv[i], "--rate") == 0)) {
+      rate = std::strtod(argv[++i], nullptr);
+    } else if ((i + 1 < argc) && (std::strcmp(argv[i], "--seconds") == 0)) {
+      seconds = std::strtod(argv[++i], nullptr);
+    } else if ((i + 1 < argc) && (std::strcmp(argv[i], "--cycle-hz") == 0)) {
+      cycleHz = std::strtod(argv[++i], nullptr);
+    } else if ((i + 1 < argc) && (std::strcmp(argv[i], "--window") == 0)) {
+      window = std::strtoul(argv[++i], nullptr, 0);
+    } else if ((i + 1 < argc) && (std::strcmp(argv[i], "--warmup") == 0)) {
+      warmup = std::strtod(argv[++i], nullptr);
+    } else if ((i + 1 < argc) && (std::strcmp(argv[i], "--settle") == 0)) {
+      settle = std::strtod(argv[++i], nullptr);
+    } else {
+      return usage(argv[0]);
+    }
+  }
+  if ((rate <= 0) || (seconds <= 0) || (cycleHz <= 0) || (warmup < 0) || (warmup >= seconds) || (settle < 0)) {
+    return usage(argv[0]);
+  }
+
+  Os::init();
+  DownlinkMonitor monitor;
+  MathDeployment::loopbackDriver.setListener(&monitor);
+  MathDeployment::TopologyState state;
+  state.hostname = nullptr;
+  state.port = 0;
+  state.tlmBackend = MathModule::TlmBackend::COMPACT;
+  state.comDriver = MathModule::ComDriverKind::LOOPBACK;
+  state.device = nullptr;
+  MathDeployment::setupTopology(state);
+  monitor.resolveIds();
+
+  const U64 cycleUsec = static_cast<U64>(1e6 / cycleHz);
+  Fw::TimeInterval interval(static_cast<U32>(cycleUsec / 1000000U), static_cast<U32>(cycleUsec % 1000000U));
+  Os::Task cycle;
+  Os::TaskString cycleName("soakCycle");
+  const Os::Task::TaskStatus started = cycle.start(cycleName, cycleTask, &interval);
+  FW_ASSERT(started == Os::Task::TASK_OK, started);
+
+  // Every result equals its first operand from here on
+  Uplink uplink;
+  U8 args[3 * sizeof(U32)];
+  (void) writeF32(args, 1.0f);
+  FW_ASSERT(uplink.command(MathDeployment::mathReceiver.getIdBase() + MathReceiverIds::factorSet(),
+                           args, sizeof(F32)));
+  while (!uplink.flush()) {
+    sleepUntil(monotonicNsec() + TICK_NSEC);
+  }
+
+  const FwOpcodeType doMath = MathDeployment::mathSender.getIdBase() + MathSenderIds::doMath();
+  U64 injected = 0;
+  U64 warmupCompleted = 0;
+  bool warmedUp = false;
+  const U64 start = monotonicNsec();
+  const U64 warmupEnd = start + static_cast<U64>(warmup * 1e9);
+  const U64 injectEnd = start + static_cast<U64>(seconds * 1e9);
+  U64 nextProgress = start + 1000000000U;
+  U64 now = start;
+  while (now < injectEnd) {
+    const DownlinkMonitor::Counts counts = monitor.counts();
+    if (!warmedUp && (now >= warmupEnd)) {
+      warmupCompleted = counts.completed;
+      warmedUp = true;
+    }
+    U64 due = static_cast<U64>(rate * static_cast<double>(now - start) / 1e9) + 1;
+    if ((window > 0) && (due > counts.completed + window)) {
+      due = counts.completed + window;
+    }
+    bool accepted = true;
+    while (accepted && (injected < due)) {
+      const U32 sequence = static_cast<U32>((injected + 1) % SEQUENCE_MODULUS);
+      U8* arg = writeF32(args, static_cast<F32>(sequence));
+      arg = writeU32(arg, static_cast<U32>(static_cast<FwEnumStoreType>(MathModule::MathOp::ADD)));
+      (void) writeF32(arg, 0.0f);
+      if (uplink.command(doMath, args, sizeof(args))) {
+        injected++;
+      } else {
+        accepted = uplink.flush();
+      }
+    }
+    if (accepted) {
+      (void) uplink.flush();
+    }
+    if (now >= nextProgress) {
+      std::fprintf(stderr, "%6.1f s: %llu injected, %llu completed\n", static_cast<double>(now - start) / 1e9,
+                   static_cast<unsigned long long>(injected), static_cast<unsigned long long>(counts.completed));
+      nextProgress += 1000000000U;
+    }
+    sleepUntil(now + TICK_NSEC);
+    now = monotonicNsec();
+  }
+  while (!uplink.flush()) {
+    sleepUntil(monotonicNsec() + TICK_NSEC);
+  }
+  const U64 measuredCompleted = monitor.counts().completed;
+  const double measuredSeconds = static_cast<double>(monotonicNsec() - warmupEnd) / 1e9;
+
+  // Let the backlog drain and the slower rate groups report
+  sleepUntil(monotonicNsec() + static_cast<U64>(settle * 1e9));
+  MathDeployment::stopSimulatedCycle();
+  (void) cycle.join(nullptr);
+
+  const NamedQueue queues[] = {
+    {"blockDrv", &MathDeployment::blockDrv},
+    {"rateGroup1", &MathDeployment::rateGroup1},
+    {"rateGroup2", &MathDeployment::rateGroup2},
+    {"rateGroup3", &MathDeployment::rateGroup3},
+    {"cmdDisp", &MathDeployment::cmdDisp},
+    {"cmdSeq", &MathDeployment::cmdSeq},
+    {"comQueue", &MathDeployment::comQueue},
+    {"comAggregator", &MathDeployment::comAggregator},
+    {"fileDownlink", &MathDeployment::fileDownlink},
+    {"fileManager", &MathDeployment::fileManager},
+    {"fileUplink", &MathDeployment::fileUplink},
+    {"eventJournal", &MathDeployment::eventJournal},
+    {"eventLogger", &MathDeployment::eventLogger},
+    {"textLogger", &MathDeployment::textLogger},
+    {"tlmSend", &MathDeployment::tlmSend},
+    {"tlmPacketizer", &MathDeployment::tlmPacketizer},
+    {"tlmHistory", &MathDeployment::tlmHistory},
+    {"prmDb", &MathDeployment::prmDb},
+    {"tracer", &MathDeployment::tracer},
+    {"health", &MathDeployment::health},
+    {"mathSender", &MathDeployment::mathSender},
+    {"mathReceiver", &MathDeployment::mathReceiver},
+    {"mathFileJob", &MathDeployment::mathFileJob},
+  };
+  FwSizeType highWater[FW_NUM_ARRAY_ELEMENTS(queues)];
+  for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(queues); i++) {
+    highWater[i] = QueueAccess::highWaterMark(*queues[i].component);
+  }
+  const DownlinkMonitor::Counts counts = monitor.counts();
+  MathDeployment::teardownTopology(state);
+
+  std::printf("{\n  \"rate\": %.1f,\n  \"seconds\": %.1f,\n  \"cycle_hz\": %.1f,\n  \"window\": %lu,\n"
+              "  \"injected\": %llu,\n  \"completed\": %llu,\n  \"ops_per_sec\": %.1f,\n"
+              "  \"result_events\": %llu,\n  \"uplink_refused\": %u,\n",
+              rate, seconds, cycleHz, window, static_cast<unsigned long long>(injected),
+              static_cast<unsigned long long>(counts.completed),
+              static_cast<double>(measuredCompleted - warmupCompleted) / measuredSeconds,
+              static_cast<unsigned long long>(counts.resultEvents), uplink.refused());
+  std::printf("  \"downlink\": {\"frames\": %llu, \"bytes\": %llu, \"bad_frames\": %llu, \"tlm_packets\": %llu},\n"
+              "  \"no_buffs\": %u,\n  \"cycle_slips\": {\"rateGroup1\": %u, \"rateGroup2\": %u, \"rateGroup3\": %u},\n"
+              "  \"queue_high_water\": {\n",
+              static_cast<unsigned long long>(counts.frames), static_cast<unsigned long long>(counts.bytes),
+              static_cast<unsigned long long>(counts.badFrames), static_cast<unsigned long long>(counts.tlmPackets),
+              counts.noBuffs, counts.cycleSlips[0], counts.cycleSlips[1], counts.cycleSlips[2]);
+  for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(queues); i++) {
+    std::printf("    \"%s\": %llu%s\n", queues[i].name, static_cast<unsigned long long>(highWater[i]),
+                (i + 1 < FW_NUM_ARRAY_ELEMENTS(queues)) ? "," : "");
+  }
+  std::printf("  }\n}\n");
+  return ((counts.completed == injected) && (counts.badFrames == 0)) ? 0 : 1;
+}
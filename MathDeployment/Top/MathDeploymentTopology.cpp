@@ -5,15 +5,19 @@
 // ======================================================================
 // Provides access to autocoded functions
 #include <MathDeployment/Top/MathDeploymentTopologyAc.hpp>
-// Note: Uncomment when using Svc:TlmPacketizer
-//#include <MathDeployment/Top/MathDeploymentPacketsAc.hpp>
+// Packet definitions for Svc:TlmPacketizer
+#include <MathDeployment/Top/MathDeploymentPacketsAc.hpp>
 
 // Necessary project-specified types
 #include <Fw/Types/MallocAllocator.hpp>
 #include <Svc/FramingProtocol/FprimeProtocol.hpp>
+#include <Components/Crc32Framing/Crc32Framing.hpp>
+#include <Components/StreamingSequence/StreamingSequence.hpp>
 
 // Used for 1Hz synthetic cycling
 #include <Os/Mutex.hpp>
+// Used to run independent configuration steps concurrently
+#include <Os/Task.hpp>
 
 // Allows easy reference to objects in FPP/autocoder required namespaces
 using namespace MathDeployment;
@@ -22,10 +26,14 @@ using namespace MathDeployment;
 // initialization phase.
 Fw::MallocAllocator mallocator;
 
-// The reference topology uses the F´ packet protocol when communicating with the ground and therefore uses the F´
-// framing and deframing implementations.
-Svc::FprimeFraming framing;
-Svc::FprimeDeframing deframing;
+// The reference topology uses the F´ packet protocol when communicating with the ground. Crc32Framing produces the
+// same frames as the F´ framing and deframing implementations with a CPU-dispatched frame checksum.
+MathModule::Crc32Framing framing;
+MathModule::Crc32Deframing deframing;
+
+// The command sequencer streams sequence files through its buffer rather than loading them whole, so the length of a
+// sequence is not bounded by the buffer size.
+MathModule::StreamingSequence cmdSeqStream(cmdSeq);
 
 Svc::ComQueue::QueueConfigurationTable configurationTable;
 
@@ -40,7 +48,8 @@ NATIVE_INT_TYPE rateGroup3Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] =
 
 // A number of constants are needed for construction of the topology. These are specified here.
 enum TopologyConstants {
-    CMD_SEQ_BUFFER_SIZE = 5 * 1024,
+    // cmdSeq constants: two 8 KB read-ahead chunks of a streamed sequence
+    CMD_SEQ_BUFFER_SIZE = 2 * (8 * 1024 + MathModule::StreamingSequence::MAX_RECORD_SIZE),
     FILE_DOWNLINK_TIMEOUT = 1000,
     FILE_DOWNLINK_COOLDOWN = 1000,
     FILE_DOWNLINK_CYCLE_TIME = 1000,
@@ -54,13 +63,25 @@ enum TopologyConstants {
     DEFRAMER_BUFFER_COUNT = 30,
     COM_DRIVER_BUFFER_SIZE = 3000,
     COM_DRIVER_BUFFER_COUNT = 30,
-    BUFFER_MANAGER_ID = 200
+    BUFFER_MANAGER_ID = 200,
+    // comAggregator constants: an aggregate may use all of a framer buffer not taken by the frame header and hash
+    AGGREGATE_MAX_SIZE = FRAMER_BUFFER_SIZE - HASH_DIGEST_LENGTH - Svc::FpFrameHeader::SIZE,
+    // The deadline cannot be shorter than the 1 Hz rateGroup1 period that calls comAggregator.schedIn
+    AGGREGATE_DEADLINE_MS = 1000,
+    // compactTlm constants: packets fill one Ethernet frame, and every channel is resent every 10 rate group 1 cycles
+    COMPACT_TLM_PACKET_SIZE = 1500,
+    COMPACT_TLM_REFRESH_PERIOD = 10,
+    // eventJournal constants: about 2 MB of the most recent events
+    EVENT_JOURNAL_SLOTS = 4096,
+    // tlmHistory constants: 16 KB per channel, about 2 MB in all
+    TLM_HISTORY_BLOCKS = 32
 };
 
 // Ping entries are autocoded, however; this code is not properly exported. Thus, it is copied here.
 Svc::Health::PingEntry pingEntries[] = {
     {PingEntries::MathDeployment_blockDrv::WARN, PingEntries::MathDeployment_blockDrv::FATAL, "blockDrv"},
     {PingEntries::MathDeployment_tlmSend::WARN, PingEntries::MathDeployment_tlmSend::FATAL, "chanTlm"},
+    {PingEntries::MathDeployment_tlmPacketizer::WARN, PingEntries::MathDeployment_tlmPacketizer::FATAL, "tlmPacketizer"},
     {PingEntries::MathDeployment_cmdDisp::WARN, PingEntries::MathDeployment_cmdDisp::FATAL, "cmdDisp"},
     {PingEntries::MathDeployment_cmdSeq::WARN, PingEntries::MathDeployment_cmdSeq::FATAL, "cmdSeq"},
     {PingEntries::MathDeployment_eventLogger::WARN, PingEntries::MathDeployment_eventLogger::FATAL, "eventLogger"},
@@ -74,14 +95,11 @@ Svc::Health::PingEntry pingEntries[] = {
 };
 
 /**
- * \brief configure/setup components in project-specific way
+ * \brief set up the buffer manager bins
  *
- * This is a *helper* function which configures/sets up each component requiring project specific input. This includes
- * allocating resources, passing-in arguments, etc. This function may be inlined into the topology setup function if
- * desired, but is extracted here for clarity.
+ * Buffer managers need a configured set of buckets and an allocator used to allocate memory for those buckets.
  */
-void configureTopology(const TopologyState& state) {
-    // Buffer managers need a configured set of buckets and an allocator used to allocate memory for those buckets.
+void configureBufferManager() {
     Svc::BufferManager::BufferBins upBuffMgrBins;
     memset(&upBuffMgrBins, 0, sizeof(upBuffMgrBins));
     upBuffMgrBins.bins[0].bufferSize = FRAMER_BUFFER_SIZE;
@@ -91,13 +109,103 @@ void configureTopology(const TopologyState& state) {
     upBuffMgrBins.bins[2].bufferSize = COM_DRIVER_BUFFER_SIZE;
     upBuffMgrBins.bins[2].numBuffers = COM_DRIVER_BUFFER_COUNT;
     bufferManager.setup(BUFFER_MANAGER_ID, 0, mallocator, upBuffMgrBins);
+}
+
+/**
+ * \brief set up the com queue priorities and depths
+ */
+void configureComQueue() {
+    // Events (highest-priority)
+    configurationTable.entries[0] = {.depth = 100, .priority = 0};
+    // Telemetry
+    configurationTable.entries[1] = {.depth = 500, .priority = 2};
+    // File Downlink
+    configurationTable.entries[2] = {.depth = 100, .priority = 1};
+    // Allocation identifier is 0 as the MallocAllocator discards it
+    comQueue.configure(configurationTable, 0, mallocator);
+}
+
+/**
+ * \brief set up the parameter database
+ *
+ * Parameter database is configured with a database file name, and that file must be initially read. The read maps the
+ * file and indexes record headers only; values are validated when first requested by loadParameters.
+ */
+void configureParameters() {
+    prmDb.configure("PrmDb.dat");
+    prmDb.readParamFile();
+}
+
+/**
+ * \brief set up the command sequencer
+ *
+ * Command sequencer needs to allocate memory to hold the chunks of a command sequence being streamed, and the task that
+ * reads the chunks ahead of it.
+ */
+void configureSequencer() {
+    cmdSeq.setSequenceFormat(cmdSeqStream);
+    cmdSeq.allocateBuffer(0, mallocator, CMD_SEQ_BUFFER_SIZE);
+    cmdSeqStream.startReader();
+}
+
+/**
+ * \brief a configuration step that may run concurrently with the others
+ *
+ * Each step touches a disjoint set of components, and the only shared resource, the malloc-based allocator, is
+ * thread-safe. Events emitted by a step (e.g. the parameter file load) are queued to the event logger, which is also
+ * safe from any thread.
+ */
+struct ParallelConfigStep {
+    const char* name;
+    void (*configure)();
+};
+
+const ParallelConfigStep parallelConfigSteps[] = {
+    {"cfgBuffMgr", configureBufferManager},
+    {"cfgComQueue", configureComQueue},
+    {"cfgPrmDb", configureParameters},
+    {"cfgCmdSeq", configureSequencer},
+};
+
+void runParallelConfigStep(void* arg) {
+    const ParallelConfigStep* step = static_cast<const ParallelConfigStep*>(arg);
+    step->configure();
+}
+
+/**
+ * \brief configure/setup components in project-specific way
+ *
+ * This is a *helper* function which configures/sets up each component requiring project specific input. This includes
+ * allocating resources, passing-in arguments, etc. This function may be inlined into the topology setup function if
+ * desired, but is extracted here for clarity.
+ *
+ * The independent, allocation- and file-heavy steps are started on short-lived tasks and joined before returning, so
+ * the remainder of setupTopology sees a fully configured topology. A step whose task cannot be started runs inline.
+ */
+void configureTopology(const TopologyState& state) {
+    // The event journal is mapped first so the events of the configuration steps are kept
+    eventJournal.configure("EventJournal.bin", EVENT_JOURNAL_SLOTS, "EventJournal");
+    tlmHistory.configure("TlmHistory.bin", TLM_HISTORY_BLOCKS, "TlmHistory");
+    tracer.configure("Trace.json");
+
+    Os::Task configTasks[FW_NUM_ARRAY_ELEMENTS(parallelConfigSteps)];
+    bool configStarted[FW_NUM_ARRAY_ELEMENTS(parallelConfigSteps)] = {};
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(parallelConfigSteps); i++) {
+        Os::TaskString name(parallelConfigSteps[i].name);
+        configStarted[i] = (configTasks[i].start(name, runParallelConfigStep,
+                                                 const_cast<ParallelConfigStep*>(&parallelConfigSteps[i])) ==
+                            Os::Task::TASK_OK);
+        if (!configStarted[i]) {
+            parallelConfigSteps[i].configure();
+        }
+    }
 
     // Framer and Deframer components need to be passed a protocol handler
     framer.setup(framing);
     deframer.setup(deframing);
 
-    // Command sequencer needs to allocate memory to hold contents of command sequences
-    cmdSeq.allocateBuffer(0, mallocator, CMD_SEQ_BUFFER_SIZE);
+    // Com buffers are packed into shared frames up to a size limit or latency deadline
+    comAggregator.configure(AGGREGATE_MAX_SIZE, AGGREGATE_DEADLINE_MS);
 
     // Rate group driver needs a divisor list
     rateGroupDriver.configure(rateGroupDivisorsSet);
@@ -111,54 +219,103 @@ void configureTopology(const TopologyState& state) {
     fileDownlink.configure(FILE_DOWNLINK_TIMEOUT, FILE_DOWNLINK_COOLDOWN, FILE_DOWNLINK_CYCLE_TIME,
                            FILE_DOWNLINK_FILE_QUEUE_DEPTH);
 
-    // Parameter database is configured with a database file name, and that file must be initially read.
-    prmDb.configure("PrmDb.dat");
-    prmDb.readParamFile();
-
     // Health is supplied a set of ping entires.
     health.setPingEntries(pingEntries, FW_NUM_ARRAY_ELEMENTS(pingEntries), HEALTH_WATCHDOG_CODE);
 
-    // Note: Uncomment when using Svc:TlmPacketizer
-    // tlmSend.setPacketList(MathDeploymentPacketsPkts, MathDeploymentPacketsIgnore, 1);
+    // The packetizer is always given its packet set so either backend can be selected; only the selected one receives
+    // channel updates from the router.
+    tlmPacketizer.setPacketList(MathDeploymentPacketsPkts, MathDeploymentPacketsIgnore, 1);
+    tlmRouter.setBackend(state.tlmBackend);
+    compactTlm.configure(COMPACT_TLM_PACKET_SIZE, COMPACT_TLM_REFRESH_PERIOD);
 
-    // Events (highest-priority)
-    configurationTable.entries[0] = {.depth = 100, .priority = 0};
-    // Telemetry
-    configurationTable.entries[1] = {.depth = 500, .priority = 2};
-    // File Downlink
-    configurationTable.entries[2] = {.depth = 100, .priority = 1};
-    // Allocation identifier is 0 as the MallocAllocator discards it
-    comQueue.configure(configurationTable, 0, mallocator);
-    if (state.hostname != nullptr && state.port != 0) {
+    // Only the selected com driver is configured and started; the mux ignores the others
+    comDriverMux.setDriver(state.comDriver);
+    if (state.comDriver == MathModule::ComDriverKind::TCP && state.hostname != nullptr && state.port != 0) {
         comDriver.configure(state.hostname, state.port);
     }
+    if (state.comDriver == MathModule::ComDriverKind::IO_URING && state.hostname != nullptr && state.port != 0) {
+        uringDriver.configure(state.hostname, state.port);
+    }
+
+    // Parameters are loaded and buffers handed out right after this function returns
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(parallelConfigSteps); i++) {
+        if (configStarted[i]) {
+            (void)configTasks[i].join(nullptr);
+        }
+    }
 }
 
 // Public functions for use in main program are namespaced with deployment name MathDeployment
 namespace MathDeployment {
 void setupTopology(const TopologyState& state) {
     // Autocoded initialization. Function provided by autocoder.
+    startupProfiler.beginPhase(MathModule::StartupPhase::INIT_COMPONENTS);
     initComponents(state);
+    startupProfiler.endPhase(MathModule::StartupPhase::INIT_COMPONENTS);
     // Autocoded id setup. Function provided by autocoder.
+    startupProfiler.beginPhase(MathModule::StartupPhase::SET_BASE_IDS);
     setBaseIds();
+    startupProfiler.endPhase(MathModule::StartupPhase::SET_BASE_IDS);
     // Autocoded connection wiring. Function provided by autocoder.
+    startupProfiler.beginPhase(MathModule::StartupPhase::CONNECT_COMPONENTS);
     connectComponents();
+    startupProfiler.endPhase(MathModule::StartupPhase::CONNECT_COMPONENTS);
     // Autocoded configuration. Function provided by autocoder.
+    startupProfiler.beginPhase(MathModule::StartupPhase::CONFIG_COMPONENTS);
     configComponents(state);
+    startupProfiler.endPhase(MathModule::StartupPhase::CONFIG_COMPONENTS);
     // Deployment-specific component configuration. Function provided above. May be inlined, if desired.
+    startupProfiler.beginPhase(MathModule::StartupPhase::CONFIGURE_TOPOLOGY);
     configureTopology(state);
+    startupProfiler.endPhase(MathModule::StartupPhase::CONFIGURE_TOPOLOGY);
     // Autocoded command registration. Function provided by autocoder.
+    startupProfiler.beginPhase(MathModule::StartupPhase::REG_COMMANDS);
     regCommands();
+    startupProfiler.endPhase(MathModule::StartupPhase::REG_COMMANDS);
     // Autocoded parameter loading. Function provided by autocoder.
+    startupProfiler.beginPhase(MathModule::StartupPhase::LOAD_PARAMETERS);
     loadParameters();
+    startupProfiler.endPhase(MathModule::StartupPhase::LOAD_PARAMETERS);
     // Autocoded task kick-off (active components). Function provided by autocoder.
+    startupProfiler.beginPhase(MathModule::StartupPhase::START_TASKS);
     startTasks(state);
+    startupProfiler.endPhase(MathModule::StartupPhase::START_TASKS);
     // Initialize socket communication if and only if there is a valid specification
-    if (state.hostname != nullptr && state.port != 0) {
+    if (state.comDriver == MathModule::ComDriverKind::TCP && state.hostname != nullptr && state.port != 0) {
         Os::TaskString name("ReceiveTask");
         // Uplink is configured for receive so a socket task is started
         comDriver.start(name, COMM_PRIORITY, Default::STACK_SIZE);
     }
+    if (state.comDriver == MathModule::ComDriverKind::IO_URING && state.hostname != nullptr && state.port != 0) {
+        Os::TaskString name("UringTask");
+        uringDriver.start(name, COMM_PRIORITY, Default::STACK_SIZE);
+    }
+    // The server listens on -a (every interface if omitted) and -p; the open reports its own failure as an event
+    if (state.comDriver == MathModule::ComDriverKind::TCP_SERVER && state.port != 0 &&
+        serverDriver.open(state.hostname, state.port)) {
+        serverDriver.startReadThread(COMM_PRIORITY, Default::STACK_SIZE);
+    }
+    // For the shared-memory driver the device is the socket path ground clients attach through
+    if (state.comDriver == MathModule::ComDriverKind::SHM && state.device != nullptr &&
+        shmDriver.open(state.device)) {
+        shmDriver.startReadThread(COMM_PRIORITY, Default::STACK_SIZE);
+    }
+    // Serial communication starts once the port is open; the open reports its own failure as an event
+    if (state.comDriver == MathModule::ComDriverKind::SLIP && state.device != nullptr &&
+        slipDriver.open(state.device)) {
+        slipDriver.startReadThread(COMM_PRIORITY, Default::STACK_SIZE);
+    }
+    // Likewise for the Ethernet driver, where the device is a network interface
+    if (state.comDriver == MathModule::ComDriverKind::ETHERNET && state.device != nullptr &&
+        ethDriver.open(state.device)) {
+        ethDriver.startReadThread(COMM_PRIORITY, Default::STACK_SIZE);
+    }
+    // The loopback driver has nothing to open; the harness driving it set its listener before setup
+    if (state.comDriver == MathModule::ComDriverKind::LOOPBACK) {
+        loopbackDriver.connect();
+    }
+    // The event logger is running now, so the phase timings can be reported
+    startupProfiler.report();
 }
 
 // Variables used for cycle simulation
@@ -195,6 +352,21 @@ void teardownTopology(const TopologyState& state) {
     // Other task clean-up.
     comDriver.stop();
     (void)comDriver.join();
+    uringDriver.stop();
+    (void)uringDriver.join();
+    serverDriver.quitReadThread();
+    (void)serverDriver.join();
+    shmDriver.quitReadThread();
+    (void)shmDriver.join();
+    slipDriver.quitReadThread();
+    (void)slipDriver.join();
+    ethDriver.quitReadThread();
+    (void)ethDriver.join();
+    prmDb.shutdownWriter();
+    cmdSeqStream.stopReader();
+
+    // With every task stopped the trace buffers are complete
+    (void)tracer.dumpAtShutdown();
 
     // Resource deallocation
     cmdSeq.deallocateBuffer(mallocator);
@@ -6,6 +6,8 @@
 #ifndef MATHDEPLOYMENT_MATHDEPLOYMENTTOPOLOGYDEFS_HPP
 #define MATHDEPLOYMENT_MATHDEPLOYMENTTOPOLOGYDEFS_HPP
 
+#include "Components/ComDriverMux/ComDriverKindEnumAc.hpp"
+#include "Components/TlmRouter/TlmBackendEnumAc.hpp"
 #include "Drv/BlockDriver/BlockDriver.hpp"
 #include "Fw/Types/MallocAllocator.hpp"
 #include "MathDeployment/Top/FppConstantsAc.hpp"
@@ -25,6 +27,9 @@ namespace MathDeployment {
 struct TopologyState {
     const CHAR* hostname;
     U16 port;
+    MathModule::TlmBackend tlmBackend;
+    MathModule::ComDriverKind comDriver;
+    const CHAR* device;
 };
 
 /**
@@ -53,6 +58,9 @@ enum { WARN = 3, FATAL = 5 };
 namespace MathDeployment_tlmSend {
 enum { WARN = 3, FATAL = 5 };
 }
+namespace MathDeployment_tlmPacketizer {
+enum { WARN = 3, FATAL = 5 };
+}
 namespace MathDeployment_cmdDisp {
 enum { WARN = 3, FATAL = 5 };
 }
@@ -1,6 +1,12 @@
 # This CMake file is intended to register project-wide objects.
 # This allows for reuse between deployments, or other projects.
 
+# Port call and queue tracing, compiled out unless enabled (see Components/Tracer)
+option(MATH_TRACE "Record port calls and queue dispatch for Chrome trace export" OFF)
+if (MATH_TRACE)
+  add_compile_definitions(MATH_TRACE=1)
+endif()
+
 add_fprime_subdirectory("${CMAKE_CURRENT_LIST_DIR}/Components")
 add_fprime_subdirectory("${CMAKE_CURRENT_LIST_DIR}/Types")
 add_fprime_subdirectory("${CMAKE_CURRENT_LIST_DIR}/Ports")
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+check_tlm_packets.py
+
+Checks that MathDeployment/Top/MathDeploymentPackets.xml covers every telemetry
+channel in the generated topology dictionary. Svc::TlmPacketizer drops updates
+for channels that are neither packetized nor ignored, so a new channel added to
+a component without a packet entry silently disappears when the packetized
+backend is selected.
+
+Exit status is 0 when the packet set and the dictionary agree, 1 otherwise.
+"""
+
+import argparse
+import logging
+import os
+import sys
+import xml.etree.ElementTree as ET
+
+LOGGER = logging.getLogger("CheckTlmPackets")
+
+PROJECT_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_PACKETS = os.path.join(PROJECT_ROOT, 'MathDeployment/Top/MathDeploymentPackets.xml')
+DEFAULT_DICTIONARY = os.path.join(
+    PROJECT_ROOT, 'build-artifacts/Linux/MathDeployment/dict/MathDeploymentTopologyAppDictionary.xml')
+
+
+def dictionary_channels(path):
+    """Read channel names from a topology dictionary.
+
+    Args:
+        path (string): path to the <Topology>TopologyAppDictionary.xml file
+
+    Returns:
+        set: channel names in <instance>.<channel> form
+    """
+    root = ET.parse(path).getroot()
+    return {f"{ch.get('component')}.{ch.get('name')}" for ch in root.iter('channel')}
+
+
+def packet_channels(path):
+    """Read packetized and ignored channel names from a packet definition file.
+
+    Args:
+        path (string): path to the packets XML file
+
+    Returns:
+        tuple: (packetized names (list, in file order), ignored names (set))
+    """
+    root = ET.parse(path).getroot()
+    packetized = [ch.get('name') for packet in root.iter('packet') for ch in packet.iter('channel')]
+    ignored = {ch.get('name') for ignore in root.iter('ignore') for ch in ignore.iter('channel')}
+    return packetized, ignored
+
+
+def main():
+    """Compare the packet set against the dictionary and report differences."""
+    parser = argparse.ArgumentParser(description='Check telemetry packet definitions against the topology')
+    parser.add_argument('--packets', default=DEFAULT_PACKETS, help='Packet definition XML')
+    parser.add_argument('--dictionary', default=DEFAULT_DICTIONARY, help='Topology dictionary XML')
+    args = parser.parse_args()
+    logging.basicConfig(level=logging.INFO, format="%(levelname)s - %(message)s")
+
+    channels = dictionary_channels(args.dictionary)
+    packetized, ignored = packet_channels(args.packets)
+    covered = set(packetized) | ignored
+
+    ok = True
+    for name in sorted(channels - covered):
+        LOGGER.error("Channel %s is in the dictionary but in no packet and not ignored", name)
+        ok = False
+    for name in sorted(covered - channels):
+        LOGGER.error("Channel %s is in the packet set but not in the dictionary", name)
+        ok = False
+    seen = set()
+    for name in packetized:
+        if name in seen:
+            LOGGER.warning("Channel %s appears in more than one packet", name)
+        seen.add(name)
+
+    if ok:
+        LOGGER.info("Packet set covers all %d channels", len(channels))
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
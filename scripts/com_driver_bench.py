@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+com_driver_bench.py
+
+Compares the TCP com drivers of MathDeployment over loopback: the vectored
+sendmsg client (`-c tcp`) and the io_uring client (`-c uring`).
+
+For each driver the script listens on a loopback port, launches the deployment
+with the driver selected so it dials in, streams framed DO_MATH commands at the
+requested rate, drains the downlink as fast as it arrives, and measures:
+    - downlink bytes and frames per second
+    - deployment CPU utilization, and CPU milliseconds per downlinked megabyte
+
+The downlink is what the commands make the deployment emit, so raise --rate
+until the byte rate stops following it to find where a driver saturates.
+Results are printed as one JSON object per driver.
+"""
+
+import argparse
+import json
+import logging
+import random
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+from fprime_link import Deframer, encode_do_math, frame
+from tlm_backend_bench import cpu_seconds
+
+LOGGER = logging.getLogger("ComDriverBench")
+
+
+def run_driver(binary, driver, port, rate, duration):
+    """Run one deployment under load and measure it.
+
+    Args:
+        binary (string): path to the MathDeployment executable
+        driver (string): 'tcp' or 'uring'
+        port (int): loopback port to listen on
+        rate (float): DO_MATH commands per second
+        duration (float): measurement window, seconds
+
+    Returns:
+        dict: measurement results
+    """
+    listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    listener.bind(('127.0.0.1', port))
+    listener.listen(1)
+    listener.settimeout(10.0)
+
+    workdir = tempfile.mkdtemp(prefix=f'combench-{driver}-')
+    proc = subprocess.Popen([binary, '-a', '127.0.0.1', '-p', str(port), '-c', driver],
+                            cwd=workdir, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    try:
+        conn, _ = listener.accept()
+        conn.setblocking(False)
+        deframer = Deframer()
+        ops = ['ADD', 'SUB', 'MUL', 'DIV']
+
+        total_bytes = 0
+        frames = 0
+        sent = 0
+        start = time.monotonic()
+        cpu_start = cpu_seconds(proc.pid)
+        period = 1.0 / rate if rate > 0 else None
+        next_send = start
+
+        while time.monotonic() - start < duration:
+            now = time.monotonic()
+            # Catch up in a burst if the loop fell behind, so the offered load holds at high rates
+            while period is not None and now >= next_send:
+                packet = encode_do_math(random.uniform(1, 100), random.choice(ops), random.uniform(1, 100))
+                conn.sendall(frame(packet))
+                sent += 1
+                next_send += period
+            try:
+                data = conn.recv(262144)
+                if not data:
+                    break
+                total_bytes += len(data)
+                frames += len(deframer.feed(data))
+            except BlockingIOError:
+                time.sleep(0.0002)
+
+        elapsed = time.monotonic() - start
+        cpu = cpu_seconds(proc.pid) - cpu_start
+        conn.close()
+        megabytes = total_bytes / 1e6
+        return {
+            'driver': driver,
+            'commands_sent': sent,
+            'seconds': round(elapsed, 3),
+            'downlink_bytes_per_sec': round(total_bytes / elapsed, 1),
+            'downlink_frames_per_sec': round(frames / elapsed, 1),
+            'cpu_percent': round(100.0 * cpu / elapsed, 2),
+            'cpu_ms_per_mb': round(1000.0 * cpu / megabytes, 2) if megabytes > 0 else None,
+            'bad_frames': deframer.bad_frames,
+        }
+    finally:
+        proc.send_signal(signal.SIGINT)
+        try:
+            proc.wait(timeout=10)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+        listener.close()
+
+
+def main():
+    """Parse arguments and benchmark each driver."""
+    parser = argparse.ArgumentParser(description='Benchmark the vectored TCP client against the io_uring client')
+    parser.add_argument('binary', help='Path to the MathDeployment executable')
+    parser.add_argument('--port', type=int, default=50000, help='Loopback port (default: 50000)')
+    parser.add_argument('--rate', type=float, default=500.0, help='DO_MATH commands per second (default: 500)')
+    parser.add_argument('--duration', type=float, default=30.0, help='Seconds per driver (default: 30)')
+    parser.add_argument('--drivers', nargs='+', choices=['tcp', 'uring'], default=['tcp', 'uring'])
+    args = parser.parse_args()
+    logging.basicConfig(level=logging.INFO, format="%(asctime)s - %(levelname)s - %(message)s")
+
+    for driver in args.drivers:
+        LOGGER.info("Measuring %s driver for %.0f s at %.1f cmd/s", driver, args.duration, args.rate)
+        print(json.dumps(run_driver(args.binary, driver, args.port, args.rate, args.duration)))
+        sys.stdout.flush()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
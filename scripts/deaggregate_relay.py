@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+deaggregate_relay.py
+
+Relay between MathDeployment and an unmodified fprime-gds that expands
+ComAggregator aggregates back into one F' frame per packet, decompressing
+ComCompressor packets first.
+
+    MathDeployment (TcpClient) --> relay --> fprime-gds (--no-app, TCP server)
+
+The deployment dials the relay's listening port; the relay dials the GDS.
+Uplink bytes are forwarded untouched. Downlink frames are deframed, decompressed,
+aggregates are split, and each packet is re-framed before being forwarded.
+"""
+
+import argparse
+import logging
+import selectors
+import socket
+import sys
+
+from fprime_link import Deframer, deaggregate, decompress, frame
+
+LOGGER = logging.getLogger("DeaggregateRelay")
+
+
+def relay(deployment, gds):
+    """Shuttle bytes between the two connections until either closes.
+
+    Args:
+        deployment (socket.socket): connection from the deployment
+        gds (socket.socket): connection to the GDS
+    """
+    deframer = Deframer()
+    selector = selectors.DefaultSelector()
+    selector.register(deployment, selectors.EVENT_READ, 'down')
+    selector.register(gds, selectors.EVENT_READ, 'up')
+    frames_in = 0
+    frames_out = 0
+
+    while True:
+        for key, _ in selector.select():
+            data = key.fileobj.recv(65536)
+            if not data:
+                LOGGER.info("Connection closed; %d frames in, %d frames out", frames_in, frames_out)
+                return
+            if key.data == 'up':
+                deployment.sendall(data)
+                continue
+            out = bytearray()
+            for packet in deframer.feed(data):
+                frames_in += 1
+                try:
+                    packet = decompress(packet)
+                except ValueError as error:
+                    LOGGER.warning("Dropped a compressed frame: %s", error)
+                    continue
+                for inner in deaggregate(packet):
+                    out += frame(inner)
+                    frames_out += 1
+            if out:
+                gds.sendall(out)
+            if deframer.bad_frames:
+                LOGGER.warning("Dropped %d frames with bad checksums", deframer.bad_frames)
+                deframer.bad_frames = 0
+
+
+def main():
+    """Accept the deployment, connect to the GDS and relay."""
+    parser = argparse.ArgumentParser(description='Expand ComAggregator and ComCompressor frames for fprime-gds')
+    parser.add_argument('--listen-port', type=int, default=50001,
+                        help='Port the deployment connects to (default: 50001)')
+    parser.add_argument('--gds-address', default='127.0.0.1', help='GDS address (default: 127.0.0.1)')
+    parser.add_argument('--gds-port', type=int, default=50000, help='GDS TCP server port (default: 50000)')
+    parser.add_argument('--debug', action='store_true', help='Enable debug logging')
+    args = parser.parse_args()
+    logging.basicConfig(level=logging.DEBUG if args.debug else logging.INFO,
+                        format="%(asctime)s - %(levelname)s - %(message)s")
+
+    listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    listener.bind(('0.0.0.0', args.listen_port))
+    listener.listen(1)
+    LOGGER.info("Waiting for the deployment on port %d", args.listen_port)
+
+    try:
+        while True:
+            deployment, address = listener.accept()
+            LOGGER.info("Deployment connected from %s:%d", *address)
+            gds = socket.create_connection((args.gds_address, args.gds_port))
+            try:
+                relay(deployment, gds)
+            finally:
+                deployment.close()
+                gds.close()
+    except KeyboardInterrupt:
+        LOGGER.info("Stopping relay")
+    finally:
+        listener.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
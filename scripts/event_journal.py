@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+event_journal.py
+
+Print the events in a range file written by eventJournal.DOWNLINK_RANGE and
+received through file downlink.
+
+File layout (all fields big endian):
+    - Magic (4 bytes) - 0x454A5831
+    - Start and end seconds of the requested range (4 bytes each)
+    - Records, oldest first:
+        - Journal sequence number (8 bytes); gaps are events overwritten or skipped
+        - Event id (4 bytes)
+        - Time tag (11 bytes) - Fw::Time: base U16, context U8, seconds U32, microseconds U32
+        - Severity (1 byte) - Fw::LogSeverity
+        - Argument size (2 bytes) and the serialized arguments
+
+Without a dictionary events are printed with their ids and raw arguments. With
+the deployment's dictionary, names and formatted arguments are printed instead.
+"""
+
+import argparse
+import collections
+import struct
+import sys
+
+RANGE_FILE_MAGIC = 0x454A5831
+HEADER_FORMAT = '>III'
+RECORD_FORMAT = '>QIHBIIBH'
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+SEVERITIES = {1: 'FATAL', 2: 'WARNING_HI', 3: 'WARNING_LO', 4: 'COMMAND', 5: 'ACTIVITY_HI', 6: 'ACTIVITY_LO',
+              7: 'DIAGNOSTIC'}
+
+Record = collections.namedtuple('Record', 'sequence id time_base time_context seconds useconds severity args')
+
+
+def read_range(data):
+    """Parse a range file.
+
+    Args:
+        data (bytes): file contents
+
+    Returns:
+        tuple: (start, end, list of Record)
+
+    Raises:
+        ValueError: the file is not a range file or is truncated
+    """
+    if len(data) < struct.calcsize(HEADER_FORMAT):
+        raise ValueError("file too short for a range header")
+    magic, start, end = struct.unpack_from(HEADER_FORMAT, data, 0)
+    if magic != RANGE_FILE_MAGIC:
+        raise ValueError("not an event journal range file (magic 0x%08X)" % magic)
+    offset = struct.calcsize(HEADER_FORMAT)
+    records = []
+    while offset < len(data):
+        if offset + RECORD_SIZE > len(data):
+            raise ValueError("record at offset %d is truncated" % offset)
+        fields = struct.unpack_from(RECORD_FORMAT, data, offset)
+        offset += RECORD_SIZE
+        arg_size = fields[-1]
+        if offset + arg_size > len(data):
+            raise ValueError("arguments at offset %d are truncated" % offset)
+        records.append(Record(*fields[:-1], args=data[offset:offset + arg_size]))
+        offset += arg_size
+    return start, end, records
+
+
+def load_events(dictionary_path):
+    """Load the event templates of a deployment dictionary, keyed by id.
+
+    Args:
+        dictionary_path (str): the deployment's dictionary
+
+    Returns:
+        dict: event id to fprime_gds EventTemplate
+    """
+    from fprime_gds.common.pipeline.dictionaries import Dictionaries
+    dictionaries = Dictionaries()
+    dictionaries.load_standard(dictionary_path)
+    return dictionaries.event_id
+
+
+def describe(record, events):
+    """Render a record's event name and arguments.
+
+    Args:
+        record (Record): the record
+        events (dict): event templates from load_events, or None
+
+    Returns:
+        str: name and text of the event
+    """
+    template = events.get(record.id) if events else None
+    if template is None:
+        return "0x%X %s" % (record.id, record.args.hex())
+    values = []
+    offset = 0
+    try:
+        for _, _, arg_type in template.get_args():
+            value = arg_type()
+            value.deserialize(record.args, offset)
+            offset += value.getSize()
+            values.append(value.val)
+        text = template.get_format_str() % tuple(values)
+    except Exception as error:  # A dictionary from another build may not match the arguments
+        text = "%s (arguments not decoded: %s)" % (record.args.hex(), error)
+    return "%s.%s %s" % (template.get_comp_name(), template.get_name(), text)
+
+
+def main():
+    """Print a range file."""
+    parser = argparse.ArgumentParser(description='Print an eventJournal range file')
+    parser.add_argument('file', help='Range file received through file downlink')
+    parser.add_argument('--dictionary', help="Deployment dictionary, for event names and arguments")
+    args = parser.parse_args()
+
+    with open(args.file, 'rb') as stream:
+        data = stream.read()
+    try:
+        start, end, records = read_range(data)
+    except ValueError as error:
+        print("%s: %s" % (args.file, error), file=sys.stderr)
+        return 1
+    events = load_events(args.dictionary) if args.dictionary else None
+
+    print("# %d events between %d and %d s" % (len(records), start, end))
+    for record in records:
+        print("%8d %d.%06d %-11s %s" % (record.sequence, record.seconds, record.useconds,
+                                        SEVERITIES.get(record.severity, str(record.severity)),
+                                        describe(record, events)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+"""
+fprime_link.py
+
+Dependency-free helpers for speaking the F' framing protocol directly, used by
+ground-side tools that talk to MathDeployment without going through fprime-gds.
+
+Frame layout (Svc::FprimeFraming):
+    - Start word (4 bytes) - 0xDEADBEEF
+    - Data size (4 bytes)
+    - Data (variable) - packet descriptor followed by the packet body
+    - CRC32 (4 bytes) - over start word, size and data
+"""
+
+import struct
+import zlib
+
+START_WORD = 0xDEADBEEF
+HEADER_FORMAT = '>II'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+HASH_SIZE = 4
+
+# Fw::ComPacket::ComPacketType values (FwPacketDescriptorType is U32)
+PACKET_COMMAND = 0
+PACKET_TELEM = 1
+PACKET_LOG = 2
+PACKET_FILE = 3
+# MathModule::ComAggregator aggregate: U16 length-prefixed packets follow the descriptor
+PACKET_AGGREGATE = 0xA0
+# MathModule::ComCompressor packet: U16 original size and an LZ4 block follow the descriptor
+PACKET_COMPRESSED = 0xA1
+# First byte of a compressed file packet, in place of the Fw::FilePacket type
+COMPRESSED_FILE_MARKER = 0xA1
+
+# MathModule::MathOp values
+MATH_OPS = {'ADD': 0, 'SUB': 1, 'MUL': 2, 'DIV': 3}
+
+# mathSender base id 0x0E00 plus the DO_MATH opcode 0
+DO_MATH_OPCODE = 0x0E00
+
+# MathModule::BatchCmdDispatcher batch: U16 length-prefixed command packets follow the opcode
+BATCH_OPCODE = 0xFFFF0000
+# FW_COM_BUFFER_MAX_SIZE, the largest packet the deframer forwards to cmdDisp
+MAX_PACKET_SIZE = 512
+
+
+def frame(data):
+    """Wrap a packet in an F' frame.
+
+    Args:
+        data (bytes): packet, starting with its descriptor
+
+    Returns:
+        bytes: framed packet
+    """
+    header = struct.pack(HEADER_FORMAT, START_WORD, len(data))
+    body = header + data
+    return body + struct.pack('>I', zlib.crc32(body) & 0xFFFFFFFF)
+
+
+class Deframer:
+    """Incremental F' deframer for a byte stream."""
+
+    def __init__(self):
+        """Deframer Constructor."""
+        self._buffer = bytearray()
+        self.bad_frames = 0
+
+    def feed(self, data):
+        """Add received bytes and return every complete packet.
+
+        Args:
+            data (bytes): bytes read from the link
+
+        Returns:
+            list: packets (bytes), descriptor included, with framing removed
+        """
+        self._buffer += data
+        packets = []
+        while len(self._buffer) >= HEADER_SIZE:
+            start, size = struct.unpack_from(HEADER_FORMAT, self._buffer, 0)
+            if start != START_WORD:
+                # Resynchronize on the next candidate start word
+                del self._buffer[0]
+                continue
+            total = HEADER_SIZE + size + HASH_SIZE
+            if len(self._buffer) < total:
+                break
+            body = bytes(self._buffer[:HEADER_SIZE + size])
+            (crc,) = struct.unpack_from('>I', self._buffer, HEADER_SIZE + size)
+            del self._buffer[:total]
+            if zlib.crc32(body) & 0xFFFFFFFF != crc:
+                self.bad_frames += 1
+                continue
+            packets.append(body[HEADER_SIZE:])
+        return packets
+
+
+def packet_type(packet):
+    """Return the descriptor of a deframed packet.
+
+    Args:
+        packet (bytes): deframed packet
+
+    Returns:
+        int: Fw::ComPacket::ComPacketType value
+    """
+    return struct.unpack_from('>I', packet, 0)[0]
+
+
+def deaggregate(packet):
+    """Split a ComAggregator aggregate into its packets.
+
+    Args:
+        packet (bytes): deframed packet
+
+    Returns:
+        list: the contained packets, or [packet] if it is not an aggregate
+    """
+    if len(packet) < 4 or packet_type(packet) != PACKET_AGGREGATE:
+        return [packet]
+    packets = []
+    ptr = 4
+    while ptr + 2 <= len(packet):
+        (length,) = struct.unpack_from('>H', packet, ptr)
+        ptr += 2
+        if ptr + length > len(packet):
+            break
+        packets.append(packet[ptr:ptr + length])
+        ptr += length
+    return packets
+
+
+def lz4_block_decompress(block, size):
+    """Decompress an LZ4 block, the format ComCompressor sends.
+
+    Args:
+        block (bytes): the block
+        size (int): size of the original data
+
+    Returns:
+        bytes: the original data
+
+    Raises:
+        ValueError: if the block is malformed or does not decompress to size bytes
+    """
+    out = bytearray()
+    ptr = 0
+    while ptr < len(block):
+        token = block[ptr]
+        ptr += 1
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                if ptr >= len(block):
+                    raise ValueError('truncated literal length')
+                literals += block[ptr]
+                ptr += 1
+                if block[ptr - 1] != 255:
+                    break
+        if ptr + literals > len(block):
+            raise ValueError('truncated literals')
+        out += block[ptr:ptr + literals]
+        ptr += literals
+        if ptr == len(block):
+            break
+        if ptr + 2 > len(block):
+            raise ValueError('truncated match offset')
+        (offset,) = struct.unpack_from('<H', block, ptr)
+        ptr += 2
+        length = token & 0x0F
+        if length == 15:
+            while True:
+                if ptr >= len(block):
+                    raise ValueError('truncated match length')
+                length += block[ptr]
+                ptr += 1
+                if block[ptr - 1] != 255:
+                    break
+        length += 4
+        if offset == 0 or offset > len(out):
+            raise ValueError('match offset {} outside the output'.format(offset))
+        # Byte by byte: the match may overlap the bytes it produces
+        start = len(out) - offset
+        for i in range(length):
+            out.append(out[start + i])
+    if len(out) != size:
+        raise ValueError('decompressed {} bytes, expected {}'.format(len(out), size))
+    return bytes(out)
+
+
+def decompress(packet):
+    """Undo ComCompressor compression of a deframed packet.
+
+    Args:
+        packet (bytes): deframed packet
+
+    Returns:
+        bytes: the original packet, or packet unchanged if it is not compressed
+    """
+    if len(packet) < 4:
+        return packet
+    kind = packet_type(packet)
+    if kind == PACKET_COMPRESSED and len(packet) >= 6:
+        (size,) = struct.unpack_from('>H', packet, 4)
+        return lz4_block_decompress(packet[6:], size)
+    if kind == PACKET_FILE and len(packet) >= 7 and packet[4] == COMPRESSED_FILE_MARKER:
+        (size,) = struct.unpack_from('>H', packet, 5)
+        return packet[:4] + lz4_block_decompress(packet[7:], size)
+    return packet
+
+
+def encode_command(opcode, args=b''):
+    """Encode a command packet.
+
+    Args:
+        opcode (int): full command opcode (instance base id + component opcode)
+        args (bytes, optional): serialized arguments. Defaults to no arguments.
+
+    Returns:
+        bytes: command packet, ready to be framed
+    """
+    return struct.pack('>II', PACKET_COMMAND, opcode) + args
+
+
+def encode_do_math(val1, op, val2):
+    """Encode a mathSender.DO_MATH command packet.
+
+    Args:
+        val1 (float): first operand
+        op (str): operation name, one of MATH_OPS
+        val2 (float): second operand
+
+    Returns:
+        bytes: command packet, ready to be framed
+    """
+    return encode_command(DO_MATH_OPCODE, struct.pack('>fif', val1, MATH_OPS[op], val2))
+
+
+def encode_command_batch(commands):
+    """Encode command packets as one batch, dispatched by cmdDisp in order.
+
+    Args:
+        commands (list): command packets, as returned by encode_command
+
+    Returns:
+        bytes: batch packet, ready to be framed
+    """
+    batch = encode_command(BATCH_OPCODE)
+    for command in commands:
+        batch += struct.pack('>H', len(command)) + command
+    if len(batch) > MAX_PACKET_SIZE:
+        raise ValueError('batch of {} bytes exceeds {}'.format(len(batch), MAX_PACKET_SIZE))
+    return batch
+
+
+def batch_commands(commands):
+    """Group command packets into as few batches as fit in a packet each.
+
+    Args:
+        commands (list): command packets, as returned by encode_command
+
+    Returns:
+        list: batch packets, ready to be framed, in command order
+    """
+    batches = []
+    group = []
+    size = len(encode_command(BATCH_OPCODE))
+    for command in commands:
+        if group and size + 2 + len(command) > MAX_PACKET_SIZE:
+            batches.append(encode_command_batch(group))
+            group = []
+            size = len(encode_command(BATCH_OPCODE))
+        group.append(command)
+        size += 2 + len(command)
+    if group:
+        batches.append(encode_command_batch(group))
+    return batches
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+math_job.py
+
+Write operand files for mathFileJob.RUN_MATH_FILE and print the result files
+it downlinks.
+
+Operand file layout (all fields big endian):
+    - Magic (4 bytes) - 0x4D4A4931, "MJI1"
+    - Records:
+        - Operation (1 byte) - MathOp value: ADD 0, SUB 1, MUL 2, DIV 3
+        - First and second operands (4 bytes each) - F32
+
+Result file layout (all fields big endian):
+    - Magic (4 bytes) - 0x4D4A4F31, "MJO1"
+    - Record count (4 bytes)
+    - Results, one per operand record in the same order (4 bytes each) - F32
+
+The operands are read as text, one "OP VAL1 VAL2" line per record, e.g.
+"DIV 1.5 3". Blank lines and lines starting with # are skipped.
+"""
+
+import argparse
+import struct
+import sys
+
+from fprime_link import MATH_OPS
+
+INPUT_MAGIC = 0x4D4A4931
+OUTPUT_MAGIC = 0x4D4A4F31
+INPUT_RECORD_FORMAT = '>Bff'
+OUTPUT_HEADER_FORMAT = '>II'
+OUTPUT_RECORD_FORMAT = '>f'
+
+
+def encode_operands(records):
+    """Encode an operand file.
+
+    Args:
+        records (iterable): (op, val1, val2) tuples, op one of MATH_OPS
+
+    Returns:
+        bytes: the file contents
+    """
+    data = bytearray(struct.pack('>I', INPUT_MAGIC))
+    for op, val1, val2 in records:
+        data += struct.pack(INPUT_RECORD_FORMAT, MATH_OPS[op], val1, val2)
+    return bytes(data)
+
+
+def parse_operands(lines):
+    """Parse operand text.
+
+    Args:
+        lines (iterable): lines of "OP VAL1 VAL2"
+
+    Returns:
+        list: (op, val1, val2) tuples
+
+    Raises:
+        ValueError: a line is not an operation and two numbers
+    """
+    records = []
+    for number, line in enumerate(lines, 1):
+        fields = line.split()
+        if not fields or fields[0].startswith('#'):
+            continue
+        if len(fields) != 3 or fields[0].upper() not in MATH_OPS:
+            raise ValueError("line %d is not OP VAL1 VAL2: %s" % (number, line.strip()))
+        records.append((fields[0].upper(), float(fields[1]), float(fields[2])))
+    return records
+
+
+def read_results(data):
+    """Parse a result file.
+
+    Args:
+        data (bytes): file contents
+
+    Returns:
+        list: the results, in operand record order
+
+    Raises:
+        ValueError: the file is not a result file or is truncated
+    """
+    header_size = struct.calcsize(OUTPUT_HEADER_FORMAT)
+    if len(data) < header_size:
+        raise ValueError("file too short for a result header")
+    magic, count = struct.unpack_from(OUTPUT_HEADER_FORMAT, data, 0)
+    if magic != OUTPUT_MAGIC:
+        raise ValueError("not a math job result file (magic 0x%08X)" % magic)
+    record_size = struct.calcsize(OUTPUT_RECORD_FORMAT)
+    if len(data) != header_size + count * record_size:
+        raise ValueError("%d bytes do not hold the %d results of the header" % (len(data), count))
+    return [value for (value,) in struct.iter_unpack(OUTPUT_RECORD_FORMAT, data[header_size:])]
+
+
+def main():
+    """Encode an operand file or print a result file."""
+    parser = argparse.ArgumentParser(description='Operand and result files of mathFileJob')
+    subparsers = parser.add_subparsers(dest='action', required=True)
+    encode = subparsers.add_parser('encode', help='Write an operand file from "OP VAL1 VAL2" lines')
+    encode.add_argument('text', help='Operand text, or - for standard input')
+    encode.add_argument('file', help='Operand file to write, for file uplink')
+    decode = subparsers.add_parser('decode', help='Print a result file')
+    decode.add_argument('file', help='Result file received through file downlink')
+    args = parser.parse_args()
+
+    try:
+        if args.action == 'encode':
+            if args.text == '-':
+                records = parse_operands(sys.stdin)
+            else:
+                with open(args.text) as stream:
+                    records = parse_operands(stream)
+            with open(args.file, 'wb') as stream:
+                stream.write(encode_operands(records))
+            print("%s: %d records" % (args.file, len(records)))
+        else:
+            with open(args.file, 'rb') as stream:
+                results = read_results(stream.read())
+            for result in results:
+                print("%.9g" % result)
+    except ValueError as error:
+        print("%s: %s" % (args.file, error), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
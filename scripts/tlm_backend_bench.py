@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""
+tlm_backend_bench.py
+
+Compares the channelized (Svc::TlmChan) and packetized (Svc::TlmPacketizer)
+telemetry backends of MathDeployment under a DO_MATH command load.
+
+For each backend the script listens on a loopback port, launches the deployment
+with `-t chan` or `-t pkt` so its TcpClient dials in, streams framed DO_MATH
+commands at the requested rate, and measures:
+    - downlink bytes per second, total and telemetry-only
+    - deployment CPU utilization, from /proc/<pid>/stat
+
+Results are printed as one JSON object per backend.
+"""
+
+import argparse
+import json
+import logging
+import os
+import random
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+from fprime_link import Deframer, PACKET_TELEM, deaggregate, encode_do_math, frame, packet_type
+
+LOGGER = logging.getLogger("TlmBackendBench")
+
+CLOCK_TICKS = os.sysconf('SC_CLK_TCK')
+
+
+def cpu_seconds(pid):
+    """Return user + system CPU seconds consumed by a process.
+
+    Args:
+        pid (int): process id
+
+    Returns:
+        float: CPU seconds
+    """
+    with open(f'/proc/{pid}/stat', 'r', encoding='ascii') as stat:
+        fields = stat.read().rsplit(')', 1)[1].split()
+    # utime and stime are fields 14 and 15; fields[0] here is field 3
+    return (int(fields[11]) + int(fields[12])) / CLOCK_TICKS
+
+
+def run_backend(binary, backend, port, rate, duration):
+    """Run one deployment under load and measure it.
+
+    Args:
+        binary (string): path to the MathDeployment executable
+        backend (string): 'chan' or 'pkt'
+        port (int): loopback port to listen on
+        rate (float): DO_MATH commands per second
+        duration (float): measurement window, seconds
+
+    Returns:
+        dict: measurement results
+    """
+    listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    listener.bind(('127.0.0.1', port))
+    listener.listen(1)
+    listener.settimeout(10.0)
+
+    workdir = tempfile.mkdtemp(prefix=f'tlmbench-{backend}-')
+    proc = subprocess.Popen([binary, '-a', '127.0.0.1', '-p', str(port), '-t', backend],
+                            cwd=workdir, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    try:
+        conn, _ = listener.accept()
+        conn.setblocking(False)
+        deframer = Deframer()
+        ops = ['ADD', 'SUB', 'MUL', 'DIV']
+
+        total_bytes = 0
+        tlm_bytes = 0
+        sent = 0
+        start = time.monotonic()
+        cpu_start = cpu_seconds(proc.pid)
+        period = 1.0 / rate if rate > 0 else None
+        next_send = start
+
+        while time.monotonic() - start < duration:
+            now = time.monotonic()
+            if period is not None and now >= next_send:
+                packet = encode_do_math(random.uniform(1, 100), random.choice(ops), random.uniform(1, 100))
+                conn.sendall(frame(packet))
+                sent += 1
+                next_send += period
+            try:
+                data = conn.recv(65536)
+                if not data:
+                    break
+                total_bytes += len(data)
+                for framed in deframer.feed(data):
+                    for packet in deaggregate(framed):
+                        if packet_type(packet) == PACKET_TELEM:
+                            tlm_bytes += len(packet)
+            except BlockingIOError:
+                time.sleep(min(0.001, period or 0.001))
+
+        elapsed = time.monotonic() - start
+        cpu = cpu_seconds(proc.pid) - cpu_start
+        conn.close()
+        return {
+            'backend': backend,
+            'commands_sent': sent,
+            'seconds': round(elapsed, 3),
+            'downlink_bytes_per_sec': round(total_bytes / elapsed, 1),
+            'telemetry_bytes_per_sec': round(tlm_bytes / elapsed, 1),
+            'cpu_percent': round(100.0 * cpu / elapsed, 2),
+            'bad_frames': deframer.bad_frames,
+        }
+    finally:
+        proc.send_signal(signal.SIGINT)
+        try:
+            proc.wait(timeout=10)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+        listener.close()
+
+
+def main():
+    """Parse arguments and benchmark each backend."""
+    parser = argparse.ArgumentParser(description='Benchmark TlmChan against TlmPacketizer')
+    parser.add_argument('binary', help='Path to the MathDeployment executable')
+    parser.add_argument('--port', type=int, default=50000, help='Loopback port (default: 50000)')
+    parser.add_argument('--rate', type=float, default=50.0, help='DO_MATH commands per second (default: 50)')
+    parser.add_argument('--duration', type=float, default=30.0, help='Seconds per backend (default: 30)')
+    parser.add_argument('--backends', nargs='+', choices=['chan', 'pkt'], default=['chan', 'pkt'])
+    args = parser.parse_args()
+    logging.basicConfig(level=logging.INFO, format="%(asctime)s - %(levelname)s - %(message)s")
+
+    for backend in args.backends:
+        LOGGER.info("Measuring %s backend for %.0f s at %.1f cmd/s", backend, args.duration, args.rate)
+        print(json.dumps(run_backend(args.binary, backend, args.port, args.rate, args.duration)))
+        sys.stdout.flush()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+tlm_history.py
+
+Print the samples in a query file written by tlmHistory.QUERY and received
+through file downlink.
+
+File layout (all fields big endian):
+    - Magic (4 bytes) - 0x54485831
+    - Channel id (4 bytes)
+    - Start and end seconds of the requested range (4 bytes each)
+    - Records, oldest first:
+        - Time tag (11 bytes) - Fw::Time: base U16, context U8, seconds U32, microseconds U32
+        - Value size (1 byte) and the serialized value
+
+Without a dictionary values are printed as raw bytes. With the deployment's
+dictionary, the channel name and decoded values are printed instead.
+"""
+
+import argparse
+import collections
+import struct
+import sys
+
+QUERY_FILE_MAGIC = 0x54485831
+HEADER_FORMAT = '>IIII'
+RECORD_FORMAT = '>HBIIB'
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+Record = collections.namedtuple('Record', 'time_base time_context seconds useconds value')
+
+
+def read_query(data):
+    """Parse a query file.
+
+    Args:
+        data (bytes): file contents
+
+    Returns:
+        tuple: (channel id, start, end, list of Record)
+
+    Raises:
+        ValueError: the file is not a query file or is truncated
+    """
+    if len(data) < struct.calcsize(HEADER_FORMAT):
+        raise ValueError("file too short for a query header")
+    magic, channel, start, end = struct.unpack_from(HEADER_FORMAT, data, 0)
+    if magic != QUERY_FILE_MAGIC:
+        raise ValueError("not a telemetry history query file (magic 0x%08X)" % magic)
+    offset = struct.calcsize(HEADER_FORMAT)
+    records = []
+    while offset < len(data):
+        if offset + RECORD_SIZE > len(data):
+            raise ValueError("record at offset %d is truncated" % offset)
+        fields = struct.unpack_from(RECORD_FORMAT, data, offset)
+        offset += RECORD_SIZE
+        value_size = fields[-1]
+        if offset + value_size > len(data):
+            raise ValueError("value at offset %d is truncated" % offset)
+        records.append(Record(*fields[:-1], value=data[offset:offset + value_size]))
+        offset += value_size
+    return channel, start, end, records
+
+
+def load_channel(dictionary_path, channel):
+    """Load the template of a channel from a deployment dictionary.
+
+    Args:
+        dictionary_path (str): the deployment's dictionary
+        channel (int): the channel id
+
+    Returns:
+        fprime_gds ChTemplate, or None if the dictionary has no such channel
+    """
+    from fprime_gds.common.pipeline.dictionaries import Dictionaries
+    dictionaries = Dictionaries()
+    dictionaries.load_standard(dictionary_path)
+    return dictionaries.channel_id.get(channel)
+
+
+def describe(record, template):
+    """Render a record's value.
+
+    Args:
+        record (Record): the record
+        template: channel template from load_channel, or None
+
+    Returns:
+        str: the value
+    """
+    if template is None:
+        return record.value.hex()
+    try:
+        value = template.get_type_obj()()
+        value.deserialize(record.value, 0)
+        return str(value.val)
+    except Exception as error:  # A dictionary from another build may not match the value
+        return "%s (value not decoded: %s)" % (record.value.hex(), error)
+
+
+def main():
+    """Print a query file."""
+    parser = argparse.ArgumentParser(description='Print a tlmHistory query file')
+    parser.add_argument('file', help='Query file received through file downlink')
+    parser.add_argument('--dictionary', help="Deployment dictionary, for the channel name and values")
+    args = parser.parse_args()
+
+    with open(args.file, 'rb') as stream:
+        data = stream.read()
+    try:
+        channel, start, end, records = read_query(data)
+    except ValueError as error:
+        print("%s: %s" % (args.file, error), file=sys.stderr)
+        return 1
+    template = load_channel(args.dictionary, channel) if args.dictionary else None
+    name = "%s.%s" % (template.get_comp_name(), template.get_name()) if template else "0x%X" % channel
+
+    print("# %s: %d samples between %d and %d s" % (name, len(records), start, end))
+    for record in records:
+        print("%d.%06d %s" % (record.seconds, record.useconds, describe(record, template)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())